@@ -18,6 +18,7 @@
 
 // CodeLite includes
 #include <ctags_manager.h>
+#include <tags_storage_sqlite3.h>
 #include <CxxVariableScanner.h>
 #include <wx/crt.h>
 
@@ -219,6 +220,47 @@ TEST_FUNC(testLocalArgument)
     return true;
 }
 
+TEST_FUNC(testRepeatedExpressionInScope)
+{
+    // The second request is answered from the expressions cache and must return the same result
+    std::vector<TagEntryPtr> tags;
+    TagsManagerST::Get()->AutoCompleteCandidates(wxFileName(wxT("../tests/test_repeated_expression.h")), 3,
+        wxT("obj->"), LoadFile(wxT("../tests/test_repeated_expression.h")), tags);
+    CHECK_SIZE(tags.size(), CLASS_WITH_MEMBERS_COUNT);
+
+    tags.clear();
+    TagsManagerST::Get()->AutoCompleteCandidates(wxFileName(wxT("../tests/test_repeated_expression.h")), 3,
+        wxT("obj->"), LoadFile(wxT("../tests/test_repeated_expression.h")), tags);
+    CHECK_SIZE(tags.size(), CLASS_WITH_MEMBERS_COUNT);
+
+    // Same file, function and expression but 'obj' has another type: the cached result must not be used
+    tags.clear();
+    TagsManagerST::Get()->AutoCompleteCandidates(wxFileName(wxT("../tests/test_repeated_expression.h")), 3,
+        wxT("obj->"), wxT("void foo()\n{\n    wxString* obj;\n    obj->"), tags);
+    CHECK_SIZE(tags.size(), WX_STRING_MEMBERS_COUNT);
+    return true;
+}
+
+TEST_FUNC(testExpressionResolvedAfterDbChange)
+{
+    std::vector<TagEntryPtr> tags;
+    TagsManagerST::Get()->AutoCompleteCandidates(wxFileName(wxT("../tests/test_repeated_expression.h")), 3,
+        wxT("obj->"), LoadFile(wxT("../tests/test_repeated_expression.h")), tags);
+    CHECK_SIZE(tags.size(), CLASS_WITH_MEMBERS_COUNT);
+
+    // A database change drops the cached expressions, the next request resolves the expression again
+    size_t generation = TagsStorageSQLiteCache::GetDbGeneration();
+    TagsStorageSQLiteCache::InvalidateAll();
+    CHECK_CONDITION(
+        TagsStorageSQLiteCache::GetDbGeneration() != generation, "the database generation did not change");
+
+    tags.clear();
+    TagsManagerST::Get()->AutoCompleteCandidates(wxFileName(wxT("../tests/test_repeated_expression.h")), 3,
+        wxT("obj->"), LoadFile(wxT("../tests/test_repeated_expression.h")), tags);
+    CHECK_SIZE(tags.size(), CLASS_WITH_MEMBERS_COUNT);
+    return true;
+}
+
 TEST_FUNC(testBoostForeach)
 {
     std::vector<TagEntryPtr> tags;
@@ -0,0 +1,4 @@
+void foo()
+{
+    ClassWithMembers* obj;
+    obj->
\ No newline at end of file
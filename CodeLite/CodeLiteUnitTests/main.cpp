@@ -0,0 +1,478 @@
+#include <stdio.h>
+#include <string.h>
+#include <wx/init.h>
+#include <wx/regex.h>
+#include <wx/tokenzr.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include "clLinearRegex.h"
+#include "clByteSearcher.h"
+#include "cJSON.h"
+#include "json_node.h"
+#include "cl_tags_binary.h"
+#include "ctags_manager.h"
+#include "tester.h"
+
+// The find in files search compiles its patterns with these flags
+static int GetRegexFlags(bool matchCase) { return wxRE_ADVANCED | (matchCase ? 0 : wxRE_ICASE); }
+
+static void AddMatch(wxString& matches, size_t line, size_t col, size_t len)
+{
+    matches << line << ":" << col << ":" << len << " ";
+}
+
+// Search 'text' line by line with wxRegEx, the same way SearchThread::DoSearchLineRE does
+static wxString FindWithWxRegex(const wxString& pattern, bool matchCase, const wxString& text)
+{
+    wxString matches;
+    wxRegEx re(pattern, GetRegexFlags(matchCase));
+    if(!re.IsValid()) return "<invalid>";
+
+    wxArrayString lines = ::wxStringTokenize(text, "\n", wxTOKEN_RET_EMPTY_ALL);
+    for(size_t i = 0; i < lines.size(); ++i) {
+        const wxString& line = lines.Item(i);
+        size_t col = 0;
+        while(col < line.length() && re.Matches(line.Mid(col), col ? wxRE_NOTBOL : 0)) {
+            size_t start, len;
+            re.GetMatch(&start, &len);
+            if(len == 0) break;
+            AddMatch(matches, i, col + start, len);
+            col += start + len;
+        }
+    }
+    return matches;
+}
+
+// Search the whole buffer at once, the same way SearchThread::DoSearchFileRegex does
+static wxString FindWithLinearRegex(const wxString& pattern, bool matchCase, const wxString& text)
+{
+    clLinearRegex re;
+    if(!re.Compile(pattern, matchCase)) return "<not supported>";
+
+    // The texts are plain ASCII so a byte offset is also a character offset
+    wxCharBuffer cb = text.mb_str(wxConvUTF8);
+    const char* buffer = cb.data();
+    const size_t size = strlen(buffer);
+
+    wxString matches;
+    size_t from = 0, matchStart = 0, matchLen = 0;
+    while(re.Find(buffer, size, from, matchStart, matchLen)) {
+        size_t line = 0, lineStart = 0;
+        for(size_t i = 0; i < matchStart; ++i) {
+            if(buffer[i] == '\n') {
+                ++line;
+                lineStart = i + 1;
+            }
+        }
+        AddMatch(matches, line, matchStart - lineStart, matchLen);
+        from = matchStart + matchLen;
+    }
+    return matches;
+}
+
+// Plain string searches are done with clByteSearcher, compare them with an escaped pattern
+static wxString FindWithByteSearcher(const wxString& needle, bool matchCase, const wxString& text)
+{
+    clByteSearcher searcher(needle.mb_str(wxConvUTF8).data(), matchCase);
+    wxCharBuffer cb = text.mb_str(wxConvUTF8);
+    const char* buffer = cb.data();
+    const char* end = buffer + strlen(buffer);
+
+    wxString matches;
+    wxArrayString lines = ::wxStringTokenize(text, "\n", wxTOKEN_RET_EMPTY_ALL);
+    const char* lineStart = buffer;
+    for(size_t i = 0; i < lines.size(); ++i) {
+        const char* lineEnd = (const char*)memchr(lineStart, '\n', end - lineStart);
+        if(!lineEnd) lineEnd = end;
+        const char* p = lineStart;
+        while((p = searcher.Find(p, lineEnd))) {
+            AddMatch(matches, i, p - lineStart, searcher.GetLength());
+            p += searcher.GetLength();
+        }
+        lineStart = lineEnd + 1;
+    }
+    return matches;
+}
+
+static wxString EscapePattern(const wxString& str)
+{
+    wxString escaped;
+    for(size_t i = 0; i < str.length(); ++i) {
+        if(!wxIsalnum(str[i])) escaped << "\\";
+        escaped << str[i];
+    }
+    return escaped;
+}
+
+struct RegexTestCase {
+    const char* pattern;
+    bool matchCase;
+    const char* text;
+};
+
+static const RegexTestCase kRegexTests[] = {
+    { "foo", true, "foo bar foo\nfoofoo\nFOO" },
+    { "foo", false, "foo bar foo\nfoofoo\nFOO" },
+    { "cat|category", true, "category cat dog" },
+    { "(a|ab)(c|bcd)", true, "abcd abc" },
+    { "[A-Z][a-z]+", true, "Hello World fooBar" },
+    { "[^ ]+", true, "one  two\tthree" },
+    { "[[:digit:]]+", true, "a1 b22 c333" },
+    { "0x[[:xdigit:]]+", true, "0xff 0x 0x1A2b" },
+    { "\\d+\\.\\d*", true, "pi is 3.14, not 3." },
+    { "\\D+", true, "ab12cd" },
+    { "a\\tb", true, "a\tb a b" },
+    { "x{2,3}", true, "xxxxxxx x xx" },
+    { "colou?r", true, "color colour colouur" },
+    { "a.c", true, "abc a-c a\nc" },
+    { "^foo", true, "foo foo\nfoo\n foo" },
+    { "^a", true, "aaa\nba" },
+    { "foo$", true, "foo foo\nfoo\nfoo " },
+    { "get[A-Z][a-z_]*\\(", false, "GetName() getvalue( Get_x(" },
+    { "(ab)+c", true, "ababc abc ac" },
+};
+
+TEST_FUNC(test_linear_regex_matches_wxregex)
+{
+    for(size_t i = 0; i < sizeof(kRegexTests) / sizeof(kRegexTests[0]); ++i) {
+        const RegexTestCase& t = kRegexTests[i];
+        wxString expected = FindWithWxRegex(t.pattern, t.matchCase, t.text);
+        wxString actual = FindWithLinearRegex(t.pattern, t.matchCase, t.text);
+        CHECK_WXSTRING(actual, expected);
+    }
+    return true;
+}
+
+TEST_FUNC(test_linear_regex_unsupported)
+{
+    // Patterns the engine can not match like wxRegEx are rejected so the search falls back to wxRegEx
+    clLinearRegex re;
+    CHECK_BOOL(!re.Compile("(a)\\1", true));
+    CHECK_BOOL(!re.Compile("a+?b", true));
+    CHECK_BOOL(!re.Compile("a*?", true));
+    CHECK_BOOL(!re.Compile("(abc", true));
+
+    // wxRegEx matches these against Unicode letters and spaces (e.g. 'é' is a word character)
+    CHECK_BOOL(!re.Compile("\\w+", true));
+    CHECK_BOOL(!re.Compile("\\W", true));
+    CHECK_BOOL(!re.Compile("\\s+", true));
+    CHECK_BOOL(!re.Compile("\\S", true));
+    CHECK_BOOL(!re.Compile("\\yint\\y", true));
+    CHECK_BOOL(!re.Compile("\\Yint", true));
+    CHECK_BOOL(!re.Compile("\\mwx", true));
+    CHECK_BOOL(!re.Compile("wx\\M", true));
+    CHECK_BOOL(!re.Compile("[[:alpha:]]+", true));
+    CHECK_BOOL(!re.Compile("[^[:space:]]", true));
+    CHECK_BOOL(!re.Compile("[\\w.]", true));
+    CHECK_BOOL(re.Compile("a+b", true));
+    return true;
+}
+
+struct SearchTestCase {
+    const char* needle;
+    bool matchCase;
+    const char* text;
+};
+
+static const SearchTestCase kSearchTests[] = {
+    { "foo", true, "foo bar foo\nfoofoo\nFOO" },
+    { "foo", false, "foo bar foo\nfoofoo\nFOO" },
+    { "aa", true, "aaaaa" },
+    { "a", false, "AaAa\n\na" },
+    { "m_name", false, "M_Name m_name m_namE" },
+    { "->Get(", true, "p->Get(1); p->Get (2);" },
+    { "abcabd", false, "abcabcabd ABCABD" },
+    { "needle", true, "no match here" },
+    { "longer than the text", true, "short" },
+};
+
+TEST_FUNC(test_byte_searcher_matches_wxregex)
+{
+    for(size_t i = 0; i < sizeof(kSearchTests) / sizeof(kSearchTests[0]); ++i) {
+        const SearchTestCase& t = kSearchTests[i];
+        wxString expected = FindWithWxRegex(EscapePattern(t.needle), t.matchCase, t.text);
+        wxString actual = FindWithByteSearcher(t.needle, t.matchCase, t.text);
+        CHECK_WXSTRING(actual, expected);
+    }
+    return true;
+}
+
+static cJSON* ParseJSONBuffer(const char* text)
+{
+    size_t len = strlen(text);
+    char* buffer = cJSON_AllocBuffer(len + 1);
+    memcpy(buffer, text, len + 1);
+    return cJSON_ParseBuffer(buffer);
+}
+
+TEST_FUNC(test_json_parse_buffer)
+{
+    cJSON* root = ParseJSONBuffer("{ \"escaped\" : \"a\\nb\\\"c\\\\d\\/e\\t\", "
+                                  "\"unicode\":\"\\u00e9\\u20ac\\ud83d\\ude00\", "
+                                  "\"raw\":\"\xC3\xA9t\xC3\xA9\", "
+                                  "\"numbers\":[1, -2.5, 1e3], \"bool\":true, \"null\":null }");
+    CHECK_BOOL(root != NULL);
+    CHECK_STRING(cJSON_GetObjectItem(root, "escaped")->valuestring, "a\nb\"c\\d/e\t");
+    CHECK_STRING(cJSON_GetObjectItem(root, "unicode")->valuestring, "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+    CHECK_STRING(cJSON_GetObjectItem(root, "raw")->valuestring, "\xC3\xA9t\xC3\xA9");
+
+    cJSON* numbers = cJSON_GetObjectItem(root, "numbers");
+    CHECK_SIZE(cJSON_GetArraySize(numbers), 3);
+    CHECK_SIZE(cJSON_GetArrayItem(numbers, 0)->valueint, 1);
+    CHECK_BOOL(cJSON_GetArrayItem(numbers, 1)->valuedouble == -2.5);
+    CHECK_SIZE(cJSON_GetArrayItem(numbers, 2)->valueint, 1000);
+    CHECK_SIZE(cJSON_GetObjectItem(root, "bool")->type, cJSON_True);
+    CHECK_SIZE(cJSON_GetObjectItem(root, "null")->type, cJSON_NULL);
+
+    // The document can be printed and parsed again
+    char* text = cJSON_PrintUnformatted(root);
+    cJSON* copy = cJSON_Parse(text);
+    CHECK_BOOL(copy != NULL);
+    CHECK_STRING(cJSON_GetObjectItem(copy, "escaped")->valuestring, "a\nb\"c\\d/e\t");
+    CHECK_STRING(cJSON_GetObjectItem(copy, "unicode")->valuestring, "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+    cJSON_Delete(copy);
+    free(text);
+    cJSON_Delete(root);
+
+    // Malformed documents are rejected (and their buffer released)
+    CHECK_BOOL(ParseJSONBuffer("{\"a\":[1,2}") == NULL);
+    CHECK_BOOL(ParseJSONBuffer("[\"unterminated]") == NULL);
+    CHECK_BOOL(ParseJSONBuffer("") == NULL);
+    return true;
+}
+
+TEST_FUNC(test_json_index)
+{
+    wxString text = "{";
+    for(int i = 0; i < 20; ++i) {
+        text << "\"key" << i << "\":" << i << ",";
+    }
+    text << "\"KEY3\":100, \"array\":[";
+    for(int i = 0; i < 20; ++i) {
+        text << (i ? "," : "") << i * 10;
+    }
+    text << "], \"small\":[1,2,3]}";
+
+    cJSON* root = ParseJSONBuffer(text.mb_str(wxConvUTF8).data());
+    CHECK_BOOL(root != NULL);
+    CHECK_BOOL(root->index != NULL);
+
+    // Case insensitive, the first of the duplicate names wins
+    CHECK_SIZE(cJSON_GetObjectItem(root, "key3")->valueint, 3);
+    CHECK_SIZE(cJSON_GetObjectItem(root, "Key19")->valueint, 19);
+    CHECK_BOOL(cJSON_GetObjectItem(root, "key20") == NULL);
+    CHECK_SIZE(cJSON_GetArraySize(root), 23);
+
+    cJSON* array = cJSON_GetObjectItem(root, "array");
+    CHECK_BOOL(array->index != NULL);
+    CHECK_SIZE(cJSON_GetArraySize(array), 20);
+    CHECK_SIZE(cJSON_GetArrayItem(array, 0)->valueint, 0);
+    CHECK_SIZE(cJSON_GetArrayItem(array, 19)->valueint, 190);
+    CHECK_BOOL(cJSON_GetArrayItem(array, 20) == NULL);
+
+    // Small containers are not indexed
+    cJSON* small = cJSON_GetObjectItem(root, "small");
+    CHECK_BOOL(small->index == NULL);
+    CHECK_SIZE(cJSON_GetArrayItem(small, 2)->valueint, 3);
+
+    // The index is dropped when the children change
+    cJSON_AddItemToArray(array, cJSON_CreateNumber(200));
+    CHECK_BOOL(array->index == NULL);
+    CHECK_SIZE(cJSON_GetArraySize(array), 21);
+    CHECK_SIZE(cJSON_GetArrayItem(array, 20)->valueint, 200);
+
+    cJSON_DeleteItemFromObject(root, "key3");
+    CHECK_BOOL(root->index == NULL);
+    CHECK_SIZE(cJSON_GetObjectItem(root, "key3")->valueint, 100);
+    cJSON_Delete(root);
+    return true;
+}
+
+TEST_FUNC(test_json_array_reader)
+{
+    // Larger than a read chunk, with separators inside the strings
+    const int count = 5000;
+    wxString content = "[\n";
+    for(int i = 0; i < count; ++i) {
+        content << "  {\"file\":\"file" << i << ".cpp\", \"command\":\"g++ -D'A=\\\"],{\\\"' file" << i
+                << ".cpp\", \"args\":[" << i << ",{}]},\n";
+    }
+    content << "  42, null, \"last\"\n]\n";
+
+    wxFileName fn(wxFileName::GetTempDir(), "CodeLiteUnitTests.json");
+    {
+        wxFFile fp(fn.GetFullPath(), "wb");
+        CHECK_BOOL(fp.IsOpened());
+        const wxCharBuffer cb = content.mb_str(wxConvUTF8);
+        fp.Write("\xEF\xBB\xBF", 3); // UTF-8 BOM
+        fp.Write(cb.data(), cb.length());
+    }
+
+    JSONArrayReader reader(fn);
+    CHECK_BOOL(reader.isOk());
+    int items = 0;
+    for(; items < count; ++items) {
+        JSONElement item = reader.next();
+        if(!item.isOk()) break;
+        wxString file;
+        file << "file" << items << ".cpp";
+        if(item.namedObject("file").toString() != file) break;
+        if(item.namedObject("command").toString() != "g++ -D'A=\"],{\"' " + file) break;
+        if(item.namedObject("args").arrayItem(0).toInt() != items) break;
+    }
+    CHECK_SIZE(items, count);
+    CHECK_SIZE(reader.next().toInt(), 42);
+    CHECK_BOOL(reader.next().isNull());
+    CHECK_WXSTRING(reader.next().toString(), "last");
+    CHECK_BOOL(!reader.next().isOk());
+    CHECK_BOOL(!reader.isOk());
+    ::wxRemoveFile(fn.GetFullPath());
+    return true;
+}
+
+static void AddBinaryTag(clTagsBinaryWriter& writer,
+                         const char* name,
+                         const char* pattern,
+                         const char* kind,
+                         const char* scopeKind,
+                         const char* scopeName,
+                         long line,
+                         unsigned int flags = 0)
+{
+    const char* fields[kTagFieldsCount] = { 0 };
+    fields[kTagName] = name;
+    fields[kTagFile] = "/src/colors.h";
+    fields[kTagPattern] = pattern;
+    fields[kTagKind] = kind;
+    fields[kTagLanguage] = "C++";
+    fields[kTagScopeKind] = scopeKind;
+    fields[kTagScopeName] = scopeName;
+    fields[kTagAccess] = ""; // same as not set
+    writer.Add(fields, line, flags);
+}
+
+static void BuildTagsBinary(std::string& buffer)
+{
+    clTagsBinaryWriter writer;
+    AddBinaryTag(writer, "Color", "/^enum class Color {$/", "enum", "namespace", "ns", 3);
+    AddBinaryTag(writer, "Red", "/^    Red,$/", "enumerator", "enum", "ns::Color", 4);
+    AddBinaryTag(writer, "Mode", "/^enum Mode {$/", "enum", "namespace", "ns", 8);
+    AddBinaryTag(writer, "Fast", "/^    Fast$/", "enumerator", "enum", "ns::Mode", -1, kTagFileScope);
+    writer.Serialize(buffer);
+}
+
+TEST_FUNC(test_tags_binary_round_trip)
+{
+    std::string buffer;
+    BuildTagsBinary(buffer);
+
+    clTagsBinaryReader reader;
+    CHECK_BOOL(reader.Open(buffer));
+    CHECK_SIZE(reader.GetRecordsCount(), 4);
+
+    // slot 0 is the empty string, used for the unset and the empty fields
+    CHECK_STRING(reader.GetString(0), "");
+    const clTagsBinaryRecord& red = reader.GetRecord(1);
+    CHECK_SIZE(red.fields[kTagAccess], 0);
+    CHECK_SIZE(red.fields[kTagSignature], 0);
+    CHECK_STRING(reader.GetString(red.fields[kTagName]), "Red");
+    CHECK_STRING(reader.GetString(red.fields[kTagScopeName]), "ns::Color");
+    CHECK_SIZE(red.line, 4);
+
+    // every string is stored once
+    const clTagsBinaryRecord& fast = reader.GetRecord(3);
+    CHECK_SIZE(fast.fields[kTagFile], red.fields[kTagFile]);
+    CHECK_SIZE(fast.fields[kTagKind], red.fields[kTagKind]);
+    CHECK_SIZE(fast.line, -1);
+    CHECK_SIZE(fast.flags, kTagFileScope);
+    return true;
+}
+
+TEST_FUNC(test_tags_binary_rejects_invalid_buffers)
+{
+    std::string buffer;
+    BuildTagsBinary(buffer);
+
+    // every truncation is rejected (the copies have the exact size, so a read past the end is caught by ASAN)
+    clTagsBinaryReader reader;
+    size_t accepted = 0;
+    for(size_t len = 0; len < buffer.size(); ++len) {
+        if(reader.Open(buffer.substr(0, len))) {
+            ++accepted;
+        }
+    }
+    CHECK_SIZE(accepted, 0);
+    CHECK_BOOL(!reader.Open(buffer + '\0'));
+
+    clTagsBinaryHeader header;
+    memcpy(&header, buffer.data(), sizeof(header));
+    const size_t offsetsPos = sizeof(header);
+    const size_t recordsPos = offsetsPos + header.stringsCount * sizeof(unsigned int);
+
+    std::string corrupt = buffer;
+    corrupt[0] = 'X'; // magic
+    CHECK_BOOL(!reader.Open(corrupt));
+
+    // a string offset outside of the strings pool
+    corrupt = buffer;
+    unsigned int offset = header.stringsSize;
+    memcpy(&corrupt[offsetsPos + sizeof(unsigned int)], &offset, sizeof(offset));
+    CHECK_BOOL(!reader.Open(corrupt));
+
+    // slot 0 is not the empty string
+    corrupt = buffer;
+    offset = 1;
+    memcpy(&corrupt[offsetsPos], &offset, sizeof(offset));
+    CHECK_BOOL(!reader.Open(corrupt));
+
+    // a field referring to a string that does not exist
+    corrupt = buffer;
+    unsigned int index = header.stringsCount;
+    memcpy(&corrupt[recordsPos + kTagName * sizeof(unsigned int)], &index, sizeof(index));
+    CHECK_BOOL(!reader.Open(corrupt));
+
+    // the strings pool is not NUL terminated
+    corrupt = buffer;
+    corrupt[corrupt.size() - 1] = 'X';
+    CHECK_BOOL(!reader.Open(corrupt));
+
+    // the reader is not attached after a failure
+    CHECK_SIZE(reader.GetRecordsCount(), 0);
+
+    // an invalid reply adds no tags
+    TagEntryPtrVector_t tags;
+    TagsManagerST::Get()->TagsFromBinary(corrupt, tags);
+    CHECK_SIZE(tags.size(), 0);
+    return true;
+}
+
+TEST_FUNC(test_tags_binary_enum_namespace)
+{
+    std::string buffer;
+    BuildTagsBinary(buffer);
+
+    TagEntryPtrVector_t tags;
+    TagsManagerST::Get()->TagsFromBinary(buffer, tags);
+    CHECK_SIZE(tags.size(), 4);
+
+    // the enumerators of an "enum class" live in the enum scope
+    CHECK_WXSTRING(tags.at(1)->GetName(), "Red");
+    CHECK_WXSTRING(tags.at(1)->GetScope(), "ns::Color");
+    CHECK_WXSTRING(tags.at(1)->GetTyperef(), "");
+    CHECK_SIZE(tags.at(1)->GetLine(), 4);
+
+    // the enumerators of a plain enum live in the enclosing scope, typed by the enum
+    CHECK_WXSTRING(tags.at(3)->GetName(), "Fast");
+    CHECK_WXSTRING(tags.at(3)->GetScope(), "ns");
+    CHECK_WXSTRING(tags.at(3)->GetTyperef(), "ns::Mode");
+    CHECK_WXSTRING(tags.at(3)->GetFile(), "/src/colors.h");
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    wxInitialize(argc, argv);
+    Tester::Instance()->RunTests();
+    wxUninitialize();
+    return 0;
+}
@@ -3,8 +3,10 @@
 #include "file_logger.h"
 
 CxxPreProcessor::CxxPreProcessor()
-    : m_maxDepth(-1)
+    : m_options(0)
+    , m_maxDepth(-1)
     , m_currentDepth(0)
+    , m_cacheValidated(false)
 {
 }
 
@@ -19,6 +21,9 @@ void CxxPreProcessor::Parse(const wxFileName& filename, size_t options)
         scanner = new CxxPreProcessorScanner(filename, m_options);
         // Remove the option so recursive scanner won't get it
         m_options &= ~kLexerOpt_DontCollectMacrosDefinedInThisFile;
+        m_cacheKey.Clear();
+        m_cacheValidated = false;
+        m_summaries.clear();
         if(scanner && !scanner->IsNull()) {
             scanner->Parse(this);
         }
@@ -43,57 +48,57 @@ void CxxPreProcessor::Parse(const wxFileName& filename, size_t options)
 bool
 CxxPreProcessor::ExpandInclude(const wxFileName& currentFile, const wxString& includeStatement, wxFileName& outFile)
 {
+    if(!m_cacheValidated) {
+        // pick up the changes made to the file system since the previous run
+        CxxPreProcessorSharedCache::Get().Revalidate();
+        m_cacheValidated = true;
+    }
+
+    // if this file has a mapped file, it means that we either
+    // already scanned it or could not find a match for it
+    bool alreadySeen = m_noSuchFiles.count(includeStatement) || m_fileMapping.count(includeStatement);
+    if(!m_summaries.empty()) {
+        CxxPreProcessorSharedCache::Summary::Ptr_t summary = m_summaries.back();
+        if(!summary->includes.count(includeStatement) && !summary->includeDeps.count(includeStatement)) {
+            summary->includeDeps.insert(std::make_pair(includeStatement, alreadySeen));
+        }
+    }
+
+    if(alreadySeen) {
+        return false;
+    }
+
     wxString includeName = includeStatement;
     includeName.Replace("\"", "");
     includeName.Replace("<", "");
     includeName.Replace(">", "");
 
     // Try the current file's directory first
-    wxArrayString paths = m_includePaths;
-    paths.Insert(currentFile.GetPath(), 0);
+    wxString resolved;
+    CxxPreProcessorSharedCache::Get().ResolveInclude(
+        GetCacheKey(), m_includePaths, currentFile.GetPath(), includeName, resolved);
 
-    if(m_noSuchFiles.count(includeStatement)) {
-        // wxPrintf("No such file hit\n");
-        return false;
+    m_fileMapping.insert(std::make_pair(includeStatement, resolved));
+    if(!m_summaries.empty()) {
+        m_summaries.back()->includes[includeStatement] = resolved;
     }
 
-    std::map<wxString, wxString>::iterator iter = m_fileMapping.find(includeStatement);
-    if(iter != m_fileMapping.end()) {
-        // if this file has a mapped file, it means that we either
-        // already scanned it or could not find a match for it
-        // wxPrintf("File already been scanned\n");
+    if(resolved.IsEmpty()) {
+        // remember that we could not locate this include statement
+        m_noSuchFiles.insert(includeStatement);
         return false;
     }
 
-    for(size_t i = 0; i < paths.GetCount(); ++i) {
-        wxString tmpfile;
-        tmpfile << paths.Item(i) << "/" << includeName;
-        wxFileName fn(tmpfile);
-        tmpfile = fn.GetFullPath();
-        // CL_DEBUG(" ... Checking include file: %s\n", fn.GetFullPath());
-        struct stat buff;
-        if((stat(tmpfile.mb_str(wxConvUTF8).data(), &buff) == 0)) {
-            CL_DEBUG1(" ==> Creating scanner for file: %s\n", tmpfile);
-            wxFileName fixedFileName(tmpfile);
-            if(fixedFileName.FileExists()) {
-                fixedFileName.Normalize(wxPATH_NORM_DOTS);
-                tmpfile = fixedFileName.GetFullPath();
-                m_fileMapping.insert(std::make_pair(includeStatement, tmpfile));
-                outFile = fixedFileName;
-                return true;
-            } else {
-                CL_DEBUG("Including a folder :/ : %s", fixedFileName.GetFullPath());
-            }
-        }
-    }
-
-    // remember that we could not locate this include statement
-    m_noSuchFiles.insert(includeStatement);
-    m_fileMapping.insert(std::make_pair(includeStatement, wxString()));
-    return false;
+    CL_DEBUG1(" ==> Creating scanner for file: %s\n", resolved);
+    outFile = wxFileName(resolved);
+    return true;
 }
 
-void CxxPreProcessor::AddIncludePath(const wxString& path) { m_includePaths.Add(path); }
+void CxxPreProcessor::AddIncludePath(const wxString& path)
+{
+    m_includePaths.Add(path);
+    m_cacheKey.Clear();
+}
 
 void CxxPreProcessor::AddDefinition(const wxString& def)
 {
@@ -134,6 +139,7 @@ wxString CxxPreProcessor::GetGxxCommand(const wxString& gxx, const wxString& fil
 
 void CxxPreProcessor::SetIncludePaths(const wxArrayString& includePaths)
 {
+    m_cacheKey.Clear();
     m_includePaths.Clear();
     for(size_t i = 0; i < includePaths.GetCount(); ++i) {
         wxString path = includePaths.Item(i);
@@ -161,3 +167,101 @@ void CxxPreProcessor::DecDepth()
 }
 
 void CxxPreProcessor::IncDepth() { m_currentDepth++; }
+
+const wxString& CxxPreProcessor::GetCacheKey()
+{
+    // the include files and the macro values collected depend on the search paths and the options
+    if(m_cacheKey.IsEmpty()) {
+        m_cacheKey << (int)m_options;
+        for(size_t i = 0; i < m_includePaths.GetCount(); ++i) {
+            m_cacheKey << "\n" << m_includePaths.Item(i);
+        }
+    }
+    return m_cacheKey;
+}
+
+void CxxPreProcessor::RecordMacroRead(const wxString& name)
+{
+    if(m_summaries.empty()) return;
+
+    // a macro the header already defined (or undefined) does not depend on the incoming state
+    CxxPreProcessorSharedCache::Summary::Ptr_t summary = m_summaries.back();
+    if(summary->macros.count(name) || summary->macroDeps.count(name)) return;
+
+    CxxPreProcessorSharedCache::MacroState state;
+    CxxPreProcessorToken::Map_t::const_iterator iter = m_tokens.find(name);
+    if(iter != m_tokens.end()) {
+        state = CxxPreProcessorSharedCache::MacroState(true, iter->second.value);
+    }
+    summary->macroDeps.insert(std::make_pair(name, state));
+}
+
+void CxxPreProcessor::DefineMacro(const CxxPreProcessorToken& token)
+{
+    // the first definition wins, so the result depends on whether the macro is already defined
+    RecordMacroRead(token.name);
+    if(m_tokens.insert(std::make_pair(token.name, token)).second && !m_summaries.empty()) {
+        m_summaries.back()->macros[token.name] = CxxPreProcessorSharedCache::MacroState(true, token.value);
+    }
+}
+
+void CxxPreProcessor::UndefineMacro(const wxString& name)
+{
+    m_tokens.erase(name);
+    if(!m_summaries.empty()) {
+        m_summaries.back()->macros[name] = CxxPreProcessorSharedCache::MacroState();
+    }
+}
+
+bool CxxPreProcessor::ApplyHeaderSummary(const wxFileName& filename)
+{
+    CxxPreProcessorSharedCache::Summary::Ptr_t summary = CxxPreProcessorSharedCache::Get().FindSummary(
+        GetCacheKey(), filename.GetFullPath(), m_tokens, m_fileMapping);
+    if(!summary) return false;
+
+    CL_DEBUG1(" ==> Using cached summary for file: %s\n", filename.GetFullPath());
+    CxxPreProcessorSharedCache::Summary::MacroMap_t::const_iterator iter = summary->macros.begin();
+    for(; iter != summary->macros.end(); ++iter) {
+        if(iter->second.defined) {
+            CxxPreProcessorToken token;
+            token.name = iter->first;
+            token.value = iter->second.value;
+            m_tokens[iter->first] = token;
+        } else {
+            m_tokens.erase(iter->first);
+        }
+    }
+
+    std::map<wxString, wxString>::const_iterator fileIter = summary->includes.begin();
+    for(; fileIter != summary->includes.end(); ++fileIter) {
+        m_fileMapping.insert(*fileIter);
+        if(fileIter->second.IsEmpty()) {
+            m_noSuchFiles.insert(fileIter->first);
+        }
+    }
+
+    // the including header inherits the dependencies of this one
+    if(!m_summaries.empty()) {
+        m_summaries.back()->Merge(*summary);
+    }
+    return true;
+}
+
+void CxxPreProcessor::BeginHeaderSummary(const wxFileName& filename)
+{
+    CxxPreProcessorSharedCache::Summary::Ptr_t summary(new CxxPreProcessorSharedCache::Summary());
+    summary->stamped = CxxPreProcessorSharedCache::GetStat(filename.GetFullPath(), summary->stamp);
+    m_summaries.push_back(summary);
+}
+
+void CxxPreProcessor::EndHeaderSummary(const wxFileName& filename)
+{
+    if(m_summaries.empty()) return;
+
+    CxxPreProcessorSharedCache::Summary::Ptr_t summary = m_summaries.back();
+    m_summaries.pop_back();
+    if(!m_summaries.empty()) {
+        m_summaries.back()->Merge(*summary);
+    }
+    CxxPreProcessorSharedCache::Get().AddSummary(GetCacheKey(), filename.GetFullPath(), summary);
+}
@@ -29,7 +29,9 @@
 #include "CxxLexerAPI.h"
 #include <wx/filename.h>
 #include "CxxPreProcessorScanner.h"
+#include "CxxPreProcessorSharedCache.h"
 #include <set>
+#include <vector>
 #include "codelite_exports.h"
 
 class WXDLLIMPEXP_CL CxxPreProcessor
@@ -41,6 +43,13 @@ class WXDLLIMPEXP_CL CxxPreProcessor
     size_t m_options;
     int m_maxDepth;
     int m_currentDepth;
+    wxString m_cacheKey;
+    bool m_cacheValidated;
+    // the summaries of the headers currently being scanned (innermost last)
+    std::vector<CxxPreProcessorSharedCache::Summary::Ptr_t> m_summaries;
+
+protected:
+    const wxString& GetCacheKey();
 
 public:
     CxxPreProcessor();
@@ -55,7 +64,11 @@ public:
     void SetIncludePaths(const wxArrayString& includePaths);
     const wxArrayString& GetIncludePaths() const { return m_includePaths; }
 
-    void SetOptions(size_t options) { this->m_options = options; }
+    void SetOptions(size_t options)
+    {
+        this->m_options = options;
+        m_cacheKey.Clear();
+    }
     size_t GetOptions() const { return m_options; }
     /**
      * @brief return a command that generates a single file with all defines in it
@@ -111,6 +124,36 @@ public:
      * @brief decrease the current include depth
      */
     void DecDepth();
+
+    // Header summaries, see CxxPreProcessorSharedCache
+    // The scanner reports every macro a condition tests and every macro it defines or undefines,
+    // so the effect of a header can be recorded and replayed the next time it is included
+
+    /**
+     * @brief a condition tested 'name'
+     */
+    void RecordMacroRead(const wxString& name);
+    /**
+     * @brief #define: add 'token' to the table (an existing definition is kept)
+     */
+    void DefineMacro(const CxxPreProcessorToken& token);
+    /**
+     * @brief #undef: remove 'name' from the table
+     */
+    void UndefineMacro(const wxString& name);
+    /**
+     * @brief if 'filename' was already scanned with the same incoming state, apply its recorded
+     * effect and return true. The caller should not scan the file in this case
+     */
+    bool ApplyHeaderSummary(const wxFileName& filename);
+    /**
+     * @brief start recording the effect of 'filename'. Must be called before the file is read
+     */
+    void BeginHeaderSummary(const wxFileName& filename);
+    /**
+     * @brief 'filename' was scanned, store its summary in the shared cache
+     */
+    void EndHeaderSummary(const wxFileName& filename);
 };
 
 #endif // CXXPREPROCESSOR_H
@@ -69,7 +69,6 @@ void CxxPreProcessorScanner::Parse(CxxPreProcessor* pp) throw(CxxLexerException)
 {
     CxxLexerToken token;
     bool searchingForBranch = false;
-    CxxPreProcessorToken::Map_t& ppTable = pp->GetTokens();
     while(::LexerNext(m_scanner, token)) {
         // Pre Processor state
         switch(token.type) {
@@ -77,6 +76,11 @@ void CxxPreProcessorScanner::Parse(CxxPreProcessor* pp) throw(CxxLexerException)
             // we found an include statement, recurse into it
             wxFileName include;
             if(pp->ExpandInclude(m_filename, token.text, include)) {
+                // a header already scanned with the same incoming state is replayed from the cache
+                if(pp->ApplyHeaderSummary(include)) {
+                    break;
+                }
+                pp->BeginHeaderSummary(include);
                 CxxPreProcessorScanner* scanner = new CxxPreProcessorScanner(include, pp->GetOptions());
                 try {
                     if(scanner && !scanner->IsNull()) {
@@ -86,6 +90,7 @@ void CxxPreProcessorScanner::Parse(CxxPreProcessor* pp) throw(CxxLexerException)
                     // catch the exception
                     CL_DEBUG("Exception caught: %s\n", e.message);
                 }
+                pp->EndHeaderSummary(include);
                 // make sure we always delete the scanner
                 wxDELETE(scanner);
                 DEBUGMSG("<== Resuming parser on file: %s\n", m_filename.GetFullPath());
@@ -96,7 +101,7 @@ void CxxPreProcessorScanner::Parse(CxxPreProcessor* pp) throw(CxxLexerException)
             searchingForBranch = true;
             // read the identifier
             ReadUntilMatch(T_PP_IDENTIFIER, token);
-            if(IsTokenExists(ppTable, token)) {
+            if(IsTokenExists(pp, token)) {
                 DEBUGMSG("=> ifdef condition is TRUE (line: %d)\n", token.lineNumber);
                 searchingForBranch = false;
                 // condition is true
@@ -113,7 +118,7 @@ void CxxPreProcessorScanner::Parse(CxxPreProcessor* pp) throw(CxxLexerException)
             searchingForBranch = true;
             // read the identifier
             ReadUntilMatch(T_PP_IDENTIFIER, token);
-            if(!IsTokenExists(ppTable, token)) {
+            if(!IsTokenExists(pp, token)) {
                 DEBUGMSG("=> ifndef condition is TRUE (line: %d)\n", token.lineNumber);
                 searchingForBranch = false;
                 // condition is true
@@ -131,7 +136,7 @@ void CxxPreProcessorScanner::Parse(CxxPreProcessor* pp) throw(CxxLexerException)
         case T_PP_ELIF: {
             if(searchingForBranch) {
                 // We expect a condition
-                if(!CheckIf(ppTable)) {
+                if(!CheckIf(pp)) {
                     DEBUGMSG("=> if condition is FALSE (line: %d)\n", token.lineNumber);
                     // skip until we find the next:
                     // else, elif, endif (but do not consume these tokens)
@@ -179,13 +184,30 @@ void CxxPreProcessorScanner::Parse(CxxPreProcessor* pp) throw(CxxLexerException)
             // Optionally get the value
             GetRestOfPPLine(macroValue, m_options & kLexerOpt_CollectMacroValueNumbers);
 
-            CxxPreProcessorToken pp;
-            pp.name = macroName;
-            pp.value = macroValue;
+            CxxPreProcessorToken macro;
+            macro.name = macroName;
+            macro.value = macroValue;
             // mark this token for deletion when the entire TU parsing is done
-            pp.deleteOnExit = (m_options & kLexerOpt_DontCollectMacrosDefinedInThisFile);
-            DEBUGMSG("=> Adding macro: %s=%s (line %d)\n", pp.name, pp.value, token.lineNumber);
-            ppTable.insert(std::make_pair(pp.name, pp));
+            macro.deleteOnExit = (m_options & kLexerOpt_DontCollectMacrosDefinedInThisFile);
+            DEBUGMSG("=> Adding macro: %s=%s (line %d)\n", macro.name, macro.value, token.lineNumber);
+            pp->DefineMacro(macro);
+            break;
+        }
+        case T_PP_UNDEF: {
+            if(!::LexerNext(m_scanner, token) || token.type != T_PP_IDENTIFIER) {
+                // Recover
+                wxString dummy;
+                GetRestOfPPLine(dummy);
+                break;
+            }
+            wxString macroName = token.text;
+
+            // consume the rest of the line
+            wxString dummy;
+            GetRestOfPPLine(dummy);
+
+            DEBUGMSG("=> Removing macro: %s (line %d)\n", macroName, token.lineNumber);
+            pp->UndefineMacro(macroName);
             break;
         }
         }
@@ -227,8 +249,9 @@ struct ExpressionLocker {
     ~ExpressionLocker() { wxDELETE(m_expr); }
 };
 
-bool CxxPreProcessorScanner::CheckIf(const CxxPreProcessorToken::Map_t& table)
+bool CxxPreProcessorScanner::CheckIf(CxxPreProcessor* pp)
 {
+    const CxxPreProcessorToken::Map_t& table = pp->GetTokens();
     // we currently support
     // #if IDENTIFIER
     // #if NUMBER
@@ -293,6 +316,7 @@ bool CxxPreProcessorScanner::CheckIf(const CxxPreProcessorToken::Map_t& table)
         }
         case T_PP_IDENTIFIER: {
             wxString identifier = token.text;
+            pp->RecordMacroRead(identifier);
             CxxPreProcessorToken::Map_t::const_iterator iter = table.find(identifier);
             if(iter == table.end()) {
                 SET_CUR_EXPR_VALUE_RET_FALSE(0);
@@ -401,7 +425,8 @@ void CxxPreProcessorScanner::ReadUntilMatch(int type, CxxLexerToken& token) thro
     throw CxxLexerException(wxString() << "<<EOF>> Could not find a match for type: " << type);
 }
 
-bool CxxPreProcessorScanner::IsTokenExists(const CxxPreProcessorToken::Map_t& table, const CxxLexerToken& token)
+bool CxxPreProcessorScanner::IsTokenExists(CxxPreProcessor* pp, const CxxLexerToken& token)
 {
-    return table.count(token.text);
+    pp->RecordMacroRead(token.text);
+    return pp->GetTokens().count(token.text);
 }
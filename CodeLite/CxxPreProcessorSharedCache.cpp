@@ -0,0 +1,302 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : CxxPreProcessorSharedCache.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+#include "CxxPreProcessorSharedCache.h"
+#include <wx/filename.h>
+#include <wx/filefn.h>
+#include <wx/dir.h>
+#include <wx/log.h>
+#include "file_logger.h"
+#include "fileutils.h"
+#include <wx/stopwatch.h>
+
+// the number of summaries kept per header (a header included with different macros defined)
+static const size_t MAX_SUMMARY_VARIANTS = 8;
+
+// the file system is checked at most once in this period
+static const int REVALIDATE_INTERVAL_MS = 1000;
+
+bool CxxPreProcessorSharedCache::Summary::Matches(const CxxPreProcessorToken::Map_t& tokens,
+                                                  const std::map<wxString, wxString>& seenIncludes) const
+{
+    MacroMap_t::const_iterator iter = macroDeps.begin();
+    for(; iter != macroDeps.end(); ++iter) {
+        CxxPreProcessorToken::Map_t::const_iterator token = tokens.find(iter->first);
+        MacroState current;
+        if(token != tokens.end()) {
+            current = MacroState(true, token->second.value);
+        }
+        if(!(current == iter->second)) return false;
+    }
+
+    std::map<wxString, bool>::const_iterator includeIter = includeDeps.begin();
+    for(; includeIter != includeDeps.end(); ++includeIter) {
+        bool seen = (seenIncludes.count(includeIter->first) > 0);
+        if(seen != includeIter->second) return false;
+    }
+    return true;
+}
+
+void CxxPreProcessorSharedCache::Summary::Merge(const Summary& nested)
+{
+    // the nested header depends on what was defined before it was included. What this
+    // header defined itself is not a dependency of this header
+    MacroMap_t::const_iterator iter = nested.macroDeps.begin();
+    for(; iter != nested.macroDeps.end(); ++iter) {
+        if(macros.count(iter->first) == 0 && macroDeps.count(iter->first) == 0) {
+            macroDeps.insert(*iter);
+        }
+    }
+
+    std::map<wxString, bool>::const_iterator includeIter = nested.includeDeps.begin();
+    for(; includeIter != nested.includeDeps.end(); ++includeIter) {
+        if(includes.count(includeIter->first) == 0 && includeDeps.count(includeIter->first) == 0) {
+            includeDeps.insert(*includeIter);
+        }
+    }
+
+    // the nested header effect is applied on top of ours
+    iter = nested.macros.begin();
+    for(; iter != nested.macros.end(); ++iter) {
+        macros[iter->first] = iter->second;
+    }
+
+    std::map<wxString, wxString>::const_iterator fileIter = nested.includes.begin();
+    for(; fileIter != nested.includes.end(); ++fileIter) {
+        includes[fileIter->first] = fileIter->second;
+    }
+}
+
+CxxPreProcessorSharedCache::CxxPreProcessorSharedCache()
+    : m_lastRevalidate(0)
+{
+}
+
+CxxPreProcessorSharedCache::~CxxPreProcessorSharedCache() {}
+
+CxxPreProcessorSharedCache& CxxPreProcessorSharedCache::Get()
+{
+    static CxxPreProcessorSharedCache theCache;
+    return theCache;
+}
+
+bool CxxPreProcessorSharedCache::GetStat(const wxString& path, FileStamp& stamp)
+{
+    if(!FileUtils::GetFileStat(path, stamp.mtime, stamp.size)) {
+        stamp = FileStamp();
+        return false;
+    }
+    return true;
+}
+
+const CxxPreProcessorSharedCache::DirEntry& CxxPreProcessorSharedCache::DoGetDir(const wxString& dir)
+{
+    std::map<wxString, DirEntry>::iterator iter = m_dirs.find(dir);
+    if(iter != m_dirs.end()) {
+        return iter->second;
+    }
+
+    DirEntry& entry = m_dirs[dir];
+    if(GetStat(dir, entry.stamp)) {
+        // list the files (folders are not valid include files)
+        wxLogNull noLog;
+        wxDir d;
+        if(d.Open(dir)) {
+            wxString filename;
+            bool cont = d.GetFirst(&filename, wxEmptyString, wxDIR_FILES | wxDIR_HIDDEN);
+            while(cont) {
+                if(!wxFileName::IsCaseSensitive()) {
+                    filename.MakeLower();
+                }
+                entry.files.insert(filename);
+                cont = d.GetNext(&filename);
+            }
+        }
+    }
+    return entry;
+}
+
+void CxxPreProcessorSharedCache::Revalidate()
+{
+    // Copy the stamps to check, the file system is accessed without holding the lock
+    std::map<wxString, FileStamp> dirs;
+    std::map<wxString, FileStamp> files;
+    bool fileModified = false;
+    {
+        wxCriticalSectionLocker locker(m_cs);
+        wxInt64 now = wxGetUTCTimeMillis().GetValue();
+        if(m_lastRevalidate != 0 && now >= m_lastRevalidate && (now - m_lastRevalidate) < REVALIDATE_INTERVAL_MS) {
+            return;
+        }
+        m_lastRevalidate = now;
+
+        std::map<wxString, DirEntry>::const_iterator dirIter = m_dirs.begin();
+        for(; dirIter != m_dirs.end(); ++dirIter) {
+            dirs.insert(std::make_pair(dirIter->first, dirIter->second.stamp));
+        }
+
+        std::map<wxString, FileMap_t>::const_iterator keyIter = m_summaries.begin();
+        for(; keyIter != m_summaries.end() && !fileModified; ++keyIter) {
+            FileMap_t::const_iterator fileIter = keyIter->second.begin();
+            for(; fileIter != keyIter->second.end(); ++fileIter) {
+                std::map<wxString, FileStamp>::iterator iter =
+                    files.insert(std::make_pair(fileIter->first, fileIter->second.stamp)).first;
+                if(iter->second != fileIter->second.stamp) {
+                    // two versions of the same header: at least one of them is stale
+                    fileModified = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // a directory was modified (a file was added, removed or saved by renaming): an include
+    // statement may now resolve to a different file
+    std::vector<wxString> modifiedDirs;
+    std::map<wxString, FileStamp>::const_iterator iter = dirs.begin();
+    for(; iter != dirs.end(); ++iter) {
+        FileStamp stamp;
+        GetStat(iter->first, stamp);
+        if(stamp != iter->second) {
+            modifiedDirs.push_back(iter->first);
+        }
+    }
+
+    // a modified header affects the summaries of all the headers including it. We don't keep
+    // track of who includes whom, so drop all the summaries
+    iter = files.begin();
+    for(; iter != files.end() && !fileModified && modifiedDirs.empty(); ++iter) {
+        FileStamp stamp;
+        GetStat(iter->first, stamp);
+        if(stamp != iter->second) {
+            CL_DEBUG1("CxxPreProcessorSharedCache: %s was modified, clearing summaries\n", iter->first);
+            fileModified = true;
+        }
+    }
+
+    wxCriticalSectionLocker locker(m_cs);
+    if(!modifiedDirs.empty()) {
+        CL_DEBUG1("CxxPreProcessorSharedCache: include directories were modified, clearing cache\n");
+        for(size_t i = 0; i < modifiedDirs.size(); ++i) {
+            m_dirs.erase(modifiedDirs.at(i));
+        }
+        m_resolved.clear();
+        m_summaries.clear();
+
+    } else if(fileModified) {
+        m_summaries.clear();
+    }
+}
+
+void CxxPreProcessorSharedCache::Clear()
+{
+    wxCriticalSectionLocker locker(m_cs);
+    m_dirs.clear();
+    m_resolved.clear();
+    m_summaries.clear();
+    m_lastRevalidate = 0;
+}
+
+bool CxxPreProcessorSharedCache::ResolveInclude(const wxString& key,
+                                                const wxArrayString& includePaths,
+                                                const wxString& currentDir,
+                                                const wxString& includeName,
+                                                wxString& resolved)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    ResolvedMap_t& resolvedMap = m_resolved[key];
+
+    wxString lookupKey;
+    lookupKey << currentDir << "\n" << includeName;
+    ResolvedMap_t::iterator iter = resolvedMap.find(lookupKey);
+    if(iter != resolvedMap.end()) {
+        resolved = iter->second;
+        return !resolved.IsEmpty();
+    }
+
+    // Try the current file's directory first
+    resolved.Clear();
+    for(size_t i = 0; i <= includePaths.GetCount(); ++i) {
+        wxString tmpfile;
+        tmpfile << (i == 0 ? currentDir : includePaths.Item(i - 1)) << "/" << includeName;
+        wxFileName fn(tmpfile);
+
+        wxString name = fn.GetFullName();
+        if(name.IsEmpty()) continue;
+        if(!wxFileName::IsCaseSensitive()) {
+            name.MakeLower();
+        }
+
+        const DirEntry& dir = DoGetDir(fn.GetPath());
+        if(dir.files.count(name)) {
+            fn.Normalize(wxPATH_NORM_DOTS);
+            resolved = fn.GetFullPath();
+            break;
+        }
+    }
+
+    resolvedMap.insert(std::make_pair(lookupKey, resolved));
+    return !resolved.IsEmpty();
+}
+
+CxxPreProcessorSharedCache::Summary::Ptr_t
+CxxPreProcessorSharedCache::FindSummary(const wxString& key,
+                                        const wxString& filename,
+                                        const CxxPreProcessorToken::Map_t& tokens,
+                                        const std::map<wxString, wxString>& seenIncludes)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    std::map<wxString, FileMap_t>::iterator keyIter = m_summaries.find(key);
+    if(keyIter == m_summaries.end()) return Summary::Ptr_t(NULL);
+
+    FileMap_t::iterator fileIter = keyIter->second.find(filename);
+    if(fileIter == keyIter->second.end()) return Summary::Ptr_t(NULL);
+
+    const std::vector<Summary::Ptr_t>& variants = fileIter->second.variants;
+    for(size_t i = 0; i < variants.size(); ++i) {
+        if(variants.at(i)->Matches(tokens, seenIncludes)) {
+            return variants.at(i);
+        }
+    }
+    return Summary::Ptr_t(NULL);
+}
+
+void CxxPreProcessorSharedCache::AddSummary(const wxString& key, const wxString& filename, Summary::Ptr_t summary)
+{
+    // Without a stamp taken before the header was read, a change made while it was scanned would go unnoticed
+    if(!summary->stamped) return;
+
+    wxCriticalSectionLocker locker(m_cs);
+    FileEntry& entry = m_summaries[key][filename];
+    if(entry.stamp != summary->stamp) {
+        // the summaries we have were recorded for another version of the file
+        entry.variants.clear();
+        entry.stamp = summary->stamp;
+    }
+
+    entry.variants.push_back(summary);
+    if(entry.variants.size() > MAX_SUMMARY_VARIANTS) {
+        entry.variants.erase(entry.variants.begin());
+    }
+}
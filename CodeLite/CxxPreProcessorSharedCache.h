@@ -0,0 +1,189 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : CxxPreProcessorSharedCache.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CXXPREPROCESSORSHAREDCACHE_H
+#define CXXPREPROCESSORSHAREDCACHE_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include <wx/string.h>
+#include <wx/arrstr.h>
+#include <wx/filefn.h>
+#include <wx/sharedptr.h>
+#include <wx/thread.h>
+#include "CxxLexerAPI.h"
+#include "codelite_exports.h"
+
+/**
+ * @class CxxPreProcessorSharedCache
+ * @brief a process wide cache shared by all the CxxPreProcessor instances (and threads):
+ * - include resolution: the full path of a spelled include name for a given list of search
+ *   directories. Lookups are answered from a listing of the directories instead of calling
+ *   stat() for every search directory
+ * - header summaries: the macros a header (and the headers it includes) defines and undefines,
+ *   recorded together with the incoming state it depends on (the macros its conditions test and
+ *   the include statements it skips as already seen). A header is not scanned again when it is
+ *   included with the same state
+ * Revalidate() compares the modification time of every directory and header known to the cache
+ * with the file system and drops what is stale. To keep the cost of a parse batch low, the file
+ * system is checked at most once per second
+ */
+class WXDLLIMPEXP_CL CxxPreProcessorSharedCache
+{
+public:
+    /**
+     * @brief the modification time (in nanoseconds) and size of a file or directory
+     */
+    struct FileStamp {
+        wxInt64 mtime;
+        wxInt64 size;
+        FileStamp()
+            : mtime(0)
+            , size(0)
+        {
+        }
+        bool operator==(const FileStamp& other) const { return mtime == other.mtime && size == other.size; }
+        bool operator!=(const FileStamp& other) const { return !(*this == other); }
+    };
+
+    struct MacroState {
+        bool defined;
+        wxString value;
+        MacroState()
+            : defined(false)
+        {
+        }
+        MacroState(bool d, const wxString& v)
+            : defined(d)
+            , value(v)
+        {
+        }
+        bool operator==(const MacroState& other) const
+        {
+            return defined == other.defined && value == other.value;
+        }
+    };
+
+    struct Summary {
+        typedef wxSharedPtr<Summary> Ptr_t;
+        typedef std::map<wxString, MacroState> MacroMap_t;
+        // the header file, taken before it was read
+        FileStamp stamp;
+        bool stamped;
+        // the incoming state the header depends on
+        MacroMap_t macroDeps;
+        std::map<wxString, bool> includeDeps; // include statement -> was it already seen
+        // the effect of the header
+        MacroMap_t macros;                    // defined (or undefined) by the header
+        std::map<wxString, wxString> includes; // include statement -> resolved path (empty: not found)
+
+        /**
+         * @brief does the header behave the same when included with 'tokens' / 'seenIncludes'?
+         */
+        bool Matches(const CxxPreProcessorToken::Map_t& tokens, const std::map<wxString, wxString>& seenIncludes) const;
+
+        /**
+         * @brief merge a nested header summary into this one
+         */
+        void Merge(const Summary& nested);
+
+        Summary()
+            : stamped(false)
+        {
+        }
+    };
+
+private:
+    struct DirEntry {
+        FileStamp stamp;
+        std::set<wxString> files;
+    };
+
+    struct FileEntry {
+        FileStamp stamp;
+        std::vector<Summary::Ptr_t> variants;
+    };
+
+    typedef std::map<wxString, wxString> ResolvedMap_t;
+    typedef std::map<wxString, FileEntry> FileMap_t;
+
+    std::map<wxString, DirEntry> m_dirs;
+    std::map<wxString, ResolvedMap_t> m_resolved; // search path key -> (dir + include name) -> path
+    std::map<wxString, FileMap_t> m_summaries;    // search path key -> header -> summaries
+    wxInt64 m_lastRevalidate;                     // milliseconds
+    wxCriticalSection m_cs;
+
+private:
+    CxxPreProcessorSharedCache();
+    virtual ~CxxPreProcessorSharedCache();
+
+    const DirEntry& DoGetDir(const wxString& dir);
+
+public:
+    static CxxPreProcessorSharedCache& Get();
+
+    /**
+     * @brief the current stamp of 'path'. Returns false (and an empty stamp) if it does not exist
+     */
+    static bool GetStat(const wxString& path, FileStamp& stamp);
+
+    /**
+     * @brief drop the entries of directories and headers that were modified
+     */
+    void Revalidate();
+
+    /**
+     * @brief drop everything
+     */
+    void Clear();
+
+    /**
+     * @brief locate 'includeName' in 'currentDir' followed by 'includePaths'
+     * @param key identifies the 'includePaths' list
+     * @param resolved [output] the full path of the include file
+     */
+    bool ResolveInclude(const wxString& key,
+                        const wxArrayString& includePaths,
+                        const wxString& currentDir,
+                        const wxString& includeName,
+                        wxString& resolved);
+
+    /**
+     * @brief find a summary for 'filename' that was recorded with the same incoming state
+     */
+    Summary::Ptr_t FindSummary(const wxString& key,
+                               const wxString& filename,
+                               const CxxPreProcessorToken::Map_t& tokens,
+                               const std::map<wxString, wxString>& seenIncludes);
+
+    /**
+     * @brief store the summary of 'filename'. The summary is kept only if its stamp was taken
+     * before the header was read (see Summary::stamp)
+     */
+    void AddSummary(const wxString& key, const wxString& filename, Summary::Ptr_t summary);
+};
+
+#endif // CXXPREPROCESSORSHAREDCACHE_H
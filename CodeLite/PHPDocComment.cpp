@@ -2,10 +2,89 @@
 #include <wx/regex.h>
 #include <wx/tokenzr.h>
 #include <set>
+#include <vector>
+#include <wx/thread.h>
+
+namespace
+{
+/**
+ * @brief the regular expressions used to parse a doc comment.
+ * wxRegEx keeps the result of the last match, so a set cannot be shared by threads parsing in
+ * parallel (see PHPLookupTable::RecreateSymbolsDatabase): each comment borrows a set from a pool
+ */
+struct PHPDocCommentRegexes {
+    wxRegEx reReturnStatement;
+    wxRegEx reVarType;
+    wxRegEx reVarType2;
+    wxRegEx reParam2;
+
+    PHPDocCommentRegexes()
+        : reReturnStatement(wxT("@(return)[ \t]+([\\a-zA-Z_]{1}[\\|\\a-zA-Z0-9_]*)"))
+        , reVarType(wxT("@(var|variable)[ \t]+([\\a-zA-Z_]{1}[\\a-zA-Z0-9_]*)"))
+        , reVarType2(wxT("@(var|variable)[ \t]+([\\a-zA-Z0-9_]+)[ \t]+([\\$]{1}[\\a-zA-Z0-9_]*)"))
+        , reParam2(wxT("@(param|parameter)[ \t]+([\\a-zA-Z0-9_]*)[ \t]+([\\$]{1}[\\a-zA-Z0-9_]+)"))
+    {
+    }
+};
+
+class PHPDocCommentRegexesPool
+{
+    std::vector<PHPDocCommentRegexes*> m_free;
+    wxMutex m_mutex;
+
+public:
+    virtual ~PHPDocCommentRegexesPool()
+    {
+        for(size_t i = 0; i < m_free.size(); ++i) {
+            delete m_free.at(i);
+        }
+    }
+
+    PHPDocCommentRegexes* Take()
+    {
+        {
+            wxMutexLocker locker(m_mutex);
+            if(!m_free.empty()) {
+                PHPDocCommentRegexes* regexes = m_free.back();
+                m_free.pop_back();
+                return regexes;
+            }
+        }
+        return new PHPDocCommentRegexes();
+    }
+
+    void Release(PHPDocCommentRegexes* regexes)
+    {
+        wxMutexLocker locker(m_mutex);
+        m_free.push_back(regexes);
+    }
+
+    static PHPDocCommentRegexesPool& Get()
+    {
+        static PHPDocCommentRegexesPool pool;
+        return pool;
+    }
+};
+
+class PHPDocCommentRegexesLocker
+{
+    PHPDocCommentRegexes* m_regexes;
+
+public:
+    PHPDocCommentRegexesLocker()
+        : m_regexes(PHPDocCommentRegexesPool::Get().Take())
+    {
+    }
+    ~PHPDocCommentRegexesLocker() { PHPDocCommentRegexesPool::Get().Release(m_regexes); }
+    PHPDocCommentRegexes* operator->() const { return m_regexes; }
+};
+}
 
 PHPDocComment::PHPDocComment(PHPSourceFile& sourceFile, const wxString& comment)
     : m_comment(comment)
 {
+    PHPDocCommentRegexesLocker regexes;
+
     std::set<wxString> nativeTypes;
     nativeTypes.insert("int");
     nativeTypes.insert("integer");
@@ -21,7 +100,7 @@ PHPDocComment::PHPDocComment(PHPSourceFile& sourceFile, const wxString& comment)
     nativeTypes.insert("mixed");
     nativeTypes.insert("null");
 
-    static wxRegEx reReturnStatement(wxT("@(return)[ \t]+([\\a-zA-Z_]{1}[\\|\\a-zA-Z0-9_]*)"));
+    wxRegEx& reReturnStatement = regexes->reReturnStatement;
     if(reReturnStatement.IsValid() && reReturnStatement.Matches(m_comment)) {
         wxString returnValue = reReturnStatement.GetMatch(m_comment, 2);
         wxArrayString types = ::wxStringTokenize(returnValue, "|", wxTOKEN_STRTOK);
@@ -44,7 +123,7 @@ PHPDocComment::PHPDocComment(PHPSourceFile& sourceFile, const wxString& comment)
         }
     }
 
-    static wxRegEx reVarType(wxT("@(var|variable)[ \t]+([\\a-zA-Z_]{1}[\\a-zA-Z0-9_]*)"));
+    wxRegEx& reVarType = regexes->reVarType;
     if(reVarType.IsValid() && reVarType.Matches(m_comment)) {
         m_varType = reVarType.GetMatch(m_comment, 2);
         m_varType = sourceFile.MakeIdentifierAbsolute(m_varType);
@@ -52,7 +131,7 @@ PHPDocComment::PHPDocComment(PHPSourceFile& sourceFile, const wxString& comment)
     }
 
     // @var Type $Name
-    static wxRegEx reVarType2(wxT("@(var|variable)[ \t]+([\\a-zA-Z0-9_]+)[ \t]+([\\$]{1}[\\a-zA-Z0-9_]*)"));
+    wxRegEx& reVarType2 = regexes->reVarType2;
     if(reVarType2.IsValid() && reVarType2.Matches(m_comment)) {
         m_varType = reVarType2.GetMatch(m_comment, 3);
         m_varType = sourceFile.MakeIdentifierAbsolute(m_varType);
@@ -60,7 +139,7 @@ PHPDocComment::PHPDocComment(PHPSourceFile& sourceFile, const wxString& comment)
     }
 
     // @param PDO $name
-    static wxRegEx reParam2(wxT("@(param|parameter)[ \t]+([\\a-zA-Z0-9_]*)[ \t]+([\\$]{1}[\\a-zA-Z0-9_]+)"));
+    wxRegEx& reParam2 = regexes->reParam2;
     wxArrayString lines2 = wxStringTokenize(m_comment, wxT("\n"), wxTOKEN_STRTOK);
     if(reParam2.IsValid()) {
         for(size_t i = 0; i < lines2.GetCount(); i++) {
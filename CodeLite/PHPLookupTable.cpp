@@ -12,6 +12,8 @@
 #include "PHPEntityFunctionAlias.h"
 #include <wx/tokenzr.h>
 #include "fileextmanager.h"
+#include <wx/thread.h>
+#include <deque>
 
 wxDEFINE_EVENT(wxPHP_PARSE_STARTED, clParseEvent);
 wxDEFINE_EVENT(wxPHP_PARSE_ENDED, clParseEvent);
@@ -19,6 +21,15 @@ wxDEFINE_EVENT(wxPHP_PARSE_PROGRESS, clParseEvent);
 
 static wxString PHP_SCHEMA_VERSION = "9.0.1";
 
+// Below this number of files per worker, the files are parsed by the calling thread
+#define PHP_PARSE_MIN_FILES_PER_WORKER 20
+
+// Max number of parsed files waiting to be stored
+#define PHP_PARSE_MAX_PENDING_FILES 128
+
+// Number of files stored per transaction
+#define PHP_PARSE_FILES_PER_TRANSACTION 500
+
 //------------------------------------------------
 // Metadata table
 //------------------------------------------------
@@ -636,8 +647,241 @@ wxString PHPLookupTable::EscapeWildCards(const wxString& str)
 
 void PHPLookupTable::DoAddLimit(wxString& sql) { sql << " LIMIT " << m_sizeLimit; }
 
+namespace
+{
+/**
+ * @brief a file to parse. 'lastParsed' is the time the file was last stored into the database,
+ * the file is parsed only if it was modified since. -1 means: always parse
+ */
+struct PHPParseJob {
+    wxString filename;
+    wxLongLong lastParsed;
+};
+
+/**
+ * @brief a parsed file, 'sourceFile' is NULL if the file does not need to be stored
+ */
+struct PHPParseResult {
+    wxString filename;
+    PHPSourceFile* sourceFile;
+};
+
+/**
+ * @brief read and parse a PHP file
+ * @return the parsed file (owned by the caller) or NULL if the file does not need to be stored
+ */
+PHPSourceFile* ParsePHPFile(const PHPParseJob& job, bool parseFuncBodies)
+{
+    wxFileName fnFile(job.filename);
+    if(!fnFile.Exists()) {
+        return NULL;
+    }
+
+    if(job.lastParsed >= 0) {
+        time_t lastModifiedOnDisk = fnFile.GetModificationTime().GetTicks();
+        if(lastModifiedOnDisk <= job.lastParsed.ToLong()) {
+            return NULL;
+        }
+    }
+
+    // For performance reaons, load the file into memory and then parse it
+    wxString content;
+    if(!FileUtils::ReadFileContent(fnFile, content, wxConvISO8859_1)) {
+        CL_WARNING("PHP: Failed to read file: %s for parsing", fnFile.GetFullPath());
+        return NULL;
+    }
+    PHPSourceFile* sourceFile = new PHPSourceFile(content);
+    sourceFile->SetFilename(fnFile);
+    sourceFile->SetParseFunctionBody(parseFuncBodies);
+    sourceFile->Parse();
+    return sourceFile;
+}
+
+class PHPParseWorker;
+
+/**
+ * @class PHPParseWorkerPool
+ * @brief parses PHP files with several worker threads. The workers take the next job from a shared
+ * index and queue the parsed files, which are stored by a single writer: the thread that owns the
+ * database. A parsed file belongs to one thread at a time, as the reference counting of its
+ * entities is not thread safe
+ */
+class PHPParseWorkerPool
+{
+    std::vector<PHPParseJob> m_jobs;
+    bool m_parseFuncBodies;
+    size_t m_next;
+    std::vector<PHPParseWorker*> m_workers;
+    std::deque<PHPParseResult> m_results;
+    wxMutex m_mutex;
+    wxCondition m_resultsCond; // a file was parsed
+    wxCondition m_spaceCond;   // a parsed file was consumed
+    bool m_stop;
+
+public:
+    PHPParseWorkerPool(const std::vector<PHPParseJob>& jobs, bool parseFuncBodies);
+    virtual ~PHPParseWorkerPool();
+
+    /**
+     * @brief start 'workers' threads. Returns false if less than 2 workers could be started,
+     * the caller should parse the files by itself
+     */
+    bool Start(size_t workers);
+
+    /**
+     * @brief stop and wait for the workers
+     */
+    void Stop();
+
+    /**
+     * @brief wait for the next parsed file. Every job produces exactly one result
+     * (the results are not in the jobs order)
+     */
+    bool Pop(PHPParseResult& result);
+
+    // Workers API
+    bool Next(PHPParseJob& job);
+    bool Push(const wxString& filename, PHPSourceFile* sourceFile);
+    bool IsParseFuncBodies() const { return m_parseFuncBodies; }
+};
+
+class PHPParseWorker : public wxThread
+{
+    PHPParseWorkerPool* m_pool;
+
+public:
+    PHPParseWorker(PHPParseWorkerPool* pool)
+        : wxThread(wxTHREAD_JOINABLE)
+        , m_pool(pool)
+    {
+    }
+    virtual ~PHPParseWorker() {}
+
+    virtual void* Entry()
+    {
+        PHPParseJob job;
+        while(m_pool->Next(job)) {
+            if(!m_pool->Push(job.filename, ParsePHPFile(job, m_pool->IsParseFuncBodies()))) {
+                break;
+            }
+        }
+        return NULL;
+    }
+};
+
+PHPParseWorkerPool::PHPParseWorkerPool(const std::vector<PHPParseJob>& jobs, bool parseFuncBodies)
+    : m_parseFuncBodies(parseFuncBodies)
+    , m_next(0)
+    , m_resultsCond(m_mutex)
+    , m_spaceCond(m_mutex)
+    , m_stop(false)
+{
+    // The workers get their own copy of the file names
+    m_jobs.reserve(jobs.size());
+    for(size_t i = 0; i < jobs.size(); ++i) {
+        PHPParseJob job;
+        job.filename = jobs.at(i).filename.c_str();
+        job.lastParsed = jobs.at(i).lastParsed;
+        m_jobs.push_back(job);
+    }
+}
+
+PHPParseWorkerPool::~PHPParseWorkerPool() { Stop(); }
+
+bool PHPParseWorkerPool::Start(size_t workers)
+{
+    if(workers < 2) {
+        return false;
+    }
+
+    for(size_t i = 0; i < workers; ++i) {
+        PHPParseWorker* worker = new PHPParseWorker(this);
+        if(worker->Run() != wxTHREAD_NO_ERROR) {
+            delete worker;
+            continue;
+        }
+        m_workers.push_back(worker);
+    }
+
+    if(m_workers.size() < 2) {
+        Stop();
+        return false;
+    }
+    return true;
+}
+
+void PHPParseWorkerPool::Stop()
+{
+    {
+        wxMutexLocker locker(m_mutex);
+        m_stop = true;
+        m_spaceCond.Broadcast();
+    }
+
+    for(size_t i = 0; i < m_workers.size(); ++i) {
+        m_workers.at(i)->Wait();
+        delete m_workers.at(i);
+    }
+    m_workers.clear();
+
+    wxMutexLocker locker(m_mutex);
+    for(size_t i = 0; i < m_results.size(); ++i) {
+        wxDELETE(m_results.at(i).sourceFile);
+    }
+    m_results.clear();
+}
+
+bool PHPParseWorkerPool::Pop(PHPParseResult& result)
+{
+    wxMutexLocker locker(m_mutex);
+    while(m_results.empty()) {
+        if(m_stop) {
+            return false;
+        }
+        m_resultsCond.Wait();
+    }
+    result = m_results.front();
+    m_results.pop_front();
+    m_spaceCond.Signal();
+    return true;
+}
+
+bool PHPParseWorkerPool::Next(PHPParseJob& job)
+{
+    wxMutexLocker locker(m_mutex);
+    if(m_stop || m_next == m_jobs.size()) {
+        return false;
+    }
+    job.filename = m_jobs.at(m_next).filename.c_str();
+    job.lastParsed = m_jobs.at(m_next).lastParsed;
+    ++m_next;
+    return true;
+}
+
+bool PHPParseWorkerPool::Push(const wxString& filename, PHPSourceFile* sourceFile)
+{
+    wxMutexLocker locker(m_mutex);
+    while(!m_stop && m_results.size() >= PHP_PARSE_MAX_PENDING_FILES) {
+        m_spaceCond.Wait();
+    }
+
+    if(m_stop) {
+        wxDELETE(sourceFile);
+        return false;
+    }
+
+    PHPParseResult result;
+    result.filename = filename.c_str();
+    result.sourceFile = sourceFile;
+    m_results.push_back(result);
+    m_resultsCond.Signal();
+    return true;
+}
+}
+
 void PHPLookupTable::RecreateSymbolsDatabase(const wxArrayString& files, eUpdateMode updateMode, bool parseFuncBodies)
 {
+    PHPParseWorkerPool* pool = NULL;
     try {
 
         {
@@ -650,60 +894,74 @@ void PHPLookupTable::RecreateSymbolsDatabase(const wxArrayString& files, eUpdate
         wxStopWatch sw;
         sw.Start();
 
-        m_db.Begin();
-        for(size_t i = 0; i < files.GetCount(); ++i) {
-            {
-                clParseEvent event(wxPHP_PARSE_PROGRESS);
-                event.SetTotalFiles(files.GetCount());
-                event.SetCurfileIndex(i);
-                event.SetFileName(files.Item(i));
-                EventNotifier::Get()->AddPendingEvent(event);
-            }
+        // Load the timestamps with a single query instead of a query per file
+        std::map<wxString, wxLongLong> timestamps;
+        if(updateMode == kUpdateMode_Fast) {
+            LoadFilesLastParsedTimestamp(timestamps);
+        }
 
+        // Parse only valid PHP files
+        std::vector<PHPParseJob> jobs;
+        jobs.reserve(files.GetCount());
+        for(size_t i = 0; i < files.GetCount(); ++i) {
             wxFileName fnFile(files.Item(i));
-            bool reParseNeeded(true);
+            if(FileExtManager::GetType(fnFile.GetFullName()) != FileExtManager::TypePhp) {
+                continue;
+            }
 
+            PHPParseJob job;
+            job.filename = fnFile.GetFullPath();
+            job.lastParsed = -1;
             if(updateMode == kUpdateMode_Fast) {
                 // Check to see if we need to re-parse this file
                 // and store it to the database
+                std::map<wxString, wxLongLong>::const_iterator iter = timestamps.find(job.filename);
+                job.lastParsed = (iter == timestamps.end()) ? wxLongLong(0) : iter->second;
+            }
+            jobs.push_back(job);
+        }
 
-                if(!fnFile.Exists()) {
-                    reParseNeeded = false;
-                } else {
-                    time_t lastModifiedOnDisk = fnFile.GetModificationTime().GetTicks();
-                    wxLongLong lastModifiedInDB = GetFileLastParsedTimestamp(fnFile);
-                    if(lastModifiedOnDisk <= lastModifiedInDB.ToLong()) {
-                        reParseNeeded = false;
-                    }
-                }
+        // Parse the files in parallel, this thread stores them
+        size_t workers = wxMin((size_t)wxThread::GetCPUCount(), jobs.size() / PHP_PARSE_MIN_FILES_PER_WORKER);
+        if(workers > 1) {
+            pool = new PHPParseWorkerPool(jobs, parseFuncBodies);
+            if(!pool->Start(workers)) {
+                wxDELETE(pool);
             }
+        }
 
-            // Ensure that the file exists
-            if(!fnFile.Exists()) {
-                reParseNeeded = false;
+        size_t skipped = files.GetCount() - jobs.size();
+        m_db.Begin();
+        for(size_t i = 0; i < jobs.size(); ++i) {
+            PHPParseResult result;
+            if(pool) {
+                if(!pool->Pop(result)) break;
+            } else {
+                result.filename = jobs.at(i).filename;
+                result.sourceFile = ParsePHPFile(jobs.at(i), parseFuncBodies);
             }
 
-            // Parse only valid PHP files
-            if(FileExtManager::GetType(fnFile.GetFullName()) != FileExtManager::TypePhp) {
-                reParseNeeded = false;
+            {
+                clParseEvent event(wxPHP_PARSE_PROGRESS);
+                event.SetTotalFiles(files.GetCount());
+                event.SetCurfileIndex(skipped + i);
+                event.SetFileName(result.filename);
+                EventNotifier::Get()->AddPendingEvent(event);
             }
-            
-            if(reParseNeeded) {
-                // For performance reaons, load the file into memory and then parse it
-                wxFileName fnSourceFile(files.Item(i));
-                wxString content;
-                if(!FileUtils::ReadFileContent(fnSourceFile, content, wxConvISO8859_1)) {
-                    CL_WARNING("PHP: Failed to read file: %s for parsing", fnSourceFile.GetFullPath());
-                    continue;
-                }
-                PHPSourceFile sourceFile(content);
-                sourceFile.SetFilename(fnSourceFile);
-                sourceFile.SetParseFunctionBody(parseFuncBodies);
-                sourceFile.Parse();
-                UpdateSourceFile(sourceFile, false);
+
+            if(result.sourceFile) {
+                UpdateSourceFile(*result.sourceFile, false);
+                wxDELETE(result.sourceFile);
+            }
+
+            if((i + 1) % PHP_PARSE_FILES_PER_TRANSACTION == 0) {
+                m_db.Commit();
+                m_db.Begin();
             }
         }
         m_db.Commit();
+        wxDELETE(pool);
+
         long elapsedMs = sw.Time();
         wxString message;
         message << _("PHP: parsed ") << files.GetCount() << " in " << elapsedMs << " milliseconds";
@@ -717,6 +975,7 @@ void PHPLookupTable::RecreateSymbolsDatabase(const wxArrayString& files, eUpdate
         }
 
     } catch(wxSQLite3Exception& e) {
+        wxDELETE(pool);
         try {
             m_db.Rollback();
 
@@ -1005,20 +1264,16 @@ void PHPLookupTable::DoFindChildren(PHPEntityBase::List_t& matches,
     }
 }
 
-wxLongLong PHPLookupTable::GetFileLastParsedTimestamp(const wxFileName& filename)
+void PHPLookupTable::LoadFilesLastParsedTimestamp(std::map<wxString, wxLongLong>& timestamps)
 {
     try {
-        wxSQLite3Statement st =
-            m_db.PrepareStatement("SELECT LAST_UPDATED FROM FILES_TABLE WHERE FILE_NAME=:FILE_NAME");
-        st.Bind(st.GetParamIndex(":FILE_NAME"), filename.GetFullPath());
-        wxSQLite3ResultSet res = st.ExecuteQuery();
-        if(res.NextRow()) {
-            return res.GetInt64("LAST_UPDATED");
+        wxSQLite3ResultSet res = m_db.ExecuteQuery("SELECT FILE_NAME, LAST_UPDATED FROM FILES_TABLE");
+        while(res.NextRow()) {
+            timestamps.insert(std::make_pair(res.GetString("FILE_NAME"), res.GetInt64("LAST_UPDATED")));
         }
     } catch(wxSQLite3Exception& e) {
-        CL_WARNING("PHPLookupTable::FindChildren: %s", e.GetMessage());
+        CL_WARNING("PHPLookupTable::LoadFilesLastParsedTimestamp: %s", e.GetMessage());
     }
-    return 0;
 }
 
 void PHPLookupTable::UpdateFileLastParsedTimestamp(const wxFileName& filename)
@@ -33,6 +33,7 @@
 #include "PHPSourceFile.h"
 #include <vector>
 #include <set>
+#include <map>
 #include <wx/longlong.h>
 #include "cl_command_event.h"
 #include "smart_ptr.h"
@@ -139,9 +140,9 @@ private:
                         const wxString& nameHint = "");
 
     /**
-     * @brief return the timestamp of the last parse for 'filename'
+     * @brief load the last parse timestamp of all the files in the database
      */
-    wxLongLong GetFileLastParsedTimestamp(const wxFileName& filename);
+    void LoadFilesLastParsedTimestamp(std::map<wxString, wxLongLong>& timestamps);
 
     /**
      * @brief update the file's last updated timestamp
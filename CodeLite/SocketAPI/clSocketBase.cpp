@@ -288,6 +288,82 @@ void clSocketBase::WriteMessage(const wxString& message) throw(clSocketException
     Send(c_str);
 }
 
+// Largest frame we agree to read, anything bigger is a corrupted stream
+#define CL_SOCKET_MAX_FRAME_SIZE (256 * 1024 * 1024)
+
+void clSocketBase::WriteFrame(const std::string& payload) throw(clSocketException)
+{
+    if(m_socket == INVALID_SOCKET) {
+        throw clSocketException("Invalid socket!");
+    }
+
+    size_t len = payload.length();
+    std::string frame;
+    frame.reserve(len + 4);
+    frame.push_back((char)((len >> 24) & 0xFF));
+    frame.push_back((char)((len >> 16) & 0xFF));
+    frame.push_back((char)((len >> 8) & 0xFF));
+    frame.push_back((char)(len & 0xFF));
+    frame.append(payload);
+    Send(frame);
+}
+
+int clSocketBase::ReadFrame(std::string& payload, long timeout) throw(clSocketException)
+{
+    unsigned char header[4];
+    int rc = DoReadExact((char*)header, sizeof(header), timeout);
+    if(rc != kSuccess) {
+        return rc;
+    }
+
+    size_t len = ((size_t)header[0] << 24) | ((size_t)header[1] << 16) | ((size_t)header[2] << 8) | header[3];
+    if(len > CL_SOCKET_MAX_FRAME_SIZE) {
+        throw clSocketException("Frame too large");
+    }
+
+    payload.resize(len);
+    if(len == 0) {
+        return kSuccess;
+    }
+    // we are in the middle of a frame: don't time out here or the stream gets out of sync
+    return DoReadExact(&payload[0], len, -1);
+}
+
+int clSocketBase::DoReadExact(char* buffer, size_t len, long timeout) throw(clSocketException)
+{
+    if(m_socket == INVALID_SOCKET) {
+        throw clSocketException("Invalid socket!");
+    }
+
+    // only wait for the first byte, the rest follows it
+    if(SelectRead(timeout) == kTimeout) {
+        return kTimeout;
+    }
+
+    size_t totalRead = 0;
+    while(totalRead < len) {
+        int bytesRead = ::recv(m_socket, buffer + totalRead, len - totalRead, 0);
+        if(bytesRead < 0) {
+#ifndef _WIN32
+            if(errno == EINTR) continue;
+#endif
+            throw clSocketException("Read failed: " + error());
+
+        } else if(bytesRead == 0) {
+            throw clSocketException("connection closed by peer");
+        }
+        totalRead += bytesRead;
+    }
+    return kSuccess;
+}
+
+void clSocketBase::Shutdown()
+{
+    if(m_socket != INVALID_SOCKET) {
+        ::shutdown(m_socket, 2);
+    }
+}
+
 socket_t clSocketBase::Release()
 {
     int fd = m_socket;
@@ -165,11 +165,37 @@ public:
      */
     void WriteMessage(const wxString& message) throw(clSocketException);
 
+    /**
+     * @brief write a binary frame: a 4 byte (network order) length followed by the payload.
+     * The header and the payload are sent in a single 'send' call
+     */
+    void WriteFrame(const std::string& payload) throw(clSocketException);
+
+    /**
+     * @brief read a frame that was sent with 'WriteFrame'
+     * @param payload [output]
+     * @param timeout seconds to wait for the frame to arrive, -1 blocks until it does.
+     * Once the header arrived, the payload is always read in full
+     * @return kSuccess or kTimeout. A connection closed by the peer throws an exception
+     */
+    int ReadFrame(std::string& payload, long timeout = -1) throw(clSocketException);
+
+    /**
+     * @brief shutdown the connection without closing the descriptor. A thread blocked
+     * on a read from this socket wakes up with a "connection closed" error
+     */
+    void Shutdown();
+
 protected:
     /**
      * @brief
      */
     void DestroySocket();
+
+    /**
+     * @brief read exactly 'len' bytes into 'buffer'
+     */
+    int DoReadExact(char* buffer, size_t len, long timeout) throw(clSocketException);
 };
 
 #endif // CLSOCKETBASE_H
@@ -92,6 +92,17 @@ static char* cJSON_strdup(const char* str)
     return copy;
 }
 
+char* cJSON_AllocBuffer(size_t size)
+{
+    return (char*)cJSON_malloc(size);
+}
+
+void cJSON_FreeBuffer(char* buffer)
+{
+    if(buffer)
+        cJSON_free(buffer);
+}
+
 void cJSON_InitHooks(cJSON_Hooks* hooks)
 {
     if(!hooks) { /* Reset hooks */
@@ -113,19 +124,170 @@ static cJSON* cJSON_New_Item()
     return node;
 }
 
+/* Arena: the items of a parsed document are carved out of large blocks, released all at once with the root */
+#define CJSON_ARENA_BLOCK_SIZE (64 * 1024)
+
+typedef struct cJSON_ArenaBlock
+{
+    struct cJSON_ArenaBlock* next;
+    size_t size;
+    size_t used;
+} cJSON_ArenaBlock;
+
+struct cJSON_Arena
+{
+    cJSON_ArenaBlock* blocks;
+    char* buffer; /* the parsed text, the strings of the document point into it */
+};
+
+static void* cJSON_ArenaAlloc(cJSON_Arena* arena, size_t sz)
+{
+    cJSON_ArenaBlock* block = arena->blocks;
+    void* p;
+
+    sz = (sz + 7) & ~(size_t)7;
+    if(!block || block->used + sz > block->size) {
+        size_t size = sz > CJSON_ARENA_BLOCK_SIZE ? sz : CJSON_ARENA_BLOCK_SIZE;
+        block = (cJSON_ArenaBlock*)cJSON_malloc(sizeof(cJSON_ArenaBlock) + size);
+        if(!block)
+            return 0;
+        block->size = size;
+        block->used = 0;
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+    p = (char*)(block + 1) + block->used;
+    block->used += sz;
+    return p;
+}
+
+static void cJSON_FreeArena(cJSON_Arena* arena)
+{
+    cJSON_ArenaBlock* block = arena->blocks;
+    while(block) {
+        cJSON_ArenaBlock* next = block->next;
+        cJSON_free(block);
+        block = next;
+    }
+    if(arena->buffer)
+        cJSON_free(arena->buffer);
+    cJSON_free(arena);
+}
+
+/* A new item of a document being parsed */
+static cJSON* cJSON_New_ParsedItem(cJSON_Arena* arena)
+{
+    cJSON* node;
+    if(!arena)
+        return cJSON_New_Item();
+
+    node = (cJSON*)cJSON_ArenaAlloc(arena, sizeof(cJSON));
+    if(node) {
+        memset(node, 0, sizeof(cJSON));
+        node->arenaFlags = cJSON_ArenaItem;
+    }
+    return node;
+}
+
+/* Index: the children of a large array or object in a contiguous array, and for objects a hash table of their names
+ * (case insensitive, like cJSON_GetObjectItem) */
+#define CJSON_INDEX_MIN_ITEMS 8
+
+struct cJSON_Index
+{
+    int count;
+    cJSON** items;
+    int bucketCount; /* 0 for arrays, a power of 2 for objects */
+    int* buckets;    /* the first item of each bucket, -1 if empty */
+    int* chain;      /* the next item of the same bucket, in document order */
+};
+
+static unsigned cJSON_HashName(const char* s)
+{
+    unsigned h = 5381;
+    while(*s)
+        h = h * 33 + tolower((unsigned char)*s++);
+    return h;
+}
+
+static void cJSON_InvalidateIndex(cJSON* container)
+{
+    if(container->index) {
+        cJSON_free(container->index);
+        container->index = 0;
+    }
+}
+
+/* Built once the container is parsed, so the lookups only read the document. Without an index (small containers,
+ * containers modified after parsing or out of memory) the lookups walk the children */
+static void cJSON_BuildIndex(cJSON* container)
+{
+    cJSON_Index* index;
+    cJSON* c;
+    int count = 0, bucketCount = 0, i;
+
+    cJSON_InvalidateIndex(container);
+
+    for(c = container->child; c; c = c->next)
+        count++;
+    if(count < CJSON_INDEX_MIN_ITEMS)
+        return;
+
+    if(container->type == cJSON_Object) {
+        bucketCount = 1;
+        while(bucketCount < count * 2)
+            bucketCount <<= 1;
+    }
+
+    /* one allocation: the index, the items, then the buckets and the chains */
+    index = (cJSON_Index*)cJSON_malloc(sizeof(cJSON_Index) + count * sizeof(cJSON*) +
+                                       (bucketCount + count) * sizeof(int));
+    if(!index)
+        return;
+
+    index->count = count;
+    index->items = (cJSON**)(index + 1);
+    index->bucketCount = bucketCount;
+    index->buckets = (int*)(index->items + count);
+    index->chain = index->buckets + bucketCount;
+
+    for(i = 0, c = container->child; c; c = c->next, i++)
+        index->items[i] = c;
+
+    for(i = 0; i < bucketCount; i++)
+        index->buckets[i] = -1;
+
+    /* insert backwards so each bucket lists its items in document order: the first match wins */
+    for(i = count - 1; i >= 0; i--) {
+        index->chain[i] = -1;
+        if(bucketCount && index->items[i]->string) {
+            int bucket = cJSON_HashName(index->items[i]->string) & (bucketCount - 1);
+            index->chain[i] = index->buckets[bucket];
+            index->buckets[bucket] = i;
+        }
+    }
+
+    container->index = index;
+}
+
 /* Delete a cJSON structure. */
 void cJSON_Delete(cJSON* c)
 {
     cJSON* next;
     while(c) {
+        cJSON_Arena* arena = c->arena;
         next = c->next;
         if(!(c->type & cJSON_IsReference) && c->child)
             cJSON_Delete(c->child);
-        if(!(c->type & cJSON_IsReference) && c->valuestring)
+        if(!(c->type & cJSON_IsReference) && c->valuestring && !(c->arenaFlags & cJSON_ArenaValueString))
             cJSON_free(c->valuestring);
-        if(c->string)
+        if(c->string && !(c->arenaFlags & cJSON_ArenaString))
             cJSON_free(c->string);
-        cJSON_free(c);
+        cJSON_InvalidateIndex(c);
+        if(!(c->arenaFlags & cJSON_ArenaItem))
+            cJSON_free(c);
+        if(arena)
+            cJSON_FreeArena(arena);
         c = next;
     }
 }
@@ -195,7 +357,7 @@ static char* print_number(cJSON* item)
 
 /* Parse the input text into an unescaped cstring, and populate item. */
 static const unsigned char firstByteMark[7] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
-static const char* parse_string(cJSON* item, const char* str)
+static const char* parse_string(cJSON* item, const char* str, cJSON_Arena* arena)
 {
     const char* ptr = str + 1;
     char* ptr2;
@@ -207,13 +369,19 @@ static const char* parse_string(cJSON* item, const char* str)
         return 0;
     } /* not a string! */
 
-    while(*ptr != '\"' && *ptr && ++len)
-        if(*ptr++ == '\\')
-            ptr++; /* Skip escaped quotes. */
+    if(arena) {
+        /* decode in place: the decoded string is never longer than its escaped version */
+        out = (char*)ptr;
 
-    out = (char*)cJSON_malloc(len + 1); /* This is how long we need for the string, roughly. */
-    if(!out)
-        return 0;
+    } else {
+        while(*ptr != '\"' && *ptr && ++len)
+            if(*ptr++ == '\\')
+                ptr++; /* Skip escaped quotes. */
+
+        out = (char*)cJSON_malloc(len + 1); /* This is how long we need for the string, roughly. */
+        if(!out)
+            return 0;
+    }
 
     ptr = str + 1;
     ptr2 = out;
@@ -287,12 +455,16 @@ static const char* parse_string(cJSON* item, const char* str)
             ptr++;
         }
     }
+    /* step over the closing quote before terminating the string, which may overwrite it */
+    str = ptr;
+    if(*str == '\"')
+        str++;
     *ptr2 = 0;
-    if(*ptr == '\"')
-        ptr++;
     item->valuestring = out;
     item->type = cJSON_String;
-    return ptr;
+    if(arena)
+        item->arenaFlags |= cJSON_ArenaValueString;
+    return str;
 }
 
 /* Render the cstring provided to an escaped version that can be printed. */
@@ -366,11 +538,11 @@ static char* print_string(cJSON* item)
 }
 
 /* Predeclare these prototypes. */
-static const char* parse_value(cJSON* item, const char* value);
+static const char* parse_value(cJSON* item, const char* value, cJSON_Arena* arena);
 static char* print_value(cJSON* item, int depth, int fmt);
-static const char* parse_array(cJSON* item, const char* value);
+static const char* parse_array(cJSON* item, const char* value, cJSON_Arena* arena);
 static char* print_array(cJSON* item, int depth, int fmt);
-static const char* parse_object(cJSON* item, const char* value);
+static const char* parse_object(cJSON* item, const char* value, cJSON_Arena* arena);
 static char* print_object(cJSON* item, int depth, int fmt);
 
 /* Utility to jump whitespace and cr/lf */
@@ -389,7 +561,36 @@ cJSON* cJSON_Parse(const char* value)
     if(!c)
         return 0; /* memory fail */
 
-    if(!parse_value(c, skip(value))) {
+    if(!parse_value(c, skip(value), 0)) {
+        cJSON_Delete(c);
+        return 0;
+    }
+    return c;
+}
+
+cJSON* cJSON_ParseBuffer(char* buffer)
+{
+    cJSON_Arena* arena;
+    cJSON* c;
+
+    ep = 0;
+    arena = (cJSON_Arena*)cJSON_malloc(sizeof(cJSON_Arena));
+    if(!arena) {
+        cJSON_free(buffer);
+        return 0;
+    }
+    arena->blocks = 0;
+    arena->buffer = buffer;
+
+    c = cJSON_New_ParsedItem(arena);
+    if(!c) {
+        cJSON_FreeArena(arena);
+        return 0;
+    }
+
+    /* the root owns the arena from now on */
+    c->arena = arena;
+    if(!parse_value(c, skip(buffer), arena)) {
         cJSON_Delete(c);
         return 0;
     }
@@ -407,7 +608,7 @@ char* cJSON_PrintUnformatted(cJSON* item)
 }
 
 /* Parser core - when encountering text, process appropriately. */
-static const char* parse_value(cJSON* item, const char* value)
+static const char* parse_value(cJSON* item, const char* value, cJSON_Arena* arena)
 {
     if(!value)
         return 0; /* Fail on null. */
@@ -425,16 +626,16 @@ static const char* parse_value(cJSON* item, const char* value)
         return value + 4;
     }
     if(*value == '\"') {
-        return parse_string(item, value);
+        return parse_string(item, value, arena);
     }
     if(*value == '-' || (*value >= '0' && *value <= '9')) {
         return parse_number(item, value);
     }
     if(*value == '[') {
-        return parse_array(item, value);
+        return parse_array(item, value, arena);
     }
     if(*value == '{') {
-        return parse_object(item, value);
+        return parse_object(item, value, arena);
     }
 
     ep = value;
@@ -474,7 +675,7 @@ static char* print_value(cJSON* item, int depth, int fmt)
 }
 
 /* Build an array from input text. */
-static const char* parse_array(cJSON* item, const char* value)
+static const char* parse_array(cJSON* item, const char* value, cJSON_Arena* arena)
 {
     cJSON* child;
     if(*value != '[') {
@@ -487,27 +688,29 @@ static const char* parse_array(cJSON* item, const char* value)
     if(*value == ']')
         return value + 1; /* empty array. */
 
-    item->child = child = cJSON_New_Item();
+    item->child = child = cJSON_New_ParsedItem(arena);
     if(!item->child)
-        return 0;                                  /* memory fail */
-    value = skip(parse_value(child, skip(value))); /* skip any spacing, get the value. */
+        return 0;                                         /* memory fail */
+    value = skip(parse_value(child, skip(value), arena)); /* skip any spacing, get the value. */
     if(!value)
         return 0;
 
     while(*value == ',') {
         cJSON* new_item;
-        if(!(new_item = cJSON_New_Item()))
+        if(!(new_item = cJSON_New_ParsedItem(arena)))
             return 0; /* memory fail */
         child->next = new_item;
         new_item->prev = child;
         child = new_item;
-        value = skip(parse_value(child, skip(value + 1)));
+        value = skip(parse_value(child, skip(value + 1), arena));
         if(!value)
             return 0; /* memory fail */
     }
 
-    if(*value == ']')
+    if(*value == ']') {
+        cJSON_BuildIndex(item);
         return value + 1; /* end of array */
+    }
     ep = value;
     return 0; /* malformed. */
 }
@@ -579,7 +782,16 @@ static char* print_array(cJSON* item, int depth, int fmt)
 }
 
 /* Build an object from the text. */
-static const char* parse_object(cJSON* item, const char* value)
+/* The string just parsed is the item's name */
+static void parse_name(cJSON* item)
+{
+    item->string = item->valuestring;
+    item->valuestring = 0;
+    if(item->arenaFlags & cJSON_ArenaValueString)
+        item->arenaFlags = (item->arenaFlags & ~cJSON_ArenaValueString) | cJSON_ArenaString;
+}
+
+static const char* parse_object(cJSON* item, const char* value, cJSON_Arena* arena)
 {
     cJSON* child;
     if(*value != '{') {
@@ -592,45 +804,45 @@ static const char* parse_object(cJSON* item, const char* value)
     if(*value == '}')
         return value + 1; /* empty array. */
 
-    item->child = child = cJSON_New_Item();
+    item->child = child = cJSON_New_ParsedItem(arena);
     if(!item->child)
         return 0;
-    value = skip(parse_string(child, skip(value)));
+    value = skip(parse_string(child, skip(value), arena));
     if(!value)
         return 0;
-    child->string = child->valuestring;
-    child->valuestring = 0;
+    parse_name(child);
     if(*value != ':') {
         ep = value;
         return 0;
-    }                                                  /* fail! */
-    value = skip(parse_value(child, skip(value + 1))); /* skip any spacing, get the value. */
+    }                                                         /* fail! */
+    value = skip(parse_value(child, skip(value + 1), arena)); /* skip any spacing, get the value. */
     if(!value)
         return 0;
 
     while(*value == ',') {
         cJSON* new_item;
-        if(!(new_item = cJSON_New_Item()))
+        if(!(new_item = cJSON_New_ParsedItem(arena)))
             return 0; /* memory fail */
         child->next = new_item;
         new_item->prev = child;
         child = new_item;
-        value = skip(parse_string(child, skip(value + 1)));
+        value = skip(parse_string(child, skip(value + 1), arena));
         if(!value)
             return 0;
-        child->string = child->valuestring;
-        child->valuestring = 0;
+        parse_name(child);
         if(*value != ':') {
             ep = value;
             return 0;
-        }                                                  /* fail! */
-        value = skip(parse_value(child, skip(value + 1))); /* skip any spacing, get the value. */
+        }                                                         /* fail! */
+        value = skip(parse_value(child, skip(value + 1), arena)); /* skip any spacing, get the value. */
         if(!value)
             return 0;
     }
 
-    if(*value == '}')
-        return value + 1; /* end of array */
+    if(*value == '}') {
+        cJSON_BuildIndex(item);
+        return value + 1; /* end of object */
+    }
     ep = value;
     return 0; /* malformed. */
 }
@@ -731,22 +943,36 @@ static char* print_object(cJSON* item, int depth, int fmt)
 /* Get Array size/item / object item. */
 int cJSON_GetArraySize(cJSON* array)
 {
+    const cJSON_Index* index = array->index;
     cJSON* c = array->child;
     int i = 0;
+    if(index)
+        return index->count;
     while(c)
         i++, c = c->next;
     return i;
 }
 cJSON* cJSON_GetArrayItem(cJSON* array, int item)
 {
+    const cJSON_Index* index = array->index;
     cJSON* c = array->child;
+    if(index)
+        return item >= index->count ? 0 : index->items[item < 0 ? 0 : item];
     while(c && item > 0)
         item--, c = c->next;
     return c;
 }
 cJSON* cJSON_GetObjectItem(cJSON* object, const char* string)
 {
+    const cJSON_Index* index = object->index;
     cJSON* c = object->child;
+    if(index && index->bucketCount && string) {
+        int i = index->buckets[cJSON_HashName(string) & (index->bucketCount - 1)];
+        for(; i != -1; i = index->chain[i])
+            if(!cJSON_strcasecmp(index->items[i]->string, string))
+                return index->items[i];
+        return 0;
+    }
     while(c && cJSON_strcasecmp(c->string, string))
         c = c->next;
     return c;
@@ -766,6 +992,9 @@ static cJSON* create_reference(cJSON* item)
         return 0;
     memcpy(ref, item, sizeof(cJSON));
     ref->string = 0;
+    ref->index = 0;
+    ref->arena = 0;
+    ref->arenaFlags = 0;
     ref->type |= cJSON_IsReference;
     ref->next = ref->prev = 0;
     return ref;
@@ -777,6 +1006,7 @@ void cJSON_AddItemToArray(cJSON* array, cJSON* item)
     cJSON* c = array->child;
     if(!item)
         return;
+    cJSON_InvalidateIndex(array);
     if(!c) {
         array->child = item;
     } else {
@@ -789,8 +1019,9 @@ void cJSON_AddItemToObject(cJSON* object, const char* string, cJSON* item)
 {
     if(!item)
         return;
-    if(item->string)
+    if(item->string && !(item->arenaFlags & cJSON_ArenaString))
         cJSON_free(item->string);
+    item->arenaFlags &= ~cJSON_ArenaString;
     item->string = cJSON_strdup(string);
     cJSON_AddItemToArray(object, item);
 }
@@ -810,6 +1041,7 @@ cJSON* cJSON_DetachItemFromArray(cJSON* array, int which)
         c = c->next, which--;
     if(!c)
         return 0;
+    cJSON_InvalidateIndex(array);
     if(c->prev)
         c->prev->next = c->next;
     if(c->next)
@@ -846,6 +1078,7 @@ void cJSON_ReplaceItemInArray(cJSON* array, int which, cJSON* newitem)
         c = c->next, which--;
     if(!c)
         return;
+    cJSON_InvalidateIndex(array);
     newitem->next = c->next;
     newitem->prev = c->prev;
     if(newitem->next)
@@ -864,6 +1097,7 @@ void cJSON_ReplaceItemInObject(cJSON* object, const char* string, cJSON* newitem
     while(c && cJSON_strcasecmp(c->string, string))
         i++, c = c->next;
     if(c) {
+        newitem->arenaFlags &= ~cJSON_ArenaString;
         newitem->string = cJSON_strdup(string);
         cJSON_ReplaceItemInArray(object, i, newitem);
     }
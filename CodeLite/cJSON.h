@@ -63,6 +63,14 @@ extern "C" {
 
 #define cJSON_IsReference 256
 
+/* cJSON arena flags: what is owned by the arena of the document rather than allocated with cJSON_malloc */
+#define cJSON_ArenaItem 1        /* the cJSON structure itself */
+#define cJSON_ArenaString 2      /* the item's name */
+#define cJSON_ArenaValueString 4 /* the item's string value */
+
+struct cJSON_Index;
+struct cJSON_Arena;
+
 /* The cJSON structure: */
 typedef struct cJSON
 {
@@ -79,6 +87,10 @@ typedef struct cJSON
 
     char*
     string; /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
+
+    struct cJSON_Index* index; /* Index of the children of a large parsed array or object, see GetArrayItem */
+    struct cJSON_Arena* arena; /* The root of a document parsed by cJSON_ParseBuffer owns the arena of its items */
+    int arenaFlags;            /* The cJSON_Arena* flags above */
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -92,6 +104,13 @@ extern void cJSON_InitHooks(cJSON_Hooks* hooks);
 
 /* Supply a block of JSON, and this returns a cJSON object you can interrogate. Call cJSON_Delete when finished. */
 extern cJSON* cJSON_Parse(const char* value);
+/* Allocate / free a buffer with the cJSON hooks (malloc and free by default), e.g. for cJSON_ParseBuffer */
+extern char* cJSON_AllocBuffer(size_t size);
+extern void cJSON_FreeBuffer(char* buffer);
+/* Parse a NUL terminated buffer allocated with cJSON_AllocBuffer, taking ownership of it.
+ * The items are allocated from a single arena and the strings are decoded in place: the buffer and the arena are
+ * released with the root by cJSON_Delete. Items of such a document must not be moved to another document. */
+extern cJSON* cJSON_ParseBuffer(char* buffer);
 /* Render a cJSON entity to text for transfer/storage. Free the char* when finished. */
 extern char* cJSON_Print(cJSON* item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. Free the char* when finished. */
@@ -99,6 +118,9 @@ extern char* cJSON_PrintUnformatted(cJSON* item);
 /* Delete a cJSON entity and all subentities. */
 extern void cJSON_Delete(cJSON* c);
 
+/* The parser indexes the children of arrays and objects with many items, making the lookup functions below O(1).
+ * The index is dropped whenever the children change. The lookups never modify the document: several threads can
+ * read the same document at once, as long as none of them modifies it. */
 /* Returns the number of items in an array (or object). */
 extern int cJSON_GetArraySize(cJSON* array);
 /* Retrieve item number "item" from array "array". Returns NULL if unsuccessful. */
@@ -0,0 +1,62 @@
+#include "clByteSearcher.h"
+#include <string.h>
+
+static inline unsigned char FoldByte(unsigned char ch) { return (ch >= 'A' && ch <= 'Z') ? (ch + ('a' - 'A')) : ch; }
+
+clByteSearcher::clByteSearcher(const char* needle, bool matchCase)
+    : m_needle(needle)
+    , m_matchCase(matchCase)
+{
+    const size_t len = m_needle.length();
+    if(!m_matchCase) {
+        for(size_t i = 0; i < len; ++i) {
+            m_needle[i] = FoldByte(m_needle[i]);
+        }
+    }
+
+    // Horspool's bad character table
+    for(size_t i = 0; i < 256; ++i) {
+        m_shift[i] = len;
+    }
+    for(size_t i = 0; len && i < len - 1; ++i) {
+        m_shift[(unsigned char)m_needle[i]] = len - 1 - i;
+    }
+}
+
+const char* clByteSearcher::Find(const char* begin, const char* end) const
+{
+    const size_t len = m_needle.length();
+    if(len == 0 || begin > end || (size_t)(end - begin) < len) return NULL;
+
+    if(m_matchCase) {
+        // memchr is vectorized by the C library, use it to jump to the candidates
+        const char first = m_needle[0];
+        const char* last = end - len;
+        const char* p = begin;
+        while(p <= last) {
+            p = (const char*)::memchr(p, first, last - p + 1);
+            if(!p) return NULL;
+            if(::memcmp(p, m_needle.c_str(), len) == 0) return p;
+            ++p;
+        }
+        return NULL;
+    }
+
+    // Case insensitive: Horspool with the folding done on the fly
+    const unsigned char* needle = (const unsigned char*)m_needle.c_str();
+    const unsigned char* p = (const unsigned char*)begin;
+    const unsigned char* last = (const unsigned char*)end - len;
+    const unsigned char lastCh = needle[len - 1];
+    while(p <= last) {
+        unsigned char ch = FoldByte(p[len - 1]);
+        if(ch == lastCh) {
+            size_t i = 0;
+            while(i < len - 1 && FoldByte(p[i]) == needle[i]) {
+                ++i;
+            }
+            if(i == len - 1) return (const char*)p;
+        }
+        p += m_shift[ch];
+    }
+    return NULL;
+}
@@ -1,8 +1,8 @@
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //
-// Copyright            : (C) 2015 Eran Ifrah
-// File name            : CScopeSettingsDlg.h
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : clByteSearcher.h
 //
 // -------------------------------------------------------------------------
 // A
@@ -23,16 +23,36 @@
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-#ifndef CSCOPESETTINGSDLG_H
-#define CSCOPESETTINGSDLG_H
-#include "CscopeTabBase.h"
+#ifndef CLBYTESEARCHER_H
+#define CLBYTESEARCHER_H
 
-class CScopeSettingsDlg : public CScopeSettingsDlgBase
+#include <string>
+#include <stddef.h>
+#include "codelite_exports.h"
+
+/**
+ * @class clByteSearcher
+ * @brief substring search over raw UTF-8 bytes.
+ * Case sensitive searches jump between candidates with memchr, case insensitive searches use
+ * Horspool with ASCII folding done on the fly. The object is not modified by Find() and can be
+ * shared between threads
+ */
+class WXDLLIMPEXP_CL clByteSearcher
 {
+    std::string m_needle; // lower case when !m_matchCase
+    bool m_matchCase;
+    size_t m_shift[256];
+
 public:
-    CScopeSettingsDlg(wxWindow* parent);
-    virtual ~CScopeSettingsDlg();
-    
-    wxString GetPath() const { return m_filePickerCScopeExe->GetPath(); }
+    clByteSearcher(const char* needle, bool matchCase);
+    virtual ~clByteSearcher() {}
+
+    size_t GetLength() const { return m_needle.length(); }
+
+    /**
+     * @brief return the first occurrence of the needle in [begin, end) or NULL
+     */
+    const char* Find(const char* begin, const char* end) const;
 };
-#endif // CSCOPESETTINGSDLG_H
+
+#endif // CLBYTESEARCHER_H
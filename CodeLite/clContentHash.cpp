@@ -0,0 +1,189 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : clContentHash.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "clContentHash.h"
+#include <string.h>
+#include <stdio.h>
+
+#define PRIME64_1 11400714785074694791ULL
+#define PRIME64_2 14029467366897019727ULL
+#define PRIME64_3 1609587929392839161ULL
+#define PRIME64_4 9650029242287828579ULL
+#define PRIME64_5 2870177450012600261ULL
+
+static inline wxUint64 RotateLeft(wxUint64 x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// Read little endian words regardless of the host byte order
+static inline wxUint64 Read64(const unsigned char* p)
+{
+    return ((wxUint64)p[0]) | ((wxUint64)p[1] << 8) | ((wxUint64)p[2] << 16) | ((wxUint64)p[3] << 24) |
+           ((wxUint64)p[4] << 32) | ((wxUint64)p[5] << 40) | ((wxUint64)p[6] << 48) | ((wxUint64)p[7] << 56);
+}
+
+static inline wxUint64 Read32(const unsigned char* p)
+{
+    return ((wxUint64)p[0]) | ((wxUint64)p[1] << 8) | ((wxUint64)p[2] << 16) | ((wxUint64)p[3] << 24);
+}
+
+static inline wxUint64 Round(wxUint64 acc, wxUint64 input)
+{
+    acc += input * PRIME64_2;
+    acc = RotateLeft(acc, 31);
+    return acc * PRIME64_1;
+}
+
+static inline wxUint64 MergeRound(wxUint64 acc, wxUint64 val)
+{
+    acc ^= Round(0, val);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+clContentHash::clContentHash(wxUint64 seed)
+    : m_totalLength(0)
+    , m_v1(seed + PRIME64_1 + PRIME64_2)
+    , m_v2(seed + PRIME64_2)
+    , m_v3(seed)
+    , m_v4(seed - PRIME64_1)
+    , m_bufferSize(0)
+    , m_seed(seed)
+{
+}
+
+clContentHash::~clContentHash() {}
+
+void clContentHash::Update(const void* data, size_t len)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    const unsigned char* end = p + len;
+    m_totalLength += len;
+
+    // Not enough for a stripe, keep it for later
+    if(m_bufferSize + len < 32) {
+        memcpy(m_buffer + m_bufferSize, p, len);
+        m_bufferSize += len;
+        return;
+    }
+
+    // Complete the pending stripe
+    if(m_bufferSize) {
+        memcpy(m_buffer + m_bufferSize, p, 32 - m_bufferSize);
+        p += 32 - m_bufferSize;
+        m_v1 = Round(m_v1, Read64(m_buffer));
+        m_v2 = Round(m_v2, Read64(m_buffer + 8));
+        m_v3 = Round(m_v3, Read64(m_buffer + 16));
+        m_v4 = Round(m_v4, Read64(m_buffer + 24));
+        m_bufferSize = 0;
+    }
+
+    while(p + 32 <= end) {
+        m_v1 = Round(m_v1, Read64(p));
+        m_v2 = Round(m_v2, Read64(p + 8));
+        m_v3 = Round(m_v3, Read64(p + 16));
+        m_v4 = Round(m_v4, Read64(p + 24));
+        p += 32;
+    }
+
+    if(p < end) {
+        m_bufferSize = end - p;
+        memcpy(m_buffer, p, m_bufferSize);
+    }
+}
+
+wxUint64 clContentHash::GetDigest() const
+{
+    wxUint64 h;
+    if(m_totalLength >= 32) {
+        h = RotateLeft(m_v1, 1) + RotateLeft(m_v2, 7) + RotateLeft(m_v3, 12) + RotateLeft(m_v4, 18);
+        h = MergeRound(h, m_v1);
+        h = MergeRound(h, m_v2);
+        h = MergeRound(h, m_v3);
+        h = MergeRound(h, m_v4);
+    } else {
+        h = m_seed + PRIME64_5;
+    }
+    h += m_totalLength;
+
+    // The tail
+    const unsigned char* p = m_buffer;
+    const unsigned char* end = m_buffer + m_bufferSize;
+    while(p + 8 <= end) {
+        h ^= Round(0, Read64(p));
+        h = RotateLeft(h, 27) * PRIME64_1 + PRIME64_4;
+        p += 8;
+    }
+
+    if(p + 4 <= end) {
+        h ^= Read32(p) * PRIME64_1;
+        h = RotateLeft(h, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+
+    while(p < end) {
+        h ^= (*p) * PRIME64_5;
+        h = RotateLeft(h, 11) * PRIME64_1;
+        ++p;
+    }
+
+    // Avalanche
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+wxUint64 clContentHash::Hash(const void* data, size_t len, wxUint64 seed)
+{
+    clContentHash hash(seed);
+    hash.Update(data, len);
+    return hash.GetDigest();
+}
+
+wxString clContentHash::ToString(wxUint64 hash)
+{
+    wxString str;
+    str.Printf("%08x%08x", (unsigned int)(hash >> 32), (unsigned int)(hash & 0xFFFFFFFF));
+    return str;
+}
+
+wxString clContentHash::HashFile(const wxString& filename)
+{
+    FILE* fp = fopen(filename.mb_str(wxConvUTF8).data(), "rb");
+    if(!fp) {
+        return wxEmptyString;
+    }
+
+    clContentHash hash;
+    char buffer[64 * 1024];
+    size_t count = 0;
+    while((count = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+        hash.Update(buffer, count);
+    }
+
+    bool ok = (ferror(fp) == 0);
+    fclose(fp);
+    return ok ? ToString(hash.GetDigest()) : wxString();
+}
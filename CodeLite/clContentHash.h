@@ -0,0 +1,79 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : clContentHash.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CLCONTENTHASH_H
+#define CLCONTENTHASH_H
+
+#include <wx/string.h>
+#include "codelite_exports.h"
+
+/**
+ * @class clContentHash
+ * @brief a fast non cryptographic 64 bit hash (XXH64) of a content.
+ * Used to tell whether a file content changed since it was last parsed
+ */
+class WXDLLIMPEXP_CL clContentHash
+{
+    wxUint64 m_totalLength;
+    wxUint64 m_v1;
+    wxUint64 m_v2;
+    wxUint64 m_v3;
+    wxUint64 m_v4;
+    unsigned char m_buffer[32];
+    size_t m_bufferSize;
+    wxUint64 m_seed;
+
+public:
+    clContentHash(wxUint64 seed = 0);
+    virtual ~clContentHash();
+
+    /**
+     * @brief add 'len' bytes to the hashed content
+     */
+    void Update(const void* data, size_t len);
+
+    /**
+     * @brief return the hash of the content added so far
+     */
+    wxUint64 GetDigest() const;
+
+    /**
+     * @brief hash a buffer
+     */
+    static wxUint64 Hash(const void* data, size_t len, wxUint64 seed = 0);
+
+    /**
+     * @brief return the hash as a 16 characters hex string
+     */
+    static wxString ToString(wxUint64 hash);
+
+    /**
+     * @brief return the hash of the content of 'filename' as a string
+     * or an empty string if the file could not be read
+     */
+    static wxString HashFile(const wxString& filename);
+};
+
+#endif // CLCONTENTHASH_H
@@ -0,0 +1,405 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : clFileNameIndex.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "clFileNameIndex.h"
+#include "file_logger.h"
+#include <wx/wxsqlite3.h>
+#include <wx/stopwatch.h>
+#include <algorithm>
+#include <string.h>
+
+// The number of trigram buckets (the bucket is taken from the high 16 bits of the trigram hash)
+#define FILE_INDEX_BUCKETS 65536
+
+// Compact the index when there are more than max(FILE_INDEX_MIN_COMPACT, <number of files> / 4) removed entries
+#define FILE_INDEX_MIN_COMPACT 1024
+
+// Match scores, lower is better
+enum {
+    kScoreExactName = 0,
+    kScoreNamePrefix,
+    kScoreNameSubstring,
+    kScoreComponentPrefix,
+    kScorePathSubstring,
+    kScoreFuzzy, // + the number of gaps between the matched characters
+};
+
+namespace
+{
+struct FileNameMatch {
+    wxUint32 id;
+    int score;
+    size_t nameLen;
+    const char* folded;
+};
+
+bool FileNameMatchLess(const FileNameMatch& a, const FileNameMatch& b)
+{
+    if(a.score != b.score) return a.score < b.score;
+    if(a.nameLen != b.nameLen) return a.nameLen < b.nameLen;
+    return strcmp(a.folded, b.folded) < 0;
+}
+}
+
+static inline char FoldPathByte(char ch)
+{
+    if(ch >= 'A' && ch <= 'Z') return ch + ('a' - 'A');
+    return ch == '\\' ? '/' : ch;
+}
+
+static std::string FoldPath(const wxString& path)
+{
+    const wxCharBuffer cb = path.mb_str(wxConvUTF8);
+    std::string folded = cb.data() ? std::string(cb.data(), cb.length()) : std::string();
+    std::transform(folded.begin(), folded.end(), folded.begin(), FoldPathByte);
+    return folded;
+}
+
+static inline wxUint32 TrigramBucket(const char* p)
+{
+    wxUint32 trigram = ((wxUint32)(unsigned char)p[0] << 16) | ((wxUint32)(unsigned char)p[1] << 8) |
+                       (wxUint32)(unsigned char)p[2];
+    return (trigram * 0x9E3779B1u) >> 16;
+}
+
+/// Return a bitmask of the characters of 'str': a fuzzy match needs all the characters of the pattern
+static wxUint64 CharsMask(const char* str)
+{
+    wxUint64 mask = 0;
+    for(; *str; ++str) {
+        unsigned char ch = *str;
+        if(ch >= 'a' && ch <= 'z') {
+            mask |= (wxUint64)1 << (ch - 'a');
+        } else if(ch >= '0' && ch <= '9') {
+            mask |= (wxUint64)1 << (26 + ch - '0');
+        } else {
+            mask |= (wxUint64)1 << (36 + (ch % 28));
+        }
+    }
+    return mask;
+}
+
+/// Return the number of gaps between the characters of 'pattern' found in order in 'str',
+/// (a match that does not start 'str' counts as a gap) or -1 if 'pattern' is not a subsequence of 'str'
+static int SubsequenceGaps(const char* str, const char* pattern)
+{
+    int gaps = 0;
+    bool contiguous = true;
+    for(; *str && *pattern; ++str) {
+        if(*str == *pattern) {
+            if(!contiguous) ++gaps;
+            contiguous = true;
+            ++pattern;
+        } else {
+            contiguous = false;
+        }
+    }
+    return *pattern ? -1 : gaps;
+}
+
+clFileNameIndex::clFileNameIndex()
+    : m_removedEntries(0)
+{
+    m_buckets.resize(FILE_INDEX_BUCKETS);
+}
+
+clFileNameIndex::~clFileNameIndex() {}
+
+clFileNameIndex& clFileNameIndex::Get()
+{
+    static clFileNameIndex theIndex;
+    return theIndex;
+}
+
+void clFileNameIndex::DoClear()
+{
+    std::vector<Entry>().swap(m_entries);
+    std::vector<char>().swap(m_pool);
+    m_ids.clear();
+    for(size_t i = 0; i < m_buckets.size(); ++i) {
+        std::vector<wxUint32>().swap(m_buckets[i]);
+    }
+    m_removedEntries = 0;
+}
+
+void clFileNameIndex::DoAdd(const wxString& path)
+{
+    if(path.IsEmpty() || m_ids.count(path)) return;
+
+    std::string folded = FoldPath(path);
+    size_t slash = folded.rfind('/');
+
+    wxUint32 id = m_entries.size();
+    Entry entry;
+    entry.path = path;
+    entry.folded = m_pool.size();
+    entry.name = entry.folded + ((slash == std::string::npos) ? 0 : (slash + 1));
+    entry.nameChars = CharsMask(folded.c_str() + (entry.name - entry.folded));
+    entry.pathChars = CharsMask(folded.c_str());
+    entry.removed = false;
+    m_entries.push_back(entry);
+    m_pool.insert(m_pool.end(), folded.c_str(), folded.c_str() + folded.length() + 1);
+    m_ids.insert(std::make_pair(path, id));
+
+    // IDs are increasing: the buckets remain sorted
+    std::vector<wxUint32> buckets;
+    for(size_t i = 0; i + 3 <= folded.length(); ++i) {
+        buckets.push_back(TrigramBucket(folded.c_str() + i));
+    }
+    std::sort(buckets.begin(), buckets.end());
+    buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+    for(size_t i = 0; i < buckets.size(); ++i) {
+        m_buckets[buckets[i]].push_back(id);
+    }
+}
+
+void clFileNameIndex::DoRemove(const wxString& path)
+{
+    std::map<wxString, wxUint32>::iterator iter = m_ids.find(path);
+    if(iter == m_ids.end()) return;
+    m_entries[iter->second].removed = true;
+    m_ids.erase(iter);
+    ++m_removedEntries;
+}
+
+void clFileNameIndex::DoCompactIfNeeded()
+{
+    if(m_removedEntries > std::max((size_t)FILE_INDEX_MIN_COMPACT, m_entries.size() / 4)) {
+        DoCompact();
+    }
+}
+
+void clFileNameIndex::DoCompact()
+{
+    std::vector<Entry> entries;
+    entries.swap(m_entries);
+    DoClear();
+    for(size_t i = 0; i < entries.size(); ++i) {
+        if(!entries[i].removed) {
+            DoAdd(entries[i].path);
+        }
+    }
+}
+
+bool clFileNameIndex::Open(const wxFileName& tagsDb)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    if(m_filename.IsOk() && m_filename.GetFullPath() == tagsDb.GetFullPath()) return true;
+
+    DoClear();
+    m_filename.Clear();
+
+    wxStopWatch sw;
+    try {
+        wxSQLite3Database db;
+        db.Open(tagsDb.GetFullPath());
+        wxSQLite3ResultSet rs = db.ExecuteQuery("SELECT file FROM files");
+        while(rs.NextRow()) {
+            DoAdd(rs.GetString(0));
+        }
+        rs.Finalize();
+        db.Close();
+
+    } catch(wxSQLite3Exception& e) {
+        CL_WARNING("clFileNameIndex: failed to load files from %s: %s", tagsDb.GetFullPath(), e.GetMessage());
+        DoClear();
+        return false;
+    }
+
+    m_filename = tagsDb;
+    CL_DEBUG("clFileNameIndex: loaded %u files in %ld ms", (unsigned int)m_entries.size(), sw.Time());
+    return true;
+}
+
+void clFileNameIndex::Close()
+{
+    wxCriticalSectionLocker locker(m_cs);
+    DoClear();
+    m_filename.Clear();
+}
+
+bool clFileNameIndex::IsOpen()
+{
+    wxCriticalSectionLocker locker(m_cs);
+    return m_filename.IsOk();
+}
+
+bool clFileNameIndex::IsFor(const wxFileName& tagsDb)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    return m_filename.IsOk() && m_filename.GetFullPath() == tagsDb.GetFullPath();
+}
+
+void clFileNameIndex::AddFile(const wxString& file)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    DoAdd(file);
+}
+
+void clFileNameIndex::AddFiles(const wxArrayString& files)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        DoAdd(files.Item(i));
+    }
+}
+
+void clFileNameIndex::RemoveFiles(const wxArrayString& files)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        DoRemove(files.Item(i));
+    }
+    DoCompactIfNeeded();
+}
+
+void clFileNameIndex::RemoveFilesByPrefix(const wxString& prefix)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    std::map<wxString, wxUint32>::iterator iter = m_ids.lower_bound(prefix);
+    while(iter != m_ids.end() && iter->first.StartsWith(prefix)) {
+        m_entries[iter->second].removed = true;
+        ++m_removedEntries;
+        m_ids.erase(iter++);
+    }
+    DoCompactIfNeeded();
+}
+
+void clFileNameIndex::RenameFile(const wxString& oldName, const wxString& newName)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    if(!m_ids.count(oldName)) return;
+    DoRemove(oldName);
+    DoAdd(newName);
+    DoCompactIfNeeded();
+}
+
+void clFileNameIndex::Clear()
+{
+    wxCriticalSectionLocker locker(m_cs);
+    DoClear();
+}
+
+int clFileNameIndex::DoScore(const Entry& entry, const std::string& pattern) const
+{
+    const char* path = GetFolded(entry);
+    const char* name = GetName(entry);
+
+    const char* where = strstr(name, pattern.c_str());
+    if(where == name) {
+        return (name[pattern.length()] == 0) ? kScoreExactName : kScoreNamePrefix;
+    } else if(where) {
+        return kScoreNameSubstring;
+    }
+
+    where = strstr(path, pattern.c_str());
+    if(!where) return -1;
+    for(; where; where = strstr(where + 1, pattern.c_str())) {
+        if(where == path || where[-1] == '/' || pattern[0] == '/') return kScoreComponentPrefix;
+    }
+    return kScorePathSubstring;
+}
+
+int clFileNameIndex::DoFuzzyScore(const Entry& entry, const std::string& pattern, wxUint64 patternChars) const
+{
+    // Patterns with a separator are matched against the whole path
+    bool matchPath = (pattern.find('/') != std::string::npos);
+    wxUint64 chars = matchPath ? entry.pathChars : entry.nameChars;
+    if((chars & patternChars) != patternChars) return -1;
+
+    const char* str = matchPath ? GetFolded(entry) : GetName(entry);
+    int gaps = SubsequenceGaps(str, pattern.c_str());
+    return (gaps < 0) ? -1 : (kScoreFuzzy + gaps);
+}
+
+void clFileNameIndex::Find(const wxString& pattern, size_t flags, size_t limit, wxArrayString& files)
+{
+    wxString trimmed = pattern;
+    trimmed.Trim().Trim(false);
+    std::string folded = FoldPath(trimmed);
+    if(folded.empty()) return;
+    bool fuzzy = (flags & kFindFuzzy);
+    wxUint64 patternChars = CharsMask(folded.c_str());
+
+    wxCriticalSectionLocker locker(m_cs);
+    std::vector<FileNameMatch> matches;
+    std::vector<bool> matched;
+
+    const std::vector<wxUint32>* candidates = NULL;
+    for(size_t i = 0; i + 3 <= folded.length(); ++i) {
+        const std::vector<wxUint32>& bucket = m_buckets[TrigramBucket(folded.c_str() + i)];
+        if(!candidates || bucket.size() < candidates->size()) {
+            candidates = &bucket;
+        }
+    }
+
+    if(candidates) {
+        // Only the files of the smallest bucket can contain the pattern
+        for(size_t i = 0; i < candidates->size(); ++i) {
+            wxUint32 id = candidates->at(i);
+            const Entry& entry = m_entries[id];
+            if(entry.removed) continue;
+            int score = DoScore(entry, folded);
+            if(score < 0) continue;
+            FileNameMatch match = { id, score, strlen(GetName(entry)), GetFolded(entry) };
+            matches.push_back(match);
+        }
+    }
+
+    // Scan the files when the pattern is too short for the buckets or when there are not enough matches
+    bool scan = !candidates || (fuzzy && (limit == 0 || matches.size() < limit));
+    if(scan) {
+        if(candidates && fuzzy) {
+            matched.resize(m_entries.size(), false);
+            for(size_t i = 0; i < matches.size(); ++i) {
+                matched[matches[i].id] = true;
+            }
+        }
+
+        for(size_t id = 0; id < m_entries.size(); ++id) {
+            const Entry& entry = m_entries[id];
+            if(entry.removed || (!matched.empty() && matched[id])) continue;
+            int score = candidates ? -1 : DoScore(entry, folded);
+            if(score < 0 && fuzzy) {
+                score = DoFuzzyScore(entry, folded, patternChars);
+            }
+            if(score < 0) continue;
+            FileNameMatch match = { (wxUint32)id, score, strlen(GetName(entry)), GetFolded(entry) };
+            matches.push_back(match);
+        }
+    }
+
+    if(limit && matches.size() > limit) {
+        std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(), FileNameMatchLess);
+        matches.resize(limit);
+    } else {
+        std::sort(matches.begin(), matches.end(), FileNameMatchLess);
+    }
+
+    files.Alloc(files.GetCount() + matches.size());
+    for(size_t i = 0; i < matches.size(); ++i) {
+        files.Add(m_entries[matches[i].id].path);
+    }
+}
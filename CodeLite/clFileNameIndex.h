@@ -0,0 +1,147 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : clFileNameIndex.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CLFILENAMEINDEX_H
+#define CLFILENAMEINDEX_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <wx/string.h>
+#include <wx/arrstr.h>
+#include <wx/filename.h>
+#include <wx/thread.h>
+#include "codelite_exports.h"
+
+/**
+ * @class clFileNameIndex
+ * @brief an in-memory index of file paths answering "files matching what the user typed" lookups
+ * Every path is kept ASCII lower cased, in UTF-8 and with '/' as the separator in a single pool.
+ * The paths are bucketed by their (hashed) trigrams: a lookup only verifies the paths found in the
+ * smallest bucket of the pattern trigrams. Patterns shorter than a trigram and fuzzy lookups scan the paths.
+ * Matches are ranked by quality: exact file name, file name prefix, file name substring, path component
+ * prefix, path substring and finally (when requested) fuzzy matches, i.e. the pattern characters appear
+ * in order in the file name
+ *
+ * The instance returned by Get() indexes the FILES table of the tags database, it may hold names that
+ * are no longer in the database (e.g. rolled back transactions)
+ */
+class WXDLLIMPEXP_CL clFileNameIndex
+{
+public:
+    enum eFindFlags {
+        kFindDefault = 0,
+        kFindFuzzy = (1 << 0), // include fuzzy matches
+    };
+
+private:
+    struct Entry {
+        wxString path;
+        wxUint32 folded;    // offset of the folded path in the pool
+        wxUint32 name;      // offset of the folded file name in the pool
+        wxUint64 nameChars; // the characters of the file name (a bit per character class)
+        wxUint64 pathChars; // the characters of the path
+        bool removed;
+    };
+
+    std::vector<Entry> m_entries;
+    std::vector<char> m_pool;
+    std::map<wxString, wxUint32> m_ids;
+    std::vector<std::vector<wxUint32> > m_buckets;
+    size_t m_removedEntries;
+
+    wxFileName m_filename;
+    wxCriticalSection m_cs;
+
+private:
+    void DoClear();
+    void DoAdd(const wxString& path);
+    void DoRemove(const wxString& path);
+    void DoCompactIfNeeded();
+    void DoCompact();
+    int DoScore(const Entry& entry, const std::string& pattern) const;
+    int DoFuzzyScore(const Entry& entry, const std::string& pattern, wxUint64 patternChars) const;
+    const char* GetFolded(const Entry& entry) const { return &m_pool[entry.folded]; }
+    const char* GetName(const Entry& entry) const { return &m_pool[entry.name]; }
+
+public:
+    clFileNameIndex();
+    virtual ~clFileNameIndex();
+
+    /**
+     * @brief the index of the files of the tags database
+     */
+    static clFileNameIndex& Get();
+
+    /**
+     * @brief load the files of the tags database 'tagsDb'
+     */
+    bool Open(const wxFileName& tagsDb);
+
+    /**
+     * @brief free the index
+     */
+    void Close();
+
+    bool IsOpen();
+
+    /**
+     * @brief return true if the index was loaded from 'tagsDb'
+     */
+    bool IsFor(const wxFileName& tagsDb);
+
+    /**
+     * @brief add files to the index. Files already in the index are ignored
+     */
+    void AddFile(const wxString& file);
+    void AddFiles(const wxArrayString& files);
+
+    /**
+     * @brief remove files from the index
+     */
+    void RemoveFiles(const wxArrayString& files);
+
+    /**
+     * @brief remove all the files starting with 'prefix'
+     */
+    void RemoveFilesByPrefix(const wxString& prefix);
+
+    void RenameFile(const wxString& oldName, const wxString& newName);
+
+    /**
+     * @brief remove all files (the index remains open)
+     */
+    void Clear();
+
+    /**
+     * @brief find the files matching 'pattern' (ASCII case insensitive, '\\' and '/' are the same)
+     * @param flags a combination of eFindFlags
+     * @param limit the maximum number of files to return, 0 means no limit
+     * @param files [output] the matching files, best match first
+     */
+    void Find(const wxString& pattern, size_t flags, size_t limit, wxArrayString& files);
+};
+
+#endif // CLFILENAMEINDEX_H
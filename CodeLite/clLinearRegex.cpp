@@ -0,0 +1,718 @@
+#include "clLinearRegex.h"
+#include <string.h>
+
+// Limits the program size of patterns like (a{255}){255}
+#define RE_MAX_PROGRAM_SIZE 20000
+#define RE_MAX_REPEAT 255
+
+namespace
+{
+//--------------------------------------------------------------
+// The parsed pattern
+//--------------------------------------------------------------
+struct ReNode {
+    enum eType { kConcat, kClass, kAlt, kRepeat, kAssert };
+    eType type;
+    int value; // class index or assertion opcode
+    int min;
+    int max; // -1 means unbounded
+    std::vector<ReNode> children;
+
+    ReNode(eType t = kConcat, int v = 0)
+        : type(t)
+        , value(v)
+        , min(0)
+        , max(0)
+    {
+    }
+};
+
+static inline bool IsAsciiAlpha(unsigned char ch) { return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'); }
+static inline bool IsAsciiDigit(unsigned char ch) { return ch >= '0' && ch <= '9'; }
+static inline bool IsAsciiAlnum(unsigned char ch) { return IsAsciiAlpha(ch) || IsAsciiDigit(ch); }
+
+//--------------------------------------------------------------
+// Pattern parser (recursive descent)
+//--------------------------------------------------------------
+class ReParser
+{
+    const std::string& m_re;
+    size_t m_pos;
+    bool m_matchCase;
+    std::vector<clLinearRegex::ByteSet>& m_classes;
+    bool m_error;
+
+public:
+    ReParser(const std::string& re, bool matchCase, std::vector<clLinearRegex::ByteSet>& classes)
+        : m_re(re)
+        , m_pos(0)
+        , m_matchCase(matchCase)
+        , m_classes(classes)
+        , m_error(false)
+    {
+    }
+
+    bool Parse(ReNode& root)
+    {
+        root = ParseAlt();
+        return !m_error && m_pos == m_re.length();
+    }
+
+private:
+    bool HasMore() const { return !m_error && m_pos < m_re.length(); }
+    unsigned char Peek() const { return (unsigned char)m_re[m_pos]; }
+
+    ReNode MakeClass(clLinearRegex::ByteSet set)
+    {
+        // A line break is never matched
+        set.bits['\n' >> 5] &= ~(1u << ('\n' & 31));
+        if(!m_matchCase) {
+            for(unsigned char ch = 'a'; ch <= 'z'; ++ch) {
+                unsigned char upper = ch - ('a' - 'A');
+                if(set.Contains(ch) || set.Contains(upper)) {
+                    set.Add(ch);
+                    set.Add(upper);
+                }
+            }
+        }
+        m_classes.push_back(set);
+        return ReNode(ReNode::kClass, (int)m_classes.size() - 1);
+    }
+
+    ReNode MakeByte(unsigned char from, unsigned char to)
+    {
+        clLinearRegex::ByteSet set;
+        set.AddRange(from, to);
+        m_classes.push_back(set);
+        return ReNode(ReNode::kClass, (int)m_classes.size() - 1);
+    }
+
+    // Any ASCII character that is not in 'set' or any multi bytes UTF-8 sequence
+    ReNode MakeNegatedClass(const clLinearRegex::ByteSet& set)
+    {
+        clLinearRegex::ByteSet complement;
+        for(unsigned int ch = 0; ch < 0x80; ++ch) {
+            if(!set.Contains((unsigned char)ch)) complement.Add((unsigned char)ch);
+        }
+
+        ReNode alt(ReNode::kAlt);
+        alt.children.push_back(MakeClass(complement));
+        for(int bytes = 2; bytes <= 4; ++bytes) {
+            ReNode seq(ReNode::kConcat);
+            if(bytes == 2) seq.children.push_back(MakeByte(0xC2, 0xDF));
+            if(bytes == 3) seq.children.push_back(MakeByte(0xE0, 0xEF));
+            if(bytes == 4) seq.children.push_back(MakeByte(0xF0, 0xF4));
+            for(int i = 1; i < bytes; ++i) {
+                seq.children.push_back(MakeByte(0x80, 0xBF));
+            }
+            alt.children.push_back(seq);
+        }
+        return alt;
+    }
+
+    ReNode ParseAlt()
+    {
+        ReNode alt(ReNode::kAlt);
+        alt.children.push_back(ParseConcat());
+        while(HasMore() && Peek() == '|') {
+            ++m_pos;
+            alt.children.push_back(ParseConcat());
+        }
+        if(alt.children.size() == 1) return alt.children[0];
+        return alt;
+    }
+
+    ReNode ParseConcat()
+    {
+        ReNode concat(ReNode::kConcat);
+        while(HasMore() && Peek() != '|' && Peek() != ')') {
+            ReNode atom = ParseAtom();
+            if(m_error) break;
+            ParseQuantifier(atom);
+            concat.children.push_back(atom);
+        }
+        return concat;
+    }
+
+    bool ParseNumber(int& num)
+    {
+        if(!HasMore() || !IsAsciiDigit(Peek())) return false;
+        num = 0;
+        while(HasMore() && IsAsciiDigit(Peek())) {
+            num = num * 10 + (Peek() - '0');
+            if(num > RE_MAX_REPEAT) return false;
+            ++m_pos;
+        }
+        return true;
+    }
+
+    void ParseQuantifier(ReNode& atom)
+    {
+        if(!HasMore()) return;
+        int min, max;
+        unsigned char ch = Peek();
+        if(ch == '*') {
+            min = 0;
+            max = -1;
+            ++m_pos;
+        } else if(ch == '+') {
+            min = 1;
+            max = -1;
+            ++m_pos;
+        } else if(ch == '?') {
+            min = 0;
+            max = 1;
+            ++m_pos;
+        } else if(ch == '{') {
+            ++m_pos;
+            if(!ParseNumber(min)) {
+                m_error = true;
+                return;
+            }
+            max = min;
+            if(HasMore() && Peek() == ',') {
+                ++m_pos;
+                max = -1;
+                if(HasMore() && Peek() != '}' && (!ParseNumber(max) || max < min)) {
+                    m_error = true;
+                    return;
+                }
+            }
+            if(!HasMore() || Peek() != '}') {
+                m_error = true;
+                return;
+            }
+            ++m_pos;
+        } else {
+            return;
+        }
+
+        // Non greedy quantifiers change the match wxRegEx picks, the engine always picks the longest match
+        if(HasMore() && Peek() == '?') {
+            m_error = true;
+            return;
+        }
+
+        if(atom.type == ReNode::kAssert || (HasMore() && (Peek() == '*' || Peek() == '+' || Peek() == '?' || Peek() == '{'))) {
+            m_error = true;
+            return;
+        }
+
+        ReNode repeat(ReNode::kRepeat);
+        repeat.min = min;
+        repeat.max = max;
+        repeat.children.push_back(atom);
+        atom = repeat;
+    }
+
+    ReNode ParseLiteral()
+    {
+        unsigned char ch = Peek();
+        if(ch < 0x80) {
+            ++m_pos;
+            clLinearRegex::ByteSet set;
+            set.Add(ch);
+            return MakeClass(set);
+        }
+
+        // A multi bytes UTF-8 character. We don't fold non ASCII characters
+        if(!m_matchCase) {
+            m_error = true;
+            return ReNode();
+        }
+        ReNode seq(ReNode::kConcat);
+        seq.children.push_back(MakeByte(ch, ch));
+        ++m_pos;
+        while(HasMore() && (Peek() & 0xC0) == 0x80) {
+            seq.children.push_back(MakeByte(Peek(), Peek()));
+            ++m_pos;
+        }
+        return seq;
+    }
+
+    // Add the set for the escape 'ch' (\d or \t), return false for other escapes.
+    // wxRegEx matches \w \s (and the word boundaries built on \w) against Unicode letters and spaces, a byte
+    // set can't do the same so these are rejected and the search falls back to wxRegEx
+    bool AddEscapeClass(unsigned char ch, clLinearRegex::ByteSet& set)
+    {
+        switch(ch) {
+        case 'd':
+            set.AddRange('0', '9');
+            return true;
+        case 't':
+            set.Add('\t');
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    ReNode ParseEscape()
+    {
+        ++m_pos; // skip the backslash
+        if(!HasMore()) {
+            m_error = true;
+            return ReNode();
+        }
+
+        unsigned char ch = Peek();
+        if(!IsAsciiAlnum(ch)) {
+            // escaped punctuation
+            return ParseLiteral();
+        }
+
+        ++m_pos;
+        clLinearRegex::ByteSet set;
+        if(AddEscapeClass(ch, set)) {
+            return MakeClass(set);
+        }
+
+        switch(ch) {
+        case 'D':
+            AddEscapeClass('d', set);
+            return MakeNegatedClass(set);
+        default:
+            // \w \s \y \m and their negations, back references, \x, \u, \b ... are not supported
+            m_error = true;
+            return ReNode();
+        }
+    }
+
+    ReNode ParseBracket()
+    {
+        ++m_pos; // skip '['
+        bool negate = false;
+        if(HasMore() && Peek() == '^') {
+            negate = true;
+            ++m_pos;
+        }
+
+        clLinearRegex::ByteSet set;
+        bool first = true;
+        while(HasMore() && (first || Peek() != ']')) {
+            first = false;
+            unsigned char ch = Peek();
+            if(ch >= 0x80) {
+                // non ASCII members are not supported
+                m_error = true;
+                break;
+            }
+
+            if(ch == '[' && m_pos + 1 < m_re.length() && m_re[m_pos + 1] == ':') {
+                size_t end = m_re.find(":]", m_pos + 2);
+                if(end == std::string::npos || !AddNamedClass(m_re.substr(m_pos + 2, end - m_pos - 2), set)) {
+                    m_error = true;
+                    break;
+                }
+                m_pos = end + 2;
+                continue;
+            }
+
+            if(ch == '[' && m_pos + 1 < m_re.length() && (m_re[m_pos + 1] == '.' || m_re[m_pos + 1] == '=')) {
+                // collating elements and equivalence classes
+                m_error = true;
+                break;
+            }
+
+            if(ch == '\\') {
+                ++m_pos;
+                if(!HasMore()) {
+                    m_error = true;
+                    break;
+                }
+                ch = Peek();
+                if(IsAsciiAlnum(ch)) {
+                    ++m_pos;
+                    if(!AddEscapeClass(ch, set)) {
+                        m_error = true;
+                        break;
+                    }
+                    continue;
+                }
+            }
+
+            ++m_pos;
+            unsigned char to = ch;
+            if(m_pos + 1 < m_re.length() && Peek() == '-' && m_re[m_pos + 1] != ']') {
+                to = (unsigned char)m_re[m_pos + 1];
+                if(to >= 0x80 || to == '\\' || to < ch) {
+                    m_error = true;
+                    break;
+                }
+                m_pos += 2;
+            }
+            set.AddRange(ch, to);
+        }
+
+        if(!HasMore() || Peek() != ']') {
+            m_error = true;
+            return ReNode();
+        }
+        ++m_pos;
+
+        if(negate) {
+            if(!m_matchCase) {
+                // fold the set before negating it
+                for(unsigned char ch = 'a'; ch <= 'z'; ++ch) {
+                    unsigned char upper = ch - ('a' - 'A');
+                    if(set.Contains(ch) || set.Contains(upper)) {
+                        set.Add(ch);
+                        set.Add(upper);
+                    }
+                }
+            }
+            return MakeNegatedClass(set);
+        }
+        return MakeClass(set);
+    }
+
+    // Only the classes that are ASCII in wxRegEx too: [:alpha:], [:space:] ... also match Unicode characters
+    bool AddNamedClass(const std::string& name, clLinearRegex::ByteSet& set)
+    {
+        if(name == "digit") {
+            set.AddRange('0', '9');
+        } else if(name == "xdigit") {
+            set.AddRange('0', '9');
+            set.AddRange('a', 'f');
+            set.AddRange('A', 'F');
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    ReNode ParseAtom()
+    {
+        unsigned char ch = Peek();
+        switch(ch) {
+        case '(': {
+            ++m_pos;
+            if(HasMore() && Peek() == '?') {
+                // only non capturing groups are supported (no embedded options or lookahead)
+                if(m_pos + 1 < m_re.length() && m_re[m_pos + 1] == ':') {
+                    m_pos += 2;
+                } else {
+                    m_error = true;
+                    return ReNode();
+                }
+            }
+            ReNode group = ParseAlt();
+            if(!HasMore() || Peek() != ')') {
+                m_error = true;
+                return ReNode();
+            }
+            ++m_pos;
+            return group;
+        }
+        case '[':
+            return ParseBracket();
+        case '.':
+            ++m_pos;
+            return MakeNegatedClass(clLinearRegex::ByteSet());
+        case '^':
+            ++m_pos;
+            return ReNode(ReNode::kAssert, clLinearRegex::kOpBOL);
+        case '$':
+            ++m_pos;
+            return ReNode(ReNode::kAssert, clLinearRegex::kOpEOL);
+        case '\\':
+            return ParseEscape();
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            // quantifier without an operand (or ARE directives like '***=')
+            m_error = true;
+            return ReNode();
+        default:
+            return ParseLiteral();
+        }
+    }
+};
+
+//--------------------------------------------------------------
+// Program generation
+//--------------------------------------------------------------
+class ReCompiler
+{
+    std::vector<clLinearRegex::Instruction>& m_program;
+
+    int Emit(const clLinearRegex::Instruction& inst)
+    {
+        m_program.push_back(inst);
+        return (int)m_program.size() - 1;
+    }
+    int Next() const { return (int)m_program.size(); }
+
+public:
+    ReCompiler(std::vector<clLinearRegex::Instruction>& program)
+        : m_program(program)
+    {
+    }
+
+    bool Compile(const ReNode& node)
+    {
+        if(m_program.size() > RE_MAX_PROGRAM_SIZE) return false;
+
+        switch(node.type) {
+        case ReNode::kConcat:
+            for(size_t i = 0; i < node.children.size(); ++i) {
+                if(!Compile(node.children[i])) return false;
+            }
+            return true;
+
+        case ReNode::kClass:
+            Emit(clLinearRegex::Instruction(clLinearRegex::kOpClass, node.value));
+            return true;
+
+        case ReNode::kAssert:
+            Emit(clLinearRegex::Instruction((clLinearRegex::eOpCode)node.value));
+            return true;
+
+        case ReNode::kAlt: {
+            std::vector<int> jumps;
+            for(size_t i = 0; i < node.children.size(); ++i) {
+                if(i + 1 < node.children.size()) {
+                    int split = Emit(clLinearRegex::Instruction(clLinearRegex::kOpSplit, Next() + 1));
+                    if(!Compile(node.children[i])) return false;
+                    jumps.push_back(Emit(clLinearRegex::Instruction(clLinearRegex::kOpJump)));
+                    m_program[split].y = Next();
+                } else if(!Compile(node.children[i])) {
+                    return false;
+                }
+            }
+            for(size_t i = 0; i < jumps.size(); ++i) {
+                m_program[jumps[i]].x = Next();
+            }
+            return true;
+        }
+
+        case ReNode::kRepeat: {
+            const ReNode& child = node.children[0];
+            for(int i = 0; i < node.min; ++i) {
+                if(!Compile(child)) return false;
+            }
+
+            if(node.max == -1) {
+                int loop = Emit(clLinearRegex::Instruction(clLinearRegex::kOpSplit, Next() + 1));
+                if(!Compile(child)) return false;
+                Emit(clLinearRegex::Instruction(clLinearRegex::kOpJump, loop));
+                m_program[loop].y = Next();
+
+            } else {
+                std::vector<int> splits;
+                for(int i = node.min; i < node.max; ++i) {
+                    splits.push_back(Emit(clLinearRegex::Instruction(clLinearRegex::kOpSplit, Next() + 1)));
+                    if(!Compile(child)) return false;
+                }
+                for(size_t i = 0; i < splits.size(); ++i) {
+                    m_program[splits[i]].y = Next();
+                }
+            }
+            return true;
+        }
+        }
+        return false;
+    }
+};
+
+struct ReThread {
+    int pc;
+    size_t start;
+    ReThread(int p, size_t s)
+        : pc(p)
+        , start(s)
+    {
+    }
+};
+}
+
+clLinearRegex::clLinearRegex()
+    : m_ok(false)
+{
+}
+
+clLinearRegex::~clLinearRegex() {}
+
+void clLinearRegex::Reset()
+{
+    m_program.clear();
+    m_classes.clear();
+    m_firstBytes.Clear();
+    m_ok = false;
+}
+
+bool clLinearRegex::Compile(const wxString& pattern, bool matchCase)
+{
+    Reset();
+    if(pattern.IsEmpty()) return false;
+
+    std::string re = pattern.mb_str(wxConvUTF8).data();
+    ReNode root;
+    ReParser parser(re, matchCase, m_classes);
+    if(!parser.Parse(root)) {
+        Reset();
+        return false;
+    }
+
+    ReCompiler compiler(m_program);
+    if(!compiler.Compile(root) || m_program.size() > RE_MAX_PROGRAM_SIZE) {
+        Reset();
+        return false;
+    }
+    m_program.push_back(Instruction(kOpMatch));
+    DoComputeFirstBytes();
+    m_ok = true;
+    return true;
+}
+
+void clLinearRegex::DoComputeFirstBytes()
+{
+    // Collect the classes reachable from the start without consuming a byte
+    // Assertions are followed as if they always succeed which gives a super set
+    m_firstBytes.Clear();
+    std::vector<bool> visited(m_program.size(), false);
+    std::vector<int> stack(1, 0);
+    while(!stack.empty()) {
+        int pc = stack.back();
+        stack.pop_back();
+        if(visited[pc]) continue;
+        visited[pc] = true;
+
+        const Instruction& inst = m_program[pc];
+        switch(inst.op) {
+        case kOpClass:
+            for(size_t i = 0; i < 8; ++i) {
+                m_firstBytes.bits[i] |= m_classes[inst.x].bits[i];
+            }
+            break;
+        case kOpJump:
+            stack.push_back(inst.x);
+            break;
+        case kOpSplit:
+            stack.push_back(inst.x);
+            stack.push_back(inst.y);
+            break;
+        case kOpMatch:
+            break;
+        default:
+            stack.push_back(pc + 1);
+            break;
+        }
+    }
+}
+
+bool clLinearRegex::DoCheckAssertion(eOpCode op, const char* buffer, size_t len, size_t pos) const
+{
+    switch(op) {
+    case kOpBOL:
+        return pos == 0 || buffer[pos - 1] == '\n';
+    case kOpEOL:
+        return pos == len || buffer[pos] == '\n';
+    default:
+        return false;
+    }
+}
+
+bool clLinearRegex::Find(const char* buffer, size_t len, size_t from, size_t& matchStart, size_t& matchLen) const
+{
+    if(!m_ok || from >= len) return false;
+
+    std::vector<ReThread> clist, nlist;
+    std::vector<size_t> marks(m_program.size(), (size_t)-1);
+    std::vector<int> stack;
+    clist.reserve(m_program.size());
+    nlist.reserve(m_program.size());
+
+    bool matched = false;
+    size_t bestStart = 0, bestEnd = 0;
+
+    // Add the thread 'pc' and all the threads reachable from it without consuming a byte
+    // 'marks' ensures that each instruction appears only once per position
+    struct Adder {
+        static void Add(const clLinearRegex* re,
+                        std::vector<ReThread>& list,
+                        std::vector<size_t>& marks,
+                        std::vector<int>& stack,
+                        int startPc,
+                        size_t start,
+                        const char* buffer,
+                        size_t len,
+                        size_t pos)
+        {
+            stack.clear();
+            stack.push_back(startPc);
+            while(!stack.empty()) {
+                int pc = stack.back();
+                stack.pop_back();
+                if(marks[pc] == pos) continue;
+                marks[pc] = pos;
+
+                const Instruction& inst = re->m_program[pc];
+                switch(inst.op) {
+                case kOpJump:
+                    stack.push_back(inst.x);
+                    break;
+                case kOpSplit:
+                    // 'x' is preferred: push it last
+                    stack.push_back(inst.y);
+                    stack.push_back(inst.x);
+                    break;
+                case kOpClass:
+                case kOpMatch:
+                    list.push_back(ReThread(pc, start));
+                    break;
+                default:
+                    if(re->DoCheckAssertion(inst.op, buffer, len, pos)) {
+                        stack.push_back(pc + 1);
+                    }
+                    break;
+                }
+            }
+        }
+    };
+
+    for(size_t pos = from; pos <= len; ++pos) {
+        if(!matched && pos < len) {
+            if(clist.empty()) {
+                // Nothing is in progress: jump to the next byte that can start a match
+                while(pos < len && !m_firstBytes.Contains((unsigned char)buffer[pos])) {
+                    ++pos;
+                }
+                if(pos == len) break;
+            }
+            // The new thread has the lowest priority (it starts last)
+            Adder::Add(this, clist, marks, stack, 0, pos, buffer, len, pos);
+        }
+
+        if(clist.empty()) {
+            // the new thread failed an assertion
+            if(matched || pos >= len) break;
+            continue;
+        }
+
+        nlist.clear();
+        for(size_t i = 0; i < clist.size(); ++i) {
+            const ReThread& t = clist[i];
+            if(matched && t.start > bestStart) continue;
+
+            const Instruction& inst = m_program[t.pc];
+            if(inst.op == kOpMatch) {
+                // Empty matches are ignored
+                if(t.start < pos && (!matched || t.start < bestStart || (t.start == bestStart && pos > bestEnd))) {
+                    matched = true;
+                    bestStart = t.start;
+                    bestEnd = pos;
+                }
+            } else if(pos < len && m_classes[inst.x].Contains((unsigned char)buffer[pos])) {
+                Adder::Add(this, nlist, marks, stack, t.pc + 1, t.start, buffer, len, pos + 1);
+            }
+        }
+        clist.swap(nlist);
+    }
+
+    if(!matched) return false;
+    matchStart = bestStart;
+    matchLen = bestEnd - bestStart;
+    return true;
+}
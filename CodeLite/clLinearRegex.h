@@ -0,0 +1,130 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : clLinearRegex.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CLLINEARREGEX_H
+#define CLLINEARREGEX_H
+
+#include <vector>
+#include <wx/string.h>
+#include "codelite_exports.h"
+
+/**
+ * @class clLinearRegex
+ * @brief a regular expression engine that runs in linear time over a UTF-8 buffer
+ * The pattern is compiled once into a program that is executed with a Pike VM (a breadth first
+ * simulation of the NFA) so there is no backtracking. Matches follow the leftmost-longest rule and never
+ * span a line break, '^' and '$' match at the start / end of every line.
+ *
+ * The supported syntax is a subset of the advanced regular expressions used by wxRegEx:
+ * literals, '.', bracket expressions (including ranges, [:digit:] and [:xdigit:]), groups, alternation,
+ * the quantifiers * + ? {n,m}, the escapes \d \D \t and the anchors ^ $. Compile() returns false for
+ * anything else (e.g. back references or non greedy quantifiers) so the caller can fallback to wxRegEx.
+ * \w \s, the word boundaries and the other [:class:] are rejected too: wxRegEx matches them against
+ * Unicode characters while this engine only knows ASCII
+ */
+class WXDLLIMPEXP_CL clLinearRegex
+{
+public:
+    enum eOpCode {
+        kOpClass,   // consume one byte that belongs to a class
+        kOpSplit,   // continue at 'x' and at 'y' ('x' is preferred)
+        kOpJump,    // continue at 'x'
+        kOpBOL,     // assert start of a line
+        kOpEOL,     // assert end of a line
+        kOpMatch,
+    };
+
+    struct Instruction {
+        eOpCode op;
+        int x;
+        int y;
+        Instruction(eOpCode o, int a = 0, int b = 0)
+            : op(o)
+            , x(a)
+            , y(b)
+        {
+        }
+    };
+
+    // A set of bytes
+    struct ByteSet {
+        unsigned int bits[8];
+        ByteSet() { Clear(); }
+        void Clear()
+        {
+            for(size_t i = 0; i < 8; ++i)
+                bits[i] = 0;
+        }
+        void Add(unsigned char ch) { bits[ch >> 5] |= (1u << (ch & 31)); }
+        void AddRange(unsigned char from, unsigned char to)
+        {
+            for(unsigned int ch = from; ch <= to; ++ch)
+                Add((unsigned char)ch);
+        }
+        bool Contains(unsigned char ch) const { return (bits[ch >> 5] & (1u << (ch & 31))) != 0; }
+    };
+
+private:
+    std::vector<Instruction> m_program;
+    std::vector<ByteSet> m_classes;
+    ByteSet m_firstBytes; // the bytes that can start a match
+    bool m_ok;
+
+public:
+    clLinearRegex();
+    virtual ~clLinearRegex();
+
+    /**
+     * @brief compile 'pattern'
+     * @return false if the pattern is invalid or uses an unsupported construct
+     */
+    bool Compile(const wxString& pattern, bool matchCase);
+
+    /**
+     * @brief forget the compiled pattern
+     */
+    void Reset();
+
+    bool IsOk() const { return m_ok; }
+
+    /**
+     * @brief find the first (non empty) match in buffer[from, len)
+     * This method does not modify the object and can be called from multiple threads
+     * @param buffer the UTF-8 buffer. The bytes before 'from' are used for the '^' and word boundary assertions
+     * @param matchStart [output] offset of the match in buffer
+     * @param matchLen [output] the match length in bytes
+     */
+    bool Find(const char* buffer, size_t len, size_t from, size_t& matchStart, size_t& matchLen) const;
+
+    // Used by the compiler
+    std::vector<Instruction>& GetProgram() { return m_program; }
+    std::vector<ByteSet>& GetClasses() { return m_classes; }
+
+private:
+    void DoComputeFirstBytes();
+    bool DoCheckAssertion(eOpCode op, const char* buffer, size_t len, size_t pos) const;
+};
+
+#endif // CLLINEARREGEX_H
@@ -0,0 +1,153 @@
+#include "clMappedFile.h"
+#include <wx/ffile.h>
+#include <wx/log.h>
+
+#ifdef __WXMSW__
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+clMappedFile::clMappedFile()
+    : m_data(NULL)
+    , m_size(0)
+    , m_mapped(false)
+#ifdef __WXMSW__
+    , m_hFile(INVALID_HANDLE_VALUE)
+    , m_hMapping(NULL)
+#endif
+{
+}
+
+clMappedFile::~clMappedFile() { Close(); }
+
+bool clMappedFile::Open(const wxFileName& filename)
+{
+    Close();
+    wxString path = filename.GetFullPath();
+
+#ifdef __WXMSW__
+    HANDLE hFile = ::CreateFileW(path.wc_str(),
+                                 GENERIC_READ,
+                                 FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                 NULL,
+                                 OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                 NULL);
+    if(hFile == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if(!::GetFileSizeEx(hFile, &fileSize)) {
+        ::CloseHandle(hFile);
+        return false;
+    }
+
+    if(fileSize.QuadPart == 0) {
+        // Can't map an empty file
+        ::CloseHandle(hFile);
+        return true;
+    }
+
+    HANDLE hMapping = ::CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(hMapping == NULL) {
+        ::CloseHandle(hFile);
+        return DoReadIntoBuffer(filename);
+    }
+
+    void* view = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if(view == NULL) {
+        ::CloseHandle(hMapping);
+        ::CloseHandle(hFile);
+        return DoReadIntoBuffer(filename);
+    }
+
+    m_hFile = hFile;
+    m_hMapping = hMapping;
+    m_data = (const char*)view;
+    m_size = (size_t)fileSize.QuadPart;
+    m_mapped = true;
+    return true;
+#else
+    int fd = ::open(path.mb_str(wxConvFile).data(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat st;
+    if(::fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    if(st.st_size == 0) {
+        // Can't map an empty file
+        ::close(fd);
+        return true;
+    }
+
+    void* view = ::mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping remains valid after the descriptor is closed
+    ::close(fd);
+    if(view == MAP_FAILED) {
+        return DoReadIntoBuffer(filename);
+    }
+
+#ifdef MADV_SEQUENTIAL
+    ::madvise(view, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+
+    m_data = (const char*)view;
+    m_size = (size_t)st.st_size;
+    m_mapped = true;
+    return true;
+#endif
+}
+
+bool clMappedFile::DoReadIntoBuffer(const wxFileName& filename)
+{
+    wxFFile fp(filename.GetFullPath(), "rb");
+    if(!fp.IsOpened()) return false;
+
+    wxFileOffset len = fp.Length();
+    if(len <= 0) return len == 0;
+
+    char* buffer = new char[len];
+    if(fp.Read(buffer, len) != (size_t)len) {
+        delete[] buffer;
+        return false;
+    }
+    m_data = buffer;
+    m_size = (size_t)len;
+    m_mapped = false;
+    return true;
+}
+
+void clMappedFile::Close()
+{
+    if(m_data) {
+        if(!m_mapped) {
+            delete[] m_data;
+        } else {
+#ifdef __WXMSW__
+            ::UnmapViewOfFile(m_data);
+#else
+            ::munmap((void*)m_data, m_size);
+#endif
+        }
+    }
+#ifdef __WXMSW__
+    if(m_hMapping) {
+        ::CloseHandle((HANDLE)m_hMapping);
+    }
+    if(m_hFile != INVALID_HANDLE_VALUE) {
+        ::CloseHandle((HANDLE)m_hFile);
+    }
+    m_hMapping = NULL;
+    m_hFile = INVALID_HANDLE_VALUE;
+#endif
+    m_data = NULL;
+    m_size = 0;
+    m_mapped = false;
+}
@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : clMappedFile.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CLMAPPEDFILE_H
+#define CLMAPPEDFILE_H
+
+#include <wx/string.h>
+#include <wx/filename.h>
+#include "codelite_exports.h"
+
+/**
+ * @class clMappedFile
+ * @brief a read-only view of a file content. The file is memory mapped when possible
+ * and read into a private buffer otherwise. The view is released when the object is destroyed
+ */
+class WXDLLIMPEXP_CL clMappedFile
+{
+    const char* m_data;
+    size_t m_size;
+    bool m_mapped;
+#ifdef __WXMSW__
+    void* m_hFile;
+    void* m_hMapping;
+#endif
+
+private:
+    clMappedFile(const clMappedFile&);
+    clMappedFile& operator=(const clMappedFile&);
+    bool DoReadIntoBuffer(const wxFileName& filename);
+
+public:
+    clMappedFile();
+    virtual ~clMappedFile();
+
+    /**
+     * @brief open the file and map its content
+     * @return true on success. An empty file is a success with Size() == 0
+     */
+    bool Open(const wxFileName& filename);
+
+    /**
+     * @brief release the view
+     */
+    void Close();
+
+    /**
+     * @brief return a pointer to the file content. The content is NOT null terminated
+     */
+    const char* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+    bool IsMapped() const { return m_mapped; }
+};
+
+#endif // CLMAPPEDFILE_H
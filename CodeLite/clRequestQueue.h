@@ -0,0 +1,202 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : clRequestQueue.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CLREQUESTQUEUE_H
+#define CLREQUESTQUEUE_H
+
+#include <deque>
+#include <map>
+#include <wx/string.h>
+#include <wx/thread.h>
+
+enum eRequestPriority {
+    kRequestPriorityLow = 0, // background work (e.g. retagging)
+    kRequestPriorityNormal,
+    kRequestPriorityHigh, // a user is waiting for the result
+};
+
+/**
+ * @class clRequestQueue
+ * @brief a blocking queue of heap allocated requests, consumed by one or more threads.
+ * Requests are served by priority, and in order of arrival within the same priority.
+ * A request posted with a non empty key replaces the queued request with the same key (the older
+ * request is deleted and the new one is queued after the requests that arrived in the meantime).
+ * Once Shutdown() is called, the queued requests are deleted and Receive() returns NULL.
+ * The queue owns the requests it holds
+ */
+template <typename T> class clRequestQueue
+{
+    struct Entry {
+        T* request;
+        wxString key;
+    };
+
+    std::deque<Entry> m_queues[kRequestPriorityHigh + 1];
+    std::map<wxString, int> m_keys; // the queued requests posted with a key and their priority
+    wxMutex m_mutex;
+    wxCondition m_cond;
+    bool m_shutdown;
+
+private:
+    clRequestQueue(const clRequestQueue& rhs);
+    clRequestQueue& operator=(const clRequestQueue& rhs);
+
+    void DoClear()
+    {
+        for(int i = 0; i <= kRequestPriorityHigh; ++i) {
+            for(size_t j = 0; j < m_queues[i].size(); ++j) {
+                delete m_queues[i].at(j).request;
+            }
+            m_queues[i].clear();
+        }
+        m_keys.clear();
+    }
+
+    bool DoRemove(const wxString& key)
+    {
+        typename std::map<wxString, int>::iterator iter = m_keys.find(key);
+        if(iter == m_keys.end()) return false;
+
+        std::deque<Entry>& queue = m_queues[iter->second];
+        for(typename std::deque<Entry>::iterator it = queue.begin(); it != queue.end(); ++it) {
+            if(it->key == key) {
+                delete it->request;
+                queue.erase(it);
+                break;
+            }
+        }
+        m_keys.erase(iter);
+        return true;
+    }
+
+public:
+    clRequestQueue()
+        : m_cond(m_mutex)
+        , m_shutdown(false)
+    {
+    }
+
+    virtual ~clRequestQueue() { DoClear(); }
+
+    /**
+     * @brief add a request to the queue
+     * @param request heap allocated request, owned by the queue from now on
+     * @param priority one of eRequestPriority
+     * @param key if not empty, a queued request with the same key is replaced by this one
+     * @return false if the queue is shut down (the request is deleted)
+     */
+    bool Post(T* request, int priority = kRequestPriorityNormal, const wxString& key = wxEmptyString)
+    {
+        wxMutexLocker locker(m_mutex);
+        if(m_shutdown) {
+            delete request;
+            return false;
+        }
+
+        if(priority < kRequestPriorityLow) priority = kRequestPriorityLow;
+        if(priority > kRequestPriorityHigh) priority = kRequestPriorityHigh;
+
+        Entry entry;
+        entry.request = request;
+        entry.key = key.c_str(); // deep copy, the key is used by other threads
+
+        if(!key.IsEmpty()) {
+            // Don't take the place of the older request: a request queued after it (e.g. a delete
+            // of the same file) must still be served before this one
+            DoRemove(key);
+            m_keys.insert(std::make_pair(entry.key, priority));
+        }
+
+        m_queues[priority].push_back(entry);
+        m_cond.Signal();
+        return true;
+    }
+
+    /**
+     * @brief wait for a request
+     * @return the request with the highest priority (the caller takes ownership)
+     * or NULL if the queue was shut down
+     */
+    T* Receive()
+    {
+        wxMutexLocker locker(m_mutex);
+        while(true) {
+            if(m_shutdown) return NULL;
+            for(int i = kRequestPriorityHigh; i >= kRequestPriorityLow; --i) {
+                if(!m_queues[i].empty()) {
+                    Entry entry = m_queues[i].front();
+                    m_queues[i].pop_front();
+                    if(!entry.key.IsEmpty()) {
+                        m_keys.erase(entry.key);
+                    }
+                    return entry.request;
+                }
+            }
+            m_cond.Wait();
+        }
+        return NULL;
+    }
+
+    /**
+     * @brief delete the queued requests and wake up all the threads waiting in Receive()
+     */
+    void Shutdown()
+    {
+        wxMutexLocker locker(m_mutex);
+        m_shutdown = true;
+        DoClear();
+        m_cond.Broadcast();
+    }
+
+    /**
+     * @brief accept requests again after Shutdown()
+     */
+    void Reset()
+    {
+        wxMutexLocker locker(m_mutex);
+        m_shutdown = false;
+    }
+
+    /**
+     * @brief delete the queued requests
+     */
+    void Clear()
+    {
+        wxMutexLocker locker(m_mutex);
+        DoClear();
+    }
+
+    size_t GetCount()
+    {
+        wxMutexLocker locker(m_mutex);
+        size_t count = 0;
+        for(int i = 0; i <= kRequestPriorityHigh; ++i) {
+            count += m_queues[i].size();
+        }
+        return count;
+    }
+};
+
+#endif // CLREQUESTQUEUE_H
@@ -0,0 +1,542 @@
+#include "clSymbolIndex.h"
+#include "file_logger.h"
+#include <wx/wxsqlite3.h>
+#include <wx/stopwatch.h>
+#include <algorithm>
+#include <string.h>
+
+// Merge the recently added tags into the sorted table when there are more than
+// max(SYMBOL_INDEX_MIN_MERGE, <sorted table size> / 8) of them
+#define SYMBOL_INDEX_MIN_MERGE 4096
+
+// The loader checks whether it was cancelled every SYMBOL_INDEX_LOAD_CHECK rows
+#define SYMBOL_INDEX_LOAD_CHECK 10000
+
+static inline unsigned char FoldSymbolByte(unsigned char ch) { return (ch >= 'A' && ch <= 'Z') ? (ch + ('a' - 'A')) : ch; }
+
+static inline std::string ToUTF8(const wxString& str)
+{
+    const wxCharBuffer cb = str.mb_str(wxConvUTF8);
+    return cb.data() ? std::string(cb.data(), cb.length()) : std::string();
+}
+
+static inline bool SameByte(char a, char b, bool matchCase)
+{
+    return matchCase ? (a == b) : (FoldSymbolByte((unsigned char)a) == FoldSymbolByte((unsigned char)b));
+}
+
+/// Compare two names the way the sorted table is ordered: ASCII case insensitive first
+static int FoldedCompare(const char* a, const char* b)
+{
+    const unsigned char* p1 = (const unsigned char*)a;
+    const unsigned char* p2 = (const unsigned char*)b;
+    for(; *p1 && FoldSymbolByte(*p1) == FoldSymbolByte(*p2); ++p1, ++p2) {
+    }
+    return (int)FoldSymbolByte(*p1) - (int)FoldSymbolByte(*p2);
+}
+
+static bool StartsWith(const char* name, const std::string& prefix, bool matchCase)
+{
+    for(size_t i = 0; i < prefix.length(); ++i) {
+        if(name[i] == 0 || !SameByte(name[i], prefix[i], matchCase)) return false;
+    }
+    return true;
+}
+
+static bool Contains(const char* name, const std::string& needle, bool matchCase)
+{
+    if(needle.empty()) return true;
+    for(; *name; ++name) {
+        if(SameByte(*name, needle[0], matchCase) && StartsWith(name, needle, matchCase)) return true;
+    }
+    return false;
+}
+
+/// Loads the symbols of the tags database, see clSymbolIndex::Open()
+class clSymbolIndexLoader : public wxThread
+{
+    wxString m_tagsDb;
+    size_t m_loadId;
+
+public:
+    clSymbolIndexLoader(const wxString& tagsDb, size_t loadId)
+        : wxThread(wxTHREAD_DETACHED)
+        , m_tagsDb(tagsDb.c_str())
+        , m_loadId(loadId)
+    {
+    }
+    virtual ~clSymbolIndexLoader() {}
+
+    virtual void* Entry()
+    {
+        clSymbolIndex::Get().DoLoad(m_tagsDb, m_loadId);
+        return NULL;
+    }
+};
+
+clSymbolIndex::clSymbolIndex()
+    : m_removedEntries(0)
+    , m_ready(false)
+    , m_loadId(0)
+{
+}
+
+clSymbolIndex::~clSymbolIndex() {}
+
+clSymbolIndex& clSymbolIndex::Get()
+{
+    static clSymbolIndex theIndex;
+    return theIndex;
+}
+
+void clSymbolIndex::DoClear()
+{
+    std::vector<Entry>().swap(m_entries);
+    std::vector<char>().swap(m_names);
+    std::vector<Entry>().swap(m_added);
+    std::vector<char>().swap(m_addedNames);
+    m_scopes.clear();
+    m_kinds.clear();
+    m_files.clear();
+    m_fileEntries.clear();
+    m_removedFiles.clear();
+    m_removedEntries = 0;
+}
+
+void clSymbolIndex::DoSwap(clSymbolIndex& other)
+{
+    m_entries.swap(other.m_entries);
+    m_names.swap(other.m_names);
+    m_added.swap(other.m_added);
+    m_addedNames.swap(other.m_addedNames);
+    m_scopes.swap(other.m_scopes);
+    m_kinds.swap(other.m_kinds);
+    m_files.swap(other.m_files);
+    m_fileEntries.swap(other.m_fileEntries);
+    m_removedFiles.swap(other.m_removedFiles);
+    std::swap(m_removedEntries, other.m_removedEntries);
+}
+
+bool clSymbolIndex::IsFor(const wxFileName& tagsDb) const
+{
+    return m_filename.IsOk() && m_filename.GetFullPath() == tagsDb.GetFullPath();
+}
+
+bool clSymbolIndex::Open(const wxFileName& tagsDb)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    if(IsFor(tagsDb)) return true;
+
+    // Reading the whole table takes a while on large databases: the index is built by a
+    // worker thread and the lookups are answered by the database until it is ready
+    DoClear();
+    std::vector<Change>().swap(m_changes);
+    m_filename = tagsDb;
+    m_ready = false;
+    ++m_loadId;
+
+    clSymbolIndexLoader* loader = new clSymbolIndexLoader(tagsDb.GetFullPath(), m_loadId);
+    if(loader->Create() != wxTHREAD_NO_ERROR || loader->Run() != wxTHREAD_NO_ERROR) {
+        CL_WARNING("clSymbolIndex: failed to start the loader thread");
+        delete loader;
+        m_filename.Clear();
+        return false;
+    }
+    return true;
+}
+
+bool clSymbolIndex::IsLoadCancelled(size_t loadId)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    return m_loadId != loadId;
+}
+
+void clSymbolIndex::DoLoad(const wxFileName& tagsDb, size_t loadId)
+{
+    // The symbols are loaded into a private index, the lock is taken only to publish it
+    clSymbolIndex index;
+    wxStopWatch sw;
+    try {
+        wxSQLite3Database db;
+        db.Open(tagsDb.GetFullPath());
+        wxSQLite3ResultSet rs = db.ExecuteQuery("SELECT ID, name, kind, scope, file FROM tags");
+        size_t count = 0;
+        while(rs.NextRow()) {
+            index.DoAdd(
+                rs.GetString(1), rs.GetString(2), rs.GetString(3), rs.GetString(4), rs.GetInt64(0).GetValue());
+            if((++count % SYMBOL_INDEX_LOAD_CHECK) == 0 && IsLoadCancelled(loadId)) {
+                return;
+            }
+        }
+        rs.Finalize();
+        db.Close();
+
+    } catch(wxSQLite3Exception& e) {
+        CL_WARNING("clSymbolIndex: failed to load symbols from %s: %s", tagsDb.GetFullPath(), e.GetMessage());
+        wxCriticalSectionLocker locker(m_cs);
+        if(m_loadId == loadId) {
+            // stop recording changes, the lookups keep using the database
+            std::vector<Change>().swap(m_changes);
+            m_filename.Clear();
+        }
+        return;
+    }
+    index.DoMerge();
+
+    wxCriticalSectionLocker locker(m_cs);
+    if(m_loadId != loadId) return;
+
+    DoSwap(index);
+    // Apply the changes made to the database during the load. The changes that were
+    // already part of what we read add the same IDs again, the merge drops them
+    if(!m_changes.empty()) {
+        for(size_t i = 0; i < m_changes.size(); ++i) {
+            DoApplyChange(m_changes[i]);
+        }
+        std::vector<Change>().swap(m_changes);
+        DoMerge();
+    }
+    m_ready = true;
+    CL_DEBUG("clSymbolIndex: loaded %u symbols in %ld ms", (unsigned int)m_entries.size(), sw.Time());
+}
+
+void clSymbolIndex::Close()
+{
+    wxCriticalSectionLocker locker(m_cs);
+    ++m_loadId; // cancel the load in progress
+    DoClear();
+    std::vector<Change>().swap(m_changes);
+    m_filename.Clear();
+    m_ready = false;
+}
+
+bool clSymbolIndex::IsOpen()
+{
+    wxCriticalSectionLocker locker(m_cs);
+    return m_filename.IsOk();
+}
+
+void clSymbolIndex::DoAdd(const wxString& name,
+                          const wxString& kind,
+                          const wxString& scope,
+                          const wxString& file,
+                          wxInt64 id)
+{
+    Entry entry;
+    entry.id = id;
+
+    std::string str = ToUTF8(name);
+    entry.name = m_addedNames.size();
+    m_addedNames.insert(m_addedNames.end(), str.c_str(), str.c_str() + str.length() + 1);
+
+    str = ToUTF8(scope);
+    std::map<std::string, wxUint32>::iterator iter = m_scopes.find(str);
+    if(iter == m_scopes.end()) {
+        iter = m_scopes.insert(std::make_pair(str, (wxUint32)m_scopes.size())).first;
+    }
+    entry.scope = iter->second;
+
+    str = ToUTF8(kind);
+    entry.kind = std::find(m_kinds.begin(), m_kinds.end(), str) - m_kinds.begin();
+    if(entry.kind == m_kinds.size()) {
+        m_kinds.push_back(str);
+    }
+
+    // removed files are not in m_files anymore: a file stored again gets a new ID
+    str = ToUTF8(file);
+    iter = m_files.find(str);
+    if(iter == m_files.end()) {
+        iter = m_files.insert(std::make_pair(str, (wxUint32)m_fileEntries.size())).first;
+        m_fileEntries.push_back(0);
+        m_removedFiles.push_back(false);
+    }
+    entry.file = iter->second;
+    m_fileEntries[entry.file]++;
+
+    m_added.push_back(entry);
+}
+
+void clSymbolIndex::DoRemoveFileId(wxUint32 fileId)
+{
+    if(m_removedFiles[fileId]) return;
+    m_removedFiles[fileId] = true;
+    m_removedEntries += m_fileEntries[fileId];
+}
+
+void clSymbolIndex::DoMergeIfNeeded()
+{
+    size_t threshold = std::max((size_t)SYMBOL_INDEX_MIN_MERGE, m_entries.size() / 8);
+    if(m_added.size() > threshold || m_removedEntries > threshold) {
+        DoMerge();
+    }
+}
+
+void clSymbolIndex::DoMerge()
+{
+    struct MergeItem {
+        const char* name;
+        Entry entry;
+    };
+
+    // The IDs of the removed files are reused: renumber the files that are still indexed
+    std::vector<wxUint32> fileIds(m_fileEntries.size(), (wxUint32)-1);
+    std::vector<wxUint32> fileEntries;
+    std::map<std::string, wxUint32>::iterator fileIter = m_files.begin();
+    for(; fileIter != m_files.end(); ++fileIter) {
+        fileIds[fileIter->second] = fileEntries.size();
+        fileEntries.push_back(m_fileEntries[fileIter->second]);
+        fileIter->second = fileIds[fileIter->second];
+    }
+
+    std::vector<MergeItem> items;
+    items.reserve(m_entries.size() + m_added.size());
+    for(size_t i = 0; i < m_entries.size(); ++i) {
+        if(m_removedFiles[m_entries[i].file]) continue;
+        MergeItem item = { &m_names[m_entries[i].name], m_entries[i] };
+        item.entry.file = fileIds[item.entry.file];
+        items.push_back(item);
+    }
+    for(size_t i = 0; i < m_added.size(); ++i) {
+        if(m_removedFiles[m_added[i].file]) continue;
+        MergeItem item = { &m_addedNames[m_added[i].name], m_added[i] };
+        item.entry.file = fileIds[item.entry.file];
+        items.push_back(item);
+    }
+
+    std::sort(items.begin(), items.end(), [](const MergeItem& a, const MergeItem& b) {
+        int cmp = FoldedCompare(a.name, b.name);
+        if(cmp == 0) cmp = strcmp(a.name, b.name);
+        return cmp < 0 || (cmp == 0 && a.entry.id < b.entry.id);
+    });
+
+    // Build the new table, equal names share the same pool entry
+    std::vector<Entry> entries;
+    std::vector<char> names;
+    entries.reserve(items.size());
+    const char* prevName = NULL;
+    wxUint32 prevOffset = 0;
+    for(size_t i = 0; i < items.size(); ++i) {
+        // an ID added twice, see DoLoad()
+        if(i > 0 && items[i].entry.id == items[i - 1].entry.id) continue;
+
+        Entry entry = items[i].entry;
+        if(prevName && strcmp(prevName, items[i].name) == 0) {
+            entry.name = prevOffset;
+        } else {
+            entry.name = names.size();
+            names.insert(names.end(), items[i].name, items[i].name + strlen(items[i].name) + 1);
+            prevName = items[i].name;
+            prevOffset = entry.name;
+        }
+        entries.push_back(entry);
+    }
+
+    m_entries.swap(entries);
+    m_names.swap(names);
+    std::vector<Entry>().swap(m_added);
+    std::vector<char>().swap(m_addedNames);
+
+    // the removed entries are gone now
+    m_fileEntries.swap(fileEntries);
+    m_removedFiles.assign(m_fileEntries.size(), false);
+    m_removedEntries = 0;
+}
+
+void clSymbolIndex::DoRemoveFile(const wxString& file)
+{
+    std::map<std::string, wxUint32>::iterator iter = m_files.find(ToUTF8(file));
+    if(iter == m_files.end()) return;
+
+    DoRemoveFileId(iter->second);
+    m_files.erase(iter);
+}
+
+void clSymbolIndex::DoRemoveFilesByPrefix(const wxString& prefix)
+{
+    std::string str = ToUTF8(prefix);
+    std::map<std::string, wxUint32>::iterator iter = m_files.lower_bound(str);
+    while(iter != m_files.end() && iter->first.compare(0, str.length(), str) == 0) {
+        DoRemoveFileId(iter->second);
+        m_files.erase(iter++);
+    }
+}
+
+void clSymbolIndex::DoApplyChange(const Change& change)
+{
+    switch(change.type) {
+    case Change::kAddSymbols:
+        for(size_t i = 0; i < change.symbols.size(); ++i) {
+            const Symbol& symbol = change.symbols[i];
+            DoAdd(symbol.name, symbol.kind, symbol.scope, symbol.file, symbol.id);
+        }
+        break;
+    case Change::kRemoveFile:
+        DoRemoveFile(change.file);
+        break;
+    case Change::kRemoveFilesByPrefix:
+        DoRemoveFilesByPrefix(change.file);
+        break;
+    }
+}
+
+void clSymbolIndex::AddSymbols(const wxFileName& tagsDb, const std::vector<Symbol>& symbols)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    if(!IsFor(tagsDb)) return;
+
+    if(!m_ready) {
+        // applied once the index is loaded
+        Change change;
+        change.type = Change::kAddSymbols;
+        change.symbols = symbols;
+        m_changes.push_back(change);
+        return;
+    }
+
+    for(size_t i = 0; i < symbols.size(); ++i) {
+        const Symbol& symbol = symbols[i];
+        DoAdd(symbol.name, symbol.kind, symbol.scope, symbol.file, symbol.id);
+    }
+    DoMergeIfNeeded();
+}
+
+void clSymbolIndex::RemoveFile(const wxFileName& tagsDb, const wxString& file)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    if(!IsFor(tagsDb)) return;
+
+    Change change;
+    change.type = Change::kRemoveFile;
+    change.file = file.c_str();
+    if(!m_ready) {
+        m_changes.push_back(change);
+        return;
+    }
+    DoApplyChange(change);
+    DoMergeIfNeeded();
+}
+
+void clSymbolIndex::RemoveFilesByPrefix(const wxFileName& tagsDb, const wxString& prefix)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    if(!IsFor(tagsDb)) return;
+
+    Change change;
+    change.type = Change::kRemoveFilesByPrefix;
+    change.file = prefix.c_str();
+    if(!m_ready) {
+        m_changes.push_back(change);
+        return;
+    }
+    DoApplyChange(change);
+    DoMergeIfNeeded();
+}
+
+void clSymbolIndex::Clear(const wxFileName& tagsDb)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    if(!IsFor(tagsDb)) return;
+
+    // The database is empty now: a load in progress is no longer needed
+    ++m_loadId;
+    std::vector<Change>().swap(m_changes);
+    DoClear();
+    m_ready = true;
+}
+
+bool clSymbolIndex::DoFind(const Query& query,
+                           const std::vector<Entry>& entries,
+                           const char* pool,
+                           bool sorted,
+                           std::vector<wxInt64>& ids) const
+{
+    // Resolve the filters to IDs
+    std::vector<bool> scopes;
+    if(!query.scopes.IsEmpty()) {
+        scopes.resize(m_scopes.size(), false);
+        bool found = false;
+        for(size_t i = 0; i < query.scopes.GetCount(); ++i) {
+            std::map<std::string, wxUint32>::const_iterator iter =
+                m_scopes.find(ToUTF8(query.scopes.Item(i)));
+            if(iter != m_scopes.end()) {
+                scopes[iter->second] = true;
+                found = true;
+            }
+        }
+        if(!found) return true;
+    }
+
+    std::vector<bool> kinds;
+    if(!query.kinds.IsEmpty()) {
+        kinds.resize(m_kinds.size(), false);
+        bool found = false;
+        for(size_t i = 0; i < query.kinds.GetCount(); ++i) {
+            std::vector<std::string>::const_iterator iter =
+                std::find(m_kinds.begin(), m_kinds.end(), ToUTF8(query.kinds.Item(i)));
+            if(iter != m_kinds.end()) {
+                kinds[iter - m_kinds.begin()] = true;
+                found = true;
+            }
+        }
+        if(!found) return true;
+    }
+
+    const std::string name = ToUTF8(query.name);
+    size_t first = 0;
+    bool stopOnMismatch = false;
+    if(sorted && (query.match == kMatchExact || query.match == kMatchPrefix)) {
+        // All the candidates are consecutive in the sorted table
+        std::vector<Entry>::const_iterator iter =
+            std::lower_bound(entries.begin(), entries.end(), name, [pool](const Entry& entry, const std::string& key) {
+                return FoldedCompare(pool + entry.name, key.c_str()) < 0;
+            });
+        first = iter - entries.begin();
+        stopOnMismatch = true;
+    }
+
+    // Names are tested once per distinct pool offset
+    wxUint32 lastName = (wxUint32)-1;
+    bool lastMatch = false;
+    for(size_t i = first; i < entries.size(); ++i) {
+        const Entry& entry = entries[i];
+        if(entry.name != lastName) {
+            const char* entryName = pool + entry.name;
+            lastName = entry.name;
+            if(stopOnMismatch && !StartsWith(entryName, name, false)) break;
+
+            switch(query.match) {
+            case kMatchExact:
+                lastMatch = StartsWith(entryName, name, query.matchCase) && entryName[name.length()] == 0;
+                break;
+            case kMatchPrefix:
+                lastMatch = StartsWith(entryName, name, query.matchCase);
+                break;
+            case kMatchSubstring:
+                lastMatch = Contains(entryName, name, query.matchCase);
+                break;
+            }
+        }
+
+        if(!lastMatch) continue;
+        if(m_removedFiles[entry.file]) continue;
+        if(!scopes.empty() && !scopes[entry.scope]) continue;
+        if(!kinds.empty() && !kinds[entry.kind]) continue;
+
+        ids.push_back(entry.id);
+        if(query.limit && ids.size() >= query.limit) return false;
+    }
+    return true;
+}
+
+bool clSymbolIndex::Find(const wxFileName& tagsDb, const Query& query, std::vector<wxInt64>& ids)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    if(!IsFor(tagsDb) || !m_ready) return false;
+
+    // DoFind() returns false once the limit is reached
+    if(!m_entries.empty() && !DoFind(query, m_entries, &m_names[0], true, ids)) return true;
+    if(!m_added.empty()) {
+        DoFind(query, m_added, &m_addedNames[0], false, ids);
+    }
+    return true;
+}
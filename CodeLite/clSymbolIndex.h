@@ -0,0 +1,196 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : clSymbolIndex.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CLSYMBOLINDEX_H
+#define CLSYMBOLINDEX_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <wx/string.h>
+#include <wx/arrstr.h>
+#include <wx/filename.h>
+#include <wx/thread.h>
+#include "codelite_exports.h"
+
+/**
+ * @class clSymbolIndex
+ * @brief an in-memory index of the symbol names of the tags database.
+ * The index is a sorted string table: one record per tag (name, kind, scope, file and the tag ID)
+ * ordered by the (ASCII lower cased) name, with the names stored once in a single UTF-8 pool.
+ * Name lookups (exact, prefix and substring) are answered with tag IDs, the tags
+ * themselves are fetched from the database by ID.
+ * The index is loaded by a worker thread, until it is ready lookups return false and the changes
+ * made to the database are recorded, they are applied once the load completes.
+ * New tags are appended to a small unsorted table which is merged into the sorted one when it grows.
+ * Tags of removed files are skipped by lookups and dropped by the next merge.
+ * The index may return IDs of tags that are no longer in the database (e.g. replaced tags or
+ * rolled back transactions), these IDs simply fetch nothing
+ */
+class WXDLLIMPEXP_CL clSymbolIndex
+{
+public:
+    enum eMatchType {
+        kMatchExact,
+        kMatchPrefix,
+        kMatchSubstring,
+    };
+
+    /**
+     * @brief a tag as seen by the index
+     */
+    struct Symbol {
+        wxInt64 id;
+        wxString name;
+        wxString kind;
+        wxString scope;
+        wxString file;
+    };
+
+    /**
+     * @brief a name lookup
+     */
+    struct Query {
+        wxString name;
+        eMatchType match;
+        bool matchCase;
+        wxArrayString scopes; // if not empty, only tags from these scopes are returned
+        wxArrayString kinds;  // if not empty, only tags of these kinds are returned
+        size_t limit;         // 0 means no limit
+
+        Query()
+            : match(kMatchPrefix)
+            , matchCase(false)
+            , limit(0)
+        {
+        }
+    };
+
+private:
+    struct Entry {
+        wxInt64 id;
+        wxUint32 name; // offset in the names pool
+        wxUint32 scope;
+        wxUint32 file;
+        wxUint32 kind;
+    };
+
+    // the sorted table
+    std::vector<Entry> m_entries;
+    std::vector<char> m_names;
+
+    // recently added tags, not sorted
+    std::vector<Entry> m_added;
+    std::vector<char> m_addedNames;
+
+    std::map<std::string, wxUint32> m_scopes;
+    std::vector<std::string> m_kinds;
+    std::map<std::string, wxUint32> m_files;
+    std::vector<wxUint32> m_fileEntries; // number of entries per file ID
+    std::vector<bool> m_removedFiles;    // file IDs that were removed
+    size_t m_removedEntries;
+
+    // A change made to the database while the index is loaded
+    struct Change {
+        enum eType { kAddSymbols, kRemoveFile, kRemoveFilesByPrefix };
+        eType type;
+        std::vector<Symbol> symbols;
+        wxString file;
+    };
+
+    wxFileName m_filename;
+    bool m_ready;                 // the index is loaded
+    size_t m_loadId;              // identifies the current load, changed to cancel it
+    std::vector<Change> m_changes; // changes made while loading
+    wxCriticalSection m_cs;
+
+    friend class clSymbolIndexLoader;
+
+private:
+    clSymbolIndex();
+    virtual ~clSymbolIndex();
+
+    void DoClear();
+    void DoSwap(clSymbolIndex& other);
+    bool IsFor(const wxFileName& tagsDb) const;
+    void DoLoad(const wxFileName& tagsDb, size_t loadId);
+    bool IsLoadCancelled(size_t loadId);
+    void DoApplyChange(const Change& change);
+    void DoAdd(const wxString& name, const wxString& kind, const wxString& scope, const wxString& file, wxInt64 id);
+    void DoRemoveFile(const wxString& file);
+    void DoRemoveFilesByPrefix(const wxString& prefix);
+    void DoRemoveFileId(wxUint32 fileId);
+    void DoMergeIfNeeded();
+    void DoMerge();
+    bool DoFind(const Query& query, const std::vector<Entry>& entries, const char* pool, bool sorted,
+                std::vector<wxInt64>& ids) const;
+
+public:
+    static clSymbolIndex& Get();
+
+    /**
+     * @brief start loading the symbols of the tags database 'tagsDb' in the background
+     * @return false if the loader thread could not be started
+     */
+    bool Open(const wxFileName& tagsDb);
+
+    /**
+     * @brief free the index
+     */
+    void Close();
+
+    /**
+     * @brief return true if the index was opened (it may still be loading)
+     */
+    bool IsOpen();
+
+    /**
+     * @brief add tags stored into 'tagsDb'. Ignored if the index was not loaded from 'tagsDb'
+     */
+    void AddSymbols(const wxFileName& tagsDb, const std::vector<Symbol>& symbols);
+
+    /**
+     * @brief remove the tags of 'file'
+     */
+    void RemoveFile(const wxFileName& tagsDb, const wxString& file);
+
+    /**
+     * @brief remove the tags of all the files starting with 'prefix'
+     */
+    void RemoveFilesByPrefix(const wxFileName& tagsDb, const wxString& prefix);
+
+    /**
+     * @brief remove all tags (the database was recreated)
+     */
+    void Clear(const wxFileName& tagsDb);
+
+    /**
+     * @brief find the IDs of the tags matching 'query'
+     * @return false if the index is not loaded for 'tagsDb' (the caller should query the database)
+     */
+    bool Find(const wxFileName& tagsDb, const Query& query, std::vector<wxInt64>& ids);
+};
+
+#endif // CLSYMBOLINDEX_H
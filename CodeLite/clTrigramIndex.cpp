@@ -0,0 +1,319 @@
+#include "clTrigramIndex.h"
+#include "clMappedFile.h"
+#include "file_logger.h"
+#include "fileutils.h"
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/stopwatch.h>
+#include <algorithm>
+#include <string.h>
+
+#define TRIGRAM_INDEX_MAGIC "CLTRIGRAMS"
+#define TRIGRAM_INDEX_MAGIC_LEN 10
+#define TRIGRAM_INDEX_VERSION 2
+
+// Files larger than this are not indexed (and are always searched)
+#define TRIGRAM_MAX_FILE_SIZE (16 * 1024 * 1024)
+
+// The signature size is 4 bits per distinct trigram, rounded up to a power of 2
+#define TRIGRAM_BITS_PER_TRIGRAM 4
+#define TRIGRAM_MIN_BITS 64
+#define TRIGRAM_MAX_BITS (64 * 1024)
+
+// A file modified within this delay after it was indexed may keep the same time stamp on
+// file systems with a coarse resolution (2 seconds on FAT)
+#define TRIGRAM_RACY_WINDOW_NS ((wxInt64)2 * 1000 * 1000 * 1000)
+
+static inline wxUint32 FoldTrigramByte(unsigned char ch) { return (ch >= 'A' && ch <= 'Z') ? (ch + ('a' - 'A')) : ch; }
+
+static inline bool IsLineBreak(unsigned char ch) { return ch == '\n' || ch == '\r'; }
+
+static inline wxInt64 NowNs() { return wxGetUTCTimeMillis().GetValue() * 1000 * 1000; }
+
+static inline size_t TrigramBit(wxUint32 trigram, size_t bits)
+{
+    wxUint32 h = trigram * 0x9E3779B1u;
+    h ^= (h >> 15);
+    return h & (bits - 1);
+}
+
+clTrigramIndex::clTrigramIndex()
+    : m_dirty(false)
+{
+}
+
+clTrigramIndex::~clTrigramIndex() {}
+
+clTrigramIndex& clTrigramIndex::Get()
+{
+    static clTrigramIndex theIndex;
+    return theIndex;
+}
+
+bool clTrigramIndex::FileEntry::IsCurrent(wxInt64 fileModified, wxInt64 fileSize) const
+{
+    return modified == fileModified && size == fileSize && (indexed - modified) > TRIGRAM_RACY_WINDOW_NS;
+}
+
+bool clTrigramIndex::GetFileStat(const wxString& filename, wxInt64& modified, wxInt64& size)
+{
+    return FileUtils::GetFileStat(filename, modified, size);
+}
+
+bool clTrigramIndex::DoIndexFile(const wxString& filename, FileEntry& entry)
+{
+    entry.indexed = NowNs();
+    if(!GetFileStat(filename, entry.modified, entry.size)) return false;
+    if(entry.size > TRIGRAM_MAX_FILE_SIZE) return false;
+
+    clMappedFile mappedFile;
+    if(!mappedFile.Open(filename)) return false;
+
+    // Collect the distinct trigrams. Matches never span lines so trigrams
+    // containing a line break are not needed
+    std::vector<wxUint32> trigrams;
+    const unsigned char* p = (const unsigned char*)mappedFile.GetData();
+    const size_t len = mappedFile.GetSize();
+    trigrams.reserve(len);
+    for(size_t i = 2; i < len; ++i) {
+        if(IsLineBreak(p[i]) || IsLineBreak(p[i - 1]) || IsLineBreak(p[i - 2])) continue;
+        trigrams.push_back((FoldTrigramByte(p[i - 2]) << 16) | (FoldTrigramByte(p[i - 1]) << 8) |
+                           FoldTrigramByte(p[i]));
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+    size_t bits = TRIGRAM_MIN_BITS;
+    while(bits < trigrams.size() * TRIGRAM_BITS_PER_TRIGRAM && bits < TRIGRAM_MAX_BITS) {
+        bits <<= 1;
+    }
+
+    entry.signature.assign(bits / 64, 0);
+    for(size_t i = 0; i < trigrams.size(); ++i) {
+        size_t bit = TrigramBit(trigrams[i], bits);
+        entry.signature[bit / 64] |= ((wxUint64)1 << (bit % 64));
+    }
+
+    // Don't keep a signature of a file that was modified while it was read
+    wxInt64 modified, size;
+    return GetFileStat(filename, modified, size) && modified == entry.modified && size == entry.size;
+}
+
+void clTrigramIndex::Open(const wxFileName& tagsDb)
+{
+    Close();
+
+    wxCriticalSectionLocker locker(m_cs);
+    m_filename = wxFileName(tagsDb.GetPath(), tagsDb.GetName() + ".trigrams");
+    if(!DoLoad()) {
+        m_files.clear();
+    }
+    m_dirty = false;
+    CL_DEBUG("Find in files index: %s loaded with %d files", m_filename.GetFullPath(), (int)m_files.size());
+}
+
+bool clTrigramIndex::DoLoad()
+{
+    m_files.clear();
+    if(!m_filename.FileExists()) return true;
+
+    wxFFile fp(m_filename.GetFullPath(), "rb");
+    if(!fp.IsOpened()) return false;
+
+    char magic[TRIGRAM_INDEX_MAGIC_LEN];
+    wxUint32 version = 0, count = 0;
+    if(fp.Read(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, TRIGRAM_INDEX_MAGIC, sizeof(magic)) != 0) {
+        return false;
+    }
+    if(fp.Read(&version, sizeof(version)) != sizeof(version) || version != TRIGRAM_INDEX_VERSION) return false;
+    if(fp.Read(&count, sizeof(count)) != sizeof(count)) return false;
+
+    std::vector<char> path;
+    for(wxUint32 i = 0; i < count; ++i) {
+        wxUint32 pathLen = 0, words = 0;
+        FileEntry entry;
+        if(fp.Read(&pathLen, sizeof(pathLen)) != sizeof(pathLen)) return false;
+        path.resize(pathLen);
+        if(pathLen && fp.Read(&path[0], pathLen) != pathLen) return false;
+        if(fp.Read(&entry.modified, sizeof(entry.modified)) != sizeof(entry.modified)) return false;
+        if(fp.Read(&entry.size, sizeof(entry.size)) != sizeof(entry.size)) return false;
+        if(fp.Read(&entry.indexed, sizeof(entry.indexed)) != sizeof(entry.indexed)) return false;
+        if(fp.Read(&words, sizeof(words)) != sizeof(words)) return false;
+        if(words == 0 || words > (TRIGRAM_MAX_BITS / 64)) return false;
+
+        entry.signature.resize(words);
+        if(fp.Read(&entry.signature[0], words * sizeof(wxUint64)) != words * sizeof(wxUint64)) return false;
+        std::swap(m_files[wxString::FromUTF8(pathLen ? &path[0] : "", pathLen)], entry);
+    }
+    return true;
+}
+
+void clTrigramIndex::Save()
+{
+    wxCriticalSectionLocker locker(m_cs);
+    if(!m_dirty || !m_filename.IsOk()) return;
+
+    // Write to a temporary file and replace the index when done
+    wxString tmpfile = m_filename.GetFullPath() + ".tmp";
+    {
+        wxFFile fp(tmpfile, "wb");
+        if(!fp.IsOpened()) return;
+
+        wxUint32 version = TRIGRAM_INDEX_VERSION;
+        wxUint32 count = m_files.size();
+        fp.Write(TRIGRAM_INDEX_MAGIC, TRIGRAM_INDEX_MAGIC_LEN);
+        fp.Write(&version, sizeof(version));
+        fp.Write(&count, sizeof(count));
+
+        std::map<wxString, FileEntry>::const_iterator iter = m_files.begin();
+        for(; iter != m_files.end(); ++iter) {
+            const wxCharBuffer path = iter->first.mb_str(wxConvUTF8);
+            wxUint32 pathLen = path.length();
+            wxUint32 words = iter->second.signature.size();
+            fp.Write(&pathLen, sizeof(pathLen));
+            fp.Write(path.data(), pathLen);
+            fp.Write(&iter->second.modified, sizeof(iter->second.modified));
+            fp.Write(&iter->second.size, sizeof(iter->second.size));
+            fp.Write(&iter->second.indexed, sizeof(iter->second.indexed));
+            fp.Write(&words, sizeof(words));
+            fp.Write(&iter->second.signature[0], words * sizeof(wxUint64));
+        }
+
+        if(fp.Error()) {
+            fp.Close();
+            ::wxRemoveFile(tmpfile);
+            return;
+        }
+    }
+
+    if(::wxRenameFile(tmpfile, m_filename.GetFullPath(), true)) {
+        m_dirty = false;
+    }
+}
+
+void clTrigramIndex::Close()
+{
+    Save();
+    wxCriticalSectionLocker locker(m_cs);
+    m_files.clear();
+    m_filename.Clear();
+    m_dirty = false;
+}
+
+bool clTrigramIndex::IsOpen()
+{
+    wxCriticalSectionLocker locker(m_cs);
+    return m_filename.IsOk();
+}
+
+void clTrigramIndex::UpdateFiles(const wxArrayString& files)
+{
+    if(!IsOpen()) return;
+
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        wxInt64 modified, size;
+        if(GetFileStat(files.Item(i), modified, size)) {
+            wxCriticalSectionLocker locker(m_cs);
+            std::map<wxString, FileEntry>::const_iterator iter = m_files.find(files.Item(i));
+            if(iter != m_files.end() && iter->second.IsCurrent(modified, size)) {
+                // already up to date
+                continue;
+            }
+        }
+
+        // Index the file without holding the lock
+        FileEntry entry;
+        bool indexed = DoIndexFile(files.Item(i), entry);
+
+        wxCriticalSectionLocker locker(m_cs);
+        if(indexed) {
+            std::swap(m_files[files.Item(i)], entry);
+        } else {
+            // an entry that is not in the index is always searched
+            m_files.erase(files.Item(i));
+        }
+        m_dirty = true;
+    }
+}
+
+void clTrigramIndex::RemoveFiles(const wxArrayString& files)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        if(m_files.erase(files.Item(i))) {
+            m_dirty = true;
+        }
+    }
+}
+
+void clTrigramIndex::RenameFile(const wxString& oldName, const wxString& newName)
+{
+    wxCriticalSectionLocker locker(m_cs);
+    std::map<wxString, FileEntry>::iterator iter = m_files.find(oldName);
+    if(iter == m_files.end()) return;
+
+    // Keep the entry of the new file if it was already indexed
+    if(m_files.count(newName) == 0) {
+        // Keep the time stamp of the indexed content: if the move changed it, the file is
+        // searched until it is indexed again
+        std::swap(m_files[newName], iter->second);
+    }
+    m_files.erase(oldName);
+    m_dirty = true;
+}
+
+void clTrigramIndex::FilterFiles(const wxArrayString& literals, bool allowNonAscii, wxArrayString& files)
+{
+    if(!IsOpen()) return;
+
+    // Build the list of trigrams that a matching file must contain
+    std::vector<wxUint32> query;
+    for(size_t i = 0; i < literals.GetCount(); ++i) {
+        const wxCharBuffer cb = literals.Item(i).mb_str(wxConvUTF8);
+        const unsigned char* p = (const unsigned char*)cb.data();
+        const size_t len = cb.length();
+        for(size_t j = 2; j < len; ++j) {
+            if(!allowNonAscii && (p[j] >= 0x80 || p[j - 1] >= 0x80 || p[j - 2] >= 0x80)) continue;
+            if(IsLineBreak(p[j]) || IsLineBreak(p[j - 1]) || IsLineBreak(p[j - 2])) continue;
+            query.push_back((FoldTrigramByte(p[j - 2]) << 16) | (FoldTrigramByte(p[j - 1]) << 8) |
+                            FoldTrigramByte(p[j]));
+        }
+    }
+
+    std::sort(query.begin(), query.end());
+    query.erase(std::unique(query.begin(), query.end()), query.end());
+    if(query.empty()) return;
+
+    wxArrayString candidates;
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        const wxString& filename = files.Item(i);
+        wxInt64 modified, size;
+        if(!GetFileStat(filename, modified, size)) {
+            // let the search report it
+            candidates.Add(filename);
+            continue;
+        }
+
+        wxCriticalSectionLocker locker(m_cs);
+        std::map<wxString, FileEntry>::const_iterator iter = m_files.find(filename);
+        if(iter == m_files.end() || !iter->second.IsCurrent(modified, size)) {
+            // not indexed or (possibly) modified since it was indexed
+            candidates.Add(filename);
+            continue;
+        }
+
+        const std::vector<wxUint64>& signature = iter->second.signature;
+        const size_t bits = signature.size() * 64;
+        bool match = true;
+        for(size_t j = 0; j < query.size() && match; ++j) {
+            size_t bit = TrigramBit(query[j], bits);
+            match = (signature[bit / 64] & ((wxUint64)1 << (bit % 64))) != 0;
+        }
+
+        if(match) {
+            candidates.Add(filename);
+        }
+    }
+    CL_DEBUG("Find in files index: %d candidates out of %d files", (int)candidates.GetCount(), (int)files.GetCount());
+    files.swap(candidates);
+}
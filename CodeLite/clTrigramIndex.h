@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : clTrigramIndex.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CLTRIGRAMINDEX_H
+#define CLTRIGRAMINDEX_H
+
+#include <map>
+#include <vector>
+#include <wx/string.h>
+#include <wx/arrstr.h>
+#include <wx/filename.h>
+#include <wx/thread.h>
+#include "codelite_exports.h"
+
+/**
+ * @class clTrigramIndex
+ * @brief a persistent trigram index of the workspace files used by "Find In Files"
+ * For every file, the index keeps a signature: a bitset of the hashed (ASCII lower cased) trigrams
+ * found in the file. A query keeps the files whose signature contains all the trigrams of the searched
+ * literals. The index may return files that do not contain the literals but never drops a file that does:
+ * files that were not indexed or that can't be shown to be unchanged since they were indexed are always returned
+ */
+class WXDLLIMPEXP_CL clTrigramIndex
+{
+    struct FileEntry {
+        wxInt64 modified; // nanoseconds since the epoch
+        wxInt64 size;
+        wxInt64 indexed; // when the file was read, in the same units as 'modified'
+        std::vector<wxUint64> signature;
+
+        /**
+         * @brief the signature matches the file content if the file still has the same time stamp and size,
+         * unless it was modified so soon after it was read that the file system could not tell the two apart
+         */
+        bool IsCurrent(wxInt64 fileModified, wxInt64 fileSize) const;
+    };
+
+    std::map<wxString, FileEntry> m_files;
+    wxFileName m_filename;
+    bool m_dirty;
+    wxCriticalSection m_cs;
+
+private:
+    clTrigramIndex();
+    virtual ~clTrigramIndex();
+
+    /**
+     * @brief the last modification time (nanoseconds since the epoch) and the size of a file
+     */
+    static bool GetFileStat(const wxString& filename, wxInt64& modified, wxInt64& size);
+    static bool DoIndexFile(const wxString& filename, FileEntry& entry);
+    bool DoLoad();
+
+public:
+    static clTrigramIndex& Get();
+
+    /**
+     * @brief open the index stored next to the tags database 'tagsDb'
+     */
+    void Open(const wxFileName& tagsDb);
+
+    /**
+     * @brief write the index to the disk (if modified) and clear it
+     */
+    void Close();
+
+    /**
+     * @brief write the index to the disk if it was modified
+     */
+    void Save();
+
+    bool IsOpen();
+
+    /**
+     * @brief (re)index the given files. Files that did not change since they were indexed are skipped
+     */
+    void UpdateFiles(const wxArrayString& files);
+
+    /**
+     * @brief remove files from the index
+     */
+    void RemoveFiles(const wxArrayString& files);
+
+    /**
+     * @brief move the entry of 'oldName' to 'newName' (the file was renamed without being modified)
+     */
+    void RenameFile(const wxString& oldName, const wxString& newName);
+
+    /**
+     * @brief remove from 'files' the files that can not contain all of the 'literals'
+     * @param allowNonAscii when false, only trigrams made of ASCII characters are used
+     * (i.e. when the search is not case sensitive)
+     */
+    void FilterFiles(const wxArrayString& literals, bool allowNonAscii, wxArrayString& files);
+};
+
+#endif // CLTRIGRAMINDEX_H
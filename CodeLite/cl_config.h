@@ -75,6 +75,11 @@ public:
 #define kConfigWorkspaceTabSashPosition "WorkspaceTabSashPosition"
 #define kConfigTabsPaneSortAlphabetically "TabsPaneSortAlphabetically"
 #define kConfigFileExplorerBookmarks "FileExplorerBookmarks"
+#define kConfigFindInFilesUseIndex "FindInFilesUseIndex"
+#define kConfigCodeCompletionSymbolIndex "CodeCompletionSymbolIndex"
+#define kConfigCodeCompletionFileIndex "CodeCompletionFileIndex"
+#define kConfigParserThreads "ParserThreads"
+#define kConfigBuildOutputPrefilter "BuildOutputPrefilter"
 
 class WXDLLIMPEXP_CL clConfig
 {
@@ -37,10 +37,12 @@
 #include "ctags_manager.h"
 #include "named_pipe_client.h"
 #include <set>
+#include <map>
 #include "cl_indexer_request.h"
 #include "asyncprocess.h"
 #include "clindexerprotocol.h"
 #include "cl_indexer_reply.h"
+#include "cl_tags_binary.h"
 #include <wx/txtstrm.h>
 #include <wx/file.h>
 #include <algorithm>
@@ -68,6 +70,11 @@
 
 //#define __PERFORMANCE
 #include "performance.h"
+#include "clTrigramIndex.h"
+#include "clSymbolIndex.h"
+#include "clFileNameIndex.h"
+#include "cl_config.h"
+#include "clContentHash.h"
 
 #ifdef __WXMSW__
 #define PIPE_NAME "\\\\.\\pipe\\codelite_indexer_%s"
@@ -75,6 +82,38 @@
 #define PIPE_NAME "/tmp/codelite_indexer.%s.sock"
 #endif
 
+// Upper limit for the number of codelite_indexer instances started by default
+#define MAX_DEFAULT_INDEXERS 8
+
+// How long the parser thread waits for the main thread to start the indexers it requested
+#define INDEXERS_START_TIMEOUT_MS 2000
+
+// The ID of the codelite_indexer instance 'indexer': the main indexer uses our process ID,
+// the other instances use "<pid>_<indexer>" (the indexer still watches our process ID)
+static wxString GetIndexerChannelId(size_t indexer)
+{
+    wxString uid;
+    uid << wxGetProcessId();
+    if(indexer > 0) {
+        uid << wxT("_") << indexer;
+    }
+    return uid;
+}
+
+static void RemoveIndexerChannel(size_t indexer)
+{
+#ifndef __WXMSW__
+    // Clear the socket file
+    char channel_name[1024];
+    memset(channel_name, 0, sizeof(channel_name));
+    sprintf(channel_name, PIPE_NAME, GetIndexerChannelId(indexer).mb_str(wxConvUTF8).data());
+    ::unlink(channel_name);
+    ::remove(channel_name);
+#else
+    wxUnusedVar(indexer);
+#endif
+}
+
 const wxEventType wxEVT_UPDATE_FILETREE_EVENT = XRCID("update_file_tree_event");
 const wxEventType wxEVT_TAGS_DB_UPGRADE = XRCID("tags_db_upgraded");
 const wxEventType wxEVT_TAGS_DB_UPGRADE_INTER = XRCID("tags_db_upgraded_now");
@@ -141,6 +180,7 @@ TagsManager::TagsManager()
     : wxEvtHandler()
     , m_codeliteIndexerPath(wxT("codelite_indexer"))
     , m_codeliteIndexerProcess(NULL)
+    , m_indexersCount(1)
     , m_canRestartIndexer(true)
     , m_lang(NULL)
     , m_evtHandler(NULL)
@@ -163,28 +203,27 @@ TagsManager::TagsManager()
 
 TagsManager::~TagsManager()
 {
+    m_canRestartIndexer = false;
+    for(size_t i = 0; i < m_parallelIndexers.size(); ++i) {
+        if(m_parallelIndexers.at(i)) {
+#ifndef __WXMSW__
+            m_parallelIndexers.at(i)->Terminate();
+#endif
+            wxDELETE(m_parallelIndexers.at(i));
+            RemoveIndexerChannel(i + 1);
+        }
+    }
+    m_parallelIndexers.clear();
+
     if(m_codeliteIndexerProcess) {
 
         // Dont kill the indexer process, just terminate the
         // reader-thread (this is done by deleting the indexer object)
-        m_canRestartIndexer = false;
-
 #ifndef __WXMSW__
         m_codeliteIndexerProcess->Terminate();
 #endif
         delete m_codeliteIndexerProcess;
-
-#ifndef __WXMSW__
-        // Clear the socket file
-        std::stringstream s;
-        s << wxGetProcessId();
-
-        char channel_name[1024];
-        memset(channel_name, 0, sizeof(channel_name));
-        sprintf(channel_name, PIPE_NAME, s.str().c_str());
-        ::unlink(channel_name);
-        ::remove(channel_name);
-#endif
+        RemoveIndexerChannel(0);
     }
 }
 
@@ -214,6 +253,27 @@ void TagsManager::OpenDatabase(const wxFileName& fileName)
         }
     }
 
+    // The "Find In Files" index is kept next to the tags database
+    if(clConfig::Get().Read(kConfigFindInFilesUseIndex, false)) {
+        clTrigramIndex::Get().Open(fileName);
+    } else {
+        clTrigramIndex::Get().Close();
+    }
+
+    // Name lookups are answered from memory when the symbol index is loaded
+    if(clConfig::Get().Read(kConfigCodeCompletionSymbolIndex, true)) {
+        clSymbolIndex::Get().Open(fileName);
+    } else {
+        clSymbolIndex::Get().Close();
+    }
+
+    // File name lookups ("Open Resource", #include completion) are answered from memory
+    if(clConfig::Get().Read(kConfigCodeCompletionFileIndex, true)) {
+        clFileNameIndex::Get().Open(fileName);
+    } else {
+        clFileNameIndex::Get().Close();
+    }
+
     if(retagIsRequired && m_evtHandler) {
         wxCommandEvent e(wxEVT_COMMAND_MENU_SELECTED, XRCID("retag_workspace"));
         m_evtHandler->AddPendingEvent(e);
@@ -222,7 +282,7 @@ void TagsManager::OpenDatabase(const wxFileName& fileName)
 
 TagTreePtr TagsManager::ParseSourceFile(const wxFileName& fp, std::vector<CommentPtr>* comments)
 {
-    wxString tags;
+    TagEntryPtrVector_t tags;
 
     if(!m_codeliteIndexerProcess) {
         return TagTreePtr(NULL);
@@ -293,24 +353,73 @@ void TagsManager::StartCodeLiteIndexer()
 {
     if(!m_canRestartIndexer) return;
 
-    // Run ctags process
-    wxString cmd;
-    wxString ctagsCmd;
-
-    // build the command, we surround ctags name with double quatations
-    wxString uid;
-    uid << wxGetProcessId();
-
     if(m_codeliteIndexerPath.FileExists() == false) {
         CL_ERROR(wxT("ERROR: Could not locate indexer: %s"), m_codeliteIndexerPath.GetFullPath().c_str());
         m_codeliteIndexerProcess = NULL;
         return;
     }
 
-    // concatenate the PID to identifies this channel to this instance of codelite
-    cmd << wxT("\"") << m_codeliteIndexerPath.GetFullPath() << wxT("\" ") << uid << wxT(" --pid");
-    m_codeliteIndexerProcess =
-        CreateAsyncProcess(this, cmd, IProcessCreateDefault, clStandardPaths::Get().GetUserDataDir());
+    m_codeliteIndexerProcess = DoStartIndexer(0);
+}
+
+IProcess* TagsManager::DoStartIndexer(size_t indexer)
+{
+    // Run ctags process
+    // build the command, we surround ctags name with double quatations
+    // concatenate the channel ID to identifies this channel to this instance of codelite
+    wxString cmd;
+    cmd << wxT("\"") << m_codeliteIndexerPath.GetFullPath() << wxT("\" ") << GetIndexerChannelId(indexer)
+        << wxT(" --pid");
+    return CreateAsyncProcess(this, cmd, IProcessCreateDefault, clStandardPaths::Get().GetUserDataDir());
+}
+
+void TagsManager::StartParallelIndexers(size_t count)
+{
+    // ctags is not thread safe: every parser worker thread is served by its own indexer.
+    // 0 means one indexer per CPU
+    int maxCount = clConfig::Get().Read(kConfigParserThreads, 0);
+    if(maxCount <= 0) {
+        maxCount = wxMin(wxThread::GetCPUCount(), MAX_DEFAULT_INDEXERS);
+    }
+    count = wxMin(count, (size_t)wxMax(maxCount, 1));
+
+    if(m_canRestartIndexer && m_codeliteIndexerProcess && m_parallelIndexers.size() < count - 1) {
+        m_parallelIndexers.resize(count - 1, NULL);
+        for(size_t i = 0; i < m_parallelIndexers.size(); ++i) {
+            if(!m_parallelIndexers.at(i)) {
+                m_parallelIndexers.at(i) = DoStartIndexer(i + 1);
+            }
+        }
+    }
+
+    {
+        wxCriticalSectionLocker locker(m_indexersLocker);
+        m_indexersCount = m_parallelIndexers.size() + 1;
+    }
+    m_indexersStarted.Post();
+}
+
+size_t TagsManager::RequestIndexers(size_t count)
+{
+    if(count <= GetIndexersCount()) {
+        return count;
+    }
+
+    if(wxThread::IsMain()) {
+        StartParallelIndexers(count);
+    } else {
+        // The indexers are child processes of the main thread: ask it to start them
+        // and wait for it. Don't wait forever, the main thread might be waiting for us
+        CallAfter(&TagsManager::StartParallelIndexers, count);
+        m_indexersStarted.WaitTimeout(INDEXERS_START_TIMEOUT_MS);
+    }
+    return wxMin(count, GetIndexersCount());
+}
+
+size_t TagsManager::GetIndexersCount()
+{
+    wxCriticalSectionLocker locker(m_indexersLocker);
+    return m_indexersCount;
 }
 
 void TagsManager::RestartCodeLiteIndexer()
@@ -327,7 +436,17 @@ void TagsManager::SetCodeLiteIndexerPath(const wxString& path) { m_codeliteIndex
 
 void TagsManager::OnIndexerTerminated(clProcessEvent& event)
 {
-    wxUnusedVar(event);
+    // One of the parser workers indexers?
+    for(size_t i = 0; i < m_parallelIndexers.size(); ++i) {
+        if(event.GetProcess() && m_parallelIndexers.at(i) == event.GetProcess()) {
+            wxDELETE(m_parallelIndexers.at(i));
+            if(m_canRestartIndexer) {
+                m_parallelIndexers.at(i) = DoStartIndexer(i + 1);
+            }
+            return;
+        }
+    }
+
     wxDELETE(m_codeliteIndexerProcess);
     StartCodeLiteIndexer();
 }
@@ -335,21 +454,24 @@ void TagsManager::OnIndexerTerminated(clProcessEvent& event)
 //---------------------------------------------------------------------
 // Parsing
 //---------------------------------------------------------------------
-void TagsManager::SourceToTags(const wxFileName& source, wxString& tags)
+void TagsManager::SourceToTags(const wxFileName& source, TagEntryPtrVector_t& tags) { SourceToTags(source, tags, 0); }
+
+void TagsManager::SourceToTags(const wxFileName& source, TagEntryPtrVector_t& tags, size_t indexer)
 {
-    std::stringstream s;
-    s << wxGetProcessId();
+    if(indexer >= GetIndexersCount()) {
+        indexer = 0;
+    }
 
     char channel_name[1024];
     memset(channel_name, 0, sizeof(channel_name));
-    sprintf(channel_name, PIPE_NAME, s.str().c_str());
+    sprintf(channel_name, PIPE_NAME, GetIndexerChannelId(indexer).mb_str(wxConvUTF8).data());
 
     clNamedPipeClient client(channel_name);
 
     // Build a request for the indexer
     clIndexerRequest req;
     // set the command
-    req.setCmd(clIndexerRequest::CLI_PARSE);
+    req.setCmd(clIndexerRequest::CLI_PARSE_BINARY);
 
     // prepare list of files to be parsed
     std::vector<std::string> files;
@@ -364,6 +486,11 @@ void TagsManager::SourceToTags(const wxFileName& source, wxString& tags)
 
     // connect to the indexer
     if(!client.connect()) {
+        if(indexer != 0) {
+            // this indexer is being restarted, use the main one
+            SourceToTags(source, tags, 0);
+            return;
+        }
         wxPrintf(wxT("Failed to connect to indexer ID %d!\n"), (int)wxGetProcessId());
         return;
     }
@@ -378,31 +505,113 @@ void TagsManager::SourceToTags(const wxFileName& source, wxString& tags)
     clIndexerReply reply;
     try {
         if(!clIndexerProtocol::ReadReply(&client, reply)) {
-            RestartCodeLiteIndexer();
+            // the parser workers indexers are restarted by the termination handler
+            if(indexer == 0) {
+                RestartCodeLiteIndexer();
+            }
             return;
         }
     } catch(std::bad_alloc& ex) {
-        tags.Clear();
+        tags.clear();
         return;
     }
 
-    // convert the data into wxString
-    if(m_encoding == wxFONTENCODING_DEFAULT || m_encoding == wxFONTENCODING_SYSTEM)
-        tags = wxString(reply.getTags().c_str(), wxConvUTF8);
-    else
-        tags = wxString(reply.getTags().c_str(), wxCSConv(m_encoding));
-    if(tags.empty()) {
-        tags = wxString::From8BitData(reply.getTags().c_str());
+    TagsFromBinary(reply.getTags(), tags);
+}
+
+void TagsManager::TagsFromBinary(const std::string& data, TagEntryPtrVector_t& tags)
+{
+    clTagsBinaryReader reader;
+    if(!reader.Open(data)) {
+        CL_WARNING("Invalid tags reply received from codelite_indexer");
+        return;
     }
 
-    AddEnumClassData(tags);
+    // Convert each string of the reply once, the records only refer to them
+    bool useUTF8 = (m_encoding == wxFONTENCODING_DEFAULT || m_encoding == wxFONTENCODING_SYSTEM);
+    wxCSConv conv(useUTF8 ? wxFONTENCODING_UTF8 : m_encoding);
+    std::vector<wxString> strings(reader.GetStringsCount());
+    for(size_t i = 1; i < strings.size(); ++i) {
+        const char* str = reader.GetString(i);
+        wxString& s = strings.at(i);
+        s = useUTF8 ? wxString(str, wxConvUTF8) : wxString(str, conv);
+        if(s.empty()) {
+            s = wxString::From8BitData(str);
+        }
+        s.Trim().Trim(false);
+    }
+
+    // Add the isInEnumNamespace flag to the enumerators of "enum class ..." (C++11)
+    std::set<wxString> enumClasses;
+    for(size_t i = 0; i < reader.GetRecordsCount(); ++i) {
+        const clTagsBinaryRecord& record = reader.GetRecord(i);
+        if(strings.at(record.fields[kTagKind]) != TagEntry::KIND_ENUM) continue;
+
+        const wxString& pattern = strings.at(record.fields[kTagPattern]);
+        if(!pattern.Contains(wxT("enum class")) && !pattern.Contains(wxT("enum struct"))) continue;
+
+        const wxString& scope = strings.at(record.fields[kTagScopeName]);
+        const wxString& name = strings.at(record.fields[kTagName]);
+        enumClasses.insert(scope.IsEmpty() ? name : scope + wxT("::") + name);
+    }
+
+    static const struct {
+        eTagsBinaryField field;
+        const wxChar* key;
+    } optionalFields[] = {
+        { kTagLanguage, wxT("language") },
+        { kTagInherits, wxT("inherits") },
+        { kTagAccess, wxT("access") },
+        { kTagImplementation, wxT("implementation") },
+        { kTagSignature, wxT("signature") },
+        { kTagReturns, wxT("returns") },
+    };
+
+    tags.reserve(tags.size() + reader.GetRecordsCount());
+    for(size_t i = 0; i < reader.GetRecordsCount(); ++i) {
+        const clTagsBinaryRecord& record = reader.GetRecord(i);
+        const wxString& pattern = strings.at(record.fields[kTagPattern]);
+        const wxString& kind = strings.at(record.fields[kTagKind]);
+
+        long lineNumber = wxNOT_FOUND;
+        if(record.line != -1) {
+            lineNumber = record.line;
+        } else if(!pattern.StartsWith(wxT("/^"))) {
+            // line number pattern (e.g. macros)
+            pattern.ToLong(&lineNumber);
+        }
+
+        std::map<wxString, wxString> extFields;
+        const wxString& scopeKind = strings.at(record.fields[kTagScopeKind]);
+        if(!scopeKind.IsEmpty()) {
+            extFields[scopeKind] = strings.at(record.fields[kTagScopeName]);
+            if(scopeKind == TagEntry::KIND_ENUM && enumClasses.count(extFields[scopeKind])) {
+                extFields[wxT("isInEnumNamespace")] = wxT("1");
+            }
+        }
+        if(record.fields[kTagTypeRefKind]) {
+            extFields[wxT("typeref")] =
+                strings.at(record.fields[kTagTypeRefKind]) + wxT(":") + strings.at(record.fields[kTagTypeRefName]);
+        }
+        if(record.flags & kTagFileScope) {
+            extFields[wxT("file")] = wxEmptyString;
+        }
+
+        for(size_t n = 0; n < sizeof(optionalFields) / sizeof(optionalFields[0]); ++n) {
+            if(record.fields[optionalFields[n].field]) {
+                extFields[optionalFields[n].key] = strings.at(record.fields[optionalFields[n].field]);
+            }
+        }
 
-#if 0
-    wxFFile fff(clStandardPaths::Get().GetUserDataDir() + wxT("\\tmp_tags"), wxT("w+"));
-    if(fff.IsOpened()) {
-        fff.Write(tags);
+        TagEntryPtr tag(new TagEntry());
+        tag->FromFields(strings.at(record.fields[kTagFile]),
+                        strings.at(record.fields[kTagName]),
+                        lineNumber,
+                        pattern,
+                        kind,
+                        extFields);
+        tags.push_back(tag);
     }
-#endif
 }
 
 TagTreePtr TagsManager::TreeFromTags(const wxString& tags, int& count)
@@ -433,6 +642,21 @@ TagTreePtr TagsManager::TreeFromTags(const wxString& tags, int& count)
     return tree;
 }
 
+TagTreePtr TagsManager::TreeFromTags(const TagEntryPtrVector_t& tags, int& count)
+{
+    TagEntry root;
+    root.SetName(wxT("<ROOT>"));
+
+    TagTreePtr tree(new TagTree(wxT("<ROOT>"), root));
+    for(size_t i = 0; i < tags.size(); ++i) {
+        // Add the tag to the tree, locals are not added to the
+        // tree
+        count++;
+        if(tags.at(i)->GetKind() != wxT("local")) tree->AddEntry(*tags.at(i));
+    }
+    return tree;
+}
+
 bool TagsManager::IsValidCtagsFile(const wxFileName& filename) const { return FileExtManager::IsCxxFile(filename); }
 
 //-----------------------------------------------------------------------------
@@ -1292,23 +1516,20 @@ void TagsManager::RetagFiles(const std::vector<wxFileName>& files, RetagType typ
         return;
     }
 
-    // step 2: remove all files which do not need retag
-    if(type == Retag_Quick || type == Retag_Quick_No_Scan) DoFilterNonNeededFilesForRetaging(strFiles, GetDatabase());
-
-    // If there are no files to tag - send the 'end' event
-    if(strFiles.IsEmpty()) {
-        wxFrame* frame = dynamic_cast<wxFrame*>(wxTheApp->GetTopWindow());
-        if(frame) {
-            wxCommandEvent retaggingCompletedEvent(wxEVT_PARSE_THREAD_RETAGGING_COMPLETED);
-            frame->GetEventHandler()->AddPendingEvent(retaggingCompletedEvent);
+    // step 2: the "Find In Files" index covers all the files, including
+    // the ones that are not going to be re-parsed
+    if(clTrigramIndex::Get().IsOpen()) {
+        ParseRequest* indexReq = new ParseRequest(NULL);
+        indexReq->setType(ParseRequest::PR_UPDATE_FIND_IN_FILES_INDEX);
+        indexReq->_workspaceFiles.reserve(strFiles.size());
+        for(size_t i = 0; i < strFiles.GetCount(); i++) {
+            indexReq->_workspaceFiles.push_back(strFiles[i].mb_str(wxConvUTF8).data());
         }
-        return;
+        ParseThreadST::Get()->Add(indexReq);
     }
 
-    // step 4: Remove tags belonging to these files
-    DeleteFilesTags(strFiles);
-
-    // step 5: build the database
+    // step 3: build the database. The parser thread skips the files which do not need
+    // to be parsed again (quick retag) and replaces the tags of the others
     ParseRequest* req = new ParseRequest(ParseThreadST::Get()->GetNotifiedWindow());
     if(cb) {
         req->_evtHandler = cb; // Callback window
@@ -1318,6 +1539,8 @@ void TagsManager::RetagFiles(const std::vector<wxFileName>& files, RetagType typ
 
     req->setType(
         type == Retag_Quick_No_Scan ? ParseRequest::PR_PARSE_FILE_NO_INCLUDES : ParseRequest::PR_PARSE_AND_STORE);
+    // a full retag is stored in bulk load mode (see ParseThread::ProcessParseAndStore)
+    req->_quickRetag = (type != Retag_Full);
     req->_workspaceFiles.clear();
     req->_workspaceFiles.reserve(strFiles.size());
     for(size_t i = 0; i < strFiles.GetCount(); i++) {
@@ -1680,6 +1903,9 @@ void TagsManager::GetFunctionTipFromTags(
 
 void TagsManager::CloseDatabase()
 {
+    clTrigramIndex::Get().Close();
+    clSymbolIndex::Get().Close();
+    clFileNameIndex::Get().Close();
     m_dbFile.Clear();
     m_db = NULL; // Free the current database
     m_db = new TagsStorageSQLite();
@@ -1719,6 +1945,8 @@ void TagsManager::SetCtagsOptions(const TagsOptionsData& options)
     m_tagsOptions = options;
     RestartCodeLiteIndexer();
     m_parseComments = m_tagsOptions.GetFlags() & CC_PARSE_COMMENTS ? true : false;
+    // the ignored tokens and the user types affect the expressions resolution
+    GetLanguage()->ClearCache();
     ITagsStoragePtr db = GetDatabase();
     if(db) {
         db->SetSingleSearchLimit(m_tagsOptions.GetCcNumberOfDisplayItems());
@@ -2407,7 +2635,7 @@ void TagsManager::UpdateFilesRetagTimestamp(const wxArrayString& files, ITagsSto
 {
     db->Begin();
     for(size_t i = 0; i < files.GetCount(); i++) {
-        db->InsertFileEntry(files.Item(i), (int)time(NULL));
+        db->InsertFileEntry(files.Item(i), (int)time(NULL), clContentHash::HashFile(files.Item(i)));
     }
     db->Commit();
 }
@@ -2422,12 +2650,22 @@ void TagsManager::FilterNonNeededFilesForRetaging(wxArrayString& strFiles, ITags
         files_set.insert(strFiles.Item(i));
     }
 
+    // Files that were touched (e.g. by a checkout) but whose content did not change
+    std::vector<FileEntryPtr> unchangedFiles;
+
+    // The database entries which are not in the list, by content hash: a file of the list
+    // which is not in the database may be one of them, renamed or moved
+    std::multimap<wxString, FileEntryPtr> otherFiles;
+    std::set<wxString> newFiles = files_set;
+
     for(size_t i = 0; i < files_entries.size(); i++) {
         FileEntryPtr fe = files_entries.at(i);
 
         // does the file exist in both lists?
         std::set<wxString>::iterator iter = files_set.find(fe->GetFile());
         if(iter != files_set.end()) {
+            newFiles.erase(fe->GetFile());
+
             // get the actual modifiaction time of the file from the disk
             struct stat buff;
             int modified(0);
@@ -2438,10 +2676,60 @@ void TagsManager::FilterNonNeededFilesForRetaging(wxArrayString& strFiles, ITags
             }
 
             // if the timestamp from the database < then the actual timestamp, re-tag the file
+            // unless its content is the one we parsed
             if(fe->GetLastRetaggedTimestamp() >= modified) {
                 files_set.erase(iter);
+
+            } else if(!fe->GetContentHash().IsEmpty() && clContentHash::HashFile(*iter) == fe->GetContentHash()) {
+                unchangedFiles.push_back(fe);
+                files_set.erase(iter);
+            }
+
+        } else if(!fe->GetContentHash().IsEmpty()) {
+            otherFiles.insert(std::make_pair(fe->GetContentHash(), fe));
+        }
+    }
+
+    // A new file with the content of a database entry whose file no longer exists was renamed
+    std::vector<std::pair<FileEntryPtr, wxString> > renamedFiles;
+    if(!otherFiles.empty()) {
+        std::set<wxString>::iterator iter = newFiles.begin();
+        for(; iter != newFiles.end(); ++iter) {
+            wxString contentHash = clContentHash::HashFile(*iter);
+            if(contentHash.IsEmpty()) continue;
+
+            std::pair<std::multimap<wxString, FileEntryPtr>::iterator, std::multimap<wxString, FileEntryPtr>::iterator>
+                range = otherFiles.equal_range(contentHash);
+            for(std::multimap<wxString, FileEntryPtr>::iterator it = range.first; it != range.second; ++it) {
+                if(!wxFileName::FileExists(it->second->GetFile())) {
+                    renamedFiles.push_back(std::make_pair(it->second, *iter));
+                    otherFiles.erase(it);
+                    break;
+                }
+            }
+        }
+    }
+
+    if(!unchangedFiles.empty() || !renamedFiles.empty()) {
+        int now = (int)time(NULL);
+        db->Begin();
+        for(size_t i = 0; i < unchangedFiles.size(); i++) {
+            db->UpdateFileEntry(unchangedFiles.at(i)->GetFile(), now, unchangedFiles.at(i)->GetContentHash());
+        }
+
+        for(size_t i = 0; i < renamedFiles.size(); i++) {
+            const wxString& oldName = renamedFiles.at(i).first->GetFile();
+            const wxString& newName = renamedFiles.at(i).second;
+            if(db->RenameFile(oldName, newName)) {
+                db->UpdateFileEntry(newName, now, renamedFiles.at(i).first->GetContentHash());
+                clTrigramIndex::Get().RenameFile(oldName, newName);
+                files_set.erase(newName);
             }
         }
+        db->Commit();
+        CL_DEBUG("Retagging: skipped %u unmodified files and %u renamed files",
+                 (unsigned int)unchangedFiles.size(),
+                 (unsigned int)renamedFiles.size());
     }
 
     // copy back the files to the array
@@ -2452,11 +2740,6 @@ void TagsManager::FilterNonNeededFilesForRetaging(wxArrayString& strFiles, ITags
     }
 }
 
-void TagsManager::DoFilterNonNeededFilesForRetaging(wxArrayString& strFiles, ITagsStoragePtr db)
-{
-    FilterNonNeededFilesForRetaging(strFiles, db);
-}
-
 wxString TagsManager::GetFunctionReturnValueFromPattern(TagEntryPtr tag)
 {
     // evaluate the return value of the tag
@@ -2750,20 +3033,8 @@ void TagsManager::DoParseModifiedText(const wxString& text, std::vector<TagEntry
     if(fp.IsOpened()) {
         fp.Write(text);
         fp.Close();
-        wxString tagsStr;
-        SourceToTags(wxFileName(fileName), tagsStr);
-
-        // Create tags from the string
-        wxArrayString tagsLines = wxStringTokenize(tagsStr, wxT("\n"), wxTOKEN_STRTOK);
-        for(size_t i = 0; i < tagsLines.GetCount(); i++) {
-            wxString line = tagsLines.Item(i).Trim().Trim(false);
-            if(line.IsEmpty()) continue;
+        SourceToTags(wxFileName(fileName), tags);
 
-            TagEntryPtr tag(new TagEntry());
-            tag->FromLine(line);
-
-            tags.push_back(tag);
-        }
         // Delete the modified file
         wxRemoveFile(fileName);
     }
@@ -2953,46 +3224,6 @@ void TagsManager::DoSortByVisibility(TagEntryPtrVector_t& tags)
     tags.insert(tags.end(), privateTags.begin(), privateTags.end());
 }
 
-void TagsManager::AddEnumClassData(wxString& tags)
-{
-    // Add tisInEnumNamespace flag for enums. For declaration "enum class ..." (C++11)
-    size_t startIndex = tags.find(TagEntry::KIND_ENUM + wxT(" "), 0);
-    while(startIndex != (size_t)wxNOT_FOUND) {
-        size_t patternEndIndex = tags.find(wxT("$/"), startIndex);
-        wxString pattern = tags.substr(startIndex, patternEndIndex - startIndex);
-        if(pattern.Contains(TagEntry::KIND_CLASS)) {
-
-            wxString enumName = pattern.AfterLast(wxT(' '));
-
-            // Get namespace
-            wxString enumNamespace = wxT("");
-            size_t endIndex = tags.find(wxT("\n"), startIndex);
-            wxString line = tags.substr(startIndex, endIndex - startIndex);
-            size_t namespaceStartIndex = line.find(TagEntry::KIND_NAMESPACE, 0);
-            if(namespaceStartIndex != (size_t)wxNOT_FOUND) {
-                size_t namespaceNameStartIndex = line.find(wxT(":"), namespaceStartIndex);
-                if(namespaceNameStartIndex != (size_t)wxNOT_FOUND) {
-                    namespaceNameStartIndex++;
-                    size_t namespaceNameEndIndex = line.find_first_of(wxT("\t\r"), namespaceNameStartIndex);
-                    enumNamespace =
-                        line.substr(namespaceNameStartIndex, namespaceNameEndIndex - namespaceNameStartIndex);
-                }
-            }
-
-            wxString fullName = enumNamespace.IsEmpty() ? enumName : enumNamespace + wxT("::") + enumName;
-            wxString parametersFrom = TagEntry::KIND_ENUM + wxT(":") + fullName + wxT("\r");
-            wxString parametersTo =
-                TagEntry::KIND_ENUM + wxT(":") + fullName + wxT("\tisInEnumNamespace:1") + wxT("\r");
-            size_t lengthBefore = tags.Length();
-            tags.Replace(parametersFrom, parametersTo, true);
-            startIndex += tags.Length() - lengthBefore;
-        }
-
-        startIndex += TagEntry::KIND_ENUM.Length();
-        startIndex = tags.find(TagEntry::KIND_ENUM + wxT(" "), startIndex);
-    }
-}
-
 void TagsManager::GetScopesByScopeName(const wxString& scopeName, wxArrayString& scopes)
 {
     std::vector<wxString> derivationList;
@@ -3158,7 +3389,7 @@ TagEntryPtrVector_t TagsManager::ParseBuffer(const wxString& content)
     fp.Write(content, wxConvUTF8);
     fp.Close();
 
-    wxString tags;
+    TagEntryPtrVector_t tags;
     SourceToTags(filename, tags);
 
     {
@@ -3167,17 +3398,10 @@ TagEntryPtrVector_t TagsManager::ParseBuffer(const wxString& content)
     }
 
     TagEntryPtrVector_t tagsVec;
-    wxArrayString lines = ::wxStringTokenize(tags, "\n", wxTOKEN_STRTOK);
-    for(size_t i = 0; i < lines.GetCount(); ++i) {
-        wxString& line = lines.Item(i);
-        line.Trim().Trim(false);
-        if(line.IsEmpty()) continue;
-
-        TagEntryPtr tag(new TagEntry());
-        tag->FromLine(line);
-
-        if(tag->GetKind() != "local") {
-            tagsVec.push_back(tag);
+    tagsVec.reserve(tags.size());
+    for(size_t i = 0; i < tags.size(); ++i) {
+        if(tags.at(i)->GetKind() != "local") {
+            tagsVec.push_back(tags.at(i));
         }
     }
     return tagsVec;
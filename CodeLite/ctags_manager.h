@@ -43,6 +43,7 @@
 #include "extdbdata.h"
 #include "language.h"
 #include <set>
+#include <string>
 #include "istorage.h"
 #include "codelite_exports.h"
 #include "cl_command_event.h"
@@ -144,6 +145,10 @@ public:
 private:
     wxFileName m_codeliteIndexerPath;
     IProcess* m_codeliteIndexerProcess;
+    std::vector<IProcess*> m_parallelIndexers; // indexer 'i' is at m_parallelIndexers[i - 1]
+    size_t m_indexersCount;
+    wxCriticalSection m_indexersLocker;
+    wxSemaphore m_indexersStarted;
     wxString m_ctagsCmd;
     wxStopWatch m_watch;
     TagsOptionsData m_tagsOptions;
@@ -256,6 +261,12 @@ public:
      * @brief parse source file (from memory) and return list of tags
      */
     TagEntryPtrVector_t ParseBuffer(const wxString &content);
+
+    /**
+     * @brief convert a binary tags reply of codelite_indexer (see cl_tags_binary.h) into tags
+     * and append them to 'tags'. An invalid reply adds nothing
+     */
+    void TagsFromBinary(const std::string& data, TagEntryPtrVector_t& tags);
     
     /**
      * load all symbols of fileName from the database and return them
@@ -295,6 +306,19 @@ public:
      */
     void RestartCodeLiteIndexer();
 
+    /**
+     * @brief return the number of codelite_indexer instances available for parsing.
+     * Since ctags is not thread safe, each parser worker thread uses its own indexer
+     */
+    size_t GetIndexersCount();
+
+    /**
+     * @brief make up to 'count' codelite_indexer instances available for parsing, starting
+     * the missing ones. Can be called from the parser thread.
+     * @return the number of indexers available, never more than 'count'
+     */
+    size_t RequestIndexers(size_t count);
+
     /**
      * Test if filename matches the current ctags file spec.
      * @param filename file name to test
@@ -552,11 +576,17 @@ public:
     wxString GetScopeName(const wxString& scope);
 
     /**
-     * Pass a source file to ctags process, wait for it to process it and return the output.
+     * Pass a source file to ctags process, wait for it to process it and return the tags found.
      * @param source Source file name
-     * @param tags String containing the ctags output
+     * @param tags [output] the tags of the file are appended to this vector
      */
-    void SourceToTags(const wxFileName& source, wxString& tags);
+    void SourceToTags(const wxFileName& source, TagEntryPtrVector_t& tags);
+
+    /**
+     * @brief same as above, using the codelite_indexer instance 'indexer' (0 is the main indexer).
+     * Falls back to the main indexer if 'indexer' is not available
+     */
+    void SourceToTags(const wxFileName& source, TagEntryPtrVector_t& tags, size_t indexer);
 
     /**
      * return list of files from the database(s). The returned list is ordered
@@ -809,7 +839,9 @@ public:
      */
     wxString GetFunctionReturnValueFromPattern(TagEntryPtr tag);
     /**
-     * @brief fileter a recently tagged files from the strFiles array
+     * @brief fileter a recently tagged files from the strFiles array.
+     * Files that were renamed or touched without being modified are updated in the database.
+     * Called from the parser thread
      * @param strFiles
      * @param db
      */
@@ -823,6 +855,11 @@ public:
      */
     TagTreePtr TreeFromTags(const wxString& tags, int& count);
 
+    /**
+     * @brief build a TagTree from tags returned by SourceToTags
+     */
+    TagTreePtr TreeFromTags(const TagEntryPtrVector_t& tags, int& count);
+
     /**
      * @brief clear the underlying caching mechanism
      */
@@ -878,6 +915,17 @@ protected:
      */
     void OnIndexerTerminated(clProcessEvent& event);
 
+    /**
+     * Start the extra codelite_indexer processes used by the parser thread workers
+     * so there are 'count' indexers in total (limited by the parser threads setting)
+     */
+    void StartParallelIndexers(size_t count);
+
+    /**
+     * Start the codelite_indexer process number 'indexer'
+     */
+    IProcess* DoStartIndexer(size_t indexer);
+
 private:
     /**
      * Construct a TagsManager object, for internal use
@@ -952,7 +1000,6 @@ protected:
     void FilterImplementation(const std::vector<TagEntryPtr>& src, std::vector<TagEntryPtr>& tags);
     void FilterDeclarations(const std::vector<TagEntryPtr>& src, std::vector<TagEntryPtr>& tags);
     wxString DoReplaceMacros(wxString name);
-    void DoFilterNonNeededFilesForRetaging(wxArrayString& strFiles, ITagsStoragePtr db);
     void DoGetFunctionTipForEmptyExpression(const wxString& word,
                                             const wxString& text,
                                             std::vector<TagEntryPtr>& tips,
@@ -966,7 +1013,6 @@ protected:
     wxArrayString BreakToOuterScopes(const wxString& scope);
     wxString DoReplaceMacrosFromDatabase(const wxString& name);
     void DoSortByVisibility(TagEntryPtrVector_t& tags);
-    void AddEnumClassData(wxString& tags);
     void GetScopesByScopeName(const wxString& scopeName, wxArrayString& scopes);
 };
 
@@ -519,27 +519,6 @@ void TagEntry::FromLine(const wxString& line)
             if(key == wxT("line") && !val.IsEmpty()) {
                 val.ToLong(&lineNumber);
             } else {
-                if(key == wxT("union") || key == wxT("struct")) {
-
-                    // remove the anonymous part of the struct / union
-                    if(!val.StartsWith(wxT("__anon"))) {
-                        // an internal anonymous union / struct
-                        // remove all parts of the
-                        wxArrayString scopeArr;
-                        wxString tmp, new_val;
-
-                        scopeArr = wxStringTokenize(val, wxT(":"), wxTOKEN_STRTOK);
-                        for(size_t i = 0; i < scopeArr.GetCount(); i++) {
-                            if(scopeArr.Item(i).StartsWith(wxT("__anon")) == false) {
-                                tmp << scopeArr.Item(i) << wxT("::");
-                            }
-                        }
-
-                        tmp.EndsWith(wxT("::"), &new_val);
-                        val = new_val;
-                    }
-                }
-
                 extFields[key] = val;
             }
         }
@@ -550,6 +529,38 @@ void TagEntry::FromLine(const wxString& line)
     fileName = fileName.Trim();
     pattern = pattern.Trim();
 
+    FromFields(fileName, name, lineNumber, pattern, kind, extFields);
+}
+
+void TagEntry::FromFields(const wxString& fileName,
+                          const wxString& name,
+                          int lineNumber,
+                          const wxString& pattern,
+                          const wxString& kind,
+                          std::map<wxString, wxString>& extFields)
+{
+    // remove the anonymous part of the struct / union
+    static const wxString anonScopes[] = { wxT("union"), wxT("struct") };
+    for(size_t n = 0; n < sizeof(anonScopes) / sizeof(anonScopes[0]); ++n) {
+        std::map<wxString, wxString>::iterator iter = extFields.find(anonScopes[n]);
+        if(iter == extFields.end() || iter->second.StartsWith(wxT("__anon"))) continue;
+
+        // an internal anonymous union / struct
+        // remove all parts of the
+        wxArrayString scopeArr;
+        wxString tmp, new_val;
+
+        scopeArr = wxStringTokenize(iter->second, wxT(":"), wxTOKEN_STRTOK);
+        for(size_t i = 0; i < scopeArr.GetCount(); i++) {
+            if(scopeArr.Item(i).StartsWith(wxT("__anon")) == false) {
+                tmp << scopeArr.Item(i) << wxT("::");
+            }
+        }
+
+        tmp.EndsWith(wxT("::"), &new_val);
+        iter->second = new_val;
+    }
+
     if(kind == wxT("enumerator")) {
         // enums are specials, they are a scope, when they declared as "enum class ..." (C++11),
         // but not a scope when declared as "enum ...". So, for "enum class ..." declaration
@@ -127,6 +127,17 @@ public:
 
     void FromLine(const wxString& line);
 
+    /**
+     * @brief construct the tag from the fields of a ctags entry, already split (e.g. as received
+     * from the indexer in the binary format). The fields are normalized the same way FromLine does
+     */
+    void FromFields(const wxString& fileName,
+                    const wxString& name,
+                    int lineNumber,
+                    const wxString& pattern,
+                    const wxString& kind,
+                    std::map<wxString, wxString>& extFields);
+
     /**
      * Copy constructor.
      */
@@ -33,6 +33,7 @@ class FileEntry
 	long      m_id;
 	wxString  m_file;
 	int       m_lastRetaggedTimestamp;
+	wxString  m_contentHash;
 
 public:
 	FileEntry();
@@ -51,6 +52,12 @@ public:
 	const int& GetLastRetaggedTimestamp() const {
 		return m_lastRetaggedTimestamp;
 	}
+	void SetContentHash(const wxString& contentHash) {
+		this->m_contentHash = contentHash;
+	}
+	const wxString& GetContentHash() const {
+		return m_contentHash;
+	}
 	void SetId(const long& id) {
 		this->m_id = id;
 	}
@@ -385,3 +385,25 @@ bool FileUtils::WildMatch(const wxArrayString& masks, const wxString& filename)
     }
     return false;
 }
+
+bool FileUtils::GetFileStat(const wxString& path, wxInt64& modified, wxInt64& size)
+{
+#ifdef __WXMSW__
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if(!::GetFileAttributesExW(path.wc_str(), GetFileExInfoStandard, &data)) return false;
+    // FILETIME is in 100 nanoseconds units since 1601-01-01
+    wxInt64 ft = ((wxInt64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+    modified = (ft - wxLL(116444736000000000)) * 100;
+    size = ((wxInt64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+#else
+    wxStructStat st;
+    if(wxStat(path, &st) != 0) return false;
+#ifdef __WXMAC__
+    modified = (wxInt64)st.st_mtimespec.tv_sec * 1000 * 1000 * 1000 + st.st_mtimespec.tv_nsec;
+#else
+    modified = (wxInt64)st.st_mtim.tv_sec * 1000 * 1000 * 1000 + st.st_mtim.tv_nsec;
+#endif
+    size = (wxInt64)st.st_size;
+#endif
+    return true;
+}
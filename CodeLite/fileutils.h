@@ -131,5 +131,10 @@ public:
      * @brief is the file or folder a hidden file?
      */
     static bool IsHidden(const wxString& path);
+
+    /**
+     * @brief the last modification time (in nanoseconds since the epoch) and the size of a file or folder
+     */
+    static bool GetFileStat(const wxString& path, wxInt64& modified, wxInt64& size);
 };
 #endif // FILEUTILS_H
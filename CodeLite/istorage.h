@@ -234,17 +234,27 @@ public:
     /**
      * @brief insert entry by file name
      * @param filename
+     * @param timestamp retag timestamp
+     * @param contentHash the hash of the parsed content (see clContentHash)
      * @return
      */
-    virtual int InsertFileEntry ( const wxString &filename , int timestamp ) = 0;
+    virtual int InsertFileEntry ( const wxString &filename , int timestamp, const wxString& contentHash ) = 0;
 
     /**
      * @brief update file entry using file name as key
      * @param filename
      * @param timestamp new timestamp
+     * @param contentHash the hash of the parsed content (see clContentHash)
      * @return
      */
-    virtual int UpdateFileEntry ( const wxString &filename , int timestamp ) = 0;
+    virtual int UpdateFileEntry ( const wxString &filename , int timestamp, const wxString& contentHash ) = 0;
+
+    /**
+     * @brief move the tags, the macros and the file entry of 'oldName' to 'newName'
+     * (the file was renamed or moved without being modified)
+     * @return true on success
+     */
+    virtual bool RenameFile ( const wxString &oldName, const wxString &newName ) = 0;
 
     // -------------------------- TagEntry -------------------------------------------
     /**
@@ -363,6 +373,19 @@ public:
     virtual void Commit() = 0;
     virtual void Rollback() = 0;
 
+    /**
+     * @brief prepare the storage for storing a large number of tags (e.g. full retag).
+     * The storage must remain complete and searchable during the load, the caller
+     * is expected to store the tags in large transactions
+     */
+    virtual void BeginBulkLoad() = 0;
+
+    /**
+     * @brief complete a bulk load started with BeginBulkLoad()
+     * @return the number of tags stored during the bulk load
+     */
+    virtual size_t EndBulkLoad() = 0;
+
     /**
      * Delete all entries from database that are related to filename.
      * @param path Database name
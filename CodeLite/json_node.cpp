@@ -25,14 +25,30 @@
 
 #include "json_node.h"
 #include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 #include <wx/filename.h>
 #include <wx/ffile.h>
 #include "clFontHelper.h"
 
+// The chunk size used by JSONArrayReader
+#define JSON_READER_CHUNK_SIZE (64 * 1024)
+
+static cJSON* ParseUTF8(const char* data, size_t len)
+{
+    // cJSON_ParseBuffer takes ownership of the buffer and decodes the strings in place
+    char* buffer = cJSON_AllocBuffer(len + 1);
+    if(!buffer) return NULL;
+    memcpy(buffer, data, len);
+    buffer[len] = 0;
+    return cJSON_ParseBuffer(buffer);
+}
+
 JSONRoot::JSONRoot(const wxString& text)
     : _json(NULL)
 {
-    _json = cJSON_Parse(text.mb_str(wxConvUTF8).data());
+    const wxCharBuffer cb = text.mb_str(wxConvUTF8);
+    _json = ParseUTF8(cb.data(), cb.length());
 }
 
 JSONRoot::JSONRoot(int type)
@@ -47,11 +63,20 @@ JSONRoot::JSONRoot(int type)
 JSONRoot::JSONRoot(const wxFileName& filename)
     : _json(NULL)
 {
-    wxString content;
+    // Parse the raw UTF-8 content, there is no need to convert it to a wxString and back
     wxFFile fp(filename.GetFullPath(), wxT("rb"));
     if(fp.IsOpened()) {
-        if(fp.ReadAll(&content, wxConvUTF8)) {
-            _json = cJSON_Parse(content.mb_str(wxConvUTF8).data());
+        wxFileOffset len = fp.Length();
+        char* buffer = (len >= 0) ? cJSON_AllocBuffer(len + 1) : NULL;
+        if(buffer && fp.Read(buffer, len) == (size_t)len) {
+            buffer[len] = 0;
+            // skip the UTF-8 BOM
+            if(len >= 3 && memcmp(buffer, "\xEF\xBB\xBF", 3) == 0) {
+                memmove(buffer, buffer + 3, len - 2);
+            }
+            _json = cJSON_ParseBuffer(buffer);
+        } else {
+            cJSON_FreeBuffer(buffer);
         }
     }
 
@@ -119,10 +144,10 @@ void JSONRoot::clear()
 JSONElement::JSONElement(cJSON* json)
     : _json(json)
     , _type(-1)
+    , _hasName(json == NULL)
     , _walker(NULL)
 {
     if(_json) {
-        _name = wxString(_json->string, wxConvUTF8);
         _type = _json->type;
     }
 }
@@ -130,12 +155,24 @@ JSONElement::JSONElement(cJSON* json)
 JSONElement::JSONElement(const wxString& name, const wxVariant& val, int type)
     : _json(NULL)
     , _type(type)
+    , _hasName(true)
     , _walker(NULL)
 {
     _value = val;
     _name = name;
 }
 
+const wxString& JSONElement::getName() const
+{
+    if(!_hasName) {
+        if(_json && _json->string) {
+            _name = wxString(_json->string, wxConvUTF8);
+        }
+        _hasName = true;
+    }
+    return _name;
+}
+
 JSONElement JSONElement::arrayItem(int pos) const
 {
     if(!_json) {
@@ -419,8 +456,8 @@ wxArrayString JSONElement::toArrayString(const wxArrayString& defaultValue) cons
     }
 
     wxArrayString arr;
-    for(int i = 0; i < arraySize(); i++) {
-        arr.Add(arrayItem(i).toString());
+    for(cJSON* item = _json->child; item; item = item->next) {
+        arr.Add(JSONElement(item).toString());
     }
     return arr;
 }
@@ -611,3 +648,159 @@ bool JSONElement::isNumber() const
     }
     return _json->type == cJSON_Number;
 }
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+JSONArrayReader::JSONArrayReader(const wxFileName& filename)
+    : m_pos(0)
+    , m_item(NULL)
+    , m_ok(false)
+    , m_scanPos(0)
+    , m_depth(0)
+    , m_inString(false)
+    , m_escape(false)
+{
+    if(!m_fp.Open(filename.GetFullPath(), wxT("rb")) || !ReadMore()) {
+        return;
+    }
+
+    // skip the UTF-8 BOM
+    if(m_buffer.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        m_pos = 3;
+    }
+
+    if(SkipSeparators() && m_buffer[m_pos] == '[') {
+        ++m_pos;
+        m_ok = true;
+    }
+}
+
+JSONArrayReader::~JSONArrayReader()
+{
+    if(m_item) {
+        cJSON_Delete(m_item);
+        m_item = NULL;
+    }
+}
+
+bool JSONArrayReader::ReadMore()
+{
+    if(!m_fp.IsOpened() || m_fp.Eof()) {
+        return false;
+    }
+
+    // drop the bytes already consumed
+    if(m_pos) {
+        m_buffer.erase(0, m_pos);
+        m_scanPos = m_scanPos > m_pos ? m_scanPos - m_pos : 0;
+        m_pos = 0;
+    }
+
+    size_t size = m_buffer.size();
+    m_buffer.resize(size + JSON_READER_CHUNK_SIZE);
+    size_t count = m_fp.Read(&m_buffer[size], JSON_READER_CHUNK_SIZE);
+    m_buffer.resize(size + count);
+    return count > 0;
+}
+
+bool JSONArrayReader::SkipSeparators()
+{
+    while(true) {
+        while(m_pos < m_buffer.size() && (isspace((unsigned char)m_buffer[m_pos]) || m_buffer[m_pos] == ',')) {
+            ++m_pos;
+        }
+        if(m_pos < m_buffer.size()) {
+            return true;
+        }
+        if(!ReadMore()) {
+            return false;
+        }
+    }
+}
+
+bool JSONArrayReader::FindItemEnd(size_t& end)
+{
+    while(true) {
+        for(; m_scanPos < m_buffer.size(); ++m_scanPos) {
+            char ch = m_buffer[m_scanPos];
+            if(m_inString) {
+                if(m_escape) {
+                    m_escape = false;
+                } else if(ch == '\\') {
+                    m_escape = true;
+                } else if(ch == '"') {
+                    m_inString = false;
+                }
+                continue;
+            }
+
+            switch(ch) {
+            case '"':
+                m_inString = true;
+                break;
+            case '{':
+            case '[':
+                ++m_depth;
+                break;
+            case '}':
+            case ']':
+                if(m_depth == 0) {
+                    // a number or a literal, followed by the end of the array
+                    end = m_scanPos;
+                    return true;
+                }
+                if(--m_depth == 0) {
+                    end = m_scanPos + 1;
+                    return true;
+                }
+                break;
+            case ',':
+                if(m_depth == 0) {
+                    end = m_scanPos;
+                    return true;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        if(!ReadMore()) {
+            return false;
+        }
+    }
+}
+
+JSONElement JSONArrayReader::next()
+{
+    if(m_item) {
+        cJSON_Delete(m_item);
+        m_item = NULL;
+    }
+
+    if(!m_ok || !SkipSeparators() || m_buffer[m_pos] == ']') {
+        // the end of the array
+        m_ok = false;
+        return JSONElement(NULL);
+    }
+
+    m_scanPos = m_pos;
+    m_depth = 0;
+    m_inString = false;
+    m_escape = false;
+
+    size_t end = 0;
+    if(!FindItemEnd(end)) {
+        m_ok = false;
+        return JSONElement(NULL);
+    }
+
+    m_item = ParseUTF8(m_buffer.c_str() + m_pos, end - m_pos);
+    m_pos = end;
+    if(!m_item) {
+        m_ok = false;
+        return JSONElement(NULL);
+    }
+    return JSONElement(m_item);
+}
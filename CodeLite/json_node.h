@@ -36,16 +36,24 @@
 #include "cJSON.h"
 #include <wx/colour.h>
 #include <wx/font.h>
+#include <wx/ffile.h>
+#include <string>
 
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 
+/**
+ * @brief a node of a JSON document. The read methods don't modify the document, so several threads may read
+ * the same document at once. A document modified while it is shared must be protected by the caller
+ */
 class WXDLLIMPEXP_CL JSONElement
 {
 protected:
     cJSON* _json;
     int _type;
-    wxString _name;
+    // the name of a parsed element is converted on demand
+    mutable wxString _name;
+    mutable bool _hasName;
 
     // Values
     wxVariant _value;
@@ -66,10 +74,14 @@ public:
 
     // Setters
     ////////////////////////////////////////////////
-    void setName(const wxString& _name) { this->_name = _name; }
+    void setName(const wxString& _name)
+    {
+        this->_name = _name;
+        this->_hasName = true;
+    }
     void setType(int _type) { this->_type = _type; }
     int getType() const { return _type; }
-    const wxString& getName() const { return _name; }
+    const wxString& getName() const;
     const wxVariant& getValue() const { return _value; }
     void setValue(const wxVariant& _value) { this->_value = _value; }
     // Readers
@@ -186,4 +198,52 @@ private:
     JSONRoot& operator=(const JSONRoot& src);
 };
 
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * @class JSONArrayReader
+ * @brief read the items of a file holding a large JSON array (e.g. compile_commands.json) one at a time.
+ * The file is read in chunks and only the current item is parsed, so the memory used does not depend on the file size
+ */
+class WXDLLIMPEXP_CL JSONArrayReader
+{
+    wxFFile m_fp;
+    std::string m_buffer;
+    size_t m_pos;
+    cJSON* m_item;
+    bool m_ok;
+
+    // the scanner state of the current item, kept across reads
+    size_t m_scanPos;
+    int m_depth;
+    bool m_inString;
+    bool m_escape;
+
+protected:
+    bool ReadMore();
+    bool SkipSeparators();
+    bool FindItemEnd(size_t& end);
+
+public:
+    JSONArrayReader(const wxFileName& filename);
+    virtual ~JSONArrayReader();
+
+    /**
+     * @brief false if the file could not be read as an array, or once all its items were read
+     */
+    bool isOk() const { return m_ok; }
+
+    /**
+     * @brief parse the next item of the array. The element is valid until the next call
+     * @return an invalid element (isOk() == false) at the end of the array or on a parse error
+     */
+    JSONElement next();
+
+private:
+    // Make this class not copyable
+    JSONArrayReader(const JSONArrayReader& src);
+    JSONArrayReader& operator=(const JSONArrayReader& src);
+};
+
 #endif // ZJSONNODE_H
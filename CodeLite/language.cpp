@@ -33,9 +33,11 @@
 #include "variable.h"
 #include "function.h"
 #include "ctags_manager.h"
+#include "tags_storage_sqlite3.h"
 #include "y.tab.h"
 #include <wx/stopwatch.h>
 #include <wx/ffile.h>
+#include <wx/hashmap.h>
 #include "map"
 #include <algorithm>
 #include "CxxPreProcessor.h"
@@ -83,6 +85,7 @@ Language::Language()
     , m_scanner(new CppScanner())
     , m_tokenScanner(new CppScanner())
     , m_tm(NULL)
+    , m_cacheGeneration(0)
 {
     // Initialise the braces map
     m_braces['<'] = '>';
@@ -342,7 +345,8 @@ bool Language::ProcessExpression(const wxString& stmt, const wxString& text, con
     wxString visibleScope, scopeName, localsBody;
 
     CL_DEBUG(wxT("Getting function signature from the database..."));
-    TagEntryPtr tag = GetTagsManager()->FunctionFromFileLine(fn, lineno);
+    DoValidateCache();
+    TagEntryPtr tag = DoFunctionFromFileLine(fn, lineno);
     if(tag) {
         lastFuncSig = tag->GetSignature();
     }
@@ -355,19 +359,30 @@ bool Language::ProcessExpression(const wxString& stmt, const wxString& text, con
     visibleScope = this->OptimizeScope(textAfterTokensReplacements, lastFuncLine, localsBody);
     CL_DEBUG(wxT("Optimizing scope...done"));
 
-    std::vector<wxString> additionalScopes;
-
-    CL_DEBUG(wxT("Obtaining the scope name..."));
-    scopeName = GetScopeName(visibleScope, &additionalScopes);
-    CL_DEBUG(wxT("Obtaining the scope name...done"));
-
-    // Allways use the global namespace as an addition scope
-    // but make sure we add it last
-    additionalScopes.push_back(wxT("<global>"));
+    // The scope name, the 'using namespace' scopes and the locals (ProcessToken() uses them) are
+    // parsed once per function body
+    const FunctionScopeCacheEntry& functionScope =
+        DoGetFunctionScope(fn, lastFuncLine, lastFuncSig, visibleScope, localsBody);
+    scopeName = functionScope.scopeName;
+    m_locals = functionScope.locals;
+    const wxString localsKey = functionScope.localsKey;
 
     SetLastFunctionSignature(lastFuncSig);
     SetVisibleScope(localsBody);
-    SetAdditionalScopes(additionalScopes, fn.GetFullPath());
+    SetAdditionalScopes(functionScope.additionalScopes, fn.GetFullPath());
+
+    // Resolving the expression is expensive (typedefs, templates and many database queries). Completing
+    // 'obj->a' and then 'obj->b' in the same scope resolves the very same 'obj->' expression
+    wxString cacheKey = DoGetExpressionCacheKey(statement, scopeName, localsKey);
+    std::map<wxString, ExpressionCacheEntry>::const_iterator cacheIter = m_expressionCache.find(cacheKey);
+    if(cacheIter != m_expressionCache.end()) {
+        CL_DEBUG(wxT(" <<< Language::ProcessExpression: using cached result"));
+        typeName = cacheIter->second.typeName;
+        typeScope = cacheIter->second.typeScope;
+        oper = cacheIter->second.oper;
+        m_templateArgs = cacheIter->second.templateArgs;
+        return cacheIter->second.succeeded;
+    }
 
     // get next token using the tokenscanner object
     m_tokenScanner->SetText(_C(statement));
@@ -457,6 +472,17 @@ bool Language::ProcessExpression(const wxString& stmt, const wxString& text, con
 
     // release the tokens
     ParsedToken::DeleteTokens(container.head);
+
+    if(m_expressionCache.size() >= 1000) {
+        m_expressionCache.clear();
+    }
+    ExpressionCacheEntry& entry = m_expressionCache[cacheKey];
+    entry.succeeded = evaluationSucceeded;
+    entry.typeName = typeName;
+    entry.typeScope = typeScope;
+    entry.oper = oper;
+    entry.templateArgs = m_templateArgs;
+
     CL_DEBUG(wxT(" <<< Language::ProcessExpression started ... done"));
     return evaluationSucceeded;
 }
@@ -471,22 +497,9 @@ void Language::DoSimpleTypedef(ParsedToken* token)
 {
     // If the match is typedef, try to replace it with the actual
     // typename
-    std::vector<TagEntryPtr> tags;
-    std::vector<TagEntryPtr> filteredTags;
-    wxString path;
-
-    GetTagsManager()->FindByPath(token->GetPath(), tags);
-
-    // try to remove all tags that are Macros from this list
-    for(size_t i = 0; i < tags.size(); i++) {
-        if(!tags.at(i)->IsMacro()) {
-            filteredTags.push_back(tags.at(i));
-        }
-    }
-
-    if(filteredTags.size() == 1) {
+    TagEntryPtr tag;
+    if(DoFindTypeByPath(token->GetPath(), tag) == 1) {
         // we have a single match, test to see if it a typedef
-        TagEntryPtr tag = filteredTags.at(0);
         wxString tmpInitList;
 
         wxString realName = tag->NameFromTyperef(tmpInitList);
@@ -505,26 +518,15 @@ bool Language::OnTypedef(ParsedToken* token)
     // If the match is typedef, try to replace it with the actual
     // typename
     bool res(false);
-    std::vector<TagEntryPtr> tags;
-    std::vector<TagEntryPtr> filteredTags;
-    wxString path;
-    TagsManager* tagsManager = GetTagsManager();
 
     wxString oldName = token->GetTypeName();
     wxString oldScope = token->GetTypeScope();
 
-    tagsManager->FindByPath(token->GetPath(), tags);
-
-    // try to remove all tags that are Macros from this list
-    for(size_t i = 0; i < tags.size(); i++) {
-        if(!tags.at(i)->IsMacro()) {
-            filteredTags.push_back(tags.at(i));
-        }
-    }
-
-    if(filteredTags.size() == 1) {
+    // the tags matching the path (macros excluded)
+    TagEntryPtr tag;
+    size_t matches = DoFindTypeByPath(token->GetPath(), tag);
+    if(matches == 1) {
         // We have a single match, test to see if it a typedef
-        TagEntryPtr tag = filteredTags.at(0);
         wxString tmpInitList;
 
         wxString realName = tag->NameFromTyperef(tmpInitList);
@@ -552,7 +554,7 @@ bool Language::OnTypedef(ParsedToken* token)
         }
     }
 
-    if(filteredTags.empty()) {
+    if(matches == 0) {
         // this is yet another attempt to fix a match which we failed to resolve it completly
         // a good example for such case is using a typedef which was defined inside a function
         // body
@@ -855,10 +857,8 @@ bool Language::ProcessToken(TokenContainer* tokeContainer)
         CL_DEBUG(wxT("Parsing for local variables..."));
         CL_DEBUG1("Current scrope:\n%s\n", GetVisibleScope());
 
-        const wxCharBuffer buf = _C(GetVisibleScope());
-        const wxCharBuffer buf2 = _C(GetLastFunctionSignature() + wxT(";"));
-        get_variables(buf.data(), li, ignoreTokens, false);
-        get_variables(buf2.data(), li, ignoreTokens, true);
+        // collected by ProcessExpression()
+        li = m_locals;
         CL_DEBUG(wxT("Parsing for local variables... done"));
 
         // Search for a full match in the returned list
@@ -1855,6 +1855,144 @@ void Language::SetAdditionalScopes(const std::vector<wxString>& additionalScopes
 
 const std::vector<wxString>& Language::GetAdditionalScopes() const { return m_additionalScopes; }
 
+void Language::ClearCache()
+{
+    m_expressionCache.clear();
+    m_functionScopeCache.clear();
+    m_functionByLineCache.clear();
+    m_typeByPathCache.clear();
+}
+
+void Language::DoValidateCache()
+{
+    size_t generation = TagsStorageSQLiteCache::GetDbGeneration();
+    if(generation != m_cacheGeneration) {
+        ClearCache();
+        m_cacheGeneration = generation;
+    }
+}
+
+size_t Language::DoFindTypeByPath(const wxString& path, TagEntryPtr& tag)
+{
+    DoValidateCache();
+    std::map<wxString, std::pair<size_t, TagEntryPtr> >::const_iterator iter = m_typeByPathCache.find(path);
+    if(iter == m_typeByPathCache.end()) {
+        std::vector<TagEntryPtr> tags;
+        GetTagsManager()->FindByPath(path, tags);
+
+        // try to remove all tags that are Macros from this list
+        size_t count(0);
+        TagEntryPtr match(NULL);
+        for(size_t i = 0; i < tags.size(); i++) {
+            if(!tags.at(i)->IsMacro()) {
+                if(count == 0) {
+                    match = tags.at(i);
+                }
+                count++;
+            }
+        }
+
+        if(m_typeByPathCache.size() >= 5000) {
+            m_typeByPathCache.clear();
+        }
+        iter = m_typeByPathCache.insert(std::make_pair(path, std::make_pair(count, match))).first;
+    }
+
+    tag = (iter->second.first == 1) ? iter->second.second : TagEntryPtr(NULL);
+    return iter->second.first;
+}
+
+TagEntryPtr Language::DoFunctionFromFileLine(const wxFileName& fn, int lineno)
+{
+    wxString key;
+    key << fn.GetFullPath() << wxT(":") << lineno;
+    std::map<wxString, TagEntryPtr>::const_iterator iter = m_functionByLineCache.find(key);
+    if(iter != m_functionByLineCache.end()) {
+        return iter->second;
+    }
+
+    TagEntryPtr tag = GetTagsManager()->FunctionFromFileLine(fn, lineno);
+    if(m_functionByLineCache.size() >= 1000) {
+        m_functionByLineCache.clear();
+    }
+    m_functionByLineCache.insert(std::make_pair(key, tag));
+    return tag;
+}
+
+const Language::FunctionScopeCacheEntry& Language::DoGetFunctionScope(const wxFileName& fn,
+                                                                      int lastFuncLine,
+                                                                      const wxString& lastFuncSig,
+                                                                      const wxString& visibleScope,
+                                                                      const wxString& localsBody)
+{
+    // The scope text is hashed: keeping it in the key would copy the whole file text for every entry
+    wxStringHash hasher;
+    wxString key;
+    key << fn.GetFullPath() << wxT(":") << lastFuncLine << wxT(":") << visibleScope.length() << wxT(":")
+        << (size_t)hasher(visibleScope) << wxT(":") << localsBody.length() << wxT(":") << (size_t)hasher(localsBody);
+
+    std::map<wxString, FunctionScopeCacheEntry>::iterator iter = m_functionScopeCache.find(key);
+    if(iter != m_functionScopeCache.end()) {
+        return iter->second;
+    }
+
+    if(m_functionScopeCache.size() >= 100) {
+        m_functionScopeCache.clear();
+    }
+    FunctionScopeCacheEntry& entry = m_functionScopeCache[key];
+
+    CL_DEBUG(wxT("Obtaining the scope name..."));
+    entry.scopeName = GetScopeName(visibleScope, &entry.additionalScopes);
+    CL_DEBUG(wxT("Obtaining the scope name...done"));
+
+    // Allways use the global namespace as an addition scope
+    // but make sure we add it last
+    entry.additionalScopes.push_back(wxT("<global>"));
+
+    std::map<std::string, std::string> ignoreTokens = GetTagsManager()->GetCtagsOptions().GetTokensMap();
+    const wxCharBuffer localsBuf = _C(localsBody);
+    const wxCharBuffer signatureBuf = _C(lastFuncSig + wxT(";"));
+    get_variables(localsBuf.data(), entry.locals, ignoreTokens, false);
+    get_variables(signatureBuf.data(), entry.locals, ignoreTokens, true);
+
+    VariableList::const_iterator varIter = entry.locals.begin();
+    for(; varIter != entry.locals.end(); varIter++) {
+        entry.localsKey << _U(varIter->m_name.c_str()) << wxT(" ") << _U(varIter->m_completeType.c_str())
+                        << (varIter->m_isAuto ? wxT(" auto;") : wxT(";"));
+    }
+    entry.localsKey << wxT("\n");
+
+    clTypedefList typedefsList;
+    get_typedefs(localsBuf.data(), typedefsList);
+    clTypedefList::const_iterator tdIter = typedefsList.begin();
+    for(; tdIter != typedefsList.end(); tdIter++) {
+        entry.localsKey << _U(tdIter->m_name.c_str()) << wxT("=") << _U(tdIter->m_realType.m_typeScope.c_str())
+                        << wxT("::") << _U(tdIter->m_realType.m_type.c_str())
+                        << _U(tdIter->m_realType.m_templateDecl.c_str()) << wxT(";");
+    }
+    return entry;
+}
+
+wxString Language::DoGetExpressionCacheKey(const wxString& statement,
+                                           const wxString& scopeName,
+                                           const wxString& localsKey)
+{
+    // The result depends on the database, the expression, the scope, the 'using namespace' statements
+    // and the local variables and typedefs
+    wxString key;
+    ITagsStoragePtr db = GetTagsManager()->GetDatabase();
+    if(db) {
+        key << db->GetDatabaseFileName().GetFullPath();
+    }
+    key << wxT("\n") << statement << wxT("\n") << scopeName << wxT("\n") << GetLastFunctionSignature() << wxT("\n");
+
+    for(size_t i = 0; i < m_additionalScopes.size(); i++) {
+        key << m_additionalScopes.at(i) << wxT(";");
+    }
+    key << wxT("\n") << localsKey;
+    return key;
+}
+
 bool Language::OnSubscriptOperator(ParsedToken* token)
 {
     bool ret(false);
@@ -103,6 +103,32 @@ private:
     std::map<wxString, std::vector<wxString> > m_additionalScopesCache; // collected by parsing 'using namespace XXX'
     TemplateHelper m_templateHelper;
     std::set<wxString> m_templateArgs;
+    VariableList m_locals; // the local variables of the scope passed to ProcessExpression()
+
+    // Resolved expressions and typedefs. Both are valid as long as the database does not change
+    struct ExpressionCacheEntry {
+        bool succeeded;
+        wxString typeName;
+        wxString typeScope;
+        wxString oper;
+        std::set<wxString> templateArgs;
+        ExpressionCacheEntry()
+            : succeeded(false)
+        {
+        }
+    };
+    // What ProcessExpression() parses out of the function enclosing the caret
+    struct FunctionScopeCacheEntry {
+        wxString scopeName;
+        std::vector<wxString> additionalScopes; // the 'using namespace' scopes
+        VariableList locals;
+        wxString localsKey; // the locals and the local typedefs, part of the expressions cache key
+    };
+    std::map<wxString, ExpressionCacheEntry> m_expressionCache;
+    std::map<wxString, FunctionScopeCacheEntry> m_functionScopeCache; // file + function line + scope hash -> entry
+    std::map<wxString, TagEntryPtr> m_functionByLineCache;             // file + line -> enclosing function
+    std::map<wxString, std::pair<size_t, TagEntryPtr> > m_typeByPathCache; // path -> number of matches, match
+    size_t m_cacheGeneration;
 
 protected:
     void SetVisibleScope(const wxString& visibleScope) { this->m_visibleScope = visibleScope; }
@@ -280,6 +306,12 @@ public:
                             wxString& sourceContent,
                             int& insertedLine);
 
+    /**
+     * @brief clear the resolved expressions and typedefs cache. The cache is cleared automatically
+     * when the database is modified; call this when the settings affecting the resolution change
+     */
+    void ClearCache();
+
 private:
     bool DoSearchByNameAndScope(const wxString& name,
                                 const wxString& scopeName,
@@ -292,6 +324,34 @@ private:
                                wxString& typeScope,
                                const wxString& parentScope,
                                std::vector<TagEntryPtr>& tags);
+
+    /**
+     * @brief clear the caches if the database was modified since they were filled
+     */
+    void DoValidateCache();
+    /**
+     * @brief return the number of non macro tags matching 'path'. If there is exactly one, return it in 'tag'
+     */
+    size_t DoFindTypeByPath(const wxString& path, TagEntryPtr& tag);
+    /**
+     * @brief return the function enclosing 'lineno' (see TagsManager::FunctionFromFileLine)
+     */
+    TagEntryPtr DoFunctionFromFileLine(const wxFileName& fn, int lineno);
+    /**
+     * @brief return the scope name, the 'using namespace' scopes, the local variables and the local typedefs
+     * of a function. They are parsed once per function body: the entry is keyed by the file, the function line
+     * and a hash of 'visibleScope' and 'localsBody'
+     */
+    const FunctionScopeCacheEntry& DoGetFunctionScope(const wxFileName& fn,
+                                                      int lastFuncLine,
+                                                      const wxString& lastFuncSig,
+                                                      const wxString& visibleScope,
+                                                      const wxString& localsBody);
+    /**
+     * @brief return the key of 'statement' in the expressions cache. Must be called after the visible scope
+     * and the additional scopes were set
+     */
+    wxString DoGetExpressionCacheKey(const wxString& statement, const wxString& scopeName, const wxString& localsKey);
     /**
      * Private constructor
      */
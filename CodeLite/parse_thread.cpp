@@ -37,12 +37,24 @@
 #include <wx/ffile.h>
 #include "cpp_scanner.h"
 #include <set>
+#include <deque>
 #include "cl_command_event.h"
 #include <tags_options_data.h>
 #include "CxxVariableScanner.h"
+#include "clTrigramIndex.h"
 
 #define DEBUG_MESSAGE(x) CL_DEBUG1(x.c_str())
 
+// Below this number of files, rebuilding the indexes of the whole
+// tags table costs more than updating them while storing
+#define PARSE_THREAD_BULK_LOAD_MIN_FILES 200
+
+// Below this number of files per worker, the files are parsed by the parser thread itself
+#define PARSE_THREAD_MIN_FILES_PER_WORKER 20
+
+// Max number of parsed files waiting to be stored by the parser thread
+#define PARSE_THREAD_MAX_PENDING_FILES 256
+
 #define TEST_DESTROY()                                                                                        \
     {                                                                                                         \
         if(TestDestroy()) {                                                                                   \
@@ -73,6 +85,258 @@ const wxEventType wxEVT_PARSE_THREAD_READY = XRCID("wxEVT_PARSE_THREAD_READY");
 // Event type: clCommandEvent
 const wxEventType wxEVT_PARSE_THREAD_SUGGEST_COLOUR_TOKENS = XRCID("wxEVT_PARSE_THREAD_SUGGEST_COLOUR_TOKENS");
 
+namespace
+{
+/**
+ * @brief a file parsed by a worker thread, waiting to be stored
+ */
+struct ParsedFile {
+    wxString file;
+    bool binary;
+    TagTreePtr tree;
+    int count;
+    wxString contentHash;
+
+    ParsedFile()
+        : binary(false)
+        , count(0)
+    {
+    }
+};
+
+class ParseWorker;
+
+/**
+ * @class ParseWorkerPool
+ * @brief converts a list of files into tags trees using several worker threads.
+ * Each worker is given an equal range of the files; a worker which is done with its range
+ * steals the second half of the largest remaining range. The parsed files are consumed
+ * (in no particular order) by a single writer - the parser thread - which owns the database.
+ * TagTreePtr reference counting is not thread safe, so the trees change hands under the lock only
+ */
+class ParseWorkerPool
+{
+    struct Range {
+        size_t first; // next file to parse
+        size_t last;  // one past the last file
+    };
+
+    wxArrayString m_files;
+    std::vector<Range> m_ranges;
+    std::vector<ParseWorker*> m_workers;
+    std::deque<ParsedFile> m_results;
+    wxMutex m_mutex;
+    wxCondition m_resultsCond; // a file was parsed
+    wxCondition m_spaceCond;   // a parsed file was consumed
+    bool m_stop;
+
+public:
+    ParseWorkerPool(const wxArrayString& files);
+    virtual ~ParseWorkerPool();
+
+    /**
+     * @brief start 'workers' threads. Returns false (and nothing is parsed) if less
+     * than 2 workers could be started, the caller should parse the files by itself
+     */
+    bool Start(size_t workers);
+
+    /**
+     * @brief stop and wait for the workers
+     */
+    void Stop();
+
+    /**
+     * @brief wait up to 'timeout' ms for a parsed file
+     */
+    bool Pop(ParsedFile& parsedFile, long timeout);
+
+    // Workers API
+    bool Next(size_t worker, wxString& file);
+    bool Push(ParsedFile& parsedFile);
+};
+
+class ParseWorker : public wxThread
+{
+    ParseWorkerPool* m_pool;
+    size_t m_id;
+
+public:
+    ParseWorker(ParseWorkerPool* pool, size_t id)
+        : wxThread(wxTHREAD_JOINABLE)
+        , m_pool(pool)
+        , m_id(id)
+    {
+    }
+    virtual ~ParseWorker() {}
+
+    virtual void* Entry()
+    {
+        wxString file;
+        while(m_pool->Next(m_id, file)) {
+            ParsedFile parsedFile;
+            parsedFile.file = file;
+            parsedFile.binary = TagsManagerST::Get()->IsBinaryFile(file);
+            if(!parsedFile.binary) {
+                // ctags is not thread safe, each worker uses its own indexer
+                TagEntryPtrVector_t tags;
+                TagsManagerST::Get()->SourceToTags(file, tags, m_id);
+                parsedFile.tree = TagsManagerST::Get()->TreeFromTags(tags, parsedFile.count);
+            }
+
+            if(!m_pool->Push(parsedFile)) {
+                break;
+            }
+        }
+        return NULL;
+    }
+};
+
+ParseWorkerPool::ParseWorkerPool(const wxArrayString& files)
+    : m_resultsCond(m_mutex)
+    , m_spaceCond(m_mutex)
+    , m_stop(false)
+{
+    // The workers get their own copy of the file names
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        m_files.Add(files.Item(i).c_str());
+    }
+}
+
+ParseWorkerPool::~ParseWorkerPool() { Stop(); }
+
+bool ParseWorkerPool::Start(size_t workers)
+{
+    if(workers < 2 || m_files.IsEmpty()) {
+        return false;
+    }
+
+    size_t chunk = m_files.GetCount() / workers;
+    for(size_t i = 0; i < workers; ++i) {
+        Range range;
+        range.first = i * chunk;
+        range.last = (i + 1 == workers) ? m_files.GetCount() : range.first + chunk;
+        m_ranges.push_back(range);
+    }
+
+    for(size_t i = 0; i < workers; ++i) {
+        ParseWorker* worker = new ParseWorker(this, i);
+        if(worker->Run() != wxTHREAD_NO_ERROR) {
+            // its range will be stolen by the other workers
+            delete worker;
+            continue;
+        }
+        m_workers.push_back(worker);
+    }
+
+    if(m_workers.size() < 2) {
+        Stop();
+        return false;
+    }
+    CL_DEBUG("ParseThread: parsing %u files with %u workers", (unsigned int)m_files.GetCount(),
+             (unsigned int)m_workers.size());
+    return true;
+}
+
+void ParseWorkerPool::Stop()
+{
+    {
+        wxMutexLocker locker(m_mutex);
+        m_stop = true;
+        m_resultsCond.Broadcast();
+        m_spaceCond.Broadcast();
+    }
+
+    for(size_t i = 0; i < m_workers.size(); ++i) {
+        m_workers.at(i)->Wait();
+        delete m_workers.at(i);
+    }
+    m_workers.clear();
+
+    wxMutexLocker locker(m_mutex);
+    m_results.clear();
+}
+
+bool ParseWorkerPool::Pop(ParsedFile& parsedFile, long timeout)
+{
+    wxMutexLocker locker(m_mutex);
+    if(m_results.empty()) {
+        m_resultsCond.WaitTimeout(timeout);
+        if(m_results.empty()) {
+            return false;
+        }
+    }
+    parsedFile = m_results.front();
+    m_results.pop_front();
+    m_spaceCond.Signal();
+    return true;
+}
+
+bool ParseWorkerPool::Next(size_t worker, wxString& file)
+{
+    wxMutexLocker locker(m_mutex);
+    if(m_stop) {
+        return false;
+    }
+
+    Range& range = m_ranges.at(worker);
+    if(range.first == range.last) {
+        // Steal the second half of the largest range
+        size_t victim = 0;
+        size_t largest = 0;
+        for(size_t i = 0; i < m_ranges.size(); ++i) {
+            size_t size = m_ranges.at(i).last - m_ranges.at(i).first;
+            if(size > largest) {
+                largest = size;
+                victim = i;
+            }
+        }
+
+        if(largest == 0) {
+            return false;
+        }
+
+        Range& victimRange = m_ranges.at(victim);
+        range.last = victimRange.last;
+        range.first = victimRange.last - (largest - largest / 2);
+        victimRange.last = range.first;
+    }
+
+    file = m_files.Item(range.first).c_str();
+    ++range.first;
+    return true;
+}
+
+bool ParseWorkerPool::Push(ParsedFile& parsedFile)
+{
+    wxMutexLocker locker(m_mutex);
+    while(!m_stop && m_results.size() >= PARSE_THREAD_MAX_PENDING_FILES) {
+        m_spaceCond.Wait();
+    }
+
+    if(!m_stop) {
+        m_results.push_back(parsedFile);
+        m_resultsCond.Signal();
+    }
+
+    // Release the worker's reference to the tree while holding the lock
+    parsedFile.tree = TagTreePtr();
+    return !m_stop;
+}
+
+/**
+ * @brief the number of workers to use for parsing 'files' files
+ */
+size_t GetParseWorkersCount(size_t files)
+{
+    size_t workers = files / PARSE_THREAD_MIN_FILES_PER_WORKER;
+    if(workers < 2) {
+        return workers;
+    }
+    // The extra indexers are started by the first batch that needs them
+    return TagsManagerST::Get()->RequestIndexers(workers);
+}
+}
+
 ParseThread::ParseThread()
     : WorkerThread()
 {
@@ -104,6 +368,10 @@ void ParseThread::ProcessRequest(ThreadRequest* request)
     case ParseRequest::PR_SUGGEST_HIGHLIGHT_WORDS:
         ProcessColourRequest(req);
         break;
+    case ParseRequest::PR_UPDATE_FIND_IN_FILES_INDEX:
+        // Background maintenance, no one is waiting for this request
+        ProcessUpdateFindInFilesIndex(req);
+        return;
     default:
     case ParseRequest::PR_FILESAVED:
         ProcessSimple(req);
@@ -129,12 +397,12 @@ void ParseThread::ParseIncludeFiles(ParseRequest* req, const wxString& filename,
     ParseAndStoreFiles(req, arrFiles, initalCount, db);
 }
 
-TagTreePtr ParseThread::DoTreeFromTags(const wxString& tags, int& count)
+TagTreePtr ParseThread::DoTreeFromTags(const TagEntryPtrVector_t& tags, int& count)
 {
     return TagsManagerST::Get()->TreeFromTags(tags, count);
 }
 
-void ParseThread::DoStoreTags(const wxString& tags, const wxString& filename, int& count, ITagsStoragePtr db)
+void ParseThread::DoStoreTags(const TagEntryPtrVector_t& tags, const wxString& filename, int& count, ITagsStoragePtr db)
 {
     TagTreePtr ttp = DoTreeFromTags(tags, count);
     db->Begin();
@@ -222,7 +490,7 @@ void ParseThread::ProcessSimple(ParseRequest* req)
     db->OpenDatabase(dbfile);
 
     // convert the file content into tags
-    wxString tags;
+    TagEntryPtrVector_t tags;
     wxString file_name(req->getFile());
     tagmgr->SourceToTags(file_name, tags);
 
@@ -230,19 +498,20 @@ void ParseThread::ProcessSimple(ParseRequest* req)
     DoStoreTags(tags, file_name, count, db);
 
     db->Begin();
-    ///////////////////////////////////////////
-    // update the file retag timestamp
-    ///////////////////////////////////////////
-    db->InsertFileEntry(file, (int)time(NULL));
-
     ////////////////////////////////////////////////
     // Parse and store the macros found in this file
     ////////////////////////////////////////////////
+    wxString contentHash;
     PPTable::Instance()->Clear();
-    PPScan(file, true);
+    PPScan(file, true, &contentHash);
     db->StoreMacros(PPTable::Instance()->GetTable());
     PPTable::Instance()->Clear();
 
+    ///////////////////////////////////////////
+    // update the file retag timestamp
+    ///////////////////////////////////////////
+    db->InsertFileEntry(file, (int)time(NULL), contentHash);
+
     db->Commit();
 
     // Parse the saved file to get a list of files to include
@@ -250,10 +519,8 @@ void ParseThread::ProcessSimple(ParseRequest* req)
 
     // If there is no event handler set to handle this comaprison
     // results, then nothing more to be done
+    // The tags cache of the main thread drops the entries of the modified files by itself
     if(req->_evtHandler) {
-        wxCommandEvent clearCacheEvent(wxEVT_PARSE_THREAD_CLEAR_TAGS_CACHE);
-        req->_evtHandler->AddPendingEvent(clearCacheEvent);
-
         wxCommandEvent retaggingCompletedEvent(wxEVT_PARSE_THREAD_RETAGGING_COMPLETED);
         retaggingCompletedEvent.SetClientData(NULL);
         req->_evtHandler->AddPendingEvent(retaggingCompletedEvent);
@@ -312,16 +579,66 @@ void ParseThread::ParseAndStoreFiles(
     // Loop over the files and parse them
     int totalSymbols(0);
     DEBUG_MESSAGE(wxString::Format(wxT("Parsing and saving files to database....")));
-    for(size_t i = 0; i < arrFiles.GetCount(); i++) {
 
-        // give a shutdown request a chance
-        TEST_DESTROY();
+    // Crawling the include files of a workspace for the first time stores a large number of files
+    bool bulkLoad = arrFiles.GetCount() >= PARSE_THREAD_BULK_LOAD_MIN_FILES;
+    size_t commitEvery = bulkLoad ? 1000 : 50;
 
-        wxString tags; // output
-        TagsManagerST::Get()->SourceToTags(arrFiles.Item(i), tags);
+    ParseWorkerPool pool(arrFiles);
+    if(pool.Start(GetParseWorkersCount(arrFiles.GetCount()))) {
+        // The files are parsed by the workers, we store them in batches
+        if(bulkLoad) {
+            db->BeginBulkLoad();
+        }
+        size_t stored = 0;
+        db->Begin();
+        while(stored < arrFiles.GetCount()) {
+
+            // give a shutdown request a chance
+            if(TestDestroy()) {
+                pool.Stop();
+                db->Rollback();
+                if(bulkLoad) {
+                    db->EndBulkLoad();
+                }
+                return;
+            }
+
+            ParsedFile parsedFile;
+            if(!pool.Pop(parsedFile, 100)) {
+                continue;
+            }
 
-        if(tags.IsEmpty() == false) {
-            DoStoreTags(tags, arrFiles.Item(i), totalSymbols, db);
+            ++stored;
+            if(parsedFile.count == 0) {
+                continue;
+            }
+
+            totalSymbols += parsedFile.count;
+            db->DeleteByFileName(wxFileName(), parsedFile.file, false);
+            db->Store(parsedFile.tree, wxFileName(), false);
+            if(stored % commitEvery == 0) {
+                db->Commit();
+                db->Begin();
+            }
+        }
+        db->Commit();
+        if(bulkLoad) {
+            db->EndBulkLoad();
+        }
+
+    } else {
+        for(size_t i = 0; i < arrFiles.GetCount(); i++) {
+
+            // give a shutdown request a chance
+            TEST_DESTROY();
+
+            TagEntryPtrVector_t tags; // output
+            TagsManagerST::Get()->SourceToTags(arrFiles.Item(i), tags);
+
+            if(tags.empty() == false) {
+                DoStoreTags(tags, arrFiles.Item(i), totalSymbols, db);
+            }
         }
     }
 
@@ -339,13 +656,6 @@ void ParseThread::ParseAndStoreFiles(
 
         e.SetClientData(new wxString(message.c_str()));
         req->_evtHandler->AddPendingEvent(e);
-
-        // if we added new symbols to the database, send an even to the main thread
-        // to clear the tags cache
-        if(totalSymbols) {
-            wxCommandEvent clearCacheEvent(wxEVT_PARSE_THREAD_CLEAR_TAGS_CACHE);
-            req->_evtHandler->AddPendingEvent(clearCacheEvent);
-        }
     }
 }
 
@@ -370,6 +680,7 @@ void ParseThread::ProcessDeleteTagsOfFiles(ParseRequest* req)
 
     db->DeleteFromFiles(file_array);
     db->Commit();
+    clTrigramIndex::Get().RemoveFiles(file_array);
     DEBUG_MESSAGE(wxString(wxT("ParseThread::ProcessDeleteTagsOfFile - completed")));
 }
 
@@ -377,9 +688,30 @@ void ParseThread::ProcessParseAndStore(ParseRequest* req)
 {
     wxString dbfile = req->getDbfile();
 
+    ITagsStoragePtr db(new TagsStorageSQLite());
+    db->OpenDatabase(dbfile);
+
+    wxArrayString files;
+    for(size_t i = 0; i < req->_workspaceFiles.size(); i++) {
+        files.Add(wxString(req->_workspaceFiles.at(i).c_str(), wxConvUTF8));
+    }
+
+    // A quick retag only parses the files that were modified since they were parsed
+    if(req->_quickRetag) {
+        TagsManagerST::Get()->FilterNonNeededFilesForRetaging(files, db);
+        DEBUG_MESSAGE(wxString::Format(wxT("Quick retag: %u out of %u files need to be parsed"),
+                                       (unsigned int)files.GetCount(),
+                                       (unsigned int)req->_workspaceFiles.size()));
+    }
+
     // convert the file to tags
-    double maxVal = (double)req->_workspaceFiles.size();
+    double maxVal = (double)files.GetCount();
     if(maxVal == 0.0) {
+        if(req->_evtHandler) {
+            wxCommandEvent retaggingCompletedEvent(wxEVT_PARSE_THREAD_RETAGGING_COMPLETED);
+            retaggingCompletedEvent.SetClientData(NULL);
+            req->_evtHandler->AddPendingEvent(retaggingCompletedEvent);
+        }
         return;
     }
 
@@ -390,31 +722,61 @@ void ParseThread::ProcessParseAndStore(ParseRequest* req)
         reportingPoint = 1.0;
     }
 
-    ITagsStoragePtr db(new TagsStorageSQLite());
-    db->OpenDatabase(dbfile);
+    // A full retag of a large number of files is stored in bulk load mode:
+    // large transactions with a page cache big enough to hold the indexes
+    bool bulkLoad = !req->_quickRetag && files.GetCount() >= PARSE_THREAD_BULK_LOAD_MIN_FILES;
+    size_t commitEvery = bulkLoad ? 1000 : 50;
+    wxStopWatch sw;
+    if(bulkLoad) {
+        db->BeginBulkLoad();
+    }
 
-    // We commit every 10 files
+    // We commit every 'commitEvery' files
     db->Begin();
     int precent(0);
     int lastPercentageReported(0);
 
     PPTable::Instance()->Clear();
 
-    for(size_t i = 0; i < maxVal; i++) {
+    // The files are converted into tags by the workers (each one with its own codelite_indexer),
+    // this thread remains the only one writing to the database
+    ParseWorkerPool pool(files);
+    bool parallel = pool.Start(GetParseWorkersCount(files.GetCount()));
+
+    size_t i = 0;
+    while(i < files.GetCount()) {
 
         // give a shutdown request a chance
         if(TestDestroy()) {
             // Do an ordered shutdown:
-            // rollback any transaction
+            // stop the workers, rollback any transaction
             // and close the database
+            pool.Stop();
             db->Rollback();
+            if(bulkLoad) {
+                db->EndBulkLoad();
+            }
             return;
         }
 
-        wxFileName curFile(wxString(req->_workspaceFiles.at(i).c_str(), wxConvUTF8));
+        ParsedFile parsedFile;
+        if(parallel) {
+            if(!pool.Pop(parsedFile, 100)) {
+                continue;
+            }
+        } else {
+            parsedFile.file = files.Item(i);
+            parsedFile.binary = TagsManagerST::Get()->IsBinaryFile(parsedFile.file);
+            if(!parsedFile.binary) {
+                parsedFile.tree = TagsManagerST::Get()->ParseSourceFile(parsedFile.file);
+            }
+        }
+        ++i;
+
+        wxFileName curFile(parsedFile.file);
 
         // Skip binary files
-        if(TagsManagerST::Get()->IsBinaryFile(curFile.GetFullPath())) {
+        if(parsedFile.binary) {
             DEBUG_MESSAGE(wxString::Format(wxT("Skipping binary file %s"), curFile.GetFullPath().c_str()));
             continue;
         }
@@ -432,15 +794,16 @@ void ParseThread::ProcessParseAndStore(ParseRequest* req)
             wxPrintf(wxT("parsing: %%%d completed\n"), precent);
         }
 
-        TagTreePtr tree = TagsManagerST::Get()->ParseSourceFile(curFile);
-        PPScan(curFile.GetFullPath(), false);
+        // The macros scanner reads the whole file: hash the content it read
+        PPScan(curFile.GetFullPath(), false, &parsedFile.contentHash);
 
-        db->Store(tree, wxFileName(), false);
-        if(db->InsertFileEntry(curFile.GetFullPath(), (int)time(NULL)) == TagExist) {
-            db->UpdateFileEntry(curFile.GetFullPath(), (int)time(NULL));
+        db->DeleteByFileName(wxFileName(), curFile.GetFullPath(), false);
+        db->Store(parsedFile.tree, wxFileName(), false);
+        if(db->InsertFileEntry(curFile.GetFullPath(), (int)time(NULL), parsedFile.contentHash) == TagExist) {
+            db->UpdateFileEntry(curFile.GetFullPath(), (int)time(NULL), parsedFile.contentHash);
         }
 
-        if(i % 50 == 0) {
+        if(i % commitEvery == 0) {
             // Commit what we got so far
             db->Commit();
             // Start a new transaction
@@ -458,6 +821,17 @@ void ParseThread::ProcessParseAndStore(ParseRequest* req)
     // Commit whats left
     db->Commit();
 
+    if(bulkLoad) {
+        size_t tagsCount = db->EndBulkLoad();
+        long totalTime = sw.Time();
+        double tagsPerSecond = totalTime > 0 ? ((double)tagsCount * 1000.0 / (double)totalTime) : (double)tagsCount;
+        CL_SYSTEM("ParseThread: stored %u tags from %u files in %.2f seconds, %.0f tags/s",
+                  (unsigned int)tagsCount,
+                  (unsigned int)files.GetCount(),
+                  (double)totalTime / 1000.0,
+                  tagsPerSecond);
+    }
+
     // Clear the results
     PPTable::Instance()->Clear();
 
@@ -465,7 +839,10 @@ void ParseThread::ProcessParseAndStore(ParseRequest* req)
     if(req->_evtHandler) {
         wxCommandEvent retaggingCompletedEvent(wxEVT_PARSE_THREAD_RETAGGING_COMPLETED);
         std::vector<std::string>* arrFiles = new std::vector<std::string>;
-        *arrFiles = req->_workspaceFiles;
+        arrFiles->reserve(files.GetCount());
+        for(size_t j = 0; j < files.GetCount(); j++) {
+            arrFiles->push_back(files.Item(j).mb_str(wxConvUTF8).data());
+        }
         retaggingCompletedEvent.SetClientData(arrFiles);
         req->_evtHandler->AddPendingEvent(retaggingCompletedEvent);
     }
@@ -550,6 +927,42 @@ void ParseRequest::setFile(const wxString& file) { _file = file.c_str(); }
 
 ParseRequest::~ParseRequest() {}
 
+int ParseRequest::GetPriority() const
+{
+    switch(_type) {
+    case PR_SUGGEST_HIGHLIGHT_WORDS:
+    case PR_PARSE_INCLUDE_STATEMENTS:
+        return kRequestPriorityHigh;
+    case PR_UPDATE_FIND_IN_FILES_INDEX:
+        return kRequestPriorityLow;
+    case PR_FILESAVED:
+    case PR_PARSEINCLUDES:
+    case PR_PARSE_AND_STORE:
+    case PR_DELETE_TAGS_OF_FILES:
+    case PR_PARSE_FILE_NO_INCLUDES:
+        // Writers to the tags database: keep them in one class so a "file saved" request can't
+        // overtake an earlier delete or retag of the same file
+        return kRequestPriorityNormal;
+    default:
+        return kRequestPriorityNormal;
+    }
+}
+
+wxString ParseRequest::GetCoalescingKey() const
+{
+    if(_file.IsEmpty()) {
+        return wxEmptyString;
+    }
+
+    switch(_type) {
+    case PR_FILESAVED:
+    case PR_SUGGEST_HIGHLIGHT_WORDS:
+        return wxString() << _type << wxT(":") << _dbfile << wxT(":") << _file;
+    default:
+        return wxEmptyString;
+    }
+}
+
 // Adaptor to the parse thread
 static ParseThread* gs_theParseThread = NULL;
 
@@ -705,3 +1118,22 @@ void ParseThread::ProcessColourRequest(ParseRequest* req)
         }
     }
 }
+
+void ParseThread::ProcessUpdateFindInFilesIndex(ParseRequest* req)
+{
+    // Index the files in small chunks so a shutdown request is not delayed
+    wxArrayString files;
+    for(size_t i = 0; i < req->_workspaceFiles.size(); i++) {
+        files.Add(wxString(req->_workspaceFiles.at(i).c_str(), wxConvUTF8));
+        if(files.GetCount() == 200 || (i + 1) == req->_workspaceFiles.size()) {
+            TEST_DESTROY();
+            clTrigramIndex::Get().UpdateFiles(files);
+            files.Clear();
+        }
+    }
+
+    // A single saved file is kept in memory until the index is closed
+    if(req->_workspaceFiles.size() > 1) {
+        clTrigramIndex::Get().Save();
+    }
+}
@@ -71,6 +71,7 @@ public:
         PR_PARSE_FILE_NO_INCLUDES,
         PR_PARSE_INCLUDE_STATEMENTS,
         PR_SUGGEST_HIGHLIGHT_WORDS,
+        PR_UPDATE_FIND_IN_FILES_INDEX,
     };
 
 public:
@@ -130,6 +131,17 @@ public:
     {
         return _type;
     }
+    /**
+     * @brief requests a user is waiting for are served first. All the requests that write to the
+     * tags database share one priority so they are served in the order they were posted
+     */
+    virtual int GetPriority() const;
+
+    /**
+     * @brief only the last "file saved" and "colour" request of a file is kept in the queue
+     */
+    virtual wxString GetCoalescingKey() const;
+
     // copy ctor
     ParseRequest(const ParseRequest& rhs);
 
@@ -169,8 +181,8 @@ private:
      */
     virtual ~ParseThread();
 
-    void DoStoreTags(const wxString& tags, const wxString& filename, int& count, ITagsStoragePtr db);
-    TagTreePtr DoTreeFromTags(const wxString& tags, int& count);
+    void DoStoreTags(const TagEntryPtrVector_t& tags, const wxString& filename, int& count, ITagsStoragePtr db);
+    TagTreePtr DoTreeFromTags(const TagEntryPtrVector_t& tags, int& count);
     void DoNotifyReady(wxEvtHandler* caller, int requestType);
 
 private:
@@ -195,6 +207,7 @@ private:
     void ProcessIncludeStatements(ParseRequest* req);
     void ProcessColourRequest(ParseRequest* req);
     void ProcessMacroRequest(ParseRequest* req);
+    void ProcessUpdateFindInFilesIndex(ParseRequest* req);
     void GetFileListToParse(const wxString& filename, wxArrayString& arrFiles);
     void ParseAndStoreFiles(ParseRequest* req, const wxArrayString& arrFiles, int initalCount, ITagsStoragePtr db);
 
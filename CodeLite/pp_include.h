@@ -44,9 +44,10 @@
 /**
  * @brief the main interface to the PP API.
  * @param filePath
+ * @param contentHash [output] when not NULL, set to the hash of the scanned content (see clContentHash)
  * @return 
  */
-extern WXDLLIMPEXP_CL int PPScan      ( const wxString &filePath, bool forCC );
+extern WXDLLIMPEXP_CL int PPScan      ( const wxString &filePath, bool forCC, wxString* contentHash = NULL );
 /**
  * @brief scan input string
  */
@@ -735,6 +735,7 @@ char *pp_text;
 #include "pp_include.h"
 #include "pp_lexer.h"
 #include "pptable.h"
+#include "clContentHash.h"
 
 #define YYSTYPE wxString
 extern wxString pp_lval;
@@ -2401,30 +2402,36 @@ int pp_wrap() {
 	return 1;
 }
 
-int PPScan( const wxString &filePath, bool forCC )
+int PPScan( const wxString &filePath, bool forCC, wxString* contentHash )
 {
 	g_filename = filePath;
 	
 	BEGIN INITIAL;
 	pp_lineno = 1;
-	FILE* fp = fopen(filePath.To8BitData(), "r");
+	FILE* fp = fopen(filePath.To8BitData(), "rb");
 	if ( fp == NULL ) {
 		//printf("%s\n", strerror(errno));
 		// failed to open input file...
 		return -1;
 	}
 
-	pp__switch_to_buffer(pp__create_buffer(fp,YY_BUF_SIZE) );
-	pp_in = fp;
+	// Scan the file from memory, so its content can be hashed without reading it again
+	std::string content;
+	char buffer[64 * 1024];
+	size_t count = 0;
+	while ( (count = fread(buffer, 1, sizeof(buffer), fp)) > 0 ) {
+		content.append(buffer, count);
+	}
+	fclose(fp);
+
+	if ( contentHash ) {
+		*contentHash = clContentHash::ToString(clContentHash::Hash(content.data(), content.length()));
+	}
+
+	pp__scan_bytes( content.data(), (int)content.length() );
 	g_forCC = forCC;
 	int rc = pp_parse();
     g_forCC = false;
-	
-    if ( YY_CURRENT_BUFFER->yy_input_file ) {
-        fclose( YY_CURRENT_BUFFER->yy_input_file );
-        YY_CURRENT_BUFFER->yy_input_file = NULL;
-
-    }
 
     pp__delete_buffer    ( YY_CURRENT_BUFFER    );
     yyterminate();
@@ -26,13 +26,27 @@
 #include "file_logger.h"
 #include <wx/longlong.h>
 #include "tags_storage_sqlite3.h"
+#include "clSymbolIndex.h"
+#include "clFileNameIndex.h"
 #include <wx/tokenzr.h>
+#include <set>
+#include <deque>
+#include <algorithm>
+
+// The page cache used while storing a large number of tags (KB)
+#define TAGS_BULK_LOAD_CACHE_SIZE_KB (64 * 1024)
+
+// Number of tags fetched per query by DoFetchTagsFromIndex()
+#define TAGS_FETCH_BY_ID_BATCH 500
 
 //-------------------------------------------------
 // Tags database class implementation
 //-------------------------------------------------
 TagsStorageSQLite::TagsStorageSQLite()
     : ITagsStorage()
+    , m_bulkLoad(false)
+    , m_bulkLoadCacheSize(0)
+    , m_bulkLoadCount(0)
 {
     m_db = new clSqliteDB();
     SetUseCache(true);
@@ -108,7 +122,7 @@ void TagsStorageSQLite::CreateSchema()
         m_db->ExecuteUpdate(sql);
 
         sql = wxT("create  table if not exists FILES (ID INTEGER PRIMARY KEY AUTOINCREMENT, file string, last_retagged "
-                  "integer);");
+                  "integer, content_hash string);");
         m_db->ExecuteUpdate(sql);
 
         sql = wxT("create  table if not exists MACROS (ID INTEGER PRIMARY KEY AUTOINCREMENT, file string, line "
@@ -131,20 +145,26 @@ void TagsStorageSQLite::CreateSchema()
 
         m_db->ExecuteUpdate(trigger1);
 
-        wxString trigger2 = wxT("CREATE TRIGGER IF NOT EXISTS tags_insert AFTER INSERT ON tags ")
-            wxT("FOR EACH ROW WHEN NEW.scope = '<global>' ") wxT("BEGIN ")
-            wxT("    INSERT INTO global_tags (id, name, tag_id) VALUES (NULL, NEW.name, NEW.id);") wxT("END;");
-        m_db->ExecuteUpdate(trigger2);
-
         // Create unique index on tags table
         sql = wxT("CREATE UNIQUE INDEX IF NOT EXISTS TAGS_UNIQ on tags(kind, path, signature, typeref);");
         m_db->ExecuteUpdate(sql);
 
-        sql = wxT("CREATE INDEX IF NOT EXISTS KIND_IDX on tags(kind);");
-        m_db->ExecuteUpdate(sql);
-
-        sql = wxT("CREATE INDEX IF NOT EXISTS FILE_IDX on tags(file);");
-        m_db->ExecuteUpdate(sql);
+        // The 'tags_insert' trigger and the search indexes of the tags table.
+        // A database written by an interrupted bulk load of an older version may
+        // have lost the trigger, fill 'global_tags' with what it missed
+        bool hasInsertTrigger = false;
+        {
+            wxSQLite3ResultSet rs = m_db->ExecuteQuery(
+                wxT("SELECT 1 FROM sqlite_master WHERE type='trigger' AND name='tags_insert'"));
+            hasInsertTrigger = rs.NextRow();
+            rs.Finalize();
+        }
+        DoCreateTagsIndexes();
+        if(!hasInsertTrigger) {
+            sql = wxT("INSERT INTO global_tags (id, name, tag_id) SELECT NULL, name, id FROM tags WHERE scope = "
+                      "'<global>' AND id NOT IN (SELECT tag_id FROM global_tags)");
+            m_db->ExecuteUpdate(sql);
+        }
 
         sql = wxT("CREATE UNIQUE INDEX IF NOT EXISTS MACROS_UNIQ on MACROS(name);");
         m_db->ExecuteUpdate(sql);
@@ -155,42 +175,105 @@ void TagsStorageSQLite::CreateSchema()
         sql = wxT("CREATE INDEX IF NOT EXISTS global_tags_idx_2 on global_tags(tag_id);");
         m_db->ExecuteUpdate(sql);
 
-        // Create search indexes
-        sql = wxT("CREATE INDEX IF NOT EXISTS TAGS_NAME on tags(name);");
+        sql = wxT("CREATE INDEX IF NOT EXISTS MACROS_NAME on MACROS(name);");
         m_db->ExecuteUpdate(sql);
 
-        sql = wxT("CREATE INDEX IF NOT EXISTS TAGS_SCOPE on tags(scope);");
+        sql = wxT("CREATE INDEX IF NOT EXISTS SIMPLE_MACROS_FILE on SIMPLE_MACROS(file);");
         m_db->ExecuteUpdate(sql);
 
-        sql = wxT("CREATE INDEX IF NOT EXISTS TAGS_PATH on tags(path);");
+        sql = wxT("create table if not exists tags_version (version string primary key);");
         m_db->ExecuteUpdate(sql);
 
-        sql = wxT("CREATE INDEX IF NOT EXISTS TAGS_PARENT on tags(parent);");
+        sql = wxT("create unique index if not exists tags_version_uniq on tags_version(version);");
         m_db->ExecuteUpdate(sql);
 
-        sql = wxT("CREATE INDEX IF NOT EXISTS TAGS_TYPEREF on tags(typeref);");
+        sql = wxString(wxT("replace into tags_version values ('")) << GetVersion() << wxT("');");
         m_db->ExecuteUpdate(sql);
 
-        sql = wxT("CREATE INDEX IF NOT EXISTS MACROS_NAME on MACROS(name);");
+        // Used to find renamed files. This is done last since it fails on databases
+        // created before the 'content_hash' column was added (they are recreated)
+        sql = wxT("CREATE INDEX IF NOT EXISTS FILES_HASH on FILES(content_hash)");
         m_db->ExecuteUpdate(sql);
 
-        sql = wxT("CREATE INDEX IF NOT EXISTS SIMPLE_MACROS_FILE on SIMPLE_MACROS(file);");
-        m_db->ExecuteUpdate(sql);
+    } catch(wxSQLite3Exception& e) {
+        wxUnusedVar(e);
+    }
+}
 
-        sql = wxT("create table if not exists tags_version (version string primary key);");
-        m_db->ExecuteUpdate(sql);
+void TagsStorageSQLite::DoCreateTagsIndexes()
+{
+    wxString trigger = wxT("CREATE TRIGGER IF NOT EXISTS tags_insert AFTER INSERT ON tags ")
+        wxT("FOR EACH ROW WHEN NEW.scope = '<global>' ") wxT("BEGIN ")
+        wxT("    INSERT INTO global_tags (id, name, tag_id) VALUES (NULL, NEW.name, NEW.id);") wxT("END;");
+    m_db->ExecuteUpdate(trigger);
 
-        sql = wxT("create unique index if not exists tags_version_uniq on tags_version(version);");
-        m_db->ExecuteUpdate(sql);
+    wxString sql;
+    sql = wxT("CREATE INDEX IF NOT EXISTS KIND_IDX on tags(kind);");
+    m_db->ExecuteUpdate(sql);
 
-        sql = wxString(wxT("replace into tags_version values ('")) << GetVersion() << wxT("');");
+    sql = wxT("CREATE INDEX IF NOT EXISTS FILE_IDX on tags(file);");
+    m_db->ExecuteUpdate(sql);
+
+    // Create search indexes
+    sql = wxT("CREATE INDEX IF NOT EXISTS TAGS_NAME on tags(name);");
+    m_db->ExecuteUpdate(sql);
+
+    sql = wxT("CREATE INDEX IF NOT EXISTS TAGS_SCOPE on tags(scope);");
+    m_db->ExecuteUpdate(sql);
+
+    sql = wxT("CREATE INDEX IF NOT EXISTS TAGS_PATH on tags(path);");
+    m_db->ExecuteUpdate(sql);
+
+    sql = wxT("CREATE INDEX IF NOT EXISTS TAGS_PARENT on tags(parent);");
+    m_db->ExecuteUpdate(sql);
+
+    sql = wxT("CREATE INDEX IF NOT EXISTS TAGS_TYPEREF on tags(typeref);");
+    m_db->ExecuteUpdate(sql);
+}
+
+void TagsStorageSQLite::BeginBulkLoad()
+{
+    if(m_bulkLoad) return;
+
+    try {
+        // The indexes and the 'tags_insert' trigger are kept: the database is used by
+        // the other connections while the load is running (and must survive a crash).
+        // What slows the load down is SQLite reading and writing the index pages over
+        // and over, with a large page cache they remain in memory during a transaction
+        wxSQLite3ResultSet rs = m_db->ExecuteQuery(wxT("PRAGMA cache_size"));
+        m_bulkLoadCacheSize = rs.NextRow() ? rs.GetInt(0) : 0;
+        rs.Finalize();
+
+        wxString sql;
+        sql << wxT("PRAGMA cache_size = -") << TAGS_BULK_LOAD_CACHE_SIZE_KB;
         m_db->ExecuteUpdate(sql);
 
+        m_bulkLoad = true;
+        m_bulkLoadCount = 0;
+
     } catch(wxSQLite3Exception& e) {
-        wxUnusedVar(e);
+        CL_WARNING("TagsStorageSQLite::BeginBulkLoad: %s", e.GetMessage());
     }
 }
 
+size_t TagsStorageSQLite::EndBulkLoad()
+{
+    if(!m_bulkLoad) return 0;
+    m_bulkLoad = false;
+
+    try {
+        if(m_bulkLoadCacheSize != 0) {
+            wxString sql;
+            sql << wxT("PRAGMA cache_size = ") << m_bulkLoadCacheSize;
+            m_db->ExecuteUpdate(sql);
+        }
+
+    } catch(wxSQLite3Exception& e) {
+        CL_WARNING("TagsStorageSQLite::EndBulkLoad: %s", e.GetMessage());
+    }
+    return m_bulkLoadCount;
+}
+
 void TagsStorageSQLite::RecreateDatabase()
 {
     try {
@@ -218,6 +301,7 @@ void TagsStorageSQLite::RecreateDatabase()
 
             // drop indexes
             m_db->ExecuteUpdate(wxT("DROP INDEX IF EXISTS FILES_NAME"));
+            m_db->ExecuteUpdate(wxT("DROP INDEX IF EXISTS FILES_HASH"));
             m_db->ExecuteUpdate(wxT("DROP INDEX IF EXISTS TAGS_UNIQ"));
             m_db->ExecuteUpdate(wxT("DROP INDEX IF EXISTS KIND_IDX"));
             m_db->ExecuteUpdate(wxT("DROP INDEX IF EXISTS FILE_IDX"));
@@ -241,6 +325,11 @@ void TagsStorageSQLite::RecreateDatabase()
             m_fileName.Clear();
             OpenDatabase(filename);
         }
+        clSymbolIndex::Get().Clear(m_fileName);
+        if(clFileNameIndex::Get().IsFor(m_fileName)) {
+            clFileNameIndex::Get().Clear();
+        }
+        ClearCache();
     } catch(wxSQLite3Exception& e) {
         wxUnusedVar(e);
     }
@@ -280,6 +369,13 @@ void TagsStorageSQLite::Store(TagTreePtr tree, const wxFileName& path, bool auto
         // Create the statements before the execution
         std::vector<TagEntry> updateList;
 
+        // The stored tags are added to the symbol index
+        bool updateIndex = clSymbolIndex::Get().IsOpen();
+        std::vector<clSymbolIndex::Symbol> symbols;
+
+        // The cached queries are invalidated per file (see TagsStorageSQLiteCache)
+        std::map<wxString, std::vector<const TagEntry*> > fileTags;
+
         // AddChild entries to database
         if(autoCommit) m_db->Begin();
 
@@ -287,11 +383,33 @@ void TagsStorageSQLite::Store(TagTreePtr tree, const wxFileName& path, bool auto
             // Skip root node
             if(walker.GetNode() == tree->GetRoot()) continue;
 
-            DoInsertTagEntry(walker.GetNode()->GetData());
+            const TagEntry& tag = walker.GetNode()->GetData();
+            if(tag.IsOk()) {
+                fileTags[tag.GetFile()].push_back(&tag);
+            }
+
+            if(DoInsertTagEntry(tag) == TagOk && updateIndex && tag.IsOk()) {
+                clSymbolIndex::Symbol symbol;
+                symbol.id = m_db->GetLastRowId().GetValue();
+                symbol.name = tag.GetName();
+                symbol.kind = tag.GetKind();
+                symbol.scope = tag.GetScope();
+                symbol.file = tag.GetFile();
+                symbols.push_back(symbol);
+            }
         }
 
         if(autoCommit) m_db->Commit();
 
+        if(!symbols.empty()) {
+            clSymbolIndex::Get().AddSymbols(m_fileName, symbols);
+        }
+
+        std::map<wxString, std::vector<const TagEntry*> >::const_iterator iter = fileTags.begin();
+        for(; iter != fileTags.end(); ++iter) {
+            TagsStorageSQLiteCache::FileStored(iter->first, iter->second);
+        }
+
     } catch(wxSQLite3Exception& e) {
         try {
             if(autoCommit) m_db->Rollback();
@@ -334,6 +452,8 @@ void TagsStorageSQLite::DeleteByFileName(const wxFileName& path, const wxString&
         //#endif
         CL_DEBUG("TagsStorageSQLite: DeleteByFileName: '%s'", sql);
         m_db->ExecuteUpdate(sql);
+        clSymbolIndex::Get().RemoveFile(m_fileName, fileName);
+        TagsStorageSQLiteCache::FileDeleted(fileName);
 
         if(autoCommit) m_db->Commit();
     } catch(wxSQLite3Exception& e) {
@@ -366,38 +486,58 @@ void TagsStorageSQLite::ExecuteUpdate(const wxString& sql)
 
 const bool TagsStorageSQLite::IsOpen() const { return m_db->IsOpen(); }
 
+static FileEntryPtr FileEntryFromResultSet(wxSQLite3ResultSet& res)
+{
+    FileEntryPtr fe(new FileEntry());
+    fe->SetId(res.GetInt(0));
+    fe->SetFile(res.GetString(1));
+    fe->SetLastRetaggedTimestamp(res.GetInt(2));
+    fe->SetContentHash(res.GetString(3));
+    return fe;
+}
+
 void TagsStorageSQLite::GetFilesForCC(const wxString& userTyped, wxArrayString& matches)
 {
-    try {
-        wxString query;
-        wxString tmpName(userTyped);
-
-        // Files are kept in native format in the database
-        // so it only makes sense to search them with the correct path
-        // separator
-        tmpName.Replace("\\", "/");
-        tmpName.Replace("/", wxString() << wxFILE_SEP_PATH);
-        tmpName.Replace(wxT("_"), wxT("^_"));
-        query << wxT("select * from files where file like '%%") << tmpName << wxT("%%' ESCAPE '^' ")
-              << wxT("order by file");
+    wxArrayString files;
+    if(!userTyped.IsEmpty() && clFileNameIndex::Get().IsFor(m_fileName)) {
+        // Best matches first
+        clFileNameIndex::Get().Find(userTyped, clFileNameIndex::kFindDefault, 0, files);
 
-        wxString pattern = userTyped;
-        pattern.Replace("\\", "/");
+    } else {
+        try {
+            wxString query;
+            wxString tmpName(userTyped);
+
+            // Files are kept in native format in the database
+            // so it only makes sense to search them with the correct path
+            // separator
+            tmpName.Replace("\\", "/");
+            tmpName.Replace("/", wxString() << wxFILE_SEP_PATH);
+            tmpName.Replace(wxT("_"), wxT("^_"));
+            query << wxT("select * from files where file like '%%") << tmpName << wxT("%%' ESCAPE '^' ")
+                  << wxT("order by file");
+
+            wxSQLite3ResultSet res = m_db->ExecuteQuery(query);
+            while(res.NextRow()) {
+                files.Add(res.GetString(1));
+            }
 
-        wxSQLite3ResultSet res = m_db->ExecuteQuery(query);
-        while(res.NextRow()) {
-            // Keep the part from where the user typed and until the end of the file name
-            wxString matchedFile = res.GetString(1);
-            matchedFile.Replace("\\", "/");
-            
-            int where = matchedFile.Find(pattern);
-            if(where == wxNOT_FOUND) continue;
-            matchedFile = matchedFile.Mid(where);
-            matches.Add(matchedFile);
+        } catch(wxSQLite3Exception& e) {
+            wxUnusedVar(e);
         }
-        
-    } catch(wxSQLite3Exception& e) {
-        wxUnusedVar(e);
+    }
+
+    wxString pattern = userTyped;
+    pattern.Replace("\\", "/");
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        // Keep the part from where the user typed and until the end of the file name
+        wxString matchedFile = files.Item(i);
+        matchedFile.Replace("\\", "/");
+
+        int where = matchedFile.Find(pattern);
+        if(where == wxNOT_FOUND) continue;
+        matchedFile = matchedFile.Mid(where);
+        matches.Add(matchedFile);
     }
 }
 
@@ -406,20 +546,38 @@ void TagsStorageSQLite::GetFiles(const wxString& partialName, std::vector<FileEn
     try {
         bool match_path = (!partialName.IsEmpty() && partialName.Last() == wxFileName::GetPathSeparator());
 
-        wxString query;
-        wxString tmpName(partialName);
-        tmpName.Replace(wxT("_"), wxT("^_"));
-        query << wxT("select * from files where file like '%%") << tmpName << wxT("%%' ESCAPE '^' ")
-              << wxT("order by file");
+        std::vector<FileEntryPtr> candidates;
+        if(!partialName.IsEmpty() && clFileNameIndex::Get().IsFor(m_fileName)) {
+            // Fetch the entries of the files found in the index (the index may hold deleted files)
+            wxArrayString names;
+            clFileNameIndex::Get().Find(partialName, clFileNameIndex::kFindDefault, 0, names);
+            names.Sort();
+            wxSQLite3Statement& statement = m_db->GetPrepareStatement(wxT("select * from files where file=?"));
+            for(size_t i = 0; i < names.GetCount(); ++i) {
+                statement.Bind(1, names.Item(i));
+                wxSQLite3ResultSet res = statement.ExecuteQuery();
+                if(res.NextRow()) {
+                    candidates.push_back(FileEntryFromResultSet(res));
+                }
+                res.Finalize();
+                statement.Reset();
+            }
 
-        wxSQLite3ResultSet res = m_db->ExecuteQuery(query);
-        while(res.NextRow()) {
+        } else {
+            wxString query;
+            wxString tmpName(partialName);
+            tmpName.Replace(wxT("_"), wxT("^_"));
+            query << wxT("select * from files where file like '%%") << tmpName << wxT("%%' ESCAPE '^' ")
+                  << wxT("order by file");
 
-            FileEntryPtr fe(new FileEntry());
-            fe->SetId(res.GetInt(0));
-            fe->SetFile(res.GetString(1));
-            fe->SetLastRetaggedTimestamp(res.GetInt(2));
+            wxSQLite3ResultSet res = m_db->ExecuteQuery(query);
+            while(res.NextRow()) {
+                candidates.push_back(FileEntryFromResultSet(res));
+            }
+        }
 
+        for(size_t i = 0; i < candidates.size(); ++i) {
+            FileEntryPtr fe = candidates.at(i);
             wxFileName fileName(fe->GetFile());
             wxString match = match_path ? fileName.GetFullPath() : fileName.GetFullName();
 
@@ -459,6 +617,8 @@ void TagsStorageSQLite::DeleteByFilePrefix(const wxFileName& dbpath, const wxStr
 
         sql << wxT("delete from tags where file like '") << name << wxT("%%' ESCAPE '^' ");
         m_db->ExecuteUpdate(sql);
+        clSymbolIndex::Get().RemoveFilesByPrefix(m_fileName, filePrefix);
+        TagsStorageSQLiteCache::InvalidateAll();
 
     } catch(wxSQLite3Exception& e) {
         wxUnusedVar(e);
@@ -472,13 +632,7 @@ void TagsStorageSQLite::GetFiles(std::vector<FileEntryPtr>& files)
         wxSQLite3ResultSet res = m_db->ExecuteQuery(query);
 
         while(res.NextRow()) {
-
-            FileEntryPtr fe(new FileEntry());
-            fe->SetId(res.GetInt(0));
-            fe->SetFile(res.GetString(1));
-            fe->SetLastRetaggedTimestamp(res.GetInt(2));
-
-            files.push_back(fe);
+            files.push_back(FileEntryFromResultSet(res));
         }
 
     } catch(wxSQLite3Exception& e) {
@@ -505,6 +659,9 @@ void TagsStorageSQLite::DeleteFromFiles(const wxArrayString& files)
 
     try {
         m_db->ExecuteQuery(query);
+        if(clFileNameIndex::Get().IsFor(m_fileName)) {
+            clFileNameIndex::Get().RemoveFiles(files);
+        }
     } catch(wxSQLite3Exception& e) {
         wxUnusedVar(e);
     }
@@ -522,6 +679,9 @@ void TagsStorageSQLite::DeleteFromFilesByPrefix(const wxFileName& dbpath, const
 
         sql << wxT("delete from FILES where file like '") << name << wxT("%%' ESCAPE '^' ");
         m_db->ExecuteUpdate(sql);
+        if(clFileNameIndex::Get().IsFor(m_fileName)) {
+            clFileNameIndex::Get().RemoveFilesByPrefix(filePrefix);
+        }
 
     } catch(wxSQLite3Exception& e) {
         wxUnusedVar(e);
@@ -652,6 +812,13 @@ void TagsStorageSQLite::GetTagsByScopeAndName(const wxString& scope,
 {
     if(name.IsEmpty()) return;
 
+    clSymbolIndex::Query query;
+    query.name = name;
+    query.scopes.Add(scope.IsEmpty() ? wxString(wxT("<global>")) : scope);
+    DoPrepareIndexQuery(query, partialNameAllowed);
+    query.limit = GetSingleSearchLimit();
+    if(DoFetchTagsFromIndex(query, tags)) return;
+
     wxString sql;
     sql << wxT("select * from tags where ");
 
@@ -834,9 +1001,12 @@ void TagsStorageSQLite::GetTagsByKindAndFile(const wxArrayString& kind,
 int TagsStorageSQLite::DeleteFileEntry(const wxString& filename)
 {
     try {
-        wxSQLite3Statement statement = m_db->GetPrepareStatement(wxT("DELETE FROM FILES WHERE FILE=?"));
+        wxSQLite3Statement& statement = m_db->GetPrepareStatement(wxT("DELETE FROM FILES WHERE FILE=?"));
         statement.Bind(1, filename);
         statement.ExecuteUpdate();
+        if(clFileNameIndex::Get().IsFor(m_fileName)) {
+            clFileNameIndex::Get().RemoveFiles(wxArrayString(1, &filename));
+        }
 
     } catch(wxSQLite3Exception& exc) {
         if(exc.ErrorCodeAsString(exc.GetErrorCode()) == wxT("SQLITE_CONSTRAINT")) return TagExist;
@@ -845,14 +1015,18 @@ int TagsStorageSQLite::DeleteFileEntry(const wxString& filename)
     return TagOk;
 }
 
-int TagsStorageSQLite::InsertFileEntry(const wxString& filename, int timestamp)
+int TagsStorageSQLite::InsertFileEntry(const wxString& filename, int timestamp, const wxString& contentHash)
 {
     try {
-        wxSQLite3Statement statement =
-            m_db->GetPrepareStatement(wxT("INSERT OR REPLACE INTO FILES VALUES(NULL, ?, ?)"));
+        wxSQLite3Statement& statement =
+            m_db->GetPrepareStatement(wxT("INSERT OR REPLACE INTO FILES VALUES(NULL, ?, ?, ?)"));
         statement.Bind(1, filename);
         statement.Bind(2, timestamp);
+        statement.Bind(3, contentHash);
         statement.ExecuteUpdate();
+        if(clFileNameIndex::Get().IsFor(m_fileName)) {
+            clFileNameIndex::Get().AddFile(filename);
+        }
 
     } catch(wxSQLite3Exception& exc) {
         return TagError;
@@ -860,13 +1034,14 @@ int TagsStorageSQLite::InsertFileEntry(const wxString& filename, int timestamp)
     return TagOk;
 }
 
-int TagsStorageSQLite::UpdateFileEntry(const wxString& filename, int timestamp)
+int TagsStorageSQLite::UpdateFileEntry(const wxString& filename, int timestamp, const wxString& contentHash)
 {
     try {
-        wxSQLite3Statement statement =
-            m_db->GetPrepareStatement(wxT("UPDATE OR REPLACE FILES SET last_retagged=? WHERE file=?"));
+        wxSQLite3Statement& statement = m_db->GetPrepareStatement(
+            wxT("UPDATE OR REPLACE FILES SET last_retagged=?, content_hash=? WHERE file=?"));
         statement.Bind(1, timestamp);
-        statement.Bind(2, filename);
+        statement.Bind(2, contentHash);
+        statement.Bind(3, filename);
         statement.ExecuteUpdate();
 
     } catch(wxSQLite3Exception& exc) {
@@ -875,18 +1050,59 @@ int TagsStorageSQLite::UpdateFileEntry(const wxString& filename, int timestamp)
     return TagOk;
 }
 
+bool TagsStorageSQLite::RenameFile(const wxString& oldName, const wxString& newName)
+{
+    try {
+        // The tags and the macros of the file remain valid, only their file name changes
+        const wxChar* tables[] = { wxT("tags"), wxT("MACROS"), wxT("SIMPLE_MACROS"), wxT("FILES") };
+        for(size_t i = 0; i < sizeof(tables) / sizeof(tables[0]); ++i) {
+            wxString sql;
+            sql << wxT("UPDATE OR REPLACE ") << tables[i] << wxT(" SET file=? WHERE file=?");
+            wxSQLite3Statement& statement = m_db->GetPrepareStatement(sql);
+            statement.Bind(1, newName);
+            statement.Bind(2, oldName);
+            statement.ExecuteUpdate();
+        }
+
+        // Keep the symbol index and the tags cache in sync
+        clSymbolIndex::Get().RemoveFile(m_fileName, oldName);
+        if(clSymbolIndex::Get().IsOpen()) {
+            std::vector<clSymbolIndex::Symbol> symbols;
+            wxSQLite3Statement& statement =
+                m_db->GetPrepareStatement(wxT("SELECT ID, name, kind, scope FROM tags WHERE file=?"));
+            statement.Bind(1, newName);
+            wxSQLite3ResultSet rs = statement.ExecuteQuery();
+            while(rs.NextRow()) {
+                clSymbolIndex::Symbol symbol;
+                symbol.id = rs.GetInt64(0).GetValue();
+                symbol.name = rs.GetString(1);
+                symbol.kind = rs.GetString(2);
+                symbol.scope = rs.GetString(3);
+                symbol.file = newName;
+                symbols.push_back(symbol);
+            }
+            rs.Finalize();
+            clSymbolIndex::Get().AddSymbols(m_fileName, symbols);
+        }
+        if(clFileNameIndex::Get().IsFor(m_fileName)) {
+            clFileNameIndex::Get().RenameFile(oldName, newName);
+        }
+        TagsStorageSQLiteCache::FileDeleted(oldName);
+
+    } catch(wxSQLite3Exception& e) {
+        CL_WARNING("TagsStorageSQLite::RenameFile: %s", e.GetMessage());
+        return false;
+    }
+    return true;
+}
+
 int TagsStorageSQLite::DoInsertTagEntry(const TagEntry& tag)
 {
     // If this node is a dummy, (IsOk() == false) we dont insert it to database
     if(!tag.IsOk()) return TagOk;
 
-    // does not matter if we insert or update, the cache must be cleared for any related tags
-    if(GetUseCache()) {
-        ClearCache();
-    }
-
     try {
-        wxSQLite3Statement statement = m_db->GetPrepareStatement(
+        wxSQLite3Statement& statement = m_db->GetPrepareStatement(
             wxT("INSERT OR REPLACE INTO TAGS VALUES (NULL, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"));
         statement.Bind(1, tag.GetName());
         statement.Bind(2, tag.GetFile());
@@ -902,6 +1118,7 @@ int TagsStorageSQLite::DoInsertTagEntry(const TagEntry& tag)
         statement.Bind(12, tag.GetScope());
         statement.Bind(13, tag.GetReturnValue());
         statement.ExecuteUpdate();
+        if(m_bulkLoad) ++m_bulkLoadCount;
     } catch(wxSQLite3Exception& exc) {
         return TagError;
     }
@@ -1212,6 +1429,13 @@ void TagsStorageSQLite::GetTagsByScopeAndName(const wxArrayString& scope,
     }
 
     if(scopes.IsEmpty() == false) {
+        clSymbolIndex::Query query;
+        query.name = name;
+        query.scopes = scopes;
+        DoPrepareIndexQuery(query, partialNameAllowed);
+        query.limit = DoGetRemainingLimit(tags);
+        if(DoFetchTagsFromIndex(query, tags)) return;
+
         wxString sql;
         sql << wxT("select * from tags where scope in(");
 
@@ -1315,6 +1539,16 @@ void TagsStorageSQLite::GetTagsByKindLimit(const wxArrayString& kinds,
                                            const wxString& partName,
                                            std::vector<TagEntryPtr>& tags)
 {
+    // The index returns the tags in name order, use it only when no other order is requested
+    if(!partName.IsEmpty() && !kinds.IsEmpty() && orderingColumn.IsEmpty()) {
+        clSymbolIndex::Query query;
+        query.name = partName;
+        query.kinds = kinds;
+        DoPrepareIndexQuery(query, true);
+        query.limit = limit > 0 ? limit : 0;
+        if(DoFetchTagsFromIndex(query, tags)) return;
+    }
+
     wxString sql;
     sql << wxT("select * from tags where kind in (");
     for(size_t i = 0; i < kinds.GetCount(); i++) {
@@ -1387,9 +1621,320 @@ void TagsStorageSQLite::GetSubscriptOperator(const wxString& scope, std::vector<
 //-----------------------------TagsStorageSQLiteCache -----------------
 //---------------------------------------------------------------------
 
-TagsStorageSQLiteCache::TagsStorageSQLiteCache() {}
+// The default memory budget of a cache
+#define TAGS_CACHE_DEFAULT_MAX_BYTES (32 * 1024 * 1024)
+
+// Log the cache statistics every this number of lookups
+#define TAGS_CACHE_STATS_INTERVAL 1000
+
+// The number of new tags remembered to validate the cached queries, entries
+// older than these are dropped
+#define TAGS_CACHE_MAX_ADDED_TAGS 10000
+
+namespace
+{
+// A hash of the tag, excluding its location in the file
+size_t TagKeyHash(const TagEntry& tag)
+{
+    wxString str;
+    str << tag.GetName() << wxT("\n") << tag.GetKind() << wxT("\n") << tag.GetScope() << wxT("\n") << tag.GetPath()
+        << wxT("\n") << tag.GetSignature() << wxT("\n") << tag.GetTyperef() << wxT("\n") << tag.GetParent()
+        << wxT("\n") << tag.GetAccess() << wxT("\n") << tag.GetInheritsAsString() << wxT("\n")
+        << tag.GetReturnValue();
+    size_t hash = 2166136261u;
+    for(size_t i = 0; i < str.length(); ++i) {
+        hash = (hash ^ (size_t)str.at(i).GetValue()) * 16777619;
+    }
+    return hash;
+}
+
+/**
+ * @brief collect the string literals of a cached query.
+ * The values compared with the 'kind' column go to 'kinds', the other values go to 'words' (lower
+ * case, split at the LIKE wildcards). A tag returned by the query has one of these kinds and contains
+ * one of these words. Values that do not have to appear in the results (negations, upper bounds)
+ * are ignored, when nothing is left the query may return any tag
+ */
+void ParseQueryLiterals(const wxString& sql, wxArrayString& kinds, wxArrayString& words)
+{
+    wxString column;   // the last column name
+    wxString op;       // the operators and keywords seen after it
+    bool skipNext = false;
+    bool anyKind = false;
+    size_t i = 0;
+    while(i < sql.length()) {
+        wxChar ch = sql.at(i);
+        if(ch == wxT('\'')) {
+            // a string literal, '' is an escaped quote
+            wxString literal;
+            ++i;
+            while(i < sql.length()) {
+                if(sql.at(i) == wxT('\'')) {
+                    if(i + 1 < sql.length() && sql.at(i + 1) == wxT('\'')) {
+                        literal << wxT('\'');
+                        i += 2;
+                        continue;
+                    }
+                    break;
+                }
+                literal << sql.at(i);
+                ++i;
+            }
+            ++i;
 
-TagsStorageSQLiteCache::~TagsStorageSQLiteCache() { m_cache.clear(); }
+            if(skipNext) {
+                skipNext = false;
+                continue;
+            }
+            bool negated = op.Contains(wxT("not")) || op.Contains(wxT("!")) || op.Contains(wxT("<>"));
+            bool upperBound = op.StartsWith(wxT("<"));
+            literal.MakeLower();
+            if(column == wxT("kind")) {
+                if(negated) {
+                    anyKind = true;
+                } else {
+                    kinds.Add(literal);
+                }
+            } else if(!negated && !upperBound) {
+                literal.Replace(wxT("^"), wxT(""));
+                wxArrayString parts = ::wxStringTokenize(literal, wxT("%"), wxTOKEN_STRTOK);
+                for(size_t j = 0; j < parts.GetCount(); ++j) {
+                    words.Add(parts.Item(j));
+                }
+            }
+
+        } else if(wxIsalnum(ch) || ch == wxT('_')) {
+            wxString ident;
+            while(i < sql.length() && (wxIsalnum(sql.at(i)) || sql.at(i) == wxT('_'))) {
+                ident << sql.at(i);
+                ++i;
+            }
+            ident.MakeLower();
+            if(ident == wxT("escape")) {
+                skipNext = true;
+            } else if(ident == wxT("not") || ident == wxT("like") || ident == wxT("in") || ident == wxT("glob")) {
+                op << wxT(" ") << ident;
+            } else if(ident == wxT("and") || ident == wxT("or")) {
+                op.Clear();
+            } else {
+                column = ident;
+                op.Clear();
+            }
+
+        } else {
+            if(ch == wxT('=') || ch == wxT('<') || ch == wxT('>') || ch == wxT('!')) {
+                op << ch;
+            }
+            ++i;
+        }
+    }
+
+    if(anyKind) {
+        kinds.Clear();
+    }
+}
+
+/**
+ * @brief the file generations shared by all the caches
+ */
+class TagsCacheGenerations
+{
+    struct FileInfo {
+        size_t generation;
+        std::vector<size_t> tags; // the sorted TagKeyHash() of the stored tags
+        bool hasTags;
+
+        FileInfo()
+            : generation(0)
+            , hasTags(false)
+        {
+        }
+    };
+
+    // A tag that was not stored before
+    struct AddedTag {
+        wxString kind;
+        wxString text; // the (lower case) values of the other columns
+    };
+
+    std::map<wxString, FileInfo> m_files;
+    std::deque<AddedTag> m_addedTags;
+    size_t m_addedBase; // the sequence number of m_addedTags.front()
+    size_t m_globalGeneration;
+    size_t m_dbGeneration; // bumped on every change
+    wxCriticalSection m_cs;
+
+    void DoAddTag(const TagEntry& tag)
+    {
+        AddedTag added;
+        added.kind = tag.GetKind().Lower();
+        added.text << tag.GetName() << wxT("\n") << tag.GetScope() << wxT("\n") << tag.GetPath() << wxT("\n")
+                   << tag.GetFile() << wxT("\n") << tag.GetParent() << wxT("\n") << tag.GetTyperef() << wxT("\n")
+                   << tag.GetSignature() << wxT("\n") << tag.GetAccess() << wxT("\n")
+                   << tag.GetInheritsAsString() << wxT("\n") << tag.GetReturnValue();
+        added.text.MakeLower();
+        m_addedTags.push_back(added);
+        if(m_addedTags.size() > TAGS_CACHE_MAX_ADDED_TAGS) {
+            m_addedTags.pop_front();
+            m_addedBase++;
+        }
+    }
+
+    static bool Matches(const AddedTag& tag, const wxArrayString& kinds, const wxArrayString& words)
+    {
+        if(!kinds.IsEmpty() && kinds.Index(tag.kind) == wxNOT_FOUND) return false;
+        if(words.IsEmpty()) return true;
+        for(size_t i = 0; i < words.GetCount(); ++i) {
+            if(tag.text.Contains(words.Item(i))) return true;
+        }
+        return false;
+    }
+
+public:
+    TagsCacheGenerations()
+        : m_addedBase(0)
+        , m_globalGeneration(0)
+        , m_dbGeneration(0)
+    {
+    }
+
+    static TagsCacheGenerations& Get()
+    {
+        static TagsCacheGenerations theGenerations;
+        return theGenerations;
+    }
+
+    void FileDeleted(const wxString& file)
+    {
+        wxCriticalSectionLocker locker(m_cs);
+        // keep the tags: the file is usually stored again right after
+        m_files[file].generation++;
+        m_dbGeneration++;
+    }
+
+    void FileStored(const wxString& file, const std::vector<const TagEntry*>& tags)
+    {
+        std::vector<size_t> hashes;
+        hashes.reserve(tags.size());
+        for(size_t i = 0; i < tags.size(); ++i) {
+            hashes.push_back(TagKeyHash(*tags.at(i)));
+        }
+
+        wxCriticalSectionLocker locker(m_cs);
+        FileInfo& info = m_files[file];
+        info.generation++;
+        m_dbGeneration++;
+
+        // The queries that returned tags of this file are stale now, the new tags
+        // may be returned by other queries too
+        for(size_t i = 0; i < tags.size(); ++i) {
+            if(!info.hasTags || !std::binary_search(info.tags.begin(), info.tags.end(), hashes.at(i))) {
+                DoAddTag(*tags.at(i));
+            }
+        }
+        std::sort(hashes.begin(), hashes.end());
+        info.tags.swap(hashes);
+        info.hasTags = true;
+    }
+
+    void InvalidateAll()
+    {
+        wxCriticalSectionLocker locker(m_cs);
+        m_globalGeneration++;
+        m_dbGeneration++;
+    }
+
+    size_t GetDbGeneration()
+    {
+        wxCriticalSectionLocker locker(m_cs);
+        return m_dbGeneration;
+    }
+
+    /**
+     * @brief collect the current generation of the files of 'tags'
+     */
+    void GetFilesGenerations(const std::vector<TagEntryPtr>& tags,
+                             std::vector<std::pair<wxString, size_t> >& files,
+                             size_t& globalGeneration,
+                             size_t& addedSequence)
+    {
+        std::set<wxString> uniqueFiles;
+        for(size_t i = 0; i < tags.size(); ++i) {
+            uniqueFiles.insert(tags.at(i)->GetFile());
+        }
+
+        wxCriticalSectionLocker locker(m_cs);
+        globalGeneration = m_globalGeneration;
+        addedSequence = m_addedBase + m_addedTags.size();
+        files.reserve(uniqueFiles.size());
+        std::set<wxString>::const_iterator iter = uniqueFiles.begin();
+        for(; iter != uniqueFiles.end(); ++iter) {
+            std::map<wxString, FileInfo>::const_iterator fileIter = m_files.find(*iter);
+            files.push_back(std::make_pair(*iter, fileIter == m_files.end() ? 0 : fileIter->second.generation));
+        }
+    }
+
+    /**
+     * @brief return true if the cached results are still valid.
+     * 'addedSequence' is advanced past the new tags checked by this call
+     */
+    bool IsUpToDate(const std::vector<std::pair<wxString, size_t> >& files,
+                    size_t globalGeneration,
+                    size_t& addedSequence,
+                    const wxArrayString& kinds,
+                    const wxArrayString& words,
+                    bool matchesNewTags)
+    {
+        wxCriticalSectionLocker locker(m_cs);
+        if(globalGeneration != m_globalGeneration) return false;
+        for(size_t i = 0; i < files.size(); ++i) {
+            std::map<wxString, FileInfo>::const_iterator iter = m_files.find(files.at(i).first);
+            size_t generation = (iter == m_files.end()) ? 0 : iter->second.generation;
+            if(generation != files.at(i).second) return false;
+        }
+
+        if(matchesNewTags) {
+            // too many tags were added since the entry was validated
+            if(addedSequence < m_addedBase) return false;
+            for(size_t i = addedSequence - m_addedBase; i < m_addedTags.size(); ++i) {
+                if(Matches(m_addedTags.at(i), kinds, words)) return false;
+            }
+        }
+        addedSequence = m_addedBase + m_addedTags.size();
+        return true;
+    }
+};
+
+size_t EstimateTagBytes(const TagEntryPtr& tag)
+{
+    size_t chars = tag->GetName().length() + tag->GetFile().length() + tag->GetKind().length() +
+                   tag->GetAccess().length() + tag->GetSignature().length() + tag->GetPattern().length() +
+                   tag->GetParent().length() + tag->GetPath().length() + tag->GetTyperef().length() +
+                   tag->GetScope().length() + tag->GetReturnValue().length();
+    return sizeof(TagEntry) + chars * sizeof(wxChar);
+}
+}
+
+wxString TagsStorageSQLiteCache::Statistics::ToString() const
+{
+    size_t lookups = hits + misses;
+    return wxString::Format(wxT("hits: %u, misses: %u (%.1f%% hit rate), evictions: %u, invalidations: %u, ")
+                                wxT("entries: %u, size: %u KB"),
+                            (unsigned int)hits,
+                            (unsigned int)misses,
+                            lookups ? (100.0 * (double)hits / (double)lookups) : 0.0,
+                            (unsigned int)evictions,
+                            (unsigned int)invalidations,
+                            (unsigned int)entries,
+                            (unsigned int)(bytes / 1024));
+}
+
+TagsStorageSQLiteCache::TagsStorageSQLiteCache()
+    : m_maxBytes(TAGS_CACHE_DEFAULT_MAX_BYTES)
+{
+}
+
+TagsStorageSQLiteCache::~TagsStorageSQLiteCache() { Clear(); }
 
 bool TagsStorageSQLiteCache::Get(const wxString& sql, std::vector<TagEntryPtr>& tags) { return DoGet(sql, tags); }
 
@@ -1404,12 +1949,18 @@ bool TagsStorageSQLiteCache::Get(const wxString& sql, const wxArrayString& kind,
     return DoGet(key, tags);
 }
 
-void TagsStorageSQLiteCache::Store(const wxString& sql, const std::vector<TagEntryPtr>& tags) { DoStore(sql, tags); }
+void TagsStorageSQLiteCache::Store(const wxString& sql, const std::vector<TagEntryPtr>& tags)
+{
+    DoStore(sql, sql, wxArrayString(), tags);
+}
 
 void TagsStorageSQLiteCache::Clear()
 {
     CL_DEBUG1(wxT("[CACHE CLEARED]"));
-    m_cache.clear();
+    m_entries.clear();
+    m_lru.clear();
+    m_stats.entries = 0;
+    m_stats.bytes = 0;
 }
 
 void TagsStorageSQLiteCache::Store(const wxString& sql, const wxArrayString& kind, const std::vector<TagEntryPtr>& tags)
@@ -1419,27 +1970,125 @@ void TagsStorageSQLiteCache::Store(const wxString& sql, const wxArrayString& kin
     for(size_t i = 0; i < kind.GetCount(); i++) {
         key << wxT("@") << kind.Item(i);
     }
-    DoStore(key, tags);
+    DoStore(key, sql, kind, tags);
+}
+
+void TagsStorageSQLiteCache::SetMaxBytes(size_t maxBytes)
+{
+    m_maxBytes = maxBytes;
+    DoEvict();
 }
 
 bool TagsStorageSQLiteCache::DoGet(const wxString& key, std::vector<TagEntryPtr>& tags)
 {
-    std::map<wxString, std::vector<TagEntryPtr> >::iterator iter = m_cache.find(key);
-    if(iter != m_cache.end()) {
-        // Append the results to the output tags
-        tags.insert(tags.end(), iter->second.begin(), iter->second.end());
-        return true;
+    if(((m_stats.hits + m_stats.misses + 1) % TAGS_CACHE_STATS_INTERVAL) == 0) {
+        CL_DEBUG(wxT("Tags cache: %s"), m_stats.ToString());
     }
-    return false;
+
+    std::map<wxString, CacheList_t::iterator>::iterator iter = m_entries.find(key);
+    if(iter == m_entries.end()) {
+        m_stats.misses++;
+        return false;
+    }
+
+    CacheList_t::iterator entry = iter->second;
+    if(!TagsCacheGenerations::Get().IsUpToDate(entry->files,
+                                                entry->globalGeneration,
+                                                entry->addedSequence,
+                                                entry->kinds,
+                                                entry->words,
+                                                entry->matchesNewTags)) {
+        DoErase(entry);
+        m_stats.invalidations++;
+        m_stats.misses++;
+        return false;
+    }
+
+    // Move the entry to the front of the LRU list
+    m_lru.splice(m_lru.begin(), m_lru, entry);
+    m_stats.hits++;
+
+    // Append the results to the output tags
+    tags.insert(tags.end(), entry->tags.begin(), entry->tags.end());
+    return true;
 }
 
-void TagsStorageSQLiteCache::DoStore(const wxString& key, const std::vector<TagEntryPtr>& tags)
+void TagsStorageSQLiteCache::DoStore(const wxString& key,
+                                     const wxString& sql,
+                                     const wxArrayString& kinds,
+                                     const std::vector<TagEntryPtr>& tags)
+{
+    std::map<wxString, CacheList_t::iterator>::iterator iter = m_entries.find(key);
+    if(iter != m_entries.end()) {
+        DoErase(iter->second);
+    }
+
+    CacheEntry entry;
+    entry.key = key;
+    entry.tags = tags;
+    entry.bytes = sizeof(CacheEntry) + key.length() * sizeof(wxChar);
+    for(size_t i = 0; i < tags.size(); ++i) {
+        entry.bytes += EstimateTagBytes(tags.at(i));
+    }
+
+    // Do not let a single result take over the whole cache
+    if(entry.bytes > m_maxBytes / 4) return;
+
+    TagsCacheGenerations::Get().GetFilesGenerations(tags, entry.files, entry.globalGeneration, entry.addedSequence);
+
+    // What the new tags must match to be part of the results. The results of a lookup by
+    // tag IDs (see DoFetchTagsFromIndex) can not change with new tags
+    ParseQueryLiterals(sql, entry.kinds, entry.words);
+    for(size_t i = 0; i < kinds.GetCount(); ++i) {
+        entry.kinds.Add(kinds.Item(i).Lower());
+    }
+    entry.matchesNewTags = !(entry.words.IsEmpty() && sql.Lower().Contains(wxT("where id in (")));
+    for(size_t i = 0; i < entry.words.GetCount(); ++i) {
+        entry.bytes += entry.words.Item(i).length() * sizeof(wxChar);
+    }
+
+    m_lru.push_front(entry);
+    m_entries.insert(std::make_pair(key, m_lru.begin()));
+    m_stats.entries++;
+    m_stats.bytes += entry.bytes;
+    DoEvict();
+}
+
+void TagsStorageSQLiteCache::DoErase(CacheList_t::iterator iter)
+{
+    m_stats.entries--;
+    m_stats.bytes -= iter->bytes;
+    m_entries.erase(iter->key);
+    m_lru.erase(iter);
+}
+
+void TagsStorageSQLiteCache::DoEvict()
+{
+    while(m_stats.bytes > m_maxBytes && !m_lru.empty()) {
+        CacheList_t::iterator last = m_lru.end();
+        --last;
+        DoErase(last);
+        m_stats.evictions++;
+    }
+}
+
+void TagsStorageSQLiteCache::FileDeleted(const wxString& file) { TagsCacheGenerations::Get().FileDeleted(file); }
+
+void TagsStorageSQLiteCache::FileStored(const wxString& file, const std::vector<const TagEntry*>& tags)
 {
-    m_cache[key].reserve(tags.size());
-    m_cache[key] = tags;
+    TagsCacheGenerations::Get().FileStored(file, tags);
 }
 
-void TagsStorageSQLite::ClearCache() { m_cache.Clear(); }
+void TagsStorageSQLiteCache::InvalidateAll() { TagsCacheGenerations::Get().InvalidateAll(); }
+
+size_t TagsStorageSQLiteCache::GetDbGeneration() { return TagsCacheGenerations::Get().GetDbGeneration(); }
+
+void TagsStorageSQLite::ClearCache()
+{
+    m_cache.Clear();
+    // the caches of the other storage objects are not valid either
+    TagsStorageSQLiteCache::InvalidateAll();
+}
 
 void TagsStorageSQLite::SetUseCache(bool useCache) { ITagsStorage::SetUseCache(useCache); }
 
@@ -1464,9 +2113,9 @@ PPToken TagsStorageSQLite::GetMacro(const wxString& name)
 void TagsStorageSQLite::StoreMacros(const std::map<wxString, PPToken>& table)
 {
     try {
-        wxSQLite3Statement stmntCC =
+        wxSQLite3Statement& stmntCC =
             m_db->GetPrepareStatement(wxT("insert or replace into MACROS values(NULL, ?, ?, ?, ?, ?, ?)"));
-        wxSQLite3Statement stmntSimple =
+        wxSQLite3Statement& stmntSimple =
             m_db->GetPrepareStatement(wxT("insert or replace into SIMPLE_MACROS values(NULL, ?, ?)"));
 
         std::map<wxString, PPToken>::const_iterator iter = table.begin();
@@ -1553,6 +2202,12 @@ void TagsStorageSQLite::GetTagsByName(const wxString& prefix, std::vector<TagEnt
     try {
         if(prefix.IsEmpty()) return;
 
+        clSymbolIndex::Query query;
+        query.name = prefix;
+        DoPrepareIndexQuery(query, !exactMatch);
+        query.limit = DoGetRemainingLimit(tags);
+        if(DoFetchTagsFromIndex(query, tags)) return;
+
         wxString sql;
         sql << wxT("select * from tags where ");
         DoAddNamePartToQuery(sql, prefix, !exactMatch, false);
@@ -1597,12 +2252,59 @@ void TagsStorageSQLite::DoAddNamePartToQuery(wxString& sql, const wxString& name
 }
 
 void TagsStorageSQLite::DoAddLimitPartToQuery(wxString& sql, const std::vector<TagEntryPtr>& tags)
+{
+    sql << wxT(" LIMIT ") << DoGetRemainingLimit(tags) << wxT(" ");
+}
+
+size_t TagsStorageSQLite::DoGetRemainingLimit(const std::vector<TagEntryPtr>& tags)
 {
     if(tags.size() >= (size_t)GetSingleSearchLimit()) {
-        sql << wxT(" LIMIT 1 ");
-    } else {
-        sql << wxT(" LIMIT ") << (size_t)GetSingleSearchLimit() - tags.size();
+        return 1;
     }
+    return (size_t)GetSingleSearchLimit() - tags.size();
+}
+
+void TagsStorageSQLite::DoPrepareIndexQuery(clSymbolIndex::Query& query, bool partial)
+{
+    // Same semantic as DoAddNamePartToQuery(): exact matches are always case sensitive
+    query.match = partial ? clSymbolIndex::kMatchPrefix : clSymbolIndex::kMatchExact;
+    query.matchCase = partial ? !m_enableCaseInsensitive : true;
+}
+
+bool TagsStorageSQLite::DoFetchTagsFromIndex(const clSymbolIndex::Query& query, std::vector<TagEntryPtr>& tags)
+{
+    // The index may return IDs of tags that are no longer in the database: the limit
+    // is applied to the fetched tags, not to the IDs
+    clSymbolIndex::Query allQuery = query;
+    allQuery.limit = 0;
+
+    std::vector<wxInt64> ids;
+    if(!clSymbolIndex::Get().Find(m_fileName, allQuery, ids)) return false;
+
+    // Fetch the tags by their IDs, in batches so we can stop once we have enough
+    size_t remaining = query.limit;
+    for(size_t first = 0; first < ids.size(); first += TAGS_FETCH_BY_ID_BATCH) {
+        size_t last = std::min(ids.size(), first + TAGS_FETCH_BY_ID_BATCH);
+        wxString sql;
+        sql << wxT("select * from tags where ID IN (");
+        for(size_t i = first; i < last; ++i) {
+            sql << wxLongLong(ids.at(i)).ToString() << wxT(",");
+        }
+        sql.RemoveLast();
+        sql << wxT(")");
+        if(query.limit) {
+            sql << wxT(" LIMIT ") << remaining;
+        }
+
+        std::vector<TagEntryPtr> batch;
+        DoFetchTags(sql, batch);
+        tags.insert(tags.end(), batch.begin(), batch.end());
+        if(query.limit) {
+            remaining -= std::min(remaining, batch.size());
+            if(remaining == 0) break;
+        }
+    }
+    return true;
 }
 
 TagEntryPtr TagsStorageSQLite::GetTagsByNameLimitOne(const wxString& name)
@@ -1611,6 +2313,14 @@ TagEntryPtr TagsStorageSQLite::GetTagsByNameLimitOne(const wxString& name)
         if(name.IsEmpty()) return NULL;
 
         std::vector<TagEntryPtr> tags;
+        clSymbolIndex::Query query;
+        query.name = name;
+        DoPrepareIndexQuery(query, false);
+        query.limit = 1;
+        if(DoFetchTagsFromIndex(query, tags)) {
+            return tags.size() == 1 ? tags.at(0) : TagEntryPtr(NULL);
+        }
+
         wxString sql;
         sql << wxT("select * from tags where ");
         DoAddNamePartToQuery(sql, name, false, false);
@@ -1633,6 +2343,13 @@ void TagsStorageSQLite::GetTagsByPartName(const wxString& partname, std::vector<
     try {
         if(partname.IsEmpty()) return;
 
+        // LIKE is case insensitive
+        clSymbolIndex::Query query;
+        query.name = partname;
+        query.match = clSymbolIndex::kMatchSubstring;
+        query.limit = DoGetRemainingLimit(tags);
+        if(DoFetchTagsFromIndex(query, tags)) return;
+
         wxString tmpName(partname);
         tmpName.Replace(wxT("_"), wxT("^_"));
 
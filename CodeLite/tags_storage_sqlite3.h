@@ -26,14 +26,17 @@
 #define CODELITE_TAGS_DATABASE_H
 
 #include "tag_tree.h"
+#include <list>
+#include <map>
 #include "entry.h"
 #include <wx/filename.h>
 #include "fileentry.h"
 #include "istorage.h"
 #include <wx/wxsqlite3.h>
 #include "codelite_exports.h"
+#include "clSymbolIndex.h"
 
-const wxString gTagsDatabaseVersion(wxT("CodeLite Version 7.0"));
+const wxString gTagsDatabaseVersion(wxT("CodeLite Version 7.1"));
 
 /**
  * TagsDatabase is a wrapper around wxSQLite3 database with tags specific functions.
@@ -88,12 +91,64 @@ const wxString gTagsDatabaseVersion(wxT("CodeLite Version 7.0"));
  * @ingroup CodeLite
  */
 
+/**
+ * @class TagsStorageSQLiteCache
+ * @brief a bounded LRU cache of query results, keyed by the SQL text.
+ * Every entry remembers the generation of the files its tags come from. Storing or deleting the
+ * tags of a file bumps the file generation, which makes the entries touching this file stale.
+ * Tags that were not stored for the file before (new symbols) may be returned by queries that did not
+ * touch the file: they are recorded and an entry is stale if one of them matches the strings its query
+ * searches for (e.g. the name prefix or the scope).
+ * The generations are shared by all the caches of the process (the parser thread and the main thread use
+ * different storage objects)
+ */
 class TagsStorageSQLiteCache
 {
-    std::map<wxString, std::vector<TagEntryPtr> > m_cache;
+public:
+    struct Statistics {
+        size_t hits;
+        size_t misses;
+        size_t evictions;     // entries dropped to keep the cache within its memory budget
+        size_t invalidations; // stale entries dropped
+        size_t entries;
+        size_t bytes;
+
+        Statistics()
+            : hits(0)
+            , misses(0)
+            , evictions(0)
+            , invalidations(0)
+            , entries(0)
+            , bytes(0)
+        {
+        }
+        wxString ToString() const;
+    };
+
+protected:
+    struct CacheEntry {
+        wxString key;
+        std::vector<TagEntryPtr> tags;
+        std::vector<std::pair<wxString, size_t> > files; // file name and its generation
+        size_t globalGeneration;
+        size_t addedSequence;  // the new tags recorded before the entry was last validated
+        wxArrayString kinds;   // the kinds the query is restricted to, empty for any kind
+        wxArrayString words;   // the query matches tags containing one of these, empty for any tag
+        bool matchesNewTags;   // false for lookups by tag ID
+        size_t bytes;
+    };
+    typedef std::list<CacheEntry> CacheList_t;
+
+    CacheList_t m_lru; // most recently used first
+    std::map<wxString, CacheList_t::iterator> m_entries;
+    size_t m_maxBytes;
+    Statistics m_stats;
+
 protected:
     bool DoGet  (const wxString &key, std::vector<TagEntryPtr> &tags);
-    void DoStore(const wxString &key, const std::vector<TagEntryPtr> &tags);
+    void DoStore(const wxString &key, const wxString &sql, const wxArrayString &kinds, const std::vector<TagEntryPtr> &tags);
+    void DoErase(CacheList_t::iterator iter);
+    void DoEvict();
 
 public:
     TagsStorageSQLiteCache();
@@ -104,6 +159,38 @@ public:
     void Store(const wxString &sql, const std::vector<TagEntryPtr> &tags);
     void Store(const wxString &sql, const wxArrayString &kind, const std::vector<TagEntryPtr> &tags);
     void Clear();
+
+    /**
+     * @brief set the memory budget of the cache (an estimation of the memory used by the cached tags)
+     */
+    void SetMaxBytes(size_t maxBytes);
+    size_t GetMaxBytes() const {
+        return m_maxBytes;
+    }
+    const Statistics& GetStatistics() const {
+        return m_stats;
+    }
+
+    /**
+     * @brief the tags of 'file' were deleted
+     */
+    static void FileDeleted(const wxString& file);
+
+    /**
+     * @brief tags were stored for 'file'
+     */
+    static void FileStored(const wxString& file, const std::vector<const TagEntry*>& tags);
+
+    /**
+     * @brief make all the cached entries (of all the caches) stale
+     */
+    static void InvalidateAll();
+
+    /**
+     * @brief a counter incremented whenever tags are stored or deleted (in any database of the process).
+     * Code that keeps results derived from the database can compare it to know if they are still valid
+     */
+    static size_t GetDbGeneration();
 };
 
 class WXDLLIMPEXP_CL clSqliteDB : public wxSQLite3Database
@@ -115,14 +202,29 @@ public:
     }
 
     void Close() {
+        // finalize the cached statements before closing the connection
+        m_statements.clear();
+
         if (IsOpen())
             wxSQLite3Database::Close();
-
-        m_statements.clear();
     }
 
-    wxSQLite3Statement GetPrepareStatement(const wxString& sql) {
-        return wxSQLite3Database::PrepareStatement(sql);
+    /**
+     * @brief return a prepared statement for 'sql'. The statement is compiled on the first call
+     * and kept by the database for later calls, so the caller must hold it by reference.
+     * The returned statement is reset and ready to be bound
+     */
+    wxSQLite3Statement& GetPrepareStatement(const wxString& sql) {
+        std::map<wxString, wxSQLite3Statement>::iterator iter = m_statements.find(sql);
+        if(iter != m_statements.end()) {
+            iter->second.Reset();
+            return iter->second;
+        }
+
+        // wxSQLite3Statement assignment transfers the ownership of the compiled statement
+        wxSQLite3Statement& statement = m_statements[sql];
+        statement = wxSQLite3Database::PrepareStatement(sql);
+        return statement;
     }
 };
 
@@ -130,6 +232,9 @@ class WXDLLIMPEXP_CL TagsStorageSQLite : public ITagsStorage
 {
     clSqliteDB             *m_db;
     TagsStorageSQLiteCache  m_cache;
+    bool                    m_bulkLoad;
+    int                     m_bulkLoadCacheSize;
+    size_t                  m_bulkLoadCount;
 
 private:
     /**
@@ -148,8 +253,25 @@ private:
 
     void DoAddNamePartToQuery(wxString &sql, const wxString &name, bool partial, bool prependAnd);
     void DoAddLimitPartToQuery(wxString &sql, const std::vector<TagEntryPtr> &tags);
+    size_t DoGetRemainingLimit(const std::vector<TagEntryPtr> &tags);
+
+    /**
+     * @brief set the match type of a symbol index query for a name lookup
+     */
+    void DoPrepareIndexQuery(clSymbolIndex::Query &query, bool partial);
+
+    /**
+     * @brief run 'query' on the symbol index and fetch the matching tags by ID
+     * @return false if the symbol index is not loaded for this database
+     */
+    bool DoFetchTagsFromIndex(const clSymbolIndex::Query &query, std::vector<TagEntryPtr> &tags);
     int  DoInsertTagEntry( const TagEntry &tag );
 
+    /**
+     * @brief create the 'tags_insert' trigger and the search indexes of the TAGS table
+     */
+    void DoCreateTagsIndexes();
+
 public:
     static TagEntry *FromSQLite3ResultSet(wxSQLite3ResultSet &rs);
     static void      PPTokenFromSQlite3ResultSet(wxSQLite3ResultSet &rs, PPToken &token);
@@ -284,6 +406,18 @@ public:
         return m_db->Rollback();
     }
 
+    /**
+     * @brief enlarge the page cache of the connection so a large number of tags
+     * can be stored quickly. The indexes and triggers are kept
+     */
+    void BeginBulkLoad();
+
+    /**
+     * @brief restore the page cache size changed by BeginBulkLoad()
+     * @return number of tags stored since BeginBulkLoad()
+     */
+    size_t EndBulkLoad();
+
     /**
      * Test whether the database is opened
      * @return true if database is attached to a file
@@ -486,17 +620,25 @@ public:
     /**
      * @brief insert entry by file name
      * @param filename
+     * @param timestamp retag timestamp
+     * @param contentHash the hash of the parsed content
      * @return
      */
-    virtual int InsertFileEntry ( const wxString &filename, int timestamp );
+    virtual int InsertFileEntry ( const wxString &filename, int timestamp, const wxString& contentHash );
 
     /**
     * @brief update file entry using file name as key
     * @param filename
     * @param timestamp new timestamp
+    * @param contentHash the hash of the parsed content
     * @return
     */
-    virtual int UpdateFileEntry ( const wxString &filename , int timestamp );
+    virtual int UpdateFileEntry ( const wxString &filename , int timestamp, const wxString& contentHash );
+
+    /**
+     * @brief move the tags, the macros and the file entry of 'oldName' to 'newName'
+     */
+    virtual bool RenameFile ( const wxString &oldName, const wxString &newName );
 
     /**
      * @brief return true if type exist under a given scope.
@@ -532,10 +674,17 @@ public:
     virtual void GetScopesFromFileAsc(const wxFileName &fileName, std::vector< wxString > &scopes);
 
     /**
-     * @brief
+     * @brief clear the cache and make the cached entries of the other storage objects stale
      */
     virtual void ClearCache();
 
+    /**
+     * @brief the query results cache. Use it to tune the cache memory budget or to read its statistics
+     */
+    TagsStorageSQLiteCache& GetCache() {
+        return m_cache;
+    }
+
     /**
      * @brief
      * @param fileName
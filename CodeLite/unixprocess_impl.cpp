@@ -24,6 +24,7 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "unixprocess_impl.h"
+#include "unixprocess_reactor.h"
 #include "file_logger.h"
 
 #if defined(__WXMAC__) || defined(__WXGTK__)
@@ -286,6 +287,8 @@ UnixProcessImpl::~UnixProcessImpl() { Cleanup(); }
 
 void UnixProcessImpl::Cleanup()
 {
+    // Stop reading before the handles are closed
+    UnixProcessReactor::Remove(this);
     close(GetReadHandle());
     close(GetWriteHandle());
 
@@ -443,6 +446,11 @@ IProcess* UnixProcessImpl::Execute(
 
 void UnixProcessImpl::StartReaderThread()
 {
+    // The output of the process is read by the reactor thread, shared by all the processes
+    if(UnixProcessReactor::Add(this, GetReadHandle(), m_parent)) {
+        return;
+    }
+
     // Launch the 'Reader' thread
     m_thr = new ProcessReaderThread();
     m_thr->SetProcess(this);
@@ -470,6 +478,7 @@ bool UnixProcessImpl::WriteToConsole(const wxString& buff)
 
 void UnixProcessImpl::Detach()
 {
+    UnixProcessReactor::Remove(this);
     if(m_thr) {
         // Stop the reader thread
         m_thr->Stop();
@@ -0,0 +1,437 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : unixprocess_reactor.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "unixprocess_reactor.h"
+
+#if defined(__WXMAC__) || defined(__WXGTK__)
+#include "asyncprocess.h"
+#include "processreaderthread.h"
+#include "file_logger.h"
+#include <wx/module.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#define USE_EPOLL 1
+#endif
+
+// Size of a single read
+#define REACTOR_READ_SIZE (64 * 1024)
+
+// Max amount of output delivered in a single event
+#define REACTOR_MAX_EVENT_SIZE (1024 * 1024)
+
+// The ID of the wakeup pipe in the epoll set, the watches IDs start at 1
+#define REACTOR_WAKEUP_ID 0
+
+static UnixProcessReactor* gs_reactor = NULL;
+static bool gs_reactorStopped = false;
+
+static wxMutex& GetReactorMutex()
+{
+    static wxMutex mutex;
+    return mutex;
+}
+
+// Stop the reactor thread before the library is unloaded
+class UnixProcessReactorModule : public wxModule
+{
+public:
+    virtual bool OnInit() { return true; }
+    virtual void OnExit() { UnixProcessReactor::Stop(); }
+
+    DECLARE_DYNAMIC_CLASS(UnixProcessReactorModule)
+};
+IMPLEMENT_DYNAMIC_CLASS(UnixProcessReactorModule, wxModule)
+
+UnixProcessReactor::UnixProcessReactor()
+    : wxThread(wxTHREAD_JOINABLE)
+    , m_nextId(1)
+    , m_pollFd(-1)
+    , m_ok(false)
+    , m_stop(false)
+{
+    m_wakeupPipe[0] = m_wakeupPipe[1] = -1;
+    if(pipe(m_wakeupPipe) == 0) {
+        fcntl(m_wakeupPipe[0], F_SETFL, O_NONBLOCK);
+        fcntl(m_wakeupPipe[1], F_SETFL, O_NONBLOCK);
+        m_ok = true;
+    }
+#ifdef USE_EPOLL
+    m_pollFd = m_ok ? epoll_create(16) : -1;
+    if(m_pollFd != -1) {
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.u64 = REACTOR_WAKEUP_ID;
+        m_ok = (epoll_ctl(m_pollFd, EPOLL_CTL_ADD, m_wakeupPipe[0], &event) == 0);
+    } else {
+        m_ok = false;
+    }
+#endif
+}
+
+UnixProcessReactor::~UnixProcessReactor()
+{
+    if(m_pollFd != -1) {
+        close(m_pollFd);
+    }
+    for(size_t i = 0; i < 2; ++i) {
+        if(m_wakeupPipe[i] != -1) {
+            close(m_wakeupPipe[i]);
+        }
+    }
+}
+
+UnixProcessReactor* UnixProcessReactor::DoCreate()
+{
+    UnixProcessReactor* reactor = new UnixProcessReactor();
+    if(reactor->m_ok) {
+        reactor->m_ok = (reactor->Create() == wxTHREAD_NO_ERROR) && (reactor->Run() == wxTHREAD_NO_ERROR);
+    }
+
+    if(!reactor->m_ok) {
+        CL_WARNING("UnixProcessReactor: failed to start, using a reader thread per process");
+    }
+    return reactor;
+}
+
+UnixProcessReactor* UnixProcessReactor::DoGet(bool create)
+{
+    // The reactor is never deleted: a stopped reactor keeps refusing new processes
+    wxMutexLocker locker(GetReactorMutex());
+    if(!gs_reactor && create && !gs_reactorStopped) {
+        gs_reactor = DoCreate();
+    }
+    return gs_reactor;
+}
+
+void UnixProcessReactor::Stop()
+{
+    UnixProcessReactor* reactor = NULL;
+    {
+        wxMutexLocker locker(GetReactorMutex());
+        gs_reactorStopped = true;
+        reactor = gs_reactor;
+    }
+    if(reactor) {
+        reactor->DoStop();
+    }
+}
+
+bool UnixProcessReactor::Add(IProcess* process, int fd, wxEvtHandler* parent)
+{
+    UnixProcessReactor* reactor = DoGet(true);
+    return reactor && reactor->DoAdd(process, fd, parent);
+}
+
+void UnixProcessReactor::Remove(IProcess* process)
+{
+    UnixProcessReactor* reactor = DoGet(false);
+    if(reactor) {
+        reactor->DoRemoveProcess(process);
+    }
+}
+
+void UnixProcessReactor::DoStop()
+{
+    {
+        wxMutexLocker locker(m_mutex);
+        if(!m_ok || m_stop) return;
+        m_stop = true;
+        // Add() now fails
+        m_ok = false;
+    }
+    DoInterrupt();
+    Wait();
+}
+
+bool UnixProcessReactor::IsStopped()
+{
+    wxMutexLocker locker(m_mutex);
+    return m_stop;
+}
+
+bool UnixProcessReactor::DoAdd(IProcess* process, int fd, wxEvtHandler* parent)
+{
+    wxMutexLocker locker(m_mutex);
+    if(!m_ok) return false;
+
+    Watch watch;
+    watch.process = process;
+    watch.parent = parent;
+    watch.fd = fd;
+    watch.inEscape = false;
+
+    wxUint64 id = m_nextId++;
+#ifdef USE_EPOLL
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = id;
+    if(epoll_ctl(m_pollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        return false;
+    }
+#endif
+
+    m_watches.insert(std::make_pair(id, watch));
+    m_processes.insert(std::make_pair(process, id));
+    DoWakeup();
+    return true;
+}
+
+void UnixProcessReactor::DoRemoveProcess(IProcess* process)
+{
+    // Once we own the lock, the reactor thread is not using the process
+    wxMutexLocker locker(m_mutex);
+    std::map<IProcess*, wxUint64>::iterator iter = m_processes.find(process);
+    if(iter == m_processes.end()) return;
+
+    std::map<wxUint64, Watch>::iterator watch = m_watches.find(iter->second);
+    if(watch != m_watches.end()) {
+        DoRemove(watch);
+    }
+}
+
+void UnixProcessReactor::DoRemove(std::map<wxUint64, Watch>::iterator iter)
+{
+#ifdef USE_EPOLL
+    // the fd might already be closed, in which case epoll removed it by itself
+    epoll_ctl(m_pollFd, EPOLL_CTL_DEL, iter->second.fd, NULL);
+#endif
+    m_processes.erase(iter->second.process);
+    m_watches.erase(iter);
+    DoWakeup();
+}
+
+void UnixProcessReactor::DoWakeup()
+{
+#ifndef USE_EPOLL
+    // poll() must be restarted with the new watches, epoll sees them by itself
+    DoInterrupt();
+#endif
+}
+
+void UnixProcessReactor::DoInterrupt()
+{
+    char c = 0;
+    ssize_t rc = write(m_wakeupPipe[1], &c, 1);
+    wxUnusedVar(rc);
+}
+
+void* UnixProcessReactor::Entry()
+{
+    std::vector<wxUint64> ready;
+    while(!IsStopped() && !TestDestroy()) {
+        ready.clear();
+        if(DoWait(ready)) {
+            for(size_t i = 0; i < ready.size(); ++i) {
+                DoRead(ready.at(i));
+            }
+        }
+    }
+    return NULL;
+}
+
+bool UnixProcessReactor::DoWait(std::vector<wxUint64>& ready)
+{
+#ifdef USE_EPOLL
+    struct epoll_event events[64];
+    int count = epoll_wait(m_pollFd, events, 64, -1);
+    if(count <= 0) {
+        // EINTR
+        return false;
+    }
+
+    for(int i = 0; i < count; ++i) {
+        if(events[i].data.u64 == REACTOR_WAKEUP_ID) {
+            char buffer[128];
+            while(read(m_wakeupPipe[0], buffer, sizeof(buffer)) > 0) {
+            }
+            continue;
+        }
+        ready.push_back(events[i].data.u64);
+    }
+    return true;
+
+#else
+    std::vector<struct pollfd> fds;
+    std::vector<wxUint64> ids;
+    struct pollfd pfd;
+    memset(&pfd, 0, sizeof(pfd));
+    pfd.fd = m_wakeupPipe[0];
+    pfd.events = POLLIN;
+    fds.push_back(pfd);
+    {
+        wxMutexLocker locker(m_mutex);
+        std::map<wxUint64, Watch>::iterator iter = m_watches.begin();
+        for(; iter != m_watches.end(); ++iter) {
+            pfd.fd = iter->second.fd;
+            fds.push_back(pfd);
+            ids.push_back(iter->first);
+        }
+    }
+
+    if(poll(&fds[0], fds.size(), -1) <= 0) {
+        return false;
+    }
+
+    if(fds[0].revents & POLLIN) {
+        char buffer[128];
+        while(read(m_wakeupPipe[0], buffer, sizeof(buffer)) > 0) {
+        }
+    }
+
+    for(size_t i = 1; i < fds.size(); ++i) {
+        if(fds[i].revents & (POLLIN | POLLHUP | POLLERR | POLLNVAL)) {
+            ready.push_back(ids.at(i - 1));
+        }
+    }
+    return true;
+#endif
+}
+
+void UnixProcessReactor::DoRead(wxUint64 id)
+{
+    wxMutexLocker locker(m_mutex);
+    std::map<wxUint64, Watch>::iterator iter = m_watches.find(id);
+    if(iter == m_watches.end()) {
+        // removed while we were waiting
+        return;
+    }
+
+    Watch& watch = iter->second;
+    std::string data;
+    bool terminated = false;
+    char buffer[REACTOR_READ_SIZE];
+
+    // Read everything that is available now, so a burst of output is delivered as one event
+    while(data.size() < REACTOR_MAX_EVENT_SIZE) {
+        ssize_t bytes = read(watch.fd, buffer, sizeof(buffer));
+        if(bytes > 0) {
+            data.append(buffer, bytes);
+
+        } else if(bytes < 0 && (errno == EINTR || errno == EAGAIN)) {
+            break;
+
+        } else {
+            // EOF or EIO: the process terminated
+            // the exit code will be set in the sigchld event handler
+            terminated = true;
+            break;
+        }
+
+        struct pollfd pfd;
+        memset(&pfd, 0, sizeof(pfd));
+        pfd.fd = watch.fd;
+        pfd.events = POLLIN;
+        if(poll(&pfd, 1, 0) <= 0 || !(pfd.revents & POLLIN)) {
+            break;
+        }
+    }
+
+    IProcess* process = watch.process;
+    wxEvtHandler* parent = watch.parent;
+    wxString output = DoConvert(watch, data);
+    if(!output.IsEmpty()) {
+        // If we got a callback object, use it
+        if(process->GetCallback()) {
+            process->GetCallback()->CallAfter(&IProcessCallback::OnProcessOutput, output);
+
+        } else if(parent) {
+            // fallback to the event system
+            clProcessEvent e(wxEVT_ASYNC_PROCESS_OUTPUT);
+            e.SetOutput(output);
+            e.SetProcess(process);
+            parent->AddPendingEvent(e);
+        }
+    }
+
+    if(terminated) {
+        DoRemove(iter);
+        if(process->GetCallback()) {
+            process->GetCallback()->CallAfter(&IProcessCallback::OnProcessTerminated);
+
+        } else if(parent) {
+            clProcessEvent e(wxEVT_ASYNC_PROCESS_TERMINATED);
+            e.SetProcess(process);
+            parent->AddPendingEvent(e);
+        }
+    }
+}
+
+wxString UnixProcessReactor::DoConvert(Watch& watch, std::string& data)
+{
+    // Remove coloring chars from the incomnig buffer
+    // colors are marked with ESC and terminates with lower case 'm'
+    std::string text;
+    text.swap(watch.partial);
+    text.reserve(text.size() + data.size());
+    for(size_t i = 0; i < data.size(); ++i) {
+        char ch = data[i];
+        if(watch.inEscape) {
+            if(ch == 'm') watch.inEscape = false;
+        } else if(ch == 0x1B) {
+            watch.inEscape = true;
+        } else if(ch != 0) {
+            text.push_back(ch);
+        }
+    }
+
+    // Keep an incomplete UTF-8 sequence at the end of the buffer for the next read
+    size_t lead = text.size();
+    for(size_t i = 0; i < 3 && lead > 0; ++i) {
+        unsigned char ch = (unsigned char)text[lead - 1];
+        if((ch & 0xC0) != 0x80) {
+            --lead;
+            break;
+        }
+        --lead;
+    }
+    if(lead < text.size()) {
+        unsigned char ch = (unsigned char)text[lead];
+        size_t expected = ((ch & 0xE0) == 0xC0) ? 2 : ((ch & 0xF0) == 0xE0) ? 3 : ((ch & 0xF8) == 0xF0) ? 4 : 1;
+        if(text.size() - lead < expected) {
+            watch.partial = text.substr(lead);
+            text.erase(lead);
+        }
+    }
+
+    if(text.empty()) {
+        return wxEmptyString;
+    }
+
+    wxString output(text.c_str(), wxConvUTF8, text.size());
+    if(output.IsEmpty()) {
+        output = wxString::From8BitData(text.c_str(), text.size());
+    }
+    return output;
+}
+
+#endif // defined(__WXMAC__) || defined(__WXGTK__)
@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : unixprocess_reactor.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef UNIXPROCESS_REACTOR_H
+#define UNIXPROCESS_REACTOR_H
+
+#if defined(__WXMAC__) || defined(__WXGTK__)
+#include <map>
+#include <string>
+#include <vector>
+#include <wx/thread.h>
+#include <wx/event.h>
+#include "codelite_exports.h"
+
+class IProcess;
+
+/**
+ * @class UnixProcessReactor
+ * @brief a single thread reading the output of all the asynchronous processes.
+ * The thread sleeps in epoll_wait (poll on systems without epoll) until one of the
+ * processes has output. All the output available at that time is read in large chunks
+ * and delivered as a single event (or IProcessCallback::OnProcessOutput call).
+ * When a process terminates, the termination is delivered the same way and the process
+ * is removed from the reactor.
+ * The reactor is created by the first Add() call and stopped by Stop(), called when the
+ * library is unloaded at the latest
+ */
+class WXDLLIMPEXP_CL UnixProcessReactor : public wxThread
+{
+    struct Watch {
+        IProcess* process;
+        wxEvtHandler* parent;
+        int fd;
+        std::string partial; // incomplete UTF-8 sequence of the previous read
+        bool inEscape;       // the previous read ended inside a terminal colour sequence
+    };
+
+    std::map<wxUint64, Watch> m_watches; // by watch ID
+    std::map<IProcess*, wxUint64> m_processes;
+    wxUint64 m_nextId;
+    wxMutex m_mutex;
+    int m_pollFd;         // epoll only
+    int m_wakeupPipe[2];  // used to interrupt the wait on shutdown (and with poll, when the watches change)
+    bool m_ok;
+    bool m_stop;
+
+private:
+    UnixProcessReactor();
+    virtual ~UnixProcessReactor();
+
+    static UnixProcessReactor* DoCreate();
+    static UnixProcessReactor* DoGet(bool create);
+
+    bool DoAdd(IProcess* process, int fd, wxEvtHandler* parent);
+    void DoRemoveProcess(IProcess* process);
+    void DoStop();
+
+    bool DoWait(std::vector<wxUint64>& ready);
+    void DoRead(wxUint64 id);
+    void DoRemove(std::map<wxUint64, Watch>::iterator iter);
+    void DoWakeup();
+    void DoInterrupt();
+    bool IsStopped();
+    wxString DoConvert(Watch& watch, std::string& data);
+
+protected:
+    virtual void* Entry();
+
+public:
+    /**
+     * @brief stop the reactor thread (if it was started) and wait for it to exit. The processes
+     * started afterwards use their own reader thread
+     */
+    static void Stop();
+
+    /**
+     * @brief start delivering the output of 'process' read from 'fd' to 'parent'
+     * @return false if the reactor is not available (the caller should use its own reader thread)
+     */
+    static bool Add(IProcess* process, int fd, wxEvtHandler* parent);
+
+    /**
+     * @brief stop watching 'process'. Once this function returns, the reactor no longer
+     * uses 'process'. Does nothing if the reactor was never started
+     */
+    static void Remove(IProcess* process);
+};
+
+#endif // defined(__WXMAC__) || defined(__WXGTK__)
+#endif // UNIXPROCESS_REACTOR_H
@@ -36,28 +36,29 @@ WorkerThread::~WorkerThread()
 
 void* WorkerThread::Entry()
 {
-    while(true) {
-        // Did we get a request to terminate?
-        if(TestDestroy()) break;
-        ThreadRequest* request = NULL;
-        if(m_queue.ReceiveTimeout(50, request) == wxMSGQUEUE_NO_ERROR) {
-            // Call user's implementation for processing request
-            ProcessRequest(request);
-            wxDELETE(request);
-        }
+    // Did we get a request to terminate?
+    while(!TestDestroy()) {
+        // Sleep until a request arrives, NULL means that we are being stopped
+        ThreadRequest* request = m_queue.Receive();
+        if(!request) break;
+
+        // Call user's implementation for processing request
+        ProcessRequest(request);
+        wxDELETE(request);
     }
     return NULL;
 }
 
 void WorkerThread::Add(ThreadRequest* request)
 {
-    m_queue.Post(request);
+    m_queue.Post(request, request->GetPriority(), request->GetCoalescingKey());
 }
 
 void WorkerThread::Stop()
 {
     // Notify the thread to exit and
     // wait for it
+    m_queue.Shutdown();
     if(IsAlive()) {
         Delete(NULL, wxTHREAD_WAIT_BLOCK);
 
@@ -29,7 +29,7 @@
 #include "wx/thread.h"
 #include "wx/event.h"
 #include "codelite_exports.h"
-#include <wx/msgqueue.h>
+#include "clRequestQueue.h"
 
 /**
  * Base class for thread requests,
@@ -39,6 +39,17 @@ class WXDLLIMPEXP_CL ThreadRequest
 public:
     ThreadRequest(){};
     virtual ~ThreadRequest(){};
+
+    /**
+     * @brief requests with a higher priority are processed first (see eRequestPriority)
+     */
+    virtual int GetPriority() const { return kRequestPriorityNormal; }
+
+    /**
+     * @brief a queued request is replaced by a newer request with the same key.
+     * An empty key (the default) means that the request is never replaced
+     */
+    virtual wxString GetCoalescingKey() const { return wxEmptyString; }
 };
 
 /**
@@ -49,7 +60,7 @@ class WXDLLIMPEXP_CL WorkerThread : public wxThread
 {
 protected:
     wxEvtHandler* m_notifiedWindow;
-    wxMessageQueue<ThreadRequest*> m_queue;
+    clRequestQueue<ThreadRequest> m_queue;
 
 public:
     /**
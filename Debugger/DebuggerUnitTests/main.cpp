@@ -0,0 +1,157 @@
+#include <wx/init.h>
+#include "gdbmi_record_parser.h"
+#include "tester.h"
+
+// Format the attribute maps: one line per child with its sorted "key=value" pairs, the values keep their quotes
+static wxString FormatChildren(const GdbChildrenInfo& info)
+{
+    wxString str;
+    str << "has_more=" << (info.has_more ? "1" : "0") << "\n";
+    for(size_t i = 0; i < info.children.size(); ++i) {
+        const GdbStringMap_t& attributes = info.children.at(i);
+        GdbStringMap_t::const_iterator iter = attributes.begin();
+        for(; iter != attributes.end(); ++iter) {
+            if(iter != attributes.begin()) str << " ";
+            str << iter->first << "=" << iter->second;
+        }
+        str << "\n";
+    }
+    return str;
+}
+
+struct ChildrenTestCase {
+    const char* record;
+    const char* expected; // the output of the former flex/yacc parser (gdbparser/gdb_result.y)
+};
+
+// clang-format off
+static const ChildrenTestCase kChildrenTests[] = {
+    // -var-list-children
+    { "^done,numchild=\"2\",children=[child={name=\"var1.x\",exp=\"x\",numchild=\"0\",value=\"4\",type=\"int\",thread-id=\"1\"},"
+      "child={name=\"var1.str\",exp=\"str\",numchild=\"1\",value=\"{...}\",type=\"std::string\",thread-id=\"1\"}],has_more=\"0\"",
+      "has_more=0\n"
+      "exp=\"x\" name=\"var1.x\" numchild=\"0\" thread-id=\"1\" type=\"int\" value=\"4\"\n"
+      "exp=\"str\" name=\"var1.str\" numchild=\"1\" thread-id=\"1\" type=\"std::string\" value=\"{...}\"\n" },
+    { "^done,numchild=\"1\",displayhint=\"map\",children=[child={name=\"var2.[0]\",exp=\"[0]\",numchild=\"0\",value=\"\\\"key\\\"\","
+      "type=\"std::string\"}],has_more=\"1\"",
+      "has_more=1\n"
+      "exp=\"[0]\" name=\"var2.[0]\" numchild=\"0\" type=\"std::string\" value=\"\\\"key\\\"\"\n" },
+    // -var-create
+    { "^done,name=\"var1\",numchild=\"2\",value=\"{...}\",type=\"ChildClass\",thread-id=\"1\",has_more=\"0\"",
+      "has_more=0\n"
+      "has_more=\"0\" name=\"var1\" numchild=\"2\" thread-id=\"1\" type=\"ChildClass\" value=\"{...}\"\n" },
+    // -var-evaluate-expression
+    { "^done,value=\"0x1 \\\"a\\\\\\\"b\\\"\"",
+      "has_more=0\n"
+      "value=\"0x1 \\\"a\\\"b\\\"\"\n" },
+    // -stack-list-locals and -stack-list-variables
+    { "^done,locals=[{name=\"pcls\",type=\"ChildClass *\",value=\"0x0\"},{name=\"s\",type=\"string *\",value=\"0x3e2550\"}]",
+      "has_more=0\n"
+      "name=\"pcls\" type=\"ChildClass *\" value=\"0x0\"\n"
+      "name=\"s\" type=\"string *\" value=\"0x3e2550\"\n" },
+    { "^done,variables=[{name=\"argc\",arg=\"1\",type=\"int\",value=\"1\"},{name=\"i\",type=\"int\",value=\"7\"}]",
+      "has_more=0\n"
+      "arg=\"1\" name=\"argc\" type=\"int\" value=\"1\"\n"
+      "name=\"i\" type=\"int\" value=\"7\"\n" },
+    // -stack-list-locals on macOS
+    { "^done,locals={varobj={exp=\"str\",value=\"{...}\",name=\"var6\",numchild=\"1\",type=\"string\",typecode=\"STRUCT\","
+      "dynamic_type=\"\",in_scope=\"true\",block_start_addr=\"0x00001e84\",block_end_addr=\"0x00001f38\"},"
+      "varobj={exp=\"anotherLocal\",value=\"2\",name=\"var7\",numchild=\"0\",type=\"int\",typecode=\"INT\",dynamic_type=\"\","
+      "in_scope=\"true\",block_start_addr=\"0x00001e84\",block_end_addr=\"0x00001f38\"}}",
+      "has_more=0\n"
+      "block_end_addr=\"0x00001f38\" block_start_addr=\"0x00001e84\" dynamic_type=\"\" exp=\"str\" in_scope=\"true\" "
+      "name=\"var6\" numchild=\"1\" type=\"string\" typecode=\"STRUCT\" value=\"{...}\"\n"
+      "block_end_addr=\"0x00001f38\" block_start_addr=\"0x00001e84\" dynamic_type=\"\" exp=\"anotherLocal\" in_scope=\"true\" "
+      "name=\"var7\" numchild=\"0\" type=\"int\" typecode=\"INT\" value=\"2\"\n" },
+    // -stack-list-arguments
+    { "^done,stack-args=[frame={level=\"0\",args=[{name=\"argc\",type=\"int\",value=\"1\"},"
+      "{name=\"argv\",type=\"char **\",value=\"0x3e2570\"}]}]",
+      "has_more=0\n"
+      "name=\"argc\" type=\"int\" value=\"1\"\n"
+      "name=\"argv\" type=\"char **\" value=\"0x3e2570\"\n" },
+    { "^done,stack-args={frame={level=\"0\",args={varobj={exp=\"argc\",value=\"1\",name=\"var8\",numchild=\"0\",type=\"int\","
+      "typecode=\"INT\",dynamic_type=\"\",in_scope=\"true\",block_start_addr=\"0x00001e76\",block_end_addr=\"0x00001f42\"},"
+      "varobj={exp=\"argv\",value=\"0xbffffaa8\",name=\"var9\",numchild=\"1\",type=\"char **\",typecode=\"PTR\",dynamic_type=\"\","
+      "in_scope=\"true\",block_start_addr=\"0x00001e76\",block_end_addr=\"0x00001f42\"}}}}",
+      "has_more=0\n"
+      "block_end_addr=\"0x00001f42\" block_start_addr=\"0x00001e76\" dynamic_type=\"\" exp=\"argc\" in_scope=\"true\" "
+      "name=\"var8\" numchild=\"0\" type=\"int\" typecode=\"INT\" value=\"1\"\n"
+      "block_end_addr=\"0x00001f42\" block_start_addr=\"0x00001e76\" dynamic_type=\"\" exp=\"argv\" in_scope=\"true\" "
+      "name=\"var9\" numchild=\"1\" type=\"char **\" typecode=\"PTR\" value=\"0xbffffaa8\"\n" },
+    // -break-list: the lists (thread-groups) are skipped
+    { "^done,BreakpointTable={nr_rows=\"2\",nr_cols=\"6\",hdr=[{width=\"7\",alignment=\"-1\",col_name=\"number\",colhdr=\"Num\"}],"
+      "body=[{number=\"1\",type=\"breakpoint\",disp=\"keep\",enabled=\"y\",addr=\"<MULTIPLE>\",times=\"0\","
+      "original-location=\"__cxa_throw\"},{number=\"1.1\",enabled=\"y\",addr=\"0x000000000047efe7\",at=\"<__cxa_throw+7>\","
+      "thread-groups=[\"i1\"]},{number=\"2\",type=\"breakpoint\",disp=\"keep\",enabled=\"y\",addr=\"0x000000000042c9c9\","
+      "func=\"MainApp::OnInit()\",file=\"D:/src/main.cpp\",fullname=\"D:\\\\src\\\\main.cpp\",line=\"19\",thread-groups=[\"i1\"],"
+      "times=\"1\",original-location=\"D:/src/main.cpp:19\"}]}",
+      "has_more=0\n"
+      "addr=\"<MULTIPLE>\" disp=\"keep\" enabled=\"y\" number=\"1\" original-location=\"__cxa_throw\" times=\"0\" type=\"breakpoint\"\n"
+      "addr=\"0x000000000047efe7\" at=\"<__cxa_throw+7>\" enabled=\"y\" number=\"1.1\"\n"
+      "addr=\"0x000000000042c9c9\" disp=\"keep\" enabled=\"y\" file=\"D:/src/main.cpp\" fullname=\"D:\\src\\main.cpp\" "
+      "func=\"MainApp::OnInit()\" line=\"19\" number=\"2\" original-location=\"D:/src/main.cpp:19\" times=\"1\" type=\"breakpoint\"\n" },
+    // -stack-info-frame
+    { "^done,frame={level=\"0\",addr=\"0x0040143f\",func=\"main\",file=\"C:/TestArea/main.cpp\","
+      "fullname=\"C:/TestArea/main.cpp\",line=\"33\"}",
+      "has_more=0\n"
+      "addr=\"0x0040143f\" file=\"C:/TestArea/main.cpp\" fullname=\"C:/TestArea/main.cpp\" func=\"main\" level=\"0\" line=\"33\"\n" },
+    // -var-update
+    { "^done,changelist=[{name=\"var2\",in_scope=\"false\",type_changed=\"false\",has_more=\"0\"},{name=\"var1\",in_scope=\"true\"}]",
+      "has_more=0\n"
+      "has_more=\"0\" in_scope=\"false\" name=\"var2\" type_changed=\"false\"\n"
+      "in_scope=\"true\" name=\"var1\"\n" },
+    // *stopped: only the timing and the reason are collected
+    { "*stopped,time={wallclock=\"0.05185\",user=\"0.00800\",system=\"0.00000\"},reason=\"end-stepping-range\",thread-id=\"1\","
+      "frame={addr=\"0x0040156b\",func=\"main\",args=[{name=\"argc\",value=\"1\"}],file=\"a.cpp\",line=\"46\"}",
+      "has_more=0\n"
+      "reason=\"end-stepping-range\" system=\"0.00000\" user=\"0.00800\" wallclock=\"0.05185\"\n" },
+    { "*stopped,reason=\"breakpoint-hit\",disp=\"keep\",bkptno=\"1\",thread-id=\"1\",frame={addr=\"0x0040156b\",func=\"main\","
+      "args=[],file=\"a.cpp\",line=\"46\"}",
+      "has_more=0\n"
+      "reason=\"breakpoint-hit\"\n" },
+};
+// clang-format on
+
+TEST_FUNC(test_children_info_matches_former_parser)
+{
+    for(size_t i = 0; i < sizeof(kChildrenTests) / sizeof(kChildrenTests[0]); ++i) {
+        GdbMIRecord record;
+        CHECK_BOOL(record.Parse(std::string(kChildrenTests[i].record)));
+
+        GdbChildrenInfo info;
+        record.ToChildrenInfo(info);
+        CHECK_WXSTRING(FormatChildren(info), kChildrenTests[i].expected);
+    }
+    return true;
+}
+
+TEST_FUNC(test_children_info_fixed_cases)
+{
+    // The former parser failed on these records and returned no children
+    GdbMIRecord record;
+    GdbChildrenInfo info;
+    CHECK_BOOL(record.Parse(std::string("^done,BreakpointTable={nr_rows=\"1\",nr_cols=\"6\",hdr=[],"
+                                        "body=[bkpt={number=\"1\",type=\"breakpoint\",times=\"0\"}]}")));
+    record.ToChildrenInfo(info);
+    CHECK_WXSTRING(FormatChildren(info), "has_more=0\nnumber=\"1\" times=\"0\" type=\"breakpoint\"\n");
+
+    CHECK_BOOL(record.Parse(std::string("^done,changelist=[{name=\"var3\",value=\"5\",in_scope=\"true\",dynamic=\"1\","
+                                        "new_children=[{name=\"var3.[0]\",numchild=\"0\"}]}]")));
+    record.ToChildrenInfo(info);
+    CHECK_WXSTRING(FormatChildren(info), "has_more=1\ndynamic=\"1\" in_scope=\"true\" name=\"var3\" value=\"5\"\n");
+
+    // The former parser appended an empty entry to the disassembly
+    CHECK_BOOL(record.Parse(std::string("^done,asm_insns=[{address=\"0x000107c0\",func-name=\"main\",offset=\"4\","
+                                        "inst=\"mov 2, %o0\"}]")));
+    record.ToChildrenInfo(info);
+    CHECK_WXSTRING(FormatChildren(info), "has_more=0\naddress=\"0x000107c0\" func-name=\"main\" inst=\"mov 2, %o0\" offset=\"4\"\n");
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    wxInitialize(argc, argv);
+    Tester::Instance()->RunTests();
+    wxUninitialize();
+    return 0;
+}
@@ -27,7 +27,7 @@
 #include "event_notifier.h"
 #include "wx/tokenzr.h"
 #include "debuggergdb.h"
-#include "gdb_result_parser.h"
+#include "gdbmi_record_parser.h"
 #include <wx/regex.h>
 #include "gdb_parser_incl.h"
 #include "procutils.h"
@@ -38,17 +38,6 @@
 
 static bool IS_WINDOWNS = (wxGetOsVersion() & wxOS_WINDOWS);
 
-#define GDB_LEX()                         \
-    {                                     \
-        type = gdb_result_lex();          \
-        currentToken = gdb_result_string; \
-    }
-
-#define GDB_BREAK(ch)     \
-    if(type != (int)ch) { \
-        break;            \
-    }
-
 static void wxGDB_STRIP_QUOATES(wxString& currentToken)
 {
     size_t where = currentToken.find(wxT("\""));
@@ -86,20 +75,17 @@ static void wxRemoveQuotes(wxString& str)
 
 static wxString wxGdbFixValue(const wxString& value)
 {
-    int type(0);
-    std::string currentToken;
-
     // GDB MI tends to mess the strings...
-    // use our Flex lexer to normalize the value
-    setGdbLexerInput(value.mb_str(wxConvUTF8).data(), true, true);
-    GDB_LEX();
-    wxString display_line;
-    while(type != 0) {
-        display_line << wxString(currentToken.c_str(), wxConvUTF8);
-        GDB_LEX();
-    }
-    gdb_result_lex_clean();
-    return display_line;
+    // normalize the value
+    std::string fixed = GdbMIRecord::FixValue(value.mb_str(wxConvUTF8).data());
+    return wxString(fixed.c_str(), wxConvUTF8);
+}
+
+static void ParseListChildren(const wxString& line, GdbChildrenInfo& info)
+{
+    GdbMIRecord record;
+    record.Parse(line);
+    record.ToChildrenInfo(info);
 }
 
 static wxString NextValue(wxString& line, wxString& key)
@@ -319,7 +305,7 @@ bool DbgCmdHandlerAsyncCmd::ProcessOutput(const wxString& line)
 
     // Get the reason
     GdbChildrenInfo info;
-    gdbParseListChildren(line.mb_str(wxConvUTF8).data(), info);
+    ParseListChildren(line, info);
 
     wxString func;
     bool foundReason;
@@ -619,7 +605,7 @@ bool DbgCmdHandlerLocals::ProcessOutput(const wxString& line)
     LocalVariables locals;
 
     GdbChildrenInfo info;
-    gdbParseListChildren(line.mb_str(wxConvUTF8).data(), info);
+    ParseListChildren(line, info);
 
     for(size_t i = 0; i < info.children.size(); i++) {
         std::map<std::string, std::string> attr = info.children.at(i);
@@ -686,7 +672,7 @@ bool DbgCmdHandlerFuncArgs::ProcessOutput(const wxString& line)
     LocalVariables locals;
 
     GdbChildrenInfo info;
-    gdbParseListChildren(line.mb_str(wxConvUTF8).data(), info);
+    ParseListChildren(line, info);
 
     for(size_t i = 0; i < info.children.size(); i++) {
         std::map<std::string, std::string> attr = info.children.at(i);
@@ -826,12 +812,8 @@ bool DbgCmdDisplayOutput::ProcessOutput(const wxString& line)
 
 bool DbgCmdResolveTypeHandler::ProcessOutput(const wxString& line)
 {
-    const wxCharBuffer scannerText = _C(line);
-    setGdbLexerInput(scannerText.data(), true);
-
-    int type;
     wxString cmd, var_name;
-    wxString type_name, currentToken;
+    wxString type_name;
     wxString err_msg;
     // parse the output
     // ^done,name="var2",numchild="1",value="{...}",type="orxAABOX"
@@ -849,61 +831,13 @@ bool DbgCmdResolveTypeHandler::ProcessOutput(const wxString& line)
         return true;
 
     } else {
-
-        do {
-            // ^done
-            GDB_NEXT_TOKEN();
-            GDB_ABORT('^');
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(GDB_DONE);
-
-            // ,name="..."
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(',');
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(GDB_NAME);
-            GDB_NEXT_TOKEN();
-            GDB_ABORT('=');
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(GDB_STRING);
-            var_name = currentToken;
-
-            // ,numchild="..."
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(',');
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(GDB_NUMCHILD);
-            GDB_NEXT_TOKEN();
-            GDB_ABORT('=');
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(GDB_STRING);
-// On Mac this part does not seem to be reported by GDB
-#ifndef __WXMAC__
-            // ,value="..."
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(',');
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(GDB_VALUE);
-            GDB_NEXT_TOKEN();
-            GDB_ABORT('=');
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(GDB_STRING);
-#endif
-            // ,type="..."
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(',');
-            GDB_NEXT_TOKEN();
-            GDB_ABORT(GDB_TYPE);
-            GDB_NEXT_TOKEN();
-            GDB_ABORT('=');
-            GDB_NEXT_TOKEN();
-            type_name = currentToken;
-        } while(0);
+        GdbMIRecord record;
+        record.Parse(line);
+        if(record.GetKind() == GdbMIRecord::kResult && record.GetClass() == "done") {
+            var_name = record["name"].GetString();
+            type_name = record["type"].GetString();
+        }
     }
-    gdb_result_lex_clean();
-
-    wxGDB_STRIP_QUOATES(type_name);
-    wxGDB_STRIP_QUOATES(var_name);
 
     // delete the variable object
     cmd.Clear();
@@ -981,7 +915,7 @@ bool DbgCmdBreakList::ProcessOutput(const wxString& line)
     dbg_output.Replace("bkpt=", "");
     std::vector<BreakpointInfo> li;
     GdbChildrenInfo info;
-    gdbParseListChildren(dbg_output.mb_str(wxConvUTF8).data(), info);
+    ParseListChildren(dbg_output, info);
 
     // Children is a vector of map of attribues.
     // Each map represents an information about a breakpoint
@@ -1089,89 +1023,45 @@ bool DbgCmdWatchMemory::ProcessOutput(const wxString& line)
         factor = (int)(m_count / divider) + 1;
     }
 
+    // ^done,addr="0x003d3e24",nr-bytes="8",...,memory=[
     // {addr="0x003d3e24",data=["0x65","0x72","0x61","0x6e"],ascii="eran"},
-    // {addr="0x003d3e28",data=["0x00","0xab","0xab","0xab"],ascii="xxxx"}
-    wxString dbg_output(line), output;
+    // {addr="0x003d3e28",data=["0x00","0xab","0xab","0xab"],ascii="xxxx"}]
+    wxString output;
+    GdbMIRecord record;
+    record.Parse(line);
 
-    // search for ,memory=[
-    int where = dbg_output.Find(wxT(",memory="));
-    if(where != wxNOT_FOUND) {
-        dbg_output = dbg_output.Mid((size_t)(where + 9));
-
-        const wxCharBuffer scannerText = _C(dbg_output);
-        setGdbLexerInput(scannerText.data(), true);
-
-        int type;
-        wxString currentToken;
+    GdbMIValue row = record["memory"].GetFirstChild();
+    for(int i = 0; i < factor && row.IsOk(); i++, row = row.GetNext()) {
         wxString currentLine;
-        GDB_NEXT_TOKEN();
-
-        for(int i = 0; i < factor && type != 0; i++) {
-            currentLine.Clear();
-
-            while(type != GDB_ADDR) {
-
-                if(type == 0) {
-                    break;
-                }
-
-                GDB_NEXT_TOKEN();
-                continue;
-            }
-
-            // Eof?
-            if(type == 0) {
-                break;
-            }
-
-            GDB_NEXT_TOKEN(); //=
-            GDB_NEXT_TOKEN(); // 0x003d3e24
-            wxGDB_STRIP_QUOATES(currentToken);
-            currentLine << currentToken << wxT(": ");
-
-            GDB_NEXT_TOKEN(); //,
-            GDB_NEXT_TOKEN(); // data
-            GDB_NEXT_TOKEN(); //=
-            GDB_NEXT_TOKEN(); //[
-
-            long v(0);
-            wxString hex, asciiDump;
-            for(int yy = 0; yy < divider; yy++) {
-                GDB_NEXT_TOKEN(); //"0x65"
-                wxGDB_STRIP_QUOATES(currentToken);
-                // convert the hex string into real value
-                if(currentToken.ToLong(&v, 16)) {
-
-                    //	char ch = (char)v;
-                    if(wxIsprint((wxChar)v) || (wxChar)v == ' ') {
-                        if(v == 9) { // TAB
-                            v = 32;  // SPACE
-                        }
-
-                        hex << (wxChar)v;
-                    } else {
-                        hex << wxT("?");
+        currentLine << row["addr"].GetString() << wxT(": ");
+
+        long v(0);
+        wxString hex;
+        GdbMIValue data = row["data"].GetFirstChild();
+        for(int yy = 0; yy < divider && data.IsOk(); yy++, data = data.GetNext()) {
+            wxString currentToken = data.GetString();
+            // convert the hex string into real value
+            if(currentToken.ToLong(&v, 16)) {
+
+                //	char ch = (char)v;
+                if(wxIsprint((wxChar)v) || (wxChar)v == ' ') {
+                    if(v == 9) { // TAB
+                        v = 32;  // SPACE
                     }
+
+                    hex << (wxChar)v;
                 } else {
                     hex << wxT("?");
                 }
-
-                currentLine << currentToken << wxT(" ");
-                GDB_NEXT_TOKEN(); //, | ]
+            } else {
+                hex << wxT("?");
             }
 
-            GDB_NEXT_TOKEN(); //,
-            GDB_NEXT_TOKEN(); // GDB_ASCII
-            GDB_NEXT_TOKEN(); //=
-            GDB_NEXT_TOKEN(); // ascii_value
-            currentLine << wxT(" : ") << hex;
-
-            wxGDB_STRIP_QUOATES(currentToken);
-            output << currentLine << wxT("\n");
-            GDB_NEXT_TOKEN();
+            currentLine << currentToken << wxT(" ");
         }
 
-        gdb_result_lex_clean();
+        currentLine << wxT(" : ") << hex;
+        output << currentLine << wxT("\n");
     }
     e.m_updateReason = DBG_UR_WATCHMEMORY;
     e.m_evaluated = output;
@@ -1197,7 +1087,7 @@ bool DbgCmdCreateVarObj::ProcessOutput(const wxString& line)
     // Output sample:
     // ^done,name="var1",numchild="2",value="{...}",type="ChildClass",thread-id="1",has_more="0"
     GdbChildrenInfo info;
-    gdbParseListChildren(line.mb_str(wxConvUTF8).data(), info);
+    ParseListChildren(line, info);
 
     if(info.children.empty() == false) {
         std::map<std::string, std::string> attr = info.children.at(0);
@@ -1313,10 +1203,8 @@ static VariableObjChild FromParserOutput(const std::map<std::string, std::string
 bool DbgCmdListChildren::ProcessOutput(const wxString& line)
 {
     DebuggerEventData e;
-    std::string cbuffer = line.mb_str(wxConvUTF8).data();
-
     GdbChildrenInfo info;
-    gdbParseListChildren(cbuffer, info);
+    ParseListChildren(line, info);
 
     // Convert the parser output to codelite data structure
     for(size_t i = 0; i < info.children.size(); i++) {
@@ -1338,9 +1226,8 @@ bool DbgCmdListChildren::ProcessOutput(const wxString& line)
 
 bool DbgCmdEvalVarObj::ProcessOutput(const wxString& line)
 {
-    std::string cbuffer = line.mb_str(wxConvUTF8).data();
     GdbChildrenInfo info;
-    gdbParseListChildren(cbuffer, info);
+    ParseListChildren(line, info);
 
     if(info.children.empty() == false) {
         wxString display_line = ExtractGdbChild(info.children.at(0), wxT("value"));
@@ -1413,9 +1300,8 @@ bool DbgVarObjUpdate::ProcessOutput(const wxString& line)
         return false; // let the default loop to handle this as well by passing DBG_CMD_ERR to the observer
     }
 
-    std::string cbuffer = line.mb_str(wxConvUTF8).data();
     GdbChildrenInfo info;
-    gdbParseListChildren(cbuffer, info);
+    ParseListChildren(line, info);
 
     for(size_t i = 0; i < info.children.size(); i++) {
         wxString name = ExtractGdbChild(info.children.at(i), wxT("name"));
@@ -1474,7 +1360,7 @@ bool DbgCmdHandlerDisasseble::ProcessOutput(const wxString& line)
 {
     clCommandEvent event(wxEVT_DEBUGGER_DISASSEBLE_OUTPUT);
     GdbChildrenInfo info;
-    ::gdbParseListChildren(line.mb_str(wxConvUTF8).data(), info);
+    ParseListChildren(line, info);
 
     DebuggerEventData* evtData = new DebuggerEventData();
     for(size_t i = 0; i < info.children.size(); ++i) {
@@ -1513,7 +1399,7 @@ bool DbgCmdHandlerDisassebleCurLine::ProcessOutput(const wxString& line)
 {
     clCommandEvent event(wxEVT_DEBUGGER_DISASSEBLE_CURLINE);
     GdbChildrenInfo info;
-    ::gdbParseListChildren(line.mb_str(wxConvUTF8).data(), info);
+    ParseListChildren(line, info);
 
     DebuggerEventData* evtData = new DebuggerEventData();
     if(info.children.empty() == false) {
@@ -1555,45 +1441,18 @@ bool DbgCmdHandlerRegisterNames::ProcessOutput(const wxString& line)
 {
     // Sample output:
     // ^done,register-names=["eax","ecx","edx","ebx","esp","ebp","esi","edi","eip","eflags","cs","ss","ds","es","fs","gs","st0","st1","st2","st3","st4","st5","st6","st7","fctrl","fstat","ftag","fiseg","fioff","foseg","fooff","fop","xmm0","xmm1","xmm2","xmm3","xmm4","xmm5","xmm6","xmm7","mxcsr","","","","","","","","","al","cl","dl","bl","ah","ch","dh","bh","ax","cx","dx","bx","","bp","si","di","mm0","mm1","mm2","mm3","mm4","mm5","mm6","mm7"]
-    const wxCharBuffer scannerText = _C(line);
-    setGdbLexerInput(scannerText.data(), true);
-
-    int type;
-    wxString cmd, var_name;
-    wxString type_name, currentToken;
-    wxString err_msg;
-
     int counter = 0;
     m_numberToName.clear();
-    // ^done,register-values=[{number="0",value="4195709"},...]
     if(line.StartsWith("^done")) {
-        // ^done,register-values=[
-        GDB_NEXT_TOKEN(); // ^
-        GDB_NEXT_TOKEN(); // done
-        GDB_NEXT_TOKEN(); // ,
-        GDB_NEXT_TOKEN(); // register-names
-        GDB_NEXT_TOKEN(); // =
-        GDB_NEXT_TOKEN(); // [
-
-        while(true) {
-            wxString reg_name;
-            GDB_NEXT_TOKEN();
-            if(type == 0) {
-                // EOF?
-                break;
-            }
-            reg_name = currentToken;
-            wxGDB_STRIP_QUOATES(reg_name);
-            m_numberToName.insert(std::make_pair(counter, reg_name));
+        GdbMIRecord record;
+        record.Parse(line);
 
-            GDB_NEXT_TOKEN(); // remove the ','
-            if(type != ',')
-                // end of the list
-                break;
+        GdbMIValue reg = record["register-names"].GetFirstChild();
+        for(; reg.IsOk(); reg = reg.GetNext()) {
+            m_numberToName.insert(std::make_pair(counter, reg.GetString()));
             ++counter;
         }
     }
-    gdb_result_lex_clean();
     // Now trigger the register values call
     return m_gdb->WriteCommand("-data-list-register-values N",
                                new DbgCmdHandlerRegisterValues(m_observer, m_gdb, m_numberToName));
@@ -1608,77 +1467,36 @@ bool DbgCmdHandlerRegisterValues::ProcessOutput(const wxString& line)
     clCommandEvent event(wxEVT_DEBUGGER_LIST_REGISTERS);
     DbgRegistersVec_t registers;
 
-    const wxCharBuffer scannerText = _C(line);
-    setGdbLexerInput(scannerText.data(), true);
-    int type;
-    wxString cmd, var_name;
-    wxString type_name, currentToken;
-    wxString err_msg;
-
     // ^done,register-values=[{number="0",value="4195709"},...]
     if(line.StartsWith("^done")) {
         DebuggerEventData* data = new DebuggerEventData();
+        GdbMIRecord record;
+        record.Parse(line);
 
-        // ^done,register-values=[
-        GDB_NEXT_TOKEN(); // ^
-        GDB_NEXT_TOKEN(); // done
-        GDB_NEXT_TOKEN(); // ,
-        GDB_NEXT_TOKEN(); // register-values
-        GDB_NEXT_TOKEN(); // =
-        GDB_NEXT_TOKEN(); // [
-
-        while(true) {
+        GdbMIValue value = record["register-values"].GetFirstChild();
+        for(; value.IsOk(); value = value.GetNext()) {
             DbgRegister reg;
 
-            GDB_NEXT_TOKEN(); // {
-            GDB_ABORT('{');
-            GDB_NEXT_TOKEN(); // number
-            GDB_NEXT_TOKEN(); // =
-            GDB_NEXT_TOKEN(); // "0"
-
             long regId = 0;
-
-            wxGDB_STRIP_QUOATES(currentToken);
-            currentToken.ToCLong(&regId);
+            value["number"].GetString().ToCLong(&regId);
 
             // find this register in the map
             std::map<int, wxString>::iterator iter = m_numberToName.find(regId);
             if(iter != m_numberToName.end()) {
                 reg.reg_name = iter->second;
             }
-
-            GDB_NEXT_TOKEN(); // ,
-            GDB_NEXT_TOKEN(); // value
-            GDB_NEXT_TOKEN(); // =
-            GDB_NEXT_TOKEN(); // "..."
-            reg.reg_value = currentToken;
-            wxGDB_STRIP_QUOATES(reg.reg_value);
+            reg.reg_value = value["value"].GetString();
 
             // Add the register
             if(!reg.reg_name.IsEmpty()) {
                 registers.push_back(reg);
             }
-
-            // Read the next token
-            GDB_NEXT_TOKEN(); // }
-            GDB_NEXT_TOKEN();
-            wxGDB_STRIP_QUOATES(currentToken);
-            if(currentToken != ",") {
-                // no more registers
-                break;
-            }
-
-            if(type == 0) {
-                // EOF?
-                break;
-            }
         }
 
         data->m_registers = registers;
         event.SetClientObject(data);
         EventNotifier::Get()->AddPendingEvent(event);
     }
-    gdb_result_lex_clean();
     return true;
 }
 
@@ -33,17 +33,6 @@
 class IDebugger;
 class DbgGdb;
 
-#define GDB_NEXT_TOKEN()                              \
-    {                                                 \
-        type = gdb_result_lex();                      \
-        currentToken = _U(gdb_result_string.c_str()); \
-    }
-
-#define GDB_ABORT(ch)     \
-    if(type != (int)ch) { \
-        break;            \
-    }
-
 class DbgCmdHandler
 {
 protected:
@@ -343,12 +343,11 @@ void DbgGdb::DoCleanup()
     SetIsRemoteDebugging(false);
     SetIsRemoteExtended(false);
     EmptyQueue();
-    m_gdbOutputArr.Clear();
     m_bpList.clear();
     m_debuggeeProjectName.Clear();
 
-    // Clear any bufferd output
-    m_gdbOutputIncompleteLine.Clear();
+    // Clear any bufferd output (including the partial line)
+    m_gdbOutput.Clear();
 
     // Free allocated console for this session
     m_consoleFinder.FreeConsole();
@@ -672,7 +671,7 @@ void DbgGdb::Poke()
 
     // poll the debugger output
     wxString curline;
-    if(!m_gdbProcess || m_gdbOutputArr.IsEmpty()) {
+    if(!m_gdbProcess || m_gdbOutput.IsEmpty()) {
         return;
     }
 
@@ -1199,31 +1198,12 @@ void DbgGdb::OnDataRead(clProcessEvent& e)
     if(!m_gdbProcess || !m_gdbProcess->IsAlive()) return;
 
     CL_DEBUG("GDB>> %s", bufferRead);
-    wxArrayString lines = wxStringTokenize(bufferRead, wxT("\n"), wxTOKEN_STRTOK);
-    if(lines.IsEmpty()) return;
 
-    // Prepend the partially saved line from previous iteration to the first line
-    // of this iteration
-    lines.Item(0).Prepend(m_gdbOutputIncompleteLine);
-    m_gdbOutputIncompleteLine.Clear();
+    // Split the output into complete lines, a partial line at the end of the
+    // buffer is kept by the queue until the next read completes it
+    m_gdbOutput.Append(bufferRead);
 
-    // If the last line is in-complete, remove it from the array and keep it for next iteration
-    if(!bufferRead.EndsWith(wxT("\n"))) {
-        m_gdbOutputIncompleteLine = lines.Last();
-        lines.RemoveAt(lines.GetCount() - 1);
-    }
-
-    for(size_t i = 0; i < lines.GetCount(); i++) {
-        wxString line = lines.Item(i);
-
-        line.Replace(wxT("(gdb)"), wxT(""));
-        line.Trim().Trim(false);
-        if(line.IsEmpty() == false) {
-            m_gdbOutputArr.Add(line);
-        }
-    }
-
-    if(m_gdbOutputArr.IsEmpty() == false) {
+    if(m_gdbOutput.IsEmpty() == false) {
         // Trigger GDB processing
         Poke();
     }
@@ -1231,18 +1211,8 @@ void DbgGdb::OnDataRead(clProcessEvent& e)
 
 bool DbgGdb::DoGetNextLine(wxString& line)
 {
-    line.Clear();
-    if(m_gdbOutputArr.IsEmpty()) {
-        return false;
-    }
-    line = m_gdbOutputArr.Item(0);
-    m_gdbOutputArr.RemoveAt(0);
-    line.Replace(wxT("(gdb)"), wxT(""));
-    line.Trim().Trim(false);
-    if(line.IsEmpty()) {
-        return false;
-    }
-    return true;
+    // Lines are queued already trimmed and without the "(gdb)" prompt
+    return m_gdbOutput.Pop(line);
 }
 
 void DbgGdb::SetInternalMainBpID(int bpId) { m_internalBpId = bpId; }
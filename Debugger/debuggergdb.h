@@ -32,6 +32,7 @@
 #include <wx/hashmap.h>
 #include "consolefinder.h"
 #include "cl_command_event.h"
+#include "gdbmi_record_parser.h"
 
 #ifdef MSVC_VER
 // declare the debugger function creation
@@ -63,8 +64,7 @@ class DbgGdb : public wxEvtHandler, public IDebugger
     std::vector<BreakpointInfo> m_bpList;
     DbgCmdCLIHandler* m_cliHandler;
     IProcess* m_gdbProcess;
-    wxArrayString m_gdbOutputArr;
-    wxString m_gdbOutputIncompleteLine;
+    GdbMILineQueue m_gdbOutput;
     bool m_break_at_main;
     bool m_attachedMode;
     bool m_goingDown;
@@ -30,7 +30,6 @@
 #include <map>
 #include <string>
 
-extern std::string gdb_result_string;
 typedef std::map<std::string, std::string> GdbStringMap_t;
 typedef std::vector<GdbStringMap_t>        GdbChildren_t;
 
@@ -65,13 +64,4 @@ struct GdbChildrenInfo {
     
 };
 
-extern bool setGdbLexerInput(const std::string &in, bool ascii, bool wantWhitespace = false);
-extern void gdbParseListChildren( const std::string &in, GdbChildrenInfo &children);
-extern void gdbParseRegisterNames( const std::string &in, std::vector<std::string>& names );
-extern void gdb_parse_result(const std::string &in);
-extern void gdb_result_push_buffer(const std::string &new_input);
-extern void gdb_result_pop_buffer();
-extern int  gdb_result_lex();
-extern void gdb_result_lex_clean();
-
 #endif // _GDB_PARSER_H_
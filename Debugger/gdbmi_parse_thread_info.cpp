@@ -24,6 +24,7 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "gdbmi_parse_thread_info.h"
+#include "gdbmi_record_parser.h"
 
 GdbMIThreadInfoParser::GdbMIThreadInfoParser()
 {
@@ -38,76 +39,28 @@ void GdbMIThreadInfoParser::Parse(const wxString& info)
     m_threads.clear();
     // an example for -thread-info output
     // ^done,threads=[{id="30",target-id="Thread5060.0x1174",frame={level="0",addr="0x77a1000d",func="foo",args=[],from="C:\path\to\file"},state="stopped"},{..}],current-thread-id="30"
-    wxString buffer = info;
-    wxString threadsInfo;
-    wxString threadBlock;
-    
-    if ( !ReadBlock(buffer, "[]", threadsInfo) )
+    GdbMIRecord record;
+    record.Parse(info);
+
+    GdbMIValue threads = record["threads"];
+    if(!threads.IsList())
         return;
-    
-    wxString activeThreadId;
-    ReadKeyValuePair(buffer, "current-thread-id=", activeThreadId);
-    
-    while ( ReadBlock(threadsInfo, "{}", threadBlock) ) {
+
+    wxString activeThreadId = record["current-thread-id"].GetString();
+
+    GdbMIValue thread = threads.GetFirstChild();
+    for(; thread.IsOk(); thread = thread.GetNext()) {
+        if(!thread.IsTuple())
+            continue;
+
         GdbMIThreadInfo ti;
-        ReadKeyValuePair(threadBlock, "id=",        ti.threadId);
-        ReadKeyValuePair(threadBlock, "target-id=", ti.extendedName);
-        ReadKeyValuePair(threadBlock, "func=",      ti.function);
-        ReadKeyValuePair(threadBlock, "file=",      ti.file);
-        ReadKeyValuePair(threadBlock, "line=",      ti.line);
+        GdbMIValue frame = thread["frame"];
+        ti.threadId     = thread["id"].GetString();
+        ti.extendedName = thread["target-id"].GetString();
+        ti.function     = frame["func"].GetString();
+        ti.file         = frame["file"].GetString();
+        ti.line         = frame["line"].GetString();
         ti.active = activeThreadId == ti.threadId ? "Yes" : "No";
         m_threads.push_back( ti );
     }
 }
-
-bool GdbMIThreadInfoParser::ReadBlock(wxString& input, const wxString& pair, wxString& block)
-{
-    wxChar openChar  = pair.GetChar(0);
-    wxChar closeChar = pair.GetChar(1);
-    block.clear();
-    int depth = 0;
-    
-    const int StateSearchStart = 0;
-    const int StateCollecting  = 1;
-    
-    int curstate = StateSearchStart;
-    for(size_t i=0; i<input.length(); ++i) {
-        wxChar ch = input.GetChar(i);
-        switch ( curstate ) {
-        case StateSearchStart:
-            if ( ch == openChar ) {
-                depth++;
-                curstate = StateCollecting;
-            }
-            break;
-        case StateCollecting:
-            // Incase the open/close are the same, always
-            // test for closeure before an open
-            if ( ch == closeChar ) {
-                depth--;
-                if ( depth == 0 ) {
-                    // remove the content up to the current position
-                    // from input and return the collected block
-                    input = input.Mid(i);
-                    return true;
-                }
-            } else if ( ch == openChar ) {
-                depth++;
-            }
-            
-            block << ch;
-            break;
-        }
-    }
-    return false;
-}
-
-bool GdbMIThreadInfoParser::ReadKeyValuePair(const wxString& input, const wxString& key, wxString& value)
-{
-    int where = input.Find(key);
-    if ( where == wxNOT_FOUND )
-        return false;
-    
-    wxString sub = input.Mid(where);
-    return ReadBlock(sub, "\"\"", value);
-}
@@ -64,9 +64,6 @@ typedef std::vector<GdbMIThreadInfo> GdbMIThreadInfoVec_t;
 class GdbMIThreadInfoParser
 {
     GdbMIThreadInfoVec_t m_threads;
-protected:
-    bool ReadBlock(wxString &input, const wxString &pair, wxString& block);
-    bool ReadKeyValuePair(const wxString &input, const wxString &key, wxString &value);
 
 public:
     GdbMIThreadInfoParser();
@@ -0,0 +1,672 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : gdbmi_record_parser.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "gdbmi_record_parser.h"
+#include <string.h>
+
+// Guard against runaway recursion on malformed input
+static const int MAX_NESTING_DEPTH = 256;
+
+static inline bool IsOctal(char ch) { return ch >= '0' && ch <= '7'; }
+
+static inline bool IsOctalEscape(const char* p, size_t len, size_t i)
+{
+    return (i + 2 < len) && IsOctal(p[i]) && IsOctal(p[i + 1]) && IsOctal(p[i + 2]);
+}
+
+static inline char OctalValue(const char* p) { return (char)(((p[0] - '0') << 6) | ((p[1] - '0') << 3) | (p[2] - '0')); }
+
+/**
+ * @brief decode a string body the same way the old flex scanner (in "ascii" mode) did:
+ * octal escapes are converted into bytes, doubled escapes lose one level and \" is kept as is.
+ * When 'escaped' is true the string was opened with \" and ends with \", otherwise it ends with
+ * a plain quote. Return true if the terminator was found
+ */
+static bool DecodeLegacyString(const char* p, size_t len, size_t& i, bool escaped, std::string& out)
+{
+    while(i < len) {
+        char ch = p[i];
+        if(ch == '"' && !escaped) {
+            ++i;
+            return true;
+        }
+
+        if(ch != '\\') {
+            out += ch;
+            ++i;
+            continue;
+        }
+
+        size_t left = len - i;
+        if(left >= 5 && p[i + 1] == '\\' && IsOctalEscape(p, len, i + 2)) {
+            // \\NNN
+            char byte = OctalValue(p + i + 2);
+            if(byte) out += byte;
+            i += 5;
+
+        } else if(!escaped && left >= 4 && IsOctalEscape(p, len, i + 1)) {
+            // \NNN
+            char byte = OctalValue(p + i + 1);
+            if(byte) out += byte;
+            i += 4;
+
+        } else if(left >= 4 && p[i + 1] == '\\' && p[i + 2] == '\\' && p[i + 3] == '\\') {
+            out += '\\';
+            i += 4;
+
+        } else if(left >= 4 && p[i + 1] == '\\' && p[i + 2] == '\\' && p[i + 3] == '"') {
+            out += "\\\"";
+            i += 4;
+
+        } else if(left >= 3 && p[i + 1] == '\\' &&
+                  (p[i + 2] == 'n' || p[i + 2] == 'v' || p[i + 2] == 'r' || p[i + 2] == 't')) {
+            out += '\\';
+            out += p[i + 2];
+            i += 3;
+
+        } else if(left >= 2 && p[i + 1] == '"') {
+            i += 2;
+            if(escaped) {
+                return true;
+            }
+            out += "\\\"";
+
+        } else if(!escaped && left >= 2 && p[i + 1] == '\\') {
+            out += '\\';
+            i += 2;
+
+        } else {
+            out += ch;
+            ++i;
+        }
+    }
+    return false;
+}
+
+//===------------------------------------------------
+// GdbMIStringView
+//===------------------------------------------------
+
+bool GdbMIStringView::operator==(const char* str) const
+{
+    size_t len = strlen(str);
+    return len == length && (len == 0 || memcmp(data, str, len) == 0);
+}
+
+//===------------------------------------------------
+// GdbMIValue
+//===------------------------------------------------
+
+GdbMIValue::eType GdbMIValue::GetType() const { return m_record->m_nodes[m_index].type; }
+
+GdbMIStringView GdbMIValue::GetName() const
+{
+    if(!IsOk()) return GdbMIStringView();
+    const GdbMIRecord::Node& node = m_record->m_nodes[m_index];
+    return GdbMIStringView(m_record->m_buffer.c_str() + node.nameOffset, node.nameLength);
+}
+
+GdbMIStringView GdbMIValue::GetRawValue() const
+{
+    if(!IsConst()) return GdbMIStringView();
+    const GdbMIRecord::Node& node = m_record->m_nodes[m_index];
+    return GdbMIStringView(m_record->m_buffer.c_str() + node.valueOffset, node.valueLength);
+}
+
+std::string GdbMIValue::GetUTF8String() const { return GdbMIRecord::Unescape(GetRawValue()); }
+
+wxString GdbMIValue::GetString() const
+{
+    std::string str = GetUTF8String();
+    return wxString(str.c_str(), wxConvUTF8, str.length());
+}
+
+size_t GdbMIValue::GetCount() const
+{
+    if(!IsOk()) return 0;
+    return m_record->m_nodes[m_index].count;
+}
+
+GdbMIValue GdbMIValue::GetFirstChild() const
+{
+    if(!IsOk()) return GdbMIValue();
+    return GdbMIValue(m_record, m_record->m_nodes[m_index].firstChild);
+}
+
+GdbMIValue GdbMIValue::GetNext() const
+{
+    if(!IsOk()) return GdbMIValue();
+    return GdbMIValue(m_record, m_record->m_nodes[m_index].next);
+}
+
+GdbMIValue GdbMIValue::Find(const char* name) const
+{
+    GdbMIValue child = GetFirstChild();
+    for(; child.IsOk(); child = child.GetNext()) {
+        if(child.GetName() == name) {
+            return child;
+        }
+    }
+    return GdbMIValue();
+}
+
+//===------------------------------------------------
+// GdbMIRecord
+//===------------------------------------------------
+
+GdbMIRecord::GdbMIRecord()
+    : m_kind(kInvalid)
+    , m_tokenOffset(0)
+    , m_tokenLength(0)
+    , m_classOffset(0)
+    , m_classLength(0)
+{
+}
+
+GdbMIRecord::~GdbMIRecord() {}
+
+bool GdbMIRecord::Parse(const wxString& line) { return Parse(std::string(line.mb_str(wxConvUTF8).data())); }
+
+bool GdbMIRecord::Parse(const std::string& line)
+{
+    m_buffer = line;
+    m_nodes.clear();
+    m_kind = kInvalid;
+    m_tokenOffset = m_tokenLength = 0;
+    m_classOffset = m_classLength = 0;
+
+    const char* p = m_buffer.c_str();
+    size_t len = m_buffer.length();
+    size_t pos = 0;
+
+    // Skip leading whitespace and the optional command token
+    while(pos < len && (p[pos] == ' ' || p[pos] == '\t')) {
+        ++pos;
+    }
+    m_tokenOffset = pos;
+    while(pos < len && p[pos] >= '0' && p[pos] <= '9') {
+        ++pos;
+    }
+    m_tokenLength = pos - m_tokenOffset;
+
+    if(pos >= len) return false;
+    switch(p[pos]) {
+    case '^':
+        m_kind = kResult;
+        break;
+    case '*':
+        m_kind = kExecAsync;
+        break;
+    case '+':
+        m_kind = kStatusAsync;
+        break;
+    case '=':
+        m_kind = kNotifyAsync;
+        break;
+    case '~':
+        m_kind = kConsoleStream;
+        break;
+    case '@':
+        m_kind = kTargetStream;
+        break;
+    case '&':
+        m_kind = kLogStream;
+        break;
+    default:
+        return false;
+    }
+    ++pos;
+
+    if(m_kind == kConsoleStream || m_kind == kTargetStream || m_kind == kLogStream) {
+        // ~"text"
+        if(pos >= len || p[pos] != '"') return false;
+        int node = DoAddNode(-1, GdbMIValue::kConst, pos, 0);
+        return DoParseConst(pos, node);
+    }
+
+    // The record class: ^done, *stopped ...
+    m_classOffset = pos;
+    while(pos < len && p[pos] != ',' && p[pos] != ' ' && p[pos] != '\t' && p[pos] != '\r') {
+        ++pos;
+    }
+    m_classLength = pos - m_classOffset;
+
+    DoAddNode(-1, GdbMIValue::kTuple, pos, 0);
+    while(pos < len && p[pos] == ',') {
+        ++pos;
+        if(!DoParseResult(pos, 0, 0)) {
+            return false;
+        }
+    }
+
+    while(pos < len && (p[pos] == ' ' || p[pos] == '\t' || p[pos] == '\r')) {
+        ++pos;
+    }
+    return pos == len;
+}
+
+int GdbMIRecord::DoAddNode(int parent, GdbMIValue::eType type, size_t nameOffset, size_t nameLength)
+{
+    Node node;
+    node.type = type;
+    node.nameOffset = nameOffset;
+    node.nameLength = nameLength;
+    node.valueOffset = 0;
+    node.valueLength = 0;
+    node.firstChild = -1;
+    node.lastChild = -1;
+    node.next = -1;
+    node.count = 0;
+
+    int index = (int)m_nodes.size();
+    m_nodes.push_back(node);
+
+    if(parent != -1) {
+        Node& parentNode = m_nodes[parent];
+        if(parentNode.lastChild == -1) {
+            parentNode.firstChild = index;
+        } else {
+            m_nodes[parentNode.lastChild].next = index;
+        }
+        parentNode.lastChild = index;
+        ++parentNode.count;
+    }
+    return index;
+}
+
+bool GdbMIRecord::DoParseResult(size_t& pos, int parent, int depth)
+{
+    // name=value
+    const char* p = m_buffer.c_str();
+    size_t len = m_buffer.length();
+
+    size_t nameOffset = pos;
+    while(pos < len && p[pos] != '=' && p[pos] != ',' && p[pos] != '}' && p[pos] != ']') {
+        ++pos;
+    }
+    if(pos >= len || p[pos] != '=') return false;
+
+    size_t nameLength = pos - nameOffset;
+    ++pos;
+    return DoParseValue(pos, parent, nameOffset, nameLength, depth);
+}
+
+bool GdbMIRecord::DoParseValue(size_t& pos, int parent, size_t nameOffset, size_t nameLength, int depth)
+{
+    const char* p = m_buffer.c_str();
+    size_t len = m_buffer.length();
+    if(depth > MAX_NESTING_DEPTH || pos >= len) return false;
+
+    char ch = p[pos];
+    if(ch == '"') {
+        int node = DoAddNode(parent, GdbMIValue::kConst, nameOffset, nameLength);
+        return DoParseConst(pos, node);
+
+    } else if(ch == '{' || ch == '[') {
+        char closeChar = (ch == '{') ? '}' : ']';
+        int node = DoAddNode(parent, (ch == '{') ? GdbMIValue::kTuple : GdbMIValue::kList, nameOffset, nameLength);
+        ++pos;
+        if(pos < len && p[pos] == closeChar) {
+            ++pos;
+            return true;
+        }
+
+        while(pos < len) {
+            // Lists may hold either plain values or results, be lenient and accept both in tuples as well
+            char first = p[pos];
+            bool ok = (first == '"' || first == '{' || first == '[') ? DoParseValue(pos, node, pos, 0, depth + 1) :
+                                                                       DoParseResult(pos, node, depth + 1);
+            if(!ok || pos >= len) return false;
+
+            if(p[pos] == ',') {
+                ++pos;
+            } else if(p[pos] == closeChar) {
+                ++pos;
+                return true;
+            } else {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool GdbMIRecord::DoParseConst(size_t& pos, int node)
+{
+    // pos is placed on the opening quote
+    const char* p = m_buffer.c_str();
+    size_t len = m_buffer.length();
+
+    size_t start = ++pos;
+    while(pos < len && p[pos] != '"') {
+        pos += (p[pos] == '\\') ? 2 : 1;
+    }
+
+    bool terminated = (pos < len);
+    if(!terminated) {
+        pos = len;
+    }
+
+    m_nodes[node].valueOffset = start;
+    m_nodes[node].valueLength = pos - start;
+    if(terminated) {
+        ++pos; // skip the closing quote
+    }
+    return terminated;
+}
+
+// The attribute values keep their quotes, the way the former flex/yacc parser returned them
+static std::string ToLegacyValue(const GdbMIStringView& raw)
+{
+    std::string value = "\"";
+    size_t i = 0;
+    DecodeLegacyString(raw.data, raw.length, i, false, value);
+    value += "\"";
+    return value;
+}
+
+void GdbMIRecord::DoCollectAttributes(const GdbMIValue& tuple, GdbStringMap_t& attributes, GdbChildrenInfo& info) const
+{
+    GdbMIValue hasMore, dynamic;
+
+    GdbMIValue child = tuple.GetFirstChild();
+    for(; child.IsOk(); child = child.GetNext()) {
+        if(!child.IsConst()) continue;
+
+        GdbMIStringView name = child.GetName();
+        attributes[name.ToStdString()] = ToLegacyValue(child.GetRawValue());
+
+        if(name == "has_more") {
+            hasMore = child;
+        } else if(name == "dynamic") {
+            dynamic = child;
+        }
+    }
+
+    if(hasMore.IsOk()) {
+        info.has_more = (hasMore.GetRawValue() == "1");
+    } else if(dynamic.IsOk()) {
+        info.has_more = (dynamic.GetRawValue() == "1");
+    }
+}
+
+void GdbMIRecord::DoPushAttributes(const GdbMIValue& tuple, GdbChildrenInfo& info) const
+{
+    GdbStringMap_t attributes;
+    DoCollectAttributes(tuple, attributes, info);
+    info.push_back(attributes);
+}
+
+void GdbMIRecord::ToChildrenInfo(GdbChildrenInfo& info) const
+{
+    info.clear();
+
+    GdbMIValue results = GetResults();
+    if(!results.IsTuple()) return;
+
+    if(m_kind == kExecAsync && GetClass() == "stopped") {
+        // *stopped,time={wallclock="0.05185",user="0.00800",system="0.00000"},reason="end-stepping-range",...
+        // only the reason and the timing are collected
+        GdbMIValue reason = results["reason"];
+        if(!reason.IsConst()) return;
+
+        GdbStringMap_t attributes;
+        GdbMIValue time = results["time"];
+        if(time.IsTuple()) DoCollectAttributes(time, attributes, info);
+        attributes["reason"] = ToLegacyValue(reason.GetRawValue());
+        info.push_back(attributes);
+        return;
+    }
+
+    if(m_kind != kResult || GetClass() != "done") return;
+
+    GdbMIValue first = results.GetFirstChild();
+    if(!first.IsOk()) return;
+
+    GdbMIStringView name = first.GetName();
+    if(name == "numchild") {
+        // ^done,numchild="2",children=[child={name="var1.x",...},child={...}],has_more="0"
+        GdbMIValue child = results["children"].GetFirstChild();
+        for(; child.IsOk(); child = child.GetNext()) {
+            if(child.IsTuple()) DoPushAttributes(child, info);
+        }
+
+        GdbMIValue hasMore = results["has_more"];
+        if(hasMore.IsConst()) {
+            info.has_more = (hasMore.GetRawValue() == "1");
+        }
+
+    } else if(name == "name" || name == "value") {
+        // ^done,name="var1",numchild="2",value="{...}",type="ChildClass",thread-id="1",has_more="0"
+        DoPushAttributes(results, info);
+
+    } else if(name == "stack-args") {
+        // ^done,stack-args=[frame={level="0",args=[{name="argc",type="int",value="1"},...]}]
+        GdbMIValue frame = first.GetFirstChild();
+        for(; frame.IsOk(); frame = frame.GetNext()) {
+            GdbMIValue arg = frame["args"].GetFirstChild();
+            for(; arg.IsOk(); arg = arg.GetNext()) {
+                if(arg.IsTuple()) DoPushAttributes(arg, info);
+            }
+        }
+
+    } else if(name == "BreakpointTable") {
+        // ^done,BreakpointTable={nr_rows="1",nr_cols="6",hdr=[...],body=[bkpt={number="1",...}]}
+        GdbMIValue bkpt = first["body"].GetFirstChild();
+        for(; bkpt.IsOk(); bkpt = bkpt.GetNext()) {
+            if(bkpt.IsTuple()) DoPushAttributes(bkpt, info);
+        }
+
+    } else if(name == "frame") {
+        // ^done,frame={level="0",addr="0x0040143f",func="main",file="main.cpp",line="33"}
+        if(first.IsTuple()) DoPushAttributes(first, info);
+
+    } else if(name == "locals" || name == "variables" || name == "asm_insns" || name == "changelist") {
+        // ^done,locals=[{name="pcls",type="ChildClass *",value="0x0"},...]
+        // ^done,locals={varobj={exp="str",value="{...}",name="var6",...},...}
+        // ^done,asm_insns=[{address="0x000107c0",func-name="main",offset="4",inst="mov 2, %o0"},...]
+        // ^done,changelist=[{name="var2",in_scope="false",type_changed="false",has_more="0"},...]
+        GdbMIValue child = first.GetFirstChild();
+        for(; child.IsOk(); child = child.GetNext()) {
+            if(child.IsTuple()) DoPushAttributes(child, info);
+        }
+    }
+}
+
+std::string GdbMIRecord::Unescape(const GdbMIStringView& raw)
+{
+    std::string str;
+    str.reserve(raw.length);
+
+    const char* p = raw.data;
+    size_t len = raw.length;
+    for(size_t i = 0; i < len; ++i) {
+        char ch = p[i];
+        if(ch != '\\' || i + 1 >= len) {
+            str += ch;
+            continue;
+        }
+
+        ch = p[++i];
+        switch(ch) {
+        case 'n':
+            str += '\n';
+            break;
+        case 't':
+            str += '\t';
+            break;
+        case 'r':
+            str += '\r';
+            break;
+        case 'v':
+            str += '\v';
+            break;
+        case 'f':
+            str += '\f';
+            break;
+        case 'a':
+            str += '\a';
+            break;
+        case 'b':
+            str += '\b';
+            break;
+        default:
+            if(IsOctal(ch)) {
+                // up to 3 octal digits
+                int value = 0;
+                size_t digits = 0;
+                while(digits < 3 && i < len && IsOctal(p[i])) {
+                    value = (value << 3) | (p[i] - '0');
+                    ++digits;
+                    ++i;
+                }
+                --i;
+                str += (char)value;
+            } else {
+                // \\ \" and anything unknown
+                str += ch;
+            }
+            break;
+        }
+    }
+    return str;
+}
+
+std::string GdbMIRecord::FixValue(const std::string& value)
+{
+    // GDB MI tends to mess the strings embedded in values (e.g. char* values)
+    // normalize any embedded string the same way the old scanner did
+    std::string fixed;
+    fixed.reserve(value.length());
+
+    const char* p = value.c_str();
+    size_t len = value.length();
+    size_t i = 0;
+    while(i < len) {
+        if(p[i] == '"') {
+            fixed += '"';
+            ++i;
+            if(DecodeLegacyString(p, len, i, false, fixed)) {
+                fixed += '"';
+            }
+
+        } else if(p[i] == '\\' && i + 1 < len && p[i + 1] == '"') {
+            fixed += '"';
+            i += 2;
+            if(DecodeLegacyString(p, len, i, true, fixed)) {
+                fixed += '"';
+            }
+
+        } else {
+            fixed += p[i];
+            ++i;
+        }
+    }
+    return fixed;
+}
+
+//===------------------------------------------------
+// GdbMILineQueue
+//===------------------------------------------------
+
+GdbMILineQueue::GdbMILineQueue(size_t capacity)
+    : m_head(0)
+    , m_count(0)
+{
+    m_lines.resize(capacity ? capacity : 1);
+}
+
+GdbMILineQueue::~GdbMILineQueue() {}
+
+void GdbMILineQueue::DoGrow()
+{
+    // Unroll the ring into a buffer twice the size
+    std::vector<wxString> lines(m_lines.size() * 2);
+    for(size_t i = 0; i < m_count; ++i) {
+        lines[i].swap(m_lines[(m_head + i) % m_lines.size()]);
+    }
+    m_lines.swap(lines);
+    m_head = 0;
+}
+
+void GdbMILineQueue::Push(const wxString& line)
+{
+    if(m_count == m_lines.size()) {
+        DoGrow();
+    }
+    m_lines[(m_head + m_count) % m_lines.size()] = line;
+    ++m_count;
+}
+
+bool GdbMILineQueue::Pop(wxString& line)
+{
+    line.clear();
+    if(m_count == 0) {
+        return false;
+    }
+
+    line.swap(m_lines[m_head]);
+    m_lines[m_head].clear();
+    m_head = (m_head + 1) % m_lines.size();
+    --m_count;
+    return true;
+}
+
+void GdbMILineQueue::DoPushLine(wxString& line)
+{
+    line.Replace(wxT("(gdb)"), wxT(""));
+    line.Trim().Trim(false);
+    if(!line.IsEmpty()) {
+        Push(line);
+    }
+}
+
+void GdbMILineQueue::Append(const wxString& buffer)
+{
+    size_t start = 0;
+    while(start < buffer.length()) {
+        size_t where = buffer.find(wxT('\n'), start);
+        if(where == wxString::npos) {
+            // Incomplete line, keep it until the rest of it arrives
+            m_incompleteLine << buffer.Mid(start);
+            break;
+        }
+
+        m_incompleteLine << buffer.Mid(start, where - start);
+        DoPushLine(m_incompleteLine);
+        m_incompleteLine.clear();
+        start = where + 1;
+    }
+}
+
+void GdbMILineQueue::Clear()
+{
+    for(size_t i = 0; i < m_lines.size(); ++i) {
+        m_lines[i].clear();
+    }
+    m_head = 0;
+    m_count = 0;
+    m_incompleteLine.clear();
+}
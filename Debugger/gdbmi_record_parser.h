@@ -0,0 +1,256 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : gdbmi_record_parser.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef GDBMIRECORDPARSER_H
+#define GDBMIRECORDPARSER_H
+
+#include <wx/string.h>
+#include <string>
+#include <vector>
+#include "gdb_parser_incl.h"
+
+/**
+ * @class GdbMIStringView
+ * @brief a non owning view into the line buffer of a GdbMIRecord
+ */
+struct GdbMIStringView {
+    const char* data;
+    size_t length;
+
+    GdbMIStringView()
+        : data(NULL)
+        , length(0)
+    {
+    }
+    GdbMIStringView(const char* d, size_t len)
+        : data(d)
+        , length(len)
+    {
+    }
+
+    bool empty() const { return length == 0; }
+    bool operator==(const char* str) const;
+    bool operator!=(const char* str) const { return !(*this == str); }
+    std::string ToStdString() const { return data ? std::string(data, length) : std::string(); }
+};
+
+class GdbMIRecord;
+
+/**
+ * @class GdbMIValue
+ * @brief a handle to a node in the result tree of a GdbMIRecord.
+ * The handle (and anything returned by it) is only valid while the record is alive
+ * and was not re-parsed
+ */
+class GdbMIValue
+{
+public:
+    enum eType {
+        kConst = 0, // "c-string"
+        kTuple,     // { result, ... }
+        kList,      // [ value, ... ] or [ result, ... ]
+    };
+
+protected:
+    const GdbMIRecord* m_record;
+    int m_index;
+
+public:
+    GdbMIValue(const GdbMIRecord* record = NULL, int index = -1)
+        : m_record(record)
+        , m_index(index)
+    {
+    }
+
+    bool IsOk() const { return m_record && m_index != -1; }
+    eType GetType() const;
+    bool IsConst() const { return IsOk() && GetType() == kConst; }
+    bool IsTuple() const { return IsOk() && GetType() == kTuple; }
+    bool IsList() const { return IsOk() && GetType() == kList; }
+
+    /**
+     * @brief the result name (the part before the '='). Empty for plain list values
+     */
+    GdbMIStringView GetName() const;
+    /**
+     * @brief for a const value, return the text between the quotes as sent by gdb (still escaped)
+     */
+    GdbMIStringView GetRawValue() const;
+    /**
+     * @brief return the unescaped value of a const as UTF-8 / wxString
+     */
+    std::string GetUTF8String() const;
+    wxString GetString() const;
+
+    /**
+     * @brief number of children of a tuple or a list
+     */
+    size_t GetCount() const;
+    GdbMIValue GetFirstChild() const;
+    GdbMIValue GetNext() const;
+    /**
+     * @brief find a child result by its name
+     */
+    GdbMIValue Find(const char* name) const;
+    GdbMIValue operator[](const char* name) const { return Find(name); }
+};
+
+/**
+ * @class GdbMIRecord
+ * @brief a single GDB/MI output record parsed into a typed tree.
+ * Parsing is done in a single pass over the UTF-8 line, all names and values are
+ * views into the record's own buffer and are unescaped only when requested.
+ * The parser keeps no global state, so records can be parsed on any thread
+ */
+class GdbMIRecord
+{
+public:
+    enum eKind {
+        kInvalid = 0,
+        kResult,        // ^done, ^error, ^running...
+        kExecAsync,     // *stopped, *running
+        kStatusAsync,   // +download
+        kNotifyAsync,   // =thread-created ...
+        kConsoleStream, // ~"text"
+        kTargetStream,  // @"text"
+        kLogStream,     // &"text"
+    };
+
+    struct Node {
+        GdbMIValue::eType type;
+        size_t nameOffset;
+        size_t nameLength;
+        size_t valueOffset;
+        size_t valueLength;
+        int firstChild;
+        int lastChild;
+        int next;
+        size_t count;
+    };
+
+protected:
+    std::string m_buffer;
+    std::vector<Node> m_nodes;
+    eKind m_kind;
+    size_t m_tokenOffset;
+    size_t m_tokenLength;
+    size_t m_classOffset;
+    size_t m_classLength;
+
+    friend class GdbMIValue;
+
+protected:
+    int DoAddNode(int parent, GdbMIValue::eType type, size_t nameOffset, size_t nameLength);
+    bool DoParseResult(size_t& pos, int parent, int depth);
+    bool DoParseValue(size_t& pos, int parent, size_t nameOffset, size_t nameLength, int depth);
+    bool DoParseConst(size_t& pos, int node);
+    void DoCollectAttributes(const GdbMIValue& tuple, GdbStringMap_t& attributes, GdbChildrenInfo& info) const;
+    void DoPushAttributes(const GdbMIValue& tuple, GdbChildrenInfo& info) const;
+
+public:
+    GdbMIRecord();
+    virtual ~GdbMIRecord();
+
+    /**
+     * @brief parse a single line of gdb output. Return false if the line is not a valid
+     * MI record; whatever was parsed before the error is still accessible
+     */
+    bool Parse(const wxString& line);
+    bool Parse(const std::string& line);
+
+    eKind GetKind() const { return m_kind; }
+    /**
+     * @brief the (optional) numeric token that prefixed the record
+     */
+    GdbMIStringView GetToken() const { return GdbMIStringView(m_buffer.c_str() + m_tokenOffset, m_tokenLength); }
+    /**
+     * @brief the result/async class, e.g. "done" or "stopped"
+     */
+    GdbMIStringView GetClass() const { return GdbMIStringView(m_buffer.c_str() + m_classOffset, m_classLength); }
+    /**
+     * @brief the top level results as a tuple. For stream records this is the const
+     * holding the streamed text
+     */
+    GdbMIValue GetResults() const { return GdbMIValue(m_nodes.empty() ? NULL : this, m_nodes.empty() ? -1 : 0); }
+    GdbMIValue operator[](const char* name) const { return GetResults().Find(name); }
+
+    /**
+     * @brief flatten the record into the legacy "list of attribute maps" form.
+     * The attribute values are kept quoted and normalized the way the old flex scanner did,
+     * so they can be passed to the existing helpers (wxRemoveQuotes, FixValue...)
+     */
+    void ToChildrenInfo(GdbChildrenInfo& info) const;
+
+    /**
+     * @brief unescape a GDB/MI c-string body
+     */
+    static std::string Unescape(const GdbMIStringView& raw);
+    /**
+     * @brief normalize a value that may contain escaped strings for display
+     */
+    static std::string FixValue(const std::string& value);
+};
+
+/**
+ * @class GdbMILineQueue
+ * @brief a ring buffer of complete gdb output lines.
+ * Raw process output is appended as it arrives, the partial line at the end of a chunk
+ * is kept until the rest of it arrives
+ */
+class GdbMILineQueue
+{
+    std::vector<wxString> m_lines;
+    size_t m_head;
+    size_t m_count;
+    wxString m_incompleteLine;
+
+protected:
+    void DoPushLine(wxString& line);
+    void DoGrow();
+
+public:
+    GdbMILineQueue(size_t capacity = 64);
+    virtual ~GdbMILineQueue();
+
+    /**
+     * @brief split a raw chunk of output into lines and queue them. "(gdb)" prompts and
+     * empty lines are dropped
+     */
+    void Append(const wxString& buffer);
+    /**
+     * @brief queue a single line
+     */
+    void Push(const wxString& line);
+    /**
+     * @brief pop the oldest line. Return false if the queue is empty
+     */
+    bool Pop(wxString& line);
+
+    bool IsEmpty() const { return m_count == 0; }
+    size_t GetCount() const { return m_count; }
+    void Clear();
+};
+
+#endif // GDBMIRECORDPARSER_H
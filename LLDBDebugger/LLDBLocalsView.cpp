@@ -60,6 +60,7 @@ LLDBLocalsView::LLDBLocalsView(wxWindow* parent, LLDBPlugin* plugin)
     m_plugin->GetLLDB()->Bind(wxEVT_LLDB_STARTED, &LLDBLocalsView::OnLLDBStarted, this);
     m_plugin->GetLLDB()->Bind(wxEVT_LLDB_EXITED, &LLDBLocalsView::OnLLDBExited, this);
     m_plugin->GetLLDB()->Bind(wxEVT_LLDB_LOCALS_UPDATED, &LLDBLocalsView::OnLLDBLocalsUpdated, this);
+    m_plugin->GetLLDB()->Bind(wxEVT_LLDB_LOCALS_CHANGED, &LLDBLocalsView::OnLLDBLocalsChanged, this);
     m_plugin->GetLLDB()->Bind(wxEVT_LLDB_RUNNING, &LLDBLocalsView::OnLLDBRunning, this);
     m_plugin->GetLLDB()->Bind(wxEVT_LLDB_VARIABLE_EXPANDED, &LLDBLocalsView::OnLLDBVariableExpanded, this);
 
@@ -73,6 +74,7 @@ LLDBLocalsView::~LLDBLocalsView()
     m_plugin->GetLLDB()->Unbind(wxEVT_LLDB_STARTED, &LLDBLocalsView::OnLLDBStarted, this);
     m_plugin->GetLLDB()->Unbind(wxEVT_LLDB_EXITED, &LLDBLocalsView::OnLLDBExited, this);
     m_plugin->GetLLDB()->Unbind(wxEVT_LLDB_LOCALS_UPDATED, &LLDBLocalsView::OnLLDBLocalsUpdated, this);
+    m_plugin->GetLLDB()->Unbind(wxEVT_LLDB_LOCALS_CHANGED, &LLDBLocalsView::OnLLDBLocalsChanged, this);
     m_plugin->GetLLDB()->Unbind(wxEVT_LLDB_RUNNING, &LLDBLocalsView::OnLLDBRunning, this);
     m_plugin->GetLLDB()->Unbind(wxEVT_LLDB_VARIABLE_EXPANDED, &LLDBLocalsView::OnLLDBVariableExpanded, this);
     m_treeList->Unbind(wxEVT_COMMAND_TREE_ITEM_EXPANDING, &LLDBLocalsView::OnItemExpanding, this);
@@ -88,7 +90,10 @@ void LLDBLocalsView::OnLLDBExited(LLDBEvent& event)
 void LLDBLocalsView::OnLLDBRunning(LLDBEvent& event)
 {
     event.Skip();
-    Cleanup();
+    // Keep the rows: if the debuggee stops in the same frame, codelite-lldb
+    // only sends the variables that changed (wxEVT_LLDB_LOCALS_CHANGED)
+    m_pendingExpandItems.clear();
+    Enable(false);
 }
 
 void LLDBLocalsView::OnLLDBStarted(LLDBEvent& event)
@@ -99,8 +104,8 @@ void LLDBLocalsView::OnLLDBStarted(LLDBEvent& event)
 
 void LLDBLocalsView::OnLLDBLocalsUpdated(LLDBEvent& event)
 {
-    // FIXME: optimize this to only retrieve the top levle variables
-    // the children should be obtained in the 'OnItemExpading' event handler
+    // Only the top level variables are sent, the children are
+    // obtained page by page in the 'OnItemExpading' event handler
     event.Skip();
     wxWindowUpdateLocker locker(m_treeList);
     Enable(true);
@@ -135,8 +140,75 @@ void LLDBLocalsView::DoAddVariableToView(const LLDBVariable::Vect_t& variables,
     }
 }
 
+void LLDBLocalsView::OnLLDBLocalsChanged(LLDBEvent& event)
+{
+    event.Skip();
+    wxWindowUpdateLocker locker(m_treeList);
+    Enable(true);
+
+    std::map<int, LLDBVariable::Ptr_t> changed;
+    const LLDBVariable::Vect_t& variables = event.GetVariables();
+    for(size_t i = 0; i < variables.size(); ++i) {
+        changed.insert(std::make_pair(variables.at(i)->GetLldbId(), variables.at(i)));
+    }
+    CL_DEBUG("Updating %d changed variables in the locals view", (int)changed.size());
+    DoUpdateChangedVariables(m_treeList->GetRootItem(), changed);
+}
+
+void LLDBLocalsView::DoUpdateChangedVariables(wxTreeItemId parent, const std::map<int, LLDBVariable::Ptr_t>& changed)
+{
+    wxTreeItemIdValue cookie;
+    wxTreeItemId item = m_treeList->GetFirstChild(parent, cookie);
+    while(item.IsOk()) {
+        // clear the highlight from the previous stop
+        m_treeList->SetItemTextColour(item, wxNullColour);
+
+        LLDBVariableClientData* cd = GetItemData(item);
+        std::map<int, LLDBVariable::Ptr_t>::const_iterator iter =
+            cd ? changed.find(cd->GetVariable()->GetLldbId()) : changed.end();
+        if(iter != changed.end()) {
+            LLDBVariable::Ptr_t variable = iter->second;
+            cd->SetVariable(variable);
+            m_treeList->SetItemText(
+                item,
+                LOCALS_VIEW_SUMMARY_COL_IDX,
+                variable->GetSummary().IsEmpty() ? variable->GetValue() : variable->GetSummary());
+            m_treeList->SetItemText(item, LOCALS_VIEW_VALUE_COL_IDX, variable->GetValue());
+            m_treeList->SetItemText(item, LOCALS_VIEW_TYPE_COL_IDX, variable->GetType());
+            m_treeList->SetItemTextColour(item, "RED");
+
+            // the children we fetched may no longer be valid (e.g. a pointer changed)
+            // fold the item back so they are requested again on the next expand
+            if(m_treeList->GetChildrenCount(item, false)) {
+                m_treeList->Collapse(item);
+                m_treeList->DeleteChildren(item);
+            }
+            if(variable->HasChildren()) {
+                m_treeList->AppendItem(item, "<dummy>");
+            }
+
+        } else if(m_treeList->HasChildren(item)) {
+            DoUpdateChangedVariables(item, changed);
+        }
+        item = m_treeList->GetNextChild(parent, cookie);
+    }
+}
+
 void LLDBLocalsView::OnItemExpanding(wxTreeEvent& event)
 {
+    LLDBVariablePageClientData* page =
+        dynamic_cast<LLDBVariablePageClientData*>(m_treeList->GetItemData(event.GetItem()));
+    if(page) {
+        // "[N more...]" placeholder: fetch the next page into the parent item
+        event.Veto();
+        if(m_plugin->GetLLDB()->IsCanInteract()) {
+            m_plugin->GetLLDB()->RequestVariableChildren(page->GetParentId(), page->GetStartIndex());
+            m_pendingExpandItems.insert(
+                std::make_pair(page->GetParentId(), m_treeList->GetItemParent(event.GetItem())));
+        }
+        return;
+    }
+
     wxTreeItemIdValue cookie;
     wxTreeItemId child = m_treeList->GetFirstChild(event.GetItem(), cookie);
     if(m_treeList->GetItemText(child) == "<dummy>") {
@@ -178,8 +250,14 @@ void LLDBLocalsView::OnLLDBVariableExpanded(LLDBEvent& event)
         return;
     }
 
+    // remove the "[N more...]" placeholder, the new page replaces it
+    wxTreeItemId parent = iter->second;
+    LLDBVariablePageClientData::DeletePlaceholders(m_treeList, parent);
+
     // add the variables
-    DoAddVariableToView(event.GetVariables(), iter->second);
+    DoAddVariableToView(event.GetVariables(), parent);
+    LLDBVariablePageClientData::AppendPlaceholder(
+        m_treeList, parent, variableId, event.GetStartIndex() + kLLDBVariablePageSize, event.GetTotalCount());
     m_pendingExpandItems.erase(iter);
 }
 
@@ -43,6 +43,7 @@ class LLDBLocalsView : public LLDBLocalsViewBase
     
 private:
     void DoAddVariableToView(const LLDBVariable::Vect_t& variables, wxTreeItemId parent);
+    void DoUpdateChangedVariables(wxTreeItemId parent, const std::map<int, LLDBVariable::Ptr_t>& changed);
     LLDBVariableClientData *GetItemData(const wxTreeItemId &id);
     void Cleanup();
     void GetWatchesFromSelections(wxArrayTreeItemIds& items);
@@ -55,6 +56,7 @@ protected:
     void OnLLDBStarted(LLDBEvent &event);
     void OnLLDBExited(LLDBEvent &event);
     void OnLLDBLocalsUpdated(LLDBEvent &event);
+    void OnLLDBLocalsChanged(LLDBEvent &event);
     void OnLLDBRunning(LLDBEvent &event);
     void OnLLDBVariableExpanded(LLDBEvent &event);
     
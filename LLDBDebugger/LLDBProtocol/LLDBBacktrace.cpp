@@ -133,3 +133,43 @@ JSONElement LLDBBacktrace::Entry::ToJSON() const
     json.addProperty("address", address);
     return json;
 }
+
+void LLDBBacktrace::ToBinary(LLDBPacketWriter& writer) const
+{
+    writer.WriteInt(m_threadId);
+    writer.WriteInt(m_selectedFrameId);
+    writer.WriteUInt(m_callstack.size());
+    for(size_t i = 0; i < m_callstack.size(); ++i) {
+        m_callstack.at(i).ToBinary(writer);
+    }
+}
+
+void LLDBBacktrace::FromBinary(LLDBPacketReader& reader)
+{
+    m_callstack.clear();
+    m_threadId = reader.ReadInt();
+    m_selectedFrameId = reader.ReadInt();
+    size_t count = reader.ReadCount();
+    m_callstack.resize(count);
+    for(size_t i = 0; i < count; ++i) {
+        m_callstack.at(i).FromBinary(reader);
+    }
+}
+
+void LLDBBacktrace::Entry::ToBinary(LLDBPacketWriter& writer) const
+{
+    writer.WriteInt(id);
+    writer.WriteInt(line);
+    writer.WriteString(filename);
+    writer.WriteString(functionName);
+    writer.WriteString(address);
+}
+
+void LLDBBacktrace::Entry::FromBinary(LLDBPacketReader& reader)
+{
+    id = reader.ReadInt();
+    line = reader.ReadInt();
+    filename = reader.ReadString();
+    functionName = reader.ReadString();
+    address = reader.ReadString();
+}
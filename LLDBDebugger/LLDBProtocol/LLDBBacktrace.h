@@ -47,6 +47,7 @@
 #endif
 
 #include "json_node.h"
+#include "LLDBPacket.h"
 
 /**
  * @class LLDBBacktrace
@@ -64,6 +65,8 @@ public:
 
         JSONElement ToJSON() const;
         void FromJSON(const JSONElement& json);
+        void ToBinary(LLDBPacketWriter& writer) const;
+        void FromBinary(LLDBPacketReader& reader);
 
         Entry()
             : id(0)
@@ -110,6 +113,8 @@ public:
     // Serialization API
     JSONElement ToJSON() const;
     void FromJSON(const JSONElement& json);
+    void ToBinary(LLDBPacketWriter& writer) const;
+    void FromBinary(LLDBPacketReader& reader);
 };
 
 #endif // LLDBBACKTRACE_H
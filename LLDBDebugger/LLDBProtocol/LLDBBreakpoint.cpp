@@ -172,3 +172,32 @@ JSONElement LLDBBreakpoint::ToJSON() const
     }
     return json;
 }
+
+void LLDBBreakpoint::ToBinary(LLDBPacketWriter& writer) const
+{
+    writer.WriteInt(m_id);
+    writer.WriteInt(m_type);
+    writer.WriteString(m_name);
+    writer.WriteString(m_filename);
+    writer.WriteInt(m_lineNumber);
+    writer.WriteUInt(m_children.size());
+    for(size_t i = 0; i < m_children.size(); ++i) {
+        m_children.at(i)->ToBinary(writer);
+    }
+}
+
+void LLDBBreakpoint::FromBinary(LLDBPacketReader& reader)
+{
+    m_children.clear();
+    m_id = reader.ReadInt();
+    m_type = reader.ReadInt();
+    m_name = reader.ReadString();
+    m_filename = reader.ReadString();
+    m_lineNumber = reader.ReadInt();
+    size_t count = reader.ReadCount();
+    for(size_t i = 0; i < count; ++i) {
+        LLDBBreakpoint::Ptr_t bp(new LLDBBreakpoint());
+        bp->FromBinary(reader);
+        m_children.push_back(bp);
+    }
+}
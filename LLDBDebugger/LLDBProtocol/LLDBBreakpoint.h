@@ -32,6 +32,7 @@
 #include <wx/sharedptr.h>
 #include "debugger.h"
 #include "json_node.h"
+#include "LLDBPacket.h"
 
 class LLDBBreakpoint
 {
@@ -154,6 +155,8 @@ public:
     // Serialization API
     void FromJSON(const JSONElement& json);
     JSONElement ToJSON() const;
+    void ToBinary(LLDBPacketWriter& writer) const;
+    void FromBinary(LLDBPacketReader& reader);
     
 };
 
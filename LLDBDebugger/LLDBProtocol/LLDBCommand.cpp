@@ -71,6 +71,11 @@ void LLDBCommand::FromJSON(const JSONElement& json)
     if ( m_commandType == kCommandAttachProcess ) {
         m_processID = json.namedObject("m_processID").toInt();
     }
+
+    if ( m_commandType == kCommandExpandVariable ) {
+        m_startIndex = json.namedObject("m_startIndex").toInt(0);
+        m_count = json.namedObject("m_count").toInt(wxNOT_FOUND);
+    }
 }
 
 JSONElement LLDBCommand::ToJSON() const
@@ -110,6 +115,11 @@ JSONElement LLDBCommand::ToJSON() const
     if ( m_commandType == kCommandAttachProcess ) {
         json.addProperty("m_processID", m_processID);
     }
+
+    if ( m_commandType == kCommandExpandVariable ) {
+        json.addProperty("m_startIndex", m_startIndex);
+        json.addProperty("m_count", m_count);
+    }
     return json;
 }
 
@@ -168,3 +178,70 @@ void LLDBCommand::UpdatePaths(const LLDBPivot& pivot)
         }
     }
 }
+
+void LLDBCommand::ToBinary(LLDBPacketWriter& writer) const
+{
+    writer.WriteInt(m_commandType);
+    writer.WriteString(m_commandArguments);
+    writer.WriteString(m_workingDirectory);
+    writer.WriteString(m_executable);
+    writer.WriteString(m_redirectTTY);
+    writer.WriteInt(m_interruptReason);
+    writer.WriteInt(m_lldbId);
+    writer.WriteStringMap(m_env);
+    writer.WriteInt(m_frameId);
+    writer.WriteInt(m_threadId);
+    writer.WriteString(m_expression);
+    writer.WriteString(m_startupCommands);
+    writer.WriteString(m_corefile);
+    writer.WriteInt(m_processID);
+    writer.WriteInt(m_startIndex);
+    writer.WriteInt(m_count);
+
+    writer.WriteUInt(m_breakpoints.size());
+    for(size_t i = 0; i < m_breakpoints.size(); ++i) {
+        m_breakpoints.at(i)->ToBinary(writer);
+    }
+
+    if(m_commandType == kCommandStart || m_commandType == kCommandDebugCoreFile ||
+       m_commandType == kCommandAttachProcess) {
+        m_settings.ToBinary(writer);
+    }
+}
+
+void LLDBCommand::FromBinary(LLDBPacketReader& reader)
+{
+    m_commandType = reader.ReadInt();
+    m_commandArguments = reader.ReadString();
+    m_workingDirectory = reader.ReadString();
+    m_executable = reader.ReadString();
+    m_redirectTTY = reader.ReadString();
+    m_interruptReason = reader.ReadInt();
+    m_lldbId = reader.ReadInt();
+    m_env = reader.ReadStringMap();
+    m_frameId = reader.ReadInt();
+    m_threadId = reader.ReadInt();
+    m_expression = reader.ReadString();
+    m_startupCommands = reader.ReadString();
+    m_corefile = reader.ReadString();
+    m_processID = reader.ReadInt();
+    m_startIndex = reader.ReadInt();
+    m_count = reader.ReadInt();
+
+    m_breakpoints.clear();
+    size_t count = reader.ReadCount();
+    for(size_t i = 0; i < count; ++i) {
+        LLDBBreakpoint::Ptr_t bp(new LLDBBreakpoint());
+        bp->FromBinary(reader);
+        m_breakpoints.push_back(bp);
+    }
+
+    if(m_commandType == kCommandStart || m_commandType == kCommandDebugCoreFile ||
+       m_commandType == kCommandAttachProcess) {
+        m_settings.FromBinary(reader);
+    }
+
+    if(!reader.IsOk()) {
+        m_commandType = kCommandInvalid;
+    }
+}
@@ -28,6 +28,7 @@
 
 #include <wx/string.h>
 #include "json_node.h"
+#include "LLDBPacket.h"
 #include "LLDBEnums.h"
 #include "LLDBBreakpoint.h"
 #include "LLDBSettings.h"
@@ -52,17 +53,23 @@ protected:
     wxString m_startupCommands;
     wxString m_corefile;
     int m_processID;
+    int m_startIndex;
+    int m_count;
 
 public:
     // Serialization API
     JSONElement ToJSON() const;
     void FromJSON(const JSONElement& json);
+    void ToBinary(LLDBPacketWriter& writer) const;
+    void FromBinary(LLDBPacketReader& reader);
 
     LLDBCommand()
         : m_commandType(kCommandInvalid)
         , m_interruptReason(kInterruptReasonNone)
         , m_lldbId(0)
         , m_processID(wxNOT_FOUND)
+        , m_startIndex(0)
+        , m_count(wxNOT_FOUND)
     {
     }
     LLDBCommand(const wxString& jsonString);
@@ -70,6 +77,14 @@ public:
 
     void UpdatePaths(const LLDBPivot& pivot);
 
+    /**
+     * @brief the range of children requested by kCommandExpandVariable.
+     * A count of wxNOT_FOUND means "all the remaining children"
+     */
+    void SetStartIndex(int startIndex) { this->m_startIndex = startIndex; }
+    int GetStartIndex() const { return m_startIndex; }
+    void SetCount(int count) { this->m_count = count; }
+    int GetCount() const { return m_count; }
     void SetProcessID(int processID) { this->m_processID = processID; }
     int GetProcessID() const { return m_processID; }
     void SetCorefile(const wxString& corefile) { this->m_corefile = corefile; }
@@ -105,6 +120,8 @@ public:
         m_startupCommands.Clear();
         m_corefile.Clear();
         m_processID = wxNOT_FOUND;
+        m_startIndex = 0;
+        m_count = wxNOT_FOUND;
     }
 
     void SetFrameId(int frameId) { this->m_frameId = frameId; }
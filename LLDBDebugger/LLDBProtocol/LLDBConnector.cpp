@@ -162,7 +162,9 @@ void LLDBConnector::SendCommand(const LLDBCommand& command)
             // Convert local paths to remote paths if needed
             LLDBCommand updatedCommand = command;
             updatedCommand.UpdatePaths(m_pivot);
-            m_socket->WriteMessage(updatedCommand.ToJSON().format());
+            LLDBPacketWriter writer;
+            updatedCommand.ToBinary(writer);
+            m_socket->WriteFrame(writer.GetBuffer());
         }
 
     } catch(clSocketException& e) {
@@ -535,12 +537,14 @@ void LLDBConnector::RequestLocals()
     }
 }
 
-void LLDBConnector::RequestVariableChildren(int lldbId)
+void LLDBConnector::RequestVariableChildren(int lldbId, int startIndex, int count)
 {
     if(IsCanInteract()) {
         LLDBCommand command;
         command.SetCommandType(kCommandExpandVariable);
         command.SetLldbId(lldbId);
+        command.SetStartIndex(startIndex);
+        command.SetCount(count);
         SendCommand(command);
     }
 }
@@ -228,11 +228,13 @@ public:
     void DeleteWatch(int lldbId);
 
     /**
-     * @brief request lldb to expand a variable and return its children
+     * @brief request lldb to expand a variable and return a page of its children
      * @param lldbId the unique identifier that identifies this variable
      * at the debug server side
+     * @param startIndex index of the first child to return
+     * @param count maximum number of children to return (wxNOT_FOUND for all)
      */
-    void RequestVariableChildren(int lldbId);
+    void RequestVariableChildren(int lldbId, int startIndex = 0, int count = kLLDBVariablePageSize);
     /**
      * @brief stop the debugger
      */
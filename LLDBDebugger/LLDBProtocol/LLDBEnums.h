@@ -61,6 +61,7 @@ enum eReplyType {
     kReplyTypeExprEvaluated,
     kReplyTypeWatchEvaluated,
     kReplyTypeInterperterReply,
+    kReplyTypeLocalsChanged,
 };
 
 // LLDBCommand types
@@ -92,6 +93,11 @@ enum eCommandType {
     kCommandInterperterCommand,
 };
 
+// The number of children fetched by a single kCommandExpandVariable
+enum eLLDBVariablePaging {
+    kLLDBVariablePageSize = 100,
+};
+
 enum eLLDBOptions {
     kLLDBOptionRaiseCodeLite = 0x00000001,
     kLLDBOptionUseRemoteProxy = 0x00000002,
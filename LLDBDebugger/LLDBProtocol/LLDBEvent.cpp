@@ -36,6 +36,7 @@ wxDEFINE_EVENT(wxEVT_LLDB_BREAKPOINTS_DELETED_ALL, LLDBEvent);
 wxDEFINE_EVENT(wxEVT_LLDB_FRAME_SELECTED, LLDBEvent);
 wxDEFINE_EVENT(wxEVT_LLDB_CRASHED, LLDBEvent);
 wxDEFINE_EVENT(wxEVT_LLDB_LOCALS_UPDATED, LLDBEvent);
+wxDEFINE_EVENT(wxEVT_LLDB_LOCALS_CHANGED, LLDBEvent);
 wxDEFINE_EVENT(wxEVT_LLDB_VARIABLE_EXPANDED, LLDBEvent);
 wxDEFINE_EVENT(wxEVT_LLDB_EXPRESSION_EVALUATED, LLDBEvent);
 wxDEFINE_EVENT(wxEVT_LLDB_INTERPERTER_REPLY, LLDBEvent);
@@ -46,6 +47,8 @@ LLDBEvent::LLDBEvent(wxEventType eventType, int windid)
     , m_frameId(0)
     , m_threadId(0)
     , m_sessionType(kDebugSessionTypeNormal)
+    , m_startIndex(0)
+    , m_totalCount(0)
 {
 }
 
@@ -68,6 +71,8 @@ LLDBEvent& LLDBEvent::operator=(const LLDBEvent& src)
     m_variables = src.m_variables;
     m_threads = src.m_threads;
     m_expression = src.m_expression;
+    m_startIndex = src.m_startIndex;
+    m_totalCount = src.m_totalCount;
     return *this;
 }
 
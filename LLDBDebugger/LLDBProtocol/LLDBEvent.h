@@ -46,6 +46,8 @@ class LLDBEvent : public clCommandEvent
     LLDBThread::Vect_t m_threads;
     wxString m_expression;
     int m_sessionType;
+    int m_startIndex;
+    int m_totalCount;
 
 public:
     LLDBEvent(wxEventType eventType, int winid = 0);
@@ -56,6 +58,14 @@ public:
 
     bool ShouldPromptStopReason(wxString& message) const;
 
+    /**
+     * @brief for wxEVT_LLDB_VARIABLE_EXPANDED: the index of the first child in GetVariables()
+     * and the total number of children the variable has
+     */
+    void SetStartIndex(int startIndex) { this->m_startIndex = startIndex; }
+    int GetStartIndex() const { return m_startIndex; }
+    void SetTotalCount(int totalCount) { this->m_totalCount = totalCount; }
+    int GetTotalCount() const { return m_totalCount; }
     void SetSessionType(int sessionType) { this->m_sessionType = sessionType; }
     int GetSessionType() const { return m_sessionType; }
     void SetExpression(const wxString& expression) { this->m_expression = expression; }
@@ -102,6 +112,8 @@ wxDECLARE_EVENT(wxEVT_LLDB_BREAKPOINTS_DELETED_ALL, LLDBEvent);
 wxDECLARE_EVENT(wxEVT_LLDB_FRAME_SELECTED, LLDBEvent);
 wxDECLARE_EVENT(wxEVT_LLDB_CRASHED, LLDBEvent);
 wxDECLARE_EVENT(wxEVT_LLDB_LOCALS_UPDATED, LLDBEvent);
+// Only the variables whose value changed since the previous stop (keyed by their lldb ID)
+wxDECLARE_EVENT(wxEVT_LLDB_LOCALS_CHANGED, LLDBEvent);
 wxDECLARE_EVENT(wxEVT_LLDB_VARIABLE_EXPANDED, LLDBEvent);
 wxDECLARE_EVENT(wxEVT_LLDB_EXPRESSION_EVALUATED, LLDBEvent);
 wxDECLARE_EVENT(wxEVT_LLDB_INTERPERTER_REPLY, LLDBEvent);
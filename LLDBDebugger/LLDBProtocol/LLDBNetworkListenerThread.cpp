@@ -31,6 +31,7 @@
 LLDBNetworkListenerThread::LLDBNetworkListenerThread(wxEvtHandler* owner, const LLDBPivot& pivot, int fd)
     : wxThread(wxTHREAD_JOINABLE)
     , m_owner(owner)
+    , m_stopping(false)
 {
     m_socket.reset(new clSocketBase(fd));
     m_pivot = pivot;
@@ -41,10 +42,17 @@ LLDBNetworkListenerThread::~LLDBNetworkListenerThread() { Stop(); }
 void* LLDBNetworkListenerThread::Entry()
 {
     while(!TestDestroy()) {
-        wxString msg;
+        std::string frame;
         try {
-            if(m_socket->ReadMessage(msg, 1) == clSocketBase::kSuccess) {
-                LLDBReply reply(msg);
+            // Block until codelite-lldb sends a reply, Stop() wakes us up by shutting down the socket
+            if(m_socket->ReadFrame(frame) == clSocketBase::kSuccess) {
+                LLDBPacketReader reader(frame);
+                LLDBReply reply;
+                reply.FromBinary(reader);
+                if(!reader.IsOk()) {
+                    CL_WARNING("LLDB: discarding malformed reply packet (%d bytes)", (int)frame.length());
+                    continue;
+                }
                 reply.UpdatePaths(m_pivot);
                 switch(reply.GetReplyType()) {
                 case kReplyTypeInterperterReply: {
@@ -114,10 +122,19 @@ void* LLDBNetworkListenerThread::Entry()
                     break;
                 }
 
+                case kReplyTypeLocalsChanged: {
+                    LLDBEvent event(wxEVT_LLDB_LOCALS_CHANGED);
+                    event.SetVariables(reply.GetVariables());
+                    m_owner->AddPendingEvent(event);
+                    break;
+                }
+
                 case kReplyTypeVariableExpanded: {
                     LLDBEvent event(wxEVT_LLDB_VARIABLE_EXPANDED);
                     event.SetVariables(reply.GetVariables());
                     event.SetVariableId(reply.GetLldbId());
+                    event.SetStartIndex(reply.GetStartIndex());
+                    event.SetTotalCount(reply.GetTotalCount());
                     m_owner->AddPendingEvent(event);
                     break;
                 }
@@ -132,6 +149,10 @@ void* LLDBNetworkListenerThread::Entry()
                 }
             }
         } catch(clSocketException& e) {
+            if(m_stopping) {
+                // we closed the connection ourselves
+                break;
+            }
             CL_WARNING("Seems like we lost connection to codelite-lldb (probably crashed): %s", e.what().c_str());
             LLDBEvent event(wxEVT_LLDB_CRASHED);
             m_owner->AddPendingEvent(event);
@@ -43,6 +43,8 @@ class LLDBNetworkListenerThread : public wxThread
     wxEvtHandler *m_owner;
     clSocketBase::Ptr_t m_socket;
     LLDBPivot m_pivot;
+    volatile bool m_stopping;
+
 public:
     LLDBNetworkListenerThread(wxEvtHandler *owner, const LLDBPivot& pivot, int fd);
     virtual ~LLDBNetworkListenerThread();
@@ -65,6 +67,9 @@ protected:
      * @brief stop and join the thread
      */
     void Stop() {
+        // the thread is blocked on the socket, wake it up
+        m_stopping = true;
+        m_socket->Shutdown();
         if ( IsAlive() ) {
             Delete(NULL, wxTHREAD_WAIT_BLOCK);
         } else {
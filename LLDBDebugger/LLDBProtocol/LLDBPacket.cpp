@@ -0,0 +1,145 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : LLDBPacket.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "LLDBPacket.h"
+
+LLDBPacketWriter::LLDBPacketWriter()
+{
+    m_buffer.reserve(4096);
+    m_buffer.push_back((char)kLLDBPacketMagic);
+    m_buffer.push_back((char)kLLDBPacketVersion);
+}
+
+void LLDBPacketWriter::WriteUInt(unsigned long long value)
+{
+    while(value >= 0x80) {
+        m_buffer.push_back((char)((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    m_buffer.push_back((char)value);
+}
+
+void LLDBPacketWriter::WriteInt(long long value)
+{
+    // zigzag: small negative numbers become small positive ones
+    WriteUInt(((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+}
+
+void LLDBPacketWriter::WriteString(const wxString& str)
+{
+    const wxScopedCharBuffer utf8 = str.ToUTF8();
+    WriteUInt(utf8.length());
+    m_buffer.append(utf8.data(), utf8.length());
+}
+
+void LLDBPacketWriter::WriteStringMap(const std::map<wxString, wxString>& m)
+{
+    WriteUInt(m.size());
+    std::map<wxString, wxString>::const_iterator iter = m.begin();
+    for(; iter != m.end(); ++iter) {
+        WriteString(iter->first);
+        WriteString(iter->second);
+    }
+}
+
+LLDBPacketReader::LLDBPacketReader(const std::string& buffer)
+    : m_cur((const unsigned char*)buffer.data())
+    , m_end((const unsigned char*)buffer.data() + buffer.length())
+    , m_ok(true)
+{
+    if(buffer.length() < 2 || m_cur[0] != kLLDBPacketMagic || m_cur[1] != kLLDBPacketVersion) {
+        m_ok = false;
+        return;
+    }
+    m_cur += 2;
+}
+
+unsigned long long LLDBPacketReader::ReadUInt()
+{
+    unsigned long long value = 0;
+    int shift = 0;
+    while(m_ok) {
+        if(m_cur == m_end || shift > 63) {
+            m_ok = false;
+            break;
+        }
+        unsigned char byte = *m_cur++;
+        value |= (unsigned long long)(byte & 0x7F) << shift;
+        if(!(byte & 0x80)) {
+            return value;
+        }
+        shift += 7;
+    }
+    return 0;
+}
+
+long long LLDBPacketReader::ReadInt()
+{
+    unsigned long long value = ReadUInt();
+    return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+bool LLDBPacketReader::ReadBool()
+{
+    if(!m_ok || m_cur == m_end) {
+        m_ok = false;
+        return false;
+    }
+    return *m_cur++ != 0;
+}
+
+wxString LLDBPacketReader::ReadString()
+{
+    unsigned long long len = ReadUInt();
+    if(!m_ok || len > (unsigned long long)(m_end - m_cur)) {
+        m_ok = false;
+        return wxEmptyString;
+    }
+    wxString str = wxString::FromUTF8((const char*)m_cur, (size_t)len);
+    m_cur += len;
+    return str;
+}
+
+std::map<wxString, wxString> LLDBPacketReader::ReadStringMap()
+{
+    std::map<wxString, wxString> m;
+    size_t count = ReadCount();
+    for(size_t i = 0; i < count && m_ok; ++i) {
+        wxString key = ReadString();
+        m[key] = ReadString();
+    }
+    return m;
+}
+
+size_t LLDBPacketReader::ReadCount()
+{
+    // every element takes at least one byte
+    unsigned long long count = ReadUInt();
+    if(!m_ok || count > (unsigned long long)(m_end - m_cur)) {
+        m_ok = false;
+        return 0;
+    }
+    return (size_t)count;
+}
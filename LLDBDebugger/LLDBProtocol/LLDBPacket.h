@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : LLDBPacket.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef LLDBPACKET_H
+#define LLDBPACKET_H
+
+#include <string>
+#include <map>
+#include <wx/string.h>
+
+/**
+ * The binary encoding used for LLDBCommand / LLDBReply on the wire between
+ * codelite and codelite-lldb. Every packet starts with a magic byte and a version
+ * byte followed by the object fields in a fixed order:
+ *  - integers are LEB128 varints (signed values are zigzag encoded so -1 takes a single byte)
+ *  - strings are a varint byte count followed by the UTF-8 bytes
+ *  - arrays are a varint element count followed by the elements
+ * The packet is sent as a single frame (see clSocketBase::WriteFrame)
+ */
+enum eLLDBPacket {
+    kLLDBPacketMagic = 0xCE,
+    kLLDBPacketVersion = 1,
+};
+
+class LLDBPacketWriter
+{
+    std::string m_buffer;
+
+public:
+    LLDBPacketWriter();
+    ~LLDBPacketWriter() {}
+
+    void WriteUInt(unsigned long long value);
+    void WriteInt(long long value);
+    void WriteBool(bool value) { m_buffer.push_back(value ? 1 : 0); }
+    void WriteString(const wxString& str);
+    void WriteStringMap(const std::map<wxString, wxString>& m);
+
+    /**
+     * @brief the encoded packet, ready to be sent
+     */
+    const std::string& GetBuffer() const { return m_buffer; }
+};
+
+class LLDBPacketReader
+{
+    const unsigned char* m_cur;
+    const unsigned char* m_end;
+    bool m_ok;
+
+public:
+    /**
+     * @brief construct a reader over a received frame. The magic and version
+     * bytes are validated here, use IsOk() to check the result.
+     * The reader does not copy 'buffer', it must outlive the reader
+     */
+    LLDBPacketReader(const std::string& buffer);
+    ~LLDBPacketReader() {}
+
+    /**
+     * @brief return false if the packet header did not match or if any read ran
+     * past the end of the packet. Once failed, all reads return default values
+     */
+    bool IsOk() const { return m_ok; }
+
+    unsigned long long ReadUInt();
+    long long ReadInt();
+    bool ReadBool();
+    wxString ReadString();
+    std::map<wxString, wxString> ReadStringMap();
+    /**
+     * @brief read an array element count. The count is checked against the
+     * bytes left in the packet so a corrupted count can not trigger a huge allocation
+     */
+    size_t ReadCount();
+};
+
+#endif // LLDBPACKET_H
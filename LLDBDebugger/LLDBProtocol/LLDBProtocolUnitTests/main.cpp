@@ -0,0 +1,151 @@
+#include <limits.h>
+#include <wx/init.h>
+#include "LLDBPacket.h"
+#include "tester.h"
+
+TEST_FUNC(test_packet_round_trip)
+{
+    std::map<wxString, wxString> env;
+    env["PATH"] = "/usr/bin";
+    env["EMPTY"] = "";
+
+    LLDBPacketWriter writer;
+    writer.WriteUInt(0);
+    writer.WriteUInt(127);
+    writer.WriteUInt(128);
+    writer.WriteUInt(ULLONG_MAX);
+    writer.WriteInt(0);
+    writer.WriteInt(wxNOT_FOUND);
+    writer.WriteInt(LLONG_MIN);
+    writer.WriteInt(LLONG_MAX);
+    writer.WriteBool(true);
+    writer.WriteBool(false);
+    writer.WriteString("");
+    writer.WriteString(wxString::FromUTF8("main.cpp \xc3\xa9\xe2\x82\xac"));
+    writer.WriteStringMap(env);
+
+    LLDBPacketReader reader(writer.GetBuffer());
+    CHECK_BOOL(reader.IsOk());
+    CHECK_BOOL(reader.ReadUInt() == 0);
+    CHECK_BOOL(reader.ReadUInt() == 127);
+    CHECK_BOOL(reader.ReadUInt() == 128);
+    CHECK_BOOL(reader.ReadUInt() == ULLONG_MAX);
+    CHECK_BOOL(reader.ReadInt() == 0);
+    CHECK_BOOL(reader.ReadInt() == wxNOT_FOUND);
+    CHECK_BOOL(reader.ReadInt() == LLONG_MIN);
+    CHECK_BOOL(reader.ReadInt() == LLONG_MAX);
+    CHECK_BOOL(reader.ReadBool());
+    CHECK_BOOL(!reader.ReadBool());
+    CHECK_WXSTRING(reader.ReadString(), "");
+    CHECK_WXSTRING(reader.ReadString(), wxString::FromUTF8("main.cpp \xc3\xa9\xe2\x82\xac"));
+    CHECK_BOOL(reader.ReadStringMap() == env);
+    CHECK_BOOL(reader.IsOk());
+
+    // Nothing is left: the next read fails
+    reader.ReadBool();
+    CHECK_BOOL(!reader.IsOk());
+    return true;
+}
+
+TEST_FUNC(test_packet_zigzag_size)
+{
+    // The header is 2 bytes, small values of either sign take a single byte
+    LLDBPacketWriter writer;
+    writer.WriteInt(wxNOT_FOUND);
+    CHECK_SIZE(writer.GetBuffer().length(), 3);
+    writer.WriteInt(63);
+    writer.WriteInt(-64);
+    CHECK_SIZE(writer.GetBuffer().length(), 5);
+    writer.WriteInt(64);
+    CHECK_SIZE(writer.GetBuffer().length(), 7);
+
+    // The 64 bit limits take 10 bytes
+    LLDBPacketWriter limits;
+    limits.WriteInt(LLONG_MIN);
+    limits.WriteInt(LLONG_MAX);
+    CHECK_SIZE(limits.GetBuffer().length(), 22);
+    return true;
+}
+
+TEST_FUNC(test_packet_truncated)
+{
+    LLDBPacketWriter writer;
+    writer.WriteInt(LLONG_MIN);
+    writer.WriteString("hello");
+    const std::string& buffer = writer.GetBuffer();
+
+    // Cut inside the string bytes
+    std::string truncated = buffer.substr(0, buffer.length() - 1);
+    LLDBPacketReader reader(truncated);
+    CHECK_BOOL(reader.IsOk());
+    CHECK_BOOL(reader.ReadInt() == LLONG_MIN);
+    CHECK_WXSTRING(reader.ReadString(), "");
+    CHECK_BOOL(!reader.IsOk());
+
+    // Cut inside the varint: once failed, every read returns a default value
+    truncated = buffer.substr(0, 5);
+    LLDBPacketReader reader2(truncated);
+    CHECK_BOOL(reader2.ReadInt() == 0);
+    CHECK_BOOL(!reader2.IsOk());
+    CHECK_BOOL(!reader2.ReadBool());
+    CHECK_WXSTRING(reader2.ReadString(), "");
+    CHECK_BOOL(!reader2.IsOk());
+    return true;
+}
+
+TEST_FUNC(test_packet_oversized_count)
+{
+    // A count larger than the bytes left in the packet is rejected
+    LLDBPacketWriter writer;
+    writer.WriteUInt(1000000000ULL);
+    writer.WriteString("x");
+    LLDBPacketReader reader(writer.GetBuffer());
+    CHECK_SIZE(reader.ReadCount(), 0);
+    CHECK_BOOL(!reader.IsOk());
+
+    LLDBPacketWriter mapWriter;
+    mapWriter.WriteUInt(ULLONG_MAX);
+    LLDBPacketReader mapReader(mapWriter.GetBuffer());
+    CHECK_SIZE(mapReader.ReadStringMap().size(), 0);
+    CHECK_BOOL(!mapReader.IsOk());
+
+    // A count that fits is accepted
+    LLDBPacketWriter okWriter;
+    okWriter.WriteUInt(2);
+    okWriter.WriteBool(true);
+    okWriter.WriteBool(true);
+    LLDBPacketReader okReader(okWriter.GetBuffer());
+    CHECK_SIZE(okReader.ReadCount(), 2);
+    CHECK_BOOL(okReader.IsOk());
+    return true;
+}
+
+TEST_FUNC(test_packet_bad_header)
+{
+    LLDBPacketWriter writer;
+    writer.WriteInt(42);
+
+    std::string buffer = writer.GetBuffer();
+    buffer[1] = (char)(kLLDBPacketVersion + 1);
+    LLDBPacketReader versionReader(buffer);
+    CHECK_BOOL(!versionReader.IsOk());
+    CHECK_BOOL(versionReader.ReadInt() == 0);
+
+    buffer = writer.GetBuffer();
+    buffer[0] = 'x';
+    LLDBPacketReader magicReader(buffer);
+    CHECK_BOOL(!magicReader.IsOk());
+
+    std::string empty;
+    LLDBPacketReader emptyReader(empty);
+    CHECK_BOOL(!emptyReader.IsOk());
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    wxInitialize(argc, argv);
+    Tester::Instance()->RunTests();
+    wxUninitialize();
+    return 0;
+}
@@ -44,7 +44,11 @@ void LLDBReply::FromJSON(const JSONElement& json)
     m_expression = json.namedObject("m_expression").toString();
     m_debugSessionType = json.namedObject("m_debugSessionType").toInt(kDebugSessionTypeNormal);
     m_text = json.namedObject("m_text").toString();
-    
+    if(m_replyType == kReplyTypeVariableExpanded) {
+        m_startIndex = json.namedObject("m_startIndex").toInt(0);
+        m_totalCount = json.namedObject("m_totalCount").toInt(0);
+    }
+
     m_breakpoints.clear();
     JSONElement arr = json.namedObject("m_breakpoints");
     for(int i = 0; i < arr.arraySize(); ++i) {
@@ -80,6 +84,10 @@ JSONElement LLDBReply::ToJSON() const
     json.addProperty("m_expression", m_expression);
     json.addProperty("m_debugSessionType", m_debugSessionType);
     json.addProperty("m_text", m_text);
+    if(m_replyType == kReplyTypeVariableExpanded) {
+        json.addProperty("m_startIndex", m_startIndex);
+        json.addProperty("m_totalCount", m_totalCount);
+    }
     JSONElement bparr = JSONElement::createArray("m_breakpoints");
     json.append(bparr);
     for(size_t i = 0; i < m_breakpoints.size(); ++i) {
@@ -122,3 +130,78 @@ void LLDBReply::UpdatePaths(const LLDBPivot& pivot)
         }
     }
 }
+
+void LLDBReply::ToBinary(LLDBPacketWriter& writer) const
+{
+    writer.WriteInt(m_replyType);
+    writer.WriteInt(m_interruptResaon);
+    writer.WriteInt(m_line);
+    writer.WriteString(m_filename);
+    writer.WriteInt(m_lldbId);
+    writer.WriteString(m_expression);
+    writer.WriteInt(m_debugSessionType);
+    writer.WriteString(m_text);
+    writer.WriteInt(m_startIndex);
+    writer.WriteInt(m_totalCount);
+
+    writer.WriteUInt(m_breakpoints.size());
+    for(size_t i = 0; i < m_breakpoints.size(); ++i) {
+        m_breakpoints.at(i)->ToBinary(writer);
+    }
+
+    writer.WriteUInt(m_variables.size());
+    for(size_t i = 0; i < m_variables.size(); ++i) {
+        m_variables.at(i)->ToBinary(writer);
+    }
+
+    m_backtrace.ToBinary(writer);
+
+    writer.WriteUInt(m_threads.size());
+    for(size_t i = 0; i < m_threads.size(); ++i) {
+        m_threads.at(i).ToBinary(writer);
+    }
+}
+
+void LLDBReply::FromBinary(LLDBPacketReader& reader)
+{
+    m_replyType = reader.ReadInt();
+    m_interruptResaon = reader.ReadInt();
+    m_line = reader.ReadInt();
+    m_filename = reader.ReadString();
+    m_lldbId = reader.ReadInt();
+    m_expression = reader.ReadString();
+    m_debugSessionType = reader.ReadInt();
+    m_text = reader.ReadString();
+    m_startIndex = reader.ReadInt();
+    m_totalCount = reader.ReadInt();
+
+    m_breakpoints.clear();
+    size_t count = reader.ReadCount();
+    for(size_t i = 0; i < count; ++i) {
+        LLDBBreakpoint::Ptr_t bp(new LLDBBreakpoint());
+        bp->FromBinary(reader);
+        m_breakpoints.push_back(bp);
+    }
+
+    m_variables.clear();
+    count = reader.ReadCount();
+    m_variables.reserve(count);
+    for(size_t i = 0; i < count; ++i) {
+        LLDBVariable::Ptr_t variable(new LLDBVariable());
+        variable->FromBinary(reader);
+        m_variables.push_back(variable);
+    }
+
+    m_backtrace.FromBinary(reader);
+
+    m_threads.clear();
+    count = reader.ReadCount();
+    m_threads.resize(count);
+    for(size_t i = 0; i < count; ++i) {
+        m_threads.at(i).FromBinary(reader);
+    }
+
+    if(!reader.IsOk()) {
+        m_replyType = kReplyTypeInvalid;
+    }
+}
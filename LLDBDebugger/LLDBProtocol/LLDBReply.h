@@ -27,6 +27,7 @@
 #define LLDBREPLY_H
 
 #include "json_node.h"
+#include "LLDBPacket.h"
 #include "LLDBEnums.h"
 #include "LLDBBreakpoint.h"
 #include "LLDBBacktrace.h"
@@ -49,6 +50,8 @@ protected:
     wxString m_expression;
     int m_debugSessionType;
     wxString m_text; // free text
+    int m_startIndex; // kReplyTypeVariableExpanded: index of the first child in m_variables
+    int m_totalCount; // kReplyTypeVariableExpanded: total number of children
 
 public:
     LLDBReply()
@@ -57,12 +60,18 @@ public:
         , m_line(wxNOT_FOUND)
         , m_lldbId(wxNOT_FOUND)
         , m_debugSessionType(kDebugSessionTypeNormal)
+        , m_startIndex(0)
+        , m_totalCount(0)
     {
     }
 
     LLDBReply(const wxString& str);
     virtual ~LLDBReply();
 
+    void SetStartIndex(int startIndex) { this->m_startIndex = startIndex; }
+    int GetStartIndex() const { return m_startIndex; }
+    void SetTotalCount(int totalCount) { this->m_totalCount = totalCount; }
+    int GetTotalCount() const { return m_totalCount; }
     void SetText(const wxString& text) { this->m_text = text; }
     const wxString& GetText() const { return m_text; }
     void UpdatePaths(const LLDBPivot& pivot);
@@ -91,6 +100,8 @@ public:
     // Serialization API
     JSONElement ToJSON() const;
     void FromJSON(const JSONElement& json);
+    void ToBinary(LLDBPacketWriter& writer) const;
+    void FromBinary(LLDBPacketReader& reader);
 };
 
 #endif // LLDBREPLY_H
@@ -135,3 +135,27 @@ LLDBSettings& LLDBSettings::Save()
     }
     return *this;
 }
+
+void LLDBSettings::ToBinary(LLDBPacketWriter& writer) const
+{
+    writer.WriteUInt(m_arrItems);
+    writer.WriteUInt(m_stackFrames);
+    writer.WriteUInt(m_flags);
+    writer.WriteString(m_types);
+    writer.WriteInt(m_proxyPort);
+    writer.WriteString(m_proxyIp);
+    writer.WriteString(m_lastLocalFolder);
+    writer.WriteString(m_lastRemoteFolder);
+}
+
+void LLDBSettings::FromBinary(LLDBPacketReader& reader)
+{
+    m_arrItems = reader.ReadUInt();
+    m_stackFrames = reader.ReadUInt();
+    m_flags = reader.ReadUInt();
+    m_types = reader.ReadString();
+    m_proxyPort = reader.ReadInt();
+    m_proxyIp = reader.ReadString();
+    m_lastLocalFolder = reader.ReadString();
+    m_lastRemoteFolder = reader.ReadString();
+}
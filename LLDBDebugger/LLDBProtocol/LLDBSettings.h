@@ -29,6 +29,7 @@
 #include "LLDBEnums.h"
 #include <wx/string.h>
 #include "json_node.h"
+#include "LLDBPacket.h"
 
 class LLDBSettings
 {
@@ -126,6 +127,8 @@ public:
     // Serialization API
     JSONElement ToJSON() const;
     void FromJSON( const JSONElement &json );
+    void ToBinary(LLDBPacketWriter& writer) const;
+    void FromBinary(LLDBPacketReader& reader);
 };
 
 #endif // LLDBSETTINGS_H
@@ -82,3 +82,25 @@ LLDBThread::Vect_t LLDBThread::FromJSON(const JSONElement& json, const wxString&
     }
     return v;
 }
+
+void LLDBThread::ToBinary(LLDBPacketWriter& writer) const
+{
+    writer.WriteInt(m_id);
+    writer.WriteString(m_func);
+    writer.WriteString(m_file);
+    writer.WriteInt(m_line);
+    writer.WriteBool(m_active);
+    writer.WriteInt(m_stopReason);
+    writer.WriteString(m_stopReasonString);
+}
+
+void LLDBThread::FromBinary(LLDBPacketReader& reader)
+{
+    m_id = reader.ReadInt();
+    m_func = reader.ReadString();
+    m_file = reader.ReadString();
+    m_line = reader.ReadInt();
+    m_active = reader.ReadBool();
+    m_stopReason = reader.ReadInt();
+    m_stopReasonString = reader.ReadString();
+}
@@ -28,6 +28,7 @@
 
 #include <wx/string.h>
 #include "json_node.h"
+#include "LLDBPacket.h"
 #include <vector>
 
 class LLDBThread
@@ -97,6 +98,9 @@ public:
 
     static JSONElement ToJSON(const LLDBThread::Vect_t& threads, const wxString &name);
     static LLDBThread::Vect_t FromJSON(const JSONElement& json, const wxString &name);
+
+    void ToBinary(LLDBPacketWriter& writer) const;
+    void FromBinary(LLDBPacketReader& reader);
 };
 
 #endif // LLDBTHREAD_H
@@ -115,3 +115,27 @@ wxString LLDBVariable::ToString(const wxString& alternateName) const
     }
     return asString;
 }
+
+void LLDBVariable::ToBinary(LLDBPacketWriter& writer) const
+{
+    writer.WriteString(m_name);
+    writer.WriteString(m_value);
+    writer.WriteString(m_summary);
+    writer.WriteString(m_type);
+    writer.WriteBool(m_valueChanged);
+    writer.WriteInt(m_lldbId);
+    writer.WriteBool(m_hasChildren);
+    writer.WriteBool(m_isWatch);
+}
+
+void LLDBVariable::FromBinary(LLDBPacketReader& reader)
+{
+    m_name = reader.ReadString();
+    m_value = reader.ReadString();
+    m_summary = reader.ReadString();
+    m_type = reader.ReadString();
+    m_valueChanged = reader.ReadBool();
+    m_lldbId = reader.ReadInt();
+    m_hasChildren = reader.ReadBool();
+    m_isWatch = reader.ReadBool();
+}
@@ -31,7 +31,9 @@
 #include <wx/clntdata.h>
 #include <wx/sharedptr.h>
 #include "json_node.h"
+#include "LLDBPacket.h"
 #include <wx/treebase.h>
+#include <wx/intl.h>
 #include "LLDBEnums.h"
 #if BUILD_CODELITE_LLDB
 #include <lldb/API/SBValue.h>
@@ -67,6 +69,7 @@ public:
         : m_valueChanged(false)
         , m_lldbId(wxNOT_FOUND)
         , m_hasChildren(false)
+        , m_isWatch(false)
     {
     }
     virtual ~LLDBVariable();
@@ -78,6 +81,8 @@ public:
     // Seriliazation API
     void FromJSON(const JSONElement& json);
     JSONElement ToJSON() const;
+    void ToBinary(LLDBPacketWriter& writer) const;
+    void FromBinary(LLDBPacketReader& reader);
 
     void SetValueChanged(bool valueChanged) { this->m_valueChanged = valueChanged; }
     bool IsValueChanged() const { return m_valueChanged; }
@@ -111,6 +116,63 @@ public:
     {
     }
     LLDBVariable::Ptr_t GetVariable() const { return m_variable; }
+    void SetVariable(LLDBVariable::Ptr_t variable) { this->m_variable = variable; }
+};
+
+/**
+ * @class LLDBVariablePageClientData
+ * @brief attached to the "[N more...]" placeholder row that a view appends
+ * when a variable has more children than were fetched so far
+ */
+class LLDBVariablePageClientData : public wxTreeItemData
+{
+    int m_parentId;
+    int m_startIndex;
+
+public:
+    LLDBVariablePageClientData(int parentId, int startIndex)
+        : m_parentId(parentId)
+        , m_startIndex(startIndex)
+    {
+    }
+    int GetParentId() const { return m_parentId; }
+    int GetStartIndex() const { return m_startIndex; }
+
+    /**
+     * @brief append a "[N more...]" placeholder under 'parent' if not all of its
+     * 'totalCount' children were fetched. TreeT is a wxTreeCtrl or a clTreeListCtrl
+     */
+    template <typename TreeT>
+    static void AppendPlaceholder(TreeT* tree, const wxTreeItemId& parent, int parentId, int startIndex, int totalCount)
+    {
+        if(startIndex >= totalCount) return;
+        wxTreeItemId item = tree->AppendItem(parent,
+                                             wxString::Format(_("[%d more...]"), totalCount - startIndex),
+                                             wxNOT_FOUND,
+                                             wxNOT_FOUND,
+                                             new LLDBVariablePageClientData(parentId, startIndex));
+        // expanding the placeholder fetches the next page
+        tree->AppendItem(item, "<dummy>");
+    }
+
+    /**
+     * @brief remove the "[N more...]" placeholders of 'parent'
+     */
+    template <typename TreeT> static void DeletePlaceholders(TreeT* tree, const wxTreeItemId& parent)
+    {
+        wxArrayTreeItemIds placeholders;
+        wxTreeItemIdValue cookie;
+        wxTreeItemId child = tree->GetFirstChild(parent, cookie);
+        while(child.IsOk()) {
+            if(dynamic_cast<LLDBVariablePageClientData*>(tree->GetItemData(child))) {
+                placeholders.Add(child);
+            }
+            child = tree->GetNextChild(parent, cookie);
+        }
+        for(size_t i = 0; i < placeholders.GetCount(); ++i) {
+            tree->Delete(placeholders.Item(i));
+        }
+    }
 };
 
 #endif // LLDBLOCALVARIABLE_H
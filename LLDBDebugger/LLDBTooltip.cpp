@@ -47,6 +47,17 @@ LLDBTooltip::~LLDBTooltip()
 void LLDBTooltip::OnItemExpanding(wxTreeEvent& event)
 {
     CHECK_ITEM_RET(event.GetItem());
+    LLDBVariablePageClientData* page =
+        dynamic_cast<LLDBVariablePageClientData*>(m_treeCtrl->GetItemData(event.GetItem()));
+    if(page) {
+        // "[N more...]" placeholder: fetch the next page into the parent item
+        event.Veto();
+        m_plugin->GetLLDB()->RequestVariableChildren(page->GetParentId(), page->GetStartIndex());
+        m_itemsPendingExpansion.insert(
+            std::make_pair(page->GetParentId(), m_treeCtrl->GetItemParent(event.GetItem())));
+        return;
+    }
+
     LLDBVariableClientData* data = ItemData(event.GetItem());
 
     wxTreeItemIdValue cookie;
@@ -90,7 +101,6 @@ LLDBVariableClientData* LLDBTooltip::ItemData(const wxTreeItemId& item) const
 void LLDBTooltip::OnLLDBVariableExpanded(LLDBEvent& event)
 {
     int variableId = event.GetVariableId();
-    wxUnusedVar(variableId);
     std::map<int, wxTreeItemId>::iterator iter = m_itemsPendingExpansion.find(event.GetVariableId());
     if(iter == m_itemsPendingExpansion.end()) {
         // does not belong to us
@@ -100,10 +110,15 @@ void LLDBTooltip::OnLLDBVariableExpanded(LLDBEvent& event)
 
     wxTreeItemId parentItem = iter->second;
 
+    // remove the "[N more...]" placeholder, the new page replaces it
+    LLDBVariablePageClientData::DeletePlaceholders(m_treeCtrl, parentItem);
+
     // add the variables to the tree
     for(size_t i = 0; i < event.GetVariables().size(); ++i) {
         DoAddVariable(parentItem, event.GetVariables().at(i));
     }
+    LLDBVariablePageClientData::AppendPlaceholder(
+        m_treeCtrl, parentItem, variableId, event.GetStartIndex() + kLLDBVariablePageSize, event.GetTotalCount());
 
     // Expand the parent item
     if(m_treeCtrl->HasChildren(parentItem)) {
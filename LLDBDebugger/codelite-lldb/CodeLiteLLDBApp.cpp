@@ -332,7 +332,8 @@ void CodeLiteLLDBApp::NotifyAborted()
 void CodeLiteLLDBApp::NotifyRunning()
 {
     wxPrintf("codelite-lldb: NotifyRunning. Target Process ID %d\n", m_debuggeePid);
-    m_variables.clear();
+    // Keep the locals: if we stop in the same frame, only the changed values are sent
+    DoClearNonLocalVariables();
     LLDBReply reply;
     reply.SetReplyType(kReplyTypeDebuggerRunning);
     SendReply(reply);
@@ -352,7 +353,7 @@ void CodeLiteLLDBApp::NotifyStarted(eLLDBDebugSessionType sessionType)
         break;
     }
     m_sessionType = sessionType;
-    m_variables.clear();
+    DoClearVariables();
     LLDBReply reply;
     reply.SetDebugSessionType(sessionType);
     reply.SetReplyType(kReplyTypeDebuggerStartedSuccessfully);
@@ -361,7 +362,6 @@ void CodeLiteLLDBApp::NotifyStarted(eLLDBDebugSessionType sessionType)
 
 void CodeLiteLLDBApp::NotifyStopped()
 {
-    m_variables.clear();
     LLDBReply reply;
     wxPrintf("codelite-lldb: NotifyStopped() called. m_interruptReason=%d\n", (int)m_interruptReason);
     reply.SetReplyType(kReplyTypeDebuggerStopped);
@@ -431,7 +431,7 @@ void CodeLiteLLDBApp::NotifyStopped()
 void CodeLiteLLDBApp::NotifyStoppedOnFirstEntry()
 {
     wxPrintf("codelite-lldb: NotifyStoppedOnFirstEntry()\n");
-    m_variables.clear();
+    DoClearVariables();
     m_watches.clear();
     LLDBReply reply;
     reply.SetReplyType(kReplyTypeDebuggerStoppedOnFirstEntry);
@@ -441,7 +441,9 @@ void CodeLiteLLDBApp::NotifyStoppedOnFirstEntry()
 void CodeLiteLLDBApp::SendReply(const LLDBReply& reply)
 {
     try {
-        m_replySocket->WriteMessage(reply.ToJSON().format());
+        LLDBPacketWriter writer;
+        reply.ToBinary(writer);
+        m_replySocket->WriteFrame(writer.GetBuffer());
 
     } catch(clSocketException& e) {
         wxPrintf("codelite-lldb: failed to send reply. %s. %s.\n", e.what().c_str(), strerror(errno));
@@ -456,7 +458,7 @@ void CodeLiteLLDBApp::RunDebugger(const LLDBCommand& command)
     }
 
     if(m_debugger.IsValid()) {
-        m_variables.clear();
+        DoClearVariables();
         m_watches.clear();
 
         // Construct char** arrays
@@ -531,7 +533,7 @@ void CodeLiteLLDBApp::RunDebugger(const LLDBCommand& command)
 void CodeLiteLLDBApp::Cleanup()
 {
     wxPrintf("codelite-lldb: Cleanup() called...\n");
-    m_variables.clear();
+    DoClearVariables();
     m_watches.clear();
 
     wxDELETE(m_networkThread);
@@ -728,24 +730,33 @@ void CodeLiteLLDBApp::LocalVariables(const LLDBCommand& command)
 {
     wxUnusedVar(command);
     LLDBVariable::Vect_t locals;
-    m_variables.clear();
 
     wxPrintf("codelite-lldb: fetching local variables for selected frame\n");
     lldb::SBFrame frame = m_target.GetProcess().GetSelectedThread().GetSelectedFrame();
     if(!frame.IsValid()) {
+        DoClearVariables();
         NotifyLocals(locals);
         return;
     }
 
     // get list of locals
     lldb::SBValueList args = frame.GetVariables(true, true, false, true);
+
+    // Same frame, same locals and same watches as the previous stop: the view
+    // already has the rows, so only send the values that changed
+    wxString localsKey = DoGetLocalsKey(frame, args);
+    if(!m_localsKey.IsEmpty() && localsKey == m_localsKey) {
+        NotifyLocalsChanged();
+        return;
+    }
+
+    DoClearVariables();
+    m_localsKey = localsKey;
     for(size_t i = 0; i < args.GetSize(); ++i) {
         lldb::SBValue value = args.GetValueAtIndex(i);
         if(value.IsValid()) {
             LLDBVariable::Ptr_t var(new LLDBVariable(value));
-            VariableWrapper wrapper;
-            wrapper.value = value;
-            m_variables.insert(std::make_pair(value.GetID(), wrapper));
+            DoStashVariable(value, var, true);
             locals.push_back(var);
         }
     }
@@ -760,11 +771,7 @@ void CodeLiteLLDBApp::LocalVariables(const LLDBCommand& command)
             var->SetName(m_watches.Item(i));
 
             // Keep the info about this watch
-            VariableWrapper wrapper;
-            wrapper.value = value;
-            wrapper.isWatch = true;
-            wrapper.expression = m_watches.Item(i);
-            m_variables.insert(std::make_pair(value.GetID(), wrapper));
+            DoStashVariable(value, var, true, m_watches.Item(i));
             locals.push_back(var);
         }
     }
@@ -780,6 +787,87 @@ void CodeLiteLLDBApp::NotifyLocals(LLDBVariable::Vect_t locals)
     SendReply(reply);
 }
 
+void CodeLiteLLDBApp::NotifyLocalsChanged()
+{
+    LLDBVariable::Vect_t changed;
+    std::map<int, VariableWrapper>::iterator iter = m_variables.begin();
+    for(; iter != m_variables.end(); ++iter) {
+        VariableWrapper& wrapper = iter->second;
+        if(!wrapper.value.IsValid()) continue;
+
+        wxString value = wrapper.value.GetValue();
+        wxString summary = wrapper.value.GetSummary();
+        if(value == wrapper.lastValue && summary == wrapper.lastSummary) continue;
+
+        LLDBVariable::Ptr_t var(new LLDBVariable(wrapper.value));
+        // keep the ID the view knows this variable by
+        var->SetLldbId(iter->first);
+        var->SetValueChanged(true);
+        if(wrapper.isWatch) {
+            var->SetIsWatch(true);
+            var->SetName(wrapper.expression);
+        }
+        wrapper.lastValue = value;
+        wrapper.lastSummary = summary;
+        changed.push_back(var);
+    }
+
+    wxPrintf("codelite-lldb: NotifyLocalsChanged called with %d changed variables\n", (int)changed.size());
+    LLDBReply reply;
+    reply.SetReplyType(kReplyTypeLocalsChanged);
+    reply.SetVariables(changed);
+    SendReply(reply);
+}
+
+void CodeLiteLLDBApp::DoStashVariable(lldb::SBValue value,
+                                      LLDBVariable::Ptr_t var,
+                                      bool isLocal,
+                                      const wxString& watchExpression)
+{
+    VariableWrapper wrapper;
+    wrapper.value = value;
+    wrapper.isWatch = !watchExpression.IsEmpty();
+    wrapper.isLocal = isLocal;
+    wrapper.expression = watchExpression;
+    wrapper.lastValue = var->GetValue();
+    wrapper.lastSummary = var->GetSummary();
+    m_variables.insert(std::make_pair(value.GetID(), wrapper));
+}
+
+void CodeLiteLLDBApp::DoClearVariables()
+{
+    m_variables.clear();
+    m_localsKey.Clear();
+}
+
+void CodeLiteLLDBApp::DoClearNonLocalVariables()
+{
+    std::map<int, VariableWrapper>::iterator iter = m_variables.begin();
+    while(iter != m_variables.end()) {
+        if(iter->second.isLocal) {
+            ++iter;
+        } else {
+            m_variables.erase(iter++);
+        }
+    }
+}
+
+wxString CodeLiteLLDBApp::DoGetLocalsKey(lldb::SBFrame frame, lldb::SBValueList& args) const
+{
+    wxString key = wxString::Format("%llu:%llu:%s",
+                                    (unsigned long long)frame.GetThread().GetThreadID(),
+                                    (unsigned long long)frame.GetCFA(),
+                                    frame.GetFunctionName() ? frame.GetFunctionName() : "");
+    for(size_t i = 0; i < args.GetSize(); ++i) {
+        lldb::SBValue value = args.GetValueAtIndex(i);
+        key << ":" << (value.GetName() ? value.GetName() : "") << "=" << (int)value.GetID();
+    }
+    for(size_t i = 0; i < m_watches.GetCount(); ++i) {
+        key << ":" << m_watches.Item(i);
+    }
+    return key;
+}
+
 // we need to return list of children for a variable
 // we stashed the variables we got so far inside a map
 void CodeLiteLLDBApp::ExpandVariable(const LLDBCommand& command)
@@ -792,9 +880,12 @@ void CodeLiteLLDBApp::ExpandVariable(const LLDBCommand& command)
     LLDBVariable::Vect_t children;
     std::map<int, VariableWrapper>::iterator iter = m_variables.find(variableId);
     if(iter != m_variables.end()) {
+        // the children of a local are locals as well
+        bool isLocal = iter->second.isLocal;
         lldb::SBValue* pvalue = &(iter->second.value);
         lldb::SBValue deReferencedValue;
         int size = pvalue->GetNumChildren();
+        int startIndex = wxMax(command.GetStartIndex(), 0);
 
         lldb::TypeClass typeClass = pvalue->GetType().GetTypeClass();
         if(typeClass & lldb::eTypeClassArray) {
@@ -812,14 +903,18 @@ void CodeLiteLLDBApp::ExpandVariable(const LLDBCommand& command)
             size = pvalue->GetNumChildren();
         }*/
 
-        for(int i = 0; i < size; ++i) {
+        // Only serialize the requested page of children
+        int endIndex = size;
+        if(command.GetCount() != wxNOT_FOUND && (startIndex + command.GetCount()) < size) {
+            endIndex = startIndex + command.GetCount();
+        }
+
+        for(int i = startIndex; i < endIndex; ++i) {
             lldb::SBValue child = pvalue->GetChildAtIndex(i);
             if(child.IsValid()) {
                 LLDBVariable::Ptr_t var(new LLDBVariable(child));
                 children.push_back(var);
-                VariableWrapper wrapper;
-                wrapper.value = child;
-                m_variables.insert(std::make_pair(child.GetID(), wrapper));
+                DoStashVariable(child, var, isLocal);
             }
         }
 
@@ -827,6 +922,8 @@ void CodeLiteLLDBApp::ExpandVariable(const LLDBCommand& command)
         reply.SetReplyType(kReplyTypeVariableExpanded);
         reply.SetVariables(children);
         reply.SetLldbId(variableId);
+        reply.SetStartIndex(startIndex);
+        reply.SetTotalCount(size);
         SendReply(reply);
     }
 }
@@ -920,10 +1017,8 @@ void CodeLiteLLDBApp::EvalExpression(const LLDBCommand& command)
             LLDBVariable::Ptr_t var(new LLDBVariable(value));
             vars.push_back(var);
             reply.SetVariables(vars);
-            VariableWrapper wrapper;
-            wrapper.value = value;
             // Cache the expanded variable (we will need it later for tooltip expansion
-            m_variables.insert(std::make_pair(value.GetID(), wrapper));
+            DoStashVariable(value, var, false);
 
             SendReply(reply);
         }
@@ -39,6 +39,8 @@
 #include "SocketAPI/clSocketServer.h"
 #include "LLDBProtocol/LLDBVariable.h"
 #include <lldb/API/SBValue.h>
+#include <lldb/API/SBValueList.h>
+#include <lldb/API/SBFrame.h>
 #include <wx/msgqueue.h>
 #include "LLDBProtocol/LLDBSettings.h"
 
@@ -46,9 +48,15 @@ struct VariableWrapper
 {
     lldb::SBValue value;
     bool isWatch;
+    // locals, watches and their children. The other variables (tooltips) are dropped when the process resumes
+    bool isLocal;
     wxString expression;
-    
-    VariableWrapper() : isWatch(false) {}
+    // the value and summary as last sent to codelite, used to report only
+    // the variables that changed since the previous stop
+    wxString lastValue;
+    wxString lastSummary;
+
+    VariableWrapper() : isWatch(false), isLocal(false) {}
 };
 
 class CodeLiteLLDBApp
@@ -69,6 +77,8 @@ protected:
     clSocketBase::Ptr_t m_replySocket;
     eInterruptReason m_interruptReason;
     std::map<int, VariableWrapper> m_variables;
+    // identifies the frame (and watches) m_variables were collected for
+    wxString m_localsKey;
     wxArrayString m_watches;
     wxMessageQueue<CodeLiteLLDBApp::QueueItem_t> m_commands_queue;
     wxMessageQueue<CodeLiteLLDBApp::NotifyFunc_t> m_notify_queue;
@@ -85,6 +95,13 @@ private:
     bool InitializeLLDB(const LLDBCommand& command);
     void DoInitializeApp();
     void DoExecutueShellCommand(const wxString& command, bool printOutput = true);
+    void DoStashVariable(lldb::SBValue value,
+                         LLDBVariable::Ptr_t var,
+                         bool isLocal,
+                         const wxString& watchExpression = "");
+    void DoClearVariables();
+    void DoClearNonLocalVariables();
+    wxString DoGetLocalsKey(lldb::SBFrame frame, lldb::SBValueList& args) const;
 
 public:
     void NotifyStoppedOnFirstEntry();
@@ -97,6 +114,7 @@ public:
     void NotifyAllBreakpointsDeleted();
 
     void NotifyLocals(LLDBVariable::Vect_t locals);
+    void NotifyLocalsChanged();
 
     void SendReply(const LLDBReply& reply);
     bool CanInteract();
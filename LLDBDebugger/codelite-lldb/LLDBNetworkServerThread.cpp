@@ -32,6 +32,7 @@
 LLDBNetworkServerThread::LLDBNetworkServerThread(CodeLiteLLDBApp* app, socket_t fd)
     : wxThread(wxTHREAD_JOINABLE)
     , m_app(app)
+    , m_stopping(false)
 {
     m_socket.reset(new clSocketBase(fd));
     // we don't own the socket, so don't close it when we are going down
@@ -40,6 +41,9 @@ LLDBNetworkServerThread::LLDBNetworkServerThread(CodeLiteLLDBApp* app, socket_t
 
 LLDBNetworkServerThread::~LLDBNetworkServerThread()
 {
+    // the thread is blocked on the socket, wake it up
+    m_stopping = true;
+    m_socket->Shutdown();
     if(IsAlive()) {
         Delete(NULL, wxTHREAD_WAIT_BLOCK);
     } else {
@@ -56,12 +60,17 @@ void* LLDBNetworkServerThread::Entry()
 
         // we got connection, enter the main loop
         while(!TestDestroy()) {
-            wxString str;
-            if(m_socket->ReadMessage(str, 1) == clSocketBase::kSuccess) {
-                // wxPrintf("codelite-lldb: received command\n%s\n", str);
-
+            // Block until codelite sends a command
+            std::string frame;
+            if(m_socket->ReadFrame(frame) == clSocketBase::kSuccess) {
                 // Process command
-                LLDBCommand command(str);
+                LLDBPacketReader reader(frame);
+                LLDBCommand command;
+                command.FromBinary(reader);
+                if(!reader.IsOk()) {
+                    wxPrintf("codelite-lldb: discarding malformed command packet (%d bytes)\n", (int)frame.length());
+                    continue;
+                }
                 switch(command.GetCommandType()) {
                 case kCommandInterperterCommand:
                     m_app->CallAfter(&CodeLiteLLDBApp::ExecuteInterperterCommand, command);
@@ -165,6 +174,10 @@ void* LLDBNetworkServerThread::Entry()
         }
 
     } catch(clSocketException& e) {
+        if(m_stopping) {
+            // we are going down, the socket was shut down by us
+            return NULL;
+        }
         wxPrintf("codelite-lldb: error while reading message. %s\n", e.what().c_str());
         m_app->CallAfter(&CodeLiteLLDBApp::NotifyAborted);
         return NULL;
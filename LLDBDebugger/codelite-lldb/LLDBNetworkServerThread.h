@@ -34,7 +34,8 @@ class LLDBNetworkServerThread : public wxThread
 {
     CodeLiteLLDBApp* m_app;
     clSocketBase::Ptr_t m_socket;
-    
+    volatile bool m_stopping;
+
 public:
     LLDBNetworkServerThread(CodeLiteLLDBApp* app, socket_t fd);
     virtual ~LLDBNetworkServerThread();
@@ -0,0 +1,359 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : BuildOutputParser.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "BuildOutputParser.h"
+#include <algorithm>
+#include <string.h>
+
+namespace
+{
+struct NoCaseEqual {
+    bool operator()(const wxUniChar& ch, char lowerCh) const
+    {
+        wxUniChar::value_type value = ch.GetValue();
+        if(value >= 'A' && value <= 'Z') {
+            value += ('a' - 'A');
+        }
+        return value == (wxUniChar::value_type)lowerCh;
+    }
+};
+
+// ASCII case insensitive search of the lower case 'needle', without allocating a lower cased copy of 'str'
+bool ContainsNoCase(const wxString& str, const char* needle)
+{
+    const char* needleEnd = needle + strlen(needle);
+    return std::search(str.begin(), str.end(), needle, needleEnd, NoCaseEqual()) != str.end();
+}
+
+void CopyPatterns(const Compiler::CmpListInfoPattern& from, Compiler::CmpListInfoPattern& to)
+{
+    // Deep copy, the patterns are used by the parser thread
+    to.clear();
+    Compiler::CmpListInfoPattern::const_iterator iter = from.begin();
+    for(; iter != from.end(); ++iter) {
+        Compiler::CmpInfoPattern pattern;
+        pattern.pattern = iter->pattern.c_str();
+        pattern.fileNameIndex = iter->fileNameIndex.c_str();
+        pattern.lineNumberIndex = iter->lineNumberIndex.c_str();
+        pattern.columnIndex = iter->columnIndex.c_str();
+        to.push_back(pattern);
+    }
+}
+}
+
+BuildOutputParser::BuildOutputParser()
+    : wxThread(wxTHREAD_JOINABLE)
+    , m_workCond(m_mutex)
+    , m_flushCond(m_mutex)
+    , m_configChanged(false)
+    , m_generation(0)
+    , m_flushRequested(0)
+    , m_flushDone(0)
+    , m_busy(false)
+    , m_stop(false)
+    , m_activeGeneration(0)
+{
+}
+
+BuildOutputParser::~BuildOutputParser() { DeleteLines(m_output); }
+
+void BuildOutputParser::Start()
+{
+    Create();
+    Run();
+}
+
+void BuildOutputParser::Stop()
+{
+    {
+        wxMutexLocker locker(m_mutex);
+        m_stop = true;
+        m_workCond.Signal();
+        m_flushCond.Broadcast();
+    }
+
+    if(IsAlive()) {
+        Delete(NULL, wxTHREAD_WAIT_BLOCK);
+
+    } else {
+        Wait(wxTHREAD_WAIT_BLOCK);
+    }
+}
+
+void* BuildOutputParser::Entry()
+{
+    while(true) {
+        wxString chunk;
+        bool configChanged = false;
+        size_t generation = 0;
+        size_t flushRequested = 0;
+        bool flush = false;
+        {
+            wxMutexLocker locker(m_mutex);
+            while(!m_stop && m_input.IsEmpty() && !m_configChanged && m_flushRequested == m_flushDone) {
+                m_workCond.Wait();
+            }
+            if(m_stop) break;
+
+            if(m_configChanged) {
+                m_activeConfig = m_config;
+                m_configChanged = false;
+                configChanged = true;
+            }
+            chunk.swap(m_input);
+            generation = m_generation;
+            flushRequested = m_flushRequested;
+            flush = (m_flushRequested != m_flushDone);
+            m_busy = true;
+        }
+
+        if(generation != m_activeGeneration) {
+            // Clear() was called: a new build log
+            m_tail.Clear();
+            m_directories.Clear();
+            m_activeGeneration = generation;
+        }
+
+        if(configChanged) {
+            DoCompilePatterns();
+        }
+
+        BuildOutputLineVec_t lines;
+        DoParse(chunk, flush, lines);
+
+        {
+            wxMutexLocker locker(m_mutex);
+            if(generation == m_generation) {
+                if(m_output.empty()) {
+                    m_output.swap(lines);
+                } else {
+                    m_output.insert(m_output.end(), lines.begin(), lines.end());
+                    lines.clear();
+                }
+            }
+            m_busy = false;
+            if(flush) {
+                m_flushDone = flushRequested;
+                m_flushCond.Broadcast();
+            }
+        }
+        // Lines of a cleared build log
+        DeleteLines(lines);
+    }
+    return NULL;
+}
+
+void BuildOutputParser::SetCompiler(CompilerPtr compiler, const wxString& cygwinRoot, bool prefilter)
+{
+    wxMutexLocker locker(m_mutex);
+    if(compiler) {
+        CopyPatterns(compiler->GetErrPatterns(), m_config.errPatterns);
+        CopyPatterns(compiler->GetWarnPatterns(), m_config.warnPatterns);
+    } else {
+        m_config.errPatterns.clear();
+        m_config.warnPatterns.clear();
+    }
+    m_config.cygwinRoot = cygwinRoot.c_str();
+    m_config.prefilter = prefilter;
+    m_configChanged = true;
+    m_workCond.Signal();
+}
+
+void BuildOutputParser::Add(const wxString& output)
+{
+    if(output.IsEmpty()) return;
+
+    wxMutexLocker locker(m_mutex);
+    // Chunks that arrive while the thread is busy are parsed together
+    m_input << output.c_str();
+    m_workCond.Signal();
+}
+
+void BuildOutputParser::Flush()
+{
+    wxMutexLocker locker(m_mutex);
+    size_t flushRequest = ++m_flushRequested;
+    m_workCond.Signal();
+    while(!m_stop && m_flushDone < flushRequest) {
+        m_flushCond.Wait();
+    }
+}
+
+void BuildOutputParser::Clear()
+{
+    wxMutexLocker locker(m_mutex);
+    ++m_generation;
+    m_input.Clear();
+    DeleteLines(m_output);
+    m_workCond.Signal();
+}
+
+bool BuildOutputParser::TakeLines(BuildOutputLineVec_t& lines)
+{
+    wxMutexLocker locker(m_mutex);
+    if(m_output.empty()) return false;
+    lines.swap(m_output);
+    m_output.clear();
+    return true;
+}
+
+bool BuildOutputParser::IsEmpty()
+{
+    wxMutexLocker locker(m_mutex);
+    return m_input.IsEmpty() && m_output.empty() && !m_busy;
+}
+
+void BuildOutputParser::DeleteLines(BuildOutputLineVec_t& lines)
+{
+    for(size_t i = 0; i < lines.size(); ++i) {
+        wxDELETE(lines.at(i).info);
+    }
+    lines.clear();
+}
+
+void BuildOutputParser::DoCompilePatterns()
+{
+    m_patterns.errorsPatterns.clear();
+    m_patterns.warningPatterns.clear();
+
+    Compiler::CmpListInfoPattern::const_iterator iter;
+    for(iter = m_activeConfig.errPatterns.begin(); iter != m_activeConfig.errPatterns.end(); ++iter) {
+        CmpPatternPtr compiledPatternPtr(new CmpPattern(new wxRegEx(iter->pattern, wxRE_ADVANCED | wxRE_ICASE),
+            iter->fileNameIndex, iter->lineNumberIndex, iter->columnIndex, SV_ERROR));
+        if(compiledPatternPtr->GetRegex()->IsValid()) {
+            m_patterns.errorsPatterns.push_back(compiledPatternPtr);
+        }
+    }
+
+    for(iter = m_activeConfig.warnPatterns.begin(); iter != m_activeConfig.warnPatterns.end(); ++iter) {
+        CmpPatternPtr compiledPatternPtr(new CmpPattern(new wxRegEx(iter->pattern, wxRE_ADVANCED | wxRE_ICASE),
+            iter->fileNameIndex, iter->lineNumberIndex, iter->columnIndex, SV_WARNING));
+        if(compiledPatternPtr->GetRegex()->IsValid()) {
+            m_patterns.warningPatterns.push_back(compiledPatternPtr);
+        }
+    }
+}
+
+void BuildOutputParser::DoParse(const wxString& chunk, bool flush, BuildOutputLineVec_t& lines)
+{
+    m_tail << chunk;
+
+    // Parse only completed lines (i.e. a line that ends with '\n') unless we were asked to flush
+    size_t start = 0;
+    while(start < m_tail.length()) {
+        size_t eol = m_tail.find('\n', start);
+        if(eol == wxString::npos) {
+            if(!flush) break;
+            eol = m_tail.length() - 1;
+        }
+        DoParseLine(m_tail.Mid(start, eol - start + 1), lines);
+        start = eol + 1;
+    }
+    m_tail.Remove(0, start);
+}
+
+void BuildOutputParser::DoParseLine(const wxString& line, BuildOutputLineVec_t& lines)
+{
+    // If this is a line similar to 'Entering directory `'
+    // add the path in the directories array
+    DoSearchForDirectory(line);
+
+    BuildLineInfo* buildLineInfo = new BuildLineInfo();
+    LINE_SEVERITY severity = SV_NONE;
+    if(ContainsNoCase(line, "entering directory") || ContainsNoCase(line, "leaving directory")) {
+        severity = SV_DIR_CHANGE;
+
+    } else if(!line.StartsWith("====") && (!m_activeConfig.prefilter || IsDiagnosticCandidate(line))) {
+        // Find *warnings* first
+        BuildLineInfo bli;
+        if(DoMatch(m_patterns.warningPatterns, line, bli) || DoMatch(m_patterns.errorsPatterns, line, bli)) {
+            buildLineInfo->SetFilename(bli.GetFilename());
+            buildLineInfo->SetLineNumber(bli.GetLineNumber());
+            buildLineInfo->NormalizeFilename(m_directories, m_activeConfig.cygwinRoot);
+            buildLineInfo->SetRegexLineMatch(bli.GetRegexLineMatch());
+            buildLineInfo->SetColumn(bli.GetColumn());
+            severity = bli.GetSeverity();
+        }
+    }
+    buildLineInfo->SetSeverity(severity);
+
+    BuildOutputLine buildLine;
+    buildLine.text = line;
+    buildLine.text.Trim();
+    buildLine.info = buildLineInfo;
+    switch(severity) {
+    case SV_WARNING:
+        buildLine.style = LEX_GCC_WARNING;
+        break;
+    case SV_ERROR:
+        buildLine.style = LEX_GCC_ERROR;
+        break;
+    case SV_DIR_CHANGE:
+        buildLine.style = LEX_GCC_INFO;
+        break;
+    case SV_SUCCESS:
+    case SV_NONE:
+    default:
+        buildLine.style = LEX_GCC_DEFAULT;
+        break;
+    }
+    lines.push_back(buildLine);
+}
+
+void BuildOutputParser::DoSearchForDirectory(const wxString& line)
+{
+    // Check for makefile directory changes lines
+    if(line.Contains(wxT("Entering directory `"))) {
+        wxString currentDir = line.AfterFirst(wxT('`'));
+        currentDir = currentDir.BeforeLast(wxT('\''));
+
+        // Collect the m_baseDir
+        m_directories.Add(currentDir);
+    }
+}
+
+bool BuildOutputParser::DoMatch(std::vector<CmpPatternPtr>& patterns, const wxString& line, BuildLineInfo& bli)
+{
+    for(size_t i = 0; i < patterns.size(); ++i) {
+        if(patterns.at(i)->Matches(line, bli)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BuildOutputParser::IsDiagnosticCandidate(const wxString& line)
+{
+    // "file:line", "file(line)" or "file.o:(.text+0x..)"
+    wxUniChar prev = 0;
+    for(wxString::const_iterator iter = line.begin(); iter != line.end(); ++iter) {
+        wxUniChar ch = *iter;
+        if((prev == ':' || prev == '(') && ch >= '0' && ch <= '9') return true;
+        if(prev == ':' && ch == '(') return true;
+        prev = ch;
+    }
+    return ContainsNoCase(line, "error") || ContainsNoCase(line, "warning") ||
+        ContainsNoCase(line, "undefined reference");
+}
@@ -0,0 +1,140 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : BuildOutputParser.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BUILDOUTPUTPARSER_H
+#define BUILDOUTPUTPARSER_H
+
+#include <wx/thread.h>
+#include <wx/string.h>
+#include <wx/arrstr.h>
+#include "compiler.h"
+#include "new_build_tab.h"
+
+/**
+ * @class BuildOutputParser
+ * @brief parses the build output in a background thread.
+ * The output is added in chunks as it arrives. The thread splits it into lines, matches the lines
+ * against the compiler error and warning patterns and keeps the parsed lines until the build tab
+ * takes them (once per refresh of the build view).
+ * Unless disabled, lines that do not look like a diagnostic (no "error" / "warning" text and no
+ * "file:line" or "file(line)" shape) are not matched against the patterns at all
+ */
+class BuildOutputParser : public wxThread
+{
+    struct Config {
+        Compiler::CmpListInfoPattern errPatterns;
+        Compiler::CmpListInfoPattern warnPatterns;
+        wxString cygwinRoot;
+        bool prefilter;
+
+        Config()
+            : prefilter(true)
+        {
+        }
+    };
+
+    // Shared with the main thread, guarded by m_mutex
+    wxMutex m_mutex;
+    wxCondition m_workCond;  // signalled when there is work for the thread
+    wxCondition m_flushCond; // signalled when a flush is done
+    wxString m_input;
+    BuildOutputLineVec_t m_output;
+    Config m_config;
+    bool m_configChanged;
+    size_t m_generation;
+    size_t m_flushRequested;
+    size_t m_flushDone;
+    bool m_busy;
+    bool m_stop;
+
+    // Used by the parser thread only
+    Config m_activeConfig;
+    CmpPatterns m_patterns;
+    wxString m_tail; // an incomplete line
+    wxArrayString m_directories;
+    size_t m_activeGeneration;
+
+protected:
+    virtual void* Entry();
+
+    void DoCompilePatterns();
+    void DoParse(const wxString& chunk, bool flush, BuildOutputLineVec_t& lines);
+    void DoParseLine(const wxString& line, BuildOutputLineVec_t& lines);
+    void DoSearchForDirectory(const wxString& line);
+    bool DoMatch(std::vector<CmpPatternPtr>& patterns, const wxString& line, BuildLineInfo& bli);
+    static bool IsDiagnosticCandidate(const wxString& line);
+    static void DeleteLines(BuildOutputLineVec_t& lines);
+
+public:
+    BuildOutputParser();
+    virtual ~BuildOutputParser();
+
+    /**
+     * @brief start the parser thread
+     */
+    void Start();
+
+    /**
+     * @brief stop the parser thread and wait for it to exit
+     */
+    void Stop();
+
+    /**
+     * @brief use the patterns of 'compiler' for the output added from now on
+     * @param compiler the compiler of the build, may be NULL
+     * @param cygwinRoot used to resolve cygwin paths (Windows only)
+     * @param prefilter when false, every line is matched against the patterns
+     */
+    void SetCompiler(CompilerPtr compiler, const wxString& cygwinRoot, bool prefilter);
+
+    /**
+     * @brief add build output
+     */
+    void Add(const wxString& output);
+
+    /**
+     * @brief block until all the output added so far (including an incomplete last line) is parsed
+     */
+    void Flush();
+
+    /**
+     * @brief discard the output that was not taken yet and forget the directories seen so far
+     * (a new build log starts)
+     */
+    void Clear();
+
+    /**
+     * @brief take the parsed lines
+     * @return false if there are no parsed lines
+     */
+    bool TakeLines(BuildOutputLineVec_t& lines);
+
+    /**
+     * @brief return true if there is no output waiting to be parsed or taken
+     */
+    bool IsEmpty();
+};
+
+#endif // BUILDOUTPUTPARSER_H
@@ -95,6 +95,7 @@
 #include "editorframe.h"
 #include "clang_compilation_db_thread.h"
 #include "file_logger.h"
+#include "unixprocess_reactor.h"
 #include "code_completion_manager.h"
 #include "CompileCommandsCreateor.h"
 #include "CompilersModifiedDlg.h"
@@ -267,6 +268,11 @@ Manager::~Manager(void)
     TabGroupsManager::Free();
     clKeyboardManager::Release();
     wxCodeCompletionBoxManager::Free();
+
+#if defined(__WXMAC__) || defined(__WXGTK__)
+    // Stop reading the output of the processes that are still running
+    UnixProcessReactor::Stop();
+#endif
 }
 
 //--------------------------- Workspace Loading -----------------------------
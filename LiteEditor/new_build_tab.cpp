@@ -55,6 +55,7 @@
 #include "optionsconfig.h"
 #include "editor_config.h"
 #include "clSingleChoiceDialog.h"
+#include "BuildOutputParser.h"
 
 #define IS_VALID_LINE(lineNumber) ((lineNumber >= 0 && lineNumber < m_view->GetLineCount()))
 #ifdef __WXMSW__
@@ -63,6 +64,9 @@
 #define IS_WINDOWS false
 #endif
 
+// Parsed build output is added to the view once per refresh interval (ms)
+#define BUILD_TAB_REFRESH_INTERVAL 30
+
 // Helper function to post an event to the frame
 void SetActive(LEditor* editor)
 {
@@ -82,11 +86,6 @@ struct AnnotationInfo {
 };
 typedef std::map<int, AnnotationInfo> AnnotationInfoByLineMap_t;
 
-#define LEX_GCC_DEFAULT 0
-#define LEX_GCC_ERROR 1
-#define LEX_GCC_WARNING 2
-#define LEX_GCC_INFO 3
-
 #define LEX_GCC_MARKER 1
 
 NewBuildTab::NewBuildTab(wxWindow* parent)
@@ -100,7 +99,6 @@ NewBuildTab::NewBuildTab(wxWindow* parent)
     , m_buildpaneScrollTo(ScrollToFirstError)
     , m_buildInProgress(false)
     , m_maxlineWidth(wxNOT_FOUND)
-    , m_lastLineColoured(wxNOT_FOUND)
 {
     m_curError = m_errorsAndWarningsList.end();
     wxBoxSizer* bs = new wxBoxSizer(wxVERTICAL);
@@ -109,7 +107,12 @@ NewBuildTab::NewBuildTab(wxWindow* parent)
     m_view = new wxStyledTextCtrl(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE);
     // We dont really want to collect undo in the output tabs...
     InitView();
-    Bind(wxEVT_IDLE, &NewBuildTab::OnIdle, this);
+
+    // Parse the build output in the background
+    m_parser = new BuildOutputParser();
+    m_parser->Start();
+    m_refreshTimer = new wxTimer(this);
+    Bind(wxEVT_TIMER, &NewBuildTab::OnRefreshTimer, this, m_refreshTimer->GetId());
 
     m_view->Bind(wxEVT_STC_HOTSPOT_CLICK, &NewBuildTab::OnHotspotClicked, this);
     EventNotifier::Get()->Bind(wxEVT_CL_THEME_CHANGED, &NewBuildTab::OnThemeChanged, this);
@@ -141,6 +144,12 @@ NewBuildTab::NewBuildTab(wxWindow* parent)
 
 NewBuildTab::~NewBuildTab()
 {
+    m_refreshTimer->Stop();
+    Unbind(wxEVT_TIMER, &NewBuildTab::OnRefreshTimer, this, m_refreshTimer->GetId());
+    wxDELETE(m_refreshTimer);
+    m_parser->Stop();
+    wxDELETE(m_parser);
+
     EventNotifier::Get()->Unbind(wxEVT_CL_THEME_CHANGED, &NewBuildTab::OnThemeChanged, this);
     EventNotifier::Get()->Disconnect(
         wxEVT_SHELL_COMMAND_STARTED, clCommandEventHandler(NewBuildTab::OnBuildStarted), NULL, this);
@@ -162,7 +171,11 @@ void NewBuildTab::OnBuildEnded(clCommandEvent& e)
     CL_DEBUG("Build Ended!");
     m_buildInProgress = false;
 
-    DoProcessOutput(true, false);
+    // Parse what is left of the output (including an incomplete last line) and show it: the error
+    // and warning counts must be final when this function returns
+    m_parser->Flush();
+    DoAppendParsedLines();
+    m_refreshTimer->Stop();
 
     std::vector<LEditor*> editors;
     clMainFrame::Get()->GetMainBook()->GetAllEditors(editors, MainBook::kGetAll_Default);
@@ -182,14 +195,11 @@ void NewBuildTab::OnBuildEnded(clCommandEvent& e)
         term << wxString::Format(wxT(", %s: %02ld:%02ld:%02ld %s"), _("total time"), hours, minutes, sec, _("seconds"));
     }
 
-    m_output = term;
-    DoProcessOutput(true, true);
+    DoAppendLine("====" + term + "====");
 
     if(m_buildInterrupted) {
-        wxString InterruptedMsg;
-        InterruptedMsg << _("(Build Cancelled)") << wxT("\n\n");
-        m_output = InterruptedMsg;
-        DoProcessOutput(true, false);
+        DoAppendLine(_("(Build Cancelled)"));
+        DoAppendLine(wxEmptyString);
     }
 
     // Hide / Show the build tab according to the settings
@@ -252,7 +262,10 @@ void NewBuildTab::OnBuildStarted(clCommandEvent& e)
 
     if(e.GetEventType() != wxEVT_SHELL_COMMAND_STARTED_NOCLEAN) {
         DoClear();
-        DoCacheRegexes();
+    } else {
+        // The output of this build follows the previous one, show what is left of it first
+        m_parser->Flush();
+        DoAppendParsedLines();
     }
 
     // Show the tab if needed
@@ -289,102 +302,127 @@ void NewBuildTab::OnBuildStarted(clCommandEvent& e)
         buildEvent.SetConfigurationName(bed->GetConfiguration());
         EventNotifier::Get()->AddPendingEvent(buildEvent);
     }
+    m_parser->SetCompiler(m_cmp, m_cygwinRoot, clConfig::Get().Read(kConfigBuildOutputPrefilter, true));
 }
 
 void NewBuildTab::OnBuildAddLine(clCommandEvent& e)
 {
     e.Skip(); // Allways call skip..
-    m_output << e.GetString();
-    DoProcessOutput(false, false);
+    DoAddOutput(e.GetString());
 }
 
-BuildLineInfo* NewBuildTab::DoProcessLine(const wxString& line)
+void NewBuildTab::DoAddOutput(const wxString& output)
 {
-    BuildLineInfo* buildLineInfo = new BuildLineInfo();
-    LINE_SEVERITY severity;
-    // Get the matching regex for this line
-    CmpPatternPtr cmpPatterPtr = GetMatchingRegex(line, severity);
-    buildLineInfo->SetSeverity(severity);
-    BuildLineInfo bli;
-    if(cmpPatterPtr && cmpPatterPtr->Matches(line, bli)) {
-        buildLineInfo->SetFilename(bli.GetFilename());
-        buildLineInfo->SetSeverity(bli.GetSeverity());
-        buildLineInfo->SetLineNumber(bli.GetLineNumber());
-        buildLineInfo->NormalizeFilename(m_directories, m_cygwinRoot);
-        buildLineInfo->SetRegexLineMatch(bli.GetRegexLineMatch());
-        buildLineInfo->SetColumn(bli.GetColumn());
-        if(severity == SV_WARNING) {
-            // Warning
+    m_parser->Add(output);
+    if(!m_refreshTimer->IsRunning()) {
+        m_refreshTimer->Start(BUILD_TAB_REFRESH_INTERVAL);
+    }
+}
+
+void NewBuildTab::OnRefreshTimer(wxTimerEvent& event)
+{
+    if(!DoAppendParsedLines() && !m_buildInProgress && m_parser->IsEmpty()) {
+        // Nothing more to show
+        m_refreshTimer->Stop();
+    }
+}
+
+bool NewBuildTab::DoAppendParsedLines()
+{
+    BuildOutputLineVec_t lines;
+    if(!m_parser->TakeLines(lines)) {
+        return false;
+    }
+    DoAppendLines(lines);
+    return true;
+}
+
+void NewBuildTab::DoAppendLine(const wxString& text)
+{
+    BuildOutputLineVec_t lines;
+    BuildOutputLine line;
+    line.text = text;
+    line.text.Trim();
+    line.info = new BuildLineInfo();
+    line.style = LEX_GCC_DEFAULT;
+    lines.push_back(line);
+    DoAppendLines(lines);
+}
+
+void NewBuildTab::DoAppendLines(BuildOutputLineVec_t& lines)
+{
+    if(lines.empty()) return;
+
+    // Keep the line numbers in the build tab
+    int firstLine = m_view->GetLineCount() - 1; // -1 because the view always has 1 extra "\n"
+    size_t longestLine = 0;
+    wxString text;
+    for(size_t i = 0; i < lines.size(); ++i) {
+        const BuildOutputLine& line = lines.at(i);
+        BuildLineInfo* buildLineInfo = line.info;
+        buildLineInfo->SetLineInBuildTab(firstLine + i);
+
+        // Store the line info *before* we add the text
+        m_viewData.insert(std::make_pair(buildLineInfo->GetLineInBuildTab(), buildLineInfo));
+        if(buildLineInfo->GetFilename().IsEmpty() == false) {
+            m_buildInfoPerFile.insert(std::make_pair(buildLineInfo->GetFilename(), buildLineInfo));
+        }
+
+        if(buildLineInfo->GetSeverity() == SV_WARNING) {
             m_errorsAndWarningsList.push_back(buildLineInfo);
             m_warnCount++;
-        } else {
-            // Error
+
+        } else if(buildLineInfo->GetSeverity() == SV_ERROR) {
             m_errorsAndWarningsList.push_back(buildLineInfo);
             m_errorsList.push_back(buildLineInfo);
             m_errorCount++;
         }
-    }
-    return buildLineInfo;
-}
 
-void NewBuildTab::DoCacheRegexes()
-{
-    m_cmpPatterns.clear();
-
-    // Loop over all known compilers and cache the regular expressions
-    BuildSettingsConfigCookie cookie;
-    CompilerPtr cmp = BuildSettingsConfigST::Get()->GetFirstCompiler(cookie);
-    while(cmp) {
-        CmpPatterns cmpPatterns;
-        const Compiler::CmpListInfoPattern& errPatterns = cmp->GetErrPatterns();
-        const Compiler::CmpListInfoPattern& warnPatterns = cmp->GetWarnPatterns();
-        Compiler::CmpListInfoPattern::const_iterator iter;
-        for(iter = errPatterns.begin(); iter != errPatterns.end(); iter++) {
-
-            CmpPatternPtr compiledPatternPtr(new CmpPattern(new wxRegEx(iter->pattern, wxRE_ADVANCED | wxRE_ICASE),
-                iter->fileNameIndex, iter->lineNumberIndex, iter->columnIndex, SV_ERROR));
-            if(compiledPatternPtr->GetRegex()->IsValid()) {
-                cmpPatterns.errorsPatterns.push_back(compiledPatternPtr);
-            }
+        if(line.text.length() > lines.at(longestLine).text.length()) {
+            longestLine = i;
         }
+        text << line.text << "\n";
+    }
 
-        for(iter = warnPatterns.begin(); iter != warnPatterns.end(); iter++) {
+    m_view->SetEditable(true);
+    m_view->AppendText(text);
 
-            CmpPatternPtr compiledPatternPtr(new CmpPattern(new wxRegEx(iter->pattern, wxRE_ADVANCED | wxRE_ICASE),
-                iter->fileNameIndex, iter->lineNumberIndex, iter->columnIndex, SV_WARNING));
-            if(compiledPatternPtr->GetRegex()->IsValid()) {
-                cmpPatterns.warningPatterns.push_back(compiledPatternPtr);
-            }
-        }
+    // Apply the styles computed by the parser
+    m_view->StartStyling(m_view->PositionFromLine(firstLine), 0x1f);
+    for(size_t i = 0; i < lines.size(); ++i) {
+        int line = firstLine + i;
+        m_view->SetStyling(m_view->PositionFromLine(line + 1) - m_view->PositionFromLine(line), lines.at(i).style);
+    }
 
-        m_cmpPatterns.insert(std::make_pair(cmp->GetName(), cmpPatterns));
-        cmp = BuildSettingsConfigST::Get()->GetNextCompiler(cookie);
+    // update the scroll width with the longest of the added lines
+    int curLen = m_view->TextWidth(lines.at(longestLine).style, lines.at(longestLine).text) + 10;
+    m_maxlineWidth = wxMax(m_maxlineWidth, curLen);
+    if(m_maxlineWidth > 0) {
+        m_view->SetScrollWidth(m_maxlineWidth);
     }
-}
+    m_view->SetEditable(false);
 
-bool NewBuildTab::DoGetCompilerPatterns(const wxString& compilerName, CmpPatterns& patterns)
-{
-    MapCmpPatterns_t::iterator iter = m_cmpPatterns.find(compilerName);
-    if(iter == m_cmpPatterns.end()) {
-        return false;
+    // The view owns the line info now
+    lines.clear();
+
+    if(clConfig::Get().Read(kConfigBuildAutoScroll, true)) {
+        m_view->ScrollToEnd();
     }
-    patterns = iter->second;
-    return true;
 }
 
 void NewBuildTab::DoClear()
 {
     wxFont font = DoGetFont();
-    m_lastLineColoured = wxNOT_FOUND;
     m_maxlineWidth = wxNOT_FOUND;
     m_buildInterrupted = false;
-    m_directories.Clear();
     m_buildInfoPerFile.clear();
     m_warnCount = 0;
     m_errorCount = 0;
     m_errorsAndWarningsList.clear();
     m_errorsList.clear();
-    m_cmpPatterns.clear();
+
+    // Discard the output that was not added to the view yet
+    m_parser->Clear();
 
     // Delete all the user data
     std::for_each(m_viewData.begin(), m_viewData.end(), [&](std::pair<int, BuildLineInfo*> p) { delete p.second; });
@@ -483,18 +521,6 @@ void NewBuildTab::MarkEditor(LEditor* editor)
     editor->Refresh();
 }
 
-void NewBuildTab::DoSearchForDirectory(const wxString& line)
-{
-    // Check for makefile directory changes lines
-    if(line.Contains(wxT("Entering directory `"))) {
-        wxString currentDir = line.AfterFirst(wxT('`'));
-        currentDir = currentDir.BeforeLast(wxT('\''));
-
-        // Collect the m_baseDir
-        m_directories.Add(currentDir);
-    }
-}
-
 void NewBuildTab::OnWorkspaceClosed(wxCommandEvent& e)
 {
     e.Skip();
@@ -509,73 +535,6 @@ void NewBuildTab::OnWorkspaceLoaded(wxCommandEvent& e)
     InitView();
 }
 
-void NewBuildTab::DoProcessOutput(bool compilationEnded, bool isSummaryLine)
-{
-    wxUnusedVar(isSummaryLine);
-    if(!compilationEnded && m_output.Find(wxT("\n")) == wxNOT_FOUND) {
-        // still dont have a complete line
-        return;
-    }
-
-    wxArrayString lines = ::wxStringTokenize(m_output, wxT("\n"), wxTOKEN_RET_DELIMS);
-    m_output.Clear();
-
-    // Process only completed lines (i.e. a line that ends with '\n')
-    for(size_t i = 0; i < lines.GetCount(); ++i) {
-        if(!compilationEnded && !lines.Item(i).EndsWith(wxT("\n"))) {
-            m_output << lines.Item(i);
-            return;
-        }
-
-        wxString buildLine = lines.Item(i); //.Trim().Trim(false);
-        // If this is a line similar to 'Entering directory `'
-        // add the path in the directories array
-        DoSearchForDirectory(buildLine);
-        BuildLineInfo* buildLineInfo = DoProcessLine(buildLine);
-
-        // keep the line info
-        if(buildLineInfo->GetFilename().IsEmpty() == false) {
-            m_buildInfoPerFile.insert(std::make_pair(buildLineInfo->GetFilename(), buildLineInfo));
-        }
-
-        if(isSummaryLine) {
-            buildLine.Trim();
-            buildLine.Prepend("====");
-            buildLine.Append("====");
-            buildLineInfo->SetSeverity(SV_NONE);
-        }
-
-        // Keep the line number in the build tab
-        buildLineInfo->SetLineInBuildTab(m_view->GetLineCount() - 1); // -1 because the view always has 1 extra "\n"
-        // Store the line info *before* we add the text
-        // it is needed in the OnStyle function
-        m_viewData.insert(std::make_pair(buildLineInfo->GetLineInBuildTab(), buildLineInfo));
-
-        m_view->SetEditable(true);
-        buildLine.Trim();
-        int curline = m_view->GetLineCount() - 1;
-        m_view->AppendText(buildLine + "\n");
-
-        // get the newly added line width
-        int endPosition = m_view->GetLineEndPosition(curline); // get character position from begin
-        int beginPosition = m_view->PositionFromLine(curline); // and end of line
-
-        wxPoint beginPos = m_view->PointFromPosition(beginPosition);
-        wxPoint endPos = m_view->PointFromPosition(endPosition);
-
-        int curLen = (endPos.x - beginPos.x) + 10;
-        m_maxlineWidth = wxMax(m_maxlineWidth, curLen);
-        if(m_maxlineWidth > 0) {
-            m_view->SetScrollWidth(m_maxlineWidth);
-        }
-        m_view->SetEditable(false);
-
-        if(clConfig::Get().Read(kConfigBuildAutoScroll, true)) {
-            m_view->ScrollToEnd();
-        }
-    }
-}
-
 void NewBuildTab::CenterLineInView(int line)
 {
     if(line > m_view->GetLineCount()) return;
@@ -814,11 +773,7 @@ void NewBuildTab::OnClearUI(wxUpdateUIEvent& e) { e.Enable(!m_buildInProgress &&
 
 void NewBuildTab::ScrollToBottom() { m_view->ScrollToEnd(); }
 
-void NewBuildTab::AppendLine(const wxString& text)
-{
-    m_output << text;
-    DoProcessOutput(false, false);
-}
+void NewBuildTab::AppendLine(const wxString& text) { DoAddOutput(text); }
 
 void NewBuildTab::OnStyleNeeded(wxStyledTextEvent& event)
 {
@@ -953,107 +908,6 @@ void NewBuildTab::DoCentreErrorLine(BuildLineInfo* bli, LEditor* editor, bool ce
     SetActive(editor);
 }
 
-void NewBuildTab::ColourOutput()
-{
-    // Loop over the lines and colour them
-    int fromLine = (m_lastLineColoured == wxNOT_FOUND) ? 0 : m_lastLineColoured;
-    int untilLine = (m_view->GetLineCount() - 1);
-
-    if(fromLine == untilLine) {
-        return;
-    }
-
-    for(int i = fromLine; (i < untilLine) && (untilLine >= fromLine); ++i) {
-        int startPos = m_view->PositionFromLine(i);
-        int lineEndPos = m_view->GetLineEndPosition(i);
-
-        m_view->StartStyling(startPos, 0x1f); // text styling
-        // Run the regexes
-        wxString lineText = m_view->GetLine(i);
-        LINE_SEVERITY severity;
-        GetMatchingRegex(lineText, severity);
-        switch(severity) {
-        case SV_WARNING:
-            m_view->SetStyling((lineEndPos - startPos), LEX_GCC_WARNING);
-            break;
-        case SV_ERROR:
-            m_view->SetStyling((lineEndPos - startPos), LEX_GCC_ERROR);
-            break;
-        case SV_SUCCESS:
-            m_view->SetStyling((lineEndPos - startPos), LEX_GCC_DEFAULT);
-            break;
-        case SV_DIR_CHANGE:
-            m_view->SetStyling((lineEndPos - startPos), LEX_GCC_INFO);
-            break;
-        case SV_NONE:
-        default:
-            m_view->SetStyling((lineEndPos - startPos), LEX_GCC_DEFAULT);
-            break;
-        }
-    }
-    m_lastLineColoured = untilLine;
-}
-
-CmpPatternPtr NewBuildTab::GetMatchingRegex(const wxString& lineText, LINE_SEVERITY& severity)
-{
-    if(lineText.Lower().Contains("entering directory") || lineText.Lower().Contains("leaving directory")) {
-        severity = SV_DIR_CHANGE;
-        return NULL;
-
-    } else if(lineText.StartsWith("====")) {
-        severity = SV_NONE;
-        return NULL;
-
-    } else {
-
-        // Find *warnings* first
-        bool isWarning = false;
-
-        if(!m_cmp) {
-            severity = SV_NONE;
-            return NULL;
-        }
-
-        CmpPatterns cmpPatterns;
-        if(!DoGetCompilerPatterns(m_cmp->GetName(), cmpPatterns)) {
-            severity = SV_NONE;
-            return NULL;
-        }
-
-        // If it is not an error, maybe it's a warning
-        for(size_t i = 0; i < cmpPatterns.warningPatterns.size(); i++) {
-            CmpPatternPtr cmpPatterPtr = cmpPatterns.warningPatterns.at(i);
-            BuildLineInfo bli;
-            if(cmpPatterPtr->Matches(lineText, bli)) {
-                severity = SV_WARNING;
-                return cmpPatterPtr;
-            }
-        }
-        if(!isWarning) {
-            for(size_t i = 0; i < cmpPatterns.errorsPatterns.size(); i++) {
-                BuildLineInfo bli;
-                CmpPatternPtr cmpPatterPtr = cmpPatterns.errorsPatterns.at(i);
-                if(cmpPatterPtr->Matches(lineText, bli)) {
-                    severity = SV_ERROR;
-                    return cmpPatterPtr;
-                }
-            }
-        }
-    }
-
-    // Default
-    severity = SV_NONE;
-    return NULL;
-}
-
-void NewBuildTab::OnIdle(wxIdleEvent& event)
-{
-    if(m_view->IsEmpty()) {
-        return;
-    }
-    ColourOutput();
-}
-
 ////////////////////////////////////////////
 // CmpPatter
 
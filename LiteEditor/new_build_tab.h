@@ -39,8 +39,17 @@
 #include <wx/regex.h>
 #include "cl_command_event.h"
 #include <wx/stc/stc.h>
+#include <wx/timer.h>
+#include <vector>
 
 class wxDataViewListCtrl;
+class BuildOutputParser;
+
+// The styles of the build view
+#define LEX_GCC_DEFAULT 0
+#define LEX_GCC_ERROR 1
+#define LEX_GCC_WARNING 2
+#define LEX_GCC_INFO 3
 
 ///////////////////////////////
 // Holds the information about
@@ -142,20 +151,31 @@ struct CmpPatterns {
     std::vector<CmpPatternPtr> warningPatterns;
 };
 
+//////////////////////////////////////////////////////////////////
+
+/**
+ * @brief a parsed line of the build output, ready to be added to the build view
+ */
+struct BuildOutputLine {
+    wxString text;       // the line text, without the trailing whitespace
+    BuildLineInfo* info; // allocated by the parser, owned by the build tab once added to the view
+    int style;           // one of the LEX_GCC_* styles
+};
+typedef std::vector<BuildOutputLine> BuildOutputLineVec_t;
+
 ///////////////////////////////////////////////////////////////////
 class LEditor;
 class NewBuildTab : public wxPanel
 {
     enum BuildpaneScrollTo { ScrollToFirstError, ScrollToFirstItem, ScrollToEnd };
 
-    typedef std::map<wxString, CmpPatterns> MapCmpPatterns_t;
     typedef std::multimap<wxString, BuildLineInfo*> MultimapBuildInfo_t;
     typedef std::list<BuildLineInfo*> BuildInfoList_t;
 
-    wxString m_output;
     wxStyledTextCtrl* m_view;
     CompilerPtr m_cmp;
-    MapCmpPatterns_t m_cmpPatterns;
+    BuildOutputParser* m_parser;
+    wxTimer* m_refreshTimer;
     int m_warnCount;
     int m_errorCount;
     BuildTabSettingsData m_buildTabSettings;
@@ -164,7 +184,6 @@ class NewBuildTab : public wxPanel
     BuildTabSettingsData::ShowBuildPane m_showMe;
     wxStopWatch m_sw;
     MultimapBuildInfo_t m_buildInfoPerFile;
-    wxArrayString m_directories;
     bool m_skipWarnings;
     BuildpaneScrollTo m_buildpaneScrollTo;
     BuildInfoList_t m_errorsAndWarningsList;
@@ -174,24 +193,20 @@ class NewBuildTab : public wxPanel
     wxString m_cygwinRoot;
     std::map<int, BuildLineInfo*> m_viewData;
     int m_maxlineWidth;
-    int m_lastLineColoured;
 
 protected:
     void InitView(const wxString& theme = "");
     void CenterLineInView(int line);
-    void DoCacheRegexes();
-    BuildLineInfo* DoProcessLine(const wxString& line);
-    void DoProcessOutput(bool compilationEnded, bool isSummaryLine);
-    void DoSearchForDirectory(const wxString& line);
-    bool DoGetCompilerPatterns(const wxString& compilerName, CmpPatterns& patterns);
+    void DoAddOutput(const wxString& output);
+    bool DoAppendParsedLines();
+    void DoAppendLine(const wxString& text);
+    void DoAppendLines(BuildOutputLineVec_t& lines);
     void DoClear();
     void MarkEditor(LEditor* editor);
     void DoToggleWindow();
     bool DoSelectAndOpen(int buildViewLine, bool centerLine);
     wxFont DoGetFont() const;
     void DoCentreErrorLine(BuildLineInfo* bli, LEditor* editor, bool centerLine);
-    void ColourOutput();
-    CmpPatternPtr GetMatchingRegex(const wxString& lineText, LINE_SEVERITY& severity);
 
 public:
     NewBuildTab(wxWindow* parent);
@@ -226,7 +241,7 @@ protected:
     void OnClearUI(wxUpdateUIEvent& e);
     void OnStyleNeeded(wxStyledTextEvent& event);
     void OnHotspotClicked(wxStyledTextEvent& event);
-    void OnIdle(wxIdleEvent& event);
+    void OnRefreshTimer(wxTimerEvent& event);
 };
 
 #endif // NEWBUILDTAB_H
@@ -0,0 +1,181 @@
+#include <wx/init.h>
+#include <wx/tokenzr.h>
+#include "clDTL.h"
+#include "tester.h"
+
+// Format a one pane diff result: one character per line (' ' common, '-' removed, '+' added) followed by the line
+static wxString FormatResult(const clDTL::LineInfoVec_t& result)
+{
+    wxString str;
+    for(size_t i = 0; i < result.size(); ++i) {
+        switch(result.at(i).m_type) {
+        case clDTL::LINE_COMMON:
+            str << " ";
+            break;
+        case clDTL::LINE_REMOVED:
+            str << "-";
+            break;
+        case clDTL::LINE_ADDED:
+            str << "+";
+            break;
+        default:
+            str << "?";
+            break;
+        }
+        str << result.at(i).m_line;
+    }
+    return str;
+}
+
+// Rebuild the left and the right contents from a one pane diff result
+static void ApplyResult(const clDTL::LineInfoVec_t& result, wxString& left, wxString& right)
+{
+    for(size_t i = 0; i < result.size(); ++i) {
+        if(result.at(i).m_type != clDTL::LINE_ADDED) left << result.at(i).m_line;
+        if(result.at(i).m_type != clDTL::LINE_REMOVED) right << result.at(i).m_line;
+    }
+}
+
+static size_t CountChanges(const clDTL::LineInfoVec_t& result)
+{
+    size_t count = 0;
+    for(size_t i = 0; i < result.size(); ++i) {
+        if(result.at(i).m_type != clDTL::LINE_COMMON) ++count;
+    }
+    return count;
+}
+
+TEST_FUNC(test_diff_identical)
+{
+    clDTL d;
+    d.DiffStrings("a\nb\nc\n", "a\nb\nc\n", clDTL::kOnePane);
+    CHECK_SIZE(d.GetResultLeft().size(), 0);
+    CHECK_SIZE(d.GetSequences().size(), 0);
+
+    d.DiffStrings("", "", clDTL::kTwoPanes);
+    CHECK_SIZE(d.GetResultLeft().size(), 0);
+    CHECK_SIZE(d.GetResultRight().size(), 0);
+    return true;
+}
+
+TEST_FUNC(test_diff_empty_side)
+{
+    clDTL d;
+    d.DiffStrings("", "a\nb\n", clDTL::kOnePane);
+    CHECK_WXSTRING(FormatResult(d.GetResultLeft()), "+a\n+b\n");
+    CHECK_SIZE(d.GetSequences().size(), 1);
+
+    d.DiffStrings("a\nb\n", "", clDTL::kOnePane);
+    CHECK_WXSTRING(FormatResult(d.GetResultLeft()), "-a\n-b\n");
+
+    // The two panes view pads the missing side with placeholders
+    d.DiffStrings("", "a\nb\n", clDTL::kTwoPanes);
+    CHECK_SIZE(d.GetResultLeft().size(), 2);
+    CHECK_SIZE(d.GetResultRight().size(), 2);
+    CHECK_BOOL(d.GetResultLeft().at(0).m_type == clDTL::LINE_PLACEHOLDER);
+    CHECK_BOOL(d.GetResultRight().at(1).m_type == clDTL::LINE_ADDED);
+    return true;
+}
+
+TEST_FUNC(test_diff_single_insert)
+{
+    clDTL d;
+    d.DiffStrings("a\nb\nc\n", "a\nb\nx\nc\n", clDTL::kOnePane);
+    CHECK_WXSTRING(FormatResult(d.GetResultLeft()), " a\n b\n+x\n c\n");
+    CHECK_SIZE(d.GetSequences().size(), 1);
+    CHECK_SIZE(d.GetSequences().at(0).first, 2);
+    CHECK_SIZE(d.GetSequences().at(0).second, 3);
+
+    // An inserted line that already exists in the file
+    d.DiffStrings("a\nb\nc\n", "a\nb\nb\nc\n", clDTL::kOnePane);
+    CHECK_SIZE(CountChanges(d.GetResultLeft()), 1);
+    return true;
+}
+
+TEST_FUNC(test_diff_single_delete)
+{
+    clDTL d;
+    d.DiffStrings("a\nb\nc\n", "a\nc\n", clDTL::kOnePane);
+    CHECK_WXSTRING(FormatResult(d.GetResultLeft()), " a\n-b\n c\n");
+
+    d.DiffStrings("a\nb\na\nb\n", "a\nb\nb\n", clDTL::kOnePane);
+    CHECK_SIZE(CountChanges(d.GetResultLeft()), 1);
+    return true;
+}
+
+TEST_FUNC(test_diff_too_expensive)
+{
+    // All the lines exist on both sides, in reverse order: the minimal edit script is far longer than
+    // the cost limit so the split points are approximated. The result must still be a valid edit script
+    wxString left, right;
+    const int count = 3000;
+    for(int i = 0; i < count; ++i) {
+        left << "line " << i << "\n";
+        right << "line " << (count - 1 - i) << "\n";
+    }
+
+    clDTL d;
+    d.DiffStrings(left, right, clDTL::kOnePane);
+    wxString newLeft, newRight;
+    ApplyResult(d.GetResultLeft(), newLeft, newRight);
+    CHECK_BOOL(newLeft == left);
+    CHECK_BOOL(newRight == right);
+    CHECK_BOOL(CountChanges(d.GetResultLeft()) >= (size_t)(2 * (count - 1)));
+
+    // A few changes in a large file are found exactly
+    wxString modified;
+    wxArrayString lines = ::wxStringTokenize(left, "\n", wxTOKEN_STRTOK);
+    for(size_t i = 0; i < lines.size(); ++i) {
+        if(i % 1000 == 500) continue;
+        modified << lines.Item(i) << "\n";
+        if(i % 1000 == 700) modified << "new line " << i << "\n";
+    }
+    d.DiffStrings(left, modified, clDTL::kOnePane);
+    CHECK_SIZE(CountChanges(d.GetResultLeft()), 6);
+    CHECK_SIZE(d.GetSequences().size(), 6);
+    return true;
+}
+
+TEST_FUNC(test_diff_parallel)
+{
+    // More lines than DIFF_PARALLEL_MIN_LINES (20000), all of them on both sides: the halves of the
+    // region are compared in worker threads (when there is more than one CPU)
+    wxString left, right;
+    const int count = 15000;
+    for(int i = 0; i < count; ++i) {
+        left << "line " << i << "\n";
+    }
+
+    // Remove every 100th line and swap the lines of every 250th pair
+    for(int i = 0; i < count; ++i) {
+        if(i % 100 == 0) continue;
+        if(i % 250 == 125) {
+            right << "line " << (i + 1) << "\n"
+                  << "line " << i << "\n";
+            ++i;
+            continue;
+        }
+        right << "line " << i << "\n";
+    }
+
+    clDTL d;
+    d.DiffStrings(left, right, clDTL::kOnePane);
+    wxString newLeft, newRight;
+    ApplyResult(d.GetResultLeft(), newLeft, newRight);
+    CHECK_BOOL(newLeft == left);
+    CHECK_BOOL(newRight == right);
+    // 150 removed lines and 2 changes per swap
+    CHECK_SIZE(CountChanges(d.GetResultLeft()), 150 + 2 * 60);
+
+    d.DiffStrings(left, right, clDTL::kTwoPanes);
+    CHECK_SIZE(d.GetResultLeft().size(), d.GetResultRight().size());
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    wxInitialize(argc, argv);
+    Tester::Instance()->RunTests();
+    wxUninitialize();
+    return 0;
+}
@@ -24,10 +24,357 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "clDTL.h"
-#include "dtl/dtl.hpp"
 #include <wx/ffile.h>
 #include <wx/tokenzr.h>
 #include <wx/utils.h>
+#include <wx/hashmap.h>
+#include <wx/thread.h>
+#include <limits.h>
+
+// Regions with more lines than this are split across threads
+#define DIFF_PARALLEL_MIN_LINES 20000
+
+// Lines are compared by their ID: identical lines share the same ID
+WX_DECLARE_STRING_HASH_MAP(int, clDTLLineIdMap_t);
+
+namespace
+{
+struct DiffOp {
+    int type; // LINE_COMMON, LINE_REMOVED or LINE_ADDED
+    int line; // the line index in the left file (common and removed lines) or in the right file (added lines)
+};
+
+struct DiffPartition {
+    int xmid;
+    int ymid;
+};
+
+class DiffWorkerThread;
+
+/**
+ * @class MyersDiff
+ * @brief the linear space variant of the Myers diff algorithm (the middle snake divide and conquer)
+ * Lines are compared by ID. The changed lines of both sides are marked in 'changedX' and 'changedY'.
+ * When the edit script becomes too expensive, the split point is approximated (as GNU diff does)
+ * and the result may not be minimal. The two halves of large regions are compared in parallel
+ */
+class MyersDiff
+{
+    const int* m_xv;
+    const int* m_yv;
+    int m_xsize;
+    int m_ysize;
+    char* m_changedX;
+    char* m_changedY;
+    std::vector<int> m_fdiag;
+    std::vector<int> m_bdiag;
+    int* m_fd; // indexed by diagonal
+    int* m_bd;
+    int m_tooExpensive;
+    int m_parallelDepth;
+
+protected:
+    void Diag(int xoff, int xlim, int yoff, int ylim, DiffPartition& part);
+
+public:
+    MyersDiff(const MyersDiff& other);
+    MyersDiff(const std::vector<int>& xv,
+              const std::vector<int>& yv,
+              std::vector<char>& changedX,
+              std::vector<char>& changedY);
+    void Compare(int xoff, int xlim, int yoff, int ylim, int depth = 0);
+};
+
+class DiffWorkerThread : public wxThread
+{
+    MyersDiff m_diff;
+    int m_xoff;
+    int m_xlim;
+    int m_yoff;
+    int m_ylim;
+    int m_depth;
+
+public:
+    DiffWorkerThread(const MyersDiff& diff, int xoff, int xlim, int yoff, int ylim, int depth)
+        : wxThread(wxTHREAD_JOINABLE)
+        , m_diff(diff)
+        , m_xoff(xoff)
+        , m_xlim(xlim)
+        , m_yoff(yoff)
+        , m_ylim(ylim)
+        , m_depth(depth)
+    {
+    }
+
+    virtual void* Entry()
+    {
+        m_diff.Compare(m_xoff, m_xlim, m_yoff, m_ylim, m_depth);
+        return NULL;
+    }
+};
+
+MyersDiff::MyersDiff(const std::vector<int>& xv,
+                     const std::vector<int>& yv,
+                     std::vector<char>& changedX,
+                     std::vector<char>& changedY)
+    : m_xv(xv.empty() ? NULL : &xv[0])
+    , m_yv(yv.empty() ? NULL : &yv[0])
+    , m_xsize(xv.size())
+    , m_ysize(yv.size())
+    , m_changedX(changedX.empty() ? NULL : &changedX[0])
+    , m_changedY(changedY.empty() ? NULL : &changedY[0])
+    , m_fdiag(xv.size() + yv.size() + 3)
+    , m_bdiag(xv.size() + yv.size() + 3)
+    , m_fd(&m_fdiag[0] + yv.size() + 1)
+    , m_bd(&m_bdiag[0] + yv.size() + 1)
+    , m_tooExpensive(1)
+    , m_parallelDepth(0)
+{
+    // Give up on the minimal script after roughly sqrt(<number of diagonals>) steps
+    for(size_t diags = m_fdiag.size(); diags; diags >>= 2) {
+        m_tooExpensive <<= 1;
+    }
+    m_tooExpensive = wxMax(256, m_tooExpensive);
+
+    for(int cpus = wxThread::GetCPUCount(); cpus > 1; cpus >>= 1) {
+        ++m_parallelDepth;
+    }
+}
+
+MyersDiff::MyersDiff(const MyersDiff& other)
+    : m_xv(other.m_xv)
+    , m_yv(other.m_yv)
+    , m_xsize(other.m_xsize)
+    , m_ysize(other.m_ysize)
+    , m_changedX(other.m_changedX)
+    , m_changedY(other.m_changedY)
+    , m_fdiag(other.m_fdiag.size())
+    , m_bdiag(other.m_bdiag.size())
+    , m_fd(&m_fdiag[0] + other.m_ysize + 1)
+    , m_bd(&m_bdiag[0] + other.m_ysize + 1)
+    , m_tooExpensive(other.m_tooExpensive)
+    , m_parallelDepth(other.m_parallelDepth)
+{
+}
+
+void MyersDiff::Diag(int xoff, int xlim, int yoff, int ylim, DiffPartition& part)
+{
+    const int dmin = xoff - ylim;
+    const int dmax = xlim - yoff;
+    const int fmid = xoff - yoff;
+    const int bmid = xlim - ylim;
+    const bool odd = (fmid - bmid) & 1;
+    int fmin = fmid, fmax = fmid;
+    int bmin = bmid, bmax = bmid;
+
+    m_fd[fmid] = xoff;
+    m_bd[bmid] = xlim;
+
+    for(int c = 1;; ++c) {
+        // Extend the forward paths by one edit
+        if(fmin > dmin) {
+            m_fd[--fmin - 1] = -1;
+        } else {
+            ++fmin;
+        }
+        if(fmax < dmax) {
+            m_fd[++fmax + 1] = -1;
+        } else {
+            --fmax;
+        }
+        for(int d = fmax; d >= fmin; d -= 2) {
+            int tlo = m_fd[d - 1];
+            int thi = m_fd[d + 1];
+            int x = (tlo >= thi) ? (tlo + 1) : thi;
+            int y = x - d;
+            while(x < xlim && y < ylim && m_xv[x] == m_yv[y]) {
+                ++x;
+                ++y;
+            }
+            m_fd[d] = x;
+            if(odd && bmin <= d && d <= bmax && m_bd[d] <= x) {
+                part.xmid = x;
+                part.ymid = y;
+                return;
+            }
+        }
+
+        // Extend the backward paths by one edit
+        if(bmin > dmin) {
+            m_bd[--bmin - 1] = INT_MAX;
+        } else {
+            ++bmin;
+        }
+        if(bmax < dmax) {
+            m_bd[++bmax + 1] = INT_MAX;
+        } else {
+            --bmax;
+        }
+        for(int d = bmax; d >= bmin; d -= 2) {
+            int tlo = m_bd[d - 1];
+            int thi = m_bd[d + 1];
+            int x = (tlo < thi) ? tlo : (thi - 1);
+            int y = x - d;
+            while(x > xoff && y > yoff && m_xv[x - 1] == m_yv[y - 1]) {
+                --x;
+                --y;
+            }
+            m_bd[d] = x;
+            if(!odd && fmin <= d && d <= fmax && x <= m_fd[d]) {
+                part.xmid = x;
+                part.ymid = y;
+                return;
+            }
+        }
+
+        if(c < m_tooExpensive) continue;
+
+        // Too expensive: split at the furthest reaching forward or backward path
+        int fxybest = -1, fxbest = xoff;
+        for(int d = fmax; d >= fmin; d -= 2) {
+            int x = wxMin(m_fd[d], xlim);
+            int y = x - d;
+            if(ylim < y) {
+                x = ylim + d;
+                y = ylim;
+            }
+            if(fxybest < x + y) {
+                fxybest = x + y;
+                fxbest = x;
+            }
+        }
+
+        int bxybest = INT_MAX, bxbest = xlim;
+        for(int d = bmax; d >= bmin; d -= 2) {
+            int x = wxMax(xoff, m_bd[d]);
+            int y = x - d;
+            if(y < yoff) {
+                x = yoff + d;
+                y = yoff;
+            }
+            if(x + y < bxybest) {
+                bxybest = x + y;
+                bxbest = x;
+            }
+        }
+
+        if((xlim + ylim) - bxybest < fxybest - (xoff + yoff)) {
+            part.xmid = fxbest;
+            part.ymid = fxybest - fxbest;
+        } else {
+            part.xmid = bxbest;
+            part.ymid = bxybest - bxbest;
+        }
+        return;
+    }
+}
+
+void MyersDiff::Compare(int xoff, int xlim, int yoff, int ylim, int depth)
+{
+    // Skip the common prefix and suffix
+    while(xoff < xlim && yoff < ylim && m_xv[xoff] == m_yv[yoff]) {
+        ++xoff;
+        ++yoff;
+    }
+    while(xlim > xoff && ylim > yoff && m_xv[xlim - 1] == m_yv[ylim - 1]) {
+        --xlim;
+        --ylim;
+    }
+
+    if(xoff == xlim) {
+        while(yoff < ylim) {
+            m_changedY[yoff++] = 1;
+        }
+
+    } else if(yoff == ylim) {
+        while(xoff < xlim) {
+            m_changedX[xoff++] = 1;
+        }
+
+    } else {
+        DiffPartition part;
+        Diag(xoff, xlim, yoff, ylim, part);
+
+        // The two halves are independent: compare the first one in a worker thread
+        DiffWorkerThread* worker = NULL;
+        if(depth < m_parallelDepth && ((xlim - xoff) + (ylim - yoff)) > DIFF_PARALLEL_MIN_LINES) {
+            worker = new DiffWorkerThread(*this, xoff, part.xmid, yoff, part.ymid, depth + 1);
+            if(worker->Create() != wxTHREAD_NO_ERROR || worker->Run() != wxTHREAD_NO_ERROR) {
+                wxDELETE(worker);
+            }
+        }
+
+        if(!worker) {
+            Compare(xoff, part.xmid, yoff, part.ymid, depth + 1);
+        }
+        Compare(part.xmid, xlim, part.ymid, ylim, depth + 1);
+
+        if(worker) {
+            worker->Wait();
+            wxDELETE(worker);
+        }
+    }
+}
+
+/**
+ * @brief mark the changed lines of both sides
+ * Lines that do not appear on the other side are always changed: only the other lines are compared
+ */
+void DiffLines(const std::vector<int>& leftIds,
+               const std::vector<int>& rightIds,
+               size_t idsCount,
+               std::vector<char>& leftChanged,
+               std::vector<char>& rightChanged)
+{
+    std::vector<char> inLeft(idsCount, 0), inRight(idsCount, 0);
+    for(size_t i = 0; i < leftIds.size(); ++i) {
+        inLeft[leftIds[i]] = 1;
+    }
+    for(size_t i = 0; i < rightIds.size(); ++i) {
+        inRight[rightIds[i]] = 1;
+    }
+
+    std::vector<int> leftKept, rightKept; // indices of the compared lines
+    std::vector<int> leftKeptIds, rightKeptIds;
+    for(size_t i = 0; i < leftIds.size(); ++i) {
+        if(inRight[leftIds[i]]) {
+            leftKept.push_back(i);
+            leftKeptIds.push_back(leftIds[i]);
+        } else {
+            leftChanged[i] = 1;
+        }
+    }
+    for(size_t i = 0; i < rightIds.size(); ++i) {
+        if(inLeft[rightIds[i]]) {
+            rightKept.push_back(i);
+            rightKeptIds.push_back(rightIds[i]);
+        } else {
+            rightChanged[i] = 1;
+        }
+    }
+
+    std::vector<char> leftKeptChanged(leftKept.size(), 0), rightKeptChanged(rightKept.size(), 0);
+    {
+        MyersDiff diff(leftKeptIds, rightKeptIds, leftKeptChanged, rightKeptChanged);
+        diff.Compare(0, leftKeptIds.size(), 0, rightKeptIds.size());
+    }
+    for(size_t i = 0; i < leftKept.size(); ++i) {
+        leftChanged[leftKept[i]] = leftKeptChanged[i];
+    }
+    for(size_t i = 0; i < rightKept.size(); ++i) {
+        rightChanged[rightKept[i]] = rightKeptChanged[i];
+    }
+}
+
+void LinesToIds(const wxArrayString& lines, clDTLLineIdMap_t& ids, std::vector<int>& lineIds)
+{
+    lineIds.reserve(lines.GetCount());
+    for(size_t i = 0; i < lines.GetCount(); ++i) {
+        clDTLLineIdMap_t::Insert_Result res = ids.insert(clDTLLineIdMap_t::value_type(lines.Item(i), ids.size()));
+        lineIds.push_back(res.first->second);
+    }
+}
+}
 
 clDTL::clDTL()
 {
@@ -53,26 +400,58 @@ void clDTL::Diff(const wxFileName& fnLeft, const wxFileName& fnRight, DiffMode m
         fp2.ReadAll(&rightFile);
     }
 
+    DiffStrings(leftFile, rightFile, mode);
+}
+
+void clDTL::DiffStrings(const wxString& leftContent, const wxString& rightContent, DiffMode mode)
+{
     m_resultLeft.clear();
     m_resultRight.clear();
     m_sequences.clear();
 
-    typedef wxString elem;
-    typedef std::pair<elem, dtl::elemInfo> sesElem;
-
-    wxArrayString leftLines = wxStringTokenize(leftFile, "\n", wxTOKEN_RET_DELIMS);
-    wxArrayString rightLines = wxStringTokenize(rightFile, "\n", wxTOKEN_RET_DELIMS);
+    wxArrayString leftLines = wxStringTokenize(leftContent, "\n", wxTOKEN_RET_DELIMS);
+    wxArrayString rightLines = wxStringTokenize(rightContent, "\n", wxTOKEN_RET_DELIMS);
 
-    std::vector<elem> leftLinesVec;
-    std::vector<elem> rightLinesVec;
-    leftLinesVec.insert(leftLinesVec.end(), leftLines.begin(), leftLines.end());
-    rightLinesVec.insert(rightLinesVec.end(), rightLines.begin(), rightLines.end());
+    // Compare the lines by their IDs
+    std::vector<int> leftIds, rightIds;
+    size_t idsCount = 0;
+    {
+        clDTLLineIdMap_t ids;
+        LinesToIds(leftLines, ids, leftIds);
+        LinesToIds(rightLines, ids, rightIds);
+        idsCount = ids.size();
+    }
 
-    dtl::Diff<elem, std::vector<elem> > diff(leftLinesVec, rightLinesVec);
-    diff.onHuge();
-    diff.compose();
+    std::vector<char> leftChanged(leftIds.size(), 0);
+    std::vector<char> rightChanged(rightIds.size(), 0);
+    DiffLines(leftIds, rightIds, idsCount, leftChanged, rightChanged);
+
+    // Build the edit script: in every changed region, the removed lines come before the added ones
+    std::vector<DiffOp> seq;
+    seq.reserve(wxMax(leftIds.size(), rightIds.size()));
+    size_t leftLine = 0, rightLine = 0;
+    bool identical = true;
+    while ( leftLine < leftIds.size() || rightLine < rightIds.size() ) {
+        if ( leftLine < leftIds.size() && rightLine < rightIds.size() &&
+             !leftChanged[leftLine] && !rightChanged[rightLine] ) {
+            DiffOp op = { LINE_COMMON, (int)leftLine };
+            seq.push_back( op );
+            ++leftLine;
+            ++rightLine;
+            continue;
+        }
+        identical = false;
+        while ( leftLine < leftIds.size() && leftChanged[leftLine] ) {
+            DiffOp op = { LINE_REMOVED, (int)leftLine++ };
+            seq.push_back( op );
+        }
+        while ( rightLine < rightIds.size() && rightChanged[rightLine] ) {
+            DiffOp op = { LINE_ADDED, (int)rightLine++ };
+            seq.push_back( op );
+        }
+    }
 
-    if ( 0 == diff.getEditDistance() ) {
+    if ( identical ) {
         // nothing to be done - files are identical
         return;
     }
@@ -86,7 +465,6 @@ void clDTL::Diff(const wxFileName& fnLeft, const wxFileName& fnRight, DiffMode m
         ///////////////////////////////////////////////////////////////////
 
         // Loop over the diff and check if it is a whitespace only diff
-        std::vector<sesElem> seq = diff.getSes().getSequence();
         m_resultLeft.reserve( seq.size() );
         m_resultRight.reserve( seq.size() );
 
@@ -101,8 +479,8 @@ void clDTL::Diff(const wxFileName& fnLeft, const wxFileName& fnRight, DiffMode m
         LineInfoVec_t tmpSeqRight;
 
         for(size_t i=0; i<seq.size(); ++i) {
-            switch(seq.at(i).second.type) {
-            case dtl::SES_COMMON: {
+            switch(seq.at(i).type) {
+            case LINE_COMMON: {
                 if ( state == STATE_IN_SEQ ) {
 
                     // set the sequence size
@@ -123,14 +501,14 @@ void clDTL::Diff(const wxFileName& fnLeft, const wxFileName& fnRight, DiffMode m
                     tmpSeqRight.clear();
                     seqSize = 0;
                 }
-                clDTL::LineInfo line(seq.at(i).first, LINE_COMMON);
+                clDTL::LineInfo line(leftLines.Item(seq.at(i).line), LINE_COMMON);
                 m_resultLeft.push_back( line );
                 m_resultRight.push_back( line );
                 break;
 
             }
-            case dtl::SES_ADD: {
-                clDTL::LineInfo lineRight(seq.at(i).first, LINE_ADDED);
+            case LINE_ADDED: {
+                clDTL::LineInfo lineRight(rightLines.Item(seq.at(i).line), LINE_ADDED);
                 tmpSeqRight.push_back( lineRight );
 
                 if ( state == STATE_NONE ) {
@@ -140,8 +518,8 @@ void clDTL::Diff(const wxFileName& fnLeft, const wxFileName& fnRight, DiffMode m
                 break;
 
             }
-            case dtl::SES_DELETE: {
-                clDTL::LineInfo lineLeft(seq.at(i).first, LINE_REMOVED);
+            case LINE_REMOVED: {
+                clDTL::LineInfo lineLeft(leftLines.Item(seq.at(i).line), LINE_REMOVED);
                 tmpSeqLeft.push_back( lineLeft );
 
                 if ( state == STATE_NONE ) {
@@ -178,34 +556,33 @@ void clDTL::Diff(const wxFileName& fnLeft, const wxFileName& fnRight, DiffMode m
         // One pane diff view
         // designed for displayed on a single editor
         ///////////////////////////////////////////////////////////////////
-        std::vector<sesElem> seq = diff.getSes().getSequence();
         m_resultLeft.reserve( seq.size() );
         int seqStartLine = wxNOT_FOUND;
         for(size_t i=0; i<seq.size(); ++i) {
-            switch(seq.at(i).second.type) {
-            case dtl::SES_COMMON: {
+            switch(seq.at(i).type) {
+            case LINE_COMMON: {
                 if ( seqStartLine != wxNOT_FOUND ) {
                     m_sequences.push_back( std::make_pair(seqStartLine, m_resultLeft.size()) );
                     seqStartLine = wxNOT_FOUND;
                 }
-                clDTL::LineInfo line(seq.at(i).first, LINE_COMMON);
+                clDTL::LineInfo line(leftLines.Item(seq.at(i).line), LINE_COMMON);
                 m_resultLeft.push_back( line );
                 break;
             }
-            case dtl::SES_ADD: {
+            case LINE_ADDED: {
                 if ( seqStartLine == wxNOT_FOUND ) {
                     seqStartLine = m_resultLeft.size();
                 }
-                clDTL::LineInfo line(seq.at(i).first, LINE_ADDED);
+                clDTL::LineInfo line(rightLines.Item(seq.at(i).line), LINE_ADDED);
                 m_resultLeft.push_back( line );
                 break;
 
             }
-            case dtl::SES_DELETE: {
+            case LINE_REMOVED: {
                 if ( seqStartLine == wxNOT_FOUND ) {
                     seqStartLine = m_resultLeft.size();
                 }
-                clDTL::LineInfo line(seq.at(i).first, LINE_REMOVED);
+                clDTL::LineInfo line(leftLines.Item(seq.at(i).line), LINE_REMOVED);
                 m_resultLeft.push_back( line );
                 break;
             }
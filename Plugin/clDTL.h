@@ -99,6 +99,11 @@ public:
      */
     void Diff(const wxFileName& fnLeft, const wxFileName& fnRight, DiffMode mode);
 
+    /**
+     * @brief same as Diff(), with the content of the two files
+     */
+    void DiffStrings(const wxString& leftContent, const wxString& rightContent, DiffMode mode);
+
     const LineInfoVec_t& GetResultLeft() const {
         return m_resultLeft;
     }
@@ -318,8 +318,8 @@ FileNameVector_t CompilationDatabase::GetCompileCommandsFiles() const
 
 void CompilationDatabase::ProcessCMakeCompilationDatabase(const wxFileName& compile_commands)
 {
-    JSONRoot root(compile_commands);
-    JSONElement arr = root.toElement();
+    // compile_commands.json can be huge, read it one entry at a time
+    JSONArrayReader reader(compile_commands);
 
     try {
 
@@ -328,10 +328,9 @@ void CompilationDatabase::ProcessCMakeCompilationDatabase(const wxFileName& comp
         wxSQLite3Statement st = m_db->PrepareStatement(sql);
         m_db->ExecuteUpdate("BEGIN");
 
-        for(int i = 0; i < arr.arraySize(); ++i) {
+        for(JSONElement element = reader.next(); element.isOk(); element = reader.next()) {
             // Each object has 3 properties:
             // directory, command, file
-            JSONElement element = arr.arrayItem(i);
             if(element.hasNamedObject("file") && element.hasNamedObject("directory") &&
                element.hasNamedObject("command")) {
                 wxString cmd = element.namedObject("command").toString();
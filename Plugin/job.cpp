@@ -23,6 +23,7 @@
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
  #include "job.h"
+#include "clRequestQueue.h"
 
 const wxEventType wxEVT_CMD_JOB_STATUS = wxNewEventType();
 const wxEventType wxEVT_CMD_JOB_STATUS_VOID_PTR = wxNewEventType();
@@ -54,3 +55,8 @@ void Job::Post(void* ptr)
 		m_parent->AddPendingEvent(e);
 	}
 }
+
+int Job::GetPriority() const
+{
+	return kRequestPriorityNormal;
+}
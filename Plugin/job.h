@@ -74,5 +74,18 @@ public:
 	 * @param thread the thread that is currently running the job. 
 	 */
 	virtual void Process(wxThread *thread) = 0;
+
+	/**
+	 * @brief jobs with a higher priority are processed first (see eRequestPriority in clRequestQueue.h)
+	 */
+	virtual int GetPriority() const;
+
+	/**
+	 * @brief a queued job is replaced by a newer job with the same key.
+	 * An empty key (the default) means that the job is never replaced
+	 */
+	virtual wxString GetCoalescingKey() const {
+		return wxEmptyString;
+	}
 };
 #endif // __job__
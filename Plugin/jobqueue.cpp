@@ -25,7 +25,7 @@
 #include "jobqueue.h"
 #include "job.h"
 
-JobQueueWorker::JobQueueWorker(wxMessageQueue<Job*>* queue)
+JobQueueWorker::JobQueueWorker(clRequestQueue<Job>* queue)
     : wxThread(wxTHREAD_JOINABLE)
     , m_queue( queue )
 {
@@ -55,17 +55,15 @@ void JobQueueWorker::Start(int priority)
 void* JobQueueWorker::Entry()
 {
     while ( !TestDestroy() ) {
-        Job *job (NULL);
-        if ( (m_queue->ReceiveTimeout(50, job) == wxMSGQUEUE_NO_ERROR) && job ) {
-
-            // Call user's implementation for processing request
-            ProcessJob( job );
-
-            wxThread::Sleep(10);  // Allow other threads to work as well
-            delete job;
-            job = NULL;
-            continue; // to avoid the sleep
+        // Sleep until a job arrives, NULL means that the queue is stopped
+        Job *job = m_queue->Receive();
+        if ( !job ) {
+            break;
         }
+
+        // Call user's implementation for processing request
+        ProcessJob( job );
+        delete job;
     }
     return NULL;
 }
@@ -88,19 +86,17 @@ JobQueue::JobQueue()
 JobQueue::~JobQueue()
 {
     // Clear the queue and release it memory
-    Job* pJob(NULL);
-    while ( m_queue.ReceiveTimeout(1, pJob) == wxMSGQUEUE_NO_ERROR ) {
-        wxDELETE( pJob );
-    }
+    m_queue.Clear();
 }
 
 void JobQueue::PushJob(Job *job)
 {
-    m_queue.Post( job );
+    m_queue.Post( job, job->GetPriority(), job->GetCoalescingKey() );
 }
 
 void JobQueue::Start(size_t poolSize, int priority)
 {
+    m_queue.Reset();
     size_t maxPoolSize = poolSize > 250 ? 250 : poolSize;
     for(size_t i=0; i<maxPoolSize; i++) {
         //create new thread
@@ -112,6 +108,9 @@ void JobQueue::Start(size_t poolSize, int priority)
 
 void JobQueue::Stop()
 {
+    // wake up the idle workers
+    m_queue.Shutdown();
+
     //first loop and stop all running threads
     for(size_t i=0; i<m_threads.size(); i++) {
         JobQueueWorker *worker = m_threads.at(i);
@@ -29,7 +29,7 @@
 #include <deque>
 #include <vector>
 #include "codelite_exports.h"
-#include <wx/msgqueue.h>
+#include "clRequestQueue.h"
 
 class Job;
 
@@ -43,11 +43,11 @@ class Job;
  */
 class WXDLLIMPEXP_SDK JobQueueWorker : public wxThread
 {
-    wxMessageQueue<Job*>* m_queue;
+    clRequestQueue<Job>* m_queue;
 
 public:
     /// default ctor/dtor
-    JobQueueWorker(wxMessageQueue<Job*>* queue);
+    JobQueueWorker(clRequestQueue<Job>* queue);
     virtual ~JobQueueWorker();
 
 private:
@@ -108,7 +108,7 @@ public:
  */
 class JobQueue
 {
-    wxMessageQueue<Job*>         m_queue;
+    clRequestQueue<Job>          m_queue;
     std::vector<JobQueueWorker*> m_threads;
 
 public:
@@ -118,6 +118,7 @@ public:
     /**
      * @brief add job to the queue. all jobs must be constructed on the heap.
      * note that the job will be freed when processing is done by the job queue
+     * (or when it is replaced by a newer job with the same Job::GetCoalescingKey())
      * @param job job to process allocated on the heap
      */
     virtual void PushJob(Job *job);
@@ -130,7 +131,7 @@ public:
     virtual void Start(size_t poolSize = 1, int priority = WXTHREAD_DEFAULT_PRIORITY);
 
     /**
-     * @brief stop all workers threads
+     * @brief stop all workers threads. Jobs that were not processed yet are deleted
      */
     virtual void Stop();
 };
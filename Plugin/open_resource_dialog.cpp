@@ -98,10 +98,12 @@ OpenResourceDialog::OpenResourceDialog(wxWindow* parent, IManager* manager, cons
                 p->GetFiles(fileNames, true);
 
                 // convert std::vector to wxArrayString
+                wxArrayString files;
+                files.Alloc(fileNames.size());
                 for(std::vector<wxFileName>::iterator it = fileNames.begin(); it != fileNames.end(); it++) {
-                    wxString name = it->GetFullName().MakeLower();
-                    m_files.insert(std::make_pair(name, it->GetFullPath()));
+                    files.Add(it->GetFullPath());
                 }
+                m_fileIndex.AddFiles(files);
             }
         }
     }
@@ -252,14 +254,23 @@ void OpenResourceDialog::DoPopulateWorkspaceFile()
 
     if(!m_userFilters.IsEmpty()) {
 
-        std::multimap<wxString, wxString>::iterator iter = m_files.begin();
-        const int maxFileSize = 100;
-        int counter = 0;
-        for(; (iter != m_files.end()) && (counter < maxFileSize); iter++) {
+        // The best matches of the first filter come first, the other filters must be contained in the path
+        const size_t maxFileSize = 100;
+        wxArrayString files;
+        m_fileIndex.Find(m_userFilters.Item(0), clFileNameIndex::kFindFuzzy,
+                         (m_userFilters.GetCount() == 1) ? maxFileSize : 0, files);
 
-            if(!MatchesFilter(iter->second)) continue;
+        size_t counter = 0;
+        for(size_t i = 0; (i < files.GetCount()) && (counter < maxFileSize); ++i) {
 
-            wxFileName fn(iter->second);
+            wxString lcPath = files.Item(i).Lower();
+            bool matches = true;
+            for(size_t j = 1; j < m_userFilters.GetCount() && matches; ++j) {
+                matches = lcPath.Contains(m_userFilters.Item(j));
+            }
+            if(!matches) continue;
+
+            wxFileName fn(files.Item(i));
             FileExtManager::FileType type = FileExtManager::GetType(fn.GetFullName());
             wxBitmap imgId = m_tagImgMap[wxT("text")];
             switch(type) {
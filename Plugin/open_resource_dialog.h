@@ -32,6 +32,7 @@
 #include <wx/arrstr.h>
 #include <wx/timer.h>
 #include "codelite_exports.h"
+#include "clFileNameIndex.h"
 
 class IManager;
 class wxTimer;
@@ -80,7 +81,7 @@ public:
 class WXDLLIMPEXP_SDK OpenResourceDialog : public OpenResourceDialogBase
 {
     IManager* m_manager;
-    std::multimap<wxString, wxString> m_files;
+    clFileNameIndex m_fileIndex;
     wxTimer* m_timer;
     bool m_needRefresh;
     std::map<wxString, wxBitmap> m_tagImgMap;
@@ -56,6 +56,25 @@ static wxStringMap_t s_backticks;
 
 #define EXCLUDE_FROM_BUILD_FOR_CONFIG "ExcludeProjConfig"
 
+// "a::b:" and "a:b" are the same virtual folder
+static wxString NormalizeVirtualFolderPath(const wxString& vdPath)
+{
+    return ::wxJoin(::wxStringTokenize(vdPath, ":", wxTOKEN_STRTOK), ':', '\0');
+}
+
+// Split a path relative to the project into its directory (with the trailing separator) and file name
+static void SplitRelpath(const wxString& relpath, wxString& dir, wxString& name)
+{
+    size_t where = relpath.find_last_of(wxFileName::GetPathSeparators());
+    if(where == wxString::npos) {
+        dir.clear();
+        name = relpath;
+    } else {
+        dir = relpath.Mid(0, where + 1);
+        name = relpath.Mid(where + 1);
+    }
+}
+
 // ============---------------------
 // Project class
 // ============---------------------
@@ -78,6 +97,7 @@ Project::~Project()
 bool Project::Create(const wxString& name, const wxString& description, const wxString& path, const wxString& projType)
 {
     m_vdCache.clear();
+    DoInvalidateFilesModel();
 
     m_fileName = wxFileName(path, name);
     m_fileName.SetExt("project");
@@ -87,28 +107,33 @@ bool Project::Create(const wxString& name, const wxString& description, const wx
     m_fileName.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
     m_projectPath = m_fileName.GetPath();
 
-    wxXmlNode* root = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("CodeLite_Project"));
-    m_doc.SetRoot(root);
-    m_doc.GetRoot()->AddProperty(wxT("Name"), name);
+    {
+        // The document is read by the files model (see GetFilesModel)
+        wxCriticalSectionLocker locker(m_filesModelLock);
+        wxXmlNode* root = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("CodeLite_Project"));
+        m_doc.SetRoot(root);
+        m_doc.GetRoot()->AddProperty(wxT("Name"), name);
 
-    wxXmlNode* descNode = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("Description"));
-    XmlUtils::SetNodeContent(descNode, description);
-    m_doc.GetRoot()->AddChild(descNode);
+        wxXmlNode* descNode = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("Description"));
+        XmlUtils::SetNodeContent(descNode, description);
+        m_doc.GetRoot()->AddChild(descNode);
 
-    // Create the default virtual directories
-    wxXmlNode *srcNode = NULL, *headNode = NULL;
+        // Create the default virtual directories
+        wxXmlNode *srcNode = NULL, *headNode = NULL;
 
-    srcNode = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("VirtualDirectory"));
-    srcNode->AddProperty(wxT("Name"), wxT("src"));
-    m_doc.GetRoot()->AddChild(srcNode);
+        srcNode = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("VirtualDirectory"));
+        srcNode->AddProperty(wxT("Name"), wxT("src"));
+        m_doc.GetRoot()->AddChild(srcNode);
 
-    headNode = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("VirtualDirectory"));
-    headNode->AddProperty(wxT("Name"), wxT("include"));
-    m_doc.GetRoot()->AddChild(headNode);
+        headNode = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("VirtualDirectory"));
+        headNode->AddProperty(wxT("Name"), wxT("include"));
+        m_doc.GetRoot()->AddChild(headNode);
 
-    // creae dependencies node
-    wxXmlNode* depNode = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("Dependencies"));
-    root->AddChild(depNode);
+        // creae dependencies node
+        wxXmlNode* depNode = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("Dependencies"));
+        root->AddChild(depNode);
+        DoInvalidateFilesModel();
+    }
 
     // this will also create settings
     SaveXmlFile();
@@ -122,7 +147,10 @@ bool Project::Create(const wxString& name, const wxString& description, const wx
 
 bool Project::Load(const wxString& path)
 {
+    // The document is read by the files model (see GetFilesModel)
+    wxCriticalSectionLocker locker(m_filesModelLock);
     if(!m_doc.Load(path)) {
+        DoInvalidateFilesModel();
         return false;
     }
 
@@ -140,6 +168,10 @@ bool Project::Load(const wxString& path)
     m_fileName.MakeAbsolute();
     m_projectPath = m_fileName.GetPath();
 
+    // Read the files once, they are queried from the model from now on
+    m_filesModel = FilesModel();
+    GetFilesModel();
+
     SetModified(true);
     SetProjectLastModifiedTime(GetFileLastModifiedTime());
 
@@ -185,6 +217,7 @@ wxXmlNode* Project::CreateVD(const wxString& vdFullPath, bool mkpath)
 
     wxStringTokenizer tkz(vdFullPath, wxT(":"));
 
+    wxCriticalSectionLocker locker(m_filesModelLock);
     wxXmlNode* parent = m_doc.GetRoot();
     size_t count = tkz.CountTokens();
     for(size_t i = 0; i < count - 1; i++) {
@@ -231,15 +264,8 @@ bool Project::IsFileExist(const wxString& fileName)
     wxFileName tmp(fileName);
     tmp.MakeRelativeTo(m_fileName.GetPath());
 
-    std::vector<wxFileName> files;
-    GetFiles(files);
-
-    for(size_t i = 0; i < files.size(); i++) {
-        if(files.at(i).GetFullPath().Cmp(tmp.GetFullPath(wxPATH_UNIX)) == 0) {
-            return true;
-        }
-    }
-    return false;
+    wxCriticalSectionLocker locker(m_filesModelLock);
+    return DoFindFileRecord(tmp.GetFullPath(wxPATH_UNIX), wxEmptyString, true) != NULL;
 }
 
 bool Project::AddFile(const wxString& fileName, const wxString& virtualDirPath)
@@ -262,9 +288,16 @@ bool Project::AddFile(const wxString& fileName, const wxString& virtualDirPath)
         return false;
     }
 
-    wxXmlNode* node = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("File"));
-    node->AddProperty(wxT("Name"), tmp.GetFullPath(wxPATH_UNIX));
-    vd->AddChild(node);
+    {
+        wxCriticalSectionLocker locker(m_filesModelLock);
+        wxXmlNode* node = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("File"));
+        node->AddProperty(wxT("Name"), tmp.GetFullPath(wxPATH_UNIX));
+        vd->AddChild(node);
+        if(m_filesModel.valid) {
+            DoAddFileToModel(
+                tmp.GetFullPath(wxPATH_UNIX), NormalizeVirtualFolderPath(virtualDirPath), 0, wxEmptyString, true);
+        }
+    }
     if(!InTransaction()) {
         SaveXmlFile();
     }
@@ -278,15 +311,18 @@ bool Project::DeleteVirtualDir(const wxString& vdFullPath)
 {
     wxXmlNode* vd = GetVirtualDir(vdFullPath);
     if(vd) {
-        wxXmlNode* parent = vd->GetParent();
-        if(parent) {
-            parent->RemoveChild(vd);
+        {
+            wxCriticalSectionLocker locker(m_filesModelLock);
+            wxXmlNode* parent = vd->GetParent();
+            if(parent) {
+                parent->RemoveChild(vd);
+            }
+            DoInvalidateFilesModel();
+            delete vd;
         }
 
         // remove the entry from the cache
         DoDeleteVDFromCache(vdFullPath);
-
-        delete vd;
         SetModified(true);
         return SaveXmlFile();
     }
@@ -305,8 +341,10 @@ bool Project::RemoveFile(const wxString& fileName, const wxString& virtualDir)
 
     wxXmlNode* node = XmlUtils::FindNodeByName(vd, wxT("File"), tmp.GetFullPath(wxPATH_UNIX));
     if(node) {
+        wxCriticalSectionLocker locker(m_filesModelLock);
         node->GetParent()->RemoveChild(node);
         delete node;
+        DoInvalidateFilesModel();
 
     } else {
         wxLogMessage(wxT("Failed to remove file %s from project"), tmp.GetFullPath(wxPATH_UNIX).c_str());
@@ -418,16 +456,14 @@ void Project::Save()
 
 void Project::GetFilesByVirtualDir(const wxString& vdFullPath, wxArrayString& files)
 {
-    wxXmlNode* vd = GetVirtualDir(vdFullPath);
-    if(vd) {
-        wxXmlNode* child = vd->GetChildren();
-        while(child) {
-            if(child->GetName() == wxT("File")) {
-                wxFileName fileName(child->GetPropVal(wxT("Name"), wxEmptyString));
-                fileName.MakeAbsolute(m_fileName.GetPath());
-                files.Add(fileName.GetFullPath());
-            }
-            child = child->GetNext();
+    wxCriticalSectionLocker locker(m_filesModelLock);
+    const FilesModel& model = GetFilesModel();
+    std::map<wxString, wxUint32>::const_iterator iter = model.folderIds.find(NormalizeVirtualFolderPath(vdFullPath));
+    if(iter == model.folderIds.end()) return;
+
+    for(size_t i = 0; i < model.files.size(); ++i) {
+        if(model.files[i].folder == iter->second) {
+            files.Add(model.GetFullpath(model.files[i]));
         }
     }
 }
@@ -447,48 +483,163 @@ wxString Project::GetFiles(bool absPath)
 
 void Project::GetFiles(wxStringSet_t& files)
 {
-    DirSaver ds;
-    FileNameVector_t v;
-    ::wxSetWorkingDirectory(m_fileName.GetPath());
-    GetFiles(m_doc.GetRoot(), v, true);
-    for(size_t i = 0; i < v.size(); i++) {
-        files.insert(v.at(i).GetFullPath());
+    wxCriticalSectionLocker locker(m_filesModelLock);
+    const FilesModel& model = GetFilesModel();
+    for(size_t i = 0; i < model.files.size(); i++) {
+        files.insert(model.GetFullpath(model.files[i]));
     }
 }
 
 void Project::GetFiles(std::vector<wxFileName>& files, bool absPath)
 {
-    if(absPath) {
-        GetFiles(m_doc.GetRoot(), files, true);
-
-    } else {
-        GetFiles(m_doc.GetRoot(), files, false);
+    wxCriticalSectionLocker locker(m_filesModelLock);
+    const FilesModel& model = GetFilesModel();
+    files.reserve(files.size() + model.files.size());
+    for(size_t i = 0; i < model.files.size(); i++) {
+        const FileRecord& record = model.files[i];
+        files.push_back(wxFileName(absPath ? model.GetFullpath(record) : model.GetRelpath(record)));
     }
 }
 
-void Project::GetFiles(wxXmlNode* parent, std::vector<wxFileName>& files, bool absPath)
+// The records are sorted by directory ID and then by file name
+static bool IsFileRecordBefore(wxUint32 dirA, const wxString& nameA, wxUint32 dirB, const wxString& nameB)
 {
-    if(!parent) {
-        return;
+    return (dirA != dirB) ? (dirA < dirB) : (nameA < nameB);
+}
+
+const Project::FilesModel& Project::GetFilesModel() const
+{
+    // The caller holds m_filesModelLock
+    if(!m_filesModel.valid) {
+        m_filesModel = FilesModel();
+        if(m_doc.IsOk() && m_doc.GetRoot()) {
+            DoBuildFilesModel(m_doc.GetRoot(), wxEmptyString);
+        }
+
+        // Index the files by relative path (files with the same path remain in document order)
+        const std::vector<FileRecord>& records = m_filesModel.files;
+        std::vector<wxUint32>& sorted = m_filesModel.sortedByRelpath;
+        sorted.resize(records.size());
+        for(size_t i = 0; i < sorted.size(); ++i) {
+            sorted[i] = i;
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), [&](wxUint32 a, wxUint32 b) {
+            return IsFileRecordBefore(records[a].dir, records[a].name, records[b].dir, records[b].name);
+        });
+        m_filesModel.valid = true;
     }
+    return m_filesModel;
+}
 
+void Project::DoInvalidateFilesModel()
+{
+    wxCriticalSectionLocker locker(m_filesModelLock);
+    m_filesModel = FilesModel();
+}
+
+void Project::DoBuildFilesModel(wxXmlNode* parent, const wxString& vdPath) const
+{
     wxXmlNode* child = parent->GetChildren();
     while(child) {
         if(child->GetName() == wxT("File")) {
-            wxString fileName = child->GetPropVal(wxT("Name"), wxEmptyString);
-            wxFileName tmp(fileName);
-            if(absPath) {
-                tmp.MakeAbsolute(GetProjectPath());
-            }
-
-            files.push_back(tmp);
-        } else if(child->GetChildren()) { // we could also add a check for VirtualDirectory only
-            GetFiles(child, files, absPath);
+            DoAddFileToModel(child->GetPropVal(wxT("Name"), wxEmptyString),
+                             vdPath,
+                             XmlUtils::ReadLong(child, "Flags", 0),
+                             XmlUtils::ReadString(child, EXCLUDE_FROM_BUILD_FOR_CONFIG),
+                             false);
+
+        } else if(child->GetName() == wxT("VirtualDirectory")) {
+            wxString name = child->GetPropVal(wxT("Name"), wxEmptyString);
+            DoBuildFilesModel(child, vdPath.IsEmpty() ? name : (vdPath + ":" + name));
+
+        } else if(child->GetChildren()) {
+            // files outside of a virtual folder do not belong to any virtual folder
+            DoBuildFilesModel(child, wxEmptyString);
         }
         child = child->GetNext();
     }
 }
 
+void Project::DoAddFileToModel(const wxString& relpath,
+                               const wxString& vdPath,
+                               size_t flags,
+                               const wxString& excludeConfigs,
+                               bool keepSorted) const
+{
+    FilesModel& model = m_filesModel;
+
+    FileRecord record;
+    wxString dir;
+    SplitRelpath(relpath, dir, record.name);
+    record.flags = flags;
+
+    std::map<wxString, wxUint32>::iterator iter = model.dirIds.find(dir);
+    if(iter == model.dirIds.end()) {
+        iter = model.dirIds.insert(std::make_pair(dir, (wxUint32)model.dirs.size())).first;
+        wxFileName fn(dir, "");
+        fn.MakeAbsolute(GetProjectPath());
+        model.dirs.push_back(dir);
+        model.absDirs.push_back(fn.GetPath(wxPATH_GET_VOLUME | wxPATH_GET_SEPARATOR));
+    }
+    record.dir = iter->second;
+
+    iter = model.folderIds.find(vdPath);
+    if(iter == model.folderIds.end()) {
+        iter = model.folderIds.insert(std::make_pair(vdPath, (wxUint32)model.folders.size())).first;
+        model.folders.push_back(vdPath);
+    }
+    record.folder = iter->second;
+
+    iter = model.excludeConfigsIds.find(excludeConfigs);
+    if(iter == model.excludeConfigsIds.end()) {
+        iter = model.excludeConfigsIds.insert(std::make_pair(excludeConfigs, (wxUint32)model.excludeConfigs.size()))
+                   .first;
+        wxArrayString configs = ::wxStringTokenize(excludeConfigs, ";", wxTOKEN_STRTOK);
+        model.excludeConfigs.push_back(excludeConfigs);
+        model.excludeConfigsSets.push_back(wxStringSet_t(configs.begin(), configs.end()));
+    }
+    record.excludeConfigs = iter->second;
+
+    wxUint32 id = model.files.size();
+    model.files.push_back(record);
+    if(keepSorted) {
+        // 'id' is the last record: insert it after the records with the same path
+        const FileRecord& added = model.files.back();
+        std::vector<wxUint32>::iterator where = std::upper_bound(
+            model.sortedByRelpath.begin(), model.sortedByRelpath.end(), id, [&](wxUint32 a, wxUint32 b) {
+                return IsFileRecordBefore(added.dir, added.name, model.files[b].dir, model.files[b].name);
+            });
+        model.sortedByRelpath.insert(where, id);
+    }
+}
+
+const Project::FileRecord*
+Project::DoFindFileRecord(const wxString& relpath, const wxString& vdPath, bool anyFolder) const
+{
+    // The caller holds m_filesModelLock and the record is valid as long as it does
+    const FilesModel& model = GetFilesModel();
+    wxString dirPath, name;
+    SplitRelpath(relpath, dirPath, name);
+    std::map<wxString, wxUint32>::const_iterator dirIter = model.dirIds.find(dirPath);
+    if(dirIter == model.dirIds.end()) return NULL;
+
+    const wxUint32 dir = dirIter->second;
+    std::vector<wxUint32>::const_iterator iter = std::lower_bound(
+        model.sortedByRelpath.begin(), model.sortedByRelpath.end(), dir, [&](wxUint32 other, wxUint32) {
+            return IsFileRecordBefore(model.files[other].dir, model.files[other].name, dir, name);
+        });
+
+    wxString folder = anyFolder ? wxString() : NormalizeVirtualFolderPath(vdPath);
+    for(; iter != model.sortedByRelpath.end() && model.files[*iter].dir == dir && model.files[*iter].name == name;
+        ++iter) {
+        const FileRecord& record = model.files[*iter];
+        if(anyFolder || model.folders[record.folder] == folder) {
+            return &record;
+        }
+    }
+    return NULL;
+}
+
 wxXmlNode* Project::GetProjectEditorOptions() const
 {
     return XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("Options"));
@@ -496,13 +647,16 @@ wxXmlNode* Project::GetProjectEditorOptions() const
 
 void Project::SetProjectEditorOptions(LocalOptionsConfigPtr opts)
 {
-    wxXmlNode* parent = m_doc.GetRoot();
-    wxXmlNode* oldOptions = XmlUtils::FindFirstByTagName(parent, wxT("Options"));
-    if(oldOptions) {
-        oldOptions->GetParent()->RemoveChild(oldOptions);
-        delete oldOptions;
+    {
+        wxCriticalSectionLocker locker(m_filesModelLock);
+        wxXmlNode* parent = m_doc.GetRoot();
+        wxXmlNode* oldOptions = XmlUtils::FindFirstByTagName(parent, wxT("Options"));
+        if(oldOptions) {
+            oldOptions->GetParent()->RemoveChild(oldOptions);
+            delete oldOptions;
+        }
+        parent->AddChild(opts->ToXml());
     }
-    parent->AddChild(opts->ToXml());
     SaveXmlFile();
 }
 
@@ -510,12 +664,15 @@ ProjectSettingsPtr Project::GetSettings() const { return m_settings; }
 
 void Project::SetSettings(ProjectSettingsPtr settings)
 {
-    wxXmlNode* oldSettings = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("Settings"));
-    if(oldSettings) {
-        oldSettings->GetParent()->RemoveChild(oldSettings);
-        delete oldSettings;
+    {
+        wxCriticalSectionLocker locker(m_filesModelLock);
+        wxXmlNode* oldSettings = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("Settings"));
+        if(oldSettings) {
+            oldSettings->GetParent()->RemoveChild(oldSettings);
+            delete oldSettings;
+        }
+        m_doc.GetRoot()->AddChild(settings->ToXml());
     }
-    m_doc.GetRoot()->AddChild(settings->ToXml());
 
     // SaveXmlFile will update the internal pointer
     SaveXmlFile();
@@ -523,13 +680,16 @@ void Project::SetSettings(ProjectSettingsPtr settings)
 
 void Project::SetGlobalSettings(BuildConfigCommonPtr globalSettings)
 {
-    wxXmlNode* settings = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("Settings"));
-    wxXmlNode* oldSettings = XmlUtils::FindFirstByTagName(settings, wxT("GlobalSettings"));
-    if(oldSettings) {
-        oldSettings->GetParent()->RemoveChild(oldSettings);
-        delete oldSettings;
+    {
+        wxCriticalSectionLocker locker(m_filesModelLock);
+        wxXmlNode* settings = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("Settings"));
+        wxXmlNode* oldSettings = XmlUtils::FindFirstByTagName(settings, wxT("GlobalSettings"));
+        if(oldSettings) {
+            oldSettings->GetParent()->RemoveChild(oldSettings);
+            delete oldSettings;
+        }
+        settings->AddChild(globalSettings->ToXml());
     }
-    settings->AddChild(globalSettings->ToXml());
     SaveXmlFile();
 }
 
@@ -678,27 +838,32 @@ void Project::CopyTo(const wxString& new_path, const wxString& new_name, const w
 
 void Project::SetFiles(ProjectPtr src)
 {
-    // first remove all the virtual directories from this project
-    // Remove virtual folders
-    wxXmlNode* vd = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("VirtualDirectory"));
-    while(vd) {
-        m_doc.GetRoot()->RemoveChild(vd);
-        delete vd;
-        vd = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("VirtualDirectory"));
-    }
+    {
+        wxCriticalSectionLocker locker(m_filesModelLock);
+        // first remove all the virtual directories from this project
+        // Remove virtual folders
+        wxXmlNode* vd = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("VirtualDirectory"));
+        while(vd) {
+            m_doc.GetRoot()->RemoveChild(vd);
+            delete vd;
+            vd = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("VirtualDirectory"));
+        }
+        DoInvalidateFilesModel();
 
-    // sanity
-    if(!src || !src->m_doc.GetRoot()) return;
+        // sanity
+        if(!src || !src->m_doc.GetRoot()) return;
 
-    // copy the virtual directories from the src project
-    wxXmlNode* child = src->m_doc.GetRoot()->GetChildren();
-    while(child) {
-        if(child->GetName() == wxT("VirtualDirectory")) {
-            // create a new VirtualDirectory like this one
-            wxXmlNode* newNode = new wxXmlNode(*child);
-            m_doc.GetRoot()->AddChild(newNode);
+        // copy the virtual directories from the src project
+        wxXmlNode* child = src->m_doc.GetRoot()->GetChildren();
+        while(child) {
+            if(child->GetName() == wxT("VirtualDirectory")) {
+                // create a new VirtualDirectory like this one
+                wxXmlNode* newNode = new wxXmlNode(*child);
+                m_doc.GetRoot()->AddChild(newNode);
+            }
+            child = child->GetNext();
         }
-        child = child->GetNext();
+        DoInvalidateFilesModel();
     }
     SaveXmlFile();
 }
@@ -720,9 +885,11 @@ bool Project::RenameFile(const wxString& oldName, const wxString& virtualDir, co
 
     wxXmlNode* node = XmlUtils::FindNodeByName(vd, wxT("File"), tmp.GetFullPath(wxPATH_UNIX));
     if(node) {
+        wxCriticalSectionLocker locker(m_filesModelLock);
         // update the new name
         tmp.SetFullName(newName);
         XmlUtils::UpdateProperty(node, wxT("Name"), tmp.GetFullPath(wxPATH_UNIX));
+        DoInvalidateFilesModel();
     }
 
     SetModified(true);
@@ -744,24 +911,9 @@ wxString Project::GetVDByFileName(const wxString& file)
     wxFileName tmp(file);
     tmp.MakeRelativeTo(m_fileName.GetPath());
 
-    wxString path(wxEmptyString);
-    wxXmlNode* fileNode = FindFile(m_doc.GetRoot(), tmp.GetFullPath(wxPATH_UNIX));
-
-    if(fileNode) {
-        wxXmlNode* parent = fileNode->GetParent();
-        while(parent) {
-            if(parent->GetName() == wxT("VirtualDirectory")) {
-                path.Prepend(parent->GetPropVal(wxT("Name"), wxEmptyString));
-                path.Prepend(wxT(":"));
-            } else {
-                break;
-            }
-            parent = parent->GetParent();
-        }
-    }
-    wxString trunc_path(path);
-    path.StartsWith(wxT(":"), &trunc_path);
-    return trunc_path;
+    wxCriticalSectionLocker locker(m_filesModelLock);
+    const FileRecord* record = DoFindFileRecord(tmp.GetFullPath(wxPATH_UNIX), wxEmptyString, true);
+    return record ? GetFilesModel().folders[record->folder] : wxString();
 }
 
 wxXmlNode* Project::FindFile(wxXmlNode* parent, const wxString& file)
@@ -788,7 +940,11 @@ bool Project::RenameVirtualDirectory(const wxString& oldVdPath, const wxString&
 {
     wxXmlNode* vdNode = GetVirtualDir(oldVdPath);
     if(vdNode) {
-        XmlUtils::UpdateProperty(vdNode, wxT("Name"), newName);
+        {
+            wxCriticalSectionLocker locker(m_filesModelLock);
+            XmlUtils::UpdateProperty(vdNode, wxT("Name"), newName);
+            DoInvalidateFilesModel();
+        }
         return SaveXmlFile();
     }
     return false;
@@ -822,6 +978,7 @@ wxArrayString Project::GetDependencies(const wxString& configuration) const
 
 void Project::SetDependencies(wxArrayString& deps, const wxString& configuration)
 {
+    wxCriticalSectionLocker locker(m_filesModelLock);
     // first try to locate the old node
     wxXmlNode* node = m_doc.GetRoot()->GetChildren();
     while(node) {
@@ -853,34 +1010,14 @@ void Project::SetDependencies(wxArrayString& deps, const wxString& configuration
 
 void Project::GetFiles(std::vector<wxFileName>& files, std::vector<wxFileName>& absFiles)
 {
-    DirSaver ds;
-    ::wxSetWorkingDirectory(m_fileName.GetPath());
-    GetFiles(m_doc.GetRoot(), files, absFiles);
-}
-
-void Project::GetFiles(wxXmlNode* parent, std::vector<wxFileName>& files, std::vector<wxFileName>& absFiles)
-{
-    if(!parent) {
-        return;
-    }
-
-    wxXmlNode* child = parent->GetChildren();
-    while(child) {
-        if(child->GetName() == wxT("File")) {
-            wxString fileName = child->GetPropVal(wxT("Name"), wxEmptyString);
-            wxFileName tmp(fileName);
-
-            // append the file as it appears
-            files.push_back(tmp);
-
-            // convert to absolute path
-            tmp.MakeAbsolute();
-            absFiles.push_back(tmp);
-
-        } else if(child->GetChildren()) { // we could also add a check for VirtualDirectory only
-            GetFiles(child, files, absFiles);
-        }
-        child = child->GetNext();
+    wxCriticalSectionLocker locker(m_filesModelLock);
+    const FilesModel& model = GetFilesModel();
+    files.reserve(files.size() + model.files.size());
+    absFiles.reserve(absFiles.size() + model.files.size());
+    for(size_t i = 0; i < model.files.size(); i++) {
+        // the file as it appears and its absolute path
+        files.push_back(wxFileName(model.GetRelpath(model.files[i])));
+        absFiles.push_back(wxFileName(model.GetFullpath(model.files[i])));
     }
 }
 
@@ -899,9 +1036,16 @@ bool Project::FastAddFile(const wxString& fileName, const wxString& virtualDir)
     wxFileName tmp(fileName);
     tmp.MakeRelativeTo(m_fileName.GetPath());
 
-    wxXmlNode* node = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("File"));
-    node->AddProperty(wxT("Name"), tmp.GetFullPath(wxPATH_UNIX));
-    vd->AddChild(node);
+    {
+        wxCriticalSectionLocker locker(m_filesModelLock);
+        wxXmlNode* node = new wxXmlNode(NULL, wxXML_ELEMENT_NODE, wxT("File"));
+        node->AddProperty(wxT("Name"), tmp.GetFullPath(wxPATH_UNIX));
+        vd->AddChild(node);
+        if(m_filesModel.valid) {
+            DoAddFileToModel(
+                tmp.GetFullPath(wxPATH_UNIX), NormalizeVirtualFolderPath(virtualDir), 0, wxEmptyString, true);
+        }
+    }
     if(!InTransaction()) {
         SaveXmlFile();
     }
@@ -972,6 +1116,7 @@ bool Project::SetUserData(const wxString& name, SerializedObject* obj)
     }
 
     Archive arch;
+    wxCriticalSectionLocker locker(m_filesModelLock);
 
     // locate the 'UserData' node
     wxXmlNode* userData = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("UserData"));
@@ -1056,6 +1201,7 @@ wxString Project::GetPluginData(const wxString& pluginName)
 
 void Project::SetPluginData(const wxString& pluginName, const wxString& data, bool saveToXml)
 {
+    wxCriticalSectionLocker locker(m_filesModelLock);
     if(!m_doc.IsOk()) {
         return;
     }
@@ -1083,6 +1229,7 @@ void Project::SetPluginData(const wxString& pluginName, const wxString& data, bo
 
 void Project::SetAllPluginsData(const std::map<wxString, wxString>& pluginsDataMap, bool saveToFile /* true */)
 {
+    wxCriticalSectionLocker locker(m_filesModelLock);
     if(!m_doc.IsOk()) {
         return;
     }
@@ -1286,12 +1433,16 @@ void Project::DoDeleteVDFromCache(const wxString& vd)
 
 void Project::ClearAllVirtDirs()
 {
-    // remove all the virtual directories from this project
-    wxXmlNode* vd = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("VirtualDirectory"));
-    while(vd) {
-        m_doc.GetRoot()->RemoveChild(vd);
-        delete vd;
-        vd = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("VirtualDirectory"));
+    {
+        wxCriticalSectionLocker locker(m_filesModelLock);
+        // remove all the virtual directories from this project
+        wxXmlNode* vd = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("VirtualDirectory"));
+        while(vd) {
+            m_doc.GetRoot()->RemoveChild(vd);
+            delete vd;
+            vd = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("VirtualDirectory"));
+        }
+        DoInvalidateFilesModel();
     }
     m_vdCache.clear();
     SetModified(true);
@@ -1346,6 +1497,7 @@ void Project::SetReconciliationData(const wxString& toplevelDir, const wxString&
         return;
     }
 
+    wxCriticalSectionLocker locker(m_filesModelLock);
     wxXmlNode* reconciliation = XmlUtils::FindFirstByTagName(m_doc.GetRoot(), wxT("Reconciliation"));
     if(!reconciliation) {
         reconciliation = new wxXmlNode(m_doc.GetRoot(), wxXML_ELEMENT_NODE, wxT("Reconciliation"));
@@ -1405,65 +1557,19 @@ void Project::SetReconciliationData(const wxString& toplevelDir, const wxString&
 
 void Project::GetFilesMetadata(Project::FileInfoVector_t& files) const
 {
-    std::queue<wxXmlNode*> elements;
-    if(!m_doc.IsOk() || !m_doc.GetRoot()) return;
-
-    elements.push(m_doc.GetRoot());
-    files.reserve(1000); // make room for at least for 1000 files (should be enough for most projects)
-
-    while(!elements.empty()) {
-        wxXmlNode* element = elements.front();
-        elements.pop();
-
-        while(element) {
-            if(element->GetName() == wxT("File")) {
-
-                // files are kept relative to the project file
-                wxString fileName = element->GetAttribute(wxT("Name"), wxEmptyString);
-                wxFileName tmp(fileName);
-                tmp.MakeAbsolute(GetProjectPath());
-                FileInfo fi;
-                fi.SetFilenameRelpath(fileName);
-                fi.SetFilename(tmp.GetFullPath());
-                fi.SetFlags(XmlUtils::ReadLong(element, "Flags", 0));
-
-                wxString excludeConfigs = XmlUtils::ReadString(element, EXCLUDE_FROM_BUILD_FOR_CONFIG);
-                fi.SetExcludeConfigs(::wxStringTokenize(excludeConfigs, ";", wxTOKEN_STRTOK));
-                fi.SetVirtualFolder(DoFormatVirtualFolderName(element));
-                files.push_back(fi);
-
-            } else if(element->GetChildren()) {
-                elements.push(element->GetChildren());
-            }
-            element = element->GetNext();
-        }
-    }
-
-    // releaes any un-needed memory
-    Project::FileInfoVector_t(files).swap(files);
-}
-
-wxString Project::DoFormatVirtualFolderName(const wxXmlNode* node) const
-{
-    // we assume that 'node' is a 'File' element
-    wxString name;
-    wxXmlNode* p = node->GetParent();
-    std::list<wxString> q;
-    while(p) {
-        if(p->GetName() == "VirtualDirectory")
-            q.push_front(p->GetPropVal("Name", ""));
-        else
-            break;
-        p = p->GetParent();
-    }
-
-    while(!q.empty()) {
-        name << q.front() << ":";
-        q.pop_front();
+    wxCriticalSectionLocker locker(m_filesModelLock);
+    const FilesModel& model = GetFilesModel();
+    files.reserve(files.size() + model.files.size());
+    for(size_t i = 0; i < model.files.size(); ++i) {
+        const FileRecord& record = model.files[i];
+        FileInfo fi;
+        fi.SetFilenameRelpath(model.GetRelpath(record));
+        fi.SetFilename(model.GetFullpath(record));
+        fi.SetFlags(record.flags);
+        fi.SetExcludeConfigs(model.excludeConfigsSets[record.excludeConfigs]);
+        fi.SetVirtualFolder(model.folders[record.folder]);
+        files.push_back(fi);
     }
-
-    if(name.IsEmpty() == false) name.RemoveLast();
-    return name;
 }
 
 void Project::SetFileFlags(const wxString& fileName, const wxString& virtualDirPath, size_t flags)
@@ -1484,48 +1590,38 @@ void Project::SetFileFlags(const wxString& fileName, const wxString& virtualDirP
 
     // we have located the file node
     // updat the flags
-    XmlUtils::UpdateProperty(fileNode, "Flags", wxString() << flags);
+    {
+        wxCriticalSectionLocker locker(m_filesModelLock);
+        XmlUtils::UpdateProperty(fileNode, "Flags", wxString() << flags);
+        DoInvalidateFilesModel();
+    }
     SaveXmlFile();
 }
 
 size_t Project::GetFileFlags(const wxString& fileName, const wxString& virtualDirPath)
 {
-    wxXmlNode* vdNode = GetVirtualDir(virtualDirPath);
-    if(!vdNode) {
-        return 0;
-    }
-
     // locate our file
     wxFileName tmp(fileName);
     tmp.MakeRelativeTo(m_fileName.GetPath());
-    wxString filepath = tmp.GetFullPath(wxPATH_UNIX);
-    wxXmlNode* fileNode = XmlUtils::FindNodeByName(vdNode, "File", filepath);
-    if(!fileNode) {
-        return 0;
-    }
-
-    return XmlUtils::ReadLong(fileNode, "Flags", 0);
+    wxCriticalSectionLocker locker(m_filesModelLock);
+    const FileRecord* record = DoFindFileRecord(tmp.GetFullPath(wxPATH_UNIX), virtualDirPath, false);
+    return record ? record->flags : 0;
 }
 
 wxArrayString Project::GetExcludeConfigForFile(const wxString& filename, const wxString& virtualDirPath)
 {
     wxArrayString configs;
-    wxXmlNode* vdNode = GetVirtualDir(virtualDirPath);
-    if(!vdNode) {
-        return configs;
-    }
 
     // locate our file
     wxFileName tmp(filename);
     tmp.MakeRelativeTo(m_fileName.GetPath());
-    wxString filepath = tmp.GetFullPath(wxPATH_UNIX);
-    wxXmlNode* fileNode = XmlUtils::FindNodeByName(vdNode, "File", filepath);
-    if(!fileNode) {
+    wxCriticalSectionLocker locker(m_filesModelLock);
+    const FileRecord* record = DoFindFileRecord(tmp.GetFullPath(wxPATH_UNIX), virtualDirPath, false);
+    if(!record) {
         return configs;
     }
 
-    wxString excludeConfigs = XmlUtils::ReadString(fileNode, EXCLUDE_FROM_BUILD_FOR_CONFIG);
-    configs = ::wxStringTokenize(excludeConfigs, ";", wxTOKEN_STRTOK);
+    configs = ::wxStringTokenize(GetFilesModel().excludeConfigs[record->excludeConfigs], ";", wxTOKEN_STRTOK);
     return configs;
 }
 
@@ -1556,7 +1652,11 @@ void Project::SetExcludeConfigForFile(
     }
 
     wxString excludeConfigs = ::wxJoin(uniqueArr, ';');
-    XmlUtils::UpdateProperty(fileNode, EXCLUDE_FROM_BUILD_FOR_CONFIG, excludeConfigs);
+    {
+        wxCriticalSectionLocker locker(m_filesModelLock);
+        XmlUtils::UpdateProperty(fileNode, EXCLUDE_FROM_BUILD_FOR_CONFIG, excludeConfigs);
+        DoInvalidateFilesModel();
+    }
     SaveXmlFile();
 }
 
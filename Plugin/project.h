@@ -30,6 +30,7 @@
 #include <wx/xml/xml.h>
 #include "codelite_exports.h"
 #include "wx/filename.h"
+#include <wx/thread.h>
 #include <tree.h>
 #include "codelite_exports.h"
 #include "smart_ptr.h"
@@ -167,6 +168,49 @@ public:
     friend class clCxxWorkspace;
 
 private:
+    // -----------------------------------------
+    // The project files, as read from the XML
+    // -----------------------------------------
+    struct FileRecord {
+        wxString name;           // the file name
+        wxUint32 dir;            // index in FilesModel::dirs
+        wxUint32 folder;         // index in FilesModel::folders
+        wxUint32 excludeConfigs; // index in FilesModel::excludeConfigs
+        size_t flags;
+    };
+
+    /**
+     * @brief a flat model of the files and their virtual folders, built with a single pass over the
+     * XML document and queried instead of the document. The document is only updated by the write
+     * operations: files added with AddFile/FastAddFile are appended to the model, the other
+     * changes invalidate it and it is rebuilt when queried.
+     * The paths are not stored: a record keeps the file name and its interned directory.
+     * Worker threads read the project, the model is guarded by m_filesModelLock. The model is rebuilt
+     * from m_doc under the lock, so every change of the document structure holds it too
+     */
+    struct FilesModel {
+        std::vector<FileRecord> files;          // document order (files added since the last build are last)
+        std::vector<wxUint32> sortedByRelpath;  // indices in 'files', sorted by (dir, name)
+        std::vector<wxString> dirs;             // interned directories as stored in the project ("../src/")
+        std::vector<wxString> absDirs;          // the same directories, absolute
+        std::map<wxString, wxUint32> dirIds;
+        std::vector<wxString> folders;          // interned virtual folder paths ("a:b:c")
+        std::map<wxString, wxUint32> folderIds;
+        std::vector<wxString> excludeConfigs;   // interned "exclude from build" lists
+        std::vector<wxStringSet_t> excludeConfigsSets;
+        std::map<wxString, wxUint32> excludeConfigsIds;
+        bool valid;
+
+        FilesModel()
+            : valid(false)
+        {
+        }
+
+        // as stored in the project (Unix format, relative to the project)
+        wxString GetRelpath(const FileRecord& record) const { return dirs[record.dir] + record.name; }
+        wxString GetFullpath(const FileRecord& record) const { return absDirs[record.dir] + record.name; }
+    };
+
     wxXmlDocument m_doc;
     wxFileName m_fileName;
     wxString m_projectPath;
@@ -177,9 +221,18 @@ private:
     clCxxWorkspace* m_workspace;
     ProjectSettingsPtr m_settings;
     wxString m_iconPath; /// Not serializable
+    mutable FilesModel m_filesModel;
+    mutable wxCriticalSection m_filesModelLock; // recursive, held by the m_doc writers and the model readers
 
 private:
     void DoUpdateProjectSettings();
+    // The files model methods below must be called with m_filesModelLock held
+    const FilesModel& GetFilesModel() const;
+    void DoBuildFilesModel(wxXmlNode* parent, const wxString& vdPath) const;
+    void DoAddFileToModel(const wxString& relpath, const wxString& vdPath, size_t flags,
+                          const wxString& excludeConfigs, bool keepSorted) const;
+    void DoInvalidateFilesModel();
+    const FileRecord* DoFindFileRecord(const wxString& relpath, const wxString& vdPath, bool anyFolder) const;
     wxArrayString DoGetCompilerOptions(
         bool cxxOptions, bool clearCache = false, bool noDefines = true, bool noIncludePaths = true);
 
@@ -667,8 +720,6 @@ private:
      */
     void AssociateToWorkspace(clCxxWorkspace* workspace);
 
-    wxString DoFormatVirtualFolderName(const wxXmlNode* node) const;
-
     void DoDeleteVDFromCache(const wxString& vd);
     wxArrayString DoBacktickToIncludePath(const wxString& backtick);
     wxArrayString DoBacktickToPreProcessors(const wxString& backtick);
@@ -686,8 +737,6 @@ private:
     // Create virtual dir and return its xml node
     wxXmlNode* CreateVD(const wxString& vdFullPath, bool mkpath = false);
 
-    void GetFiles(wxXmlNode* parent, std::vector<wxFileName>& files, bool absPath = false);
-    void GetFiles(wxXmlNode* parent, std::vector<wxFileName>& files, std::vector<wxFileName>& absFiles);
     /**
      * Return list of projects that this projects depends on
      */
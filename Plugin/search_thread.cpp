@@ -39,7 +39,14 @@
 #include "workspace.h"
 #include "globals.h"
 #include <algorithm>
+#include <vector>
+#include <string.h>
+#include <wx/thread.h>
 #include "fileutils.h"
+#include "clMappedFile.h"
+#include "clByteSearcher.h"
+#include "clTrigramIndex.h"
+#include "file_logger.h"
 
 const wxEventType wxEVT_SEARCH_THREAD_MATCHFOUND = wxNewEventType();
 const wxEventType wxEVT_SEARCH_THREAD_SEARCHEND = wxNewEventType();
@@ -60,6 +67,157 @@ const wxEventType wxEVT_SEARCH_THREAD_SEARCHSTARTED = wxNewEventType();
 
 const wxString& SearchData::GetExtensions() const { return m_validExt; }
 
+// Return the number of wxChars needed to hold the UTF-8 bytes [begin, end)
+static size_t UTF8CharsCount(const char* begin, const char* end)
+{
+    size_t count = 0;
+    for(const unsigned char* p = (const unsigned char*)begin; p < (const unsigned char*)end; ++p) {
+        if((*p & 0xC0) != 0x80) {
+            ++count;
+            // a 4 bytes sequence is stored as a surrogate pair when wchar_t is 16 bit
+            if(sizeof(wchar_t) == 2 && *p >= 0xF0) ++count;
+        }
+    }
+    return count;
+}
+
+//----------------------------------------------------------------
+// LineLocator - lazy line number / offset tracking over a buffer
+//----------------------------------------------------------------
+
+class LineLocator
+{
+    const char* m_end;
+    const char* m_lineStart;
+    int m_lineNumber;
+    size_t m_lineOffset; // in chars
+
+public:
+    LineLocator(const char* buffer, const char* end)
+        : m_end(end)
+        , m_lineStart(buffer)
+        , m_lineNumber(1)
+        , m_lineOffset(0)
+    {
+    }
+
+    /**
+     * Move to the line containing 'p'. Moving backward is not supported
+     */
+    void MoveTo(const char* p)
+    {
+        const char* nl = NULL;
+        while((nl = (const char*)::memchr(m_lineStart, '\n', p - m_lineStart))) {
+            m_lineOffset += UTF8CharsCount(m_lineStart, nl + 1);
+            m_lineStart = nl + 1;
+            ++m_lineNumber;
+        }
+    }
+
+    const char* GetLineStart() const { return m_lineStart; }
+    const char* GetLineEnd() const
+    {
+        const char* nl = (const char*)::memchr(m_lineStart, '\n', m_end - m_lineStart);
+        return nl ? nl : m_end;
+    }
+    int GetLineNumber() const { return m_lineNumber; }
+    size_t GetLineOffset() const { return m_lineOffset; }
+};
+
+//----------------------------------------------------------------
+// SearchJob - state shared between the search thread and its workers
+//----------------------------------------------------------------
+
+struct SearchFileResult {
+    SearchResultList results;
+    bool ok;
+    bool done;
+
+    SearchFileResult()
+        : ok(true)
+        , done(false)
+    {
+    }
+};
+
+struct SearchJob {
+    const wxArrayString& files;
+    const SearchData* data;
+    std::vector<SearchFileResult> slots;
+    size_t nextFile;     // next file index to hand to a worker
+    size_t aliveWorkers; // number of workers still running
+    wxMutex mutex;
+    wxCondition cond;
+
+    SearchJob(const wxArrayString& fileList, const SearchData* sd)
+        : files(fileList)
+        , data(sd)
+        , slots(fileList.GetCount())
+        , nextFile(0)
+        , aliveWorkers(0)
+        , cond(mutex)
+    {
+    }
+};
+
+//----------------------------------------------------------------
+// SearchWorker
+//----------------------------------------------------------------
+
+class SearchWorker : public wxThread
+{
+    SearchThread* m_searchThread;
+    SearchJob& m_job;
+
+public:
+    SearchWorker(SearchThread* searchThread, SearchJob& job)
+        : wxThread(wxTHREAD_JOINABLE)
+        , m_searchThread(searchThread)
+        , m_job(job)
+    {
+    }
+    virtual ~SearchWorker() {}
+
+    virtual void* Entry()
+    {
+        // Each worker uses its own regex object, wxRegEx can not be shared between threads
+        wxRegEx re;
+        if(m_job.data->IsRegularExpression()) {
+#ifndef __WXMAC__
+            int flags = wxRE_ADVANCED;
+#else
+            int flags = wxRE_DEFAULT;
+#endif
+            if(!m_job.data->IsMatchCase()) flags |= wxRE_ICASE;
+            re.Compile(m_job.data->GetFindString(), flags);
+        }
+
+        while(!m_searchThread->TestStopSearch()) {
+            size_t index;
+            {
+                wxMutexLocker locker(m_job.mutex);
+                if(m_job.nextFile >= m_job.slots.size()) break;
+                index = m_job.nextFile++;
+            }
+
+            SearchResultList results;
+            bool ok = m_searchThread->DoSearchFile(m_job.files.Item(index), m_job.data, re, results);
+
+            wxMutexLocker locker(m_job.mutex);
+            SearchFileResult& slot = m_job.slots.at(index);
+            slot.results.swap(results);
+            slot.ok = ok;
+            slot.done = true;
+            m_job.cond.Broadcast();
+        }
+
+        wxMutexLocker locker(m_job.mutex);
+        --m_job.aliveWorkers;
+        m_job.cond.Broadcast();
+        return NULL;
+    }
+};
+
 //----------------------------------------------------------------
 // SearchThread
 //----------------------------------------------------------------
@@ -68,6 +226,7 @@ SearchThread::SearchThread()
     : WorkerThread()
     , m_wordChars(wxT("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_"))
     , m_reExpr(wxT(""))
+    , m_maxWorkers(wxThread::GetCPUCount() > 0 ? wxThread::GetCPUCount() : 1)
 {
     IndexWordChars();
 }
@@ -169,6 +328,7 @@ void SearchThread::DoSearchFiles(ThreadRequest* req)
     StopSearch(false);
     wxArrayString fileList;
     GetFiles(data, fileList);
+    FilterFilesByIndex(fileList, data);
 
     wxStopWatch sw;
 
@@ -184,6 +344,31 @@ void SearchThread::DoSearchFiles(ThreadRequest* req)
         }
     }
 
+    // Compile the linear time regex once for the whole search, it is shared by the workers.
+    // It is used whenever the pattern is supported, it returns the same matches as wxRegEx
+    // in advanced mode (on OSX wxRegEx uses the extended syntax, so it is not used there)
+    m_linearRegex.Reset();
+#ifndef __WXMAC__
+    if(data->IsRegularExpression() && wxFontMapper::GetEncodingFromName(data->GetEncoding()) == wxFONTENCODING_UTF8) {
+        if(!m_linearRegex.Compile(data->GetFindString(), data->IsMatchCase())) {
+            CL_DEBUG("Find in files: expression '%s' is not supported by the linear regex engine, using wxRegEx",
+                     data->GetFindString());
+        }
+    }
+#endif
+
+    // Small searches are not worth the cost of starting the workers
+    size_t workersCount = std::min(m_maxWorkers, fileList.GetCount() / 2);
+    if(workersCount > 1) {
+        DoSearchFilesParallel(fileList, data, workersCount);
+    } else {
+        DoSearchFilesSerial(fileList, data);
+    }
+}
+
+void SearchThread::DoSearchFilesSerial(const wxArrayString& fileList, const SearchData* data)
+{
+    wxRegEx& re = data->IsRegularExpression() ? GetRegex(data->GetFindString(), data->IsMatchCase()) : m_regex;
     for(size_t i = 0; i < fileList.Count(); i++) {
         m_summary.SetNumFileScanned((int)i + 1);
 
@@ -194,8 +379,94 @@ void SearchThread::DoSearchFiles(ThreadRequest* req)
             StopSearch(false);
             break;
         }
-        DoSearchFile(fileList.Item(i), data);
+
+        SearchResultList results;
+        bool ok = DoSearchFile(fileList.Item(i), data, re, results);
+        DoReportFileResults(fileList.Item(i), ok, results, data);
+    }
+}
+
+void SearchThread::DoSearchFilesParallel(const wxArrayString& fileList, const SearchData* data, size_t workersCount)
+{
+    SearchJob job(fileList, data);
+    std::vector<SearchWorker*> workers;
+    for(size_t i = 0; i < workersCount; ++i) {
+        SearchWorker* worker = new SearchWorker(this, job);
+        if(worker->Create() != wxTHREAD_NO_ERROR) {
+            delete worker;
+            break;
+        }
+        workers.push_back(worker);
+    }
+
+    if(workers.empty()) {
+        // Could not start any worker, fallback to the serial search
+        DoSearchFilesSerial(fileList, data);
+        return;
+    }
+
+    job.aliveWorkers = workers.size();
+    std::for_each(workers.begin(), workers.end(), [&](SearchWorker* worker) { worker->Run(); });
+
+    // Collect the results in the files order so the output is stable
+    // regardless of which worker scanned which file
+    bool cancelled = false;
+    for(size_t i = 0; i < fileList.GetCount(); ++i) {
+        SearchResultList results;
+        bool ok = true;
+        {
+            wxMutexLocker locker(job.mutex);
+            SearchFileResult& slot = job.slots.at(i);
+            while(!slot.done && job.aliveWorkers) {
+                job.cond.Wait();
+            }
+
+            if(!slot.done) {
+                // All the workers are gone before scanning this file: the search was cancelled
+                cancelled = true;
+                break;
+            }
+            results.swap(slot.results);
+            ok = slot.ok;
+        }
+
+        m_summary.SetNumFileScanned((int)i + 1);
+        DoReportFileResults(fileList.Item(i), ok, results, data);
+
+        if(TestStopSearch()) {
+            cancelled = true;
+            break;
+        }
+    }
+
+    // Wait for the workers before resetting the stop flag
+    std::for_each(workers.begin(), workers.end(), [&](SearchWorker* worker) {
+        worker->Wait();
+        delete worker;
+    });
+
+    if(cancelled) {
+        // Send cancel event
+        SendEvent(wxEVT_SEARCH_THREAD_SEARCHCANCELED, data->GetOwner());
+        StopSearch(false);
+    }
+}
+
+void SearchThread::DoReportFileResults(const wxString& fileName,
+                                       bool ok,
+                                       SearchResultList& results,
+                                       const SearchData* data)
+{
+    if(!ok) {
+        // failed to open the file, probably because of permissions
+        m_summary.GetFailedFiles().Add(fileName);
+        return;
     }
+
+    if(results.empty()) return;
+    m_summary.SetNumMatchesFound(m_summary.GetNumMatchesFound() + (int)results.size());
+    m_results.splice(m_results.end(), results);
+    SendEvent(wxEVT_SEARCH_THREAD_MATCHFOUND, data->GetOwner());
 }
 
 bool SearchThread::TestStopSearch()
@@ -214,19 +485,33 @@ void SearchThread::StopSearch(bool stop)
     m_stopSearch = stop;
 }
 
-void SearchThread::DoSearchFile(const wxString& fileName, const SearchData* data)
+bool SearchThread::DoSearchFile(const wxString& fileName,
+                                const SearchData* data,
+                                wxRegEx& re,
+                                SearchResultList& results)
 {
     // Process single lines
     int lineNumber = 1;
     if(!wxFileName::FileExists(fileName)) {
-        return;
+        return true;
+    }
+
+    // Try the byte level matchers first
+    if(m_linearRegex.IsOk()) {
+        int rc = DoSearchFileRegexBytes(fileName, data, results);
+        if(rc != kBytesSearchNotSupported) {
+            return rc == kBytesSearchOK;
+        }
+    } else if(CanSearchBytes(data)) {
+        int rc = DoSearchFileBytes(fileName, data, results);
+        if(rc != kBytesSearchNotSupported) {
+            return rc == kBytesSearchOK;
+        }
     }
 
     wxFFile thefile(fileName, wxT("rb"));
     if(!thefile.IsOpened()) {
-        // failed to open the file, probably because of permissions
-        m_summary.GetFailedFiles().Add(fileName);
-        return;
+        return false;
     }
 
     wxFileOffset size = thefile.Length();
@@ -237,8 +522,7 @@ void SearchThread::DoSearchFile(const wxString& fileName, const SearchData* data
     wxFontEncoding enc = wxFontMapper::GetEncodingFromName(data->GetEncoding().c_str());
     wxCSConv fontEncConv(enc);
     if(!thefile.ReadAll(&fileData, fontEncConv)) {
-        m_summary.GetFailedFiles().Add(fileName);
-        return;
+        return false;
     }
 
     // take a wild guess and see if we really need to construct
@@ -269,7 +553,7 @@ void SearchThread::DoSearchFile(const wxString& fileName, const SearchData* data
         while(tkz.HasMoreTokens()) {
             // Read the next line
             wxString line = tkz.NextToken();
-            DoSearchLineRE(line, lineNumber, lineOffset, fileName, data, states);
+            DoSearchLineRE(line, lineNumber, lineOffset, fileName, data, states, re, results);
             lineOffset += line.Length() + 1;
             lineNumber++;
         }
@@ -277,53 +561,213 @@ void SearchThread::DoSearchFile(const wxString& fileName, const SearchData* data
         // simple search
         wxString findString;
         wxArrayString filters;
-        findString = data->GetFindString();
-        if(data->IsEnablePipeSupport()) {
-            if(data->GetFindString().Find('|') != wxNOT_FOUND) {
-                findString = data->GetFindString().BeforeFirst('|');
-
-                wxString filtersString = data->GetFindString().AfterFirst('|');
-                filters = ::wxStringTokenize(filtersString, "|", wxTOKEN_STRTOK);
-                if(!data->IsMatchCase()) {
-                    for(size_t i = 0; i < filters.size(); ++i) {
-                        filters.Item(i).MakeLower();
-                    }
-                }
-            }
-        }
-
-        if(!data->IsMatchCase()) {
-            findString.MakeLower();
-        }
+        GetFindStringAndFilters(data, findString, filters);
 
         while(tkz.HasMoreTokens()) {
 
             // Read the next line
             wxString line = tkz.NextToken();
-            DoSearchLine(line, lineNumber, lineOffset, fileName, data, findString, filters, states);
+            DoSearchLine(line, lineNumber, lineOffset, fileName, data, findString, filters, states, results);
             lineOffset += line.Length() + 1;
             lineNumber++;
         }
     }
 
-    if(m_results.empty() == false) SendEvent(wxEVT_SEARCH_THREAD_MATCHFOUND, data->GetOwner());
+    return true;
+}
+
+void SearchThread::GetFindStringAndFilters(const SearchData* data, wxString& findString, wxArrayString& filters)
+{
+    findString = data->GetFindString();
+    filters.clear();
+    if(data->IsEnablePipeSupport()) {
+        if(data->GetFindString().Find('|') != wxNOT_FOUND) {
+            findString = data->GetFindString().BeforeFirst('|');
+
+            wxString filtersString = data->GetFindString().AfterFirst('|');
+            filters = ::wxStringTokenize(filtersString, "|", wxTOKEN_STRTOK);
+            if(!data->IsMatchCase()) {
+                for(size_t i = 0; i < filters.size(); ++i) {
+                    filters.Item(i).MakeLower();
+                }
+            }
+        }
+    }
+
+    if(!data->IsMatchCase()) {
+        findString.MakeLower();
+    }
+}
+
+bool SearchThread::CanSearchBytes(const SearchData* data) const
+{
+    // The byte matcher works on UTF-8 (and plain ASCII) files only
+    if(data->IsRegularExpression()) return false;
+    if(wxFontMapper::GetEncodingFromName(data->GetEncoding()) != wxFONTENCODING_UTF8) return false;
+
+    // Case folding is done for ASCII characters only
+    if(!data->IsMatchCase() && !data->GetFindString().IsAscii()) return false;
+    if(data->IsMatchWholeWord() && !m_wordChars.IsAscii()) return false;
+    return true;
+}
+
+int SearchThread::DoSearchFileBytes(const wxString& fileName, const SearchData* data, SearchResultList& results)
+{
+    wxString findString;
+    wxArrayString filters;
+    GetFindStringAndFilters(data, findString, filters);
+    if(findString.IsEmpty()) return kBytesSearchNotSupported;
+
+    clMappedFile mappedFile;
+    if(!mappedFile.Open(fileName)) {
+        return kBytesSearchFailed;
+    }
+
+    const bool matchCase = data->IsMatchCase();
+    clByteSearcher searcher(findString.mb_str(wxConvUTF8).data(), matchCase);
+    std::vector<clByteSearcher> filterSearchers;
+    for(size_t i = 0; i < filters.size(); ++i) {
+        filterSearchers.push_back(clByteSearcher(filters.Item(i).mb_str(wxConvUTF8).data(), matchCase));
+    }
+
+    const size_t findLen = searcher.GetLength();
+    const char* buffer = mappedFile.GetData();
+    const char* bufferEnd = buffer + mappedFile.GetSize();
+    LineLocator locator(buffer, bufferEnd);
+
+    SearchResultList fileResults;
+    const char* p = buffer;
+    while(p < bufferEnd) {
+        const char* match = searcher.Find(p, bufferEnd);
+        if(!match) break;
+
+        locator.MoveTo(match);
+        const char* lineStart = locator.GetLineStart();
+        const char* lineEnd = locator.GetLineEnd();
+        wxString line = wxString::FromUTF8(lineStart, lineEnd - lineStart);
+        if(line.IsEmpty()) {
+            // Not a valid UTF-8 content, let the wxString based search handle it
+            return kBytesSearchNotSupported;
+        }
+
+        // Collect all the matches on this line
+        const char* from = lineStart;
+        while(true) {
+            const char* m = searcher.Find(from, lineEnd);
+            if(!m) break;
+
+            // Pipe support: all the filters must appear in the remainder of the line
+            bool allFiltersOK = true;
+            for(size_t i = 0; i < filterSearchers.size() && allFiltersOK; ++i) {
+                allFiltersOK = (filterSearchers.at(i).Find(from, lineEnd) != NULL);
+            }
+            if(!allFiltersOK) break;
+
+            if(data->IsMatchWholeWord()) {
+                unsigned char prevCh = (m > lineStart) ? (unsigned char)m[-1] : 0;
+                unsigned char nextCh = (m + findLen < lineEnd) ? (unsigned char)m[findLen] : 0;
+                if((prevCh && prevCh < 0x80 && m_wordCharsMap.count((wxChar)prevCh)) ||
+                   (nextCh && nextCh < 0x80 && m_wordCharsMap.count((wxChar)nextCh))) {
+                    from = m + findLen;
+                    continue;
+                }
+            }
+
+            DoAddBytesMatch(fileName, data, line, locator, m, findLen, fileResults);
+            from = m + findLen;
+        }
+
+        if(lineEnd == bufferEnd) break;
+        p = lineEnd + 1;
+    }
+
+    results.splice(results.end(), fileResults);
+    return kBytesSearchOK;
+}
+
+int SearchThread::DoSearchFileRegexBytes(const wxString& fileName,
+                                         const SearchData* data,
+                                         SearchResultList& results)
+{
+    clMappedFile mappedFile;
+    if(!mappedFile.Open(fileName)) {
+        return kBytesSearchFailed;
+    }
+
+    // The whole file is scanned at once, the lines are located only when there is a match
+    const char* buffer = mappedFile.GetData();
+    const size_t size = mappedFile.GetSize();
+    LineLocator locator(buffer, buffer + size);
+
+    SearchResultList fileResults;
+    wxString line;
+    const char* lineStart = NULL;
+    size_t from = 0, matchStart = 0, matchLen = 0;
+    while(m_linearRegex.Find(buffer, size, from, matchStart, matchLen)) {
+        const char* m = buffer + matchStart;
+        locator.MoveTo(m);
+        if(locator.GetLineStart() != lineStart) {
+            lineStart = locator.GetLineStart();
+            line = wxString::FromUTF8(lineStart, locator.GetLineEnd() - lineStart);
+            if(line.IsEmpty()) {
+                // Not a valid UTF-8 content, let wxRegEx handle it
+                return kBytesSearchNotSupported;
+            }
+        }
+
+        DoAddBytesMatch(fileName, data, line, locator, m, matchLen, fileResults);
+        from = matchStart + matchLen;
+    }
+
+    results.splice(results.end(), fileResults);
+    return kBytesSearchOK;
+}
+
+void SearchThread::DoAddBytesMatch(const wxString& fileName,
+                                   const SearchData* data,
+                                   const wxString& line,
+                                   const LineLocator& locator,
+                                   const char* match,
+                                   size_t matchLen,
+                                   SearchResultList& results)
+{
+    const char* lineStart = locator.GetLineStart();
+    int colInChars = (int)UTF8CharsCount(lineStart, match);
+
+    SearchResult result;
+    result.SetPosition((int)locator.GetLineOffset() + colInChars);
+    result.SetColumnInChars(colInChars);
+    result.SetColumn((int)(match - lineStart));
+    result.SetLineNumber(locator.GetLineNumber());
+    result.SetPattern(line);
+    result.SetFileName(fileName);
+    result.SetLenInChars((int)UTF8CharsCount(match, match + matchLen));
+    result.SetLen((int)matchLen);
+    result.SetFindWhat(data->GetFindString());
+    result.SetFlags(data->m_flags);
+    result.SetMatchState(CppWordScanner::STATE_NORMAL);
+    results.push_back(result);
 }
+
 void SearchThread::DoSearchLineRE(const wxString& line,
                                   const int lineNum,
                                   const int lineOffset,
                                   const wxString& fileName,
                                   const SearchData* data,
-                                  TextStatesPtr statesPtr)
+                                  TextStatesPtr statesPtr,
+                                  wxRegEx& re,
+                                  SearchResultList& results)
 {
-    wxRegEx& re = GetRegex(data->GetFindString(), data->IsMatchCase());
     size_t col = 0;
     int iCorrectedCol = 0;
     int iCorrectedLen = 0;
     wxString modLine = line;
     if(re.IsValid()) {
-        while(re.Matches(modLine)) {
+        // modLine is the rest of the line after the previous match: '^' must not match at its start
+        while(re.Matches(modLine, col ? wxRE_NOTBOL : 0)) {
             size_t start, len;
             re.GetMatch(&start, &len);
+            if(len == 0) break; // an empty match would never advance
             col += start;
 
             // Notify our match
@@ -381,8 +825,7 @@ void SearchThread::DoSearchLineRE(const wxString& line,
             }
 
             if(canAdd) {
-                m_results.push_back(result);
-                m_summary.SetNumMatchesFound(m_summary.GetNumMatchesFound() + 1);
+                results.push_back(result);
             }
 
             col += len;
@@ -401,7 +844,8 @@ void SearchThread::DoSearchLine(const wxString& line,
                                 const SearchData* data,
                                 const wxString& findWhat,
                                 const wxArrayString& filters,
-                                TextStatesPtr statesPtr)
+                                TextStatesPtr statesPtr,
+                                SearchResultList& results)
 {
     wxString modLine = line;
 
@@ -514,8 +958,7 @@ void SearchThread::DoSearchLine(const wxString& line,
             }
 
             if(canAdd) {
-                m_results.push_back(result);
-                m_summary.SetNumMatchesFound(m_summary.GetNumMatchesFound() + 1);
+                results.push_back(result);
             }
 
             if(!AdjustLine(modLine, pos, findWhat)) {
@@ -604,6 +1047,104 @@ void SearchThread::FilterFiles(wxArrayString& files, const SearchData* data)
     files.swap(tmpFiles);
 }
 
+// Return the literal strings that must appear in any line matched by the regular expression 're'
+// The analysis is conservative: anything that is not fully understood is skipped
+static wxArrayString GetRegexLiterals(const wxString& re)
+{
+    wxArrayString literals;
+    wxString current;
+
+    // An alternation means that no literal is mandatory
+    for(size_t i = 0; i < re.length(); ++i) {
+        if(re[i] == '\\') {
+            ++i;
+        } else if(re[i] == '|') {
+            return literals;
+        }
+    }
+
+    for(size_t i = 0; i < re.length(); ++i) {
+        wxChar ch = re[i];
+        wxChar literal = 0;
+        if(ch == '\\') {
+            // an escaped punctuation is a literal, anything else (\d, \w, \x41, back references...) is not
+            if(i + 1 < re.length() && !wxIsalnum(re[i + 1])) {
+                literal = re[i + 1];
+                ++i;
+            } else {
+                // skip the escape and its arguments
+                while(i + 1 < re.length() && wxIsalnum(re[i + 1])) {
+                    ++i;
+                }
+            }
+
+        } else if(ch == '[' || ch == '(') {
+            // skip the bracket expression or the group
+            wxChar closing = (ch == '[') ? ']' : ')';
+            int depth = 1;
+            ++i;
+            if(ch == '[' && i < re.length() && re[i] == '^') ++i;
+            if(ch == '[' && i < re.length() && re[i] == ']') ++i;
+            for(; i < re.length() && depth; ++i) {
+                if(re[i] == '\\') {
+                    ++i;
+                } else if(ch == '(' && re[i] == '(') {
+                    ++depth;
+                } else if(re[i] == closing) {
+                    --depth;
+                }
+            }
+            --i;
+
+        } else if(ch == '*' || ch == '?' || ch == '{') {
+            // the previous atom is optional
+            if(!current.IsEmpty()) current.RemoveLast();
+            if(ch == '{') {
+                while(i < re.length() && re[i] != '}') {
+                    ++i;
+                }
+            }
+
+        } else if(ch != '.' && ch != '^' && ch != '$' && ch != '+' && ch != ')' && ch != ']') {
+            literal = ch;
+        }
+
+        if(literal) {
+            current << literal;
+        } else {
+            if(current.length() >= 3) literals.Add(current);
+            current.Clear();
+        }
+    }
+
+    if(current.length() >= 3) literals.Add(current);
+    return literals;
+}
+
+void SearchThread::FilterFilesByIndex(wxArrayString& files, const SearchData* data)
+{
+    if(!clTrigramIndex::Get().IsOpen()) return;
+
+    // The index is built from the raw file content
+    if(wxFontMapper::GetEncodingFromName(data->GetEncoding()) != wxFONTENCODING_UTF8) return;
+
+    wxArrayString literals;
+    if(data->IsRegularExpression()) {
+        literals = GetRegexLiterals(data->GetFindString());
+    } else {
+        wxString findString;
+        wxArrayString filters;
+        GetFindStringAndFilters(data, findString, filters);
+        literals.Add(findString);
+        literals.insert(literals.end(), filters.begin(), filters.end());
+    }
+
+    // Non ASCII characters are not case folded by the index, so they can only be used
+    // for case sensitive plain text searches
+    bool allowNonAscii = data->IsMatchCase() && !data->IsRegularExpression();
+    clTrigramIndex::Get().FilterFiles(literals, allowNonAscii, files);
+}
+
 static SearchThread* gs_SearchThread = NULL;
 void SearchThreadST::Free()
 {
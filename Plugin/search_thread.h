@@ -36,11 +36,14 @@
 #include <wx/regex.h>
 #include "worker_thread.h"
 #include "stringsearcher.h"
+#include "clLinearRegex.h"
 #include "codelite_exports.h"
 
 class wxEvtHandler;
 class SearchResult;
 class SearchThread;
+class SearchWorker;
+class LineLocator;
 
 //----------------------------------------------------------
 // The searched data class to be passed to the search thread
@@ -321,6 +324,7 @@ public:
 class WXDLLIMPEXP_SDK SearchThread : public WorkerThread
 {
     friend class SearchThreadST;
+    friend class SearchWorker;
     wxString m_wordChars;
     std::map<wxChar, bool> m_wordCharsMap; //< Internal
     SearchResultList m_results;
@@ -330,6 +334,8 @@ class WXDLLIMPEXP_SDK SearchThread : public WorkerThread
     wxRegEx m_regex;
     bool m_matchCase;
     wxCriticalSection m_cs;
+    size_t m_maxWorkers;
+    clLinearRegex m_linearRegex;
 
 private:
     /**
@@ -369,6 +375,13 @@ public:
      */
     void SetWordChars(const wxString& chars);
 
+    /**
+     * Set the maximum number of worker threads used to scan the files in parallel.
+     * The default is the number of CPUs. Passing 0 or 1 disables the parallel search
+     */
+    void SetMaxWorkers(size_t count) { m_maxWorkers = count; }
+    size_t GetMaxWorkers() const { return m_maxWorkers; }
+
 private:
     /**
      * Return files to search
@@ -391,8 +404,63 @@ private:
      */
     void DoSearchFiles(ThreadRequest* data);
 
-    // Perform search on a single file
-    void DoSearchFile(const wxString& fileName, const SearchData* data);
+    /**
+     * Scan the files one after the other from the search thread
+     */
+    void DoSearchFilesSerial(const wxArrayString& fileList, const SearchData* data);
+
+    /**
+     * Split the files between a pool of worker threads. The results are collected
+     * and reported back in the same order as 'fileList'
+     */
+    void DoSearchFilesParallel(const wxArrayString& fileList, const SearchData* data, size_t workersCount);
+
+    /**
+     * Report the matches found in a single file and update the search summary
+     */
+    void DoReportFileResults(const wxString& fileName, bool ok, SearchResultList& results, const SearchData* data);
+
+    /**
+     * Perform search on a single file, matches are appended to 'results'
+     * This function does not modify the thread state and can be called from the worker threads
+     * \return false if the file could not be read
+     */
+    bool DoSearchFile(const wxString& fileName, const SearchData* data, wxRegEx& re, SearchResultList& results);
+
+    enum { kBytesSearchOK, kBytesSearchFailed, kBytesSearchNotSupported };
+
+    /**
+     * Can 'data' be searched with DoSearchFileBytes?
+     */
+    bool CanSearchBytes(const SearchData* data) const;
+
+    /**
+     * Search a memory mapped UTF-8 file without converting it to wxString. Only the lines
+     * containing a match are converted
+     * \return kBytesSearchNotSupported if the content can not be handled at the byte level,
+     * in this case 'results' is left untouched
+     */
+    int DoSearchFileBytes(const wxString& fileName, const SearchData* data, SearchResultList& results);
+
+    /**
+     * Search a memory mapped UTF-8 file with the compiled linear time regex (m_linearRegex)
+     * \return kBytesSearchNotSupported if the file is not a valid UTF-8 file
+     */
+    int DoSearchFileRegexBytes(const wxString& fileName, const SearchData* data, SearchResultList& results);
+
+    // Add a match found by one of the byte matchers
+    void DoAddBytesMatch(const wxString& fileName,
+                         const SearchData* data,
+                         const wxString& line,
+                         const LineLocator& locator,
+                         const char* match,
+                         size_t matchLen,
+                         SearchResultList& results);
+
+    /**
+     * Split the find string into the string to search and the pipe filters
+     */
+    void GetFindStringAndFilters(const SearchData* data, wxString& findString, wxArrayString& filters);
 
     // Perform search on a line
     void DoSearchLine(const wxString& line,
@@ -402,7 +470,8 @@ private:
                       const SearchData* data,
                       const wxString& findWhat,
                       const wxArrayString& filters,
-                      TextStatesPtr statesPtr);
+                      TextStatesPtr statesPtr,
+                      SearchResultList& results);
 
     // Perform search on a line using regular expression
     void DoSearchLineRE(const wxString& line,
@@ -410,7 +479,9 @@ private:
                         const int lineOffset,
                         const wxString& fileName,
                         const SearchData* data,
-                        TextStatesPtr statesPtr);
+                        TextStatesPtr statesPtr,
+                        wxRegEx& re,
+                        SearchResultList& results);
 
     // Send an event to the notified window
     void SendEvent(wxEventType type, wxEvtHandler* owner);
@@ -423,6 +494,9 @@ private:
 
     // filter 'files' according to the files spec
     void FilterFiles(wxArrayString& files, const SearchData* data);
+
+    // remove files that can not contain a match according to the "Find In Files" index
+    void FilterFilesByIndex(wxArrayString& files, const SearchData* data);
 };
 
 class WXDLLIMPEXP_SDK SearchThreadST
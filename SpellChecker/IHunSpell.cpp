@@ -53,7 +53,7 @@
 #include "CorrectSpellingDlg.h"
 #include "spellcheck.h"
 // ------------------------------------------------------------
-#define MIN_TOKEN_LEN 3
+#define MAX_CACHED_WORDS 50000
 // ------------------------------------------------------------
 IHunSpell::IHunSpell()
 {
@@ -78,6 +78,7 @@ bool IHunSpell::InitEngine()
     // check if we are already initialized
     if(m_pSpell != NULL) return true;
 
+    wxCriticalSectionLocker locker(m_lock);
     // check base path
     if(!m_dicPath.IsEmpty() && !wxEndsWithPathSeparator(m_dicPath)) m_dicPath += wxFILE_SEP_PATH;
     // load user dict
@@ -103,6 +104,7 @@ bool IHunSpell::InitEngine()
     }
     // so far ok, init engine
     m_pSpell = Hunspell_create(affBuffer, dicBuffer);
+    m_cache.clear();
 
     return true;
 
@@ -112,20 +114,43 @@ bool IHunSpell::InitEngine()
 // ------------------------------------------------------------
 void IHunSpell::CloseEngine()
 {
+    wxCriticalSectionLocker locker(m_lock);
     if(m_pSpell != NULL) {
         Hunspell_destroy(m_pSpell);
         SaveUserDict(m_userDictPath + s_userDict);
     }
     m_pSpell = NULL;
+    m_cache.clear();
 }
 // ------------------------------------------------------------
-int IHunSpell::CheckWord(const wxString& word) { return Hunspell_spell(m_pSpell, word.ToUTF8()); }
+int IHunSpell::CheckWord(const wxString& word)
+{
+    wxCriticalSectionLocker locker(m_lock);
+    return Hunspell_spell(m_pSpell, word.ToUTF8());
+}
+// ------------------------------------------------------------
+bool IHunSpell::IsWordCorrect(const wxString& word)
+{
+    wxCriticalSectionLocker locker(m_lock);
+    if(m_pSpell == NULL) return true;
+
+    wordCacheMap::iterator iter = m_cache.find(word);
+    if(iter != m_cache.end()) return iter->second;
+
+    bool correct = Hunspell_spell(m_pSpell, word.ToUTF8()) || m_ignoreList.Index(word) != wxNOT_FOUND ||
+                   m_userDict.Index(word) != wxNOT_FOUND;
+
+    if(m_cache.size() >= MAX_CACHED_WORDS) m_cache.clear();
+    m_cache[word] = correct;
+    return correct;
+}
 // ------------------------------------------------------------
 wxArrayString IHunSpell::GetSuggestions(const wxString& misspelled)
 {
     wxArrayString suggestions;
     suggestions.Empty();
 
+    wxCriticalSectionLocker locker(m_lock);
     if(m_pSpell) {
         char** wlst;
 
@@ -162,57 +187,9 @@ void IHunSpell::CheckCppSpelling(const wxString& check)
 
         m_pSpellDlg->SetPHs(this);
     }
-    posLen query;
-
-    for(int i = 0; i < pEditor->GetLength(); i++) {
-        switch(pTextCtrl->GetStyleAt(i)) {
-        case SCT_STRING: {
-            query.first = i;
-
-            while(pTextCtrl->GetStyleAt(i++) == SCT_STRING)
-                ;
-            query.second = i;
-
-            if(IsScannerType(kString)) m_parseValues.push_back(make_pair(query, kString));
-        } break;
-        case SCT_CPP_COM: {
-            query.first = i;
-
-            while(pTextCtrl->GetStyleAt(i++) == SCT_CPP_COM)
-                ;
-            query.second = i;
-
-            if(IsScannerType(kCppComment)) m_parseValues.push_back(make_pair(query, kCppComment));
-        } break;
-        case SCT_C_COM: {
-            query.first = i;
-
-            while(pTextCtrl->GetStyleAt(i++) == SCT_C_COM)
-                ;
-            query.second = i;
-
-            if(IsScannerType(kCComment)) m_parseValues.push_back(make_pair(query, kCComment));
-        } break;
-        case SCT_DOX_1: {
-            query.first = i;
-
-            while(pTextCtrl->GetStyleAt(i++) == SCT_DOX_1)
-                ;
-            query.second = i;
-
-            if(IsScannerType(kDox1)) m_parseValues.push_back(make_pair(query, kDox1));
-        } break;
-        case SCT_DOX_2: {
-            query.first = i;
-
-            while(pTextCtrl->GetStyleAt(i++) == SCT_DOX_2)
-                ;
-            query.second = i;
-
-            if(IsScannerType(kDox2)) m_parseValues.push_back(make_pair(query, kDox2));
-        } break;
-        }
-    }
+    // get the styles of the whole document with a single call
+    wxMemoryBuffer styledText = pTextCtrl->GetStyledText(0, pTextCtrl->GetLength());
+    GetStyleRuns(static_cast<const char*>(styledText.GetData()), styledText.GetDataLen(), 0, m_scanners, m_parseValues);
     int errors = 0;
 
     if(!m_pPlugIn->GetCheckContinuous()) {
@@ -321,14 +298,25 @@ void IHunSpell::AddWordToIgnoreList(const wxString& word)
 {
     if(word.IsEmpty()) return;
 
+    wxCriticalSectionLocker locker(m_lock);
     if(m_ignoreList.Index(word) == wxNOT_FOUND) m_ignoreList.Add(word);
+    m_cache[word] = true;
 }
 // ------------------------------------------------------------
 void IHunSpell::AddWordToUserDict(const wxString& word)
 {
     if(word.IsEmpty()) return;
 
+    wxCriticalSectionLocker locker(m_lock);
     if(m_userDict.Index(word) == wxNOT_FOUND) m_userDict.Add(word);
+    m_cache[word] = true;
+}
+// ------------------------------------------------------------
+void IHunSpell::ClearIgnoreList()
+{
+    wxCriticalSectionLocker locker(m_lock);
+    m_ignoreList.Clear();
+    m_cache.clear();
 }
 // ------------------------------------------------------------
 bool IHunSpell::LoadUserDict(const wxString& filename)
@@ -481,6 +469,44 @@ void IHunSpell::EnableScannerType(int type, bool state)
         m_scanners &= ~type;
 }
 // ------------------------------------------------------------
+void IHunSpell::GetStyleRuns(const char* styledText, size_t len, int startPos, int scanners, partList& runs)
+{
+    // the buffer holds a (character, style) pair per position
+    size_t count = len / 2;
+    size_t i = 0;
+    while(i < count) {
+        unsigned char style = styledText[2 * i + 1];
+        size_t runEnd = i + 1;
+        while(runEnd < count && (unsigned char)styledText[2 * runEnd + 1] == style) {
+            ++runEnd;
+        }
+
+        int type = 0;
+        switch(style) {
+        case SCT_STRING:
+            type = kString;
+            break;
+        case SCT_CPP_COM:
+            type = kCppComment;
+            break;
+        case SCT_C_COM:
+            type = kCComment;
+            break;
+        case SCT_DOX_1:
+            type = kDox1;
+            break;
+        case SCT_DOX_2:
+            type = kDox2;
+            break;
+        }
+
+        if(type && (scanners & type)) {
+            runs.push_back(std::make_pair(posLen(startPos + i, startPos + runEnd), type));
+        }
+        i = runEnd;
+    }
+}
+// ------------------------------------------------------------
 int IHunSpell::CheckCppType(IEditor* pEditor)
 {
     wxStringTokenizer tkz;
@@ -631,6 +657,8 @@ int IHunSpell::MarkErrors(IEditor* pEditor)
 
 void IHunSpell::AddWord(const wxString& word)
 {
+    wxCriticalSectionLocker locker(m_lock);
+    m_cache[word] = true;
 #if wxUSE_STL
     // Implict conversions are disabled when building with wxUSE_STL=1
     Hunspell_add(m_pSpell, word.mb_str().data());
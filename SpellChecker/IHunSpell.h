@@ -38,10 +38,12 @@
 // ------------------------------------------------------------
 #include <hunspell/hunspell.h>
 #include <wx/hashmap.h>
+#include <wx/thread.h>
 #include <vector>
 #include <utility>
 // ------------------------------------------------------------
 WX_DECLARE_STRING_HASH_MAP(wxString, languageMap);
+WX_DECLARE_STRING_HASH_MAP(bool, wordCacheMap);
 typedef std::pair<int, int> posLen;
 typedef std::pair<posLen, int> parseEntry;
 typedef std::vector<parseEntry> partList;
@@ -57,7 +59,7 @@ public:
     virtual ~IHunSpell();
 
     /// Clears the ignore list
-    void ClearIgnoreList() { m_ignoreList.Clear(); }
+    void ClearIgnoreList();
     /// initializes spelling engine. This will be done automatic on the first check.
     bool InitEngine();
     /// close the engine. The engine must be closed before a new init or when the program finishes.
@@ -66,6 +68,8 @@ public:
     bool ChangeLanguage(const wxString& language);
     /// check spelling for one word. Return 0 if the word was not found, otherwise != 0.
     int CheckWord(const wxString& word);
+    /// returns true if the word is found, ignored or in the user dictionary. The results are cached. Thread safe.
+    bool IsWordCorrect(const wxString& word);
     /// returns an array with suggestions for the misspelled word.
     wxArrayString GetSuggestions(const wxString& misspelled);
     /// makes a spell check for the given cpp text. Canceled is set to true when the user cancels.
@@ -98,6 +102,11 @@ public:
     void EnableScannerType(int type, bool state);
     /// checks if type is set
     bool IsScannerType(int type) { return (m_scanners & type); }
+    /// returns the enabled scanner types
+    int GetScanners() const { return m_scanners; }
+    /// splits styled text (character/style pairs as returned by wxStyledTextCtrl::GetStyledText)
+    /// into the runs of the enabled scanner types. 'startPos' is the position of the first character
+    static void GetStyleRuns(const char* styledText, size_t len, int startPos, int scanners, partList& runs);
 
     void AddWordToUserDict(const wxString& word);
 
@@ -147,5 +156,8 @@ protected:
     partList m_parseValues; // list with position results for CPP parsing
 
     int m_scanners; // flags for scanner types
+
+    wxCriticalSection m_lock; // protects the engine, the word lists and the cache (see IsWordCorrect)
+    wordCacheMap m_cache;     // word -> correct
 };
 #endif // _HUNSPELLINTERFACE_
@@ -0,0 +1,136 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : SpellCheckThread.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "SpellCheckThread.h"
+#include "spellcheck.h"
+#include "scGlobals.h"
+#include <wx/regex.h>
+
+SpellCheckThread::SpellCheckThread(SpellCheck* plugin, IHunSpell* engine)
+    : m_plugin(plugin)
+    , m_engine(engine)
+{
+}
+
+SpellCheckThread::~SpellCheckThread() {}
+
+void SpellCheckThread::ProcessRequest(ThreadRequest* request)
+{
+    SpellCheckRequest* req = dynamic_cast<SpellCheckRequest*>(request);
+    if(!req) return;
+
+    SpellCheckReply reply;
+    reply.requestId = req->requestId;
+    reply.generation = req->generation;
+
+    wxRegEx reHex(s_dectHex, wxRE_ADVANCED);
+    for(size_t i = 0; i < req->ranges.size(); ++i) {
+        const SpellCheckRequest::Range& range = req->ranges.at(i);
+        const std::string& styledText = range.styledText;
+
+        std::string text(styledText.length() / 2, ' ');
+        for(size_t n = 0; n < text.length(); ++n) {
+            text[n] = styledText[2 * n];
+        }
+
+        partList runs;
+        if(req->cppStyles) {
+            IHunSpell::GetStyleRuns(styledText.c_str(), styledText.length(), 0, req->scanners, runs);
+        } else if(!text.empty()) {
+            // plain text: check everything
+            runs.push_back(std::make_pair(posLen(0, text.length()), 0));
+        }
+
+        for(size_t n = 0; n < runs.size(); ++n) {
+            DoCheckRun(text, runs.at(n), range.start, reHex, reply.errors);
+        }
+        reply.ranges.push_back(posLen(range.start, range.start + text.length()));
+    }
+    m_plugin->CallAfter(&SpellCheck::OnSpellCheckDone, reply);
+}
+
+void SpellCheckThread::DoCheckRun(const std::string& text,
+                                  const parseEntry& run,
+                                  int offset,
+                                  wxRegEx& reHex,
+                                  std::vector<posLen>& errors)
+{
+    int start = run.first.first;
+    int end = run.first.second;
+
+    // characters that are not part of a word, in addition to the delimiters
+    std::vector<bool> skip(end - start, false);
+    const wxString* delimiters = &s_defDelimiters;
+    if(run.second == IHunSpell::kString) {
+        // ignore the file names in #include
+        size_t lineStart = text.rfind('\n', start);
+        lineStart = (lineStart == std::string::npos) ? 0 : lineStart + 1;
+        size_t lineEnd = text.find('\n', start);
+        if(text.substr(lineStart, lineEnd - lineStart).find(s_include.mb_str().data()) != std::string::npos) return;
+
+        // escape sequences separate words ("\nNext line"), "\\" is a backslash
+        bool hasEscape = false;
+        for(int i = start; i < end; ++i) {
+            if(text[i] != '\\') continue;
+            if(i + 1 < end && text[i + 1] != '\\') {
+                skip[i - start] = skip[i + 1 - start] = true;
+                hasEscape = true;
+            }
+            ++i;
+        }
+        delimiters = hasEscape ? &s_cppDelimiters : &s_commentDelimiters;
+
+    } else if(run.second != 0) {
+        delimiters = &s_commentDelimiters;
+    }
+
+    // the delimiters are all ASCII, so the text can be split without decoding it
+    bool isDelimiter[256] = { false };
+    for(size_t i = 0; i < delimiters->length(); ++i) {
+        isDelimiter[(unsigned char)(*delimiters)[i].GetValue()] = true;
+    }
+
+    int i = start;
+    while(i < end) {
+        while(i < end && (skip[i - start] || isDelimiter[(unsigned char)text[i]])) {
+            ++i;
+        }
+        int tokenStart = i;
+        while(i < end && !(skip[i - start] || isDelimiter[(unsigned char)text[i]])) {
+            ++i;
+        }
+        if(i == tokenStart) break;
+
+        wxString token = wxString::FromUTF8(text.c_str() + tokenStart, i - tokenStart);
+        if(token.Len() <= MIN_TOKEN_LEN) continue;
+
+        // see if hex number
+        if(token.GetChar(0) == '0' && reHex.Matches(token)) continue;
+
+        if(!m_engine->IsWordCorrect(token)) {
+            errors.push_back(posLen(offset + tokenStart, i - tokenStart));
+        }
+    }
+}
@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : SpellCheckThread.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPELLCHECKTHREAD_H
+#define SPELLCHECKTHREAD_H
+
+#include "worker_thread.h"
+#include "IHunSpell.h"
+#include <string>
+#include <vector>
+
+class SpellCheck;
+class wxRegEx;
+
+/**
+ * @brief a request to check ranges of the active editor
+ */
+class SpellCheckRequest : public ThreadRequest
+{
+public:
+    struct Range {
+        int start;              // the position of the first character
+        std::string styledText; // character/style pairs, as returned by wxStyledTextCtrl::GetStyledText
+    };
+
+    size_t requestId;
+    size_t generation;
+    bool cppStyles; // check only the strings and comments (see IHunSpell::GetStyleRuns)
+    int scanners;
+    std::vector<Range> ranges;
+
+    SpellCheckRequest()
+        : requestId(0)
+        , generation(0)
+        , cppStyles(false)
+        , scanners(0)
+    {
+    }
+    virtual ~SpellCheckRequest() {}
+};
+
+struct SpellCheckReply {
+    size_t requestId;
+    size_t generation;
+    std::vector<posLen> ranges; // the checked ranges (start, end)
+    std::vector<posLen> errors; // the misspelled words (position, length)
+
+    SpellCheckReply()
+        : requestId(0)
+        , generation(0)
+    {
+    }
+};
+
+/**
+ * @class SpellCheckThread
+ * @brief tokenizes the requested ranges and looks up the words in the background. The results are
+ * sent back to the plugin with SpellCheck::OnSpellCheckDone
+ */
+class SpellCheckThread : public WorkerThread
+{
+    SpellCheck* m_plugin;
+    IHunSpell* m_engine;
+
+protected:
+    void DoCheckRun(
+        const std::string& text, const parseEntry& run, int offset, wxRegEx& reHex, std::vector<posLen>& errors);
+
+public:
+    SpellCheckThread(SpellCheck* plugin, IHunSpell* engine);
+    virtual ~SpellCheckThread();
+    virtual void ProcessRequest(ThreadRequest* request);
+};
+
+#endif // SPELLCHECKTHREAD_H
@@ -34,6 +34,8 @@
 // License:
 /////////////////////////////////////////////////////////////////////////////
 //------------------------------------------------------------
+#define MIN_TOKEN_LEN 3
+//------------------------------------------------------------
 static const wxString s_plugName( wxT( "SpellCheck" ) );
 static const wxString s_spOptions( wxT( "SpellCheckOptions" ) );
 static const wxString s_noEditor( wxT( "There is no active editor\n" ) );
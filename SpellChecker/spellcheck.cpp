@@ -45,11 +45,13 @@
 #include "scGlobals.h"
 #include "IHunSpell.h"
 #include "SpellCheckerSettings.h"
+#include "SpellCheckThread.h"
 
 #include <wx/mstream.h>
 #include <wx/xrc/xmlres.h>
 #include <wx/tokenzr.h>
 #include <wx/stc/stc.h>
+#include <algorithm>
 
 #include "res/spellcheck16.b2c"
 #include "res/spellcheck22.b2c"
@@ -59,6 +61,7 @@
 static SpellCheck* thePlugin = NULL;
 #define SPC_BASEID 10000
 #define PARSE_TIME 500
+#define SPC_INDICATOR 3 // the editor's user indicator (IEditor::SetUserIndicator)
 // ------------------------------------------------------------
 // Define the plugin entry point
 CL_PLUGIN_API IPlugin* CreatePlugin(IManager* manager)
@@ -81,6 +84,38 @@ CL_PLUGIN_API PluginInfo* GetPluginInfo()
 // ------------------------------------------------------------
 CL_PLUGIN_API int GetPluginInterfaceVersion() { return PLUGIN_INTERFACE_VERSION; }
 // ------------------------------------------------------------
+// adds 'range' to the sorted 'ranges', merging it with the ranges it touches
+static void AddRange(std::vector<posLen>& ranges, posLen range)
+{
+    std::vector<posLen>::iterator iter = ranges.begin();
+    while(iter != ranges.end()) {
+        if(iter->second < range.first || iter->first > range.second) {
+            ++iter;
+            continue;
+        }
+        range.first = wxMin(range.first, iter->first);
+        range.second = wxMax(range.second, iter->second);
+        iter = ranges.erase(iter);
+    }
+    ranges.insert(std::upper_bound(ranges.begin(), ranges.end(), range), range);
+}
+// ------------------------------------------------------------
+// moves the ranges after the text inserted (length > 0) or deleted (length < 0) at 'pos'
+static void ShiftRanges(std::vector<posLen>& ranges, int pos, int length)
+{
+    for(size_t i = 0; i < ranges.size(); ++i) {
+        int* bounds[] = { &ranges[i].first, &ranges[i].second };
+        for(size_t n = 0; n < 2; ++n) {
+            int& x = *bounds[n];
+            if(length > 0) {
+                if(x > pos || (n == 1 && x == pos)) x += length;
+            } else if(x > pos) {
+                x = (x >= pos - length) ? (x + length) : pos;
+            }
+        }
+    }
+}
+// ------------------------------------------------------------
 SpellCheck::SpellCheck(IManager* manager)
     : IPlugin(manager)
 {
@@ -104,6 +139,10 @@ SpellCheck::~SpellCheck()
     m_timer.Disconnect(wxEVT_TIMER, wxTimerEventHandler(SpellCheck::OnTimer), NULL, this);
     m_topWin->Disconnect(wxEVT_CMD_EDITOR_CONTEXT_MENU, wxCommandEventHandler(SpellCheck::OnContextMenu), NULL, this);
     m_topWin->Disconnect(wxEVT_WORKSPACE_CLOSED, wxCommandEventHandler(SpellCheck::OnWspClosed), NULL, this);
+    if(m_thread) {
+        m_thread->Stop();
+        wxDELETE(m_thread);
+    }
     if(m_pEngine != NULL) wxDELETE(m_pEngine);
 }
 
@@ -120,6 +159,12 @@ void SpellCheck::Init()
     m_checkContinuous = false;
     m_pEngine = new IHunSpell();
     m_currentWspPath = wxEmptyString;
+    m_thread = NULL;
+    m_watchedCtrl = NULL;
+    m_checkedLines = posLen(wxNOT_FOUND, wxNOT_FOUND);
+    m_generation = 0;
+    m_requestCounter = 0;
+    m_pendingRequestId = 0;
 
     if(m_pEngine) {
         LoadSettings();
@@ -132,12 +177,17 @@ void SpellCheck::Init()
         m_pEngine->SetPlugIn(this);
 
         if(!m_options.GetDictionaryFileName().IsEmpty()) m_pEngine->InitEngine();
+
+        m_thread = new SpellCheckThread(this, m_pEngine);
+        m_thread->Start();
     }
     m_timer.Connect(wxEVT_TIMER, wxTimerEventHandler(SpellCheck::OnTimer), NULL, this);
     m_topWin->Connect(wxEVT_CMD_EDITOR_CONTEXT_MENU, wxCommandEventHandler(SpellCheck::OnContextMenu), NULL, this);
     m_topWin->Connect(wxEVT_WORKSPACE_LOADED, wxCommandEventHandler(SpellCheck::OnWspLoaded), NULL, this);
     m_topWin->Connect(wxEVT_WORKSPACE_CLOSED, wxCommandEventHandler(SpellCheck::OnWspClosed), NULL, this);
     EventNotifier::Get()->Bind(wxEVT_CONTEXT_MENU_EDITOR, &SpellCheck::OnEditorContextMenuShowing, this);
+    EventNotifier::Get()->Bind(wxEVT_EDITOR_CLOSING, &SpellCheck::OnEditorClosing, this);
+    EventNotifier::Get()->Bind(wxEVT_ALL_EDITORS_CLOSING, &SpellCheck::OnAllEditorsClosing, this);
 }
 // ------------------------------------------------------------
 clToolBar* SpellCheck::CreateToolBar(wxWindow* parent)
@@ -213,7 +263,14 @@ void SpellCheck::UnHookPopupMenu(wxMenu* menu, MenuType type)
 void SpellCheck::UnPlug()
 {
     EventNotifier::Get()->Unbind(wxEVT_CONTEXT_MENU_EDITOR, &SpellCheck::OnEditorContextMenuShowing, this);
+    EventNotifier::Get()->Unbind(wxEVT_EDITOR_CLOSING, &SpellCheck::OnEditorClosing, this);
+    EventNotifier::Get()->Unbind(wxEVT_ALL_EDITORS_CLOSING, &SpellCheck::OnAllEditorsClosing, this);
     if(m_timer.IsRunning()) m_timer.Stop();
+    DoUnwatchEditor();
+    if(m_thread) {
+        m_thread->Stop();
+        wxDELETE(m_thread);
+    }
 }
 
 // ------------------------------------------------------------
@@ -335,7 +392,6 @@ void SpellCheck::OnContinousCheck(wxCommandEvent& e)
         }
 
         SetCheckContinuous(true);
-        wxString text = editor->GetEditorText();
 
         // if we don't have a dictionary yet, open settings
         if(!m_pEngine->GetDictionary()) {
@@ -343,16 +399,9 @@ void SpellCheck::OnContinousCheck(wxCommandEvent& e)
             return;
         }
 
-        switch(editor->GetLexerId()) {
-        case 3: { // wxSCI_LEX_CPP
-            if(m_mgr->IsWorkspaceOpen()) {
-                m_pEngine->CheckCppSpelling(text);
-            }
-        } break;
-        default: { // wxSCI_LEX_NULL
-            m_pEngine->CheckSpelling(text);
-        } break;
-        }
+        // check the visible lines now, the changes are checked by the timer
+        DoUnwatchEditor();
+        DoIncrementalCheck(editor);
         m_timer.Start(PARSE_TIME);
     }
 }
@@ -368,19 +417,157 @@ void SpellCheck::OnTimer(wxTimerEvent& e)
     if(!editor) return;
 
     if(GetCheckContinuous()) {
-        switch(editor->GetLexerId()) {
-        case 3: { // wxSCI_LEX_CPP
-            if(m_mgr->IsWorkspaceOpen()) {
-                m_pEngine->CheckCppSpelling(editor->GetEditorText());
-            }
-        } break;
-        default: { // wxSCI_LEX_NULL
-            m_pEngine->CheckSpelling(editor->GetEditorText());
-        } break;
+        DoIncrementalCheck(editor);
+    }
+}
+// ------------------------------------------------------------
+void SpellCheck::DoIncrementalCheck(IEditor* editor)
+{
+    bool cppStyles = (editor->GetLexerId() == 3); // wxSCI_LEX_CPP
+    if(cppStyles && !m_mgr->IsWorkspaceOpen()) return;
+
+    if(!m_thread || !m_pEngine->InitEngine()) return;
+
+    wxStyledTextCtrl* ctrl = editor->GetCtrl();
+    if(ctrl != m_watchedCtrl) {
+        DoWatchEditor(ctrl);
+    }
+
+    // wait for the previous request
+    if(m_pendingRequestId) return;
+
+    // the visible lines are checked whenever they change (e.g. the editor was scrolled)
+    int firstLine = ctrl->DocLineFromVisible(ctrl->GetFirstVisibleLine());
+    int lastLine = ctrl->DocLineFromVisible(ctrl->GetFirstVisibleLine() + ctrl->LinesOnScreen());
+    if(m_checkedLines != posLen(firstLine, lastLine)) {
+        AddRange(m_dirtyRanges, posLen(ctrl->PositionFromLine(firstLine), ctrl->GetLineEndPosition(lastLine)));
+        m_checkedLines = posLen(firstLine, lastLine);
+    }
+
+    if(m_dirtyRanges.empty()) return;
+
+    // check whole lines: the change may have split or joined words
+    std::vector<posLen> lines;
+    for(size_t i = 0; i < m_dirtyRanges.size(); ++i) {
+        int start = ctrl->PositionFromLine(ctrl->LineFromPosition(m_dirtyRanges.at(i).first));
+        int end = ctrl->GetLineEndPosition(ctrl->LineFromPosition(m_dirtyRanges.at(i).second));
+        AddRange(lines, posLen(start, end));
+    }
+    m_dirtyRanges.clear();
+
+    SpellCheckRequest* req = new SpellCheckRequest();
+    req->requestId = ++m_requestCounter;
+    req->generation = m_generation;
+    req->cppStyles = cppStyles;
+    req->scanners = m_pEngine->GetScanners();
+    for(size_t i = 0; i < lines.size(); ++i) {
+        // the text and the styles are copied with a single call
+        wxMemoryBuffer styledText = ctrl->GetStyledText(lines.at(i).first, lines.at(i).second);
+        SpellCheckRequest::Range range;
+        range.start = lines.at(i).first;
+        range.styledText.assign(static_cast<const char*>(styledText.GetData()), styledText.GetDataLen());
+        req->ranges.push_back(range);
+    }
+
+    m_pendingRequestId = req->requestId;
+    m_pendingRanges.swap(lines);
+    m_thread->Add(req);
+}
+// ------------------------------------------------------------
+void SpellCheck::OnSpellCheckDone(const SpellCheckReply& reply)
+{
+    // a reply for an editor we no longer watch
+    if(reply.requestId != m_pendingRequestId) return;
+    m_pendingRequestId = 0;
+
+    if(!m_watchedCtrl || reply.generation != m_generation) {
+        // the text was changed while it was checked, check these lines again
+        for(size_t i = 0; i < m_pendingRanges.size(); ++i) {
+            AddRange(m_dirtyRanges, m_pendingRanges.at(i));
         }
+        m_pendingRanges.clear();
+        return;
+    }
+    m_pendingRanges.clear();
+
+    m_watchedCtrl->SetIndicatorCurrent(SPC_INDICATOR);
+    for(size_t i = 0; i < reply.ranges.size(); ++i) {
+        const posLen& range = reply.ranges.at(i);
+        m_watchedCtrl->IndicatorClearRange(range.first, range.second - range.first);
+    }
+    for(size_t i = 0; i < reply.errors.size(); ++i) {
+        m_watchedCtrl->IndicatorFillRange(reply.errors.at(i).first, reply.errors.at(i).second);
     }
 }
 // ------------------------------------------------------------
+void SpellCheck::OnEditorModified(wxStyledTextEvent& e)
+{
+    e.Skip();
+    int type = e.GetModificationType();
+    int pos = e.GetPosition();
+    int length = e.GetLength();
+
+    if(type & wxSTC_MOD_INSERTTEXT) {
+        ShiftRanges(m_dirtyRanges, pos, length);
+        ShiftRanges(m_pendingRanges, pos, length);
+        AddRange(m_dirtyRanges, posLen(pos, pos + length));
+        ++m_generation;
+
+    } else if(type & wxSTC_MOD_DELETETEXT) {
+        ShiftRanges(m_dirtyRanges, pos, -length);
+        ShiftRanges(m_pendingRanges, pos, -length);
+        AddRange(m_dirtyRanges, posLen(pos, pos));
+        ++m_generation;
+
+    } else if((type & wxSTC_MOD_CHANGESTYLE) && m_watchedCtrl) {
+        // restyled text (e.g. a comment was opened) is checked now if it is visible, otherwise once it is scrolled
+        // into view
+        int firstLine = m_watchedCtrl->DocLineFromVisible(m_watchedCtrl->GetFirstVisibleLine());
+        int lastLine =
+            m_watchedCtrl->DocLineFromVisible(m_watchedCtrl->GetFirstVisibleLine() + m_watchedCtrl->LinesOnScreen());
+        int start = wxMax(pos, m_watchedCtrl->PositionFromLine(firstLine));
+        int end = wxMin(pos + length, m_watchedCtrl->GetLineEndPosition(lastLine));
+        if(start <= end) {
+            AddRange(m_dirtyRanges, posLen(start, end));
+        }
+    }
+}
+// ------------------------------------------------------------
+void SpellCheck::DoWatchEditor(wxStyledTextCtrl* ctrl)
+{
+    DoUnwatchEditor();
+    m_watchedCtrl = ctrl;
+    m_watchedCtrl->Bind(wxEVT_STC_MODIFIED, &SpellCheck::OnEditorModified, this);
+}
+// ------------------------------------------------------------
+void SpellCheck::DoUnwatchEditor()
+{
+    if(m_watchedCtrl) {
+        m_watchedCtrl->Unbind(wxEVT_STC_MODIFIED, &SpellCheck::OnEditorModified, this);
+        m_watchedCtrl = NULL;
+    }
+    m_dirtyRanges.clear();
+    m_pendingRanges.clear();
+    m_checkedLines = posLen(wxNOT_FOUND, wxNOT_FOUND);
+    m_pendingRequestId = 0;
+    ++m_generation;
+}
+// ------------------------------------------------------------
+void SpellCheck::OnEditorClosing(wxCommandEvent& e)
+{
+    e.Skip();
+    IEditor* editor = reinterpret_cast<IEditor*>(e.GetClientData());
+    if(editor && editor->GetCtrl() == m_watchedCtrl) {
+        DoUnwatchEditor();
+    }
+}
+// ------------------------------------------------------------
+void SpellCheck::OnAllEditorsClosing(wxCommandEvent& e)
+{
+    e.Skip();
+    DoUnwatchEditor();
+}
+// ------------------------------------------------------------
 void SpellCheck::OnContextMenu(wxCommandEvent& e)
 {
     IEditor* editor = GetEditor();
@@ -394,7 +581,7 @@ void SpellCheck::OnContextMenu(wxCommandEvent& e)
     pt = editor->GetCtrl()->ScreenToClient(pt);
     int pos = editor->GetCtrl()->PositionFromPoint(pt);
 
-    if(editor->GetCtrl()->IndicatorValueAt(3, pos) == 1) {
+    if(editor->GetCtrl()->IndicatorValueAt(SPC_INDICATOR, pos) == 1) {
         wxMenu popUp;
         m_timer.Stop();
 
@@ -426,6 +613,9 @@ void SpellCheck::OnContextMenu(wxCommandEvent& e)
                     m_pEngine->AddWordToIgnoreList(sel);
                 else if(index == SPC_BASEID - 2)
                     m_pEngine->AddWordToUserDict(sel);
+
+                // check the visible lines again
+                m_checkedLines = posLen(wxNOT_FOUND, wxNOT_FOUND);
             }
         }
         m_timer.Start(PARSE_TIME);
@@ -445,6 +635,7 @@ void SpellCheck::SetCheckContinuous(bool value)
         }
     } else {
         if(m_timer.IsRunning()) m_timer.Stop();
+        DoUnwatchEditor();
 
         if(m_pToolbar) {
             m_pToolbar->ToggleTool(XRCID(s_contCheckID.ToUTF8()), false);
@@ -39,9 +39,12 @@
 #include "plugin.h"
 #include "spellcheckeroptions.h"
 #include <wx/timer.h>
+#include <wx/stc/stc.h>
 #include "cl_command_event.h"
+#include "IHunSpell.h"
 //------------------------------------------------------------
-class IHunSpell;
+class SpellCheckThread;
+struct SpellCheckReply;
 class SpellCheck : public IPlugin
 {
 public:
@@ -73,6 +76,11 @@ public:
     void OnWspLoaded(wxCommandEvent& e);
     void OnWspClosed(wxCommandEvent& e);
     void OnEditorContextMenuShowing(clContextMenuEvent& e);
+    void OnEditorModified(wxStyledTextEvent& e);
+    void OnEditorClosing(wxCommandEvent& e);
+    void OnAllEditorsClosing(wxCommandEvent& e);
+    /// called by the spell check thread with the misspelled words of the checked ranges
+    void OnSpellCheckDone(const SpellCheckReply& reply);
 
     wxMenuItem* m_sepItem;
     wxEvtHandler* m_topWin;
@@ -86,12 +94,25 @@ protected:
     void SaveSettings();
     void ClearIndicatorsFromEditors();
 
+    // continuous check: only the changed and the visible lines are checked, in the background
+    void DoIncrementalCheck(IEditor* editor);
+    void DoWatchEditor(wxStyledTextCtrl* ctrl);
+    void DoUnwatchEditor();
+
 protected:
     bool m_checkContinuous;
     IHunSpell* m_pEngine;
     wxTimer m_timer;
     wxString m_currentWspPath;
     wxAuiToolBar* m_pToolbar;
+    SpellCheckThread* m_thread;
+    wxStyledTextCtrl* m_watchedCtrl;    // the editor checked continuously
+    std::vector<posLen> m_dirtyRanges;  // ranges changed since they were checked (start, end)
+    std::vector<posLen> m_pendingRanges; // ranges sent to the thread
+    posLen m_checkedLines;              // the visible lines, when they were checked
+    size_t m_generation;                // incremented whenever the text changes
+    size_t m_requestCounter;
+    size_t m_pendingRequestId; // the request sent to the thread, 0 if none
 };
 //------------------------------------------------------------
 #endif // SpellCheck
@@ -20,9 +20,6 @@
 #include <wx/checkbox.h>
 #include <wx/button.h>
 #include <wx/gauge.h>
-#include <wx/dialog.h>
-#include <wx/iconbndl.h>
-#include <wx/filepicker.h>
 #if wxVERSION_NUMBER >= 2900
 #include <wx/persist.h>
 #include <wx/persist/toplevel.h>
@@ -37,7 +34,6 @@ protected:
     wxStaticText* m_staticText2;
     wxChoice* m_choiceSearchScope;
     wxCheckBox* m_checkBoxUpdateDb;
-    wxCheckBox* m_checkBoxRevertedIndex;
     wxButton* m_buttonUpdateDbNow;
     wxButton* m_buttonClear;
     wxGauge* m_gauge;
@@ -55,7 +51,6 @@ public:
     wxStaticText* GetStaticText2() { return m_staticText2; }
     wxChoice* GetChoiceSearchScope() { return m_choiceSearchScope; }
     wxCheckBox* GetCheckBoxUpdateDb() { return m_checkBoxUpdateDb; }
-    wxCheckBox* GetCheckBoxRevertedIndex() { return m_checkBoxRevertedIndex; }
     wxButton* GetButtonUpdateDbNow() { return m_buttonUpdateDbNow; }
     wxButton* GetButtonClear() { return m_buttonClear; }
     wxGauge* GetGauge() { return m_gauge; }
@@ -64,22 +59,4 @@ public:
 };
 
 
-class CScopeSettingsDlgBase : public wxDialog
-{
-protected:
-    wxStaticText* m_staticText20;
-    wxFilePickerCtrl* m_filePickerCScopeExe;
-    wxStdDialogButtonSizer* m_stdBtnSizer12;
-    wxButton* m_button14;
-    wxButton* m_button16;
-
-protected:
-
-public:
-    wxStaticText* GetStaticText20() { return m_staticText20; }
-    wxFilePickerCtrl* GetFilePickerCScopeExe() { return m_filePickerCScopeExe; }
-    CScopeSettingsDlgBase(wxWindow* parent, wxWindowID id = wxID_ANY, const wxString& title = _("CScope Settings"), const wxPoint& pos = wxDefaultPosition, const wxSize& size = wxSize(-1,-1), long style = wxDEFAULT_DIALOG_STYLE|wxRESIZE_BORDER);
-    virtual ~CScopeSettingsDlgBase();
-};
-
 #endif
@@ -0,0 +1,1311 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : CscopeXRefIndex.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "CscopeXRefIndex.h"
+#include "CxxLexerAPI.h"
+#include "CxxScannerTokens.h"
+#include <algorithm>
+#include <set>
+#include <string.h>
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/thread.h>
+
+// Don't start a parser worker for less than this number of files
+#define XREF_MIN_FILES_PER_WORKER 20
+
+// Bump this whenever the on-disk layout or the parser output changes
+#define XREF_DB_MAGIC "CLXR"
+#define XREF_DB_VERSION 2
+
+// The longest source line displayed next to a match
+#define XREF_MAX_LINE_LENGTH 1024
+
+namespace
+{
+//===--------------------------------------------------------------------===//
+// Serialization helpers
+//===--------------------------------------------------------------------===//
+
+void WriteU32(std::string& buffer, wxUint32 value) { buffer.append((const char*)&value, sizeof(value)); }
+
+void WriteString(std::string& buffer, const std::string& str)
+{
+    WriteU32(buffer, str.length());
+    buffer.append(str);
+}
+
+bool ReadU32(const char*& p, const char* end, wxUint32& value)
+{
+    if((size_t)(end - p) < sizeof(value)) return false;
+    memcpy(&value, p, sizeof(value));
+    p += sizeof(value);
+    return true;
+}
+
+bool ReadString(const char*& p, const char* end, std::string& str)
+{
+    wxUint32 len;
+    if(!ReadU32(p, end, len) || (size_t)(end - p) < len) return false;
+    str.assign(p, len);
+    p += len;
+    return true;
+}
+
+//===--------------------------------------------------------------------===//
+// XRefFileParser: a heuristic C/C++ parser that collects the cross reference
+// records of a single file from the CxxLexer token stream
+//===--------------------------------------------------------------------===//
+
+class XRefFileParser
+{
+    enum eScope {
+        kScopeNone = -1,
+        kScopeNamespace,
+        kScopeClass,
+        kScopeEnum,
+        kScopeFunction,
+        kScopeBlock,
+    };
+
+    enum eCandidate {
+        kCandidateNone,       // no function definition in sight
+        kCandidateParams,     // inside the parameter list of 'name('
+        kCandidateAfterParams, // after the closing ')': cv qualifiers, noexcept, trailing return type...
+        kCandidateInitList,   // in the member initializer list of a constructor
+    };
+
+    struct Conditional {
+        bool inactive; // the current branch is ignored by the structure tracking
+        bool taken;    // one of the branches of this #if was followed
+    };
+
+    CscopeXRefIndex::ParsedFile& m_file;
+    std::map<std::string, wxUint32> m_ids;
+
+    // references are collected once per line
+    int m_refLine;
+    std::set<wxUint32> m_lineRefs;
+
+    // the scopes and the function whose body is being parsed
+    std::vector<int> m_scopes;
+    size_t m_functionDepth;
+    wxUint32 m_function;
+
+    // the previous tokens
+    int m_prevType;
+    int m_prevPrevType;
+    std::string m_prevText;
+    int m_prevLine;
+
+    // pre processor state
+    bool m_inPreProcessor;
+    int m_ppPrevType;
+    std::vector<Conditional> m_conditionals;
+
+    // the current statement outside of function bodies
+    int m_parenDepth;
+    int m_angleDepth;
+    int m_statementTokens;
+    int m_statementFirst;
+    bool m_skipStatement;
+    bool m_inInitializer;
+
+    // a class/struct/union/enum/namespace whose body is expected
+    int m_pending;
+    bool m_pendingBases;
+    std::string m_pendingName;
+    int m_pendingLine;
+
+    // typedef
+    bool m_typedef;
+    size_t m_typedefDepth;
+    std::string m_typedefName;
+    int m_typedefLine;
+    std::string m_typedefPtrName;
+    int m_typedefPtrLine;
+
+    // function definition candidate
+    int m_candidate;
+    std::string m_candidateName;
+    int m_candidateLine;
+    bool m_trailingReturn;
+    int m_initBraceDepth;
+
+    // operator name: 0 - none, 1 - collecting its name, 2 - after "operator("
+    int m_operator;
+    std::string m_operatorName;
+    int m_operatorLine;
+
+public:
+    XRefFileParser(CscopeXRefIndex::ParsedFile& file)
+        : m_file(file)
+        , m_refLine(-1)
+        , m_functionDepth(0)
+        , m_function(CscopeXRefIndex::kNoSymbol)
+        , m_prevType(0)
+        , m_prevPrevType(0)
+        , m_prevLine(0)
+        , m_inPreProcessor(false)
+        , m_ppPrevType(0)
+        , m_parenDepth(0)
+        , m_angleDepth(0)
+        , m_statementTokens(0)
+        , m_statementFirst(0)
+        , m_skipStatement(false)
+        , m_inInitializer(false)
+        , m_pending(kScopeNone)
+        , m_pendingBases(false)
+        , m_pendingLine(0)
+        , m_typedef(false)
+        , m_typedefDepth(0)
+        , m_typedefLine(0)
+        , m_typedefPtrLine(0)
+        , m_candidate(kCandidateNone)
+        , m_candidateLine(0)
+        , m_trailingReturn(false)
+        , m_initBraceDepth(0)
+        , m_operator(0)
+        , m_operatorLine(0)
+    {
+    }
+
+    void Parse(Scanner_t scanner)
+    {
+        CxxLexerToken token;
+        while(::LexerNext(scanner, token)) {
+            const char* text = token.text ? token.text : "";
+            int type = token.type;
+            int line = token.lineNumber;
+
+            if(m_inPreProcessor || (type >= T_PP_DEFINE && type <= T_PP_LTEQ)) {
+                OnPreProcessor(type, text, line);
+                continue;
+            }
+
+            if(type == T_IDENTIFIER) {
+                AddRecord(CscopeXRefIndex::kRecordReference, text, line, m_function);
+            }
+
+            // The structure is tracked on the first branch of #if/#else only, so both branches don't open the
+            // same scope twice
+            if(IsInactiveBranch()) continue;
+
+            if(m_function != CscopeXRefIndex::kNoSymbol) {
+                OnFunctionBody(type);
+            } else if(!OnCandidate(type)) {
+                OnDeclaration(type, text, line);
+            }
+
+            m_prevPrevType = m_prevType;
+            m_prevType = type;
+            m_prevText = text;
+            m_prevLine = line;
+        }
+    }
+
+private:
+    wxUint32 Intern(const std::string& symbol)
+    {
+        std::map<std::string, wxUint32>::const_iterator iter = m_ids.find(symbol);
+        if(iter != m_ids.end()) return iter->second;
+
+        wxUint32 id = m_file.symbols.size();
+        m_file.symbols.push_back(symbol);
+        m_ids.insert(std::make_pair(symbol, id));
+        return id;
+    }
+
+    void AddRecord(CscopeXRefIndex::eRecordKind kind,
+                   const std::string& symbol,
+                   int line,
+                   wxUint32 other = CscopeXRefIndex::kNoSymbol)
+    {
+        CscopeXRefIndex::Record record;
+        record.symbol = Intern(symbol);
+        record.other = other;
+        record.line = line > 0 ? line : 1;
+        record.kind = kind;
+
+        if(kind == CscopeXRefIndex::kRecordReference) {
+            if(line != m_refLine) {
+                m_refLine = line;
+                m_lineRefs.clear();
+            }
+            if(!m_lineRefs.insert(record.symbol).second) return;
+        }
+        m_file.records.push_back(record);
+    }
+
+    int CurrentScope() const { return m_scopes.empty() ? (int)kScopeNamespace : m_scopes.back(); }
+
+    bool IsInactiveBranch() const
+    {
+        for(size_t i = 0; i < m_conditionals.size(); ++i) {
+            if(m_conditionals[i].inactive) return true;
+        }
+        return false;
+    }
+
+    void OnPreProcessor(int type, const char* text, int line)
+    {
+        switch(type) {
+        case T_PP_STATE_EXIT:
+            m_inPreProcessor = false;
+            m_ppPrevType = 0;
+            return;
+        case T_PP_IF:
+        case T_PP_IFDEF:
+        case T_PP_IFNDEF: {
+            Conditional cond = { false, true };
+            m_conditionals.push_back(cond);
+            break;
+        }
+        case T_PP_DEC_NUMBER:
+            // #if 0: follow the #else branch instead
+            if(m_ppPrevType == T_PP_IF && strcmp(text, "0") == 0 && !m_conditionals.empty()) {
+                m_conditionals.back().inactive = true;
+                m_conditionals.back().taken = false;
+            }
+            break;
+        case T_PP_ELSE:
+        case T_PP_ELIF:
+            if(!m_conditionals.empty()) {
+                Conditional& cond = m_conditionals.back();
+                cond.inactive = cond.taken;
+                cond.taken = true;
+            }
+            break;
+        case T_PP_ENDIF:
+            if(!m_conditionals.empty()) {
+                m_conditionals.pop_back();
+            }
+            break;
+        case T_PP_IDENTIFIER:
+            AddRecord(CscopeXRefIndex::kRecordReference, text, line, m_function);
+            if(m_ppPrevType == T_PP_DEFINE) {
+                AddRecord(CscopeXRefIndex::kRecordDefinition, text, line);
+            }
+            break;
+        case T_PP_INCLUDE_FILENAME: {
+            // strip the quotes or the angle brackets
+            std::string path(text);
+            if(path.length() > 2) {
+                path = path.substr(1, path.length() - 2);
+                size_t slash = path.find_last_of("/\\");
+                std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+                AddRecord(CscopeXRefIndex::kRecordInclude, name, line, Intern(path));
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        m_inPreProcessor = true;
+        m_ppPrevType = type;
+    }
+
+    void OnFunctionBody(int type)
+    {
+        switch(type) {
+        case '(':
+            if(m_prevType == T_IDENTIFIER) {
+                AddRecord(CscopeXRefIndex::kRecordCall, m_prevText, m_prevLine, m_function);
+            }
+            break;
+        case '{':
+            m_scopes.push_back(kScopeBlock);
+            break;
+        case '}':
+            CloseScope();
+            break;
+        default:
+            break;
+        }
+    }
+
+    /**
+     * @brief advance a function definition candidate. Return true if the token was consumed
+     */
+    bool OnCandidate(int type)
+    {
+        switch(m_candidate) {
+        case kCandidateParams:
+            if(type == '(') {
+                ++m_parenDepth;
+            } else if(type == ')') {
+                if(--m_parenDepth == 0) m_candidate = kCandidateAfterParams;
+            } else if(type == ';') {
+                break;
+            }
+            return true;
+
+        case kCandidateAfterParams:
+            if(m_parenDepth > 0) {
+                // throw(...) or noexcept(...)
+                if(type == '(') {
+                    ++m_parenDepth;
+                } else if(type == ')') {
+                    --m_parenDepth;
+                }
+                return true;
+            }
+            switch(type) {
+            case '{':
+                OpenFunction();
+                return true;
+            case ':':
+                m_candidate = kCandidateInitList;
+                return true;
+            case '(':
+                ++m_parenDepth;
+                return true;
+            case T_ARROW:
+                m_trailingReturn = true;
+                return true;
+            case T_CONST:
+            case T_VOLATILE:
+            case T_OVERRIDE:
+            case T_FINAL:
+            case T_NOEXCEPT:
+            case T_THROW:
+            case T_TRY:
+            case '&':
+            case T_AND_AND:
+                return true;
+            case ';':
+            case '=':
+            case ',':
+            case '}':
+                break;
+            default:
+                if(m_trailingReturn) return true;
+                break;
+            }
+            break;
+
+        case kCandidateInitList:
+            if(m_initBraceDepth > 0) {
+                // a brace initializer: m_member{value}
+                if(type == '{') {
+                    ++m_initBraceDepth;
+                } else if(type == '}') {
+                    --m_initBraceDepth;
+                }
+                return true;
+            }
+            if(type == '(') {
+                ++m_parenDepth;
+            } else if(type == ')') {
+                if(m_parenDepth > 0) --m_parenDepth;
+            } else if(type == '{') {
+                if(m_parenDepth > 0 || m_prevType == T_IDENTIFIER || m_prevType == '>') {
+                    m_initBraceDepth = 1;
+                } else {
+                    OpenFunction();
+                }
+            } else if(type == ';') {
+                break;
+            }
+            return true;
+
+        default:
+            return false;
+        }
+
+        // not a function definition after all, let the declaration handle this token
+        m_candidate = kCandidateNone;
+        m_trailingReturn = false;
+        m_parenDepth = 0;
+        return false;
+    }
+
+    void OnDeclaration(int type, const char* text, int line)
+    {
+        int scope = CurrentScope();
+        bool canDefineFunction = (scope == kScopeNamespace || scope == kScopeClass) && !m_typedef &&
+                                 m_parenDepth == 0 && m_angleDepth == 0;
+
+        if(m_operator) {
+            if(m_operator == 2) {
+                if(type == ')') m_operator = 1;
+                return;
+            }
+            if(type == '(') {
+                if(m_prevType == T_OPERATOR) {
+                    m_operatorName += "()";
+                    m_operator = 2;
+                    return;
+                }
+                m_operator = 0;
+                if(canDefineFunction) {
+                    StartCandidate(m_operatorName, m_operatorLine);
+                    return;
+                }
+            } else if(type == ';' || type == '{' || type == '}') {
+                m_operator = 0;
+            } else {
+                // operator new, operator bool...
+                if(isalpha(text[0]) || text[0] == '_') m_operatorName += " ";
+                m_operatorName += text;
+                return;
+            }
+        }
+
+        // the name of a class/struct/union/enum/namespace is expected
+        if(m_pending != kScopeNone && !m_pendingBases) {
+            switch(type) {
+            case ';':
+            case ',':
+            case '(':
+            case ')':
+            case '=':
+            case '*':
+            case '&':
+            case '>':
+                m_pending = kScopeNone;
+                break;
+            default:
+                break;
+            }
+        }
+
+        switch(type) {
+        case T_CLASS:
+        case T_STRUCT:
+        case T_UNION:
+            if(m_prevType != T_ENUM) StartPending(kScopeClass);
+            m_skipStatement = true;
+            break;
+        case T_ENUM:
+            StartPending(kScopeEnum);
+            m_skipStatement = true;
+            break;
+        case T_NAMESPACE:
+            if(m_prevType != T_USING) StartPending(kScopeNamespace);
+            m_skipStatement = true;
+            break;
+        case T_TYPEDEF:
+            m_typedef = true;
+            m_typedefDepth = m_scopes.size();
+            m_typedefName.clear();
+            m_typedefPtrName.clear();
+            m_skipStatement = true;
+            break;
+        case T_EXTERN:
+        case T_USING:
+        case T_FRIEND:
+            m_skipStatement = true;
+            break;
+        case T_OPERATOR:
+            m_operator = 1;
+            m_operatorName = "operator";
+            m_operatorLine = line;
+            break;
+        case T_IDENTIFIER:
+            if(m_pending != kScopeNone && !m_pendingBases) {
+                m_pendingName = text;
+                m_pendingLine = line;
+            }
+            if(m_typedef && m_scopes.size() == m_typedefDepth) {
+                if(m_parenDepth == 0) {
+                    m_typedefName = text;
+                    m_typedefLine = line;
+                } else if(m_prevType == '*' && m_typedefPtrName.empty()) {
+                    // typedef void (*name)(...)
+                    m_typedefPtrName = text;
+                    m_typedefPtrLine = line;
+                }
+            }
+            if(scope == kScopeEnum && (m_prevType == '{' || m_prevType == ',')) {
+                AddRecord(CscopeXRefIndex::kRecordDefinition, text, line);
+            }
+            break;
+        case ':':
+            if(m_pending == kScopeClass || m_pending == kScopeEnum) {
+                m_pendingBases = true;
+            } else if(scope == kScopeClass && m_parenDepth == 0) {
+                // access specifier
+                ResetStatement();
+                return;
+            }
+            break;
+        case '(':
+            if(canDefineFunction && m_prevType == T_IDENTIFIER) {
+                StartCandidate(m_prevPrevType == '~' ? "~" + m_prevText : m_prevText, m_prevLine);
+                return;
+            }
+            ++m_parenDepth;
+            break;
+        case ')':
+            if(m_parenDepth > 0) --m_parenDepth;
+            break;
+        case '<':
+            if(m_prevType == T_IDENTIFIER || m_prevType == T_TEMPLATE) ++m_angleDepth;
+            break;
+        case '>':
+            if(m_angleDepth > 0) --m_angleDepth;
+            break;
+        case T_RS:
+            m_angleDepth = m_angleDepth > 2 ? m_angleDepth - 2 : 0;
+            break;
+        case '=':
+            if(m_statementFirst == T_USING && m_statementTokens == 2 && m_prevType == T_IDENTIFIER) {
+                // using name = type;
+                AddRecord(CscopeXRefIndex::kRecordDefinition, m_prevText, m_prevLine);
+            } else {
+                MaybeVariable();
+            }
+            if(m_parenDepth == 0 && m_angleDepth == 0) m_inInitializer = true;
+            break;
+        case '[':
+            MaybeVariable();
+            break;
+        case ',':
+            if(m_parenDepth == 0 && m_angleDepth == 0) {
+                MaybeVariable();
+                m_inInitializer = false;
+            }
+            break;
+        case ';':
+            if(m_typedef && m_scopes.size() == m_typedefDepth) {
+                if(!m_typedefPtrName.empty()) {
+                    AddRecord(CscopeXRefIndex::kRecordDefinition, m_typedefPtrName, m_typedefPtrLine);
+                } else if(!m_typedefName.empty()) {
+                    AddRecord(CscopeXRefIndex::kRecordDefinition, m_typedefName, m_typedefLine);
+                }
+                m_typedef = false;
+            } else {
+                MaybeVariable();
+            }
+            m_pending = kScopeNone;
+            ResetStatement();
+            return;
+        case '{':
+            OpenBrace();
+            return;
+        case '}':
+            CloseScope();
+            return;
+        default:
+            break;
+        }
+
+        if(m_statementTokens++ == 0) m_statementFirst = type;
+    }
+
+    void StartPending(int kind)
+    {
+        m_pending = kind;
+        m_pendingBases = false;
+        m_pendingName.clear();
+    }
+
+    void StartCandidate(const std::string& name, int line)
+    {
+        m_candidate = kCandidateParams;
+        m_candidateName = name;
+        m_candidateLine = line;
+        m_trailingReturn = false;
+        m_parenDepth = 1;
+    }
+
+    void OpenFunction()
+    {
+        m_scopes.push_back(kScopeFunction);
+        m_functionDepth = m_scopes.size();
+        m_function = Intern(m_candidateName);
+        AddRecord(CscopeXRefIndex::kRecordDefinition, m_candidateName, m_candidateLine);
+        m_initBraceDepth = 0;
+        ResetStatement();
+    }
+
+    void OpenBrace()
+    {
+        int kind = kScopeBlock;
+        if(m_pending == kScopeClass || m_pending == kScopeEnum) {
+            if(!m_pendingName.empty()) {
+                AddRecord(CscopeXRefIndex::kRecordDefinition, m_pendingName, m_pendingLine);
+            }
+            kind = m_pending;
+        } else if(m_pending == kScopeNamespace || (m_prevType == T_STRING && m_prevPrevType == T_EXTERN)) {
+            // namespace and extern "C" blocks
+            kind = kScopeNamespace;
+        }
+        m_scopes.push_back(kind);
+        m_pending = kScopeNone;
+        m_pendingBases = false;
+        ResetStatement();
+    }
+
+    void CloseScope()
+    {
+        if(!m_scopes.empty()) {
+            if(m_function != CscopeXRefIndex::kNoSymbol && m_scopes.size() == m_functionDepth) {
+                m_function = CscopeXRefIndex::kNoSymbol;
+            }
+            m_scopes.pop_back();
+        }
+        ResetStatement();
+    }
+
+    void ResetStatement()
+    {
+        m_statementTokens = 0;
+        m_statementFirst = 0;
+        m_skipStatement = false;
+        m_inInitializer = false;
+        m_parenDepth = 0;
+        m_angleDepth = 0;
+        m_operator = 0;
+        m_candidate = kCandidateNone;
+        m_trailingReturn = false;
+    }
+
+    /**
+     * @brief a global variable is declared by an identifier followed by '=', ',', '[' or ';'
+     */
+    void MaybeVariable()
+    {
+        if(CurrentScope() != kScopeNamespace || m_skipStatement || m_inInitializer || m_parenDepth || m_angleDepth) {
+            return;
+        }
+        if(m_prevType == T_IDENTIFIER && m_statementTokens >= 2) {
+            AddRecord(CscopeXRefIndex::kRecordDefinition, m_prevText, m_prevLine);
+        }
+    }
+};
+
+//===--------------------------------------------------------------------===//
+// Parallel parsing: the workers pull files from a shared queue and each of
+// them fills its own slots of the output vector
+//===--------------------------------------------------------------------===//
+
+class XRefParseQueue
+{
+    std::vector<CscopeXRefIndex::ParsedFile>& m_files;
+    size_t m_next;
+    wxMutex m_lock;
+
+public:
+    XRefParseQueue(std::vector<CscopeXRefIndex::ParsedFile>& files)
+        : m_files(files)
+        , m_next(0)
+    {
+    }
+
+    bool Next(size_t& index)
+    {
+        wxMutexLocker locker(m_lock);
+        if(m_next >= m_files.size()) return false;
+        index = m_next++;
+        return true;
+    }
+
+    void ParseAll()
+    {
+        size_t index;
+        while(Next(index)) {
+            CscopeXRefIndex::ParseFile(m_files[index]);
+        }
+    }
+};
+
+class XRefParseWorker : public wxThread
+{
+    XRefParseQueue* m_queue;
+
+public:
+    XRefParseWorker(XRefParseQueue* queue)
+        : wxThread(wxTHREAD_JOINABLE)
+        , m_queue(queue)
+    {
+    }
+    virtual ~XRefParseWorker() {}
+
+    virtual void* Entry()
+    {
+        m_queue->ParseAll();
+        return NULL;
+    }
+};
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// CscopeXRefIndex
+//===--------------------------------------------------------------------===//
+
+CscopeXRefIndex::CscopeXRefIndex()
+    : m_modified(false)
+{
+}
+
+CscopeXRefIndex::~CscopeXRefIndex() {}
+
+void CscopeXRefIndex::ParseFile(ParsedFile& file)
+{
+    file.lastModified = wxFileModificationTime(file.path);
+    if(file.lastModified == (time_t)-1) return;
+
+    Scanner_t scanner = ::LexerNew(wxFileName(file.path), kLexerOpt_None);
+    if(!scanner || !DoReadLineOffsets(file.path, file.lineOffsets)) {
+        if(scanner) ::LexerDestroy(&scanner);
+        file.lastModified = -1;
+        return;
+    }
+
+    XRefFileParser parser(file);
+    parser.Parse(scanner);
+    ::LexerDestroy(&scanner);
+}
+
+bool CscopeXRefIndex::DoReadLineOffsets(const wxString& path, std::vector<wxUint32>& offsets)
+{
+    offsets.clear();
+    wxFFile fp(path, "rb");
+    if(!fp.IsOpened()) return false;
+
+    char buffer[64 * 1024];
+    size_t offset = 0;
+    offsets.push_back(0);
+    while(!fp.Eof()) {
+        size_t count = fp.Read(buffer, sizeof(buffer));
+        if(count == 0) break;
+        const char* p = buffer;
+        const char* end = buffer + count;
+        while((p = (const char*)memchr(p, '\n', end - p))) {
+            ++p;
+            offsets.push_back(offset + (p - buffer));
+        }
+        offset += count;
+    }
+    return !fp.Error();
+}
+
+wxString CscopeXRefIndex::DoReadLine(wxFFile& fp, const IndexedFile& file, wxUint32 line)
+{
+    if(!fp.IsOpened() || line == 0 || line > file.lineOffsets.size()) return wxEmptyString;
+
+    // the file might have changed since it was indexed: read at most XREF_MAX_LINE_LENGTH bytes and stop at the EOL
+    wxUint32 start = file.lineOffsets[line - 1];
+    size_t length = XREF_MAX_LINE_LENGTH;
+    if(line < file.lineOffsets.size()) {
+        length = wxMin(length, (size_t)(file.lineOffsets[line] - start));
+    }
+
+    char buffer[XREF_MAX_LINE_LENGTH];
+    if(!fp.Seek(start)) return wxEmptyString;
+    size_t count = fp.Read(buffer, length);
+    const char* eol = (const char*)memchr(buffer, '\n', count);
+    if(eol) count = eol - buffer;
+
+    wxString text(buffer, wxConvUTF8, count);
+    if(text.IsEmpty() && count) {
+        text = wxString::From8BitData(buffer, count);
+    }
+    return text.Trim().Trim(false);
+}
+
+void CscopeXRefIndex::Clear()
+{
+    m_symbols.clear();
+    m_symbolIds.clear();
+    m_files.clear();
+    m_fileIds.clear();
+    m_freeFiles.clear();
+    for(size_t i = 0; i < kTableCount; ++i) {
+        m_postings[i].clear();
+    }
+    m_modified = false;
+}
+
+wxUint32 CscopeXRefIndex::DoIntern(const std::string& symbol)
+{
+    std::map<std::string, wxUint32>::const_iterator iter = m_symbolIds.find(symbol);
+    if(iter != m_symbolIds.end()) return iter->second;
+
+    wxUint32 id = m_symbols.size();
+    m_symbols.push_back(symbol);
+    m_symbolIds.insert(std::make_pair(symbol, id));
+    return id;
+}
+
+wxUint32 CscopeXRefIndex::DoFindSymbol(const wxString& symbol) const
+{
+    std::map<std::string, wxUint32>::const_iterator iter =
+        m_symbolIds.find(std::string(symbol.mb_str(wxConvUTF8).data()));
+    return iter == m_symbolIds.end() ? kNoSymbol : iter->second;
+}
+
+size_t CscopeXRefIndex::DoGetPostingKeys(const Record& record, eTable* tables, wxUint32* keys)
+{
+    switch(record.kind) {
+    case kRecordReference:
+        tables[0] = kTableReferences;
+        keys[0] = record.symbol;
+        return 1;
+    case kRecordDefinition:
+        tables[0] = kTableDefinitions;
+        keys[0] = record.symbol;
+        return 1;
+    case kRecordCall:
+        tables[0] = kTableByCallee;
+        keys[0] = record.symbol;
+        tables[1] = kTableByCaller;
+        keys[1] = record.other;
+        return 2;
+    case kRecordInclude:
+        tables[0] = kTableIncludes;
+        keys[0] = record.symbol;
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+void CscopeXRefIndex::DoAddPosting(eTable table, wxUint32 key, wxUint32 fileId, wxUint32 recordIdx)
+{
+    if(key == kNoSymbol) return;
+
+    std::vector<PostingList_t>& postings = m_postings[table];
+    if(key >= postings.size()) {
+        postings.resize(m_symbols.size());
+    }
+    Posting posting = { fileId, recordIdx };
+    postings[key].push_back(posting);
+}
+
+void CscopeXRefIndex::DoAddPostings(wxUint32 fileId)
+{
+    const std::vector<Record>& records = m_files[fileId].records;
+    for(size_t i = 0; i < records.size(); ++i) {
+        eTable tables[2];
+        wxUint32 keys[2];
+        size_t count = DoGetPostingKeys(records[i], tables, keys);
+        for(size_t n = 0; n < count; ++n) {
+            DoAddPosting(tables[n], keys[n], fileId, i);
+        }
+    }
+}
+
+void CscopeXRefIndex::DoRemovePostings(wxUint32 fileId)
+{
+    // collect the posting lists referring to this file, then filter each of them once
+    std::set<std::pair<int, wxUint32> > lists;
+    const std::vector<Record>& records = m_files[fileId].records;
+    for(size_t i = 0; i < records.size(); ++i) {
+        eTable tables[2];
+        wxUint32 keys[2];
+        size_t count = DoGetPostingKeys(records[i], tables, keys);
+        for(size_t n = 0; n < count; ++n) {
+            if(keys[n] != kNoSymbol) lists.insert(std::make_pair((int)tables[n], keys[n]));
+        }
+    }
+
+    std::set<std::pair<int, wxUint32> >::const_iterator iter = lists.begin();
+    for(; iter != lists.end(); ++iter) {
+        std::vector<PostingList_t>& postings = m_postings[iter->first];
+        if(iter->second >= postings.size()) continue;
+
+        PostingList_t& list = postings[iter->second];
+        list.erase(std::remove_if(list.begin(),
+                                  list.end(),
+                                  [fileId](const Posting& posting) { return posting.file == fileId; }),
+                   list.end());
+    }
+}
+
+void CscopeXRefIndex::DoRemoveFile(wxUint32 fileId)
+{
+    DoRemovePostings(fileId);
+
+    IndexedFile& file = m_files[fileId];
+    m_fileIds.erase(file.path);
+    file.path.Clear();
+    file.lastModified = -1;
+    std::vector<Record>().swap(file.records);
+    std::vector<wxUint32>().swap(file.lineOffsets);
+    m_freeFiles.push_back(fileId);
+    m_modified = true;
+}
+
+void CscopeXRefIndex::DoAddFile(ParsedFile& parsed)
+{
+    std::map<wxString, wxUint32>::iterator iter = m_fileIds.find(parsed.path);
+    if(parsed.lastModified == (time_t)-1) {
+        // the file could not be read
+        if(iter != m_fileIds.end()) {
+            DoRemoveFile(iter->second);
+        }
+        return;
+    }
+
+    wxUint32 fileId;
+    if(iter != m_fileIds.end()) {
+        fileId = iter->second;
+        DoRemovePostings(fileId);
+
+    } else {
+        if(!m_freeFiles.empty()) {
+            fileId = m_freeFiles.back();
+            m_freeFiles.pop_back();
+        } else {
+            fileId = m_files.size();
+            m_files.push_back(IndexedFile());
+        }
+        m_fileIds.insert(std::make_pair(parsed.path, fileId));
+    }
+
+    // map the file's local symbol ids to the index ids
+    std::vector<wxUint32> ids(parsed.symbols.size());
+    for(size_t i = 0; i < parsed.symbols.size(); ++i) {
+        ids[i] = DoIntern(parsed.symbols[i]);
+    }
+
+    IndexedFile& file = m_files[fileId];
+    file.path = parsed.path;
+    file.lastModified = parsed.lastModified;
+    file.records.swap(parsed.records);
+    file.lineOffsets.swap(parsed.lineOffsets);
+    for(size_t i = 0; i < file.records.size(); ++i) {
+        Record& record = file.records[i];
+        record.symbol = ids[record.symbol];
+        if(record.other != kNoSymbol) {
+            record.other = ids[record.other];
+        }
+    }
+
+    DoAddPostings(fileId);
+    m_modified = true;
+}
+
+void CscopeXRefIndex::DoParseFiles(const wxArrayString& files)
+{
+    if(files.IsEmpty()) return;
+
+    std::vector<ParsedFile> parsed(files.GetCount());
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        // deep copy, the workers must not share the string buffers of this thread
+        parsed[i].path = files.Item(i).c_str();
+    }
+
+    // Parse the files in parallel. This thread parses as well, so start one worker less
+    XRefParseQueue queue(parsed);
+    std::vector<XRefParseWorker*> workers;
+    size_t count = wxMin((size_t)wxThread::GetCPUCount(), parsed.size() / XREF_MIN_FILES_PER_WORKER);
+    for(size_t i = 1; i < count; ++i) {
+        XRefParseWorker* worker = new XRefParseWorker(&queue);
+        if(worker->Create() != wxTHREAD_NO_ERROR || worker->Run() != wxTHREAD_NO_ERROR) {
+            delete worker;
+            break;
+        }
+        workers.push_back(worker);
+    }
+
+    queue.ParseAll();
+    for(size_t i = 0; i < workers.size(); ++i) {
+        workers[i]->Wait();
+        delete workers[i];
+    }
+
+    // merge the results, this part is sequential
+    for(size_t i = 0; i < parsed.size(); ++i) {
+        DoAddFile(parsed[i]);
+    }
+}
+
+size_t CscopeXRefIndex::Sync(const wxArrayString& files)
+{
+    std::set<wxString> wanted;
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        wanted.insert(files.Item(i));
+    }
+
+    // drop the files that are no longer part of the list
+    std::vector<wxUint32> removed;
+    std::map<wxString, wxUint32>::const_iterator iter = m_fileIds.begin();
+    for(; iter != m_fileIds.end(); ++iter) {
+        if(wanted.count(iter->first) == 0) {
+            removed.push_back(iter->second);
+        }
+    }
+    for(size_t i = 0; i < removed.size(); ++i) {
+        DoRemoveFile(removed[i]);
+    }
+
+    // parse the new files and the files that were modified since they were indexed
+    wxArrayString modified;
+    std::set<wxString>::const_iterator fileIter = wanted.begin();
+    for(; fileIter != wanted.end(); ++fileIter) {
+        iter = m_fileIds.find(*fileIter);
+        if(iter == m_fileIds.end() || m_files[iter->second].lastModified != wxFileModificationTime(*fileIter)) {
+            modified.Add(*fileIter);
+        }
+    }
+    DoParseFiles(modified);
+    return modified.GetCount();
+}
+
+void CscopeXRefIndex::UpdateFiles(const wxArrayString& files)
+{
+    wxArrayString indexed;
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        if(HasFile(files.Item(i))) {
+            indexed.Add(files.Item(i));
+        }
+    }
+    DoParseFiles(indexed);
+}
+
+bool CscopeXRefIndex::Save(const wxString& filename)
+{
+    // only the symbols still in use are written, renumbered in order of appearance
+    std::vector<wxUint32> remap(m_symbols.size(), kNoSymbol);
+    std::vector<wxUint32> used;
+    for(size_t i = 0; i < m_files.size(); ++i) {
+        const std::vector<Record>& records = m_files[i].records;
+        for(size_t n = 0; n < records.size(); ++n) {
+            const Record& record = records[n];
+            if(remap[record.symbol] == kNoSymbol) {
+                remap[record.symbol] = used.size();
+                used.push_back(record.symbol);
+            }
+            if(record.other != kNoSymbol && remap[record.other] == kNoSymbol) {
+                remap[record.other] = used.size();
+                used.push_back(record.other);
+            }
+        }
+    }
+
+    std::string buffer;
+    buffer.append(XREF_DB_MAGIC);
+    WriteU32(buffer, XREF_DB_VERSION);
+
+    WriteU32(buffer, used.size());
+    for(size_t i = 0; i < used.size(); ++i) {
+        WriteString(buffer, m_symbols[used[i]]);
+    }
+
+    WriteU32(buffer, m_fileIds.size());
+    std::map<wxString, wxUint32>::const_iterator iter = m_fileIds.begin();
+    for(; iter != m_fileIds.end(); ++iter) {
+        const IndexedFile& file = m_files[iter->second];
+        WriteString(buffer, std::string(file.path.mb_str(wxConvUTF8).data()));
+        wxInt64 lastModified = file.lastModified;
+        buffer.append((const char*)&lastModified, sizeof(lastModified));
+        WriteU32(buffer, file.records.size());
+        for(size_t n = 0; n < file.records.size(); ++n) {
+            const Record& record = file.records[n];
+            WriteU32(buffer, remap[record.symbol]);
+            WriteU32(buffer, record.other == kNoSymbol ? kNoSymbol : remap[record.other]);
+            WriteU32(buffer, record.line);
+            buffer.append(1, (char)record.kind);
+        }
+        WriteU32(buffer, file.lineOffsets.size());
+        for(size_t n = 0; n < file.lineOffsets.size(); ++n) {
+            WriteU32(buffer, file.lineOffsets[n]);
+        }
+    }
+
+    wxFFile fp(filename, "w+b");
+    if(!fp.IsOpened() || !fp.Write(buffer.c_str(), buffer.length()) || !fp.Close()) {
+        return false;
+    }
+    m_modified = false;
+    return true;
+}
+
+bool CscopeXRefIndex::Load(const wxString& filename)
+{
+    Clear();
+
+    wxFFile fp(filename, "rb");
+    if(!fp.IsOpened()) return false;
+
+    std::string buffer;
+    buffer.resize(fp.Length());
+    if(buffer.empty() || fp.Read(&buffer[0], buffer.length()) != buffer.length()) return false;
+    fp.Close();
+
+    const char* p = buffer.c_str();
+    const char* end = p + buffer.length();
+    wxUint32 version;
+    if(buffer.compare(0, 4, XREF_DB_MAGIC) != 0) return false;
+    p += 4;
+    if(!ReadU32(p, end, version) || version != XREF_DB_VERSION) return false;
+
+    bool ok = true;
+    wxUint32 symbolCount = 0;
+    ok = ReadU32(p, end, symbolCount);
+    for(wxUint32 i = 0; ok && i < symbolCount; ++i) {
+        std::string symbol;
+        ok = ReadString(p, end, symbol);
+        if(ok) DoIntern(symbol);
+    }
+
+    wxUint32 fileCount = 0;
+    ok = ok && ReadU32(p, end, fileCount);
+    for(wxUint32 i = 0; ok && i < fileCount; ++i) {
+        std::string path;
+        wxInt64 lastModified;
+        wxUint32 recordCount;
+        ok = ReadString(p, end, path) && (size_t)(end - p) >= sizeof(lastModified);
+        if(!ok) break;
+        memcpy(&lastModified, p, sizeof(lastModified));
+        p += sizeof(lastModified);
+
+        ok = ReadU32(p, end, recordCount);
+        IndexedFile file;
+        file.path = wxString(path.c_str(), wxConvUTF8);
+        file.lastModified = lastModified;
+        file.records.reserve(recordCount);
+        for(wxUint32 n = 0; ok && n < recordCount; ++n) {
+            Record record;
+            ok = ReadU32(p, end, record.symbol) && ReadU32(p, end, record.other) && ReadU32(p, end, record.line) &&
+                 p < end;
+            if(!ok) break;
+            record.kind = (wxUint8)*p++;
+            ok = record.symbol < m_symbols.size() && (record.other == kNoSymbol || record.other < m_symbols.size());
+            file.records.push_back(record);
+        }
+
+        wxUint32 lineCount = 0;
+        ok = ok && ReadU32(p, end, lineCount) && (size_t)(end - p) / sizeof(wxUint32) >= lineCount;
+        if(!ok) break;
+        file.lineOffsets.resize(lineCount);
+        for(wxUint32 n = 0; n < lineCount; ++n) {
+            ReadU32(p, end, file.lineOffsets[n]);
+        }
+
+        wxUint32 fileId = m_files.size();
+        m_files.push_back(file);
+        m_fileIds.insert(std::make_pair(m_files.back().path, fileId));
+        DoAddPostings(fileId);
+    }
+
+    if(!ok) {
+        Clear();
+        return false;
+    }
+    m_modified = false;
+    return true;
+}
+
+void CscopeXRefIndex::Query(eQuery query, const wxString& word, CScopeResultTable_t& results) const
+{
+    eTable table;
+    wxString name = word;
+    switch(query) {
+    case kFindDefinition:
+        table = kTableDefinitions;
+        break;
+    case kFindCallees:
+        table = kTableByCaller;
+        break;
+    case kFindCallers:
+        table = kTableByCallee;
+        break;
+    case kFindIncludingFiles:
+        // included files are indexed by their base name
+        table = kTableIncludes;
+        name.Replace("\\", "/");
+        name = name.AfterLast('/');
+        break;
+    case kFindSymbol:
+    default:
+        table = kTableReferences;
+        break;
+    }
+
+    wxUint32 id = DoFindSymbol(name);
+    if(id == kNoSymbol || id >= m_postings[table].size()) return;
+
+    // "foo/bar.h" matches #include <foo/bar.h> and "sub/foo/bar.h" but not "bar.h"
+    std::string pathSuffix;
+    if(query == kFindIncludingFiles && word.Contains("/")) {
+        wxString suffix = word;
+        suffix.Replace("\\", "/");
+        pathSuffix = suffix.mb_str(wxConvUTF8).data();
+    }
+
+    const PostingList_t& postings = m_postings[table][id];
+    wxUint32 curFile = kNoSymbol;
+    wxFFile fp;
+    CScopeEntryDataVec_t* entries = NULL;
+    for(size_t i = 0; i < postings.size(); ++i) {
+        const IndexedFile& file = m_files[postings[i].file];
+        const Record& record = file.records[postings[i].record];
+
+        if(!pathSuffix.empty()) {
+            std::string path = m_symbols[record.other];
+            std::replace(path.begin(), path.end(), '\\', '/');
+            if(path.length() < pathSuffix.length() ||
+               path.compare(path.length() - pathSuffix.length(), pathSuffix.length(), pathSuffix) != 0) {
+                continue;
+            }
+        }
+
+        if(postings[i].file != curFile) {
+            // the matching lines are displayed next to the match, read them using the offsets collected by the parser
+            curFile = postings[i].file;
+            if(fp.IsOpened()) fp.Close();
+            fp.Open(file.path, "rb");
+
+            CScopeResultTable_t::iterator iter = results.find(file.path);
+            if(iter == results.end()) {
+                entries = new CScopeEntryDataVec_t();
+                results.insert(std::make_pair(file.path, entries));
+            } else {
+                entries = iter->second;
+            }
+        }
+
+        wxString scope;
+        switch(query) {
+        case kFindSymbol:
+            scope = record.other == kNoSymbol ? wxString("<global>")
+                                              : wxString(m_symbols[record.other].c_str(), wxConvUTF8);
+            break;
+        case kFindDefinition:
+        case kFindCallees:
+            scope = wxString(m_symbols[record.symbol].c_str(), wxConvUTF8);
+            break;
+        case kFindCallers:
+            scope = wxString(m_symbols[record.other].c_str(), wxConvUTF8);
+            break;
+        default:
+            scope = "<global>";
+            break;
+        }
+
+        CscopeEntryData data;
+        data.SetFile(file.path);
+        data.SetLine(record.line);
+        data.SetScope(scope);
+        data.SetPattern(DoReadLine(fp, file, record.line));
+        entries->push_back(data);
+    }
+}
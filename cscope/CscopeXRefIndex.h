@@ -0,0 +1,185 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// Copyright            : (C) 2016 Eran Ifrah
+// File name            : CscopeXRefIndex.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CSCOPEXREFINDEX_H
+#define CSCOPEXREFINDEX_H
+
+#include "cscopeentrydata.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <wx/arrstr.h>
+#include <wx/ffile.h>
+#include <wx/string.h>
+
+/**
+ * @class CscopeXRefIndex
+ * @brief an in-process cross reference index of C/C++ sources, answering the same questions as the cscope executable
+ * (symbol references, global definitions, callers, callees and including files).
+ * Files are tokenized with the CxxLexer, several files at a time, and the index is kept in memory as posting lists
+ * keyed by symbol. It can be saved to disk and synced with the workspace files based on their modification time.
+ * This class is not thread safe: it is owned and accessed by the cscope worker thread only
+ */
+class CscopeXRefIndex
+{
+public:
+    enum eQuery {
+        kFindSymbol,         // all the references to a symbol (cscope -0)
+        kFindDefinition,     // the global definitions of a symbol (cscope -1)
+        kFindCallees,        // the functions called by a function (cscope -2)
+        kFindCallers,        // the functions calling a function (cscope -3)
+        kFindIncludingFiles, // the files #including a file (cscope -8)
+    };
+
+    enum eRecordKind {
+        kRecordReference = 0,
+        kRecordDefinition,
+        kRecordCall,
+        kRecordInclude,
+    };
+
+    /**
+     * @brief a single cross reference entry of a file
+     */
+    struct Record {
+        wxUint32 symbol; // the symbol referenced, defined or called. For includes: the base name of the included file
+        wxUint32 other;  // the enclosing function of a reference or a call, the included path. kNoSymbol if none
+        wxUint32 line;
+        wxUint8 kind;
+    };
+
+    /**
+     * @brief a file parsed by one of the workers. Its records refer to the file's local 'symbols' table
+     */
+    struct ParsedFile {
+        wxString path;
+        time_t lastModified;
+        std::vector<std::string> symbols;
+        std::vector<Record> records;
+        std::vector<wxUint32> lineOffsets; // the offset of each line in the file, the matches display their line
+        ParsedFile()
+            : lastModified(-1)
+        {
+        }
+    };
+
+    static const wxUint32 kNoSymbol = 0xFFFFFFFF;
+
+protected:
+    enum eTable {
+        kTableReferences = 0, // keyed by the referenced symbol
+        kTableDefinitions,    // keyed by the defined symbol
+        kTableByCallee,       // keyed by the called function
+        kTableByCaller,       // keyed by the calling function
+        kTableIncludes,       // keyed by the base name of the included file
+        kTableCount,
+    };
+
+    struct IndexedFile {
+        wxString path;
+        time_t lastModified;
+        std::vector<Record> records;
+        std::vector<wxUint32> lineOffsets;
+        IndexedFile()
+            : lastModified(-1)
+        {
+        }
+    };
+
+    struct Posting {
+        wxUint32 file;
+        wxUint32 record;
+    };
+    typedef std::vector<Posting> PostingList_t;
+
+    std::vector<std::string> m_symbols;
+    std::map<std::string, wxUint32> m_symbolIds;
+    std::vector<IndexedFile> m_files;
+    std::map<wxString, wxUint32> m_fileIds;
+    std::vector<wxUint32> m_freeFiles;
+    std::vector<PostingList_t> m_postings[kTableCount];
+    bool m_modified;
+
+protected:
+    wxUint32 DoIntern(const std::string& symbol);
+    wxUint32 DoFindSymbol(const wxString& symbol) const;
+    void DoParseFiles(const wxArrayString& files);
+    void DoAddFile(ParsedFile& parsed);
+    void DoRemoveFile(wxUint32 fileId);
+    void DoAddPostings(wxUint32 fileId);
+    void DoRemovePostings(wxUint32 fileId);
+    static size_t DoGetPostingKeys(const Record& record, eTable* tables, wxUint32* keys);
+    static bool DoReadLineOffsets(const wxString& path, std::vector<wxUint32>& offsets);
+    static wxString DoReadLine(wxFFile& fp, const IndexedFile& file, wxUint32 line);
+    void DoAddPosting(eTable table, wxUint32 key, wxUint32 fileId, wxUint32 recordIdx);
+
+public:
+    CscopeXRefIndex();
+    virtual ~CscopeXRefIndex();
+
+    /**
+     * @brief tokenize a single file and collect its cross reference records. Called from the parser workers
+     */
+    static void ParseFile(ParsedFile& file);
+
+    /**
+     * @brief remove all the files and symbols from the index
+     */
+    void Clear();
+
+    bool IsEmpty() const { return m_fileIds.empty(); }
+    bool IsModified() const { return m_modified; }
+    bool HasFile(const wxString& filename) const { return m_fileIds.count(filename) != 0; }
+
+    /**
+     * @brief load the index from disk, replacing the current content. Return false if the file is missing or
+     * was written by a different version
+     */
+    bool Load(const wxString& filename);
+
+    /**
+     * @brief write the index to disk
+     */
+    bool Save(const wxString& filename);
+
+    /**
+     * @brief make the index cover exactly 'files' (absolute paths): files no longer listed are dropped and new or
+     * modified files are parsed
+     * @return the number of files parsed
+     */
+    size_t Sync(const wxArrayString& files);
+
+    /**
+     * @brief re-parse the given files. Files that are not part of the index are ignored
+     */
+    void UpdateFiles(const wxArrayString& files);
+
+    /**
+     * @brief run a query against the index and append the matches to 'results', grouped by file
+     */
+    void Query(eQuery query, const wxString& word, CScopeResultTable_t& results) const;
+};
+
+#endif // CSCOPEXREFINDEX_H
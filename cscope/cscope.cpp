@@ -34,16 +34,14 @@
 #include "dirsaver.h"
 #include "cscope.h"
 #include <wx/aui/framemanager.h>
-#include "procutils.h"
 #include "wx/ffile.h"
 #include "workspace.h"
 #include <wx/xrc/xmlres.h>
-#include "exelocator.h"
+#include "fileextmanager.h"
 #include "cscopetab.h"
 #include "cscopedbbuilderthread.h"
 #include <wx/imaglist.h>
 #include "clKeyboardManager.h"
-#include "CScopeSettingsDlg.h"
 #include "event_notifier.h"
 
 static Cscope* thePlugin = NULL;
@@ -104,6 +102,8 @@ Cscope::Cscope(IManager* manager)
     clKeyboardManager::Get()->AddGlobalAccelerator(
         "cscope_create_db", "Alt-4", "Plugins::CScope::Create CScope database");
     EventNotifier::Get()->Bind(wxEVT_CONTEXT_MENU_EDITOR, &Cscope::OnEditorContentMenu, this);
+    EventNotifier::Get()->Bind(wxEVT_FILE_SAVED, &Cscope::OnFileSaved, this);
+    EventNotifier::Get()->Bind(wxEVT_WORKSPACE_CLOSED, &Cscope::OnWorkspaceClosed, this);
 }
 
 Cscope::~Cscope() {}
@@ -148,11 +148,6 @@ clToolBar* Cscope::CreateToolBar(wxWindow* parent)
                          wxCommandEventHandler(Cscope::OnCreateDB),
                          NULL,
                          (wxEvtHandler*)this);
-    m_topWindow->Connect(XRCID("cscope_settings"),
-                         wxEVT_COMMAND_MENU_SELECTED,
-                         wxCommandEventHandler(Cscope::OnDoSettings),
-                         NULL,
-                         (wxEvtHandler*)this);
     m_topWindow->Connect(XRCID("cscope_functions_calling_this_function"),
                          wxEVT_COMMAND_MENU_SELECTED,
                          wxCommandEventHandler(Cscope::OnFindFunctionsCallingThisFunction),
@@ -268,11 +263,6 @@ void Cscope::CreatePluginMenu(wxMenu* pluginsMenu)
                           wxITEM_NORMAL);
     menu->Append(item);
 
-    menu->AppendSeparator();
-
-    item = new wxMenuItem(menu, XRCID("cscope_settings"), _("CScope settings"), _("Configure cscope"), wxITEM_NORMAL);
-    menu->Append(item);
-
     pluginsMenu->Append(wxID_ANY, CSCOPE_NAME, menu);
 }
 
@@ -350,6 +340,8 @@ void Cscope::UnPlug()
         }
     }
     EventNotifier::Get()->Unbind(wxEVT_CONTEXT_MENU_EDITOR, &Cscope::OnEditorContentMenu, this);
+    EventNotifier::Get()->Unbind(wxEVT_FILE_SAVED, &Cscope::OnFileSaved, this);
+    EventNotifier::Get()->Unbind(wxEVT_WORKSPACE_CLOSED, &Cscope::OnWorkspaceClosed, this);
     CScopeThreadST::Get()->Stop();
     CScopeThreadST::Free();
 }
@@ -428,86 +420,69 @@ wxMenu* Cscope::CreateEditorPopMenu()
     return menu;
 }
 
-wxString Cscope::DoCreateListFile(bool force)
+void Cscope::DoGetFiles(wxArrayString& files)
 {
     // get the scope
     CScopeConfData settings;
     m_mgr->GetConfigTool()->ReadObject(wxT("CscopeSettings"), &settings);
 
-    // create temporary file and save the file there
-    wxString privateFolder = clCxxWorkspaceST::Get()->GetPrivateFolder();
-    wxFileName list_file(privateFolder, "cscope_file.list");
-    if(force || settings.GetRebuildOption() || !list_file.FileExists()) {
-        wxArrayString projects;
+    wxArrayString projects;
+    if(settings.GetScanScope() == SCOPE_ENTIRE_WORKSPACE) {
         m_mgr->GetWorkspace()->GetProjectList(projects);
-        wxString err_msg;
-        std::vector<wxFileName> files;
-        std::vector<wxFileName> tmpfiles;
-        m_cscopeWin->SetMessage(_("Creating file list..."), 5);
-
-        if(settings.GetScanScope() == SCOPE_ENTIRE_WORKSPACE) {
-            for(size_t i = 0; i < projects.GetCount(); i++) {
-                ProjectPtr proj = m_mgr->GetWorkspace()->FindProjectByName(projects.Item(i), err_msg);
-                if(proj) {
-                    proj->GetFiles(tmpfiles, true);
-                }
-            }
-        } else {
-            // SCOPE_ACTIVE_PROJECT
-            wxString projName = m_mgr->GetWorkspace()->GetActiveProjectName();
-            ProjectPtr proj = m_mgr->GetWorkspace()->FindProjectByName(projName, err_msg);
-            if(proj) {
-                proj->GetFiles(tmpfiles, true);
-            }
-        }
-
-        // iterate over the files and convert them to be relative path
-        // Also remove any .exe files (one of which managed to crash cscope),
-        // and files without an ext, which may be binaries and are unlikely to be .c or .h files in disguise; and .xpm
-        // and .png too
-        for(size_t i = 0; i < tmpfiles.size(); i++) {
-            wxString ext = tmpfiles.at(i).GetExt();
-            if(ext == wxT("exe") || ext == wxT("") || ext == wxT("xpm") || ext == wxT("png")) {
-                continue;
-            }
-            tmpfiles.at(i).MakeRelativeTo(privateFolder);
-            files.push_back(tmpfiles.at(i));
-        }
+    } else {
+        // SCOPE_ACTIVE_PROJECT
+        projects.Add(m_mgr->GetWorkspace()->GetActiveProjectName());
+    }
 
-        // create temporary file and save the file there
-        wxFFile file(list_file.GetFullPath(), wxT("w+b"));
-        if(!file.IsOpened()) {
-            wxLogMessage(wxT("Failed to open temporary file ") + list_file.GetFullPath());
-            return wxEmptyString;
+    wxString err_msg;
+    std::vector<wxFileName> tmpfiles;
+    for(size_t i = 0; i < projects.GetCount(); i++) {
+        ProjectPtr proj = m_mgr->GetWorkspace()->FindProjectByName(projects.Item(i), err_msg);
+        if(proj) {
+            proj->GetFiles(tmpfiles, true);
         }
+    }
 
-        // write the content of the files into the tempfile
-        wxString content;
-        for(size_t i = 0; i < files.size(); i++) {
-            wxFileName fn(files.at(i));
-            content << fn.GetFullPath() << wxT("\n");
+    // only C/C++ sources and headers are indexed
+    files.Alloc(tmpfiles.size());
+    for(size_t i = 0; i < tmpfiles.size(); i++) {
+        if(FileExtManager::IsCxxFile(tmpfiles.at(i))) {
+            files.Add(tmpfiles.at(i).GetFullPath());
         }
-
-        file.Write(content);
-        file.Flush();
-        file.Close();
     }
+}
 
-    return list_file.GetFullPath();
+wxString Cscope::DoGetDbFile() const
+{
+    wxFileName dbFile(clCxxWorkspaceST::Get()->GetPrivateFolder(), "cscope_xref.db");
+    return dbFile.GetFullPath();
 }
 
-void Cscope::DoCscopeCommand(const wxString& command, const wxString& findWhat, const wxString& endMsg)
+bool Cscope::DoGetSyncOption()
 {
-    // We haven't yet found a valid cscope exe, so look for one
-    wxString where;
-    if(!ExeLocator::Locate(GetCscopeExeName(), where)) {
-        wxString msg;
-        msg << _("I can't find 'cscope' anywhere. Please check if it's installed.") << wxT('\n')
-            << _("Or tell me where it can be found, from the menu: 'Plugins | CScope | Settings'");
-        wxMessageBox(msg, _("CScope not found"), wxOK | wxCENTER | wxICON_WARNING);
-        return;
-    }
+    CScopeConfData settings;
+    m_mgr->GetConfigTool()->ReadObject(wxT("CscopeSettings"), &settings);
+    return settings.GetRebuildOption();
+}
+
+void Cscope::DoCscopeCommand(int query, const wxString& findWhat, const wxString& endMsg)
+{
+    m_cscopeWin->SetMessage(_("Creating file list..."), 5);
 
+    CscopeRequest* req = new CscopeRequest(CscopeRequest::kQuery);
+    req->SetQuery(query);
+    req->SetFindWhat(findWhat);
+    req->SetEndMsg(endMsg);
+    req->SetSyncFiles(DoGetSyncOption());
+
+    wxArrayString files;
+    DoGetFiles(files);
+    req->SetFiles(files);
+    DoSendRequest(req);
+}
+
+void Cscope::DoSendRequest(CscopeRequest* req)
+{
     // set the focus to the cscope tab
     Notebook* book = m_mgr->GetOutputPaneNotebook();
 
@@ -531,14 +506,9 @@ void Cscope::DoCscopeCommand(const wxString& command, const wxString& findWhat,
         }
     }
 
-    // create the search thread and return
-    CscopeRequest* req = new CscopeRequest();
+    // queue the request to the cscope thread and return
     req->SetOwner(this);
-    req->SetCmd(command);
-    req->SetEndMsg(endMsg);
-    req->SetFindWhat(findWhat);
-    req->SetWorkingDir(clCxxWorkspaceST::Get()->GetPrivateFolder());
-
+    req->SetDbFile(DoGetDbFile());
     CScopeThreadST::Get()->Add(req);
 }
 
@@ -557,14 +527,11 @@ void Cscope::OnFindGlobalDefinition(wxCommandEvent& e)
         return;
     }
     m_cscopeWin->Clear();
-    wxString list_file = DoCreateListFile(false);
 
     // Do the actual search
-    wxString command;
     wxString endMsg;
-    command << GetCscopeExeName() << wxT(" -d -L -1 ") << word << wxT(" -i ") << list_file;
     endMsg << _("cscope results for: find global definition of '") << word << wxT("'");
-    DoCscopeCommand(command, word, endMsg);
+    DoCscopeCommand(CscopeXRefIndex::kFindDefinition, word, endMsg);
 }
 
 void Cscope::OnFindFunctionsCalledByThisFunction(wxCommandEvent& e)
@@ -575,23 +542,11 @@ void Cscope::OnFindFunctionsCalledByThisFunction(wxCommandEvent& e)
     }
 
     m_cscopeWin->Clear();
-    wxString list_file = DoCreateListFile(false);
-
-    // get the rebuild option
-    wxString rebuildOption = wxT("");
-    CScopeConfData settings;
-
-    m_mgr->GetConfigTool()->ReadObject(wxT("CscopeSettings"), &settings);
-    if(!settings.GetRebuildOption()) {
-        rebuildOption = wxT(" -d");
-    }
 
     // Do the actual search
-    wxString command;
     wxString endMsg;
-    command << GetCscopeExeName() << rebuildOption << wxT(" -L -2 ") << word << wxT(" -i ") << list_file;
     endMsg << _("cscope results for: functions called by '") << word << wxT("'");
-    DoCscopeCommand(command, word, endMsg);
+    DoCscopeCommand(CscopeXRefIndex::kFindCallees, word, endMsg);
 }
 
 void Cscope::OnFindFunctionsCallingThisFunction(wxCommandEvent& e)
@@ -602,23 +557,11 @@ void Cscope::OnFindFunctionsCallingThisFunction(wxCommandEvent& e)
     }
 
     m_cscopeWin->Clear();
-    wxString list_file = DoCreateListFile(false);
-
-    // get the rebuild option
-    wxString rebuildOption = wxT("");
-    CScopeConfData settings;
-
-    m_mgr->GetConfigTool()->ReadObject(wxT("CscopeSettings"), &settings);
-    if(!settings.GetRebuildOption()) {
-        rebuildOption = wxT(" -d");
-    }
 
     // Do the actual search
-    wxString command;
     wxString endMsg;
-    command << GetCscopeExeName() << rebuildOption << wxT(" -L -3 ") << word << wxT(" -i ") << list_file;
     endMsg << _("cscope results for: functions calling '") << word << wxT("'");
-    DoCscopeCommand(command, word, endMsg);
+    DoCscopeCommand(CscopeXRefIndex::kFindCallers, word, endMsg);
 }
 
 void Cscope::OnFindFilesIncludingThisFname(wxCommandEvent& e)
@@ -644,23 +587,11 @@ void Cscope::OnFindFilesIncludingThisFname(wxCommandEvent& e)
     }
 
     m_cscopeWin->Clear();
-    wxString list_file = DoCreateListFile(false);
-
-    // get the rebuild option
-    wxString rebuildOption = wxT("");
-    CScopeConfData settings;
-
-    m_mgr->GetConfigTool()->ReadObject(wxT("CscopeSettings"), &settings);
-    if(!settings.GetRebuildOption()) {
-        rebuildOption = wxT(" -d");
-    }
 
     // Do the actual search
-    wxString command;
     wxString endMsg;
-    command << GetCscopeExeName() << rebuildOption << wxT(" -L -8 ") << word << wxT(" -i ") << list_file;
     endMsg << _("cscope results for: files that #include '") << word << wxT("'");
-    DoCscopeCommand(command, word, endMsg);
+    DoCscopeCommand(CscopeXRefIndex::kFindIncludingFiles, word, endMsg);
 }
 
 void Cscope::OnCreateDB(wxCommandEvent& e)
@@ -671,52 +602,15 @@ void Cscope::OnCreateDB(wxCommandEvent& e)
     }
 
     m_cscopeWin->Clear();
-    wxString list_file = DoCreateListFile(true);
-
-    // get the reverted index option
-    wxString command;
-    wxString endMsg;
-    CScopeConfData settings;
-
-    command << GetCscopeExeName();
-
-    m_mgr->GetConfigTool()->ReadObject(wxT("CscopeSettings"), &settings);
-    if(settings.GetBuildRevertedIndexOption()) {
-        command << wxT(" -q");
-        endMsg << _("Recreated inverted CScope DB");
-    } else {
-        command << wxT(" -b");
-        endMsg << _("Recreated CScope DB");
-    }
-
-    // Do the actual create db
-    // since the process is always running from the workspace
-    // directory, there is no need to specify the full path of the list file
-
-    command << wxT(" -L -i cscope_file.list");
-    DoCscopeCommand(command, wxEmptyString, endMsg);
-}
+    m_cscopeWin->SetMessage(_("Creating file list..."), 5);
 
-void Cscope::OnDoSettings(wxCommandEvent& e)
-{
-    // atm the only setting to set is the cscope filepath
-    // First find the current value, if any
-    CScopeConfData settings;
-    m_mgr->GetConfigTool()->ReadObject(wxT("CscopeSettings"), &settings);
-    wxString filepath = settings.GetCscopeExe();
-
-    CScopeSettingsDlg dlg(EventNotifier::Get()->TopFrame());
-    if(dlg.ShowModal() == wxID_OK) {
-        settings.SetCscopeExe(dlg.GetPath());
-        m_mgr->GetConfigTool()->WriteObject(wxT("CscopeSettings"), &settings);
-    }
-}
+    wxArrayString files;
+    DoGetFiles(files);
 
-wxString Cscope::GetCscopeExeName()
-{
-    CScopeConfData settings;
-    m_mgr->GetConfigTool()->ReadObject(wxT("CscopeSettings"), &settings);
-    return settings.GetCscopeExe();
+    CscopeRequest* req = new CscopeRequest(CscopeRequest::kCreateDB);
+    req->SetFiles(files);
+    req->SetEndMsg(_("Recreated the cross reference index"));
+    DoSendRequest(req);
 }
 
 void Cscope::OnCScopeThreadEnded(wxCommandEvent& e)
@@ -785,23 +679,11 @@ wxString Cscope::GetSearchPattern() const
 void Cscope::DoFindSymbol(const wxString& word)
 {
     m_cscopeWin->Clear();
-    wxString list_file = DoCreateListFile(false);
-
-    // get the rebuild option
-    wxString rebuildOption = wxT("");
-    CScopeConfData settings;
-
-    m_mgr->GetConfigTool()->ReadObject(wxT("CscopeSettings"), &settings);
-    if(!settings.GetRebuildOption()) {
-        rebuildOption = wxT(" -d");
-    }
 
     // Do the actual search
-    wxString command;
     wxString endMsg;
-    command << GetCscopeExeName() << rebuildOption << wxT(" -L -0 ") << word << wxT(" -i ") << list_file;
     endMsg << wxT("cscope results for: find C symbol '") << word << wxT("'");
-    DoCscopeCommand(command, word, endMsg);
+    DoCscopeCommand(CscopeXRefIndex::kFindSymbol, word, endMsg);
 }
 
 void Cscope::OnEditorContentMenu(clContextMenuEvent& event)
@@ -813,3 +695,24 @@ void Cscope::OnEditorContentMenu(clContextMenuEvent& event)
         event.GetMenu()->Append(wxID_ANY, _("CScope"), CreateEditorPopMenu());
     }
 }
+
+void Cscope::OnFileSaved(clCommandEvent& event)
+{
+    event.Skip();
+    if(!m_mgr->IsWorkspaceOpen() || !FileExtManager::IsCxxFile(event.GetFileName())) {
+        return;
+    }
+
+    // re-index the saved file in the background, files which are not indexed are ignored
+    CscopeRequest* req = new CscopeRequest(CscopeRequest::kUpdateFiles);
+    req->SetOwner(this);
+    req->SetDbFile(DoGetDbFile());
+    req->SetFiles(wxArrayString(1, &event.GetFileName()));
+    CScopeThreadST::Get()->Add(req);
+}
+
+void Cscope::OnWorkspaceClosed(wxCommandEvent& event)
+{
+    event.Skip();
+    CScopeThreadST::Get()->Add(new CscopeRequest(CscopeRequest::kCloseDB));
+}
@@ -33,6 +33,7 @@
 #include "clTabTogglerHelper.h"
 
 class CscopeTab;
+class CscopeRequest;
 
 class Cscope : public IPlugin
 {
@@ -55,9 +56,11 @@ protected:
     // Helper
     //------------------------------------------
     wxMenu* CreateEditorPopMenu();
-    wxString GetCscopeExeName();
-    wxString DoCreateListFile(bool force);
-    void DoCscopeCommand(const wxString& command, const wxString& findWhat, const wxString& endMsg);
+    void DoGetFiles(wxArrayString& files);
+    wxString DoGetDbFile() const;
+    bool DoGetSyncOption();
+    void DoCscopeCommand(int query, const wxString& findWhat, const wxString& endMsg);
+    void DoSendRequest(CscopeRequest* req);
     void DoFindSymbol(const wxString& word);
     wxString GetSearchPattern() const;
 
@@ -70,12 +73,13 @@ protected:
     void OnFindFunctionsCallingThisFunction(wxCommandEvent& e);
     void OnFindFilesIncludingThisFname(wxCommandEvent& e);
     void OnCreateDB(wxCommandEvent& e);
-    void OnDoSettings(wxCommandEvent& e);
     void OnCScopeThreadEnded(wxCommandEvent& e);
     void OnCScopeThreadUpdateStatus(wxCommandEvent& e);
     void OnCscopeUI(wxUpdateUIEvent& e);
     void OnWorkspaceOpenUI(wxUpdateUIEvent& e);
     void OnEditorContentMenu(clContextMenuEvent& event);
+    void OnFileSaved(clCommandEvent& event);
+    void OnWorkspaceClosed(wxCommandEvent& event);
 };
 
 #endif // Cscope
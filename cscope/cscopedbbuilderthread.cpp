@@ -23,9 +23,6 @@
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 #include "cscopestatusmessage.h"
-#include "procutils.h"
-#include "dirsaver.h"
-#include "wx/filefn.h"
 #include "cscopedbbuilderthread.h"
 #include "cscope.h"
 
@@ -33,32 +30,75 @@ int wxEVT_CSCOPE_THREAD_DONE            = wxNewId();
 int wxEVT_CSCOPE_THREAD_UPDATE_STATUS   = wxNewId();
 
 CscopeDbBuilderThread::CscopeDbBuilderThread()
+	: m_loaded(false)
 {
 }
 
 CscopeDbBuilderThread::~CscopeDbBuilderThread()
 {
+	// the thread is stopped by now
+	DoSaveIndex();
+}
+
+void CscopeDbBuilderThread::DoSaveIndex()
+{
+	if(!m_dbFile.IsEmpty() && m_index.IsModified()) {
+		m_index.Save(m_dbFile);
+	}
 }
 
 void CscopeDbBuilderThread::ProcessRequest(ThreadRequest *request)
 {
 	CscopeRequest *req = (CscopeRequest*)request;
 
-	//change dir to the workspace directory
-	DirSaver ds;
+	if(req->GetType() == CscopeRequest::kCloseDB || req->GetDbFile() != m_dbFile) {
+		// switch to the index of the request's workspace
+		DoSaveIndex();
+		m_index.Clear();
+		m_dbFile = req->GetDbFile();
+		m_loaded = false;
+		if(req->GetType() == CscopeRequest::kCloseDB) {
+			m_dbFile.Clear();
+			return;
+		}
+	}
 
-	wxSetWorkingDirectory(req->GetWorkingDir());
-	SendStatusEvent( _("Executing cscope..."), 10, req->GetFindWhat(), req->GetOwner() );
+	if(req->GetType() == CscopeRequest::kUpdateFiles) {
+		// an index which is not loaded yet is synced when it is
+		if(m_loaded) {
+			m_index.UpdateFiles(req->GetFiles());
+		}
+		return;
+	}
 
-	//notify the database creation process as completed
-	wxArrayString output;
+	CScopeResultTable_t *result = new CScopeResultTable_t();
+	if(req->GetType() == CscopeRequest::kCreateDB) {
+		SendStatusEvent( _("Building the cross reference index..."), 10, req->GetFindWhat(), req->GetOwner() );
+		m_index.Clear();
+		m_index.Sync(req->GetFiles());
+		m_loaded = true;
+		DoSaveIndex();
+
+	} else {
+		bool sync = req->GetSyncFiles();
+		if(!m_loaded) {
+			SendStatusEvent( _("Loading the cross reference index..."), 10, req->GetFindWhat(), req->GetOwner() );
+			m_index.Load(m_dbFile);
+			m_loaded = true;
+			// pick up the files modified since the index was saved
+			sync = true;
+		}
 
-	//set environment variables required by cscope
-	wxSetEnv(wxT("TMPDIR"), wxFileName::GetTempDir());
-	ProcUtils::SafeExecuteCommand(req->GetCmd(), output);
-	SendStatusEvent( _("Parsing results..."), 50, wxEmptyString, req->GetOwner() );
+		if(sync) {
+			SendStatusEvent( _("Updating the cross reference index..."), 30, req->GetFindWhat(), req->GetOwner() );
+			if(m_index.Sync(req->GetFiles())) {
+				DoSaveIndex();
+			}
+		}
 
-	CScopeResultTable_t *result = ParseResults( output );
+		SendStatusEvent( _("Searching..."), 50, req->GetFindWhat(), req->GetOwner() );
+		m_index.Query((CscopeXRefIndex::eQuery)req->GetQuery(), req->GetFindWhat(), *result);
+	}
 	SendStatusEvent( _("Done"), 100, wxEmptyString, req->GetOwner() );
 
 	// send status message
@@ -70,57 +110,6 @@ void CscopeDbBuilderThread::ProcessRequest(ThreadRequest *request)
 	req->GetOwner()->AddPendingEvent(e);
 }
 
-CScopeResultTable_t* CscopeDbBuilderThread::ParseResults(const wxArrayString &output)
-{
-	CScopeResultTable_t *results = new CScopeResultTable_t();
-	for (size_t i=0; i< output.GetCount(); i++) {
-		//parse each line
-		wxString line = output.Item(i);
-		CscopeEntryData data;
-
-		//first is the file name
-		line = line.Trim().Trim(false);
-		//skip errors
-		if(line.StartsWith(wxT("cscope:"))){continue;}
-
-		wxString file = line.BeforeFirst(wxT(' '));
-		data.SetFile(file);
-		line = line.AfterFirst(wxT(' '));
-
-		//next is the scope
-		line = line.Trim().Trim(false);
-		wxString scope = line.BeforeFirst(wxT(' '));
-		line = line.AfterFirst(wxT(' '));
-		data.SetScope( scope );
-
-		//next is the line number
-		line = line.Trim().Trim(false);
-		long nn;
-		wxString line_number = line.BeforeFirst(wxT(' '));
-		line_number.ToLong( &nn );
-		data.SetLine( nn );
-		line = line.AfterFirst(wxT(' '));
-
-		//the rest is the pattern
-		wxString pattern = line;
-		data.SetPattern(pattern);
-
-		//insert the result
-		CScopeResultTable_t::const_iterator iter = results->find(data.GetFile());
-		std::vector< CscopeEntryData > *vec(NULL);
-		if (iter != results->end()) {
-			//this file already exist, append the result
-			vec = iter->second;
-		} else {
-			vec = new std::vector< CscopeEntryData >();
-			//add it to the map
-			(*results)[data.GetFile()] = vec;
-		}
-		vec->push_back( data );
-	}
-	return results;
-}
-
 void CscopeDbBuilderThread::SendStatusEvent(const wxString &msg, int percent, const wxString &findWhat, wxEvtHandler *owner)
 {
 	wxCommandEvent e(wxEVT_CSCOPE_THREAD_UPDATE_STATUS);
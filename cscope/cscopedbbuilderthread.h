@@ -30,6 +30,7 @@
 #include "wx/thread.h"
 #include "wx/event.h"
 #include "cscopeentrydata.h"
+#include "CscopeXRefIndex.h"
 #include "singleton.h"
 #include "worker_thread.h"
 #include <map>
@@ -38,9 +39,6 @@
 extern int wxEVT_CSCOPE_THREAD_DONE;
 extern int wxEVT_CSCOPE_THREAD_UPDATE_STATUS;
 
-typedef std::vector< CscopeEntryData > CScopeEntryDataVec_t;
-typedef std::map<wxString, CScopeEntryDataVec_t* > CScopeResultTable_t;
-
 /**
  * \class CscopeRequest
  * \brief
@@ -49,44 +47,74 @@ typedef std::map<wxString, CScopeEntryDataVec_t* > CScopeResultTable_t;
  */
 class CscopeRequest : public ThreadRequest
 {
+public:
+	enum eType {
+		kCreateDB,    // rebuild the index from scratch
+		kQuery,       // search the index
+		kUpdateFiles, // re-parse saved files
+		kCloseDB,     // save and unload the index
+	};
+
+protected:
+	eType         m_type;
+	int           m_query;
 	wxEvtHandler *m_owner;
-	wxString      m_cmd;
-	wxString      m_workingDir;
-	wxString      m_outfile;
+	wxString      m_dbFile;
+	wxArrayString m_files;
+	bool          m_syncFiles;
 	wxString      m_endMsg;
 	wxString      m_findWhat;
 public:
-	CscopeRequest() {};
+	CscopeRequest(eType type = kQuery)
+		: m_type(type)
+		, m_query(CscopeXRefIndex::kFindSymbol)
+		, m_owner(NULL)
+		, m_syncFiles(false) {};
 	~CscopeRequest() {};
 
+	/**
+	 * @brief queued updates of the same files are merged
+	 */
+	virtual wxString GetCoalescingKey() const {
+		return m_type == kUpdateFiles ? wxString("cscope-update:") + wxJoin(m_files, ';') : wxString();
+	}
 
 //Setters
-	void SetCmd(const wxString& cmd) {
-		this->m_cmd = cmd;
+	void SetQuery(int query) {
+		this->m_query = query;
+	}
+	void SetDbFile(const wxString& dbFile) {
+		this->m_dbFile = dbFile;
+	}
+	void SetFiles(const wxArrayString& files) {
+		this->m_files = files;
 	}
-	void SetOutfile(const wxString& outfile) {
-		this->m_outfile = outfile;
+	void SetSyncFiles(bool syncFiles) {
+		this->m_syncFiles = syncFiles;
 	}
 	void SetOwner(wxEvtHandler* owner) {
 		this->m_owner = owner;
 	}
 
-	void SetWorkingDir(const wxString& workingDir) {
-		this->m_workingDir = workingDir;
-	}
 //Getters
-	const wxString& GetCmd() const {
-		return m_cmd;
+	eType GetType() const {
+		return m_type;
+	}
+	int GetQuery() const {
+		return m_query;
+	}
+	const wxString& GetDbFile() const {
+		return m_dbFile;
+	}
+	const wxArrayString& GetFiles() const {
+		return m_files;
 	}
-	const wxString& GetOutfile() const {
-		return m_outfile;
+	bool GetSyncFiles() const {
+		return m_syncFiles;
 	}
 	wxEvtHandler* GetOwner() {
 		return m_owner;
 	}
-	const wxString& GetWorkingDir() const {
-		return m_workingDir;
-	}
 
 	void SetFindWhat(const wxString& findWhat) {
 		this->m_findWhat = findWhat;
@@ -105,9 +133,15 @@ public:
 class CscopeDbBuilderThread : public WorkerThread
 {
 	friend class Singleton< CscopeDbBuilderThread >;
+
+	// the index is only accessed from this thread
+	CscopeXRefIndex m_index;
+	wxString        m_dbFile;
+	bool            m_loaded;
+
 protected:
 	void ProcessRequest(ThreadRequest *req);
-	CScopeResultTable_t* ParseResults(const wxArrayString &output);
+	void DoSaveIndex();
 
 protected:
 	void SendStatusEvent(const wxString &msg, int percent, const wxString &findWhat, wxEvtHandler *owner);
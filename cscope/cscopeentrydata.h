@@ -26,6 +26,8 @@
 #define __cscopeentrydata__
 
 #include "wx/string.h"
+#include <map>
+#include <vector>
 
 enum {
 	KindFileNode = 0,
@@ -79,4 +81,8 @@ public:
 	}
 
 };
+
+typedef std::vector< CscopeEntryData > CScopeEntryDataVec_t;
+typedef std::map<wxString, CScopeEntryDataVec_t* > CScopeResultTable_t;
+
 #endif // __cscopeentrydata__
@@ -59,7 +59,6 @@ CscopeTab::CscopeTab(wxWindow* parent, IManager* mgr)
     m_font = wxFont(defFont.GetPointSize(), wxFONTFAMILY_TELETYPE, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
 
     m_checkBoxUpdateDb->SetValue(data.GetRebuildOption());
-    m_checkBoxRevertedIndex->SetValue(data.GetBuildRevertedIndexOption());
     SetMessage(_("Ready"), 0);
 
     Clear(); // To make the Clear button UpdateUI work initially
@@ -160,7 +159,6 @@ void CscopeTab::OnChangeSearchScope(wxCommandEvent& e)
     // update the settings
     data.SetScanScope(m_stringManager.GetStringSelection());
     data.SetRebuildDbOption(m_checkBoxUpdateDb->IsChecked());
-    data.SetBuildRevertedIndexOption(m_checkBoxRevertedIndex->IsChecked());
     // store the object
     m_mgr->GetConfigTool()->WriteObject(wxT("CscopeSettings"), &data);
 }
@@ -24,16 +24,11 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "csscopeconfdata.h"
-#include <wx/stdpaths.h>
-#include "cl_standard_paths.h"
 
 CScopeConfData::CScopeConfData()
-    : m_cscopeFilepath( wxT( "" ) )
-    , m_scanScope( SCOPE_ENTIRE_WORKSPACE )
+    : m_scanScope( SCOPE_ENTIRE_WORKSPACE )
     , m_rebuildDb( false )
-    , m_buildRevertedIndex( false )
 {
-    m_cscopeFilepath = clStandardPaths::Get().GetBinaryFullPath("cscope");
 }
 
 CScopeConfData::~CScopeConfData()
@@ -42,16 +37,12 @@ CScopeConfData::~CScopeConfData()
 
 void CScopeConfData::DeSerialize( Archive& arch )
 {
-    arch.Read( wxT( "m_cscopeFilepath" ), m_cscopeFilepath );
     arch.Read( wxT( "m_scanScope" ), m_scanScope );
     arch.Read( wxT( "m_rebuildDb" ), m_rebuildDb );
-    arch.Read( wxT( "m_buildRevertedIndex" ), m_buildRevertedIndex );
 }
 
 void CScopeConfData::Serialize( Archive& arch )
 {
-    arch.Write( wxT( "m_cscopeFilepath" ), m_cscopeFilepath );
     arch.Write( wxT( "m_scanScope" ), m_scanScope );
     arch.Write( wxT( "m_rebuildDb" ), m_rebuildDb );
-    arch.Write( wxT( "m_buildRevertedIndex" ), m_buildRevertedIndex );
 }
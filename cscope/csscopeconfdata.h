@@ -34,10 +34,8 @@
 
 class CScopeConfData : public SerializedObject
 {
-	wxString m_cscopeFilepath;
 	wxString m_scanScope;
 	bool     m_rebuildDb;
-	bool     m_buildRevertedIndex;
 
 public:
 	CScopeConfData();
@@ -47,12 +45,6 @@ public:
 	virtual void DeSerialize(Archive &arch);
 	virtual void Serialize(Archive &arch);
 
-	void SetCscopeExe(const wxString& filepath) {
-		this->m_cscopeFilepath = filepath;
-	}
-	const wxString& GetCscopeExe() const {
-		return m_cscopeFilepath;
-	}
 	void SetScanScope(const wxString& scanScope) {
 		this->m_scanScope = scanScope;
 	}
@@ -65,11 +57,5 @@ public:
 	bool GetRebuildOption() const {
 		return m_rebuildDb;
 	}
-	void SetBuildRevertedIndexOption(const bool revertedIndex) {
-		this->m_buildRevertedIndex = revertedIndex;
-	}
-	bool GetBuildRevertedIndexOption() const {
-		return m_buildRevertedIndex;
-	}
 };
 #endif // __csscopeconfdata__
@@ -87,6 +87,13 @@ tagFile TagFile = {
 
 static boolean TagsToStdout = FALSE;
 
+/*  When set, tags are passed to this callback instead of being written to
+ *  the tag file (see ctags_make_tags_with_callback).
+ */
+static CTAGS_ENTRY_CALLBACK EntryCallback = NULL;
+static void *EntryCallbackData = NULL;
+static vString *EntryPattern = NULL;
+
 /*
 *   FUNCTION PROTOTYPES
 */
@@ -108,6 +115,17 @@ extern void freeTagFileResources (void)
 	if (TagFile.directory != NULL)
 		eFree (TagFile.directory);
 	vStringDelete (TagFile.vLine);
+	if (EntryPattern != NULL)
+	{
+		vStringDelete (EntryPattern);
+		EntryPattern = NULL;
+	}
+}
+
+extern void setTagEntryCallback (CTAGS_ENTRY_CALLBACK callback, void *userData)
+{
+	EntryCallback = callback;
+	EntryCallbackData = userData;
 }
 
 extern const char *tagFileName (void)
@@ -574,18 +592,15 @@ extern void endEtagsFile (const char *const name)
  *  Tag entry management
  */
 
-/*  This function copies the current line out to a specified file. It has no
- *  effect on the fileGetc () function.  During copying, any '\' characters
- *  are doubled and a leading '^' or trailing '$' is also quoted. End of line
- *  characters (line feed or carriage return) are dropped.
+/*  This function appends the current line to "string". During copying, any
+ *  '\' characters are doubled and a leading '^' or trailing '$' is also
+ *  quoted. End of line characters (line feed or carriage return) are dropped.
  */
-static size_t writeSourceLine (FILE *const fp, const char *const line)
+static size_t appendSourceLine (vString *const string, const char *const line)
 {
 	size_t length = 0;
 	const char *p;
 
-	/*  Write everything up to, but not including, a line end character.
-	 */
 	for (p = line  ;  *p != '\0'  ;  ++p)
 	{
 		const int next = *(p + 1);
@@ -594,15 +609,13 @@ static size_t writeSourceLine (FILE *const fp, const char *const line)
 		if (c == CRETURN  ||  c == NEWLINE)
 			break;
 
-		/*  If character is '\', or a terminal '$', then quote it.
-		 */
 		if (c == BACKSLASH  ||  c == (Option.backward ? '?' : '/')  ||
 			(c == '$'  &&  (next == NEWLINE  ||  next == CRETURN)))
 		{
-			putc (BACKSLASH, fp);
+			vStringPut (string, BACKSLASH);
 			++length;
 		}
-		putc (c, fp);
+		vStringPut (string, c);
 		++length;
 	}
 	return length;
@@ -845,16 +858,18 @@ static int addExtensionFields (const tagEntryInfo *const tag)
 #undef sep
 }
 
-static int writePatternEntry (const tagEntryInfo *const tag)
+/*  Builds the search pattern of the tag (e.g. "/^int foo;$/") into "pattern".
+ */
+static void makePatternString (vString *const pattern, const tagEntryInfo *const tag)
 {
-	int i=0;
-	int length = 0;
 	const int searchChar = Option.backward ? '?' : '/';
 	boolean newlineTerminated;
+	const char *line;
 
 	//Eran Ifrah [PATCH START]
 	if (tag->hasTemplate || tag->kind == 't' /* typedef */) {
-		char *const line = (char*)readSourceLines(TagFile.vLine, tag->statementStartPos, tag->filePosition);
+		int i=0;
+		readSourceLines(TagFile.vLine, tag->statementStartPos, tag->filePosition);
 
 		for(; i<(int)TagFile.vLine->length; i++){
 			if(TagFile.vLine->buffer[i] == '\n'){
@@ -862,26 +877,33 @@ static int writePatternEntry (const tagEntryInfo *const tag)
 			}
 		}
 		vStringCatS(TagFile.vLine, "\n");
-
-		newlineTerminated = (boolean) (line [strlen (line) - 1] == '\n');
-		length += fprintf (TagFile.fp, "%c^", searchChar);
-		length += writeSourceLine (TagFile.fp, line);
-		length += fprintf (TagFile.fp, "%s%c", newlineTerminated ? "$":"", searchChar);
-
-		return length;
+		line = vStringValue(TagFile.vLine);
 		//Eran Ifrah [PATCH END]
 	} else {
-		char *const line = readSourceLine (TagFile.vLine, tag->filePosition, NULL);
+		char *const sourceLine = readSourceLine (TagFile.vLine, tag->filePosition, NULL);
 		if (tag->truncateLine)
-			truncateTagLine (line, tag->name, FALSE);
-		newlineTerminated = (boolean) (line [strlen (line) - 1] == '\n');
-
-		length += fprintf (TagFile.fp, "%c^", searchChar);
-		length += writeSourceLine (TagFile.fp, line);
-		length += fprintf (TagFile.fp, "%s%c", newlineTerminated ? "$":"", searchChar);
-
-		return length;
+			truncateTagLine (sourceLine, tag->name, FALSE);
+		line = sourceLine;
 	}
+	newlineTerminated = (boolean) (line [strlen (line) - 1] == '\n');
+
+	vStringClear (pattern);
+	vStringPut (pattern, searchChar);
+	vStringPut (pattern, '^');
+	appendSourceLine (pattern, line);
+	if (newlineTerminated)
+		vStringPut (pattern, '$');
+	vStringPut (pattern, searchChar);
+	vStringTerminate (pattern);
+}
+
+static int writePatternEntry (const tagEntryInfo *const tag)
+{
+	if (EntryPattern == NULL)
+		EntryPattern = vStringNew ();
+	makePatternString (EntryPattern, tag);
+	fputs (vStringValue (EntryPattern), TagFile.fp);
+	return (int) vStringLength (EntryPattern);
 }
 
 static int writeLineNumberEntry (const tagEntryInfo *const tag)
@@ -907,6 +929,95 @@ static int writeCtagsEntry (const tagEntryInfo *const tag)
 	return length;
 }
 
+/*  Passes the tag to the entry callback. The fields are the ones
+ *  addExtensionFields would have written.
+ */
+static int makeCallbackEntry (const tagEntryInfo *const tag)
+{
+	ctagsEntry entry;
+	char lineNumber [32];
+	char kind [2] = { '\0', '\0' };
+	char *replaced = NULL;
+
+	memset (&entry, 0, sizeof (entry));
+	entry.name = tag->name;
+	entry.file = tag->sourceFileName;
+	entry.line = -1;
+
+	if (tag->lineNumberEntry)
+	{
+		sprintf (lineNumber, "%lu", tag->lineNumber);
+		entry.pattern = lineNumber;
+	}
+	else
+	{
+		if (EntryPattern == NULL)
+			EntryPattern = vStringNew ();
+		makePatternString (EntryPattern, tag);
+		entry.pattern = vStringValue (EntryPattern);
+	}
+
+	if (includeExtensionFlags ())
+	{
+		if (tag->kindName != NULL && (Option.extensionFields.kindLong  ||
+			 (Option.extensionFields.kind  && tag->kind == '\0')))
+			entry.kind = tag->kindName;
+		else if (tag->kind != '\0'  && (Option.extensionFields.kind  ||
+				(Option.extensionFields.kindLong  &&  tag->kindName == NULL)))
+		{
+			kind [0] = tag->kind;
+			entry.kind = kind;
+		}
+
+		if (Option.extensionFields.lineNumber)
+			entry.line = (long) tag->lineNumber;
+
+		if (Option.extensionFields.language)
+			entry.language = tag->language;
+
+		if (Option.extensionFields.scope  &&
+				tag->extensionFields.scope [0] != NULL  &&
+				tag->extensionFields.scope [1] != NULL)
+		{
+			entry.scope [0] = tag->extensionFields.scope [0];
+			entry.scope [1] = tag->extensionFields.scope [1];
+		}
+
+		if (Option.extensionFields.typeRef  &&
+				tag->extensionFields.typeRef [0] != NULL  &&
+				tag->extensionFields.typeRef [1] != NULL)
+		{
+			entry.typeRef [0] = tag->extensionFields.typeRef [0];
+			entry.typeRef [1] = tag->extensionFields.typeRef [1];
+		}
+
+		entry.isFileScope = (Option.extensionFields.fileScope  &&  tag->isFileScope);
+
+		if (Option.extensionFields.inheritance)
+			entry.inherits = tag->extensionFields.inheritance;
+
+		if (Option.extensionFields.access)
+			entry.access = tag->extensionFields.access;
+
+		if (Option.extensionFields.implementation)
+			entry.implementation = tag->extensionFields.implementation;
+
+		if (Option.extensionFields.signature)
+			entry.signature = tag->extensionFields.signature;
+
+		if((tag->kind == 'p' || tag->kind == 'f') && tag->return_value[0] != '\0') {
+			replaced = ctagsReplacements((char*)tag->return_value);
+			entry.returns = replaced ? replaced : tag->return_value;
+		}
+	}
+
+	EntryCallback (&entry, EntryCallbackData);
+
+	if (replaced)
+		free (replaced);
+	return 0;
+}
+
 extern void makeTagEntry (const tagEntryInfo *const tag)
 {
 	Assert (tag->name != NULL);
@@ -917,7 +1028,9 @@ extern void makeTagEntry (const tagEntryInfo *const tag)
 		int length = 0;
 
 		DebugStatement ( debugEntry (tag); )
-		if (Option.xref)
+		if (EntryCallback != NULL)
+			length = makeCallbackEntry (tag);
+		else if (Option.xref)
 		{
 			if (! tag->isFileEntry)
 				length = writeXrefEntry (tag);
@@ -19,6 +19,7 @@
 #include <stdio.h>
 
 #include "vstring.h"
+#include "libctags.h"
 
 /*
 *   MACROS
@@ -101,6 +102,7 @@ extern void beginEtagsFile (void);
 extern void endEtagsFile (const char *const name);
 extern void makeTagEntry (const tagEntryInfo *const tag);
 extern void initTagEntry (tagEntryInfo *const e, const char *const name);
+extern void setTagEntryCallback (CTAGS_ENTRY_CALLBACK callback, void *userData);
 
 #endif  /* _ENTRY_H */
 
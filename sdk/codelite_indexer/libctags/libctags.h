@@ -10,8 +10,30 @@ typedef char* (*CTAGS_MAKE_TAGS_FUNC)(const char*, const char*);
 typedef void  (*CTAGS_SHUDOWN_FUNC)();
 typedef void (*CTAGS_FREE_FUNC)(char *);
 
+/** a tag, as it would have been written into the tags file. Unset fields are NULL **/
+typedef struct sCtagsEntry {
+	const char *name;
+	const char *file;
+	const char *pattern;        /* the search pattern, or the line number (--excmd=number) */
+	const char *kind;
+	long        line;           /* -1 if the line field was not requested */
+	const char *language;
+	const char *scope[2];       /* kind and name of the parent scope, e.g. "class" "Foo" */
+	const char *typeRef[2];     /* e.g. "struct" "Bar" */
+	int         isFileScope;
+	const char *inherits;
+	const char *access;
+	const char *implementation;
+	const char *signature;
+	const char *returns;
+} ctagsEntry;
+
+typedef void (*CTAGS_ENTRY_CALLBACK)(const ctagsEntry *entry, void *user_data);
+
 /** standard incudes **/
 char *ctags_make_tags (const char *cmd, const char *infile);
+/* same as ctags_make_tags, but each tag is passed to 'callback' instead of being formatted as text */
+void ctags_make_tags_with_callback (const char *cmd, const char *infile, CTAGS_ENTRY_CALLBACK callback, void *user_data);
 void ctags_shutdown();
 void ctags_free(char *ptr);
 void ctags_batch_parse(const char* filelist, const char * outputfile);
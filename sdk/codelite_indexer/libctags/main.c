@@ -553,11 +553,8 @@ char *load_file(const char *fileName)
 }
 
 /** Create tags from argv **/
-extern char *ctags_make_tags (const char *cmd, const char *infile)
+static void ctags_run (const char *cmd, const char *infile)
 {
-	char *tags = NULL;
-	char * file_name = NULL;
-
 	ctags_init( cmd, infile );
 
 	cookedArgs *args = cArgNewFromArgv (gArgv);
@@ -572,6 +569,21 @@ extern char *ctags_make_tags (const char *cmd, const char *infile)
 	if ( Option.ignore ) {
 		stringListClear(Option.ignore);
 	}
+}
+
+extern void ctags_make_tags_with_callback (const char *cmd, const char *infile, CTAGS_ENTRY_CALLBACK callback, void *user_data)
+{
+	setTagEntryCallback(callback, user_data);
+	ctags_run(cmd, infile);
+	setTagEntryCallback(NULL, NULL);
+}
+
+extern char *ctags_make_tags (const char *cmd, const char *infile)
+{
+	char *tags = NULL;
+	char * file_name = NULL;
+
+	ctags_run(cmd, infile);
 
 	/* open the tags file, read it and convert it into char* */
 	file_name = (char*)malloc(strlen(TagFile.directory) + 6);
@@ -38,7 +38,8 @@ class clIndexerRequest
 public:
 	enum {
 		CLI_PARSE,
-		CLI_PARSE_AND_SAVE
+		CLI_PARSE_AND_SAVE,
+		CLI_PARSE_BINARY // same as CLI_PARSE, the tags are replied in the binary format of cl_tags_binary.h
 	};
 
 public:
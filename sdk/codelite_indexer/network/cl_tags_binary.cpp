@@ -0,0 +1,159 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// copyright            : (C) 2016 by Eran Ifrah
+// file name            : cl_tags_binary.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "cl_tags_binary.h"
+
+#define TAGS_BINARY_MAGIC 0x53474154 // "TAGS"
+#define TAGS_BINARY_VERSION 1
+
+clTagsBinaryWriter::clTagsBinaryWriter()
+{
+	Clear();
+}
+
+clTagsBinaryWriter::~clTagsBinaryWriter()
+{
+}
+
+void clTagsBinaryWriter::Clear()
+{
+	m_offsets.clear();
+	m_records.clear();
+	m_strings.clear();
+	m_index.clear();
+
+	// index 0 is the empty string
+	m_offsets.push_back(0);
+	m_strings.push_back('\0');
+	m_index.insert(std::make_pair(std::string(), 0));
+}
+
+unsigned int clTagsBinaryWriter::Intern(const char* str)
+{
+	if(str == NULL || *str == '\0') {
+		return 0;
+	}
+
+	std::pair<std::map<std::string, unsigned int>::iterator, bool> res =
+	    m_index.insert(std::make_pair(std::string(str), (unsigned int)m_offsets.size()));
+	if(res.second) {
+		m_offsets.push_back((unsigned int)m_strings.size());
+		m_strings.append(str, strlen(str) + 1);
+	}
+	return res.first->second;
+}
+
+void clTagsBinaryWriter::Add(const char* const* fields, long line, unsigned int flags)
+{
+	clTagsBinaryRecord record;
+	for(size_t i = 0; i < kTagFieldsCount; ++i) {
+		record.fields[i] = Intern(fields[i]);
+	}
+	record.line = (int)line;
+	record.flags = flags;
+	m_records.push_back(record);
+}
+
+void clTagsBinaryWriter::Serialize(std::string& buffer) const
+{
+	clTagsBinaryHeader header;
+	header.magic = TAGS_BINARY_MAGIC;
+	header.version = TAGS_BINARY_VERSION;
+	header.stringsCount = (unsigned int)m_offsets.size();
+	header.stringsSize = (unsigned int)m_strings.size();
+	header.recordsCount = (unsigned int)m_records.size();
+
+	buffer.clear();
+	buffer.reserve(sizeof(header) + m_offsets.size() * sizeof(unsigned int) +
+	               m_records.size() * sizeof(clTagsBinaryRecord) + m_strings.size());
+	buffer.append((const char*)&header, sizeof(header));
+	buffer.append((const char*)&m_offsets[0], m_offsets.size() * sizeof(unsigned int));
+	if(!m_records.empty()) {
+		buffer.append((const char*)&m_records[0], m_records.size() * sizeof(clTagsBinaryRecord));
+	}
+	buffer.append(m_strings);
+}
+
+//---------------------------------------------------------------------------
+
+clTagsBinaryReader::clTagsBinaryReader()
+	: m_header(NULL)
+	, m_offsets(NULL)
+	, m_records(NULL)
+	, m_strings(NULL)
+{
+}
+
+clTagsBinaryReader::~clTagsBinaryReader()
+{
+}
+
+bool clTagsBinaryReader::Open(const std::string& buffer)
+{
+	m_header = NULL;
+	if(buffer.size() < sizeof(clTagsBinaryHeader)) {
+		return false;
+	}
+
+	const char* data = buffer.data();
+	const clTagsBinaryHeader* header = (const clTagsBinaryHeader*)data;
+	if(header->magic != TAGS_BINARY_MAGIC || header->version != TAGS_BINARY_VERSION) {
+		return false;
+	}
+
+	size_t expectedSize = sizeof(clTagsBinaryHeader) + (size_t)header->stringsCount * sizeof(unsigned int) +
+	                      (size_t)header->recordsCount * sizeof(clTagsBinaryRecord) + header->stringsSize;
+	if(expectedSize != buffer.size() || header->stringsCount == 0 || header->stringsSize == 0) {
+		return false;
+	}
+
+	const unsigned int* offsets = (const unsigned int*)(data + sizeof(clTagsBinaryHeader));
+	const clTagsBinaryRecord* records = (const clTagsBinaryRecord*)(offsets + header->stringsCount);
+	const char* strings = (const char*)(records + header->recordsCount);
+
+	// validate the buffer once, so the accessors need no checks
+	if(strings[header->stringsSize - 1] != '\0' || offsets[0] >= header->stringsSize || strings[offsets[0]] != '\0') {
+		return false;
+	}
+	for(size_t i = 0; i < header->stringsCount; ++i) {
+		if(offsets[i] >= header->stringsSize) {
+			return false;
+		}
+	}
+	for(size_t i = 0; i < header->recordsCount; ++i) {
+		for(size_t j = 0; j < kTagFieldsCount; ++j) {
+			if(records[i].fields[j] >= header->stringsCount) {
+				return false;
+			}
+		}
+	}
+
+	m_header = header;
+	m_offsets = offsets;
+	m_records = records;
+	m_strings = strings;
+	return true;
+}
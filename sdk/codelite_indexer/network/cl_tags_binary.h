@@ -0,0 +1,145 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// copyright            : (C) 2016 by Eran Ifrah
+// file name            : cl_tags_binary.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef __cltagsbinary__
+#define __cltagsbinary__
+
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+ * The binary tags format, used by the CLI_PARSE_BINARY replies of the indexer.
+ * A reply is:
+ *
+ *   header    : clTagsBinaryHeader
+ *   offsets   : stringsCount x uint32, the offset of each string in the strings pool
+ *   records   : recordsCount x clTagsBinaryRecord, the fields are indexes into the offsets table
+ *   strings   : the strings pool, NUL terminated UTF-8 strings. Every string is stored once per reply
+ *
+ * String index 0 is always the empty string (which is also used for unset fields)
+ */
+enum eTagsBinaryField {
+	kTagName = 0,
+	kTagFile,
+	kTagPattern,
+	kTagKind,
+	kTagLanguage,
+	kTagScopeKind,
+	kTagScopeName,
+	kTagTypeRefKind,
+	kTagTypeRefName,
+	kTagInherits,
+	kTagAccess,
+	kTagImplementation,
+	kTagSignature,
+	kTagReturns,
+	kTagFieldsCount
+};
+
+enum {
+	kTagFileScope = (1 << 0)
+};
+
+struct clTagsBinaryHeader {
+	unsigned int magic;
+	unsigned int version;
+	unsigned int stringsCount;
+	unsigned int stringsSize;
+	unsigned int recordsCount;
+};
+
+struct clTagsBinaryRecord {
+	unsigned int fields[kTagFieldsCount];
+	int line; // -1 if not set
+	unsigned int flags;
+};
+
+class clTagsBinaryWriter
+{
+	std::vector<unsigned int> m_offsets;
+	std::vector<clTagsBinaryRecord> m_records;
+	std::string m_strings;
+	std::map<std::string, unsigned int> m_index;
+
+protected:
+	unsigned int Intern(const char* str);
+
+public:
+	clTagsBinaryWriter();
+	~clTagsBinaryWriter();
+
+	/**
+	 * @brief add a tag. 'fields' holds kTagFieldsCount strings (NULL for unset fields)
+	 */
+	void Add(const char* const* fields, long line, unsigned int flags);
+
+	bool IsEmpty() const {
+		return m_records.empty();
+	}
+
+	void Clear();
+
+	/**
+	 * @brief serialize the tags added so far into 'buffer'
+	 */
+	void Serialize(std::string& buffer) const;
+};
+
+/**
+ * @class clTagsBinaryReader
+ * @brief read the tags from a binary buffer, the buffer is not copied and must outlive the reader
+ */
+class clTagsBinaryReader
+{
+	const clTagsBinaryHeader* m_header;
+	const unsigned int* m_offsets;
+	const clTagsBinaryRecord* m_records;
+	const char* m_strings;
+
+public:
+	clTagsBinaryReader();
+	~clTagsBinaryReader();
+
+	/**
+	 * @brief attach the reader to 'buffer'
+	 * @return false if 'buffer' is not a valid tags buffer
+	 */
+	bool Open(const std::string& buffer);
+
+	size_t GetStringsCount() const {
+		return m_header ? m_header->stringsCount : 0;
+	}
+	const char* GetString(size_t index) const {
+		return m_strings + m_offsets[index];
+	}
+	size_t GetRecordsCount() const {
+		return m_header ? m_header->recordsCount : 0;
+	}
+	const clTagsBinaryRecord& GetRecord(size_t index) const {
+		return m_records[index];
+	}
+};
+#endif // __cltagsbinary__
@@ -5,12 +5,36 @@
 #include "network/cl_indexer_request.h"
 #include "network/np_connections_server.h"
 #include "network/clindexerprotocol.h"
+#include "network/cl_tags_binary.h"
 #include "libctags/libctags.h"
 #include "utils.h"
 #include <stdlib.h>
 #include <cstdio>
 #include <memory>
 
+// ctags callback: add the tag to the clTagsBinaryWriter passed as 'user_data'
+static void AddBinaryTag(const ctagsEntry *entry, void *user_data)
+{
+	const char *fields[kTagFieldsCount];
+	fields[kTagName]           = entry->name;
+	fields[kTagFile]           = entry->file;
+	fields[kTagPattern]        = entry->pattern;
+	fields[kTagKind]           = entry->kind;
+	fields[kTagLanguage]       = entry->language;
+	fields[kTagScopeKind]      = entry->scope[0];
+	fields[kTagScopeName]      = entry->scope[1];
+	fields[kTagTypeRefKind]    = entry->typeRef[0];
+	fields[kTagTypeRefName]    = entry->typeRef[1];
+	fields[kTagInherits]       = entry->inherits;
+	fields[kTagAccess]         = entry->access;
+	fields[kTagImplementation] = entry->implementation;
+	fields[kTagSignature]      = entry->signature;
+	fields[kTagReturns]        = entry->returns;
+
+	clTagsBinaryWriter *writer = (clTagsBinaryWriter*)user_data;
+	writer->Add(fields, entry->line, entry->isFileScope ? kTagFileScope : 0);
+}
+
 WorkerThread::WorkerThread(eQueue<clNamedPipe*> *queue)
 		: m_queue(queue)
 {
@@ -37,6 +61,27 @@ void WorkerThread::start()
 				continue;
 			}
 
+			if (req.getCmd() == clIndexerRequest::CLI_PARSE_BINARY) {
+				// the tags are collected from ctags directly into the binary reply,
+				// no text is formatted here nor parsed by the client
+				clTagsBinaryWriter writer;
+				for (size_t i=0; i<req.getFiles().size(); i++) {
+					ctags_make_tags_with_callback(req.getCtagOptions().c_str(), req.getFiles().at(i).c_str(), AddBinaryTag, &writer);
+				}
+
+				std::string tags;
+				writer.Serialize(tags);
+
+				clIndexerReply reply;
+				reply.setCompletionCode(1);
+				reply.setTags(tags);
+				if ( !clIndexerProtocol::SendReply(conn, reply) ) {
+					fprintf(stderr, "ERROR: Protocol error: failed to send reply for file %s\n", reply.getFileName().c_str());
+					break;
+				}
+				continue;
+			}
+
 			char *tags(NULL);
 			// create fies for the requested files
 			for (size_t i=0; i<req.getFiles().size(); i++) {